@@ -1,5 +1,6 @@
 #include "FBXAnimationImport.h"
 
+#include "Animation/AnimationChannelCompressor.h"
 #include "Animation/AnimationClip.h"
 #include "FileSystem/File.h"
 #include "Logger/Logger.h"
@@ -9,6 +10,11 @@ namespace DAVA
 {
 namespace FBXAnimationImportDetails
 {
+//max error of key reduction in channel units
+const float32 POSITION_TOLERANCE = 0.0001f;
+const float32 ORIENTATION_TOLERANCE = 0.0001f;
+const float32 SCALE_TOLERANCE = 0.0001f;
+
 //namespace declarations
 
 template <class T>
@@ -83,16 +89,12 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
     {
         //Track part
         uint8 target;
-        uint8 pad0[3];
-
-        //Channel part
-        uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
-        uint8 dimension = 0;
-        uint8 interpolation = 0;
-        uint16 compression = 0;
-        uint32 keyCount = 0;
+        uint8 pad0[3] = {};
     } channelHeader;
 
+    Vector<float32> keyTimes;
+    Vector<float32> keyValues;
+
     ScopedPtr<File> file(File::Create(filePath, File::CREATE | File::WRITE));
     if (file)
     {
@@ -133,50 +135,37 @@ void SaveAnimation(const FBXAnimationStackData& fbxStackAnimationData, const Fil
                 if (!fbxChannelData.animationKeys.empty())
                 {
                     channelHeader.target = fbxChannelData.channel;
-                    channelHeader.keyCount = uint32(fbxChannelData.animationKeys.size());
 
+                    uint32 dimension = 0;
+                    AnimationChannel::eInterpolation interpolation = AnimationChannel::INTERPOLATION_LINEAR;
+                    AnimationChannelCompressor::Settings compressionSettings;
                     if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
                     {
-                        channelHeader.dimension = 3;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
+                        dimension = 3;
+                        compressionSettings.tolerance = POSITION_TOLERANCE;
                     }
                     else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
                     {
-                        channelHeader.dimension = 4;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+                        dimension = 4;
+                        interpolation = AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR;
+                        compressionSettings.tolerance = ORIENTATION_TOLERANCE;
                     }
                     else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
                     {
-                        channelHeader.dimension = 1;
-                        channelHeader.interpolation = uint8(AnimationChannel::INTERPOLATION_LINEAR);
+                        dimension = 1;
+                        compressionSettings.tolerance = SCALE_TOLERANCE;
                     }
 
-                    WriteToBuffer(animationData, &channelHeader);
-
-                    for (uint32 k = 0; k < channelHeader.keyCount; ++k)
+                    keyTimes.clear();
+                    keyValues.clear();
+                    for (const FBXAnimationKey& key : fbxChannelData.animationKeys)
                     {
-                        const FBXAnimationKey& key = fbxChannelData.animationKeys[k];
-
-                        float32 relativeKeyTime = key.time - fbxStackAnimationData.minTimeStamp;
-                        WriteToBuffer(animationData, &relativeKeyTime);
-
-                        if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_POSITION)
-                        {
-                            Vector3 position = Vector3(key.value.data);
-                            WriteToBuffer(animationData, &position);
-                        }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_ORIENTATION)
-                        {
-                            Quaternion orientation = Quaternion(key.value.data);
-                            orientation.Normalize();
-                            WriteToBuffer(animationData, &orientation);
-                        }
-                        else if (channelHeader.target == AnimationTrack::CHANNEL_TARGET_SCALE)
-                        {
-                            float32 scale = key.value.x;
-                            WriteToBuffer(animationData, &scale);
-                        }
+                        keyTimes.push_back(key.time - fbxStackAnimationData.minTimeStamp);
+                        keyValues.insert(keyValues.end(), key.value.data, key.value.data + dimension);
                     }
+
+                    WriteToBuffer(animationData, &channelHeader);
+                    AnimationChannelCompressor::Write(interpolation, dimension, keyTimes, keyValues, compressionSettings, animationData);
                 }
             }
         }
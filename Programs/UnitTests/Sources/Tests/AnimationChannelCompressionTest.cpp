@@ -0,0 +1,128 @@
+#include "DAVAEngine.h"
+
+#include "Animation/AnimationChannel.h"
+#include "Animation/AnimationChannelCompressor.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (AnimationChannelCompressionTest)
+{
+    const uint32 KEYS_COUNT = 120;
+    const float32 SAMPLE_INTERVAL = 1.f / 30.f;
+
+    void MakePositionKeys(Vector<float32> & times, Vector<float32> & values)
+    {
+        for (uint32 k = 0; k < KEYS_COUNT; ++k)
+        {
+            float32 time = float32(k) * SAMPLE_INTERVAL;
+            times.push_back(time);
+            values.push_back(2.f * time);
+            values.push_back(std::sin(time));
+            values.push_back(-1.f);
+        }
+    }
+
+    void MakeOrientationKeys(Vector<float32> & times, Vector<float32> & values)
+    {
+        for (uint32 k = 0; k < KEYS_COUNT; ++k)
+        {
+            float32 time = float32(k) * SAMPLE_INTERVAL;
+            Quaternion q;
+            q.Construct(Vector3(0.f, 0.f, 1.f), time * 3.f);
+            times.push_back(time);
+            values.insert(values.end(), q.data, q.data + 4);
+        }
+    }
+
+    float32 EvaluateError(const AnimationChannel& channel, const Vector<float32>& times, const Vector<float32>& values)
+    {
+        uint32 dimension = channel.GetDimension();
+        float32 maxError = 0.f;
+        float32 result[4];
+        for (uint32 k = 0; k < uint32(times.size()); ++k)
+        {
+            channel.Evaluate(times[k], result, 4);
+
+            float32 sign = 1.f;
+            if (dimension == 4 && Quaternion(result).DotProduct(Quaternion(&values[k * 4])) < 0.f)
+                sign = -1.f;
+
+            for (uint32 d = 0; d < dimension; ++d)
+                maxError = Max(maxError, std::abs(sign * result[d] - values[k * dimension + d]));
+        }
+        return maxError;
+    }
+
+    DAVA_TEST (UncompressedChannelIsExact)
+    {
+        Vector<float32> times;
+        Vector<float32> values;
+        MakePositionKeys(times, values);
+
+        AnimationChannelCompressor::Settings settings;
+        settings.quantize = false;
+        settings.uniformSamples = false;
+
+        Vector<uint8> data;
+        AnimationChannelCompressor::Write(AnimationChannel::INTERPOLATION_LINEAR, 3, times, values, settings, data);
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(data.data()) == uint32(data.size()));
+        TEST_VERIFY(channel.GetKeysCount() == KEYS_COUNT);
+        TEST_VERIFY(EvaluateError(channel, times, values) == 0.f);
+    }
+
+    DAVA_TEST (QuantizedUniformPositions)
+    {
+        Vector<float32> times;
+        Vector<float32> values;
+        MakePositionKeys(times, values);
+
+        AnimationChannelCompressor::Settings settings;
+        Vector<uint8> data;
+        AnimationChannelCompressor::Write(AnimationChannel::INTERPOLATION_LINEAR, 3, times, values, settings, data);
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(data.data()) == uint32(data.size()));
+        TEST_VERIFY(channel.GetKeysCount() == KEYS_COUNT);
+        TEST_VERIFY(data.size() < KEYS_COUNT * 4 * sizeof(float32) / 2);
+        TEST_VERIFY(EvaluateError(channel, times, values) < 1e-3f);
+    }
+
+    DAVA_TEST (ReducedQuantizedPositions)
+    {
+        Vector<float32> times;
+        Vector<float32> values;
+        MakePositionKeys(times, values);
+
+        AnimationChannelCompressor::Settings settings;
+        settings.tolerance = 1e-2f;
+        settings.uniformSamples = false;
+        Vector<uint8> data;
+        AnimationChannelCompressor::Write(AnimationChannel::INTERPOLATION_LINEAR, 3, times, values, settings, data);
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(data.data()) == uint32(data.size()));
+        TEST_VERIFY(channel.GetKeysCount() < KEYS_COUNT / 2);
+        TEST_VERIFY(EvaluateError(channel, times, values) < 1e-2f + 1e-3f);
+    }
+
+    DAVA_TEST (QuantizedOrientations)
+    {
+        Vector<float32> times;
+        Vector<float32> values;
+        MakeOrientationKeys(times, values);
+
+        AnimationChannelCompressor::Settings settings;
+        settings.tolerance = 1e-3f;
+        Vector<uint8> data;
+        AnimationChannelCompressor::Write(AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR, 4, times, values, settings, data);
+
+        AnimationChannel channel;
+        TEST_VERIFY(channel.Bind(data.data()) == uint32(data.size()));
+        TEST_VERIFY((data.size() & 3) == 0);
+        TEST_VERIFY(EvaluateError(channel, times, values) < 1e-3f + 1e-4f);
+    }
+};
@@ -0,0 +1,120 @@
+#include "DAVAEngine.h"
+#include "Render/2D/Systems/BatchRecord2D.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (BatchRecord2DTest)
+{
+    DAVA_TEST (ReorderedBatchesKeepOverlapOrder)
+    {
+        ScopedPtr<NMaterial> backgroundMaterial(new NMaterial());
+        ScopedPtr<NMaterial> iconMaterial(new NMaterial());
+        ScopedPtr<NMaterial> textMaterial(new NMaterial());
+
+        // List of rows, each row draws background, icon and text over it
+        BatchRecord2D record;
+        const uint32 rowsCount = 8;
+        for (uint32 row = 0; row < rowsCount; ++row)
+        {
+            const float32 y = row * 50.f;
+            AddQuad(record, backgroundMaterial, Rect(0.f, y, 300.f, 40.f));
+            AddQuad(record, iconMaterial, Rect(5.f, y + 5.f, 30.f, 30.f));
+            AddQuad(record, textMaterial, Rect(40.f, y + 10.f, 200.f, 20.f));
+        }
+        // Popup over the whole list can't be merged with row backgrounds
+        AddQuad(record, backgroundMaterial, Rect(50.f, 50.f, 100.f, 100.f));
+
+        Vector<Rect> bounds;
+        for (const BatchRecord2D::Batch& batch : record.batches)
+        {
+            bounds.push_back(record.CalculateBatchBounds(batch));
+        }
+
+        Vector<uint32> order;
+        uint32 groupsCount = record.CalculateReorderedDrawOrder(bounds, 32, order);
+
+        uint32 submissionPacketsCount = 1;
+        for (size_t i = 1; i < record.batches.size(); ++i)
+        {
+            if (!BatchRecord2D::IsSameBatchState(record.batches[i - 1], record.batches[i]))
+            {
+                ++submissionPacketsCount;
+            }
+        }
+        TEST_VERIFY(submissionPacketsCount == rowsCount * 3 + 1);
+        TEST_VERIFY(groupsCount == 4);
+
+        // Every batch is drawn once
+        TEST_VERIFY(order.size() == record.batches.size());
+        Vector<uint32> position(record.batches.size(), uint32(-1));
+        for (uint32 i = 0; i < static_cast<uint32>(order.size()); ++i)
+        {
+            TEST_VERIFY(position[order[i]] == uint32(-1));
+            position[order[i]] = i;
+        }
+
+        // Overlapping batches are drawn in submission order, so picture is the same
+        for (size_t i = 0; i < bounds.size(); ++i)
+        {
+            for (size_t j = i + 1; j < bounds.size(); ++j)
+            {
+                if (bounds[i].RectIntersects(bounds[j]))
+                {
+                    TEST_VERIFY(position[i] < position[j]);
+                }
+            }
+        }
+
+        // Consecutive batches of each group have the same state
+        uint32 stateChangesCount = 1;
+        for (size_t i = 1; i < order.size(); ++i)
+        {
+            if (!BatchRecord2D::IsSameBatchState(record.batches[order[i - 1]], record.batches[order[i]]))
+            {
+                ++stateChangesCount;
+            }
+        }
+        TEST_VERIFY(stateChangesCount == groupsCount);
+    }
+
+    DAVA_TEST (ReorderingDistanceIsLimited)
+    {
+        ScopedPtr<NMaterial> firstMaterial(new NMaterial());
+        ScopedPtr<NMaterial> secondMaterial(new NMaterial());
+
+        BatchRecord2D record;
+        for (uint32 i = 0; i < 10; ++i)
+        {
+            AddQuad(record, (i % 2) == 0 ? firstMaterial : secondMaterial, Rect(i * 20.f, 0.f, 10.f, 10.f));
+        }
+
+        Vector<Rect> bounds;
+        for (const BatchRecord2D::Batch& batch : record.batches)
+        {
+            bounds.push_back(record.CalculateBatchBounds(batch));
+        }
+
+        Vector<uint32> order;
+        TEST_VERIFY(record.CalculateReorderedDrawOrder(bounds, 32, order) == 2);
+        TEST_VERIFY(record.CalculateReorderedDrawOrder(bounds, 0, order) == 10);
+    }
+
+    void AddQuad(BatchRecord2D & record, NMaterial * material, const Rect& rect)
+    {
+        BatchRecord2D::Batch batch;
+        batch.material = material;
+        batch.vertexOffset = static_cast<uint32>(record.vertices.size() / 2);
+        batch.vertexCount = 4;
+        batch.indexOffset = static_cast<uint32>(record.indices.size());
+        batch.indexCount = 6;
+
+        const float32 vertices[] = { rect.x, rect.y, rect.x + rect.dx, rect.y, rect.x, rect.y + rect.dy, rect.x + rect.dx, rect.y + rect.dy };
+        record.vertices.insert(record.vertices.end(), std::begin(vertices), std::end(vertices));
+        const uint16 indices[] = { 0, 1, 2, 1, 3, 2 };
+        record.indices.insert(record.indices.end(), std::begin(indices), std::end(indices));
+
+        record.AddBatch(batch);
+    }
+};
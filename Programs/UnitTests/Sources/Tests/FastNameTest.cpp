@@ -116,6 +116,22 @@ DAVA_TESTCLASS (FastNameTest)
         TEST_VERIFY(!(fn1 < fn3));
     }
 
+    DAVA_TEST (HashTest)
+    {
+        static_assert(FastNameDB::HashName("", 0) == FastNameDB::HASH_OFFSET_BASIS, "empty name hash should be FNV offset basis");
+
+        FastName fn1("hashed_name");
+        FastName fn2 = DV_FASTNAME("hashed_name");
+        FastName fn3(String("other_hashed_name"));
+
+        TEST_VERIFY(fn1 == fn2);
+        TEST_VERIFY(fn1.GetHash() == FastNameDB::HashName("hashed_name", 11));
+        TEST_VERIFY(fn2.GetHash() == fn1.GetHash());
+        TEST_VERIFY(fn3.GetHash() != fn1.GetHash());
+        TEST_VERIFY(FastName().GetHash() == 0);
+        TEST_VERIFY(std::hash<FastName>()(fn1) == fn1.GetHash());
+    }
+
     DAVA_TEST (ConcurrentConstructorTest)
     {
         const size_t threadsNum = 24;
@@ -4,6 +4,7 @@
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/FileSystem.h"
 #include "FileSystem/FileSystemDelegate.h"
+#include "FileSystem/FileAPIHelper.h"
 #include "Utils/CRC32.h"
 
 using namespace DAVA;
@@ -604,6 +605,63 @@ DAVA_TESTCLASS (FileSystemTest)
         }
     }
 
+    DAVA_TEST (ResourcesIndexTest)
+    {
+        FileSystem* fs = FileSystem::Instance();
+        bool wasEnabled = fs->IsResourcesIndexEnabled();
+        // Index is enabled only with engine option
+        TEST_VERIFY(!wasEnabled);
+        fs->SetResourcesIndexEnabled(true);
+
+        FilePath resDir = tempDir + "ResourcesIndexTest/";
+        fs->CreateDirectory(resDir + "sub/", true);
+        {
+            ScopedPtr<File> file(File::Create(resDir + "sub/file.txt", File::CREATE | File::WRITE));
+            file->WriteLine("file");
+        }
+        FilePath::AddResourcesFolder(resDir);
+
+        TEST_VERIFY(fs->Exists("~res:/sub/file.txt"));
+        TEST_VERIFY(fs->IsDirectory("~res:/sub/"));
+        TEST_VERIFY(!fs->Exists("~res:/sub/missing.txt"));
+        TEST_VERIFY(!fs->Exists("~res:/missing/missing.txt"));
+
+        { // directories are listed on first access to their content, file created bypassing FileSystem in not listed directory is found
+            fs->CreateDirectory(resDir + "sub/lazy/");
+            FILE* f = FileAPI::OpenFile((resDir + "sub/lazy/file.txt").GetAbsolutePathname(), "wb");
+            TEST_VERIFY(f != nullptr);
+            FileAPI::Close(f);
+            TEST_VERIFY(fs->IsFile("~res:/sub/lazy/file.txt"));
+        }
+#if defined(__DAVAENGINE_WINDOWS__) || defined(__DAVAENGINE_APPLE__)
+        // Index follows case-insensitive file system
+        TEST_VERIFY(fs->IsFile("~res:/Sub/File.TXT"));
+#endif
+
+        { // changes made through FileSystem and File are seen by index
+            ScopedPtr<File> file(File::Create(resDir + "sub/new.txt", File::CREATE | File::WRITE));
+            file->WriteLine("new");
+        }
+        TEST_VERIFY(fs->IsFile("~res:/sub/new.txt"));
+        ScopedPtr<File> opened(File::Create("~res:/sub/new.txt", File::OPEN | File::READ));
+        TEST_VERIFY(opened);
+        opened.reset();
+
+        fs->DeleteFile(resDir + "sub/file.txt");
+        TEST_VERIFY(!fs->Exists("~res:/sub/file.txt"));
+
+        fs->CreateDirectory(resDir + "sub/dir/");
+        TEST_VERIFY(fs->IsDirectory("~res:/sub/dir/"));
+        fs->DeleteDirectory(resDir + "sub/", true);
+        TEST_VERIFY(!fs->Exists("~res:/sub/new.txt"));
+        TEST_VERIFY(!fs->IsDirectory("~res:/sub/dir/"));
+
+        FilePath::RemoveResourcesFolder(resDir);
+        fs->InvalidateResourcesIndex();
+        fs->SetResourcesIndexEnabled(wasEnabled);
+        fs->DeleteDirectory(resDir, true);
+    }
+
     class HookDelegate : public FileSystemDelegate
     {
     public:
@@ -0,0 +1,154 @@
+#include "UnitTests/UnitTests.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Highlevel/GeoDecalManager.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+
+using namespace DAVA;
+
+namespace GeoDecalManagerTestDetails
+{
+RenderObject* CreateBoxObject()
+{
+    Map<FastName, float32> options = {
+        { FastName("segments.x"), 8.0f },
+        { FastName("segments.y"), 8.0f },
+        { FastName("segments.z"), 8.0f }
+    };
+    ScopedPtr<PolygonGroup> geometry(GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options));
+
+    ScopedPtr<NMaterial> material(new NMaterial());
+    material->SetFXName(NMaterialName::TEXTURED_OPAQUE);
+
+    ScopedPtr<RenderBatch> batch(new RenderBatch());
+    batch->SetPolygonGroup(geometry);
+    batch->SetMaterial(material);
+
+    RenderObject* object = new RenderObject();
+    object->AddRenderBatch(batch);
+    return object;
+}
+
+GeoDecalManager::DecalConfig CreateDecalConfig()
+{
+    GeoDecalManager::DecalConfig config;
+    config.dimensions = Vector3(0.5f, 0.5f, 0.5f);
+    return config;
+}
+
+Matrix4 CreateDecalTransform()
+{
+    // Decal box crosses top face of the box
+    return Matrix4::MakeTranslation(Vector3(0.5f, 0.5f, 1.0f));
+}
+
+PolygonGroup* GetDecalGeometry(RenderObject* object)
+{
+    RenderBatch* sourceBatch = object->GetRenderBatch(0);
+    for (uint32 i = 0; i < object->GetActiveRenderBatchCount(); ++i)
+    {
+        RenderBatch* batch = object->GetActiveRenderBatch(i);
+        if (batch != sourceBatch)
+        {
+            return batch->GetPolygonGroup();
+        }
+    }
+    return nullptr;
+}
+
+bool IsSameGeometry(PolygonGroup* pg1, PolygonGroup* pg2)
+{
+    if (pg1->GetFormat() != pg2->GetFormat() || pg1->GetVertexCount() != pg2->GetVertexCount())
+    {
+        return false;
+    }
+
+    for (int32 i = 0; i < pg1->GetVertexCount(); ++i)
+    {
+        Vector3 coord1, coord2;
+        pg1->GetCoord(i, coord1);
+        pg2->GetCoord(i, coord2);
+        Vector2 decalCoord1, decalCoord2;
+        pg1->GetTexcoord(3, i, decalCoord1);
+        pg2->GetTexcoord(3, i, decalCoord2);
+        if (coord1 != coord2 || decalCoord1 != decalCoord2)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+DAVA_TESTCLASS (GeoDecalManagerTest)
+{
+    DAVA_TEST (AsyncBuildMatchesSyncBuild)
+    {
+        using namespace GeoDecalManagerTestDetails;
+
+        ScopedPtr<RenderObject> syncObject(CreateBoxObject());
+        ScopedPtr<RenderObject> asyncObject(CreateBoxObject());
+        GeoDecalManager manager;
+
+        GeoDecalManager::Decal syncDecal = manager.BuildDecal(CreateDecalConfig(), CreateDecalTransform(), syncObject);
+        GeoDecalManager::Decal asyncDecal = manager.BuildDecalAsync(CreateDecalConfig(), CreateDecalTransform(), asyncObject);
+        TEST_VERIFY(syncDecal != GeoDecalManager::InvalidDecal);
+        TEST_VERIFY(asyncDecal != GeoDecalManager::InvalidDecal);
+        TEST_VERIFY(syncDecal != asyncDecal);
+        TEST_VERIFY(!manager.IsDecalBuilding(syncDecal));
+
+        GetEngineContext()->jobManager->WaitWorkerJobs();
+        manager.ApplyBuiltDecals();
+        TEST_VERIFY(!manager.IsDecalBuilding(asyncDecal));
+
+        PolygonGroup* syncGeometry = GetDecalGeometry(syncObject);
+        PolygonGroup* asyncGeometry = GetDecalGeometry(asyncObject);
+        TEST_VERIFY(syncGeometry != nullptr && syncGeometry->GetVertexCount() > 0);
+        TEST_VERIFY(asyncGeometry != nullptr);
+        if (syncGeometry != nullptr && asyncGeometry != nullptr)
+        {
+            TEST_VERIFY(IsSameGeometry(syncGeometry, asyncGeometry));
+        }
+
+        manager.DeleteDecal(syncDecal);
+        manager.DeleteDecal(asyncDecal);
+        TEST_VERIFY(syncObject->GetActiveRenderBatchCount() == 1);
+        TEST_VERIFY(asyncObject->GetActiveRenderBatchCount() == 1);
+    }
+
+    DAVA_TEST (DecalRemovedWhileBuilding)
+    {
+        using namespace GeoDecalManagerTestDetails;
+
+        GeoDecalManager manager;
+
+        // Decal is deleted and its object is released by owner before build job completes
+        RenderObject* deletedDecalObject = CreateBoxObject();
+        GeoDecalManager::Decal deletedDecal = manager.BuildDecalAsync(CreateDecalConfig(), CreateDecalTransform(), deletedDecalObject);
+        manager.DeleteDecal(deletedDecal);
+        TEST_VERIFY(!manager.IsDecalBuilding(deletedDecal));
+        SafeRelease(deletedDecalObject);
+
+        // Object is removed from manager before build job completes
+        ScopedPtr<RenderObject> removedObject(CreateBoxObject());
+        manager.BuildDecalAsync(CreateDecalConfig(), CreateDecalTransform(), removedObject);
+        manager.RemoveRenderObject(removedObject);
+
+        GetEngineContext()->jobManager->WaitWorkerJobs();
+        manager.ApplyBuiltDecals();
+        TEST_VERIFY(removedObject->GetActiveRenderBatchCount() == 1);
+
+        // Manager is destroyed while decal is building
+        ScopedPtr<RenderObject> object(CreateBoxObject());
+        {
+            GeoDecalManager destroyedManager;
+            destroyedManager.BuildDecalAsync(CreateDecalConfig(), CreateDecalTransform(), object);
+        }
+        TEST_VERIFY(object->GetActiveRenderBatchCount() == 1);
+    }
+};
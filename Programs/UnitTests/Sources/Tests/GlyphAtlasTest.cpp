@@ -0,0 +1,146 @@
+#include "DAVAEngine.h"
+
+#include "Render/2D/GlyphAtlas.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (GlyphAtlasTest)
+{
+    // 10x10 glyphs take 11x11 with margin, so 5 shelves of 5 glyphs fill 64x64 atlas
+    const uint32 ATLAS_SIZE = 64;
+    const int32 GLYPH_SIZE = 10;
+    const uint32 GLYPHS_PER_ATLAS = 25;
+
+    int32 fontStub = 0;
+
+    DAVA_TEST (PackingUntilFull)
+    {
+        GlyphAtlas atlas(ATLAS_SIZE);
+        uint32 generation = atlas.GetGeneration();
+
+        for (uint32 i = 0; i < GLYPHS_PER_ATLAS; ++i)
+        {
+            TEST_VERIFY(AddGlyph(atlas, i, GLYPH_SIZE, GLYPH_SIZE) != nullptr);
+        }
+        TEST_VERIFY(atlas.GetGlyphsCount() == GLYPHS_PER_ATLAS);
+        TEST_VERIFY(atlas.GetGeneration() == generation);
+        TEST_VERIFY(IsPackingValid(atlas));
+
+        // no room for next glyph without eviction
+        int32 x = 0;
+        int32 y = 0;
+        TEST_VERIFY(!atlas.Allocate(GLYPH_SIZE, GLYPH_SIZE, x, y));
+
+        // glyph larger than atlas never fits
+        TEST_VERIFY(AddGlyph(atlas, GLYPHS_PER_ATLAS, ATLAS_SIZE, ATLAS_SIZE) == nullptr);
+    }
+
+    DAVA_TEST (EvictionOfLeastRecentlyUsed)
+    {
+        GlyphAtlas atlas(ATLAS_SIZE);
+        for (uint32 i = 0; i < GLYPHS_PER_ATLAS; ++i)
+        {
+            AddGlyph(atlas, i, GLYPH_SIZE, GLYPH_SIZE);
+        }
+
+        // first glyph becomes most recently used, so second one is least recently used
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(0)) != nullptr);
+
+        uint32 generation = atlas.GetGeneration();
+        TEST_VERIFY(AddGlyph(atlas, GLYPHS_PER_ATLAS, GLYPH_SIZE, GLYPH_SIZE) != nullptr);
+        TEST_VERIFY(atlas.GetGeneration() == generation + 1);
+
+        TEST_VERIFY(atlas.GetGlyphsCount() < GLYPHS_PER_ATLAS);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(1)) == nullptr);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(0)) != nullptr);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(GLYPHS_PER_ATLAS)) != nullptr);
+        TEST_VERIFY(atlas.FindGlyph(MakeKey(GLYPHS_PER_ATLAS - 1)) != nullptr);
+        TEST_VERIFY(IsPackingValid(atlas));
+    }
+
+    DAVA_TEST (DirtyRectCombinesUploads)
+    {
+        GlyphAtlas atlas(ATLAS_SIZE);
+        TEST_VERIFY(atlas.dirtyMaxX <= atlas.dirtyMinX && atlas.dirtyMaxY <= atlas.dirtyMinY);
+
+        AddGlyph(atlas, 0, GLYPH_SIZE, GLYPH_SIZE);
+        AddGlyph(atlas, 1, GLYPH_SIZE, GLYPH_SIZE);
+        AddGlyph(atlas, 2, 2 * GLYPH_SIZE, 2 * GLYPH_SIZE);
+
+        int32 minX = int32(ATLAS_SIZE), minY = int32(ATLAS_SIZE), maxX = 0, maxY = 0;
+        for (const auto& item : atlas.glyphs)
+        {
+            const GlyphAtlas::GlyphEntry& entry = item.second;
+            minX = Min(minX, entry.x);
+            minY = Min(minY, entry.y);
+            maxX = Max(maxX, entry.x + entry.glyph.width);
+            maxY = Max(maxY, entry.y + entry.glyph.height);
+        }
+        TEST_VERIFY(atlas.dirtyMinX == minX && atlas.dirtyMinY == minY);
+        TEST_VERIFY(atlas.dirtyMaxX == maxX && atlas.dirtyMaxY == maxY);
+
+        // glyphs added after upload make new rect
+        atlas.ResetDirtyRect();
+        const GlyphAtlas::GlyphEntry& entry = AddGlyphEntry(atlas, 3, GLYPH_SIZE, GLYPH_SIZE);
+        TEST_VERIFY(atlas.dirtyMinX == entry.x && atlas.dirtyMinY == entry.y);
+        TEST_VERIFY(atlas.dirtyMaxX == entry.x + GLYPH_SIZE && atlas.dirtyMaxY == entry.y + GLYPH_SIZE);
+    }
+
+    GlyphAtlas::GlyphKey MakeKey(uint32 glyphIndex)
+    {
+        GlyphAtlas::GlyphKey key;
+        key.font = &fontStub;
+        key.size = 16.f;
+        key.glyphIndex = glyphIndex;
+        return key;
+    }
+
+    // Glyph pixels are filled with its index, so packed pixels can be checked
+    const GlyphAtlas::Glyph* AddGlyph(GlyphAtlas & atlas, uint32 glyphIndex, int32 width, int32 height)
+    {
+        FTFont::GlyphBitmap bitmap;
+        bitmap.width = width;
+        bitmap.height = height;
+        bitmap.data.assign(width * height, uint8(glyphIndex + 1));
+        return atlas.AddGlyph(MakeKey(glyphIndex), bitmap);
+    }
+
+    const GlyphAtlas::GlyphEntry& AddGlyphEntry(GlyphAtlas & atlas, uint32 glyphIndex, int32 width, int32 height)
+    {
+        AddGlyph(atlas, glyphIndex, width, height);
+        return atlas.glyphs.find(MakeKey(glyphIndex))->second;
+    }
+
+    // Glyphs are inside atlas, don't overlap and their pixels are in place
+    bool IsPackingValid(const GlyphAtlas& atlas)
+    {
+        Vector<Rect> regions;
+        for (const auto& item : atlas.glyphs)
+        {
+            const GlyphAtlas::GlyphEntry& entry = item.second;
+            Rect region(float32(entry.x), float32(entry.y), float32(entry.glyph.width), float32(entry.glyph.height));
+            if (entry.x < 0 || entry.y < 0 || entry.x + entry.glyph.width > int32(ATLAS_SIZE) || entry.y + entry.glyph.height > int32(ATLAS_SIZE))
+                return false;
+
+            for (const Rect& other : regions)
+            {
+                if (region.RectIntersects(other))
+                    return false;
+            }
+            regions.push_back(region);
+
+            uint8 value = uint8(item.first.glyphIndex + 1);
+            for (int32 y = 0; y < entry.glyph.height; ++y)
+            {
+                for (int32 x = 0; x < entry.glyph.width; ++x)
+                {
+                    if (atlas.pixels[(entry.y + y) * ATLAS_SIZE + entry.x + x] != value)
+                        return false;
+                }
+            }
+        }
+        return true;
+    }
+};
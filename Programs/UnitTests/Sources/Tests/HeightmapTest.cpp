@@ -0,0 +1,100 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/Heightmap.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (HeightmapTest)
+{
+    const int32 HEIGHTMAP_SIZE = 128;
+    const FilePath HEIGHTMAP_PATH = FilePath("~doc:/UnitTests/HeightmapTest/test.heightmap");
+
+    void FillHeights(Heightmap * heightmap)
+    {
+        uint16* data = heightmap->Data();
+        for (int32 y = 0; y < HEIGHTMAP_SIZE; ++y)
+        {
+            for (int32 x = 0; x < HEIGHTMAP_SIZE; ++x)
+            {
+                //smooth hills with a cliff and a few spikes to check residuals of any magnitude
+                float32 hill = 20000.f + 15000.f * std::sin(float32(x) * 0.05f) * std::cos(float32(y) * 0.07f);
+                uint16 height = uint16(hill) + ((x > HEIGHTMAP_SIZE / 2) ? 10000 : 0);
+                if ((x * 7 + y * 13) % 97 == 0)
+                    height = (x & 1) ? 0 : uint16(Heightmap::MAX_VALUE);
+
+                data[y * HEIGHTMAP_SIZE + x] = height;
+            }
+        }
+    }
+
+    DAVA_TEST (SaveAndLoadKeepsHeights)
+    {
+        FileSystem::Instance()->CreateDirectory(HEIGHTMAP_PATH.GetDirectory(), true);
+
+        ScopedPtr<Heightmap> heightmap(new Heightmap(HEIGHTMAP_SIZE));
+        heightmap->SetTileSize(32);
+        FillHeights(heightmap);
+
+        Vector<uint32> tangentBasis(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE, 0x80FF8080);
+        heightmap->SetTangentBasisData(Vector3(100.f, 100.f, 20.f), tangentBasis);
+        heightmap->Save(HEIGHTMAP_PATH);
+
+        ScopedPtr<Heightmap> loaded(new Heightmap());
+        TEST_VERIFY(loaded->Load(HEIGHTMAP_PATH));
+        TEST_VERIFY(loaded->Size() == HEIGHTMAP_SIZE);
+        TEST_VERIFY(loaded->GetTileSize() == 32);
+        TEST_VERIFY(Memcmp(loaded->Data(), heightmap->Data(), HEIGHTMAP_SIZE * HEIGHTMAP_SIZE * sizeof(uint16)) == 0);
+
+        Vector<uint32> loadedBasis;
+        TEST_VERIFY(!loaded->GetTangentBasisData(Vector3(200.f, 100.f, 20.f), loadedBasis));
+        TEST_VERIFY(loaded->GetTangentBasisData(Vector3(100.f, 100.f, 20.f), loadedBasis));
+        TEST_VERIFY(loadedBasis == tangentBasis);
+
+        ScopedPtr<File> file(File::Create(HEIGHTMAP_PATH, File::OPEN | File::READ));
+        TEST_VERIFY(file->GetSize() < uint64(HEIGHTMAP_SIZE * HEIGHTMAP_SIZE * sizeof(uint16)));
+        file.reset();
+
+        FileSystem::Instance()->DeleteFile(HEIGHTMAP_PATH);
+    }
+
+    DAVA_TEST (LoadsNotDeflatedTiles)
+    {
+        FileSystem::Instance()->CreateDirectory(HEIGHTMAP_PATH.GetDirectory(), true);
+
+        // single tile of constant height stored with raw planes: only first residual is non-zero
+        const int32 mapSize = 16;
+        const uint16 height = 1000;
+        const uint32 rawTileFlag = 1u << 31;
+
+        Vector<uint8> planes(mapSize * mapSize * 2, 0);
+        uint16 encoded = uint16(height << 1);
+        planes[0] = uint8(encoded >> 8);
+        planes[mapSize * mapSize] = uint8(encoded & 0xFF);
+
+        ScopedPtr<File> file(File::Create(HEIGHTMAP_PATH, File::CREATE | File::WRITE));
+        uint32 signature = Heightmap::FILE_SIGNATURE;
+        uint32 version = Heightmap::FILE_VERSION;
+        uint32 tileDataSize = uint32(planes.size()) | rawTileFlag;
+        uint32 tangentBasisDataSize = 0;
+        file->Write(&signature);
+        file->Write(&version);
+        file->Write(&mapSize);
+        file->Write(&mapSize);
+        file->Write(&tileDataSize);
+        file->Write(planes.data(), uint32(planes.size()));
+        file->Write(&tangentBasisDataSize);
+        file.reset();
+
+        ScopedPtr<Heightmap> loaded(new Heightmap());
+        TEST_VERIFY(loaded->Load(HEIGHTMAP_PATH));
+        TEST_VERIFY(loaded->Size() == mapSize);
+        for (int32 i = 0; i < mapSize * mapSize; ++i)
+        {
+            TEST_VERIFY(loaded->Data()[i] == height);
+        }
+
+        FileSystem::Instance()->DeleteFile(HEIGHTMAP_PATH);
+    }
+};
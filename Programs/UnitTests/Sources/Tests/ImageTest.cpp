@@ -107,4 +107,74 @@ DAVA_TESTCLASS (ImageTest)
             }
         }
     }
+
+    DAVA_TEST (ConvertLargeImageTest)
+    {
+        // big enough to be split between worker jobs, width is not multiple of SIMD block size
+        const uint32 width = 1023;
+        const uint32 height = 301;
+
+        ScopedPtr<Image> source(Image::Create(width, height, FORMAT_RGBA8888));
+        for (uint32 i = 0; i < source->GetDataSize(); ++i)
+        {
+            source->data[i] = static_cast<uint8>(Random::Instance()->Rand(256));
+        }
+        const uint32* sourcePixels = reinterpret_cast<const uint32*>(source->data);
+
+        ScopedPtr<Image> rgba4444(Image::Create(width, height, FORMAT_RGBA4444));
+        TEST_VERIFY(ImageConvert::ConvertImageDirect(source, rgba4444));
+        ScopedPtr<Image> rgb565(Image::Create(width, height, FORMAT_RGB565));
+        TEST_VERIFY(ImageConvert::ConvertImageDirect(source, rgb565));
+
+        const uint16* rgba4444Pixels = reinterpret_cast<const uint16*>(rgba4444->data);
+        const uint16* rgb565Pixels = reinterpret_cast<const uint16*>(rgb565->data);
+        for (uint32 i = 0; i < width * height; ++i)
+        {
+            uint16 expected4444 = 0;
+            ConvertRGBA8888toRGBA4444()(sourcePixels + i, &expected4444);
+            uint16 expected565 = 0;
+            ConvertRGBA8888toRGB565()(sourcePixels + i, &expected565);
+            if (rgba4444Pixels[i] != expected4444 || rgb565Pixels[i] != expected565)
+            {
+                TEST_VERIFY_WITH_MESSAGE(false, Format("Pixel %u", i));
+                break;
+            }
+        }
+
+        ScopedPtr<Image> swapped(Image::Create(width, height, FORMAT_RGBA8888));
+        ImageConvert::SwapRedBlueChannels(source, swapped);
+        ImageConvert::SwapRedBlueChannels(swapped);
+        TEST_VERIFY(Memcmp(source->data, swapped->data, source->GetDataSize()) == 0);
+
+        ScopedPtr<Image> downscaled(ImageConvert::DownscaleTwiceBillinear(source));
+        TEST_VERIFY(downscaled);
+        // Single call of scalar convert over the whole image is a reference for row blocks processed by jobs
+        ScopedPtr<Image> expected(Image::Create(width / 2, height / 2, FORMAT_RGBA8888));
+        ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
+        convert(source->data, width, height, width * sizeof(uint32), expected->data, expected->width, expected->height, expected->width * sizeof(uint32));
+        TEST_VERIFY(downscaled->width == expected->width && downscaled->height == expected->height);
+        TEST_VERIFY(Memcmp(downscaled->data, expected->data, expected->GetDataSize()) == 0);
+    }
+
+    DAVA_TEST (GammaCorrectDownscaleTest)
+    {
+        ScopedPtr<Image> source(Image::Create(8, 8, FORMAT_RGBA8888));
+        uint32* pixels = reinterpret_cast<uint32*>(source->data);
+        for (uint32 i = 0; i < 64; ++i)
+        {
+            // checkerboard of black and white pixels
+            pixels[i] = (((i % 8) + (i / 8)) % 2 == 0) ? 0xFF000000 : 0xFFFFFFFF;
+        }
+
+        ScopedPtr<Image> linear(ImageConvert::DownscaleTwiceBillinear(source, false, false));
+        ScopedPtr<Image> gamma(ImageConvert::DownscaleTwiceBillinear(source, false, true));
+        TEST_VERIFY(linear && gamma);
+
+        // average of black and white is 0.5 in linear space, that is ~188 in sRGB
+        uint32 linearPixel = reinterpret_cast<uint32*>(linear->data)[0];
+        uint32 gammaPixel = reinterpret_cast<uint32*>(gamma->data)[0];
+        TEST_VERIFY((linearPixel & 0xFF) == 127);
+        TEST_VERIFY(Abs(int32(gammaPixel & 0xFF) - 188) <= 1);
+        TEST_VERIFY((gammaPixel >> 24) == 0xFF);
+    }
 };
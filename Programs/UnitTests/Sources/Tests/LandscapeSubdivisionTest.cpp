@@ -0,0 +1,196 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/Heightmap.h"
+#include "Render/Highlevel/LandscapeSubdivision.h"
+#include "Render/RHI/rhi_Public.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (LandscapeSubdivisionTest)
+{
+    const int32 HEIGHTMAP_SIZE = 256;
+    const uint32 PATCH_SIZE_QUADS = 8;
+
+    DAVA_TEST (BatchedSubdivisionMatchesPerPatchSubdivision)
+    {
+        ScopedPtr<Heightmap> heightmap(CreateHeightmap());
+        LandscapeSubdivision subdivision;
+        subdivision.BuildSubdivision(heightmap, AABBox3(Vector3(-512.f, -512.f, 0.f), Vector3(512.f, 512.f, 100.f)), PATCH_SIZE_QUADS, 0, true);
+
+        // far camera looking over landscape, camera above landscape and camera with landscape partially clipped
+        Matrix4 worldTransform = Matrix4::IDENTITY;
+        Vector<std::pair<Vector3, Vector3>> cameras = {
+            { Vector3(0.f, -700.f, 300.f), Vector3(0.f, 0.f, 0.f) },
+            { Vector3(10.f, 20.f, 60.f), Vector3(200.f, 300.f, 0.f) },
+            { Vector3(-400.f, -400.f, 20.f), Vector3(-400.f, 400.f, 20.f) }
+        };
+
+        for (const auto& position : cameras)
+        {
+            ScopedPtr<Camera> camera(CreateCamera(position.first, position.second));
+            subdivision.PrepareSubdivision(camera, &worldTransform);
+            TEST_VERIFY(SubdivisionMatchesReference(subdivision, camera, worldTransform));
+        }
+    }
+
+    DAVA_TEST (AsyncSubdivisionIsAppliedOnNextPrepare)
+    {
+        ScopedPtr<Heightmap> heightmap(CreateHeightmap());
+        LandscapeSubdivision subdivision;
+        subdivision.BuildSubdivision(heightmap, AABBox3(Vector3(-512.f, -512.f, 0.f), Vector3(512.f, 512.f, 100.f)), PATCH_SIZE_QUADS, 0, true);
+        subdivision.SetAsyncSubdivision(true);
+
+        Matrix4 worldTransform = Matrix4::IDENTITY;
+        ScopedPtr<Camera> camera(CreateCamera(Vector3(0.f, -700.f, 300.f), Vector3(0.f, 0.f, 0.f)));
+
+        // first subdivision is computed in place, there is no previous result to render
+        subdivision.PrepareSubdivision(camera, &worldTransform);
+        TEST_VERIFY(subdivision.asyncState == nullptr);
+        TEST_VERIFY(SubdivisionMatchesReference(subdivision, camera, worldTransform));
+
+        // moved camera starts job, previous result stays until it is applied
+        uint32 firstUpdateID = subdivision.updateID;
+        camera->SetPosition(Vector3(10.f, 20.f, 60.f));
+        subdivision.PrepareSubdivision(camera, &worldTransform);
+        TEST_VERIFY(subdivision.asyncState != nullptr);
+        TEST_VERIFY(subdivision.updateID == firstUpdateID);
+
+        subdivision.ApplyAsyncSubdivision();
+        TEST_VERIFY(subdivision.asyncState == nullptr);
+        TEST_VERIFY(subdivision.updateID != firstUpdateID);
+        TEST_VERIFY(SubdivisionMatchesReference(subdivision, camera, worldTransform));
+
+        // still camera doesn't start job
+        subdivision.PrepareSubdivision(camera, &worldTransform);
+        TEST_VERIFY(subdivision.asyncState == nullptr);
+
+        // disabling async mode applies pending result
+        camera->SetPosition(Vector3(-400.f, -400.f, 20.f));
+        subdivision.PrepareSubdivision(camera, &worldTransform);
+        TEST_VERIFY(subdivision.asyncState != nullptr);
+        subdivision.SetAsyncSubdivision(false);
+        TEST_VERIFY(subdivision.asyncState == nullptr);
+        TEST_VERIFY(SubdivisionMatchesReference(subdivision, camera, worldTransform));
+    }
+
+    Heightmap* CreateHeightmap()
+    {
+        Heightmap* heightmap = new Heightmap(HEIGHTMAP_SIZE);
+        uint16* data = heightmap->Data();
+        for (int32 y = 0; y < HEIGHTMAP_SIZE; ++y)
+        {
+            for (int32 x = 0; x < HEIGHTMAP_SIZE; ++x)
+            {
+                float32 height = 0.5f + 0.25f * std::sin(x * 0.11f) * std::cos(y * 0.07f) + 0.2f * std::sin((x + y) * 0.53f);
+                data[y * HEIGHTMAP_SIZE + x] = uint16(height * Heightmap::MAX_VALUE);
+            }
+        }
+        return heightmap;
+    }
+
+    Camera* CreateCamera(const Vector3& position, const Vector3& target)
+    {
+        Camera* camera = new Camera();
+        camera->SetupPerspective(70.f, 1.5f, 1.f, 5000.f);
+        camera->SetUp(Vector3(0.f, 0.f, 1.f));
+        camera->SetPosition(position);
+        camera->SetTarget(target);
+        return camera;
+    }
+
+    // Compares applied subdivision with result of recursive per-patch subdivision for the same camera
+    bool SubdivisionMatchesReference(const LandscapeSubdivision& subdivision, Camera* camera, const Matrix4& worldTransform)
+    {
+        ScopedPtr<Frustum> frustum(new Frustum());
+        frustum->Build(worldTransform * camera->GetViewProjMatrix(), rhi::DeviceCaps().isZeroBaseClipRange);
+
+        Vector<LandscapeSubdivision::SubdivisionPatchInfo> referencePatches(subdivision.subdivPatchCount);
+        uint32 referenceTerminatedCount = 0;
+        SubdividePatchReference(subdivision, frustum, camera->GetPosition(), referencePatches, referenceTerminatedCount, 0, 0, 0, 0x3f,
+                                subdivision.maxHeightError, subdivision.maxPatchRadiusError);
+
+        if (referenceTerminatedCount != subdivision.terminatedPatchesCount)
+        {
+            return false;
+        }
+
+        for (uint32 i = 0; i < subdivision.subdivPatchCount; ++i)
+        {
+            const LandscapeSubdivision::SubdivisionPatchInfo& reference = referencePatches[i];
+            const LandscapeSubdivision::SubdivisionPatchInfo& patch = subdivision.subdivPatchArray[i];
+
+            bool isVisited = (reference.lastUpdateID != 0);
+            if (isVisited != (patch.lastUpdateID == subdivision.updateID))
+            {
+                return false;
+            }
+
+            if (isVisited && (reference.subdivisionState != patch.subdivisionState || reference.startClipPlane != patch.startClipPlane))
+            {
+                return false;
+            }
+
+            if (isVisited && reference.subdivisionState == LandscapeSubdivision::SubdivisionPatchInfo::TERMINATED && Abs(reference.subdivMorph - patch.subdivMorph) > 1e-5f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Recursive subdivision as it was implemented before level-by-level batching, visited patches are marked with `lastUpdateID` 1
+    void SubdividePatchReference(const LandscapeSubdivision& subdivision, Frustum* frustum, const Vector3& cameraPos, Vector<LandscapeSubdivision::SubdivisionPatchInfo>& patches,
+                                 uint32& terminatedCount, uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0)
+    {
+        const LandscapeSubdivision::SubdivisionLevelInfo& levelInfo = subdivision.subdivLevelInfoArray[level];
+        uint32 offset = levelInfo.offset + (y << level) + x;
+        const LandscapeSubdivision::PatchQuadInfo& patch = subdivision.patchQuadArray[offset];
+        LandscapeSubdivision::SubdivisionPatchInfo& patchInfo = patches[offset];
+        patchInfo.lastUpdateID = 1;
+
+        if (clippingFlags && frustum->Classify(patch.bbox, clippingFlags, patchInfo.startClipPlane) == Frustum::EFR_OUTSIDE)
+        {
+            patchInfo.subdivisionState = LandscapeSubdivision::SubdivisionPatchInfo::CLIPPED;
+            return;
+        }
+
+        float32 tanFovY = subdivision.tanFovY;
+        float32 heightError = Abs(patch.maxError) / (Distance(cameraPos, patch.positionOfMaxError) * tanFovY);
+        float32 radiusError = patch.radius / (Distance(cameraPos, patch.bbox.GetCenter()) * tanFovY);
+
+        float32 maxHeightError = subdivision.maxHeightError;
+        float32 maxPatchRadiusError = subdivision.maxPatchRadiusError;
+        if ((level < subdivision.subdivLevelCount - 1) && ((maxPatchRadiusError <= radiusError) || (maxHeightError <= heightError) || (subdivision.maxAbsoluteHeightError < Abs(patch.maxError)) || (subdivision.minSubdivLevel > level) || subdivision.forceMaxSubdiv))
+        {
+            patchInfo.subdivisionState = LandscapeSubdivision::SubdivisionPatchInfo::SUBDIVIDED;
+
+            uint32 x2 = x << 1;
+            uint32 y2 = y << 1;
+
+            SubdividePatchReference(subdivision, frustum, cameraPos, patches, terminatedCount, level + 1, x2 + 0, y2 + 0, clippingFlags, heightError, radiusError);
+            SubdividePatchReference(subdivision, frustum, cameraPos, patches, terminatedCount, level + 1, x2 + 1, y2 + 0, clippingFlags, heightError, radiusError);
+            SubdividePatchReference(subdivision, frustum, cameraPos, patches, terminatedCount, level + 1, x2 + 0, y2 + 1, clippingFlags, heightError, radiusError);
+            SubdividePatchReference(subdivision, frustum, cameraPos, patches, terminatedCount, level + 1, x2 + 1, y2 + 1, clippingFlags, heightError, radiusError);
+        }
+        else
+        {
+            float32 radiusError0Rel = Max(radiusError0, maxPatchRadiusError) / maxPatchRadiusError;
+            float32 radiusErrorRel = Min(radiusError, maxPatchRadiusError) / maxPatchRadiusError;
+
+            float32 heightError0Rel = Max(heightError0, maxHeightError) / maxHeightError;
+            float32 heightErrorRel = Min(heightError, maxHeightError) / maxHeightError;
+
+            float32 error0Delta = Max(radiusError0Rel, heightError0Rel) - 1.f;
+            float32 errorDelta = 1.f - Max(radiusErrorRel, heightErrorRel);
+
+            patchInfo.subdivMorph = 1.f - errorDelta / (error0Delta + errorDelta);
+            patchInfo.subdivisionState = LandscapeSubdivision::SubdivisionPatchInfo::TERMINATED;
+
+            terminatedCount++;
+        }
+    }
+};
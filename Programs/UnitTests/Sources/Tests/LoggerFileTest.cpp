@@ -49,5 +49,63 @@ DAVA_TESTCLASS (LoggerFileTest)
             }
         }
     }
+
+    DAVA_TEST (AsyncModeTest)
+    {
+        const String filename("TestAsyncLogFile.txt");
+        const FilePath logFilePath(Logger::GetLogPathForFilename(filename));
+        FileSystem::Instance()->DeleteFile(logFilePath);
+
+        Logger* logger = GetEngineContext()->logger;
+        logger->SetLogFilename(filename);
+        logger->SetAsyncMode(true);
+        TEST_VERIFY(logger->IsAsyncMode());
+
+        const uint32 messagesCount = 100;
+        for (uint32 i = 0; i < messagesCount; ++i)
+        {
+            Logger::Info("async message %u", i);
+        }
+        Logger::Flush();
+
+        String content = FileSystem::Instance()->ReadFileContents(logFilePath);
+        TEST_VERIFY(content.find("async message 0\n") != String::npos);
+        TEST_VERIFY(content.find(Format("async message %u\n", messagesCount - 1)) != String::npos);
+
+        logger->SetAsyncMode(false);
+        TEST_VERIFY(!logger->IsAsyncMode());
+        logger->SetLogFilename(String());
+    }
+
+    DAVA_TEST (AsyncModeFlushOnCrashTest)
+    {
+        const FilePath firstLogPath(Logger::GetLogPathForFilename("TestAsyncCrashLogFile1.txt"));
+        const FilePath secondLogPath(Logger::GetLogPathForFilename("TestAsyncCrashLogFile2.txt"));
+        FileSystem::Instance()->DeleteFile(firstLogPath);
+        FileSystem::Instance()->DeleteFile(secondLogPath);
+
+        Logger* logger = GetEngineContext()->logger;
+        logger->SetLogFilename("TestAsyncCrashLogFile1.txt");
+        logger->SetAsyncMode(true);
+
+        // Messages queued before log file is changed are written to the file they were logged to
+        Logger::Info("crash message first");
+        logger->SetLogFilename("TestAsyncCrashLogFile2.txt");
+        Logger::Info("crash message second");
+        // Writer thread may hold queue at the moment, crash flush doesn't wait for it
+        while (!Logger::FlushOnCrash())
+        {
+            Thread::Sleep(1);
+        }
+
+        String firstContent = FileSystem::Instance()->ReadFileContents(firstLogPath);
+        String secondContent = FileSystem::Instance()->ReadFileContents(secondLogPath);
+        TEST_VERIFY(firstContent.find("crash message first\n") != String::npos);
+        TEST_VERIFY(secondContent.find("crash message second\n") != String::npos);
+        TEST_VERIFY(secondContent.find("crash message first") == String::npos);
+
+        logger->SetAsyncMode(false);
+        logger->SetLogFilename(String());
+    }
 }
 ;
@@ -9,6 +9,11 @@ using namespace DAVA;
 
 DAVA_TESTCLASS (MemoryManagerTest)
 {
+    // About 250 sampled blocks, so estimated size is within 25% of total size with high probability
+    static const uint32 SAMPLE_INTERVAL = 4096;
+    static const uint32 BLOCK_SIZE = 256;
+    static const uint32 BLOCK_COUNT = 4000;
+
     volatile uint32 capturedTag = 0;
     volatile uint32 capturedCheckpoint = 0;
 
@@ -114,6 +119,104 @@ DAVA_TESTCLASS (MemoryManagerTest)
         ::operator delete(buffer);
     }
 
+    DAVA_TEST (TestSamplingTotals)
+    {
+        MemoryManager* mm = MemoryManager::Instance();
+        mm->EnableSamplingMode(SAMPLE_INTERVAL);
+
+        Vector<void*> blocks;
+        blocks.reserve(BLOCK_COUNT * 2);
+
+        // Statistics of threads exited earlier are freed here, statistics of this thread are already created
+        mm->MergeThreadStats();
+        uint32 threadStatCount = mm->GetThreadStatCount();
+        AllocPoolStat oldStat = GetPoolStat(ALLOC_POOL_BULLET);
+
+        // Blocks allocated by other thread are freed by this one, so counters of both threads change
+        Thread* thread = Thread::Create([&blocks, mm]() {
+            for (uint32 i = 0; i < BLOCK_COUNT; ++i)
+            {
+                blocks.push_back(mm->Allocate(BLOCK_SIZE, ALLOC_POOL_BULLET));
+            }
+        });
+        thread->Start();
+        thread->Join();
+        thread->Release();
+
+        for (uint32 i = 0; i < BLOCK_COUNT; ++i)
+        {
+            blocks.push_back(mm->Allocate(BLOCK_SIZE, ALLOC_POOL_BULLET));
+        }
+
+        // Statistics of exited thread are merged and freed
+        mm->MergeThreadStats();
+        TEST_VERIFY(mm->GetThreadStatCount() == threadStatCount);
+
+        AllocPoolStat stat = GetPoolStat(ALLOC_POOL_BULLET);
+        TEST_VERIFY(stat.allocByApp == oldStat.allocByApp + 2 * BLOCK_COUNT * BLOCK_SIZE);
+        TEST_VERIFY(stat.blockCount == oldStat.blockCount + 2 * BLOCK_COUNT);
+        TEST_VERIFY(stat.maxBlockSize >= BLOCK_SIZE);
+
+        for (void* ptr : blocks)
+        {
+            mm->Deallocate(ptr);
+        }
+
+        mm->DisableSamplingMode();
+        stat = GetPoolStat(ALLOC_POOL_BULLET);
+        TEST_VERIFY(stat.allocByApp == oldStat.allocByApp);
+        TEST_VERIFY(stat.blockCount == oldStat.blockCount);
+    }
+
+    DAVA_TEST (TestSampledBlocks)
+    {
+        MemoryManager* mm = MemoryManager::Instance();
+        mm->EnableSamplingMode(SAMPLE_INTERVAL);
+
+        Vector<void*> blocks;
+        blocks.reserve(BLOCK_COUNT);
+        for (uint32 i = 0; i < BLOCK_COUNT; ++i)
+        {
+            blocks.push_back(mm->Allocate(BLOCK_SIZE, ALLOC_POOL_BULLET));
+        }
+
+        // Snapshot contains only sampled blocks, which are sampled on average once per sample interval
+        // and sum of their estimated sizes is close to total size of allocated blocks
+        uint32 sampledCount = 0;
+        uint64 estimatedSize = 0;
+        const FilePath snapshotPath("~doc:/MemoryManagerTest.snapshot");
+        {
+            ScopedPtr<File> file(File::Create(snapshotPath, File::CREATE | File::WRITE));
+            TEST_VERIFY(mm->GetMemorySnapshot(0, file));
+        }
+        {
+            ScopedPtr<File> file(File::Create(snapshotPath, File::OPEN | File::READ));
+            MMSnapshot snapshot;
+            TEST_VERIFY(file->Read(&snapshot) == sizeof(MMSnapshot));
+            for (uint32 i = 0; i < snapshot.blockCount; ++i)
+            {
+                MMBlock block;
+                file->Read(&block);
+                if (block.pool == ALLOC_POOL_BULLET && block.allocByApp == BLOCK_SIZE && block.estimatedSize != 0)
+                {
+                    sampledCount += 1;
+                    estimatedSize += block.estimatedSize;
+                }
+            }
+        }
+        FileSystem::Instance()->DeleteFile(snapshotPath);
+
+        const uint64 totalSize = uint64(BLOCK_COUNT) * BLOCK_SIZE;
+        TEST_VERIFY(0 < sampledCount && sampledCount < BLOCK_COUNT);
+        TEST_VERIFY(totalSize * 3 / 4 < estimatedSize && estimatedSize < totalSize * 5 / 4);
+
+        for (void* ptr : blocks)
+        {
+            mm->Deallocate(ptr);
+        }
+        mm->DisableSamplingMode();
+    }
+
     DAVA_TEST (TestCallback)
     {
         const uint32 TAG = 1;
@@ -127,6 +230,14 @@ DAVA_TESTCLASS (MemoryManagerTest)
         TEST_VERIFY(leftTag == TAG);
     }
 
+    AllocPoolStat GetPoolStat(uint32 poolIndex)
+    {
+        const size_t statSize = MemoryManager::Instance()->CalcCurStatSize();
+        Vector<uint8> buffer(statSize);
+        MemoryManager::Instance()->GetCurStat(0, buffer.data(), static_cast<uint32>(statSize));
+        return OffsetPointer<AllocPoolStat>(buffer.data(), sizeof(MMCurStat))[poolIndex];
+    }
+
     void TagCallback(uint32 tag, bool entering)
     {
         if (entering)
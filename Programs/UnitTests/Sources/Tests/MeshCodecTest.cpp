@@ -0,0 +1,56 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/3D/MeshCodec.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (MeshCodecTest)
+{
+    DAVA_TEST (EncodeDecodeTest)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 8.0f },
+            { FastName("segments.y"), 8.0f },
+            { FastName("segments.z"), 8.0f }
+        };
+
+        PolygonGroup* geometry = GeometryGenerator::GenerateBox(AABBox3(Vector3(-2.0f, -2.0f, -2.0f), Vector3(2.0f, 2.0f, 2.0f)), options);
+        uint32 vertexCount = uint32(geometry->GetVertexCount());
+        uint32 indexCount = uint32(geometry->GetIndexCount());
+        int32 vertexFormat = geometry->GetFormat();
+
+        Vector<uint8> encodedVertices;
+        Vector<uint8> encodedIndices;
+        TEST_VERIFY(MeshCodec::EncodeVertices(geometry->meshData, vertexCount, vertexFormat, encodedVertices));
+        TEST_VERIFY(MeshCodec::EncodeIndices(reinterpret_cast<uint16*>(geometry->indexArray), indexCount, encodedIndices));
+        TEST_VERIFY(encodedVertices.size() < vertexCount * geometry->vertexStride);
+
+        Vector<uint8> decodedVertices;
+        Vector<uint16> decodedIndices(indexCount);
+        TEST_VERIFY(MeshCodec::DecodeVertices(encodedVertices.data(), uint32(encodedVertices.size()), vertexCount, vertexFormat, decodedVertices));
+        TEST_VERIFY(MeshCodec::DecodeIndices(encodedIndices.data(), uint32(encodedIndices.size()), indexCount, decodedIndices.data()));
+        TEST_VERIFY(decodedVertices.size() == vertexCount * geometry->vertexStride);
+        TEST_VERIFY(Memcmp(decodedIndices.data(), geometry->indexArray, indexCount * sizeof(uint16)) == 0);
+
+        const float32 positionEpsilon = 4.0f / 65535.0f;
+        const float32 normalEpsilon = 1e-3f;
+        for (uint32 i = 0; i < vertexCount; ++i)
+        {
+            const uint8* vertex = decodedVertices.data() + i * geometry->vertexStride;
+            const Vector3& position = *reinterpret_cast<const Vector3*>(vertex);
+            Vector3 sourcePosition;
+            geometry->GetCoord(i, sourcePosition);
+            TEST_VERIFY((position - sourcePosition).Length() <= positionEpsilon * 2.0f);
+
+            if (vertexFormat & EVF_NORMAL)
+            {
+                const Vector3& normal = *reinterpret_cast<const Vector3*>(vertex + GetVertexSize(EVF_VERTEX));
+                Vector3 sourceNormal;
+                geometry->GetNormal(i, sourceNormal);
+                TEST_VERIFY((normal - sourceNormal).Length() <= normalEpsilon);
+            }
+        }
+
+        SafeRelease(geometry);
+    }
+};
@@ -0,0 +1,142 @@
+#include "UnitTests/UnitTests.h"
+#include "Render/3D/MeshUtils.h"
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Scene3D/Components/RenderComponent.h"
+#include "Scene3D/Entity.h"
+
+using namespace DAVA;
+
+namespace MeshUtilsTestDetails
+{
+using Triangle = Array<Vector3, 3>;
+
+bool PointLess(const Vector3& l, const Vector3& r)
+{
+    return std::tie(l.x, l.y, l.z) < std::tie(r.x, r.y, r.z);
+}
+
+bool TriangleLess(const Triangle& l, const Triangle& r)
+{
+    return std::lexicographical_compare(l.begin(), l.end(), r.begin(), r.end(), &PointLess);
+}
+
+Vector<Triangle> GetTriangles(PolygonGroup* pg)
+{
+    Vector<Triangle> triangles(pg->GetPrimitiveCount());
+    for (int32 t = 0; t < pg->GetPrimitiveCount(); ++t)
+    {
+        for (int32 k = 0; k < 3; ++k)
+        {
+            int32 index = 0;
+            pg->GetIndex(3 * t + k, index);
+            pg->GetCoord(index, triangles[t][k]);
+        }
+
+        // triangle winding is kept, so first vertex is chosen by position only
+        std::rotate(triangles[t].begin(), std::min_element(triangles[t].begin(), triangles[t].end(), &PointLess), triangles[t].end());
+    }
+    std::sort(triangles.begin(), triangles.end(), &TriangleLess);
+    return triangles;
+}
+
+PolygonGroup* GenerateBox()
+{
+    Map<FastName, float32> options = {
+        { FastName("segments.x"), 24.0f },
+        { FastName("segments.y"), 24.0f },
+        { FastName("segments.z"), 24.0f }
+    };
+
+    return GeometryGenerator::GenerateBox(AABBox3(Vector3(0.0f, 0.0f, 0.0f), Vector3(1.0f, 1.0f, 1.0f)), options);
+}
+
+Entity* CreateMeshEntity(PolygonGroup* geometry, const FastName& fxName)
+{
+    ScopedPtr<NMaterial> material(new NMaterial());
+    material->SetFXName(fxName);
+
+    ScopedPtr<RenderBatch> batch(new RenderBatch());
+    batch->SetPolygonGroup(geometry);
+    batch->SetMaterial(material);
+
+    ScopedPtr<RenderObject> object(new RenderObject());
+    object->AddRenderBatch(batch);
+
+    Entity* entity = new Entity();
+    entity->AddComponent(new RenderComponent(object));
+    return entity;
+}
+}
+
+DAVA_TESTCLASS (MeshUtilsTest)
+{
+    DAVA_TEST (OptimizeGeometryTest)
+    {
+        using namespace MeshUtilsTestDetails;
+
+        ScopedPtr<PolygonGroup> geometry(GenerateBox());
+        Vector<Triangle> trianglesBefore = GetTriangles(geometry);
+
+        MeshUtils::GeometryOptimizationResult result = MeshUtils::OptimizeGeometry(geometry);
+        TEST_VERIFY(result.optimized);
+        TEST_VERIFY(result.after.acmr <= result.before.acmr);
+        TEST_VERIFY(result.after.acmr < 1.0f);
+        TEST_VERIFY(result.vertexCountAfter <= result.vertexCountBefore);
+        TEST_VERIFY(result.vertexCountAfter == uint32(geometry->GetVertexCount()));
+
+        MeshUtils::VertexCacheStatistics statistics = MeshUtils::CalculateVertexCacheStatistics(geometry);
+        TEST_VERIFY(FLOAT_EQUAL(statistics.acmr, result.after.acmr));
+        TEST_VERIFY(FLOAT_EQUAL(statistics.atvr, result.after.atvr));
+
+        // the same triangles should be drawn after optimization
+        TEST_VERIFY(GetTriangles(geometry) == trianglesBefore);
+    }
+
+    DAVA_TEST (OptimizeDisconnectedTrianglesTest)
+    {
+        using namespace MeshUtilsTestDetails;
+
+        // every triangle is a dead end of cache optimization
+        const int32 triangleCount = 4000;
+        ScopedPtr<PolygonGroup> geometry(new PolygonGroup());
+        geometry->AllocateData(EVF_VERTEX, triangleCount * 3, triangleCount * 3);
+        for (int32 i = 0; i < triangleCount * 3; ++i)
+        {
+            geometry->SetCoord(i, Vector3(float32(i / 3), float32(i % 3), float32((i * 7) % 5)));
+            geometry->SetIndex(i, int16(i));
+        }
+        Vector<Triangle> trianglesBefore = GetTriangles(geometry);
+
+        MeshUtils::GeometryOptimizationResult result = MeshUtils::OptimizeGeometry(geometry);
+        TEST_VERIFY(result.optimized);
+        TEST_VERIFY(result.vertexCountAfter == uint32(triangleCount * 3));
+        TEST_VERIFY(GetTriangles(geometry) == trianglesBefore);
+    }
+
+    DAVA_TEST (OptimizeGeometryRecursiveSkipsBlendedGeometryTest)
+    {
+        using namespace MeshUtilsTestDetails;
+
+        ScopedPtr<PolygonGroup> opaqueGeometry(GenerateBox());
+        ScopedPtr<PolygonGroup> blendedGeometry(GenerateBox());
+        Vector<int16> blendedIndicesBefore(blendedGeometry->indexArray, blendedGeometry->indexArray + blendedGeometry->GetIndexCount());
+
+        ScopedPtr<Entity> root(new Entity());
+        ScopedPtr<Entity> opaqueEntity(CreateMeshEntity(opaqueGeometry, NMaterialName::TEXTURED_OPAQUE));
+        ScopedPtr<Entity> blendedEntity(CreateMeshEntity(blendedGeometry, NMaterialName::TEXTURED_ALPHABLEND));
+        root->AddNode(opaqueEntity);
+        opaqueEntity->AddNode(blendedEntity);
+
+        MeshUtils::GeometryOptimizationResult result = MeshUtils::OptimizeGeometryRecursive(root);
+        TEST_VERIFY(result.optimized);
+        TEST_VERIFY(result.vertexCountAfter == uint32(opaqueGeometry->GetVertexCount()));
+
+        // triangle order of blended geometry is visible and should be kept
+        Vector<int16> blendedIndicesAfter(blendedGeometry->indexArray, blendedGeometry->indexArray + blendedGeometry->GetIndexCount());
+        TEST_VERIFY(blendedIndicesAfter == blendedIndicesBefore);
+    }
+};
@@ -0,0 +1,122 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/OcclusionDepthRasterizer.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (OcclusionDepthRasterizerTest)
+{
+    // Square in plane y = distance facing camera at origin looking along +y
+    void MakeSquare(float32 distance, float32 halfSize, Vector3 * positions)
+    {
+        positions[0] = Vector3(-halfSize, distance, -halfSize);
+        positions[1] = Vector3(halfSize, distance, -halfSize);
+        positions[2] = Vector3(halfSize, distance, halfSize);
+        positions[3] = Vector3(-halfSize, distance, halfSize);
+    }
+
+    void SetupRasterizer(OcclusionDepthRasterizer & rasterizer)
+    {
+        Matrix4 view;
+        view.BuildLookAtMatrix(Vector3(0.0f, 0.0f, 0.0f), Vector3(0.0f, 1.0f, 0.0f), Vector3(0.0f, 0.0f, 1.0f));
+        Matrix4 projection;
+        projection.BuildPerspective(-1.0f, 1.0f, -1.0f, 1.0f, 1.0f, 1000.0f, false);
+
+        rasterizer.Resize(60, 60);
+        rasterizer.SetViewProjection(view * projection, 1.0f);
+    }
+
+    DAVA_TEST (SizeIsRoundedToTiles)
+    {
+        OcclusionDepthRasterizer rasterizer;
+        SetupRasterizer(rasterizer);
+        TEST_VERIFY(rasterizer.GetWidth() == 64);
+        TEST_VERIFY(rasterizer.GetHeight() == 64);
+    }
+
+    DAVA_TEST (OccluderHidesFartherGeometry)
+    {
+        const uint32 indices[] = { 0, 1, 2, 0, 2, 3 };
+        Vector3 occluder[4];
+        Vector3 farSquare[4];
+        Vector3 nearSquare[4];
+        MakeSquare(10.0f, 5.0f, occluder);
+        MakeSquare(50.0f, 5.0f, farSquare);
+        MakeSquare(5.0f, 1.0f, nearSquare);
+
+        OcclusionDepthRasterizer rasterizer;
+        SetupRasterizer(rasterizer);
+
+        uint32 farPixels = rasterizer.CountVisiblePixels(farSquare, indices, 6);
+        TEST_VERIFY(farPixels > 0);
+
+        rasterizer.RenderTriangles(occluder, indices, 6);
+        TEST_VERIFY(rasterizer.CountVisiblePixels(farSquare, indices, 6) == 0);
+        TEST_VERIFY(rasterizer.CountVisiblePixels(nearSquare, indices, 6) > 0);
+
+        // occluder covers central quarter of the screen and stays visible through its own depth
+        uint32 quarter = rasterizer.GetWidth() * rasterizer.GetHeight() / 4;
+        TEST_VERIFY(rasterizer.CountVisiblePixels(occluder, indices, 6) >= quarter);
+
+        rasterizer.Clear();
+        TEST_VERIFY(rasterizer.CountVisiblePixels(farSquare, indices, 6) == farPixels);
+    }
+
+    DAVA_TEST (BoxBehindOccluderIsInvisible)
+    {
+        const uint32 indices[] = { 0, 1, 2, 0, 2, 3 };
+        Vector3 occluder[4];
+        MakeSquare(10.0f, 5.0f, occluder);
+
+        OcclusionDepthRasterizer rasterizer;
+        SetupRasterizer(rasterizer);
+
+        AABBox3 hiddenBox(Vector3(-2.0f, 40.0f, -2.0f), Vector3(2.0f, 44.0f, 2.0f));
+        AABBox3 sideBox(Vector3(30.0f, 40.0f, -2.0f), Vector3(34.0f, 44.0f, 2.0f));
+        AABBox3 nearBox(Vector3(-1.0f, 4.0f, -1.0f), Vector3(1.0f, 6.0f, 1.0f));
+        AABBox3 cameraBox(Vector3(-1.0f, -1.0f, -1.0f), Vector3(1.0f, 1.0f, 1.0f));
+        TEST_VERIFY(rasterizer.IsBoxVisible(hiddenBox));
+
+        rasterizer.RenderTriangles(occluder, indices, 6);
+        TEST_VERIFY(!rasterizer.IsBoxVisible(hiddenBox));
+        TEST_VERIFY(rasterizer.IsBoxVisible(sideBox));
+        TEST_VERIFY(rasterizer.IsBoxVisible(nearBox));
+        TEST_VERIFY(rasterizer.IsBoxVisible(cameraBox));
+    }
+
+    DAVA_TEST (MergeKeepsClosestDepth)
+    {
+        const uint32 indices[] = { 0, 1, 2, 0, 2, 3 };
+        Vector3 leftOccluder[4] = { Vector3(-5.0f, 10.0f, -5.0f), Vector3(0.0f, 10.0f, -5.0f), Vector3(0.0f, 10.0f, 5.0f), Vector3(-5.0f, 10.0f, 5.0f) };
+        Vector3 rightOccluder[4] = { Vector3(0.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, -5.0f), Vector3(5.0f, 10.0f, 5.0f), Vector3(0.0f, 10.0f, 5.0f) };
+        AABBox3 hiddenBox(Vector3(-2.0f, 40.0f, -2.0f), Vector3(2.0f, 44.0f, 2.0f));
+
+        OcclusionDepthRasterizer left;
+        OcclusionDepthRasterizer right;
+        SetupRasterizer(left);
+        SetupRasterizer(right);
+        left.RenderTriangles(leftOccluder, indices, 6);
+        right.RenderTriangles(rightOccluder, indices, 6);
+        TEST_VERIFY(left.IsBoxVisible(hiddenBox));
+        TEST_VERIFY(right.IsBoxVisible(hiddenBox));
+
+        left.Merge(right);
+        TEST_VERIFY(!left.IsBoxVisible(hiddenBox));
+    }
+
+    DAVA_TEST (GeometryBehindNearPlaneIsClipped)
+    {
+        // triangle crossing camera plane covers lower half of the screen
+        const uint32 indices[] = { 0, 1, 2 };
+        Vector3 triangle[3] = { Vector3(-100.0f, -10.0f, -1.0f), Vector3(100.0f, -10.0f, -1.0f), Vector3(0.0f, 100.0f, -1.0f) };
+
+        OcclusionDepthRasterizer rasterizer;
+        SetupRasterizer(rasterizer);
+
+        uint32 pixels = rasterizer.CountVisiblePixels(triangle, indices, 3);
+        TEST_VERIFY(pixels > 0);
+        TEST_VERIFY(pixels <= rasterizer.GetWidth() * rasterizer.GetHeight());
+    }
+};
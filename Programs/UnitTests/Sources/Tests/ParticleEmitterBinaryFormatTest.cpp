@@ -0,0 +1,207 @@
+#include "DAVAEngine.h"
+
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleEmitterBinaryFormat.h"
+#include "Particles/ParticleForce.h"
+#include "Particles/ParticleLayer.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (ParticleEmitterBinaryFormatTest)
+{
+    DAVA_TEST (SaveAndLoadKeepsEmitter)
+    {
+        ScopedPtr<ParticleEmitter> emitter(new ParticleEmitter());
+        emitter->name = FastName("Sparks");
+        emitter->emitterType = ParticleEmitter::EMITTER_ONCIRCLE_EDGES;
+        emitter->lifeTime = 3.5f;
+        emitter->shortEffect = true;
+        emitter->radius.Set(new PropertyLineValue<float32>(2.0f));
+
+        RefPtr<PropertyLineKeyframes<Vector3>> emissionVector(new PropertyLineKeyframes<Vector3>());
+        emissionVector->AddValue(0.0f, Vector3(0.0f, 0.0f, 1.0f));
+        emissionVector->AddValue(1.0f, Vector3(1.0f, 0.0f, 0.0f));
+        emitter->emissionVector = emissionVector;
+
+        RefPtr<PropertyLine<Color>> colorOverLife(new PropertyLineValue<Color>(Color(1.0f, 0.5f, 0.25f, 1.0f)));
+        emitter->colorOverLife = PropertyLineHelper::MakeModifiable(colorOverLife);
+
+        ScopedPtr<ParticleLayer> layer(new ParticleLayer());
+        layer->layerName = "Layer";
+        layer->type = ParticleLayer::TYPE_PARTICLE_STRIPE;
+        layer->endTime = 10.0f;
+        layer->enableFog = false;
+        layer->SetPivotPoint(Vector2(0.5f, -0.5f));
+        layer->SetInheritPosition(true);
+
+        RefPtr<PropertyLineKeyframes<float32>> life(new PropertyLineKeyframes<float32>());
+        for (uint32 i = 0; i < 16; ++i)
+        {
+            life->AddValue(float32(i), float32(i * i));
+        }
+        layer->life = life;
+        layer->sizeOverLifeXY.Set(new PropertyLineValue<Vector2>(Vector2(2.0f, 3.0f)));
+
+        ScopedPtr<ParticleForceSimplified> simplifiedForce(new ParticleForceSimplified(RefPtr<PropertyLine<Vector3>>(new PropertyLineValue<Vector3>(Vector3(0.0f, 0.0f, -9.8f))), RefPtr<PropertyLine<float32>>()));
+        layer->AddSimplifiedForce(simplifiedForce);
+
+        ScopedPtr<ParticleForce> force(new ParticleForce(layer));
+        force->forceName = "Vortex";
+        force->type = ParticleForce::eType::VORTEX;
+        force->SetRadius(4.0f);
+        force->SetShape(ParticleForce::eShape::SPHERE);
+        layer->AddForce(force);
+
+        emitter->AddLayer(layer);
+
+        FilePath configPath("~doc:/ParticleEmitterBinaryFormatTest.yaml");
+        FilePath compiledPath = ParticleEmitterBinaryFormat::GetCompiledEmitterPath(configPath);
+        TEST_VERIFY(ParticleEmitterBinaryFormat::IsCompiledEmitterPath(compiledPath));
+        TEST_VERIFY(ParticleEmitterBinaryFormat::Save(emitter, compiledPath));
+
+        ScopedPtr<ParticleEmitter> loaded(new ParticleEmitter());
+        TEST_VERIFY(loaded->LoadFromFile(configPath));
+        TEST_VERIFY(loaded->configPath == configPath);
+        TEST_VERIFY(loaded->name == emitter->name);
+        TEST_VERIFY(loaded->emitterType == emitter->emitterType);
+        TEST_VERIFY(loaded->lifeTime == emitter->lifeTime);
+        TEST_VERIFY(loaded->shortEffect);
+        TEST_VERIFY(loaded->radius->GetValue(0.0f) == 2.0f);
+        TEST_VERIFY(loaded->emissionVector->GetValues().size() == 2);
+        TEST_VERIFY(loaded->emissionVector->GetValue(0.5f) == emitter->emissionVector->GetValue(0.5f));
+        TEST_VERIFY(loaded->size.Get() == nullptr);
+
+        List<ModifiablePropertyLineBase*> modifiables;
+        loaded->GetModifableLines(modifiables);
+        TEST_VERIFY(modifiables.size() == 1);
+        TEST_VERIFY(loaded->colorOverLife->GetValue(0.0f) == Color(1.0f, 0.5f, 0.25f, 1.0f));
+
+        TEST_VERIFY(loaded->layers.size() == 1);
+        ParticleLayer* loadedLayer = loaded->layers[0];
+        TEST_VERIFY(loadedLayer->layerName == layer->layerName);
+        TEST_VERIFY(loadedLayer->type == layer->type);
+        TEST_VERIFY(loadedLayer->endTime == layer->endTime);
+        TEST_VERIFY(!loadedLayer->enableFog);
+        TEST_VERIFY(loadedLayer->layerPivotPoint == layer->layerPivotPoint);
+        TEST_VERIFY(loadedLayer->layerPivotSizeOffsets == layer->layerPivotSizeOffsets);
+        TEST_VERIFY(loadedLayer->GetInheritPosition());
+        TEST_VERIFY(loadedLayer->life->GetValues().size() == 16);
+        TEST_VERIFY(loadedLayer->life->GetValue(7.5f) == layer->life->GetValue(7.5f));
+        TEST_VERIFY(loadedLayer->sizeOverLifeXY->GetValue(0.0f) == Vector2(2.0f, 3.0f));
+        TEST_VERIFY(loadedLayer->number.Get() == nullptr);
+
+        TEST_VERIFY(loadedLayer->GetSimplifiedParticleForces().size() == 1);
+        TEST_VERIFY(loadedLayer->GetSimplifiedParticleForces()[0]->force->GetValue(0.0f) == Vector3(0.0f, 0.0f, -9.8f));
+        TEST_VERIFY(loadedLayer->GetSimplifiedParticleForces()[0]->forceOverLife.Get() == nullptr);
+
+        TEST_VERIFY(loadedLayer->GetParticleForces().size() == 1);
+        ParticleForce* loadedForce = loadedLayer->GetParticleForces()[0];
+        TEST_VERIFY(loadedForce->forceName == "Vortex");
+        TEST_VERIFY(loadedForce->type == ParticleForce::eType::VORTEX);
+        TEST_VERIFY(loadedForce->GetShape() == ParticleForce::eShape::SPHERE);
+        TEST_VERIFY(loadedForce->GetSquaredRadius() == 16.0f);
+
+        FileSystem::Instance()->DeleteFile(compiledPath);
+    }
+
+    // Config without "emissionVectorInverted" flag is converted on yaml loading, compiled emitter keeps converted vector
+    DAVA_TEST (CompiledEmitterMatchesYamlEmitter)
+    {
+        FilePath yamlPath("~doc:/ParticleEmitterBinaryFormatYamlTest.yaml");
+        FilePath compiledPath = ParticleEmitterBinaryFormat::GetCompiledEmitterPath(yamlPath);
+        FilePath resavedPath("~doc:/ParticleEmitterBinaryFormatResavedTest.pec");
+
+        const char* yaml =
+        "emitter:\n"
+        "    emissionVector: [0.0, [0.0, 0.0, 1.0], 1.0, [1.0, 2.0, 3.0]]\n"
+        "    emissionRange: [0.0, 10.0, 0.5, 20.0, 1.0, 30.0]\n"
+        "    colorOverLife: [255.0, 128.0, 64.0, 255.0]\n"
+        "    name: \"Smoke\"\n"
+        "    shortEffect: \"true\"\n"
+        "    type: \"oncircle\"\n"
+        "    radius: 3.0\n"
+        "layer0:\n"
+        "    type: \"layer\"\n"
+        "    layerType: \"single\"\n"
+        "    name: \"Puffs\"\n"
+        "    effectFormat: 1\n"
+        "    startTime: 0.0\n"
+        "    endTime: 5.0\n"
+        "    life: [0.0, 1.0, 2.5, 3.0, 5.0, 2.0]\n"
+        "    alphaOverLife: [0.0, 0.0, 0.2, 1.0, 1.0, 0.0]\n"
+        "    size: [16.0, 32.0]\n"
+        "    forceCount: 1\n"
+        "    force0: [0.0, 0.0, -9.8]\n"
+        "    forceOverLife0: [0.0, 1.0, 1.0, 0.5]\n";
+
+        ScopedPtr<File> file(File::Create(yamlPath, File::CREATE | File::WRITE));
+        TEST_VERIFY(file);
+        file->Write(yaml, static_cast<uint32>(strlen(yaml)));
+        file.reset();
+
+        ScopedPtr<ParticleEmitter> yamlEmitter(new ParticleEmitter());
+        TEST_VERIFY(yamlEmitter->LoadFromYaml(yamlPath, true));
+        TEST_VERIFY(ParticleEmitterBinaryFormat::Compile(yamlPath, compiledPath));
+
+        ScopedPtr<ParticleEmitter> compiledEmitter(new ParticleEmitter());
+        TEST_VERIFY(ParticleEmitterBinaryFormat::Load(compiledEmitter, compiledPath, yamlPath, true));
+
+        // compiled form of loaded emitter is the same as compiled config
+        TEST_VERIFY(ParticleEmitterBinaryFormat::Save(compiledEmitter, resavedPath));
+        TEST_VERIFY(FileSystem::Instance()->ReadFileContents(resavedPath) == FileSystem::Instance()->ReadFileContents(compiledPath));
+
+        TEST_VERIFY(compiledEmitter->configPath == yamlPath);
+        TEST_VERIFY(compiledEmitter->name == yamlEmitter->name);
+        TEST_VERIFY(compiledEmitter->emitterType == yamlEmitter->emitterType);
+        TEST_VERIFY(compiledEmitter->shortEffect == yamlEmitter->shortEffect);
+        TEST_VERIFY(compiledEmitter->emissionVector->GetValues().size() == 2);
+        TEST_VERIFY(compiledEmitter->emissionVector->GetValue(0.75f) == yamlEmitter->emissionVector->GetValue(0.75f));
+        TEST_VERIFY(compiledEmitter->emissionRange->GetValue(0.25f) == yamlEmitter->emissionRange->GetValue(0.25f));
+        TEST_VERIFY(compiledEmitter->colorOverLife->GetValue(0.0f) == yamlEmitter->colorOverLife->GetValue(0.0f));
+        TEST_VERIFY(compiledEmitter->radius->GetValue(0.0f) == 3.0f);
+
+        TEST_VERIFY(compiledEmitter->layers.size() == 1 && yamlEmitter->layers.size() == 1);
+        ParticleLayer* yamlLayer = yamlEmitter->layers[0];
+        ParticleLayer* compiledLayer = compiledEmitter->layers[0];
+        TEST_VERIFY(compiledLayer->layerName == yamlLayer->layerName);
+        TEST_VERIFY(compiledLayer->type == yamlLayer->type);
+        TEST_VERIFY(compiledLayer->startTime == yamlLayer->startTime);
+        TEST_VERIFY(compiledLayer->endTime == yamlLayer->endTime);
+        TEST_VERIFY(compiledLayer->GetInheritPosition() == yamlLayer->GetInheritPosition());
+        TEST_VERIFY(compiledLayer->layerPivotPoint == yamlLayer->layerPivotPoint);
+        TEST_VERIFY(compiledLayer->life->GetValues().size() == yamlLayer->life->GetValues().size());
+        for (float32 t = 0.0f; t <= 5.0f; t += 0.5f)
+        {
+            TEST_VERIFY(compiledLayer->life->GetValue(t) == yamlLayer->life->GetValue(t));
+            TEST_VERIFY(compiledLayer->alphaOverLife->GetValue(t / 5.0f) == yamlLayer->alphaOverLife->GetValue(t / 5.0f));
+        }
+        TEST_VERIFY(compiledLayer->size->GetValue(0.0f) == yamlLayer->size->GetValue(0.0f));
+
+        TEST_VERIFY(compiledLayer->GetSimplifiedParticleForces().size() == 1);
+        ParticleForceSimplified* yamlForce = yamlLayer->GetSimplifiedParticleForces()[0];
+        ParticleForceSimplified* compiledForce = compiledLayer->GetSimplifiedParticleForces()[0];
+        TEST_VERIFY(compiledForce->force->GetValue(0.0f) == yamlForce->force->GetValue(0.0f));
+        TEST_VERIFY(compiledForce->forceOverLife->GetValue(0.5f) == yamlForce->forceOverLife->GetValue(0.5f));
+
+        FileSystem::Instance()->DeleteFile(yamlPath);
+        FileSystem::Instance()->DeleteFile(compiledPath);
+        FileSystem::Instance()->DeleteFile(resavedPath);
+    }
+
+    DAVA_TEST (RejectsInvalidFile)
+    {
+        FilePath compiledPath("~doc:/ParticleEmitterBinaryFormatInvalidTest.pec");
+        ScopedPtr<File> file(File::Create(compiledPath, File::CREATE | File::WRITE));
+        TEST_VERIFY(file);
+        uint32 header[] = { 0x43455044, 0xFFFFFFFF };
+        file->Write(header, sizeof(header));
+        file.reset();
+
+        ScopedPtr<ParticleEmitter> emitter(new ParticleEmitter());
+        TEST_VERIFY(!emitter->LoadFromFile(compiledPath));
+
+        FileSystem::Instance()->DeleteFile(compiledPath);
+    }
+};
@@ -0,0 +1,130 @@
+#include "DAVAEngine.h"
+
+#include "Debug/ProfilerCPU.h"
+#include "Debug/TraceEvent.h"
+
+#include "UnitTests/UnitTests.h"
+
+#include <sstream>
+
+using namespace DAVA;
+
+namespace ProfilerCPUTestDetails
+{
+const char* MAIN_COUNTER = "ProfilerCPUTest::Main";
+const char* WORKER_COUNTER = "ProfilerCPUTest::Worker";
+const char* NESTED_COUNTER = "ProfilerCPUTest::Nested";
+
+void MakeCounters(ProfilerCPU* profiler, const char* counterName, uint32 count)
+{
+    for (uint32 i = 0; i < count; ++i)
+    {
+        DAVA_PROFILER_CPU_SCOPE_CUSTOM(counterName, profiler);
+        {
+            DAVA_PROFILER_CPU_SCOPE_CUSTOM(NESTED_COUNTER, profiler);
+        }
+    }
+}
+
+void RunInThread(const Function<void()>& func)
+{
+    RefPtr<Thread> thread(Thread::Create(func));
+    thread->Start();
+    thread->Join();
+}
+
+uint32 CountEvents(const Vector<TraceEvent>& trace, const char* counterName)
+{
+    FastName name(counterName);
+    return uint32(std::count_if(trace.begin(), trace.end(), [&name](const TraceEvent& e) { return e.name == name; }));
+}
+}
+
+DAVA_TESTCLASS (ProfilerCPUTest)
+{
+    const uint32 COUNTERS_COUNT = 64;
+
+    DAVA_TEST (UsageBeforeFirstStop)
+    {
+        ProfilerCPU profiler(COUNTERS_COUNT);
+
+        std::stringstream stream;
+        profiler.DumpLast(ProfilerCPUTestDetails::MAIN_COUNTER, 1, stream);
+        profiler.DumpAverage(ProfilerCPUTestDetails::MAIN_COUNTER, 1, stream);
+        TEST_VERIFY(profiler.GetTrace().empty());
+
+        int32 snapshot = profiler.MakeSnapshot();
+        TEST_VERIFY(profiler.GetTrace(snapshot).empty());
+        profiler.DeleteSnapshots();
+    }
+
+    DAVA_TEST (ThreadRingsAreMergedOnStop)
+    {
+        using namespace ProfilerCPUTestDetails;
+
+        ProfilerCPU profiler(COUNTERS_COUNT);
+        profiler.Start();
+
+        MakeCounters(&profiler, MAIN_COUNTER, 3);
+
+        // Busy worker overwrites only its own ring
+        RunInThread([this, &profiler]() { MakeCounters(&profiler, WORKER_COUNTER, COUNTERS_COUNT * 4); });
+
+        // Counters of running profiler are read from thread rings
+        TEST_VERIFY(profiler.GetTrace(MAIN_COUNTER).size() == 2);
+        TEST_VERIFY(profiler.GetTrace(WORKER_COUNTER).size() == 2);
+
+        profiler.Stop();
+
+        Vector<TraceEvent> trace = profiler.GetTrace();
+        TEST_VERIFY(CountEvents(trace, MAIN_COUNTER) == 3);
+        TEST_VERIFY(CountEvents(trace, WORKER_COUNTER) == (COUNTERS_COUNT - 1) / 2);
+
+        bool isSorted = std::is_sorted(trace.begin(), trace.end(), [](const TraceEvent& l, const TraceEvent& r) { return l.timestamp < r.timestamp; });
+        TEST_VERIFY(isSorted);
+
+        // Merged counters are kept by snapshot
+        int32 snapshot = profiler.MakeSnapshot();
+        TEST_VERIFY(CountEvents(profiler.GetTrace(snapshot), MAIN_COUNTER) == 3);
+        profiler.DeleteSnapshots();
+    }
+
+    DAVA_TEST (TraceStreaming)
+    {
+        using namespace ProfilerCPUTestDetails;
+
+        const FilePath tracePath("~doc:/ProfilerCPUTest/trace.json");
+        const uint32 counterCount = 1000;
+
+        // Ring of each thread is larger than number of counters made between streaming passes
+        ProfilerCPU profiler(4096);
+        profiler.Start();
+        profiler.StartTraceStreaming(tracePath, 1);
+        TEST_VERIFY(profiler.IsTraceStreaming());
+
+        RunInThread([&profiler, counterCount]() { MakeCounters(&profiler, WORKER_COUNTER, counterCount); });
+        MakeCounters(&profiler, MAIN_COUNTER, counterCount);
+
+        profiler.StopTraceStreaming();
+        profiler.Stop();
+        TEST_VERIFY(!profiler.IsTraceStreaming());
+
+        String trace = FileSystem::Instance()->ReadFileContents(tracePath);
+        TEST_VERIFY(trace.front() == '[' && trace.find(']') != String::npos);
+        TEST_VERIFY(CountSubstrings(trace, String("\"name\": \"") + WORKER_COUNTER + "\"") == counterCount);
+        TEST_VERIFY(CountSubstrings(trace, String("\"name\": \"") + MAIN_COUNTER + "\"") == counterCount);
+        TEST_VERIFY(CountSubstrings(trace, String("\"name\": \"") + NESTED_COUNTER + "\"") == 2 * counterCount);
+
+        FileSystem::Instance()->DeleteDirectory("~doc:/ProfilerCPUTest/", true);
+    }
+
+    uint32 CountSubstrings(const String& str, const String& substr)
+    {
+        uint32 count = 0;
+        for (size_t pos = str.find(substr); pos != String::npos; pos = str.find(substr, pos + substr.size()))
+        {
+            ++count;
+        }
+        return count;
+    }
+};
@@ -0,0 +1,92 @@
+#include "UnitTests/UnitTests.h"
+
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+#include "Entity/ComponentUtils.h"
+#include "Entity/SceneSystem.h"
+#include "Scene3D/Components/SingleComponents/TransformSingleComponent.h"
+#include "Scene3D/Components/SoundComponent.h"
+#include "Scene3D/Components/TransformComponent.h"
+#include "Scene3D/Scene.h"
+
+using namespace DAVA;
+
+namespace SceneProcessStagesTestDetails
+{
+class OrderRecordingSystem : public SceneSystem
+{
+public:
+    OrderRecordingSystem(Scene* scene, Atomic<uint32>& counter_)
+        : SceneSystem(scene)
+        , counter(counter_)
+    {
+    }
+
+    void Process(float32 timeElapsed) override
+    {
+        // give concurrently processed systems a chance to overlap
+        Thread::Sleep(5);
+        order = counter++;
+        processCount++;
+    }
+
+    void PrepareForRemove() override
+    {
+    }
+
+    Atomic<uint32>& counter;
+    uint32 order = 0;
+    uint32 processCount = 0;
+};
+}
+
+DAVA_TESTCLASS (SceneProcessStagesTest)
+{
+    DAVA_TEST (ConflictingSystemsOrderTest)
+    {
+        using namespace SceneProcessStagesTestDetails;
+
+        Atomic<uint32> counter(0);
+        ScopedPtr<Scene> scene(new Scene(0));
+        TEST_VERIFY(!scene->IsParallelProcessEnabled());
+
+        ComponentMask transformMask = ComponentUtils::MakeMask<TransformComponent>();
+        ComponentMask soundMask = ComponentUtils::MakeMask<SoundComponent>();
+
+        OrderRecordingSystem* transformWriter = new OrderRecordingSystem(scene, counter);
+        OrderRecordingSystem* soundWriter = new OrderRecordingSystem(scene, counter);
+        OrderRecordingSystem* transformReader = new OrderRecordingSystem(scene, counter);
+        OrderRecordingSystem* undeclared = new OrderRecordingSystem(scene, counter);
+        OrderRecordingSystem* singletonReader = new OrderRecordingSystem(scene, counter);
+        OrderRecordingSystem* singletonWriter = new OrderRecordingSystem(scene, counter);
+
+        scene->AddSystem(transformWriter, ComponentMask(), SceneSystemDataAccess().WriteComponents(transformMask), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(soundWriter, ComponentMask(), SceneSystemDataAccess().WriteComponents(soundMask), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(transformReader, ComponentMask(), SceneSystemDataAccess().ReadComponents(transformMask), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(undeclared, ComponentMask(), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(singletonReader, ComponentMask(), SceneSystemDataAccess().ReadSingleton<TransformSingleComponent>(), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+        scene->AddSystem(singletonWriter, ComponentMask(), SceneSystemDataAccess().WriteSingleton<TransformSingleComponent>(), Scene::SCENE_SYSTEM_REQUIRE_PROCESS);
+
+        TEST_VERIFY(transformWriter->GetDataAccess().ConflictsWith(transformReader->GetDataAccess()));
+        TEST_VERIFY(!transformWriter->GetDataAccess().ConflictsWith(soundWriter->GetDataAccess()));
+        TEST_VERIFY(!transformReader->GetDataAccess().ConflictsWith(transformReader->GetDataAccess()));
+        TEST_VERIFY(singletonReader->GetDataAccess().ConflictsWith(singletonWriter->GetDataAccess()));
+
+        for (bool parallel : { true, false })
+        {
+            scene->SetParallelProcessEnabled(parallel);
+            scene->Update(0.016f);
+
+            TEST_VERIFY(transformWriter->order < transformReader->order);
+            TEST_VERIFY(transformReader->order < undeclared->order);
+            TEST_VERIFY(soundWriter->order < undeclared->order);
+            TEST_VERIFY(undeclared->order < singletonReader->order);
+            TEST_VERIFY(singletonReader->order < singletonWriter->order);
+        }
+
+        for (OrderRecordingSystem* system : { transformWriter, soundWriter, transformReader, undeclared, singletonReader, singletonWriter })
+        {
+            TEST_VERIFY(system->processCount == 2);
+        }
+    }
+};
@@ -0,0 +1,90 @@
+#include "DAVAEngine.h"
+
+#include "Scene3D/Components/SkeletonComponent.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace SkeletonSystemTestDetails
+{
+const uint32 SKELETONS_COUNT = 32;
+const uint32 JOINTS_COUNT = 12;
+const uint32 FRAMES_COUNT = 4;
+
+Scene* CreateScene(bool isParallel)
+{
+    Scene* scene = new Scene(Scene::SCENE_SYSTEM_SKELETON_FLAG);
+    scene->SetParallelProcessEnabled(isParallel);
+
+    // chain of joints, each one is moved along x from its parent
+    Vector<SkeletonComponent::Joint> joints(JOINTS_COUNT);
+    for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+    {
+        SkeletonComponent::Joint& joint = joints[j];
+        joint.parentIndex = (j == 0) ? SkeletonComponent::INVALID_JOINT_INDEX : j - 1;
+        joint.name = FastName(Format("joint%u", j));
+        joint.uid = joint.name;
+        joint.bbox = AABBox3(Vector3(0.0f, 0.0f, 0.0f), 0.5f);
+        joint.bindTransform = Matrix4::MakeTranslation(Vector3(1.0f, 0.0f, 0.0f));
+        joint.bindTransform.GetInverse(joint.bindTransformInv);
+    }
+
+    for (uint32 i = 0; i < SKELETONS_COUNT; ++i)
+    {
+        SkeletonComponent* skeleton = new SkeletonComponent();
+        skeleton->SetJoints(joints);
+
+        ScopedPtr<Entity> entity(new Entity());
+        entity->AddComponent(skeleton);
+        scene->AddNode(entity);
+    }
+    return scene;
+}
+
+void AnimateSkeletons(Scene* scene, uint32 frame)
+{
+    for (int32 i = 0; i < scene->GetChildrenCount(); ++i)
+    {
+        SkeletonComponent* skeleton = scene->GetChild(i)->GetComponent<SkeletonComponent>();
+
+        // each skeleton updates its own subset of joints, so update starts from different joints
+        for (uint32 j = (i + frame) % JOINTS_COUNT; j < JOINTS_COUNT; j += 3)
+        {
+            JointTransform transform;
+            transform.SetPosition(Vector3(1.0f, 0.1f * i, 0.05f * frame));
+            transform.SetOrientation(Quaternion::MakeRotation(Vector3(0.0f, 0.0f, 1.0f), 0.1f * (i + j + frame)));
+            skeleton->SetJointTransform(j, transform);
+        }
+    }
+}
+}
+
+DAVA_TESTCLASS (SkeletonSystemTest)
+{
+    DAVA_TEST (ParallelUpdateMatchesSerialUpdate)
+    {
+        using namespace SkeletonSystemTestDetails;
+
+        ScopedPtr<Scene> serialScene(CreateScene(false));
+        ScopedPtr<Scene> parallelScene(CreateScene(true));
+
+        for (uint32 frame = 0; frame < FRAMES_COUNT; ++frame)
+        {
+            AnimateSkeletons(serialScene, frame);
+            AnimateSkeletons(parallelScene, frame);
+            serialScene->Update(0.016f);
+            parallelScene->Update(0.016f);
+
+            for (uint32 i = 0; i < SKELETONS_COUNT; ++i)
+            {
+                SkeletonComponent* serialSkeleton = serialScene->GetChild(i)->GetComponent<SkeletonComponent>();
+                SkeletonComponent* parallelSkeleton = parallelScene->GetChild(i)->GetComponent<SkeletonComponent>();
+                for (uint32 j = 0; j < JOINTS_COUNT; ++j)
+                {
+                    TEST_VERIFY(serialSkeleton->GetJointObjectSpaceTransform(j) == parallelSkeleton->GetJointObjectSpaceTransform(j));
+                }
+            }
+        }
+    }
+};
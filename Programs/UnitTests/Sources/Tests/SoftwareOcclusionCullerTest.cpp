@@ -0,0 +1,84 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/SoftwareOcclusionCuller.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (SoftwareOcclusionCullerTest)
+{
+    DAVA_TEST (HiddenObjectsAreMovedToOccluded)
+    {
+        // Camera at origin looks along +y, wall at y = 10 hides everything behind it near the view axis
+        ScopedPtr<Camera> camera(new Camera());
+        camera->SetupPerspective(90.0f, 1.0f, 1.0f, 1000.0f);
+        camera->SetPosition(Vector3(0.0f, 0.0f, 0.0f));
+        camera->SetTarget(Vector3(0.0f, 1.0f, 0.0f));
+        camera->SetUp(Vector3(0.0f, 0.0f, 1.0f));
+        camera->GetViewProjMatrix();
+
+        Matrix4 identity = Matrix4::IDENTITY;
+        ScopedPtr<PolygonGroup> wallGeometry(GenerateBox(AABBox3(Vector3(-5.0f, 10.0f, -5.0f), Vector3(5.0f, 11.0f, 5.0f))));
+        ScopedPtr<RenderObject> wall(CreateObject(wallGeometry, &identity));
+        ScopedPtr<RenderObject> hidden(CreateObject(AABBox3(Vector3(-2.0f, 40.0f, -2.0f), Vector3(2.0f, 44.0f, 2.0f)), &identity));
+        ScopedPtr<RenderObject> side(CreateObject(AABBox3(Vector3(30.0f, 40.0f, -2.0f), Vector3(34.0f, 44.0f, 2.0f)), &identity));
+        ScopedPtr<RenderObject> alwaysVisible(CreateObject(AABBox3(Vector3(-2.0f, 50.0f, -2.0f), Vector3(2.0f, 54.0f, 2.0f)), &identity));
+        alwaysVisible->AddFlag(RenderObject::ALWAYS_CLIPPING_VISIBLE);
+
+        SoftwareOcclusionCuller culler;
+        culler.SetResolution(64, 64);
+        Vector<RenderObject*> objects = { wall, hidden, side, alwaysVisible };
+        Vector<RenderObject*> occludedObjects;
+
+        // nothing is culled without occluders
+        culler.Cull(camera, objects, occludedObjects);
+        TEST_VERIFY(objects.size() == 4);
+        TEST_VERIFY(occludedObjects.empty());
+
+        culler.AddOccluder(wall, wallGeometry);
+        TEST_VERIFY((wall->GetFlags() & RenderObject::SOFTWARE_OCCLUDER) != 0);
+
+        culler.Cull(camera, objects, occludedObjects);
+        TEST_VERIFY(culler.GetCulledObjectsCount() == 1);
+        TEST_VERIFY(objects == Vector<RenderObject*>({ wall, side, alwaysVisible }));
+        TEST_VERIFY(occludedObjects == Vector<RenderObject*>({ hidden }));
+
+        // clone of occluder is not an occluder
+        ScopedPtr<RenderObject> wallClone(wall->Clone(nullptr));
+        TEST_VERIFY((wallClone->GetFlags() & RenderObject::SOFTWARE_OCCLUDER) == 0);
+
+        culler.RemoveOccluder(wall);
+        TEST_VERIFY((wall->GetFlags() & RenderObject::SOFTWARE_OCCLUDER) == 0);
+        TEST_VERIFY(culler.GetOccludersCount() == 0);
+    }
+
+    PolygonGroup* GenerateBox(const AABBox3& bbox)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 1.0f },
+            { FastName("segments.y"), 1.0f },
+            { FastName("segments.z"), 1.0f }
+        };
+        return GeometryGenerator::GenerateBox(bbox, options);
+    }
+
+    RenderObject* CreateObject(const AABBox3& bbox, Matrix4* worldTransform)
+    {
+        ScopedPtr<PolygonGroup> geometry(GenerateBox(bbox));
+        return CreateObject(geometry, worldTransform);
+    }
+
+    RenderObject* CreateObject(PolygonGroup * geometry, Matrix4 * worldTransform)
+    {
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetPolygonGroup(geometry);
+
+        RenderObject* object = new RenderObject();
+        object->AddRenderBatch(batch);
+        object->SetWorldMatrixPtr(worldTransform);
+        object->RecalculateWorldBoundingBox();
+        return object;
+    }
+};
@@ -0,0 +1,60 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/GeometryGenerator.h"
+#include "Render/Highlevel/StaticOcclusion.h"
+#include "Render/Highlevel/StaticOcclusionSoftwareBaker.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (StaticOcclusionSoftwareBakerTest)
+{
+    const uint16 HIDDEN_OBJECT_INDEX = 0;
+    const uint16 VISIBLE_OBJECT_INDEX = 1;
+    const uint16 OCCLUDER_INDEX = 2;
+
+    // Single cell with wall along +x side of it: object behind the wall is hidden, object on -x side is visible
+    DAVA_TEST (OccluderHidesObjectBehindIt)
+    {
+        StaticOcclusionData data;
+        data.Init(1, 1, 1, 3, AABBox3(Vector3(0.f, 0.f, 0.f), Vector3(10.f, 10.f, 10.f)), nullptr);
+
+        ScopedPtr<RenderObject> occluder(CreateBox(AABBox3(Vector3(20.f, -200.f, -200.f), Vector3(22.f, 200.f, 200.f)), OCCLUDER_INDEX));
+        ScopedPtr<RenderObject> hiddenObject(CreateBox(AABBox3(Vector3(40.f, 3.f, 3.f), Vector3(44.f, 7.f, 7.f)), HIDDEN_OBJECT_INDEX));
+        ScopedPtr<RenderObject> visibleObject(CreateBox(AABBox3(Vector3(-20.f, 3.f, 3.f), Vector3(-16.f, 7.f, 7.f)), VISIBLE_OBJECT_INDEX));
+        Vector<RenderObject*> renderObjects = { occluder, hiddenObject, visibleObject };
+
+        StaticOcclusionSoftwareBaker baker;
+        baker.SetResolution(128);
+        baker.StartBake(&data, renderObjects, nullptr, 0, 0);
+        TEST_VERIFY(baker.GetTotalStepsCount() == 1);
+        TEST_VERIFY(baker.ProcessBlocks(1));
+        TEST_VERIFY(baker.GetCurrentStepsCount() == 1);
+
+        TEST_VERIFY(!data.IsObjectVisibleFromBlock(0, HIDDEN_OBJECT_INDEX));
+        TEST_VERIFY(data.IsObjectVisibleFromBlock(0, VISIBLE_OBJECT_INDEX));
+        TEST_VERIFY(data.IsObjectVisibleFromBlock(0, OCCLUDER_INDEX));
+    }
+
+    RenderObject* CreateBox(const AABBox3& box, uint16 occlusionIndex)
+    {
+        Map<FastName, float32> options = {
+            { FastName("segments.x"), 1.0f },
+            { FastName("segments.y"), 1.0f },
+            { FastName("segments.z"), 1.0f }
+        };
+        ScopedPtr<PolygonGroup> geometry(GeometryGenerator::GenerateBox(box, options));
+
+        // opaque material, so the object occludes
+        ScopedPtr<NMaterial> material(new NMaterial());
+        ScopedPtr<RenderBatch> batch(new RenderBatch());
+        batch->SetPolygonGroup(geometry);
+        batch->SetMaterial(material);
+
+        RenderObject* renderObject = new RenderObject();
+        renderObject->AddRenderBatch(batch);
+        renderObject->SetStaticOcclusionIndex(occlusionIndex);
+        return renderObject;
+    }
+};
@@ -0,0 +1,136 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/StaticOcclusion.h"
+#include "Scene3D/Components/ComponentHelpers.h"
+#include "Scene3D/Components/StaticOcclusionComponent.h"
+#include "Scene3D/Systems/StaticOcclusionSystem.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (StaticOcclusionSystemTest)
+{
+    const uint32 OBJECTS_COUNT = 40;
+
+    // Two cells along x: even objects are visible from first cell, every third object is visible from second one
+    DAVA_TEST (AppliedVisibilityMirrorsFlags)
+    {
+        ScopedPtr<Scene> scene(new Scene(Scene::SCENE_SYSTEM_STATIC_OCCLUSION_FLAG | Scene::SCENE_SYSTEM_TRANSFORM_FLAG));
+        StaticOcclusionSystem* system = scene->staticOcclusionSystem;
+
+        ScopedPtr<Camera> camera(new Camera());
+        scene->AddCamera(camera);
+        scene->SetCurrentCamera(camera);
+
+        ScopedPtr<Entity> occlusionEntity(new Entity());
+        StaticOcclusionDataComponent* dataComponent = new StaticOcclusionDataComponent();
+        StaticOcclusionData& data = dataComponent->GetData();
+        data.Init(2, 1, 1, OBJECTS_COUNT, AABBox3(Vector3(0.f, 0.f, 0.f), Vector3(20.f, 10.f, 10.f)), nullptr);
+        for (uint32 cell = 0; cell < 2; ++cell)
+        {
+            for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+            {
+                if (IsVisibleFromCell(cell, i))
+                    data.EnableVisibilityForObject(cell, i);
+            }
+        }
+        occlusionEntity->AddComponent(dataComponent);
+        scene->AddNode(occlusionEntity);
+
+        // last two objects are added while cell is active
+        Vector<ScopedPtr<Entity>> entities;
+        for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+        {
+            entities.emplace_back(CreateObjectEntity(i));
+            if (i < OBJECTS_COUNT - 2)
+                scene->AddNode(entities[i]);
+        }
+
+        // enter first cell
+        camera->SetPosition(Vector3(5.f, 5.f, 5.f));
+        system->Process(0.f);
+        TEST_VERIFY(FlagsMatchCell(entities, 0, OBJECTS_COUNT - 2));
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+
+        // cell change
+        camera->SetPosition(Vector3(15.f, 5.f, 5.f));
+        system->Process(0.f);
+        TEST_VERIFY(FlagsMatchCell(entities, 1, OBJECTS_COUNT - 2));
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+
+        // object removed while cell is active keeps its flag, and gets flag of active cell when added back
+        scene->RemoveNode(entities[3]);
+        camera->SetPosition(Vector3(5.f, 5.f, 5.f));
+        system->Process(0.f);
+        TEST_VERIFY(IsFlagVisible(entities[3]));
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+
+        scene->AddNode(entities[3]);
+        scene->AddNode(entities[OBJECTS_COUNT - 2]);
+        scene->AddNode(entities[OBJECTS_COUNT - 1]);
+        TEST_VERIFY(FlagsMatchCell(entities, 0, OBJECTS_COUNT));
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+
+        camera->SetPosition(Vector3(15.f, 5.f, 5.f));
+        system->Process(0.f);
+        TEST_VERIFY(FlagsMatchCell(entities, 1, OBJECTS_COUNT));
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+
+        // leaving PVS makes all objects visible
+        camera->SetPosition(Vector3(50.f, 5.f, 5.f));
+        system->Process(0.f);
+        for (uint32 i = 0; i < OBJECTS_COUNT; ++i)
+        {
+            TEST_VERIFY(IsFlagVisible(entities[i]));
+        }
+        TEST_VERIFY(AppliedVisibilityMirrorsFlags(system));
+    }
+
+    bool IsVisibleFromCell(uint32 cell, uint32 index)
+    {
+        return (cell == 0) ? (index % 2 == 0) : (index % 3 == 0);
+    }
+
+    Entity* CreateObjectEntity(uint32 index)
+    {
+        ScopedPtr<RenderObject> renderObject(new RenderObject());
+        renderObject->SetStaticOcclusionIndex(uint16(index));
+
+        Entity* entity = new Entity();
+        entity->AddComponent(new RenderComponent(renderObject));
+        return entity;
+    }
+
+    bool IsFlagVisible(Entity * entity)
+    {
+        return (GetRenderObject(entity)->GetFlags() & RenderObject::VISIBLE_STATIC_OCCLUSION) != 0;
+    }
+
+    bool FlagsMatchCell(const Vector<ScopedPtr<Entity>>& entities, uint32 cell, uint32 count)
+    {
+        for (uint32 i = 0; i < count; ++i)
+        {
+            if (IsFlagVisible(entities[i]) != IsVisibleFromCell(cell, i))
+                return false;
+        }
+        return true;
+    }
+
+    bool AppliedVisibilityMirrorsFlags(StaticOcclusionSystem * system)
+    {
+        for (uint32 i = 0; i < uint32(system->indexedRenderObjects.size()); ++i)
+        {
+            RenderObject* renderObject = system->indexedRenderObjects[i];
+            if (renderObject == nullptr)
+                continue;
+
+            bool isApplied = (system->appliedVisibility[i / 32] & (1u << (i & 31))) != 0;
+            bool isPresent = (system->presentObjects[i / 32] & (1u << (i & 31))) != 0;
+            bool isVisible = (renderObject->GetFlags() & RenderObject::VISIBLE_STATIC_OCCLUSION) != 0;
+            if (!isPresent || isApplied != isVisible)
+                return false;
+        }
+        return true;
+    }
+};
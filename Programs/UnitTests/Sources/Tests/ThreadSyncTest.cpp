@@ -67,6 +67,29 @@ DAVA_TESTCLASS (ThreadSyncTest)
         TEST_VERIFY(p->IsJoinable() == false);
     }
 
+    DAVA_TEST (ThreadExitHandlersTest)
+    {
+        // Handlers run in exiting thread after thread function, including handlers registered by other handlers
+        Vector<int> calls;
+        Thread::Id handlerThreadId = Thread::Id();
+        RefPtr<Thread> p(Thread::Create([&calls, &handlerThreadId]() {
+            Thread::AtCurrentThreadExit([&calls, &handlerThreadId]() {
+                calls.push_back(1);
+                handlerThreadId = Thread::GetCurrentId();
+                Thread::AtCurrentThreadExit([&calls]() { calls.push_back(2); });
+            });
+            calls.push_back(0);
+        }));
+        p->Start();
+        p->Join();
+
+        TEST_VERIFY(calls == Vector<int>({ 0, 1, 2 }));
+        TEST_VERIFY(handlerThreadId != Thread::GetCurrentId());
+
+        // Main thread isn't created by DAVA::Thread
+        TEST_VERIFY(!Thread::AtCurrentThreadExit([]() {}));
+    }
+
     DAVA_TEST (ThreadSyncTestFunction)
     {
         cvMutex.Lock();
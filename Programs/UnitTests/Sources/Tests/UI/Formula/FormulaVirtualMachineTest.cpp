@@ -0,0 +1,175 @@
+#include "DAVAEngine.h"
+
+#include "UI/Formula/Private/FormulaCompiler.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaParser.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
+
+#include "Reflection/ReflectionRegistrator.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+class FormulaVMTestData : public ReflectionBase
+{
+    DAVA_VIRTUAL_REFLECTION(FormulaVMTestData);
+
+public:
+    float flVal = 2.5f;
+    bool bVal = true;
+    String strVal = "Hello";
+    int intVal = 42;
+    int16 shortVal = 7;
+    Vector<int> array;
+    Map<String, int> map;
+
+    FormulaVMTestData()
+    {
+        array.push_back(10);
+        array.push_back(20);
+
+        map["a"] = 11;
+        map["b"] = 22;
+    }
+
+    int sum(int a, int b)
+    {
+        return a + b;
+    }
+
+    String floatToStr(float a)
+    {
+        return Format("%.1f", static_cast<double>(a));
+    }
+};
+
+DAVA_VIRTUAL_REFLECTION_IMPL(FormulaVMTestData)
+{
+    ReflectionRegistrator<FormulaVMTestData>::Begin()
+    .Field("fl", &FormulaVMTestData::flVal)
+    .Field("b", &FormulaVMTestData::bVal)
+    .Field("str", &FormulaVMTestData::strVal)
+    .Field("intVal", &FormulaVMTestData::intVal)
+    .Field("shortVal", &FormulaVMTestData::shortVal)
+    .Field("array", &FormulaVMTestData::array)
+    .Field("map", &FormulaVMTestData::map)
+    .Method("sum", &FormulaVMTestData::sum)
+    .Method("floatToStr", &FormulaVMTestData::floatToStr)
+    .End();
+};
+
+DAVA_TESTCLASS (FormulaVirtualMachineTest)
+{
+    DAVA_TEST (ResultsMatchExecutor)
+    {
+        Vector<String> formulas = {
+            "5", "-5", "--2", "1---2", "5 + 5 * 2", "7 % 3", "7U - 2U", "7L * 2L",
+            "5 + 5.5", "2.0 * fl", "intVal / 5", "intVal % 5", "shortVal + 1", "-shortVal", "shortVal",
+            "intVal > 40 and b", "not b or fl < 3", "5 = 5.0", "str + \" world\"", "str = \"Hello\"",
+            "map.a + map.b", "array[1] - array[0]", "sum(intVal, 8)", "floatToStr(intVal)", "floatToStr(fl * 2)",
+            "when intVal > 50 -> 1, intVal > 40 -> 2, 3", "when false -> 1, true -> fl, 0", "when b -> str, \"no\""
+        };
+
+        for (const String& formula : formulas)
+        {
+            FormulaVMTestData data;
+            Any expected = ExecuteWithExecutor(formula, &data);
+            Any actual = ExecuteWithVM(formula, &data);
+            TEST_VERIFY_WITH_MESSAGE(expected == actual, formula);
+        }
+    }
+
+    DAVA_TEST (ErrorsMatchExecutor)
+    {
+        Vector<String> formulas = {
+            "5 + 5L", "\"a\" - \"b\"", "not 5", "-true", "map.d", "array[5.5]", "sum(1, 2, 3)",
+            "when 5 -> 1, 2", "true * false", "(5 + 5).a"
+        };
+
+        for (const String& formula : formulas)
+        {
+            FormulaVMTestData data;
+            String expected = ExecuteWithErrors(formula, &data, false);
+            String actual = ExecuteWithErrors(formula, &data, true);
+            TEST_VERIFY(!expected.empty());
+            TEST_VERIFY_WITH_MESSAGE(expected == actual, formula);
+        }
+    }
+
+    DAVA_TEST (ConstantsAreFolded)
+    {
+        FormulaParser parser("(2 + 3) * 4 - 1");
+        std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(parser.ParseExpression());
+        TEST_VERIFY(program->code.size() == 1);
+        TEST_VERIFY(program->code[0].opCode == FormulaProgram::OP_LOAD_INT);
+        TEST_VERIFY(program->code[0].intValue == 19);
+    }
+
+    DAVA_TEST (Dependencies)
+    {
+        FormulaVMTestData data;
+        FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+        FormulaParser parser("map.b + fl + array[1]");
+        std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(parser.ParseExpression());
+
+        FormulaVirtualMachine vm;
+        vm.Execute(*program, &context);
+        TEST_VERIFY(vm.GetDependencies() == Vector<void*>({ &(data.map), &(data.map["b"]), &(data.flVal), &(data.array), &(data.array[1]) }));
+    }
+
+    DAVA_TEST (MachineIsReused)
+    {
+        FormulaVMTestData data;
+        FormulaReflectionContext context(Reflection::Create(&data), std::shared_ptr<FormulaContext>());
+        std::shared_ptr<FormulaProgram> sumProgram = FormulaCompiler().Compile(FormulaParser("map.b + fl + array[1]").ParseExpression());
+        std::shared_ptr<FormulaProgram> intProgram = FormulaCompiler().Compile(FormulaParser("1 + 2").ParseExpression());
+
+        FormulaVirtualMachine vm;
+        Any first = vm.Execute(*sumProgram, &context);
+        Any constant = vm.Execute(*intProgram, &context);
+        TEST_VERIFY(constant.Get<int32>() == 3);
+        TEST_VERIFY(vm.GetDependencies().empty());
+
+        Any second = vm.Execute(*sumProgram, &context);
+        TEST_VERIFY(first == second);
+        TEST_VERIFY(vm.GetDependencies().size() == 5);
+    }
+
+    Any ExecuteWithExecutor(const String& str, FormulaVMTestData* data)
+    {
+        FormulaReflectionContext context(Reflection::Create(data), std::shared_ptr<FormulaContext>());
+        FormulaParser parser(str);
+        std::shared_ptr<FormulaExpression> exp = parser.ParseExpression();
+        return FormulaExecutor(&context).Calculate(exp.get());
+    }
+
+    Any ExecuteWithVM(const String& str, FormulaVMTestData* data)
+    {
+        FormulaReflectionContext context(Reflection::Create(data), std::shared_ptr<FormulaContext>());
+        FormulaParser parser(str);
+        std::shared_ptr<FormulaProgram> program = FormulaCompiler().Compile(parser.ParseExpression());
+        return FormulaVirtualMachine().Execute(*program, &context);
+    }
+
+    String ExecuteWithErrors(const String& str, FormulaVMTestData* data, bool useVM)
+    {
+        try
+        {
+            if (useVM)
+            {
+                ExecuteWithVM(str, data);
+            }
+            else
+            {
+                ExecuteWithExecutor(str, data);
+            }
+        }
+        catch (const FormulaException& error)
+        {
+            return error.GetFormattedMessage();
+        }
+        return String();
+    }
+};
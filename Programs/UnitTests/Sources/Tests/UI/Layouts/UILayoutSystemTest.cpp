@@ -3,6 +3,7 @@
 #include "UI/UIControl.h"
 #include "UI/Layouts/UILayoutSystem.h"
 #include "UI/Layouts/UIAnchorComponent.h"
+#include "UI/Layouts/UILayoutIsolationComponent.h"
 #include "UI/Layouts/UISizePolicyComponent.h"
 
 #include "UnitTests/UnitTests.h"
@@ -55,4 +56,75 @@ DAVA_TESTCLASS (UILayoutSystemTest)
         SafeRelease(parent);
         SafeRelease(child);
     }
+
+    DAVA_TEST (IncrementalLayout_RelayoutsSkippedSubtreeAfterResize)
+    {
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+
+        UIControl* panel = MakeChild(screen, "panel");
+        UISizePolicyComponent* panelSizePolicy = panel->GetOrCreateComponent<UISizePolicyComponent>();
+        panelSizePolicy->SetHorizontalPolicy(UISizePolicyComponent::PERCENT_OF_PARENT);
+        panelSizePolicy->SetHorizontalValue(50.0f);
+
+        UIControl* child = MakeChild(panel, "child");
+        child->SetSize(Vector2(20.0f, 20.0f));
+        UIAnchorComponent* childAnchor = child->GetOrCreateComponent<UIAnchorComponent>();
+        childAnchor->SetHCenterAnchorEnabled(true);
+
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        layoutSystem->ProcessControl(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(panel->GetSize().x, 100.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(child->GetPosition().x, 40.0f, 0.01f));
+
+        panel->ResetLayoutDirty();
+        panel->ResetLayoutChildrenDirty();
+        child->ResetLayoutDirty();
+
+        screen->SetSize(Vector2(400.0f, 200.0f));
+        layoutSystem->ProcessControl(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(panel->GetSize().x, 200.0f, 0.01f));
+        TEST_VERIFY(FLOAT_EQUAL_EPS(child->GetPosition().x, 90.0f, 0.01f));
+
+        SafeRelease(screen);
+        SafeRelease(panel);
+        SafeRelease(child);
+    }
+
+    DAVA_TEST (IncrementalLayout_LayoutsChildAttachedToCleanParent)
+    {
+        UIControl* screen = MakeRoot("screen");
+        screen->SetSize(Vector2(200.0f, 200.0f));
+        UIControl* panel = MakeChild(screen, "panel");
+        panel->SetSize(Vector2(200.0f, 200.0f));
+
+        UILayoutSystem* layoutSystem = GetEngineContext()->uiControlSystem->GetLayoutSystem();
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(!screen->IsLayoutChildrenDirty());
+        TEST_VERIFY(!panel->IsLayoutDirty());
+
+        UIControl* isolated = MakeRoot("isolated");
+        isolated->SetSize(Vector2(100.0f, 100.0f));
+        isolated->GetOrCreateComponent<UILayoutIsolationComponent>();
+        UIControl* inner = MakeChild(isolated, "inner");
+        inner->SetSize(Vector2(20.0f, 20.0f));
+        inner->GetOrCreateComponent<UIAnchorComponent>()->SetHCenterAnchorEnabled(true);
+
+        // subtree is attached below already laid out parent
+        panel->AddControl(isolated);
+        TEST_VERIFY(panel->IsLayoutChildrenDirty());
+        TEST_VERIFY(screen->IsLayoutChildrenDirty());
+
+        layoutSystem->ProcessControlHierarhy(screen);
+        TEST_VERIFY(FLOAT_EQUAL_EPS(inner->GetPosition().x, 40.0f, 0.01f));
+        TEST_VERIFY(!isolated->IsLayoutDirty());
+        TEST_VERIFY(!inner->IsLayoutDirty());
+        TEST_VERIFY(!screen->IsLayoutChildrenDirty());
+        TEST_VERIFY(!panel->IsLayoutChildrenDirty());
+
+        SafeRelease(screen);
+        SafeRelease(panel);
+        SafeRelease(isolated);
+        SafeRelease(inner);
+    }
 };
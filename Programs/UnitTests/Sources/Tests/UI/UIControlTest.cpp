@@ -1,5 +1,6 @@
 #include "DAVAEngine.h"
 
+#include "Render/2D/Systems/BatchRecord2D.h"
 #include "UI/UIControlPackageContext.h"
 #include "UnitTests/UnitTests.h"
 
@@ -172,4 +173,89 @@ DAVA_TESTCLASS (UIControlTest)
         TEST_VERIFY(b11->FindByPath("../..") == b);
         TEST_VERIFY(b11->FindByPath("../2/../../2/1") == b21);
     }
+
+    // UIControl::SetRenderDirty
+    DAVA_TEST (RenderDirtyPropagatesToParents)
+    {
+        for (UIControl* control : { root, a, a1, a11, a2, b, b1, b11 })
+        {
+            control->ResetRenderDirty();
+        }
+
+        a11->SetAngle(1.0f);
+        TEST_VERIFY(a11->IsRenderDirty());
+        TEST_VERIFY(a1->IsRenderDirty());
+        TEST_VERIFY(a->IsRenderDirty());
+        TEST_VERIFY(root->IsRenderDirty());
+        TEST_VERIFY(!a2->IsRenderDirty());
+        TEST_VERIFY(!b->IsRenderDirty());
+
+        root->ResetRenderDirty();
+        a->ResetRenderDirty();
+        b1->SetSize(Vector2(10.0f, 10.0f));
+        TEST_VERIFY(b1->IsRenderDirty());
+        TEST_VERIFY(b->IsRenderDirty());
+        TEST_VERIFY(root->IsRenderDirty());
+        TEST_VERIFY(!b11->IsRenderDirty());
+        TEST_VERIFY(!a->IsRenderDirty());
+    }
+    // UIControlBackground setters invalidate retained draw list
+    DAVA_TEST (BackgroundChangesSetRenderDirty)
+    {
+        UIControlBackground* bg = a11->GetOrCreateComponent<UIControlBackground>();
+        for (UIControl* control : { root, a, a1, a11 })
+        {
+            control->ResetRenderDirty();
+        }
+
+        bg->SetDrawColor(bg->GetDrawColor());
+        TEST_VERIFY(!a11->IsRenderDirty());
+
+        bg->SetDrawColor(Color(0.5f, 0.5f, 0.5f, 1.0f));
+        TEST_VERIFY(a11->IsRenderDirty());
+        TEST_VERIFY(root->IsRenderDirty());
+
+        for (UIControl* control : { root, a, a1, a11 })
+        {
+            control->ResetRenderDirty();
+        }
+        bg->SetColor(Color::Red);
+        TEST_VERIFY(a11->IsRenderDirty());
+
+        a11->ResetRenderDirty();
+        bg->SetSprite(nullptr);
+        TEST_VERIFY(a11->IsRenderDirty());
+
+        a11->ResetRenderDirty();
+        bg->SetDrawType(UIControlBackground::DRAW_FILL);
+        TEST_VERIFY(a11->IsRenderDirty());
+
+        a11->RemoveComponent<UIControlBackground>();
+    }
+
+    // BatchRecord2D keeps references of recorded resources only in retaining mode
+    DAVA_TEST (BatchRecordRetainsMaterial)
+    {
+        ScopedPtr<NMaterial> material(new NMaterial());
+        int32 retainCount = material->GetRetainCount();
+
+        BatchRecord2D::Batch batch;
+        batch.material = material;
+        {
+            BatchRecord2D retainedRecord(true);
+            retainedRecord.AddBatch(batch);
+            TEST_VERIFY(material->GetRetainCount() == retainCount + 1);
+
+            retainedRecord.Clear();
+            TEST_VERIFY(material->GetRetainCount() == retainCount);
+
+            retainedRecord.AddBatch(batch);
+            TEST_VERIFY(material->GetRetainCount() == retainCount + 1);
+        }
+        TEST_VERIFY(material->GetRetainCount() == retainCount);
+
+        BatchRecord2D frameRecord;
+        frameRecord.AddBatch(batch);
+        TEST_VERIFY(material->GetRetainCount() == retainCount);
+    }
 };
\ No newline at end of file
@@ -0,0 +1,143 @@
+#include "DAVAEngine.h"
+
+#include "UI/DefaultUIPackageBuilder.h"
+#include "UI/UIControlBackground.h"
+#include "UI/UIControlPackageContext.h"
+#include "UI/UIPackage.h"
+#include "UI/UIPackageBinaryFormat.h"
+#include "UI/UIPackageLoader.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+DAVA_TESTCLASS (UIPackageBinaryFormatTest)
+{
+    DAVA_TEST (CompiledPackageBuildsSameControls)
+    {
+        // "Holder" uses prototype "Button" which is declared after it
+        const String yaml =
+        "Header:\n"
+        "    version: \"21\"\n"
+        "StyleSheets:\n"
+        "-   selector: \"UIControl.highlighted\"\n"
+        "    properties:\n"
+        "        bg-color: [1.0, 0.0, 0.0, 1.0]\n"
+        "Prototypes:\n"
+        "-   class: \"UIControl\"\n"
+        "    name: \"Holder\"\n"
+        "    children:\n"
+        "    -   prototype: \"Button\"\n"
+        "        name: \"Inner\"\n"
+        "-   class: \"UIControl\"\n"
+        "    name: \"Button\"\n"
+        "    size: [40.0, 20.0]\n"
+        "    components:\n"
+        "        Background:\n"
+        "            drawType: \"DRAW_FILL\"\n"
+        "            color: [0.0, 1.0, 0.0, 1.0]\n"
+        "Controls:\n"
+        "-   class: \"UIControl\"\n"
+        "    name: \"Root\"\n"
+        "    size: [100.0, 50.0]\n"
+        "    visible: false\n"
+        "    components:\n"
+        "        Background:\n"
+        "            color: [1.0, 0.5, 0.0, 1.0]\n"
+        "    children:\n"
+        "    -   prototype: \"Button\"\n"
+        "        name: \"Ok\"\n"
+        "        position: [10.0, 5.0]\n";
+
+        FilePath yamlPath("~doc:/UIPackageBinaryFormatTest.yaml");
+        FilePath binaryPath = UIPackageBinaryFormat::GetBinaryPackagePath(yamlPath);
+        TEST_VERIFY(UIPackageBinaryFormat::IsBinaryPackagePath(binaryPath));
+        WriteText(yamlPath, yaml);
+        TEST_VERIFY(UIPackageBinaryFormat::Compile(yamlPath, binaryPath));
+
+        DefaultUIPackageBuilder yamlBuilder;
+        TEST_VERIFY(UIPackageLoader().LoadPackage(yamlPath, &yamlBuilder));
+        DefaultUIPackageBuilder binaryBuilder;
+        TEST_VERIFY(UIPackageLoader().LoadPackage(binaryPath, &binaryBuilder));
+
+        UIPackage* yamlPackage = yamlBuilder.GetPackage();
+        UIPackage* binaryPackage = binaryBuilder.GetPackage();
+        TEST_VERIFY(binaryPackage != nullptr);
+        TEST_VERIFY(binaryPackage->GetPrototypes().size() == yamlPackage->GetPrototypes().size());
+        TEST_VERIFY(binaryPackage->GetControls().size() == yamlPackage->GetControls().size());
+        TEST_VERIFY(binaryPackage->GetControlPackageContext()->GetSortedStyleSheets().size() == 1);
+
+        UIControl* root = binaryPackage->GetControl("Root");
+        TEST_VERIFY(root != nullptr);
+        TEST_VERIFY(IsEqual(yamlPackage->GetControl("Root"), root));
+        TEST_VERIFY(root->GetSize() == Vector2(100.0f, 50.0f));
+        TEST_VERIFY(!root->GetVisibilityFlag());
+        TEST_VERIFY(root->GetComponent<UIControlBackground>()->GetColor() == Color(1.0f, 0.5f, 0.0f, 1.0f));
+
+        UIControl* ok = root->FindByName("Ok");
+        TEST_VERIFY(ok != nullptr);
+        TEST_VERIFY(ok->GetPosition() == Vector2(10.0f, 5.0f));
+        TEST_VERIFY(ok->GetComponent<UIControlBackground>()->GetDrawType() == UIControlBackground::DRAW_FILL);
+
+        UIControl* holder = binaryPackage->GetPrototype("Holder");
+        TEST_VERIFY(holder != nullptr);
+        TEST_VERIFY(IsEqual(yamlPackage->GetPrototype("Holder"), holder));
+
+        FileSystem::Instance()->DeleteFile(yamlPath);
+        FileSystem::Instance()->DeleteFile(binaryPath);
+    }
+
+    DAVA_TEST (EmptyPackage)
+    {
+        FilePath yamlPath("~doc:/UIPackageBinaryFormatEmptyTest.yaml");
+        FilePath binaryPath = UIPackageBinaryFormat::GetBinaryPackagePath(yamlPath);
+        WriteText(yamlPath, "");
+        TEST_VERIFY(UIPackageBinaryFormat::Compile(yamlPath, binaryPath));
+
+        DefaultUIPackageBuilder builder;
+        TEST_VERIFY(UIPackageLoader().LoadPackage(binaryPath, &builder));
+        TEST_VERIFY(builder.GetPackage() != nullptr);
+        TEST_VERIFY(builder.GetPackage()->GetControls().empty());
+
+        FileSystem::Instance()->DeleteFile(yamlPath);
+        FileSystem::Instance()->DeleteFile(binaryPath);
+    }
+
+    DAVA_TEST (CorruptedPackageIsRejected)
+    {
+        FilePath path("~doc:/UIPackageBinaryFormatCorruptedTest.uib");
+        WriteText(path, "not a binary package");
+
+        DefaultUIPackageBuilder builder;
+        TEST_VERIFY(!UIPackageLoader().LoadPackage(path, &builder));
+        TEST_VERIFY(builder.GetPackage() == nullptr);
+
+        FileSystem::Instance()->DeleteFile(path);
+    }
+
+    void WriteText(const FilePath& path, const String& text)
+    {
+        ScopedPtr<File> file(File::Create(path, File::CREATE | File::WRITE));
+        TEST_VERIFY(file);
+        file->Write(text.data(), static_cast<uint32>(text.size()));
+    }
+
+    bool IsEqual(const UIControl* a, const UIControl* b)
+    {
+        if (a->GetName() != b->GetName() || a->GetRect() != b->GetRect() || a->GetChildren().size() != b->GetChildren().size())
+        {
+            return false;
+        }
+
+        auto itA = a->GetChildren().begin();
+        auto itB = b->GetChildren().begin();
+        for (; itA != a->GetChildren().end(); ++itA, ++itB)
+        {
+            if (!IsEqual(itA->Get(), itB->Get()))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+};
@@ -0,0 +1,83 @@
+#include "DAVAEngine.h"
+
+#include "Render/Highlevel/Vegetation/VegetationGeometry.h"
+#include "Render/Highlevel/Vegetation/VegetationGeometryData.h"
+
+#include "UnitTests/UnitTests.h"
+
+using namespace DAVA;
+
+namespace VegetationGeometryTestDetails
+{
+const uint32 RESOLUTION_CELL_SQUARE[] = { 1, 4, 16 };
+const float32 RESOLUTION_SCALE[] = { 1.0f, 2.0f, 4.0f };
+const uint32 RESOLUTION_TILES_PER_ROW[] = { 4, 2, 1 };
+const uint32 RESOLUTION_CLUSTER_STRIDE[] = { 1, 2, 4 };
+
+// Each layer is a quad with `lodCount` lods
+VegetationGeometryDataPtr CreateGeometryData(uint32 layerCount, uint32 lodCount, const Vector3& normal)
+{
+    ScopedPtr<NMaterial> material(new NMaterial());
+    Vector<NMaterial*> materials(layerCount, material.get());
+
+    Vector<Vector3> quadPositions = { Vector3(-0.5f, 0.0f, 0.0f), Vector3(0.5f, 0.0f, 0.0f), Vector3(0.5f, 0.0f, 1.0f), Vector3(-0.5f, 0.0f, 1.0f) };
+    Vector<Vector2> quadTexCoords = { Vector2(0.0f, 0.0f), Vector2(1.0f, 0.0f), Vector2(1.0f, 1.0f), Vector2(0.0f, 1.0f) };
+    Vector<Vector3> quadNormals(4, normal);
+    Vector<VegetationIndex> quadIndices = { 0, 1, 2, 0, 2, 3 };
+
+    Vector<Vector<Vector<Vector3>>> positions(layerCount, Vector<Vector<Vector3>>(lodCount, quadPositions));
+    Vector<Vector<Vector<Vector2>>> texCoords(layerCount, Vector<Vector<Vector2>>(lodCount, quadTexCoords));
+    Vector<Vector<Vector<Vector3>>> normals(layerCount, Vector<Vector<Vector3>>(lodCount, quadNormals));
+    Vector<Vector<Vector<VegetationIndex>>> indices(layerCount, Vector<Vector<VegetationIndex>>(lodCount, quadIndices));
+
+    return VegetationGeometryDataPtr(new VegetationGeometryData(materials, positions, texCoords, normals, indices));
+}
+
+std::unique_ptr<VegetationGeometry> CreateGeometry(const VegetationGeometryDataPtr& geometryData)
+{
+    Vector<VegetationLayerParams> layerParams(geometryData->GetLayerCount(), VegetationLayerParams{ 4, 0.0f, 0.0f });
+    return std::unique_ptr<VegetationGeometry>(new VegetationGeometry(layerParams, 16, Vector2(1.0f, 1.0f), FilePath(),
+                                                                      RESOLUTION_CELL_SQUARE, 3, RESOLUTION_SCALE, 3,
+                                                                      RESOLUTION_TILES_PER_ROW, 3, RESOLUTION_CLUSTER_STRIDE, 3,
+                                                                      Vector3(64.0f, 64.0f, 10.0f), geometryData));
+}
+
+bool IsLoadedFromCache(const VegetationGeometryDataPtr& geometryData, VegetationRenderData& renderData)
+{
+    std::unique_ptr<VegetationGeometry> geometry = CreateGeometry(geometryData);
+    geometry->Build(&renderData);
+    return geometry->IsLoadedFromCache();
+}
+}
+
+DAVA_TESTCLASS (VegetationGeometryTest)
+{
+    DAVA_TEST (CacheHitAndMissTest)
+    {
+        using namespace VegetationGeometryTestDetails;
+
+        FileSystem::Instance()->DeleteDirectory("~doc:/VegetationCache/", true);
+
+        VegetationGeometryDataPtr geometryData = CreateGeometryData(1, 2, Vector3(0.0f, -1.0f, 0.0f));
+        VegetationRenderData generatedData;
+        TEST_VERIFY(!IsLoadedFromCache(geometryData, generatedData));
+        TEST_VERIFY(!generatedData.GetVertices().empty());
+
+        // same input is read from cache and gives the same buffers
+        VegetationRenderData cachedData;
+        TEST_VERIFY(IsLoadedFromCache(geometryData, cachedData));
+        TEST_VERIFY(cachedData.GetVertices().size() == generatedData.GetVertices().size());
+        TEST_VERIFY(Memcmp(cachedData.GetVertices().data(), generatedData.GetVertices().data(), generatedData.GetVertices().size() * sizeof(VegetationVertex)) == 0);
+        TEST_VERIFY(cachedData.GetIndices() == generatedData.GetIndices());
+        TEST_VERIFY(cachedData.GetIndexBuffers().size() == generatedData.GetIndexBuffers().size());
+
+        // changed normals and changed layout of the same geometry are not read from cache
+        VegetationRenderData otherNormalsData;
+        TEST_VERIFY(!IsLoadedFromCache(CreateGeometryData(1, 2, Vector3(0.0f, 1.0f, 0.0f)), otherNormalsData));
+
+        VegetationRenderData otherLayoutData;
+        TEST_VERIFY(!IsLoadedFromCache(CreateGeometryData(1, 3, Vector3(0.0f, -1.0f, 0.0f)), otherLayoutData));
+
+        FileSystem::Instance()->DeleteDirectory("~doc:/VegetationCache/", true);
+    }
+};
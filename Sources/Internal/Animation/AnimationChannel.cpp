@@ -1,14 +1,48 @@
 #include "AnimationChannel.h"
 #include "Base/BaseMath.h"
 #include "Debug/DVAssert.h"
+#include "Logger/Logger.h"
 
 namespace DAVA
 {
+namespace AnimationChannelDetails
+{
+const uint32 MAX_COMPRESSED_DIMENSION = 4;
+const uint32 QUATERNION_COMPONENT_BITS = 15;
+const uint32 QUATERNION_COMPONENT_MASK = (1 << QUATERNION_COMPONENT_BITS) - 1;
+const float32 QUATERNION_COMPONENT_RANGE = 0.70710678f; //all components except largest are in [-1/sqrt(2), 1/sqrt(2)]
+
+//'smallest three': 2 bits of largest component index and three other components by 15 bits
+void UnpackQuaternion(const uint16* packedData, float32* outData)
+{
+    uint64 packed = uint64(packedData[0]) | (uint64(packedData[1]) << 16) | (uint64(packedData[2]) << 32);
+    uint32 largest = uint32(packed >> (3 * QUATERNION_COMPONENT_BITS)) & 3;
+
+    float32 squaredSum = 0.f;
+    uint32 shift = 2 * QUATERNION_COMPONENT_BITS;
+    for (uint32 c = 0; c < 4; ++c)
+    {
+        if (c == largest)
+            continue;
+
+        uint32 quantized = uint32(packed >> shift) & QUATERNION_COMPONENT_MASK;
+        float32 value = (float32(quantized) / float32(QUATERNION_COMPONENT_MASK) * 2.f - 1.f) * QUATERNION_COMPONENT_RANGE;
+        outData[c] = value;
+        squaredSum += value * value;
+        shift -= QUATERNION_COMPONENT_BITS;
+    }
+
+    outData[largest] = std::sqrt(Max(0.f, 1.f - squaredSum));
+}
+}
+
 uint32 AnimationChannel::Bind(const uint8* _data)
 {
     keysData = nullptr;
     dimension = 0;
     keyStride = keysCount = 0;
+    keysTime = nullptr;
+    valueRange = nullptr;
 
     const uint8* dataptr = _data;
     if (_data != nullptr && *reinterpret_cast<const uint32*>(_data) == ANIMATION_CHANNEL_DATA_SIGNATURE)
@@ -27,6 +61,9 @@ uint32 AnimationChannel::Bind(const uint8* _data)
         keysCount = *reinterpret_cast<const uint32*>(dataptr);
         dataptr += 4;
 
+        if (compression != COMPRESSION_NONE)
+            return BindCompressed(_data, dataptr);
+
         keysData = dataptr;
 
         keyStride = uint32(sizeof(float32)) * (dimension + 1);
@@ -37,6 +74,51 @@ uint32 AnimationChannel::Bind(const uint8* _data)
     return uint32(keysData - _data) + keysCount * keyStride;
 }
 
+uint32 AnimationChannel::BindCompressed(const uint8* channelData, const uint8* dataptr)
+{
+    using namespace AnimationChannelDetails;
+
+    bool isQuantized = (compression & COMPRESSION_QUANTIZED) != 0;
+    bool isQuaternion = (interpolation == INTERPOLATION_SPHERICAL_LINEAR);
+    if ((compression & ~(COMPRESSION_UNIFORM_SAMPLES | COMPRESSION_QUANTIZED)) != 0 || interpolation == INTERPOLATION_BEZIER ||
+        dimension > MAX_COMPRESSED_DIMENSION || keysCount == 0 || (isQuaternion && dimension != 4))
+    {
+        Logger::Error("[AnimationChannel::Bind] Unsupported compression %u for channel with interpolation %u and dimension %u",
+                      uint32(compression), uint32(interpolation), uint32(dimension));
+        dimension = 0;
+        keysCount = 0;
+        return 0;
+    }
+
+    if (compression & COMPRESSION_UNIFORM_SAMPLES)
+    {
+        startTime = *reinterpret_cast<const float32*>(dataptr);
+        sampleInterval = *reinterpret_cast<const float32*>(dataptr + 4);
+        dataptr += 8;
+    }
+    else
+    {
+        keysTime = reinterpret_cast<const float32*>(dataptr);
+        dataptr += keysCount * sizeof(float32);
+    }
+
+    if (isQuantized && !isQuaternion)
+    {
+        valueRange = reinterpret_cast<const float32*>(dataptr); //minimum, then step for each component
+        dataptr += 2 * dimension * sizeof(float32);
+    }
+
+    keysData = dataptr;
+
+    if (isQuantized)
+        keyStride = isQuaternion ? 3 * sizeof(uint16) : dimension * sizeof(uint16);
+    else
+        keyStride = dimension * sizeof(float32);
+
+    uint32 size = uint32(keysData - channelData) + keysCount * keyStride;
+    return (size + 3) & ~3u; //channels are aligned by 4 bytes
+}
+
 #define KEY_DATA_SIZE (dimension * sizeof(float32))
 #define KEY_TIME(keyIndex) (*reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride))
 #define KEY_DATA(keyIndex) (reinterpret_cast<const float32*>(keysData + (keyIndex)*keyStride + sizeof(float32)))
@@ -46,21 +128,13 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
 {
     DVASSERT(dataSize >= GetDimension());
 
-    uint32 k = startKey;
-
-    if (KEY_TIME(k) > time)
+    if (compression != COMPRESSION_NONE)
     {
-        k = 0;
-    }
-
-    for (; k < keysCount; ++k)
-    {
-        if (KEY_TIME(k) > time)
-            break;
-
-        startKey = k;
+        EvaluateCompressed(time, outData);
+        return;
     }
 
+    uint32 k = FindNextKey(time);
     if (k == 0)
     {
         Memcpy(outData, KEY_DATA(0), KEY_DATA_SIZE);
@@ -115,6 +189,107 @@ void AnimationChannel::Evaluate(float32 time, float32* outData, uint32 dataSize)
     }
 }
 
+//index of first key after `time` or keys count
+uint32 AnimationChannel::FindNextKey(float32 time) const
+{
+    if (keysTime != nullptr)
+        return uint32(std::upper_bound(keysTime, keysTime + keysCount, time) - keysTime);
+
+    uint32 first = 0;
+    uint32 count = keysCount;
+    while (count > 0)
+    {
+        uint32 step = count / 2;
+        if (KEY_TIME(first + step) > time)
+        {
+            count = step;
+        }
+        else
+        {
+            first += step + 1;
+            count -= step + 1;
+        }
+    }
+    return first;
+}
+
+void AnimationChannel::EvaluateCompressed(float32 time, float32* outData) const
+{
+    uint32 k0 = 0;
+    uint32 k1 = 0;
+    float32 t = 0.f;
+
+    if (keysTime == nullptr)
+    {
+        float32 position = (sampleInterval > 0.f) ? (time - startTime) / sampleInterval : 0.f;
+        if (position >= float32(keysCount - 1))
+        {
+            k0 = k1 = keysCount - 1;
+        }
+        else if (position > 0.f)
+        {
+            k0 = uint32(position);
+            k1 = k0 + 1;
+            t = position - float32(k0);
+        }
+    }
+    else
+    {
+        uint32 k = FindNextKey(time);
+        if (k == keysCount)
+        {
+            k0 = k1 = keysCount - 1;
+        }
+        else if (k > 0)
+        {
+            k0 = k - 1;
+            k1 = k;
+            t = (time - keysTime[k0]) / (keysTime[k1] - keysTime[k0]);
+        }
+    }
+
+    DecodeKey(k0, outData);
+    if (k0 == k1)
+        return;
+
+    float32 value1[AnimationChannelDetails::MAX_COMPRESSED_DIMENSION];
+    DecodeKey(k1, value1);
+
+    if (interpolation == INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        Quaternion q0(outData);
+        Quaternion q(value1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+
+        Memcpy(outData, q.data, 4 * sizeof(float32));
+    }
+    else
+    {
+        for (uint32 d = 0; d < uint32(dimension); ++d)
+            outData[d] = Lerp(outData[d], value1[d], t);
+    }
+}
+
+void AnimationChannel::DecodeKey(uint32 keyIndex, float32* outData) const
+{
+    const uint8* keyData = keysData + keyIndex * keyStride;
+    if ((compression & COMPRESSION_QUANTIZED) == 0)
+    {
+        Memcpy(outData, keyData, dimension * sizeof(float32));
+    }
+    else if (interpolation == INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        AnimationChannelDetails::UnpackQuaternion(reinterpret_cast<const uint16*>(keyData), outData);
+    }
+    else
+    {
+        const uint16* quantized = reinterpret_cast<const uint16*>(keyData);
+        for (uint32 d = 0; d < uint32(dimension); ++d)
+            outData[d] = valueRange[d] + float32(quantized[d]) * valueRange[dimension + d];
+    }
+}
+
 #undef KEY_DATA_SIZE
 #undef KEY_TIME
 #undef KEY_DATA
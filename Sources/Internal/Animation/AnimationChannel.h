@@ -4,6 +4,7 @@
 
 namespace DAVA
 {
+//Channel has no mutable state, so clip shared between skeletons can be evaluated from different threads
 class AnimationChannel
 {
 public:
@@ -18,25 +19,49 @@ public:
         INTERPOLATION_COUNT
     };
 
+    //flags, layout of compressed channel is described in 'AnimationBinaryFormat.md'
+    enum eCompression : uint16
+    {
+        COMPRESSION_NONE = 0,
+        COMPRESSION_UNIFORM_SAMPLES = 1 << 0, //keys have no time, they are sampled with fixed interval
+        COMPRESSION_QUANTIZED = 1 << 1, //quaternions are packed to 48 bits, other values to uint16 relative to range
+    };
+
     AnimationChannel() = default;
 
     uint32 Bind(const uint8* data);
     void Evaluate(float32 time, float32* outData, uint32 dataSize) const;
 
     uint32 GetDimension() const;
+    uint32 GetKeysCount() const;
 
 private:
+    uint32 BindCompressed(const uint8* channelData, const uint8* dataptr);
+    uint32 FindNextKey(float32 time) const;
+    void EvaluateCompressed(float32 time, float32* outData) const;
+    void DecodeKey(uint32 keyIndex, float32* outData) const;
+
     const DAVA::uint8* keysData = nullptr;
-    mutable uint32 startKey = 0;
     uint32 keysCount = 0;
     uint32 keyStride = 0;
     uint16 compression = 0;
     uint8 dimension = 0;
     eInterpolation interpolation = INTERPOLATION_COUNT;
+
+    //compressed channel data
+    const float32* keysTime = nullptr;
+    const float32* valueRange = nullptr;
+    float32 startTime = 0.0f;
+    float32 sampleInterval = 0.0f;
 };
 
 inline uint32 AnimationChannel::GetDimension() const
 {
     return uint32(dimension);
 }
-}
\ No newline at end of file
+
+inline uint32 AnimationChannel::GetKeysCount() const
+{
+    return keysCount;
+}
+}
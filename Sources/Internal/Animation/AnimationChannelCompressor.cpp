@@ -0,0 +1,251 @@
+#include "Animation/AnimationChannelCompressor.h"
+#include "Base/BaseMath.h"
+#include "Debug/DVAssert.h"
+
+namespace DAVA
+{
+namespace AnimationChannelCompressorDetails
+{
+const float32 UNIFORM_SAMPLES_EPSILON = 1e-3f; //relative to sample interval
+const uint32 QUATERNION_COMPONENT_BITS = 15;
+const uint32 QUATERNION_COMPONENT_MASK = (1 << QUATERNION_COMPONENT_BITS) - 1;
+const float32 QUATERNION_COMPONENT_RANGE = 0.70710678f; //all components except largest are in [-1/sqrt(2), 1/sqrt(2)]
+
+void WriteToBuffer(Vector<uint8>& buffer, const void* data, uint32 size)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(data);
+    buffer.insert(buffer.end(), bytes, bytes + size);
+}
+
+template <class T>
+void WriteToBuffer(Vector<uint8>& buffer, const T& value)
+{
+    WriteToBuffer(buffer, &value, uint32(sizeof(T)));
+}
+
+void Interpolate(AnimationChannel::eInterpolation interpolation, uint32 dimension, const float32* v0, const float32* v1, float32 t, float32* outData)
+{
+    if (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR)
+    {
+        Quaternion q0(v0);
+        Quaternion q(v1);
+        q.Slerp(q0, q, t);
+        q.Normalize();
+        Memcpy(outData, q.data, 4 * sizeof(float32));
+    }
+    else
+    {
+        for (uint32 d = 0; d < dimension; ++d)
+            outData[d] = Lerp(v0[d], v1[d], t);
+    }
+}
+
+//keys between `first` and `last` are restored by interpolation of `first` and `last` within tolerance
+bool CanSkipKeys(AnimationChannel::eInterpolation interpolation, uint32 dimension, const Vector<float32>& times, const Vector<float32>& values,
+                 uint32 first, uint32 last, float32 tolerance)
+{
+    float32 duration = times[last] - times[first];
+    float32 interpolated[4];
+    for (uint32 k = first + 1; k < last; ++k)
+    {
+        float32 t = (duration > 0.f) ? (times[k] - times[first]) / duration : 0.f;
+        Interpolate(interpolation, dimension, &values[first * dimension], &values[last * dimension], t, interpolated);
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            if (std::abs(interpolated[d] - values[k * dimension + d]) > tolerance)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+Vector<uint32> ReduceKeys(AnimationChannel::eInterpolation interpolation, uint32 dimension, const Vector<float32>& times, const Vector<float32>& values, float32 tolerance)
+{
+    uint32 keysCount = uint32(times.size());
+
+    Vector<uint32> keys;
+    keys.push_back(0);
+
+    uint32 anchor = 0;
+    for (uint32 k = 2; k < keysCount; ++k)
+    {
+        if (!CanSkipKeys(interpolation, dimension, times, values, anchor, k, tolerance))
+        {
+            anchor = k - 1;
+            keys.push_back(anchor);
+        }
+    }
+
+    if (keysCount > 1)
+        keys.push_back(keysCount - 1);
+
+    return keys;
+}
+
+bool IsUniformlySampled(const Vector<float32>& times, float32& outInterval)
+{
+    uint32 keysCount = uint32(times.size());
+    outInterval = (keysCount > 1) ? (times.back() - times.front()) / float32(keysCount - 1) : 0.f;
+    if (keysCount > 1 && outInterval <= 0.f)
+        return false;
+
+    for (uint32 k = 1; k < keysCount; ++k)
+    {
+        if (std::abs(times[k] - times.front() - float32(k) * outInterval) > outInterval * UNIFORM_SAMPLES_EPSILON)
+            return false;
+    }
+
+    return true;
+}
+
+void PackQuaternion(const float32* q, uint16* outData)
+{
+    uint32 largest = 0;
+    for (uint32 c = 1; c < 4; ++c)
+    {
+        if (std::abs(q[c]) > std::abs(q[largest]))
+            largest = c;
+    }
+
+    //q and -q are the same rotation, so largest component is always stored as positive
+    float32 sign = (q[largest] < 0.f) ? -1.f : 1.f;
+
+    uint64 packed = largest;
+    for (uint32 c = 0; c < 4; ++c)
+    {
+        if (c == largest)
+            continue;
+
+        float32 normalized = Clamp((sign * q[c] / QUATERNION_COMPONENT_RANGE + 1.f) * 0.5f, 0.f, 1.f);
+        packed = (packed << QUATERNION_COMPONENT_BITS) | uint64(normalized * float32(QUATERNION_COMPONENT_MASK) + 0.5f);
+    }
+
+    outData[0] = uint16(packed);
+    outData[1] = uint16(packed >> 16);
+    outData[2] = uint16(packed >> 32);
+}
+}
+
+void AnimationChannelCompressor::Write(AnimationChannel::eInterpolation interpolation, uint32 dimension, const Vector<float32>& times, const Vector<float32>& sourceValues,
+                                       const Settings& settings, Vector<uint8>& outData)
+{
+    using namespace AnimationChannelCompressorDetails;
+
+    DVASSERT(interpolation == AnimationChannel::INTERPOLATION_LINEAR || interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+    DVASSERT(dimension > 0 && dimension <= 4 && (interpolation != AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR || dimension == 4));
+    DVASSERT(!times.empty() && sourceValues.size() == times.size() * dimension);
+
+    bool isQuaternion = (interpolation == AnimationChannel::INTERPOLATION_SPHERICAL_LINEAR);
+    uint32 sourceKeysCount = uint32(times.size());
+
+    Vector<float32> values = sourceValues;
+    if (isQuaternion)
+    {
+        //keep neighbour quaternions in the same hemisphere, so components are compared correctly by key reduction
+        for (uint32 k = 0; k < sourceKeysCount; ++k)
+        {
+            Quaternion q(&values[k * 4]);
+            q.Normalize();
+            if (k > 0 && q.DotProduct(Quaternion(&values[(k - 1) * 4])) < 0.f)
+                q = Quaternion(-q.x, -q.y, -q.z, -q.w);
+            Memcpy(&values[k * 4], q.data, 4 * sizeof(float32));
+        }
+    }
+
+    Vector<uint32> keys = ReduceKeys(interpolation, dimension, times, values, settings.tolerance);
+
+    uint32 valueSize = dimension * uint32(sizeof(float32));
+    if (settings.quantize)
+        valueSize = isQuaternion ? 3 * uint32(sizeof(uint16)) : dimension * uint32(sizeof(uint16));
+
+    uint16 compression = settings.quantize ? AnimationChannel::COMPRESSION_QUANTIZED : AnimationChannel::COMPRESSION_NONE;
+
+    float32 sampleInterval = 0.f;
+    if (settings.uniformSamples && IsUniformlySampled(times, sampleInterval) &&
+        sourceKeysCount * valueSize <= uint32(keys.size()) * (valueSize + uint32(sizeof(float32))))
+    {
+        compression |= AnimationChannel::COMPRESSION_UNIFORM_SAMPLES;
+
+        keys.resize(sourceKeysCount);
+        for (uint32 k = 0; k < sourceKeysCount; ++k)
+            keys[k] = k;
+    }
+
+    uint32 channelStart = uint32(outData.size());
+
+    uint32 signature = AnimationChannel::ANIMATION_CHANNEL_DATA_SIGNATURE;
+    WriteToBuffer(outData, signature);
+    WriteToBuffer(outData, uint8(dimension));
+    WriteToBuffer(outData, uint8(interpolation));
+    WriteToBuffer(outData, compression);
+    WriteToBuffer(outData, uint32(keys.size()));
+
+    if (compression == AnimationChannel::COMPRESSION_NONE)
+    {
+        for (uint32 k : keys)
+        {
+            WriteToBuffer(outData, times[k]);
+            WriteToBuffer(outData, &values[k * dimension], valueSize);
+        }
+        return;
+    }
+
+    if (compression & AnimationChannel::COMPRESSION_UNIFORM_SAMPLES)
+    {
+        WriteToBuffer(outData, times.front());
+        WriteToBuffer(outData, sampleInterval);
+    }
+    else
+    {
+        for (uint32 k : keys)
+            WriteToBuffer(outData, times[k]);
+    }
+
+    if (!settings.quantize)
+    {
+        for (uint32 k : keys)
+            WriteToBuffer(outData, &values[k * dimension], valueSize);
+    }
+    else if (isQuaternion)
+    {
+        uint16 packed[3];
+        for (uint32 k : keys)
+        {
+            PackQuaternion(&values[k * 4], packed);
+            WriteToBuffer(outData, packed, valueSize);
+        }
+    }
+    else
+    {
+        float32 minValue[4];
+        float32 step[4];
+        for (uint32 d = 0; d < dimension; ++d)
+        {
+            float32 maxValue = -std::numeric_limits<float32>::max();
+            minValue[d] = std::numeric_limits<float32>::max();
+            for (uint32 k : keys)
+            {
+                minValue[d] = Min(minValue[d], values[k * dimension + d]);
+                maxValue = Max(maxValue, values[k * dimension + d]);
+            }
+            step[d] = (maxValue - minValue[d]) / 65535.f;
+        }
+
+        WriteToBuffer(outData, minValue, dimension * uint32(sizeof(float32)));
+        WriteToBuffer(outData, step, dimension * uint32(sizeof(float32)));
+
+        for (uint32 k : keys)
+        {
+            for (uint32 d = 0; d < dimension; ++d)
+            {
+                float32 normalized = (step[d] > 0.f) ? (values[k * dimension + d] - minValue[d]) / step[d] : 0.f;
+                WriteToBuffer(outData, uint16(Clamp(normalized + 0.5f, 0.f, 65535.f)));
+            }
+        }
+    }
+
+    uint32 channelSize = uint32(outData.size()) - channelStart;
+    outData.resize(outData.size() + ((4 - (channelSize & 3)) & 3), 0);
+}
+}
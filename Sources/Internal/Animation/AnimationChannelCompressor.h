@@ -0,0 +1,31 @@
+#pragma once
+
+#include "Animation/AnimationChannel.h"
+
+namespace DAVA
+{
+/**
+    Writes AnimationChannel data with lossy compression.
+    Keys which can be restored by interpolation of neighbour keys within tolerance are removed, values are quantized
+    ('smallest three' 48-bit quaternions or uint16 relative to value range) and key times are dropped
+    if source keys are uniformly sampled and it takes less space than reduced keys.
+*/
+class AnimationChannelCompressor final
+{
+public:
+    struct Settings
+    {
+        float32 tolerance = 0.f; //max absolute error of value component for key reduction, zero keeps all keys
+        bool quantize = true;
+        bool uniformSamples = true;
+    };
+
+    /**
+        Appends channel data in format described in 'AnimationBinaryFormat.md' to `outData`.
+        `values` contains `dimension` components for each of `times`. Bezier interpolation isn't supported.
+        Without quantization and uniform samples channel is written uncompressed.
+    */
+    static void Write(AnimationChannel::eInterpolation interpolation, uint32 dimension, const Vector<float32>& times, const Vector<float32>& values,
+                      const Settings& settings, Vector<uint8>& outData);
+};
+}
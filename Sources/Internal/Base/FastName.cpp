@@ -29,38 +29,97 @@ void FastNameDB::SetMasterDB(FastNameDB* db)
     *localDBPtr = db;
 }
 
-void FastName::Init(const char* name)
+FastNameDB::FastNameDB()
 {
-    DVASSERT(nullptr != name);
+    for (Shard& shard : shards)
+    {
+        for (std::atomic<const Entry*>& bucket : shard.buckets)
+        {
+            bucket.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+}
+
+FastNameDB::~FastNameDB()
+{
+    for (Shard& shard : shards)
+    {
+        for (std::atomic<const Entry*>& bucket : shard.buckets)
+        {
+            const Entry* entry = bucket.load(std::memory_order_relaxed);
+            while (entry != nullptr)
+            {
+                const Entry* next = entry->next;
+                delete[] reinterpret_cast<const uint8*>(entry);
+                entry = next;
+            }
+        }
+    }
+}
+
+const FastNameDB::Entry* FastNameDB::FindEntry(const Entry* first, const Entry* last, const CharT* name, size_t length, uint32 hash)
+{
+    for (const Entry* entry = first; entry != last; entry = entry->next)
+    {
+        if (entry->hash == hash && entry->length == length && 0 == memcmp(entry->GetName(), name, length * sizeof(CharT)))
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
 
-    FastNameDB* db = FastNameDB::GetLocalDB();
-    LockGuard<FastNameDB::MutexT> guard(db->mutex);
+const FastNameDB::CharT* FastNameDB::Intern(const CharT* name, size_t length, uint32 hash)
+{
+    Shard& shard = shards[hash % SHARDS_COUNT];
+    std::atomic<const Entry*>& bucket = shard.buckets[(hash / SHARDS_COUNT) % SHARD_BUCKETS_COUNT];
 
-    // search if that name is already in hash
-    auto it = db->nameToIndexMap.find(name);
-    if (it != db->nameToIndexMap.end())
+    // search if that name is already in db
+    const Entry* head = bucket.load(std::memory_order_acquire);
+    const Entry* entry = FindEntry(head, nullptr, name, length, hash);
+    if (entry != nullptr)
     {
-        // already exist, so we just need to set the same index to this object
-        str = db->namesTable[it->second];
+        return entry->GetName();
     }
-    else
+
+    LockGuard<MutexT> guard(shard.mutex);
+
+    // name could be added by other thread before lock, so check entries inserted since first lookup
+    const Entry* lockedHead = bucket.load(std::memory_order_relaxed);
+    entry = FindEntry(lockedHead, head, name, length, hash);
+    if (entry != nullptr)
     {
-        // string isn't in hash and it isn't in names table, so we need to copy it
-        // and find place for copied string in names table and set it
-        size_t nameLen = strlen(name);
-        FastNameDB::CharT* nameCopy = new FastNameDB::CharT[nameLen + 1];
-        memcpy(nameCopy, name, nameLen + 1);
+        return entry->GetName();
+    }
 
-        db->sizeOfNames += (nameLen * sizeof(FastNameDB::CharT));
+    // name isn't in db, so we need to copy it right after new entry and publish entry in bucket
+    uint8* memory = new uint8[sizeof(Entry) + (length + 1) * sizeof(CharT)];
+    Entry* newEntry = new (memory) Entry();
+    newEntry->next = lockedHead;
+    newEntry->hash = hash;
+    newEntry->length = static_cast<uint32>(length);
 
-        // index will be a new row in names table
-        size_t index = db->namesTable.size();
+    CharT* nameCopy = reinterpret_cast<CharT*>(memory + sizeof(Entry));
+    memcpy(nameCopy, name, length * sizeof(CharT));
+    nameCopy[length] = 0;
 
-        db->namesTable.push_back(nameCopy);
-        db->nameToIndexMap.emplace(nameCopy, index);
+    bucket.store(newEntry, std::memory_order_release);
+    return nameCopy;
+}
 
-        str = nameCopy;
+void FastName::Init(const char* name)
+{
+    DVASSERT(nullptr != name);
+
+    // length and hash are evaluated in one pass, result is equal to FastNameDB::HashName
+    uint32 hash = FastNameDB::HASH_OFFSET_BASIS;
+    size_t length = 0;
+    for (; name[length] != 0; ++length)
+    {
+        hash = (hash ^ uint32(uint8(name[length]))) * FastNameDB::HASH_PRIME;
     }
+
+    str = FastNameDB::GetLocalDB()->Intern(name, length, hash);
 }
 
 template <>
@@ -5,6 +5,8 @@
 #include "Base/Any.h"
 #include "Concurrency/Spinlock.h"
 
+#include <atomic>
+
 namespace DAVA
 {
 class FastNameDB final
@@ -15,48 +17,54 @@ public:
     using MutexT = Spinlock;
     using CharT = char;
 
+    static const uint32 HASH_OFFSET_BASIS = 2166136261u;
+    static const uint32 HASH_PRIME = 16777619u;
+
     static FastNameDB* GetLocalDB();
     void SetMasterDB(FastNameDB* masterDB);
 
-private:
-    FastNameDB()
-        : nameToIndexMap(8192 * 2)
+    // FNV-1a hash of name, names are stored in db with this hash.
+    // Can be evaluated at compile time for string literals, see DV_FASTNAME.
+    static DAVA_CONSTEXPR uint32 HashName(const CharT* name, size_t length, uint32 hash = HASH_OFFSET_BASIS)
     {
-        namesTable.reserve(512);
+        return (length == 0) ? hash : HashName(name + 1, length - 1, (hash ^ uint32(uint8(*name))) * HASH_PRIME);
     }
 
-    ~FastNameDB()
-    {
-        const size_t count = namesTable.size();
-        for (size_t i = 0; i < count; ++i)
-        {
-            SafeDeleteArray(namesTable[i]);
-        }
-    }
-
-    static FastNameDB** GetLocalDBPtr();
+private:
+    static const uint32 SHARDS_COUNT = 32;
+    static const uint32 SHARD_BUCKETS_COUNT = 512;
 
-    struct FastNameDBHash
+    // Name characters are allocated right after the entry, so entry can be found by FastName string pointer
+    struct Entry
     {
-        size_t operator()(const char* str) const
+        const Entry* next;
+        uint32 hash;
+        uint32 length;
+
+        const CharT* GetName() const
         {
-            return DavaHashString(str);
+            return reinterpret_cast<const CharT*>(this + 1);
         }
     };
 
-    struct FastNameDBEqualTo
+    // Entries are never removed and are published to buckets with release store,
+    // so lookup reads buckets without lock and only insertion locks the shard.
+    struct Shard
     {
-        bool operator()(const char* left, const char* right) const
-        {
-            return (0 == strcmp(left, right));
-        }
+        std::atomic<const Entry*> buckets[SHARD_BUCKETS_COUNT];
+        MutexT mutex;
     };
 
-    Vector<const CharT*> namesTable;
-    UnorderedMap<const CharT*, size_t, FastNameDBHash, FastNameDBEqualTo> nameToIndexMap;
+    FastNameDB();
+    ~FastNameDB();
 
-    MutexT mutex;
-    size_t sizeOfNames = 0;
+    static FastNameDB** GetLocalDBPtr();
+    static const Entry* GetEntry(const CharT* name);
+    static const Entry* FindEntry(const Entry* first, const Entry* last, const CharT* name, size_t length, uint32 hash);
+
+    const CharT* Intern(const CharT* name, size_t length, uint32 hash);
+
+    Shard shards[SHARDS_COUNT];
 };
 
 class FastName
@@ -65,6 +73,8 @@ public:
     FastName();
     explicit FastName(const char* name);
     explicit FastName(const String& name);
+    // `hash` should be equal to FastNameDB::HashName(name, length)
+    FastName(const char* name, size_t length, uint32 hash);
 
     bool operator<(const FastName& _name) const;
     bool operator==(const FastName& _name) const;
@@ -77,6 +87,7 @@ public:
     size_t find(const FastName& fn, size_t pos = 0) const;
 
     bool IsValid() const;
+    uint32 GetHash() const;
 
 private:
     void Init(const char* name);
@@ -95,6 +106,12 @@ inline FastName::FastName(const char* name)
     Init(name);
 }
 
+inline FastName::FastName(const char* name, size_t length, uint32 hash)
+    : str(FastNameDB::GetLocalDB()->Intern(name, length, hash))
+{
+    DVASSERT(hash == FastNameDB::HashName(name, length));
+}
+
 inline bool FastName::operator==(const FastName& _name) const
 {
     return str == _name.str;
@@ -147,6 +164,16 @@ inline const char* FastName::c_str() const
     return str;
 }
 
+inline uint32 FastName::GetHash() const
+{
+    return (str != nullptr) ? FastNameDB::GetEntry(str)->hash : 0;
+}
+
+inline const FastNameDB::Entry* FastNameDB::GetEntry(const CharT* name)
+{
+    return reinterpret_cast<const Entry*>(name) - 1;
+}
+
 template <>
 bool AnyCompare<FastName>::IsEqual(const Any& v1, const Any& v2);
 extern template struct AnyCompare<FastName>;
@@ -157,11 +184,20 @@ namespace std
 template <>
 struct hash<DAVA::FastName>
 {
+    // Stored FNV-1a hash is used instead of string pointer, whose low bits are mostly equal because of allocation alignment
     size_t operator()(const DAVA::FastName& k) const
     {
-        return reinterpret_cast<size_t>(k.c_str());
+        return k.GetHash();
     }
 };
 }
 
+// FastName from string literal with hash evaluated at compile time.
+// HashName is not constexpr before msvc 2015 (see DAVA_CONSTEXPR), there literal is hashed on each evaluation.
+#if defined(__DAVAENGINE_WINDOWS__) && _MSC_VER < 1900
+#define DV_FASTNAME(str) DAVA::FastName(str, sizeof(str) - 1, DAVA::FastNameDB::HashName(str, sizeof(str) - 1))
+#else
+#define DV_FASTNAME(str) DAVA::FastName(str, sizeof(str) - 1, std::integral_constant<DAVA::uint32, DAVA::FastNameDB::HashName(str, sizeof(str) - 1)>::value)
+#endif
+
 #endif // __DAVAENGINE_FAST_NAME__
@@ -54,6 +54,31 @@ Thread* Thread::Current()
     return nullptr;
 }
 
+bool Thread::AtCurrentThreadExit(const Procedure& handler)
+{
+    const Id currentId = GetCurrentId();
+
+    Thread* current = nullptr;
+    {
+        auto threadListAccessor = GetThreadList().GetAccessor();
+        for (Thread* t : *threadListAccessor)
+        {
+            if (t->GetId() == currentId)
+            {
+                current = t;
+                break;
+            }
+        }
+    }
+
+    if (current != nullptr)
+    {
+        current->exitHandlers.push_back(handler);
+        return true;
+    }
+    return false;
+}
+
 Thread* Thread::Create(const Message& msg)
 {
     return new Thread(msg);
@@ -143,6 +168,17 @@ void Thread::ThreadFunction(void* param)
 
     t->threadFunc();
 
+    // Handlers can allocate and free memory which in turn can register new handlers, so run them until none is left
+    while (!t->exitHandlers.empty())
+    {
+        Vector<Procedure> handlers;
+        handlers.swap(t->exitHandlers);
+        for (const Procedure& handler : handlers)
+        {
+            handler();
+        }
+    }
+
     // Zero id to mark thread as finished in thread list obtained through GetThreadList() function.
     // This prevents from retrieving invalid Thread instance through Thread::Current()
     // as system can reuse thread ids.
@@ -164,6 +164,12 @@ public:
     /** Bind current thread to specified processor. Thread cannot be run on other processors. */
     bool BindToProcessor(unsigned proc_n);
 
+    /**
+        Register `handler` to be called in the current thread after its thread function has returned.
+        Handlers can be registered only from threads created by DAVA::Thread, for other threads function returns false.
+    */
+    static bool AtCurrentThreadExit(const Procedure& handler);
+
 private:
     Thread();
     Thread(const Message& msg);
@@ -180,6 +186,7 @@ private:
     static void ThreadFunction(void* param);
 
     Procedure threadFunc;
+    Vector<Procedure> exitHandlers; // Accessed only by thread itself
     Atomic<eThreadState> state;
     Atomic<bool> isCancelling;
     Atomic<bool> isJoinable{ false };
@@ -1,16 +1,33 @@
 #include "Debug/ProfilerCPU.h"
 #include "Time/SystemTimer.h"
 #include "Concurrency/Thread.h"
+#include "Concurrency/ThreadLocalPtr.h"
 #include "Concurrency/LockGuard.h"
 #include "Base/AllocatorFactory.h"
 #include "Debug/DVAssert.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
 #include "ProfilerRingArray.h"
 #include <ostream>
+#include <sstream>
 
 //==============================================================================
 
 namespace DAVA
 {
+namespace ProfilerCPUDetails
+{
+//Every thread caches own counters array of every profiler it used.
+//Profilers are identified by unique ID instead of pointer, so entries of destroyed profilers are never matched again
+struct ThreadCountersCache
+{
+    Vector<std::pair<uint32, ProfilerCPU::ThreadCounters*>> items;
+};
+
+ThreadLocalPtr<ThreadCountersCache> threadCountersCache;
+std::atomic<uint32> nextProfilerID = { 0 };
+}
 
 #if PROFILER_CPU_ENABLED
 static ProfilerCPU GLOBAL_TIME_PROFILER;
@@ -31,6 +48,34 @@ struct ProfilerCPU::Counter
     uint32 frame = 0;
 };
 
+struct ProfilerCPU::ThreadCounters
+{
+    ThreadCounters(uint32 numCounters, uint64 _threadID)
+        : counters(numCounters)
+        , threadID(_threadID)
+    {
+    }
+
+    //Owner thread makes `sequence` odd while it writes counters, so other threads can detect torn reads and retry
+    void BeginWrite()
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+    void EndWrite()
+    {
+        sequence.store(sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    CounterArray counters; //written only by owner thread
+    std::atomic<uint32> sequence = { 0 };
+    uint64 threadID = 0;
+
+    //Used only by streaming thread
+    uint32 streamedIndex = 0;
+    Vector<uint32> pendingIndices;
+};
+
 namespace ProfilerCPUDetails
 {
 struct CounterTreeNode
@@ -60,6 +105,13 @@ protected:
     uint32 count; //recursive and duplicate counters
 };
 
+enum class CounterState
+{
+    COMPLETED,
+    PENDING,
+    LOST
+};
+
 bool NameEquals(const char* name1, const char* name2)
 {
 #ifdef __DAVAENGINE_DEBUG__
@@ -68,6 +120,119 @@ bool NameEquals(const char* name1, const char* name2)
     return name1 == name2;
 #endif
 }
+
+uint64 NsToUs(uint64 ns)
+{
+    return ns / 1000;
+}
+
+TraceEvent CreateTraceEvent(const ProfilerCPU::Counter& c)
+{
+    TraceEvent event = { FastName(c.name), NsToUs(c.startTime), NsToUs(c.endTime - c.startTime), c.threadID, 0, TraceEvent::PHASE_DURATION };
+    if (c.frame)
+    {
+        event.args.push_back({ ProfilerCPU::TRACE_ARG_FRAME, c.frame });
+    }
+    return event;
+}
+
+//Copy counter with `index` from array which may be written by owner thread at this moment.
+//Copy is repeated until it's made while owner wasn't writing, counter is valid only if its slot wasn't reused
+CounterState ReadCounter(const ProfilerCPU::ThreadCounters& t, uint32 index, ProfilerCPU::Counter& counter)
+{
+    uint32 sequence = t.sequence.load(std::memory_order_acquire);
+    for (;;)
+    {
+        if ((sequence & 1) == 0)
+        {
+            counter = t.counters.at(index);
+            std::atomic_thread_fence(std::memory_order_acquire);
+
+            uint32 sequenceAfterCopy = t.sequence.load(std::memory_order_relaxed);
+            if (sequenceAfterCopy == sequence)
+            {
+                break;
+            }
+            sequence = sequenceAfterCopy;
+        }
+        else
+        {
+            Thread::Yield();
+            sequence = t.sequence.load(std::memory_order_acquire);
+        }
+    }
+
+    if (t.counters.head_index() - index >= uint32(t.counters.size()))
+    {
+        return CounterState::LOST;
+    }
+
+    return (counter.endTime == 0) ? CounterState::PENDING : CounterState::COMPLETED;
+}
+
+//Copy all available counters of thread in order they were started, slot of last counter may be reused at this moment
+void ReadThreadCounters(const ProfilerCPU::ThreadCounters& t, Vector<ProfilerCPU::Counter>& result)
+{
+    uint32 head = t.counters.head_index();
+    uint32 available = Min(head, uint32(t.counters.size()) - 1);
+
+    ProfilerCPU::Counter c;
+    for (uint32 index = head - available; index != head; ++index)
+    {
+        if (ReadCounter(t, index, c) != CounterState::LOST && c.name != nullptr)
+        {
+            result.push_back(c);
+        }
+    }
+}
+
+bool FindLastCounter(const ProfilerCPU::CounterArray* array, const char* counterName, uint32 desiredFrameIndex, ProfilerCPU::CounterArray::const_reverse_iterator& result, std::size_t& countersCount)
+{
+    countersCount = 0;
+    ProfilerCPU::CounterArray::const_reverse_iterator rit = array->rbegin();
+    ProfilerCPU::CounterArray::const_reverse_iterator rend = array->rend();
+    for (; rit != rend; ++rit)
+    {
+        ++countersCount;
+        if (rit->endTime != 0 && (strcmp(counterName, rit->name) == 0))
+        {
+            if ((rit->frame <= desiredFrameIndex || rit->frame == 0 || desiredFrameIndex == 0))
+            {
+                result = rit;
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+Vector<TraceEvent> BuildCounterTrace(const ProfilerCPU::CounterArray* array, ProfilerCPU::CounterArray::const_reverse_iterator rit, std::size_t countersCount)
+{
+    Vector<TraceEvent> trace;
+
+    ProfilerCPU::CounterArray::const_iterator it(rit);
+    ProfilerCPU::CounterArray::const_iterator end = array->end();
+
+    trace.reserve(countersCount);
+
+    uint64 threadID = it->threadID;
+    uint64 counterEndTime = it->endTime;
+    for (; it != end; ++it)
+    {
+        if (it->threadID == threadID)
+        {
+            if (it->endTime == 0 || it->startTime > counterEndTime)
+            {
+                break;
+            }
+
+            trace.push_back(CreateTraceEvent(*it));
+        }
+    }
+
+    return trace;
+}
 }
 
 const FastName ProfilerCPU::TRACE_ARG_FRAME("Frame Number");
@@ -77,65 +242,123 @@ const FastName ProfilerCPU::TRACE_ARG_FRAME("Frame Number");
 ProfilerCPU::ScopedCounter::ScopedCounter(const char* counterName, ProfilerCPU* _profiler, uint32 frame)
 {
     profiler = _profiler;
-    if (profiler->isStarted)
+    if (profiler->isStarted.Get())
     {
-        Counter& c = profiler->counters->next();
+        threadCounters = profiler->GetThreadCounters();
+        threadCounters->BeginWrite();
+
+        Counter& c = threadCounters->counters.reserve();
 
         endTime = &c.endTime;
-        c.startTime = SystemTimer::GetUs();
+        c.startTime = SystemTimer::GetNs();
         c.endTime = 0;
         c.name = counterName;
-        c.threadID = Thread::GetCurrentIdAsUInt64();
+        c.threadID = threadCounters->threadID;
         c.frame = frame;
+
+        threadCounters->counters.commit();
+        threadCounters->EndWrite();
     }
 }
 
 ProfilerCPU::ScopedCounter::~ScopedCounter()
 {
-    // We don't write end time if profiler stopped cause
-    // in this moment other thread may dump counters.
-    // Potentially due to 'pseudo-thread-safe' (see ProfilerRingArray.h)
-    // we can get invalid counter (only one, therefore there is 'if(started)' ).
-    // We know it. But it performance reason.
-    if (profiler->isStarted && endTime != nullptr)
+    // End time is written even if profiler is stopped meanwhile, readers detect concurrent write and retry
+    if (endTime != nullptr)
     {
-        *endTime = SystemTimer::GetUs();
+        threadCounters->BeginWrite();
+        *endTime = SystemTimer::GetNs();
+        threadCounters->EndWrite();
     }
 }
 
 ProfilerCPU::ProfilerCPU(uint32 numCounters_)
     : numCounters(numCounters_)
+    , profilerID(ProfilerCPUDetails::nextProfilerID++)
 {
 }
 
 ProfilerCPU::~ProfilerCPU()
 {
+    StopTraceStreaming();
     DeleteSnapshots();
     SafeDelete(counters);
+
+    for (ThreadCounters*& c : threadCounters)
+    {
+        SafeDelete(c);
+    }
 }
 
 void ProfilerCPU::Start()
 {
     LockGuard<Mutex> lock(mutex);
-    if (isStarted == false)
-    {
-        if (counters == nullptr)
-        {
-            counters = new CounterArray(numCounters);
-        }
-        isStarted = true;
-    }
+    isStarted = true;
 }
 
 void ProfilerCPU::Stop()
 {
     LockGuard<Mutex> lock(mutex);
     isStarted = false;
+    MergeThreadCounters();
 }
 
 bool ProfilerCPU::IsStarted() const
 {
-    return isStarted;
+    return isStarted.Get();
+}
+
+ProfilerCPU::ThreadCounters* ProfilerCPU::GetThreadCounters()
+{
+    using namespace ProfilerCPUDetails;
+
+    ThreadCountersCache* cache = threadCountersCache.Get();
+    if (cache == nullptr)
+    {
+        cache = new ThreadCountersCache();
+        threadCountersCache.Reset(cache);
+
+        //Counters arrays are owned by profilers and outlive thread to keep its history
+        Thread::AtCurrentThreadExit([]() { threadCountersCache.Reset(); });
+    }
+
+    for (const std::pair<uint32, ThreadCounters*>& item : cache->items)
+    {
+        if (item.first == profilerID)
+        {
+            return item.second;
+        }
+    }
+
+    ThreadCounters* result = new ThreadCounters(numCounters, Thread::GetCurrentIdAsUInt64());
+    {
+        LockGuard<Mutex> lock(mutex);
+        threadCounters.push_back(result);
+    }
+    cache->items.emplace_back(profilerID, result);
+
+    return result;
+}
+
+void ProfilerCPU::MergeThreadCounters()
+{
+    //Counters started before stop can still be written by their threads
+    Vector<Counter> merged;
+    for (const ThreadCounters* t : threadCounters)
+    {
+        ProfilerCPUDetails::ReadThreadCounters(*t, merged);
+    }
+
+    std::stable_sort(merged.begin(), merged.end(), [](const Counter& l, const Counter& r) {
+        return l.startTime < r.startTime;
+    });
+
+    SafeDelete(counters);
+    counters = new CounterArray(uint32(NextPowerOf2(int32(Max(uint32(merged.size()), numCounters)))));
+    for (const Counter& c : merged)
+    {
+        counters->next() = c;
+    }
 }
 
 int32 ProfilerCPU::MakeSnapshot()
@@ -143,9 +366,10 @@ int32 ProfilerCPU::MakeSnapshot()
     //CPU profiler use 'pseudo-thread-safe' ring array (see ProfilerRingArray.h)
     //So we can't read array when other thread may write
     //For performance reasons we should stop profiler before dumping or snapshotting
-    DVASSERT(!isStarted && "Stop profiler before make snapshot");
+    DVASSERT(!isStarted.Get() && "Stop profiler before make snapshot");
 
-    snapshots.push_back(new CounterArray(*counters));
+    //Profiler which was never stopped has no merged counters
+    snapshots.push_back((counters != nullptr) ? new CounterArray(*counters) : new CounterArray(numCounters));
     return int32(snapshots.size() - 1);
 }
 
@@ -170,28 +394,46 @@ void ProfilerCPU::DeleteSnapshots()
 
 uint64 ProfilerCPU::GetLastCounterTime(const char* counterName) const
 {
+    LockGuard<Mutex> lock(mutex);
+
+    uint64 lastEndTime = 0;
     uint64 timeDelta = 0;
-    CounterArray::reverse_iterator it = counters->rbegin(), itEnd = counters->rend();
-    for (; it != itEnd; ++it)
+    Vector<Counter> copied;
+    for (const ThreadCounters* t : threadCounters)
     {
-        const Counter& c = *it;
-        if (c.endTime != 0 && (strcmp(counterName, c.name) == 0))
+        copied.clear();
+        ProfilerCPUDetails::ReadThreadCounters(*t, copied);
+
+        Vector<Counter>::const_reverse_iterator it = copied.rbegin(), itEnd = copied.rend();
+        for (; it != itEnd; ++it)
         {
-            timeDelta = c.endTime - c.startTime;
-            break;
+            const Counter& c = *it;
+            if (c.endTime != 0 && (strcmp(counterName, c.name) == 0))
+            {
+                if (c.endTime > lastEndTime)
+                {
+                    lastEndTime = c.endTime;
+                    timeDelta = c.endTime - c.startTime;
+                }
+                break;
+            }
         }
     }
 
-    return timeDelta;
+    return ProfilerCPUDetails::NsToUs(timeDelta);
 }
-
 void ProfilerCPU::DumpLast(const char* counterName, uint32 counterCount, std::ostream& stream, int32 snapshot) const
 {
-    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted) && "Stop profiler before dumping");
+    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted.Get()) && "Stop profiler before dumping");
+
+    const CounterArray* array = GetCounterArray(snapshot);
+    if (array == nullptr)
+    {
+        return;
+    }
 
     stream << "================================================================\n";
 
-    const CounterArray* array = GetCounterArray(snapshot);
     CounterArray::const_reverse_iterator it = array->rbegin(), itEnd = array->rend();
     const Counter* lastDumpedCounter = nullptr;
     for (; it != itEnd; ++it)
@@ -200,7 +442,7 @@ void ProfilerCPU::DumpLast(const char* counterName, uint32 counterCount, std::os
         {
             if (lastDumpedCounter)
             {
-                stream << "=== Non-tracked time [" << (lastDumpedCounter->startTime - it->endTime) << " us] ===\n";
+                stream << "=== Non-tracked time [" << ProfilerCPUDetails::NsToUs(lastDumpedCounter->startTime - it->endTime) << " us] ===\n";
             }
             lastDumpedCounter = &(*it);
 
@@ -222,12 +464,17 @@ void ProfilerCPU::DumpLast(const char* counterName, uint32 counterCount, std::os
 void ProfilerCPU::DumpAverage(const char* counterName, uint32 counterCount, std::ostream& stream, int32 snapshot) const
 {
     using namespace ProfilerCPUDetails;
-    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted) && "Stop profiler before dumping");
+    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted.Get()) && "Stop profiler before dumping");
+
+    const CounterArray* array = GetCounterArray(snapshot);
+    if (array == nullptr)
+    {
+        return;
+    }
 
     stream << "================================================================\n";
     stream << "=== Average time for " << counterCount << " counter(s):\n";
 
-    const CounterArray* array = GetCounterArray(snapshot);
     CounterArray::const_reverse_iterator it = array->rbegin();
     CounterArray::const_reverse_iterator itEnd = array->rend();
     CounterTreeNode* treeRoot = nullptr;
@@ -266,7 +513,7 @@ void ProfilerCPU::DumpAverage(const char* counterName, uint32 counterCount, std:
 
 Vector<TraceEvent> ProfilerCPU::GetTrace(int32 snapshot) const
 {
-    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted) && "Stop profiler before tracing");
+    DVASSERT((snapshot != NO_SNAPSHOT_ID || !isStarted.Get()) && "Stop profiler before tracing");
 
     const CounterArray* array = GetCounterArray(snapshot);
     Vector<TraceEvent> trace;
@@ -283,12 +530,7 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(int32 snapshot) const
             continue;
         }
 
-        trace.push_back({ FastName(c.name), c.startTime, (c.endTime - c.startTime), c.threadID, 0, TraceEvent::PHASE_DURATION });
-
-        if (c.frame)
-        {
-            trace.back().args.push_back({ TRACE_ARG_FRAME, c.frame });
-        }
+        trace.push_back(ProfilerCPUDetails::CreateTraceEvent(c));
     }
 
     return trace;
@@ -296,55 +538,56 @@ Vector<TraceEvent> ProfilerCPU::GetTrace(int32 snapshot) const
 
 Vector<TraceEvent> ProfilerCPU::GetTrace(const char* counterName, uint32 desiredFrameIndex, int32 snapshot) const
 {
-    Vector<TraceEvent> trace;
+    using namespace ProfilerCPUDetails;
 
-    bool found = false;
     std::size_t countersCount = 0;
-    const CounterArray* array = GetCounterArray(snapshot);
-    CounterArray::const_reverse_iterator rit = array->rbegin();
-    CounterArray::const_reverse_iterator rend = array->rend();
-    for (; rit != rend; ++rit)
+    CounterArray::const_reverse_iterator rit;
+
+    if (snapshot != NO_SNAPSHOT_ID)
     {
-        ++countersCount;
-        if (rit->endTime != 0 && (strcmp(counterName, rit->name) == 0))
+        const CounterArray* array = GetCounterArray(snapshot);
+        if (FindLastCounter(array, counterName, desiredFrameIndex, rit, countersCount))
         {
-            if ((rit->frame <= desiredFrameIndex || rit->frame == 0 || desiredFrameIndex == 0))
-            {
-                found = true;
-                break;
-            }
+            return BuildCounterTrace(array, rit, countersCount);
         }
+        return Vector<TraceEvent>();
     }
 
-    if (found)
+    //Counters of every thread are stored in own array, so trace is built from array of thread where counter was started last
+    LockGuard<Mutex> lock(mutex);
+
+    //Arrays are copied as they are written by their threads
+    std::unique_ptr<CounterArray> lastArray;
+    CounterArray::const_reverse_iterator lastRit;
+    std::size_t lastCountersCount = 0;
+    Vector<Counter> copied;
+    for (const ThreadCounters* t : threadCounters)
     {
-        CounterArray::const_iterator it(rit);
-        CounterArray::const_iterator end = array->end();
+        copied.clear();
+        ReadThreadCounters(*t, copied);
 
-        trace.reserve(countersCount);
+        std::unique_ptr<CounterArray> array(new CounterArray(numCounters));
+        for (const Counter& c : copied)
+        {
+            array->next() = c;
+        }
 
-        uint64 threadID = it->threadID;
-        uint64 counterEndTime = it->endTime;
-        for (; it != end; ++it)
+        if (FindLastCounter(array.get(), counterName, desiredFrameIndex, rit, countersCount))
         {
-            if (it->threadID == threadID)
+            if (lastArray == nullptr || rit->startTime > lastRit->startTime)
             {
-                if (it->endTime == 0 || it->startTime > counterEndTime)
-                {
-                    break;
-                }
-
-                trace.push_back({ FastName(it->name), it->startTime, it->endTime - it->startTime, it->threadID, 0, TraceEvent::PHASE_DURATION });
-
-                if (it->frame)
-                {
-                    trace.back().args.push_back({ TRACE_ARG_FRAME, it->frame });
-                }
+                lastArray = std::move(array);
+                lastRit = rit;
+                lastCountersCount = countersCount;
             }
         }
     }
 
-    return trace;
+    if (lastArray != nullptr)
+    {
+        return BuildCounterTrace(lastArray.get(), lastRit, lastCountersCount);
+    }
+    return Vector<TraceEvent>();
 }
 
 const ProfilerCPU::CounterArray* ProfilerCPU::GetCounterArray(int32 snapshot) const
@@ -358,6 +601,141 @@ const ProfilerCPU::CounterArray* ProfilerCPU::GetCounterArray(int32 snapshot) co
     return counters;
 }
 
+void ProfilerCPU::StartTraceStreaming(const FilePath& filePath, uint32 intervalMs)
+{
+    LockGuard<Mutex> streamingLock(streamingMutex);
+    if (streamingThread != nullptr)
+    {
+        return;
+    }
+
+    FileSystem::Instance()->CreateDirectory(filePath.GetDirectory(), true);
+    streamingFile = File::Create(filePath, File::CREATE | File::WRITE);
+    if (streamingFile == nullptr)
+    {
+        Logger::Error("[ProfilerCPU] Can't open %s for trace streaming", filePath.GetAbsolutePathname().c_str());
+        return;
+    }
+
+    //JSON array format allows to omit closing bracket, so trace stays valid at any moment
+    streamingFile->WriteNonTerminatedString("[\n");
+    streamingHasEvents = false;
+    streamingInterval = intervalMs;
+    lostCounters = 0;
+
+    {
+        LockGuard<Mutex> lock(mutex);
+        for (ThreadCounters* t : threadCounters)
+        {
+            t->streamedIndex = t->counters.head_index();
+            t->pendingIndices.clear();
+        }
+    }
+
+    streamingThread = Thread::Create(MakeFunction(this, &ProfilerCPU::TraceStreamingThread));
+    streamingThread->SetName("ProfilerCPUStreamingThread");
+    streamingThread->Start();
+}
+
+void ProfilerCPU::StopTraceStreaming()
+{
+    LockGuard<Mutex> streamingLock(streamingMutex);
+    if (streamingThread == nullptr)
+    {
+        return;
+    }
+
+    streamingThread->Cancel();
+    streamingThread->Join();
+    SafeRelease(streamingThread);
+
+    StreamCompletedCounters();
+    streamingFile->WriteNonTerminatedString("\n]\n");
+    SafeRelease(streamingFile);
+
+    if (lostCounters != 0)
+    {
+        Logger::Warning("[ProfilerCPU] %llu counters were overwritten before streaming, increase counters count or decrease streaming interval", lostCounters);
+    }
+}
+
+bool ProfilerCPU::IsTraceStreaming() const
+{
+    LockGuard<Mutex> streamingLock(streamingMutex);
+    return streamingThread != nullptr;
+}
+
+void ProfilerCPU::TraceStreamingThread()
+{
+    while (!streamingThread->IsCancelling())
+    {
+        StreamCompletedCounters();
+        Thread::Sleep(streamingInterval);
+    }
+}
+
+void ProfilerCPU::StreamCompletedCounters()
+{
+    using namespace ProfilerCPUDetails;
+
+    Vector<ThreadCounters*> threads;
+    {
+        LockGuard<Mutex> lock(mutex);
+        threads = threadCounters;
+    }
+
+    std::stringstream stream;
+    auto streamCounter = [this, &stream](ThreadCounters* t, uint32 index) {
+        Counter c;
+        CounterState state = ReadCounter(*t, index, c);
+        if (state == CounterState::COMPLETED)
+        {
+            stream << (streamingHasEvents ? ",\n" : "");
+            TraceEvent::DumpJSONEvent(CreateTraceEvent(c), stream);
+            streamingHasEvents = true;
+        }
+        else if (state == CounterState::PENDING)
+        {
+            //Parent counters are completed after nested ones, so they are checked again on next pass
+            t->pendingIndices.push_back(index);
+        }
+        else
+        {
+            ++lostCounters;
+        }
+    };
+
+    for (ThreadCounters* t : threads)
+    {
+        uint32 head = t->counters.head_index();
+        uint32 available = uint32(t->counters.size()) - 1;
+        if (head - t->streamedIndex > available)
+        {
+            lostCounters += head - t->streamedIndex - available;
+            t->streamedIndex = head - available;
+        }
+
+        Vector<uint32> pendingIndices;
+        pendingIndices.swap(t->pendingIndices);
+        for (uint32 index : pendingIndices)
+        {
+            streamCounter(t, index);
+        }
+
+        for (; t->streamedIndex != head; ++t->streamedIndex)
+        {
+            streamCounter(t, t->streamedIndex);
+        }
+    }
+
+    String data = stream.str();
+    if (!data.empty())
+    {
+        streamingFile->WriteNonTerminatedString(data);
+        streamingFile->Flush();
+    }
+}
+
 /////////////////////////////////////////////////////////////////////////////////
 //Internal Definition
 namespace ProfilerCPUDetails
@@ -482,7 +860,8 @@ void CounterTreeNode::DumpTree(const CounterTreeNode* node, std::ostream& stream
         stream << "  ";
     }
 
-    stream << node->counterName << " [" << (average ? node->counterTime / node->count : node->counterTime) << " us | x" << node->count << "]" << '\n';
+    uint64 counterTime = NsToUs(average ? node->counterTime / node->count : node->counterTime);
+    stream << node->counterName << " [" << counterTime << " us | x" << node->count << "]" << '\n';
 
     for (CounterTreeNode* child : node->childs)
     {
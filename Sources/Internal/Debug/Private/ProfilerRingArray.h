@@ -56,6 +56,16 @@ public:
     {
         return elements[head++ & mask];
     }
+    //Alternative of `next()` for array with single writer thread. It doesn't use atomic increment,
+    //element obtained by `reserve()` becomes visible for readers only after `commit()`
+    T& reserve()
+    {
+        return elements[head.load(std::memory_order_relaxed) & mask];
+    }
+    void commit()
+    {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
     iterator begin()
     {
         return iterator(elements, (head & mask), mask);
@@ -92,6 +102,16 @@ public:
     {
         return elementsCount;
     }
+    //Count of elements obtained by `next()` or `reserve()` during array lifetime.
+    //Element with index `i` stays valid in `at(i)` while `head_index() - i` is less than `size()`
+    uint32 head_index() const
+    {
+        return head.load(std::memory_order_acquire);
+    }
+    const T& at(uint32 index) const
+    {
+        return elements[index & mask];
+    }
 
 private:
     template <typename U>
@@ -292,6 +312,7 @@ public:
     class const_reverse_iterator final : public base_iterator<const T>
     {
     public:
+        const_reverse_iterator() = default;
         const_reverse_iterator(const T* data, uint32 _index, uint32 _mask)
             : base_iterator<const T>(data, _index, _mask)
         {
@@ -2,7 +2,9 @@
 
 #include "Base/BaseTypes.h"
 #include "Debug/TraceEvent.h"
+#include "Concurrency/Atomic.h"
 #include "Concurrency/Mutex.h"
+#include "FileSystem/FilePath.h"
 #include <iosfwd>
 
 #ifndef PROFILER_CPU_ENABLED
@@ -13,6 +15,8 @@ namespace DAVA
 {
 template <class T>
 class ProfilerRingArray;
+class File;
+class Thread;
 
 /**
     \ingroup profilers
@@ -20,9 +24,12 @@ class ProfilerRingArray;
              To use this profiler, at first, you have to place counters in interesting code blocks using set of DAVA_PROFILER_CPU_SCOPE defines listed below.
              Than you just start profiler. After that you can dump counted info or build trace to view it in Chromium Trace Viewer.
 
-             Any counter has string-name that must be passed to define and will be displayed in dump or trace. Time-measuring occurs in microseconds.
+             Any counter has string-name that must be passed to define and will be displayed in dump or trace. Time-measuring occurs in nanoseconds,
+             dumps and traces are reported in microseconds.
 
-             Profiler is using ring array for counters so you are limited by count passed to ctor. If it's necessary to store counters data for later usage you can use snapshots.
+             Profiler is using ring array per thread for counters so you are limited by count passed to ctor for every thread. Threads don't share
+             counters memory, so counters of busy worker threads don't overwrite history of other threads.
+             Counters of all threads are merged by start time when profiler is stopped. If it's necessary to store counters data for later usage you can use snapshots.
              Snapshot - it just a copy of internal ring buffer. To make snapshot you have to stop profiler because it can be used by other thread.
              After snapshot was made you can dump counted info or build JSON-trace from it. Remember, that dumping or building trace is more expensive in performance than making snapshot.
 
@@ -61,6 +68,15 @@ class ProfilerRingArray;
 			       TraceEvent::DumpJSON(events, file);
 			   }
 			   \endcode
+
+             To capture whole session instead of last counters use trace streaming. Background thread periodically collects completed counters
+             of all threads and appends them to file in Chromium Trace Viewer format:
+               \code
+               profiler.Start();
+               profiler.StartTraceStreaming("~doc:/session.json");
+               ...
+               profiler.StopTraceStreaming();
+               \endcode
 */
 class ProfilerCPU
 {
@@ -68,6 +84,7 @@ public:
     static const FastName TRACE_ARG_FRAME; ///< Name of frame index argument of generated TraceEvent
 
     struct Counter;
+    struct ThreadCounters;
     using CounterArray = ProfilerRingArray<Counter>;
 
     /**
@@ -82,12 +99,17 @@ public:
 
     private:
         uint64* endTime = nullptr;
+        ThreadCounters* threadCounters = nullptr;
         ProfilerCPU* profiler;
     };
 
+    static const uint32 DEFAULT_STREAMING_INTERVAL_MS = 100; ///< Default period of trace streaming
     static const int32 NO_SNAPSHOT_ID = -1; ///< Value used to dump or build trace from current counters array
     static ProfilerCPU* const globalProfiler; ///< Global Engine Profiler
 
+    /**
+        Create profiler with ring arrays of `numCounters` counters per thread. `numCounters` should be power of two
+    */
     ProfilerCPU(uint32 numCounters = 2048);
     ~ProfilerCPU();
 
@@ -107,7 +129,7 @@ public:
     bool IsStarted() const;
 
     /**
-        Looking by name last complete counter with `counterName` and return it duration in microseconds
+        Looking by name last complete counter with `counterName` in all threads and return it duration in microseconds
     */
     uint64 GetLastCounterTime(const char* counterName) const;
 
@@ -156,14 +178,46 @@ public:
     */
     Vector<TraceEvent> GetTrace(const char* counterName, uint32 desiredFrameIndex = 0, int32 snapshotID = NO_SNAPSHOT_ID) const;
 
+    /**
+        Start streaming of counters completed since this call to file with `filePath`. Counters are collected from all threads
+        every `intervalMs` milliseconds, so per-thread ring arrays should be large enough to keep counters of this period.
+        Trace is written in JSON array format of Chromium Trace Viewer which may be not terminated, so file can be opened
+        even if application was not finished properly. Path to named pipe can be passed to read trace by other process
+    */
+    void StartTraceStreaming(const FilePath& filePath, uint32 intervalMs = DEFAULT_STREAMING_INTERVAL_MS);
+
+    /**
+        Write remaining completed counters, terminate trace and stop streaming thread
+    */
+    void StopTraceStreaming();
+
+    /**
+        Returns is trace streaming started
+    */
+    bool IsTraceStreaming() const;
+
 private:
+    ThreadCounters* GetThreadCounters();
+    void MergeThreadCounters();
     const CounterArray* GetCounterArray(int32 snapshot) const;
 
-    CounterArray* counters = nullptr;
+    void TraceStreamingThread();
+    void StreamCompletedCounters();
+
+    CounterArray* counters = nullptr; //merged counters of all threads, it's built when profiler stops
     Vector<CounterArray*> snapshots;
-    Mutex mutex;
+    Vector<ThreadCounters*> threadCounters;
+    mutable Mutex mutex;
     uint32 numCounters = 2048;
-    bool isStarted = false;
+    uint32 profilerID = 0;
+    Atomic<bool> isStarted{ false };
+
+    mutable Mutex streamingMutex; //serializes start and stop of trace streaming, streaming thread doesn't take it
+    Thread* streamingThread = nullptr;
+    File* streamingFile = nullptr;
+    uint32 streamingInterval = DEFAULT_STREAMING_INTERVAL_MS;
+    bool streamingHasEvents = false;
+    uint64 lostCounters = 0;
 
     friend class ScopedCounter;
 };
@@ -43,6 +43,11 @@ struct TraceEvent
     */
     template <class Container>
     static void DumpJSON(const Container& trace, std::ostream& stream);
+
+    /**
+        Dump single `event` to `stream` as JSON-object without separators. Used to stream events to trace which is written by parts
+    */
+    static void DumpJSONEvent(const TraceEvent& event, std::ostream& stream);
 };
 
 template <class Container>
@@ -65,44 +70,47 @@ void TraceEvent::DumpJSON(const Container& trace, std::ostream& stream)
 {
     static_assert(std::is_same<typename Container::value_type, TraceEvent>::value, "Container should contain TraceEvent class");
 
-    static const char* const PHASE_STR[PHASE_COUNT] = {
-        "B", "E", "I", "X"
-    };
-
     stream << "{ \"traceEvents\": [\n";
 
     auto begin = trace.begin(), end = trace.end();
     for (auto it = begin; it != end; ++it)
     {
-        const TraceEvent& event = (*it);
-
         if (it != begin)
             stream << ",\n";
 
-        stream << "{ ";
-        stream << "\"pid\": " << event.processID << ", ";
-        stream << "\"tid\": " << event.threadID << ", ";
-        stream << "\"ts\": " << event.timestamp << ", ";
+        DumpJSONEvent(*it, stream);
+    }
 
-        if (event.phase == PHASE_DURATION)
-        {
-            stream << "\"dur\": " << event.duration << ", ";
-        }
+    stream << "\n] }\n";
 
-        stream << "\"ph\": \"" << PHASE_STR[event.phase] << "\", ";
-        stream << "\"name\": \"" << event.name.c_str() << "\"";
+    stream.flush();
+}
 
-        for (const std::pair<FastName, uint32>& arg : event.args)
-        {
-            stream << ", \"args\": { \"" << arg.first.c_str() << "\": " << arg.second << " }";
-        }
+inline void TraceEvent::DumpJSONEvent(const TraceEvent& event, std::ostream& stream)
+{
+    static const char* const PHASE_STR[PHASE_COUNT] = {
+        "B", "E", "I", "X"
+    };
+
+    stream << "{ ";
+    stream << "\"pid\": " << event.processID << ", ";
+    stream << "\"tid\": " << event.threadID << ", ";
+    stream << "\"ts\": " << event.timestamp << ", ";
 
-        stream << " }";
+    if (event.phase == PHASE_DURATION)
+    {
+        stream << "\"dur\": " << event.duration << ", ";
     }
 
-    stream << "\n] }\n";
+    stream << "\"ph\": \"" << PHASE_STR[event.phase] << "\", ";
+    stream << "\"name\": \"" << event.name.c_str() << "\"";
 
-    stream.flush();
+    for (const std::pair<FastName, uint32>& arg : event.args)
+    {
+        stream << ", \"args\": { \"" << arg.first.c_str() << "\": " << arg.second << " }";
+    }
+
+    stream << " }";
 }
 
 }; //ns DAVA
\ No newline at end of file
@@ -256,6 +256,14 @@ public:
         | shader_const_buffer_size        |                            | 0              |
 
         For more info on render options ask RHI guys.
+
+        | **File system options**         | Description                                       | Default                  |
+        | ------------------------------- | ------------------------------------------------- | ------------------------ |
+        | resources_index                 | Index resource folders content, see FileSystem    | false                    |
+
+        | **Memory profiler options**     | Description                                                       | Default |
+        | ------------------------------- | ----------------------------------------------------------------- | ------- |
+        | memory_profiler_sample_interval | Enable sampling mode with given mean bytes between sampled blocks | 0 (off) |
     
         Other options can be found in description for corresponding module.
     */
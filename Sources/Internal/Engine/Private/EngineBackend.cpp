@@ -37,6 +37,7 @@
 #include "Input/InputBindingListener.h"
 #include "Logger/Logger.h"
 #include "MemoryManager/MemoryManager.h"
+#include "MemoryManager/MemoryProfiler.h"
 #include "ModuleManager/ModuleManager.h"
 #include "Network/NetCore.h"
 #include "Notification/LocalNotificationController.h"
@@ -228,6 +229,15 @@ void EngineBackend::Init(eEngineRunMode engineRunMode, const Vector<String>& mod
         options.Set(options_);
     }
 
+    // Sampling is enabled as early as possible as it should be done before other threads start allocating memory
+    const uint32 memoryProfilerSampleInterval = options->GetUInt32("memory_profiler_sample_interval", 0);
+    if (memoryProfilerSampleInterval > 0)
+    {
+        DAVA_MEMORY_PROFILER_ENABLE_SAMPLING(memoryProfilerSampleInterval);
+    }
+
+    context->fileSystem->SetResourcesIndexEnabled(options->GetBool("resources_index", false));
+
     // Do not initialize PlatformCore in console mode as console mode is fully
     // implemented in EngineBackend
     if (!IsConsoleMode())
@@ -116,4 +116,45 @@ void SceneSystem::SetScene(Scene* scene_)
 void SceneSystem::InputCancelled(UIEvent* event)
 {
 }
+
+SceneSystemDataAccess& SceneSystemDataAccess::ReadComponents(const ComponentMask& mask)
+{
+    readComponents |= mask;
+    declared = true;
+    return *this;
+}
+
+SceneSystemDataAccess& SceneSystemDataAccess::WriteComponents(const ComponentMask& mask)
+{
+    writeComponents |= mask;
+    declared = true;
+    return *this;
+}
+
+bool SceneSystemDataAccess::IsDeclared() const
+{
+    return declared;
+}
+
+bool SceneSystemDataAccess::ConflictsWith(const SceneSystemDataAccess& other) const
+{
+    if ((writeComponents & (other.readComponents | other.writeComponents)).any() || (other.writeComponents & readComponents).any())
+    {
+        return true;
+    }
+
+    return HasIntersection(writeSingletons, other.readSingletons) || HasIntersection(writeSingletons, other.writeSingletons) || HasIntersection(other.writeSingletons, readSingletons);
+}
+
+bool SceneSystemDataAccess::HasIntersection(const Vector<std::type_index>& first, const Vector<std::type_index>& second)
+{
+    for (const std::type_index& type : first)
+    {
+        if (std::find(second.begin(), second.end(), type) != second.end())
+        {
+            return true;
+        }
+    }
+    return false;
+}
 }
@@ -2,6 +2,8 @@
 
 #include "Base/BaseTypes.h"
 
+#include <typeindex>
+
 /**
     \defgroup systems Systems
 */
@@ -12,6 +14,41 @@ class Entity;
 class Scene;
 class Component;
 class UIEvent;
+
+/**
+    \ingroup systems
+    \brief Description of data that system reads and writes in `Process`.
+    Scene runs systems with declared data access concurrently if they don't conflict with each other.
+    Data that is not stored in components (e.g. state of other systems) should be described
+    with components this data is related to.
+*/
+class SceneSystemDataAccess
+{
+public:
+    SceneSystemDataAccess& ReadComponents(const ComponentMask& mask);
+    SceneSystemDataAccess& WriteComponents(const ComponentMask& mask);
+
+    template <class T>
+    SceneSystemDataAccess& ReadSingleton();
+    template <class T>
+    SceneSystemDataAccess& WriteSingleton();
+
+    /** Returns true if any data access was declared. Systems without declaration are processed serially. */
+    bool IsDeclared() const;
+
+    /** Returns true if one of two systems writes data that other system reads or writes. */
+    bool ConflictsWith(const SceneSystemDataAccess& other) const;
+
+private:
+    static bool HasIntersection(const Vector<std::type_index>& first, const Vector<std::type_index>& second);
+
+    ComponentMask readComponents;
+    ComponentMask writeComponents;
+    Vector<std::type_index> readSingletons;
+    Vector<std::type_index> writeSingletons;
+    bool declared = false;
+};
+
 /**
     \ingroup systems
     \brief Base class of systems.
@@ -25,6 +62,9 @@ public:
     inline void SetRequiredComponents(const ComponentMask& requiredComponents);
     inline const ComponentMask& GetRequiredComponents() const;
 
+    inline void SetDataAccess(const SceneSystemDataAccess& dataAccess);
+    inline const SceneSystemDataAccess& GetDataAccess() const;
+
     /**
         \brief  This function is called when any entity registered to scene.
                 It sorts out is entity has all necessary components and we need to call AddEntity.
@@ -133,12 +173,29 @@ protected:
 
 private:
     ComponentMask requiredComponents;
+    SceneSystemDataAccess dataAccess;
     Scene* scene = nullptr;
 
     bool locked = false;
 };
 
 // Inline
+template <class T>
+SceneSystemDataAccess& SceneSystemDataAccess::ReadSingleton()
+{
+    readSingletons.emplace_back(typeid(T));
+    declared = true;
+    return *this;
+}
+
+template <class T>
+SceneSystemDataAccess& SceneSystemDataAccess::WriteSingleton()
+{
+    writeSingletons.emplace_back(typeid(T));
+    declared = true;
+    return *this;
+}
+
 inline Scene* SceneSystem::GetScene() const
 {
     return scene;
@@ -153,4 +210,14 @@ inline const ComponentMask& SceneSystem::GetRequiredComponents() const
 {
     return requiredComponents;
 }
+
+inline void SceneSystem::SetDataAccess(const SceneSystemDataAccess& dataAccess_)
+{
+    dataAccess = dataAccess_;
+}
+
+inline const SceneSystemDataAccess& SceneSystem::GetDataAccess() const
+{
+    return dataAccess;
+}
 }
@@ -11,6 +11,7 @@
 #include "FileSystem/FileSystemDelegate.h"
 #include "FileSystem/Private/PackFormatSpec.h"
 #include "FileSystem/Private/CheckIOError.h"
+#include "FileSystem/Private/ResourcesIndex.h"
 #include "FileSystem/ResourceArchive.h"
 #include "Engine/Private/Android/AssetsManagerAndroid.h"
 
@@ -144,7 +145,13 @@ File* File::Create(const FilePath& filename, uint32 attributes)
         }
     }
 
-    if (!(attributes & (WRITE | CREATE | APPEND)) && fs->filenamesTag.empty() == false)
+    const bool isReading = !(attributes & (WRITE | CREATE | APPEND));
+
+    // for paths inside indexed resource folders missing variants are skipped without touching file system
+    uint8 indexFlags = 0;
+    const bool isIndexed = isReading && fs->FindInResourcesIndex(filename.GetAbsolutePathname(), indexFlags);
+
+    if (isReading && fs->filenamesTag.empty() == false)
     {
         FilePath taggedFilename = filename;
         String basename = filename.GetBasename();
@@ -159,7 +166,9 @@ File* File::Create(const FilePath& filename, uint32 attributes)
             taggedFilename.ReplaceBasename(basename);
         }
 
-        File* result = PureCreate(taggedFilename, attributes);
+        uint8 taggedFlags = 0;
+        bool isTaggedMissing = isIndexed && fs->FindInResourcesIndex(taggedFilename.GetAbsolutePathname(), taggedFlags) && (taggedFlags & ResourcesIndex::ENTRY_FILE) == 0;
+        File* result = isTaggedMissing ? nullptr : PureCreate(taggedFilename, attributes);
         if (result != nullptr)
         {
             result->filename = filename;
@@ -168,17 +177,22 @@ File* File::Create(const FilePath& filename, uint32 attributes)
     }
     //end of tags
 
-    File* result = PureCreate(filename, attributes);
+    File* result = (isIndexed && (indexFlags & ResourcesIndex::ENTRY_FILE) == 0) ? nullptr : PureCreate(filename, attributes);
     if (result != nullptr)
     {
+        if (attributes & (CREATE | APPEND))
+        {
+            fs->UpdateResourcesIndex(filename.GetAbsolutePathname());
+        }
         return result;
     }
 
-    if (!(attributes & (WRITE | CREATE | APPEND)))
+    if (isReading)
     {
         FilePath compressedFile = filename + extDvpl;
         const String fileNameAbs = compressedFile.GetAbsolutePathname();
-        if (FileAPI::IsRegularFile(fileNameAbs))
+        bool isCompressed = isIndexed ? (indexFlags & ResourcesIndex::ENTRY_COMPRESSED_FILE) != 0 : FileAPI::IsRegularFile(fileNameAbs);
+        if (isCompressed)
         {
             try
             {
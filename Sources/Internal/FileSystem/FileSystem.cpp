@@ -14,6 +14,7 @@
 #include "Utils/Utils.h"
 #include "Logger/Logger.h"
 #include "FileSystem/ResourceArchive.h"
+#include "FileSystem/Private/ResourcesIndex.h"
 #include "Concurrency/LockGuard.h"
 
 #include "Engine/Private/EngineBackend.h"
@@ -118,16 +119,28 @@ FileSystem::eCreateDirectoryResult FileSystem::CreateExactDirectory(const FilePa
 #ifdef __DAVAENGINE_WINDOWS__
     WideString path = UTF8Utils::EncodeToWideString(filePath.GetAbsolutePathname());
     BOOL res = ::CreateDirectoryW(path.c_str(), 0);
-    return (res == 0) ? DIRECTORY_CANT_CREATE : DIRECTORY_CREATED;
+    eCreateDirectoryResult result = (res == 0) ? DIRECTORY_CANT_CREATE : DIRECTORY_CREATED;
 #elif defined(__DAVAENGINE_POSIX__)
     int res = mkdir(filePath.GetAbsolutePathname().c_str(), 0777);
-    return (res == 0) ? (DIRECTORY_CREATED) : (DIRECTORY_CANT_CREATE);
+    eCreateDirectoryResult result = (res == 0) ? (DIRECTORY_CREATED) : (DIRECTORY_CANT_CREATE);
 #endif //PLATFORMS
+
+    if (result == DIRECTORY_CREATED)
+    {
+        FilePath directoryPath(filePath);
+        directoryPath.MakeDirectoryPathname();
+        UpdateResourcesIndex(directoryPath.GetAbsolutePathname());
+    }
+    return result;
 }
 
 bool FileSystem::CopyFile(const FilePath& existingFile, const FilePath& newFile, bool overwriteExisting /* = false */)
 {
     DVASSERT(newFile.GetType() != FilePath::PATH_IN_RESOURCES);
+    SCOPE_EXIT
+    {
+        UpdateResourcesIndex(newFile.GetAbsolutePathname());
+    };
 
 #ifdef __DAVAENGINE_WINDOWS__
     WideString existingFilePath = UTF8Utils::EncodeToWideString(existingFile.GetAbsolutePathname());
@@ -221,7 +234,12 @@ bool FileSystem::MoveFile(const FilePath& existingFile, const FilePath& newFile,
         }
     }
     int result = FileAPI::RenameFile(fromFile, toFile);
-    if (0 != result && EXDEV == errno)
+    if (0 == result)
+    {
+        UpdateResourcesIndex(fromFile);
+        UpdateResourcesIndex(toFile);
+    }
+    else if (EXDEV == errno)
     {
         result = CopyFile(existingFile, newFile);
         if (result)
@@ -280,6 +298,7 @@ bool FileSystem::DeleteFile(const FilePath& filePath)
     int res = FileAPI::RemoveFile(fileName);
     if (res == 0)
     {
+        UpdateResourcesIndex(fileName);
         return true;
     }
 
@@ -331,11 +350,15 @@ bool FileSystem::DeleteDirectory(const FilePath& path, bool isRecursive)
     WideString sysPath = UTF8Utils::EncodeToWideString(path.GetAbsolutePathname());
     int32 chmodres = _wchmod(sysPath.c_str(), _S_IWRITE); // change read-only file mode
     int32 res = _wrmdir(sysPath.c_str());
-    return (res == 0);
 #elif defined(__DAVAENGINE_POSIX__)
     int32 res = rmdir(path.GetAbsolutePathname().c_str());
-    return (res == 0);
 #endif //PLATFORMS
+
+    if (res == 0)
+    {
+        UpdateResourcesIndex(path.GetAbsolutePathname());
+    }
+    return (res == 0);
 }
 
 uint32 FileSystem::DeleteDirectoryFiles(const FilePath& path, bool isRecursive)
@@ -556,6 +579,12 @@ bool FileSystem::IsFile(const FilePath& pathToCheck) const
         return false;
     }
 
+    uint8 indexFlags = 0;
+    if (FindInResourcesIndex(nativePath, indexFlags))
+    {
+        return (indexFlags & (ResourcesIndex::ENTRY_FILE | ResourcesIndex::ENTRY_COMPRESSED_FILE)) != 0;
+    }
+
     if (FileAPI::IsRegularFile(nativePath))
     {
         return true;
@@ -589,6 +618,17 @@ bool FileSystem::IsDirectory(const FilePath& pathToCheck) const
         return false;
     }
 
+    uint8 indexFlags = 0;
+    String indexPath = pathToCheckStr;
+    if (!indexPath.empty() && indexPath.back() != '/')
+    {
+        indexPath.push_back('/');
+    }
+    if (FindInResourcesIndex(indexPath, indexFlags))
+    {
+        return (indexFlags & ResourcesIndex::ENTRY_DIRECTORY) != 0;
+    }
+
 #if defined(__DAVAENGINE_WIN32__)
     WideString path = UTF8Utils::EncodeToWideString(pathToCheckStr);
     DWORD stats = GetFileAttributesW(path.c_str());
@@ -1248,4 +1288,84 @@ FileSystemDelegate* FileSystem::GetDelegate() const
 {
     return fsDelegate;
 }
+
+void FileSystem::SetResourcesIndexEnabled(bool enabled)
+{
+    LockGuard<Mutex> lock(accessResourcesIndex);
+    if (enabled && !resourcesIndex)
+    {
+        resourcesIndex.reset(new ResourcesIndex());
+    }
+    else if (!enabled)
+    {
+        resourcesIndex.reset();
+    }
+}
+
+bool FileSystem::IsResourcesIndexEnabled() const
+{
+    LockGuard<Mutex> lock(accessResourcesIndex);
+    return resourcesIndex != nullptr;
+}
+
+void FileSystem::InvalidateResourcesIndex()
+{
+    LockGuard<Mutex> lock(accessResourcesIndex);
+    if (resourcesIndex)
+    {
+        resourcesIndex->Clear();
+    }
+}
+
+bool FileSystem::FindInResourcesIndex(const String& absolutePath, uint8& flags) const
+{
+    String directory;
+    uint32 changesCount = 0;
+    {
+        LockGuard<Mutex> lock(accessResourcesIndex);
+        const FilePath* resourceFolder = resourcesIndex ? ResourcesIndex::FindFolder(resourceFolders, absolutePath) : nullptr;
+        if (resourceFolder == nullptr)
+        {
+            return false;
+        }
+
+        directory = ResourcesIndex::GetParentDirectory(resourceFolder->GetStringValue(), absolutePath);
+        if (resourcesIndex->IsDirectoryIndexed(directory))
+        {
+            flags = resourcesIndex->GetFlags(absolutePath);
+            return true;
+        }
+        changesCount = resourcesIndex->GetChangesCount();
+    }
+
+    // Directory is listed without lock, so other threads are not blocked by file system calls
+    ResourcesIndex::Entries directoryEntries = ResourcesIndex::ListDirectory(directory);
+
+    LockGuard<Mutex> lock(accessResourcesIndex);
+    if (!resourcesIndex)
+    {
+        return false;
+    }
+    if (!resourcesIndex->IsDirectoryIndexed(directory))
+    {
+        if (resourcesIndex->GetChangesCount() != changesCount)
+        {
+            // Listing may miss changes made meanwhile, directory will be listed again on next request
+            return false;
+        }
+        resourcesIndex->AddDirectory(directory, std::move(directoryEntries));
+    }
+    flags = resourcesIndex->GetFlags(absolutePath);
+    return true;
+}
+
+void FileSystem::UpdateResourcesIndex(const String& absolutePath)
+{
+    LockGuard<Mutex> lock(accessResourcesIndex);
+    const FilePath* resourceFolder = resourcesIndex ? ResourcesIndex::FindFolder(resourceFolders, absolutePath) : nullptr;
+    if (resourceFolder != nullptr)
+    {
+        resourcesIndex->Update(resourceFolder->GetStringValue(), absolutePath);
+    }
+}
 }
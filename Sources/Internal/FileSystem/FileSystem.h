@@ -26,6 +26,7 @@ namespace DAVA
 	\todo add support for pack files
 */
 class FileSystemDelegate;
+class ResourcesIndex;
 class FileSystem : public Singleton<FileSystem>
 {
 public:
@@ -303,9 +304,32 @@ public:
     void SetDelegate(FileSystemDelegate* delegate);
     FileSystemDelegate* GetDelegate() const;
 
+    /**
+        \brief Enables in-memory index of resource folders content
+        Index is disabled by default, applications with read-only resources enable it with `resources_index` engine option.
+        Index shouldn't be enabled on Android, where resources inside APK are not listed by FileList.
+        Each directory of resource folders is listed once on first access to a path directly inside it, listing doesn't block other threads. After that existence checks, ~res:/ resolving
+        and File::Create probing of tagged and compressed file variants inside resource folders don't touch file system.
+        Changes made through FileSystem and File are applied to the index, other changes of resource folders content
+        require InvalidateResourcesIndex call.
+        thread safe
+    */
+    void SetResourcesIndexEnabled(bool enabled);
+    bool IsResourcesIndexEnabled() const;
+
+    /**
+        \brief Drops indexed content of resource folders, folders will be listed again on next access
+        thread safe
+    */
+    void InvalidateResourcesIndex();
+
 private:
     bool HasLineEnding(File* f);
 
+    // Returns false if index is disabled or path is outside of resource folders
+    bool FindInResourcesIndex(const String& absolutePath, uint8& flags) const;
+    void UpdateResourcesIndex(const String& absolutePath);
+
     virtual eCreateDirectoryResult CreateExactDirectory(const FilePath& filePath);
 
     FilePath currentDocDirectory; // TODO how it influence on multithreading with FS?
@@ -336,6 +360,9 @@ private:
 
     FileSystemDelegate* fsDelegate = nullptr;
 
+    mutable Mutex accessResourcesIndex;
+    std::unique_ptr<ResourcesIndex> resourcesIndex;
+
     friend class File;
     friend class FilePath;
     Vector<FilePath> resourceFolders;
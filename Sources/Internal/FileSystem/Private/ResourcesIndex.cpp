@@ -0,0 +1,225 @@
+#include "FileSystem/Private/ResourcesIndex.h"
+#include "FileSystem/FileAPIHelper.h"
+#include "FileSystem/FileList.h"
+
+#include "Base/ScopedPtr.h"
+#include "Debug/DVAssert.h"
+
+#include <algorithm>
+#include <cctype>
+
+namespace DAVA
+{
+namespace ResourcesIndexDetails
+{
+const String COMPRESSED_EXTENSION(".dvpl");
+
+#if defined(__DAVAENGINE_WINDOWS__) || defined(__DAVAENGINE_APPLE__)
+const bool IS_CASE_INSENSITIVE_FILE_SYSTEM = true;
+#else
+const bool IS_CASE_INSENSITIVE_FILE_SYSTEM = false;
+#endif
+
+bool IsSameChar(char c1, char c2)
+{
+    return IS_CASE_INSENSITIVE_FILE_SYSTEM ? ::tolower(c1) == ::tolower(c2) : c1 == c2;
+}
+
+bool StartsWith(const String& str, const String& prefix)
+{
+    return str.size() >= prefix.size() && std::equal(prefix.begin(), prefix.end(), str.begin(), &IsSameChar);
+}
+
+bool EndsWith(const String& str, const String& suffix)
+{
+    return str.size() >= suffix.size() && std::equal(suffix.begin(), suffix.end(), str.end() - suffix.size(), &IsSameChar);
+}
+
+// Entries are stored with lower case keys on case-insensitive file systems
+String MakeKey(const String& path)
+{
+    String key = path;
+    if (IS_CASE_INSENSITIVE_FILE_SYSTEM)
+    {
+        std::transform(key.begin(), key.end(), key.begin(), ::tolower);
+    }
+    return key;
+}
+}
+
+const FilePath* ResourcesIndex::FindFolder(const Vector<FilePath>& folders, const String& path)
+{
+    using namespace ResourcesIndexDetails;
+
+    for (const FilePath& folder : folders)
+    {
+        const String& root = folder.GetStringValue();
+        if (!root.empty() && root.back() == '/' && StartsWith(path, root))
+        {
+            return &folder;
+        }
+    }
+    return nullptr;
+}
+
+String ResourcesIndex::GetParentDirectory(const String& folder, const String& path)
+{
+    if (path.size() <= folder.size())
+    {
+        return folder;
+    }
+
+    // trailing slash of directory path is skipped to find its parent
+    size_t slash = path.rfind('/', path.size() - 2);
+    DVASSERT(slash != String::npos && slash + 1 >= folder.size());
+    return path.substr(0, slash + 1);
+}
+
+ResourcesIndex::Entries ResourcesIndex::ListDirectory(const String& directory)
+{
+    using namespace ResourcesIndexDetails;
+
+    Entries directoryEntries;
+    ScopedPtr<FileList> fileList(new FileList(FilePath(directory)));
+    if (fileList->GetCount() > 0 || FileAPI::IsDirectory(directory))
+    {
+        directoryEntries[MakeKey(directory)] |= ENTRY_DIRECTORY;
+    }
+
+    for (uint32 i = 0; i < fileList->GetCount(); ++i)
+    {
+        if (fileList->IsNavigationDirectory(i))
+        {
+            continue;
+        }
+
+        const String& name = fileList->GetFilename(i);
+        if (fileList->IsDirectory(i))
+        {
+            directoryEntries[MakeKey(directory + name + "/")] |= ENTRY_DIRECTORY;
+        }
+        else if (EndsWith(name, COMPRESSED_EXTENSION))
+        {
+            directoryEntries[MakeKey(directory + name.substr(0, name.size() - COMPRESSED_EXTENSION.size()))] |= ENTRY_COMPRESSED_FILE;
+        }
+        else
+        {
+            directoryEntries[MakeKey(directory + name)] |= ENTRY_FILE;
+        }
+    }
+    return directoryEntries;
+}
+
+bool ResourcesIndex::IsDirectoryIndexed(const String& directory) const
+{
+    using namespace ResourcesIndexDetails;
+
+    return indexedDirectories.count(MakeKey(directory)) != 0;
+}
+
+void ResourcesIndex::AddDirectory(const String& directory, Entries&& directoryEntries)
+{
+    using namespace ResourcesIndexDetails;
+
+    DVASSERT(!IsDirectoryIndexed(directory));
+
+    indexedDirectories.insert(MakeKey(directory));
+    if (entries.empty())
+    {
+        entries = std::move(directoryEntries);
+    }
+    else
+    {
+        for (const auto& entry : directoryEntries)
+        {
+            entries[entry.first] |= entry.second;
+        }
+    }
+}
+
+uint8 ResourcesIndex::GetFlags(const String& path) const
+{
+    using namespace ResourcesIndexDetails;
+
+    auto it = entries.find(MakeKey(path));
+    return (it != entries.end()) ? it->second : 0;
+}
+
+void ResourcesIndex::Update(const String& folder, const String& path)
+{
+    using namespace ResourcesIndexDetails;
+
+    ++changesCount;
+
+    if (path.back() == '/')
+    {
+        String key = MakeKey(path);
+        if (FileAPI::IsDirectory(path))
+        {
+            entries[key] |= ENTRY_DIRECTORY;
+            AddParentDirectories(entries, MakeKey(folder), key);
+        }
+        else
+        {
+            // listings of removed directories stay indexed, as missing directories are listed as empty ones
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                it = StartsWith(it->first, key) ? entries.erase(it) : std::next(it);
+            }
+        }
+        return;
+    }
+
+    String filePath = EndsWith(path, COMPRESSED_EXTENSION) ? path.substr(0, path.size() - COMPRESSED_EXTENSION.size()) : path;
+
+    uint8 flags = 0;
+    if (FileAPI::IsRegularFile(filePath))
+    {
+        flags |= ENTRY_FILE;
+    }
+    if (FileAPI::IsRegularFile(filePath + COMPRESSED_EXTENSION))
+    {
+        flags |= ENTRY_COMPRESSED_FILE;
+    }
+
+    String key = MakeKey(filePath);
+    if (flags != 0)
+    {
+        entries[key] = flags;
+        AddParentDirectories(entries, MakeKey(folder), key);
+    }
+    else
+    {
+        entries.erase(key);
+    }
+}
+
+void ResourcesIndex::Clear()
+{
+    ++changesCount;
+    entries.clear();
+    indexedDirectories.clear();
+}
+
+uint32 ResourcesIndex::GetChangesCount() const
+{
+    return changesCount;
+}
+
+void ResourcesIndex::AddParentDirectories(Entries& folderEntries, const String& folder, const String& path)
+{
+    // trailing slash of directory path is skipped to start from its parent
+    size_t end = path.size() - 1;
+    while (end > folder.size())
+    {
+        size_t slash = path.rfind('/', end - 1);
+        if (slash == String::npos || slash + 1 < folder.size())
+        {
+            break;
+        }
+
+        folderEntries[path.substr(0, slash + 1)] |= ENTRY_DIRECTORY;
+        end = slash;
+    }
+}
+}
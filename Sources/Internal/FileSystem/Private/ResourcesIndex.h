@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+/**
+    In-memory index of files and directories inside resource folders.
+    Each directory inside resource folders is listed once on first request for a path directly inside it, so only
+    accessed directories are listed and each listing is a single FileList call. Later requests for such paths are
+    answered from memory without file system calls, missing directories are listed as empty ones. Compressed `.dvpl` files are stored under the name without `.dvpl`
+    extension with ENTRY_COMPRESSED_FILE flag, directories are stored with trailing slash.
+    Paths are compared case-insensitively on platforms with case-insensitive file systems (Windows, macOS and iOS).
+    Not thread safe, FileSystem guards access with mutex. Directories are listed by ListDirectory which doesn't
+    touch the index, so listing is done without holding the mutex.
+*/
+class ResourcesIndex final
+{
+public:
+    enum eEntryFlags : uint8
+    {
+        ENTRY_FILE = 1 << 0,
+        ENTRY_COMPRESSED_FILE = 1 << 1,
+        ENTRY_DIRECTORY = 1 << 2
+    };
+
+    using Entries = UnorderedMap<String, uint8>;
+
+    /** Returns folder from `folders` which contains absolute `path` or nullptr. */
+    static const FilePath* FindFolder(const Vector<FilePath>& folders, const String& path);
+
+    /** Returns directory which contains absolute `path` inside resource `folder`, `folder` itself for the folder path. */
+    static String GetParentDirectory(const String& folder, const String& path);
+
+    /** Lists files and subdirectories of `directory` from file system, content of subdirectories is not listed. */
+    static Entries ListDirectory(const String& directory);
+
+    bool IsDirectoryIndexed(const String& directory) const;
+
+    /** Adds content of `directory` listed by ListDirectory. */
+    void AddDirectory(const String& directory, Entries&& directoryEntries);
+
+    /** Returns flags of entry at absolute `path` inside indexed directory, zero for missing entries. */
+    uint8 GetFlags(const String& path) const;
+
+    /** Updates entry at absolute `path` inside resource `folder` and its parent directories from file system. */
+    void Update(const String& folder, const String& path);
+
+    /** Drops all indexed directories, they will be indexed again on next request. */
+    void Clear();
+
+    /**
+        Returns number of Update and Clear calls. Listing of directory is dropped if index was changed while
+        directory was listed, as listing may miss the change.
+    */
+    uint32 GetChangesCount() const;
+
+private:
+    static void AddParentDirectories(Entries& folderEntries, const String& folder, const String& path);
+
+    Entries entries;
+    UnorderedSet<String> indexedDirectories;
+    uint32 changesCount = 0;
+};
+}
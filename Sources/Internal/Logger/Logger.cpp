@@ -1,8 +1,13 @@
 #include "Logger/Logger.h"
 #include "Engine/Engine.h"
 #include "FileSystem/FileSystem.h"
+#include "Concurrency/LockGuard.h"
+#include "Concurrency/Mutex.h"
+#include "Concurrency/Thread.h"
 #include "Debug/DVAssert.h"
+#include "Time/SystemTimer.h"
 #include <cstdarg>
+#include <csignal>
 #include <array>
 #include <ctime>
 
@@ -15,6 +20,256 @@ namespace DAVA
 namespace
 {
 const size_t defaultBufferSize{ 4096 };
+const uint32 asyncWriteIntervalMs{ 20 };
+
+void FormatFilePrefix(time_t timestamp, Logger::eLogLevel ll, Array<char8, 128>& prefix)
+{
+    int32 seconds = timestamp % 60;
+    int32 minutes = (timestamp / 60) % 60;
+    int32 hours = (timestamp / (60 * 60)) % 24;
+
+    Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, Logger::GetLogLevelString(ll));
+}
+
+// Signals which terminate application, queued log messages are written before default handling
+const Array<int, 4> crashSignals{ { SIGABRT, SIGSEGV, SIGFPE, SIGILL } };
+Array<void (*)(int), 4> previousCrashHandlers{};
+
+void CrashSignalHandler(int sig)
+{
+    Logger::FlushOnCrash();
+
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        if (crashSignals[i] == sig)
+        {
+            std::signal(sig, previousCrashHandlers[i] != SIG_ERR ? previousCrashHandlers[i] : SIG_DFL);
+            break;
+        }
+    }
+    std::raise(sig);
+}
+
+void InstallCrashHandlers()
+{
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        previousCrashHandlers[i] = std::signal(crashSignals[i], &CrashSignalHandler);
+    }
+}
+
+void RestoreCrashHandlers()
+{
+    for (size_t i = 0; i < crashSignals.size(); ++i)
+    {
+        if (previousCrashHandlers[i] != SIG_ERR)
+        {
+            std::signal(crashSignals[i], previousCrashHandlers[i]);
+        }
+    }
+}
+}
+
+/**
+    Writer of asynchronous logger mode.
+    Producers push messages to intrusive lock-free MPSC queue (D. Vyukov's algorithm), consumer is writer thread
+    or any thread that flushes log. Consumers are serialized by mutex, producers never wait for it.
+    Each message carries everything needed to write it, so writer never reads mutable state of logger.
+*/
+class Logger::AsyncWriter
+{
+public:
+    AsyncWriter(const Logger* logger);
+    ~AsyncWriter();
+
+    void Push(const FilePath& filename, bool isMainLog, bool toConsole, eLogLevel ll, const char8* text);
+    void Flush();
+    bool TryFlush();
+    void CloseFiles();
+
+private:
+    struct Message
+    {
+        std::atomic<Message*> next{ nullptr };
+        FilePath filename;
+        bool isMainLog = false;
+        bool toConsole = false;
+        String text;
+        time_t timestamp = 0;
+        eLogLevel level = LEVEL_FRAMEWORK;
+    };
+
+    void ThreadFunc();
+    void WriteQueuedMessages();
+    void WriteToFile(const FilePath& filename, bool isMainLog, const String& data);
+
+    const Logger* logger = nullptr;
+    Thread* thread = nullptr;
+
+    std::atomic<Message*> head{ nullptr };
+    Message* tail = nullptr;
+
+    Mutex consumerMutex;
+    // Id of thread which holds consumerMutex, lets crash handler detect that it interrupted consumer on the same thread
+    std::atomic<uint64> consumerThreadId{ 0 };
+    UnorderedMap<String, File*> files;
+    String fileBatch;
+};
+
+Logger::AsyncWriter::AsyncWriter(const Logger* logger_)
+    : logger(logger_)
+{
+    tail = new Message();
+    head = tail;
+
+    thread = Thread::Create(MakeFunction(this, &AsyncWriter::ThreadFunc));
+    thread->SetName("LoggerWriterThread");
+    thread->Start();
+}
+
+Logger::AsyncWriter::~AsyncWriter()
+{
+    thread->Cancel();
+    thread->Join();
+    SafeRelease(thread);
+
+    Flush();
+    CloseFiles();
+    delete tail;
+}
+
+void Logger::AsyncWriter::Push(const FilePath& filename, bool isMainLog, bool toConsole, eLogLevel ll, const char8* text)
+{
+    Message* message = new Message();
+    message->filename = filename;
+    message->isMainLog = isMainLog;
+    message->toConsole = toConsole;
+    message->text = text;
+    message->timestamp = time(nullptr);
+    message->level = ll;
+
+    Message* prev = head.exchange(message, std::memory_order_acq_rel);
+    prev->next.store(message, std::memory_order_release);
+}
+
+void Logger::AsyncWriter::Flush()
+{
+    LockGuard<Mutex> lock(consumerMutex);
+    consumerThreadId = Thread::GetCurrentIdAsUInt64();
+    WriteQueuedMessages();
+    consumerThreadId = 0;
+}
+
+bool Logger::AsyncWriter::TryFlush()
+{
+    // Crashed thread may be the one which writes messages now, relocking mutex by it would deadlock
+    if (consumerThreadId == Thread::GetCurrentIdAsUInt64() || !consumerMutex.TryLock())
+    {
+        return false;
+    }
+
+    consumerThreadId = Thread::GetCurrentIdAsUInt64();
+    WriteQueuedMessages();
+    consumerThreadId = 0;
+    consumerMutex.Unlock();
+    return true;
+}
+
+void Logger::AsyncWriter::CloseFiles()
+{
+    LockGuard<Mutex> lock(consumerMutex);
+    consumerThreadId = Thread::GetCurrentIdAsUInt64();
+    for (auto& item : files)
+    {
+        SafeRelease(item.second);
+    }
+    files.clear();
+    consumerThreadId = 0;
+}
+
+void Logger::AsyncWriter::ThreadFunc()
+{
+    while (!thread->IsCancelling())
+    {
+        Flush();
+        Thread::Sleep(asyncWriteIntervalMs);
+    }
+}
+
+void Logger::AsyncWriter::WriteQueuedMessages()
+{
+    // Messages to the same file are collected to one write
+    FilePath batchFilename;
+    bool batchIsMainLog = false;
+
+    // Producer may be interrupted between exchange and linking, in that case rest of messages are written next time
+    Message* next = tail->next.load(std::memory_order_acquire);
+    while (next != nullptr)
+    {
+        PlatformLog(next->level, next->text.c_str());
+        if (next->toConsole)
+        {
+            logger->ConsoleLog(next->level, next->text.c_str());
+        }
+
+        if (!next->filename.IsEmpty())
+        {
+            if (batchFilename != next->filename)
+            {
+                if (!fileBatch.empty())
+                {
+                    WriteToFile(batchFilename, batchIsMainLog, fileBatch);
+                    fileBatch.clear();
+                }
+                batchFilename = next->filename;
+                batchIsMainLog = next->isMainLog;
+            }
+
+            Array<char8, 128> prefix;
+            FormatFilePrefix(next->timestamp, next->level, prefix);
+            fileBatch += prefix.data();
+            fileBatch += next->text;
+        }
+
+        // Consumed message becomes new stub node of queue
+        delete tail;
+        tail = next;
+        next = tail->next.load(std::memory_order_acquire);
+    }
+
+    if (!fileBatch.empty())
+    {
+        WriteToFile(batchFilename, batchIsMainLog, fileBatch);
+        fileBatch.clear();
+    }
+}
+
+void Logger::AsyncWriter::WriteToFile(const FilePath& filename, bool isMainLog, const String& data)
+{
+    if (nullptr == FileSystem::Instance())
+    {
+        return;
+    }
+
+    String key = filename.GetAbsolutePathname();
+    auto it = files.find(key);
+    if (it == files.end())
+    {
+        if (!isMainLog)
+        {
+            logger->CutOldLogFileIfExist(filename);
+        }
+
+        File* file = File::Create(filename, File::APPEND | File::WRITE);
+        if (nullptr == file)
+        {
+            return;
+        }
+        it = files.emplace(key, file).first;
+    }
+
+    it->second->Write(data.data(), static_cast<uint32>(data.size()));
+    it->second->Flush();
 }
 
 #if defined(__DAVAENGINE_WIN32__)
@@ -105,6 +360,8 @@ Logger::Logger()
 
 Logger::~Logger()
 {
+    SetAsyncMode(false);
+
     for (auto logOutput : customOutputs)
     {
         delete logOutput;
@@ -321,6 +578,13 @@ void Logger::SetLogFilename(const String& filename)
 
 void Logger::SetLogPathname(const FilePath& filepath)
 {
+    if (asyncWriter != nullptr)
+    {
+        // Old log file should be closed before cutting
+        asyncWriter->Flush();
+        asyncWriter->CloseFiles();
+    }
+
     const bool canWorkWithFile = CutOldLogFileIfExist(filepath);
     DVASSERT(canWorkWithFile);
 
@@ -415,13 +679,7 @@ void Logger::FileLog(const FilePath& customLogFileName, eLogLevel ll, const char
         if (file)
         {
             Array<char8, 128> prefix;
-
-            time_t timestamp = time(nullptr); //Time in UTC format
-            int32 seconds = timestamp % 60;
-            int32 minutes = (timestamp / 60) % 60;
-            int32 hours = (timestamp / (60 * 60)) % 24;
-
-            Snprintf(&prefix[0], prefix.size(), "%02d:%02d:%02d [%s] ", hours, minutes, seconds, GetLogLevelString(ll));
+            FormatFilePrefix(time(nullptr), ll, prefix); //Time in UTC format
             file->Write(prefix.data(), static_cast<uint32>(strlen(prefix.data())));
             file->Write(text, static_cast<uint32>(strlen(text)));
         }
@@ -436,6 +694,71 @@ void Logger::CustomLog(eLogLevel ll, const char8* text) const
     }
 }
 
+void Logger::SetAsyncMode(bool enable)
+{
+    if (enable && asyncWriter == nullptr)
+    {
+        asyncWriter = new AsyncWriter(this);
+        InstallCrashHandlers();
+    }
+    else if (!enable && asyncWriter != nullptr)
+    {
+        RestoreCrashHandlers();
+        SafeDelete(asyncWriter);
+    }
+}
+
+bool Logger::IsAsyncMode() const
+{
+    return asyncWriter != nullptr;
+}
+
+void Logger::Flush()
+{
+    Logger* log = GetLoggerInstance();
+    if (nullptr != log && nullptr != log->asyncWriter)
+    {
+        log->asyncWriter->Flush();
+    }
+}
+
+bool Logger::FlushOnCrash()
+{
+    Logger* log = GetLoggerInstance();
+    if (nullptr != log && nullptr != log->asyncWriter)
+    {
+        return log->asyncWriter->TryFlush();
+    }
+    return true;
+}
+
+void Logger::SetRateLimit(uint32 messagesPerSecond)
+{
+    rateLimit = messagesPerSecond;
+}
+
+bool Logger::IsRateLimited(eLogLevel ll) const
+{
+    if (rateLimit == 0 || ll >= LEVEL_WARNING)
+    {
+        return false;
+    }
+
+    // Fixed one second window, counters may be reset concurrently by several threads, it only makes limit a bit inaccurate
+    uint32 second = static_cast<uint32>(SystemTimer::GetMs() / 1000);
+    if (rateLimitSecond.exchange(second, std::memory_order_relaxed) != second)
+    {
+        rateLimitCount.store(0, std::memory_order_relaxed);
+    }
+
+    if (rateLimitCount.fetch_add(1, std::memory_order_relaxed) >= rateLimit)
+    {
+        rateLimitSkipped.fetch_add(1, std::memory_order_relaxed);
+        return true;
+    }
+    return false;
+}
+
 void Logger::EnableConsoleMode()
 {
     consoleModeEnabled = true;
@@ -459,12 +782,41 @@ void Logger::Output(eLogLevel ll, const char8* formatedMsg) const
 }
 
 void Logger::Output(const FilePath& customLogFilename, eLogLevel ll, const char8* formatedMsg) const
+{
+    if (IsRateLimited(ll))
+    {
+        return;
+    }
+
+    if (rateLimitSkipped.load(std::memory_order_relaxed) != 0)
+    {
+        uint32 skipped = rateLimitSkipped.exchange(0, std::memory_order_relaxed);
+        if (skipped != 0)
+        {
+            OutputMessage(customLogFilename, LEVEL_WARNING, Format("%u log messages were skipped by rate limit\n", skipped).c_str());
+        }
+    }
+
+    OutputMessage(customLogFilename, ll, formatedMsg);
+}
+
+void Logger::OutputMessage(const FilePath& customLogFilename, eLogLevel ll, const char8* formatedMsg) const
 {
     CustomLog(ll, formatedMsg);
     // print platform log or write log to file
     // only if log level is acceptable
     if (ll >= logLevel)
     {
+        if (asyncWriter != nullptr)
+        {
+            asyncWriter->Push(customLogFilename, customLogFilename == logFilename, consoleModeEnabled, ll, formatedMsg);
+            if (ll >= LEVEL_ERROR)
+            {
+                asyncWriter->Flush();
+            }
+            return;
+        }
+
         PlatformLog(ll, formatedMsg);
         if (consoleModeEnabled)
         {
@@ -13,6 +13,7 @@
 
 #include "FileSystem/FilePath.h"
 
+#include <atomic>
 #include <cstdarg>
 
 namespace DAVA
@@ -111,11 +112,33 @@ public:
     void SetMaxFileSize(uint32 size);
     void EnableConsoleMode();
 
+    //! Enables/disables asynchronous output. Disabled by default.
+    //! Messages are formatted and passed to custom outputs on calling thread, then they are put to lock-free queue.
+    //! Writer thread keeps log files open and writes queued messages to files, platform log and console by batches.
+    //! Messages with LEVEL_ERROR flush queue immediately, so log is complete if application crashes after error or failed assert.
+    //! Mode should be switched when other threads don't log.
+    void SetAsyncMode(bool enable);
+    bool IsAsyncMode() const;
+
+    //! Writes all queued messages in asynchronous mode. Can be called from any thread.
+    static void Flush();
+
+    //! Writes queued messages only if no other thread is writing them now, never waits.
+    //! Called from handlers of SIGABRT, SIGSEGV, SIGFPE and SIGILL installed in asynchronous mode, can be called
+    //! from other crash handlers. Returns false if messages were not written.
+    static bool FlushOnCrash();
+
+    //! Limits count of messages with level lower than LEVEL_WARNING written per second.
+    //! Skipped messages are counted and reported by next written message. 0 disables limit (default).
+    void SetRateLimit(uint32 messagesPerSecond);
+
     static const char8* GetLogLevelString(eLogLevel ll);
     //TODO: insert Optional
     static eLogLevel GetLogLevelFromString(const char8* ll);
 
 private:
+    class AsyncWriter;
+
     static Logger* GetLoggerInstance();
     bool CutOldLogFileIfExist(const FilePath& logFile) const;
 
@@ -124,12 +147,21 @@ private:
     void ConsoleLog(eLogLevel ll, const char8* text) const;
     void Output(eLogLevel ll, const char8* formatedMsg) const;
     void Output(const FilePath& customLogFilename, eLogLevel ll, const char8* formatedMsg) const;
+    void OutputMessage(const FilePath& customLogFilename, eLogLevel ll, const char8* formatedMsg) const;
+    bool IsRateLimited(eLogLevel ll) const;
 
     eLogLevel logLevel;
     FilePath logFilename;
     Vector<LoggerOutput*> customOutputs;
     bool consoleModeEnabled;
     uint32 cutLogSize = 512 * 1024; //0.5 MB;
+
+    AsyncWriter* asyncWriter = nullptr;
+
+    uint32 rateLimit = 0;
+    mutable std::atomic<uint32> rateLimitSecond{ 0 };
+    mutable std::atomic<uint32> rateLimitCount{ 0 };
+    mutable std::atomic<uint32> rateLimitSkipped{ 0 };
 };
 
 class LoggerOutput
@@ -6,6 +6,7 @@
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #include <cassert>
+#include <cmath>
 
 #if defined(__DAVAENGINE_WIN32__)
 #pragma warning(push)
@@ -49,8 +50,8 @@ struct MemoryManager::MemoryBlock
     MemoryBlock* prev; // Pointer to previous block
     MemoryBlock* next; // Pointer to next block
     void* realBlockStart; // Pointer to real block start
-    void* padding1; // Padding to make sure that
-    uint32 padding2; //          struct size is integral multiple of 16 bytes
+    void* padding1; // Padding to make sure that struct size is integral multiple of 16 bytes
+    uint32 estimatedSize; // Estimate of memory represented by sampled block in sampling mode
     uint32 orderNo; // Block order number
     uint32 allocByApp; // Size requested by application
     uint32 allocTotal; // Total allocated size
@@ -84,6 +85,145 @@ struct MemoryManager::AllocScopeItem
     uint32 allocPool;
 };
 
+// Statistics changes made by one thread in sampling mode, merged into global statistics in Update()
+// Counters are written only by owner thread and are never reset, so owner updates them without locks and read-modify-write
+// operations, and merging adds difference between current and last merged values. Deallocations made by thread
+// make its counters wrap around zero, difference works with modular arithmetic
+struct MemoryManager::ThreadStat
+{
+    struct PoolCounters
+    {
+        std::atomic<uint32> allocByApp{ 0 };
+        std::atomic<uint32> allocTotal{ 0 };
+        std::atomic<uint32> blockCount{ 0 };
+        std::atomic<uint32> maxBlockSize{ 0 };
+    };
+    struct TagCounters
+    {
+        std::atomic<uint32> allocByApp{ 0 };
+        std::atomic<uint32> blockCount{ 0 };
+    };
+
+    void Add(const MemoryBlock* block);
+    void Subtract(const MemoryBlock* block);
+    void MergeInto(AllocPoolStat* pools, TagAllocStat* tags);
+
+    static void Increase(std::atomic<uint32>& counter, uint32 value);
+    static void Decrease(std::atomic<uint32>& counter, uint32 value);
+
+    ThreadStat* next = nullptr;
+    std::atomic<bool> isDead{ false }; // Set by owner thread on exit, after that statistics are merged last time and freed
+    PoolCounters poolCounters[MAX_ALLOC_POOL_COUNT];
+    TagCounters tagCounters[MAX_TAG_COUNT];
+    AllocPoolStat mergedAllocPool[MAX_ALLOC_POOL_COUNT] = {}; // Values already merged into global statistics, used only by merging
+    TagAllocStat mergedTag[MAX_TAG_COUNT] = {};
+    int64 bytesUntilSample = 0; // Number of bytes to allocate before next sampled block
+    uint64 randomState = 0;
+};
+
+inline void MemoryManager::ThreadStat::Increase(std::atomic<uint32>& counter, uint32 value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void MemoryManager::ThreadStat::Decrease(std::atomic<uint32>& counter, uint32 value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) - value, std::memory_order_relaxed);
+}
+
+void MemoryManager::ThreadStat::Add(const MemoryBlock* block)
+{
+    const uint32 poolIndices[] = { ALLOC_POOL_TOTAL, block->pool };
+    for (uint32 poolIndex : poolIndices)
+    {
+        PoolCounters& pool = poolCounters[poolIndex];
+        Increase(pool.allocByApp, block->allocByApp);
+        Increase(pool.allocTotal, block->allocTotal);
+        Increase(pool.blockCount, 1);
+        if (block->allocByApp > pool.maxBlockSize.load(std::memory_order_relaxed))
+            pool.maxBlockSize.store(block->allocByApp, std::memory_order_relaxed);
+    }
+
+    uint32 blockTags = block->tags;
+    if (blockTags != 0)
+    {
+        for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
+        {
+            if (blockTags & 0x01)
+            {
+                Increase(tagCounters[index].allocByApp, block->allocByApp);
+                Increase(tagCounters[index].blockCount, 1);
+            }
+        }
+    }
+    else
+    {
+        Increase(tagCounters[UNTAGGED].allocByApp, block->allocByApp);
+        Increase(tagCounters[UNTAGGED].blockCount, 1);
+    }
+}
+
+void MemoryManager::ThreadStat::Subtract(const MemoryBlock* block)
+{
+    const uint32 poolIndices[] = { ALLOC_POOL_TOTAL, block->pool };
+    for (uint32 poolIndex : poolIndices)
+    {
+        PoolCounters& pool = poolCounters[poolIndex];
+        Decrease(pool.allocByApp, block->allocByApp);
+        Decrease(pool.allocTotal, block->allocTotal);
+        Decrease(pool.blockCount, 1);
+    }
+
+    uint32 blockTags = block->tags;
+    if (blockTags != 0)
+    {
+        for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
+        {
+            if (blockTags & 0x01)
+            {
+                Decrease(tagCounters[index].allocByApp, block->allocByApp);
+                Decrease(tagCounters[index].blockCount, 1);
+            }
+        }
+    }
+    else
+    {
+        Decrease(tagCounters[UNTAGGED].allocByApp, block->allocByApp);
+        Decrease(tagCounters[UNTAGGED].blockCount, 1);
+    }
+}
+
+void MemoryManager::ThreadStat::MergeInto(AllocPoolStat* pools, TagAllocStat* tags)
+{
+    for (uint32 i = 0; i < MAX_ALLOC_POOL_COUNT; ++i)
+    {
+        const AllocPoolStat current = {
+            poolCounters[i].allocByApp.load(std::memory_order_relaxed),
+            poolCounters[i].allocTotal.load(std::memory_order_relaxed),
+            poolCounters[i].blockCount.load(std::memory_order_relaxed),
+            poolCounters[i].maxBlockSize.load(std::memory_order_relaxed)
+        };
+        AllocPoolStat& merged = mergedAllocPool[i];
+        pools[i].allocByApp += current.allocByApp - merged.allocByApp;
+        pools[i].allocTotal += current.allocTotal - merged.allocTotal;
+        pools[i].blockCount += current.blockCount - merged.blockCount;
+        if (current.maxBlockSize > pools[i].maxBlockSize)
+            pools[i].maxBlockSize = current.maxBlockSize;
+        merged = current;
+    }
+    for (uint32 i = 0; i < MAX_TAG_COUNT; ++i)
+    {
+        const TagAllocStat current = {
+            tagCounters[i].allocByApp.load(std::memory_order_relaxed),
+            tagCounters[i].blockCount.load(std::memory_order_relaxed)
+        };
+        TagAllocStat& merged = mergedTag[i];
+        tags[i].allocByApp += current.allocByApp - merged.allocByApp;
+        tags[i].blockCount += current.blockCount - merged.blockCount;
+        merged = current;
+    }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 MMItemName MemoryManager::tagNames[MAX_TAG_COUNT];
@@ -162,6 +302,24 @@ void MemoryManager::EnableLightWeightMode()
     lightWeightMode = true;
 }
 
+void MemoryManager::EnableSamplingMode(uint32 sampleInterval_)
+{
+    DVASSERT(sampleInterval_ > 0);
+
+    LockType lock(allocMutex);
+    sampleInterval = sampleInterval_;
+    nextBlockNo = statGeneral.nextBlockNo;
+    samplingMode = true;
+}
+
+void MemoryManager::DisableSamplingMode()
+{
+    MergeThreadStats();
+
+    LockType lock(allocMutex);
+    samplingMode = false;
+}
+
 void MemoryManager::SetCallbacks(Function<void()> updateCallback_, Function<void(uint32, bool)> tagCallback_)
 {
     updateCallback = updateCallback_;
@@ -177,6 +335,11 @@ void MemoryManager::Update()
         symbolCollectorThread->Start();
     }
 
+    if (samplingMode)
+    {
+        MergeThreadStats();
+    }
+
     if (updateCallback != nullptr)
     {
         updateCallback();
@@ -227,26 +390,7 @@ DAVA_NOINLINE void* MemoryManager::Allocate(size_t size, uint32 poolIndex)
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
-        {
-            Backtrace backtrace;
-            CollectBacktrace(&backtrace, 1);
-            block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
-            InsertBacktrace(backtrace);
-        }
+        TrackBlock(block);
         return static_cast<void*>(block + 1);
     }
     return nullptr;
@@ -296,26 +440,7 @@ DAVA_NOINLINE void* MemoryManager::AlignedAllocate(size_t size, size_t align, ui
             }
         }
 
-        {
-            LockType lock(allocMutex);
-            block->tags = statGeneral.activeTags;
-            block->orderNo = statGeneral.nextBlockNo++;
-            InsertBlock(block);
-        }
-        {
-            uint32 systemMemoryUsage = GetSystemMemoryUsage();
-            LockType lock(statMutex);
-            UpdateStatAfterAlloc(block, systemMemoryUsage);
-        }
-        if (!lightWeightMode)
-        {
-            Backtrace backtrace;
-            CollectBacktrace(&backtrace, 1);
-            block->bktraceHash = backtrace.hash;
-
-            LockType lock(bktraceMutex);
-            InsertBacktrace(backtrace);
-        }
+        TrackBlock(block);
         return reinterpret_cast<void*>(aligned);
     }
     return nullptr;
@@ -425,20 +550,7 @@ void MemoryManager::Deallocate(void* ptr)
         bool isAccessible = IsMemoryAddressAccessible(block);
         if (isAccessible && BLOCK_MARK == block->mark)
         {
-            {
-                LockType lock(allocMutex);
-                RemoveBlock(block);
-            }
-            {
-                uint32 systemMemoryUsage = GetSystemMemoryUsage();
-                LockType lock(statMutex);
-                UpdateStatAfterDealloc(block, systemMemoryUsage);
-            }
-            if (!lightWeightMode)
-            {
-                LockType lock(bktraceMutex);
-                RemoveBacktrace(block->bktraceHash);
-            }
+            UntrackBlock(block);
 
             // Tracked memory block consists of header (of type struct MemoryBlock) and data block that returned to app.
             // Tracked memory blocks are distinguished by special mark in header.
@@ -661,6 +773,249 @@ void MemoryManager::TrackGpuDealloc(uint32 id, uint32 gpuPoolIndex)
     gpuBlockMap->erase(iter);
 }
 
+DAVA_NOINLINE void MemoryManager::TrackBlock(MemoryBlock* block)
+{
+    block->estimatedSize = 0;
+    if (samplingMode)
+    {
+        block->tags = statGeneral.activeTags;
+        block->orderNo = nextBlockNo.fetch_add(1, std::memory_order_relaxed);
+
+        ThreadStat* threadStat = GetThreadStat(true);
+        bool sampled = false;
+        if (threadStat != nullptr)
+        {
+            sampled = SampleAllocation(threadStat, block->allocByApp, sampleInterval, block->estimatedSize);
+            threadStat->Add(block);
+        }
+        else
+        {
+            LockType lock(statMutex);
+            AddAllocStat(statAllocPool, statTag, block);
+        }
+
+        if (!sampled)
+        {
+            // Blocks which are not sampled aren't linked into list of blocks, they point to themselves
+            // to be distinguished on deallocation
+            block->prev = block;
+            block->next = block;
+            return;
+        }
+
+        LockType lock(allocMutex);
+        InsertBlock(block);
+    }
+    else
+    {
+        {
+            LockType lock(allocMutex);
+            block->tags = statGeneral.activeTags;
+            block->orderNo = statGeneral.nextBlockNo++;
+            InsertBlock(block);
+        }
+        {
+            uint32 systemMemoryUsage = GetSystemMemoryUsage();
+            LockType lock(statMutex);
+            UpdateStatAfterAlloc(block, systemMemoryUsage);
+        }
+    }
+
+    if (!lightWeightMode)
+    {
+        Backtrace backtrace;
+        CollectBacktrace(&backtrace, 2);
+        block->bktraceHash = backtrace.hash;
+
+        LockType lock(bktraceMutex);
+        InsertBacktrace(backtrace);
+    }
+}
+
+void MemoryManager::UntrackBlock(MemoryBlock* block)
+{
+    if (samplingMode)
+    {
+        // Do not create statistics on deallocation as thread can free memory after its statistics are released on exit
+        ThreadStat* threadStat = GetThreadStat(false);
+        if (threadStat != nullptr)
+        {
+            threadStat->Subtract(block);
+        }
+        else
+        {
+            LockType lock(statMutex);
+            SubtractAllocStat(statAllocPool, statTag, block);
+        }
+    }
+    else
+    {
+        uint32 systemMemoryUsage = GetSystemMemoryUsage();
+        LockType lock(statMutex);
+        UpdateStatAfterDealloc(block, systemMemoryUsage);
+    }
+
+    if (block->next != block)
+    {
+        {
+            LockType lock(allocMutex);
+            RemoveBlock(block);
+        }
+        if (!lightWeightMode)
+        {
+            LockType lock(bktraceMutex);
+            RemoveBacktrace(block->bktraceHash);
+        }
+    }
+}
+
+MemoryManager::ThreadStat* MemoryManager::GetThreadStat(bool create)
+{
+    if (!tlsThreadStat.IsCreated())
+    {
+        return nullptr;
+    }
+
+    ThreadStat* threadStat = tlsThreadStat.Get();
+    if (nullptr == threadStat && create)
+    {
+        threadStat = CreateThreadStat();
+        tlsThreadStat.Reset(threadStat);
+
+        // Registering handler allocates memory, so it's done after statistics are set for thread
+        Thread::AtCurrentThreadExit([this]() {
+            ThreadStat* exitedThreadStat = tlsThreadStat.Release();
+            if (exitedThreadStat != nullptr)
+            {
+                exitedThreadStat->isDead.store(true, std::memory_order_release);
+            }
+        });
+    }
+    return threadStat;
+}
+
+MemoryManager::ThreadStat* MemoryManager::CreateThreadStat()
+{
+    ThreadStat* threadStat = new (InternalAllocate(sizeof(ThreadStat))) ThreadStat;
+    threadStat->randomState = (static_cast<uint64>(reinterpret_cast<uintptr_t>(threadStat)) << 1) | 1;
+    threadStat->bytesUntilSample = NextSampleDistance(threadStat, sampleInterval);
+
+    ThreadStat* head = threadStatHead.load(std::memory_order_relaxed);
+    do
+    {
+        threadStat->next = head;
+    } while (!threadStatHead.compare_exchange_weak(head, threadStat, std::memory_order_release, std::memory_order_relaxed));
+    return threadStat;
+}
+
+bool MemoryManager::SampleAllocation(ThreadStat* threadStat, size_t size, uint32 sampleInterval, uint32& estimatedSize)
+{
+    threadStat->bytesUntilSample -= static_cast<int64>(size);
+    if (threadStat->bytesUntilSample > 0)
+    {
+        return false;
+    }
+    threadStat->bytesUntilSample = NextSampleDistance(threadStat, sampleInterval);
+
+    // Block of given size is sampled with probability p = 1 - exp(-size / interval),
+    // so it represents size / p bytes to keep sum of estimates unbiased
+    const float64 probability = 1.0 - std::exp(-static_cast<float64>(size) / static_cast<float64>(sampleInterval));
+    const float64 estimate = static_cast<float64>(size) / probability;
+    estimatedSize = static_cast<uint32>(std::min(estimate, 4294967295.0));
+    return true;
+}
+
+uint32 MemoryManager::NextSampleDistance(ThreadStat* threadStat, uint32 sampleInterval)
+{
+    // xorshift64* generator
+    uint64 x = threadStat->randomState;
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+    threadStat->randomState = x;
+    const uint64 r = x * 2685821657736338717ULL;
+
+    // Distances between samples are exponentially distributed with mean equal to sample interval
+    const float64 uniform = (static_cast<float64>(r >> 11) + 1.0) / 9007199254740992.0; // (0, 1]
+    const float64 distance = -std::log(uniform) * static_cast<float64>(sampleInterval);
+    return static_cast<uint32>(std::max(1.0, std::min(distance, 4294967295.0)));
+}
+
+void MemoryManager::MergeThreadStats()
+{
+    uint32 systemMemoryUsage = GetSystemMemoryUsage();
+
+    ThreadStat* deadThreadStats = nullptr;
+    {
+        LockType lockStat(statMutex);
+        ThreadStat* prev = nullptr;
+        ThreadStat* threadStat = threadStatHead.load(std::memory_order_acquire);
+        while (threadStat != nullptr)
+        {
+            // Flag is read before counters, so counters of dead thread are final
+            const bool isDead = threadStat->isDead.load(std::memory_order_acquire);
+            threadStat->MergeInto(statAllocPool, statTag);
+
+            ThreadStat* next = threadStat->next;
+            if (isDead)
+            {
+                // Only merging removes items, other threads can only push new items to list head
+                if (prev != nullptr)
+                {
+                    prev->next = next;
+                }
+                else
+                {
+                    ThreadStat* expected = threadStat;
+                    if (!threadStatHead.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        prev = expected;
+                        while (prev->next != threadStat)
+                        {
+                            prev = prev->next;
+                        }
+                        prev->next = next;
+                    }
+                }
+                threadStat->next = deadThreadStats;
+                deadThreadStats = threadStat;
+            }
+            else
+            {
+                prev = threadStat;
+            }
+            threadStat = next;
+        }
+
+        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+        if (samplingMode)
+        {
+            statGeneral.nextBlockNo = nextBlockNo.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Internal deallocation takes statistics mutex, so dead items are freed after merging
+    while (deadThreadStats != nullptr)
+    {
+        ThreadStat* next = deadThreadStats->next;
+        deadThreadStats->~ThreadStat();
+        InternalDeallocate(deadThreadStats);
+        deadThreadStats = next;
+    }
+}
+
+uint32 MemoryManager::GetThreadStatCount() const
+{
+    LockType lock(statMutex);
+    uint32 count = 0;
+    for (ThreadStat* threadStat = threadStatHead.load(std::memory_order_acquire); threadStat != nullptr; threadStat = threadStat->next)
+    {
+        count += 1;
+    }
+    return count;
+}
+
 void MemoryManager::InsertBlock(MemoryBlock* block)
 {
     if (head != nullptr)
@@ -694,79 +1049,88 @@ void MemoryManager::UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemory
         statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
         statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
     }
+    AddAllocStat(statAllocPool, statTag, block);
+}
+
+void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+{
+    { // Update memory usage reported by system
+        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
+        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
+    }
+    SubtractAllocStat(statAllocPool, statTag, block);
+}
+
+void MemoryManager::AddAllocStat(AllocPoolStat* pools, TagAllocStat* tags, const MemoryBlock* block)
+{
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount += 1;
+        pools[ALLOC_POOL_TOTAL].allocByApp += block->allocByApp;
+        pools[ALLOC_POOL_TOTAL].allocTotal += block->allocTotal;
+        pools[ALLOC_POOL_TOTAL].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize)
-            statAllocPool[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > pools[ALLOC_POOL_TOTAL].maxBlockSize)
+            pools[ALLOC_POOL_TOTAL].maxBlockSize = block->allocByApp;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp += block->allocByApp;
-        statAllocPool[poolIndex].allocTotal += block->allocTotal;
-        statAllocPool[poolIndex].blockCount += 1;
+        pools[poolIndex].allocByApp += block->allocByApp;
+        pools[poolIndex].allocTotal += block->allocTotal;
+        pools[poolIndex].blockCount += 1;
 
-        if (block->allocByApp > statAllocPool[poolIndex].maxBlockSize)
-            statAllocPool[poolIndex].maxBlockSize = block->allocByApp;
+        if (block->allocByApp > pools[poolIndex].maxBlockSize)
+            pools[poolIndex].maxBlockSize = block->allocByApp;
     }
-
     { // Update tag statistics
-        uint32 tags = statGeneral.activeTags;
-        if (tags != 0)
+        uint32 blockTags = block->tags;
+        if (blockTags != 0)
         {
-            for (size_t index = 0; tags != 0; ++index, tags >>= 1)
+            for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
             {
-                if (tags & 0x01)
+                if (blockTags & 0x01)
                 {
-                    statTag[index].allocByApp += block->allocByApp;
-                    statTag[index].blockCount += 1;
+                    tags[index].allocByApp += block->allocByApp;
+                    tags[index].blockCount += 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp += block->allocByApp;
-            statTag[UNTAGGED].blockCount += 1;
+            tags[UNTAGGED].allocByApp += block->allocByApp;
+            tags[UNTAGGED].blockCount += 1;
         }
     }
 }
 
-void MemoryManager::UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage)
+void MemoryManager::SubtractAllocStat(AllocPoolStat* pools, TagAllocStat* tags, const MemoryBlock* block)
 {
-    { // Update memory usage reported by system
-        statAllocPool[ALLOC_POOL_SYSTEM].allocByApp = systemMemoryUsage;
-        statAllocPool[ALLOC_POOL_SYSTEM].allocTotal = systemMemoryUsage;
-    }
     { // Update total statistics
-        statAllocPool[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
-        statAllocPool[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
-        statAllocPool[ALLOC_POOL_TOTAL].blockCount -= 1;
+        pools[ALLOC_POOL_TOTAL].allocByApp -= block->allocByApp;
+        pools[ALLOC_POOL_TOTAL].allocTotal -= block->allocTotal;
+        pools[ALLOC_POOL_TOTAL].blockCount -= 1;
     }
     { // Update pool statistics
         const uint32 poolIndex = block->pool;
-        statAllocPool[poolIndex].allocByApp -= block->allocByApp;
-        statAllocPool[poolIndex].allocTotal -= block->allocTotal;
-        statAllocPool[poolIndex].blockCount -= 1;
+        pools[poolIndex].allocByApp -= block->allocByApp;
+        pools[poolIndex].allocTotal -= block->allocTotal;
+        pools[poolIndex].blockCount -= 1;
     }
     { // Update tag statistics
-        uint32 tags = block->tags;
-        if (tags != 0)
+        uint32 blockTags = block->tags;
+        if (blockTags != 0)
         {
-            for (size_t index = 0; tags != 0; ++index, tags >>= 1)
+            for (size_t index = 0; blockTags != 0; ++index, blockTags >>= 1)
             {
-                if (tags & 0x01)
+                if (blockTags & 0x01)
                 {
-                    statTag[index].allocByApp -= block->allocByApp;
-                    statTag[index].blockCount -= 1;
+                    tags[index].allocByApp -= block->allocByApp;
+                    tags[index].blockCount -= 1;
                 }
             }
         }
         else
         {
-            statTag[UNTAGGED].allocByApp -= block->allocByApp;
-            statTag[UNTAGGED].blockCount -= 1;
+            tags[UNTAGGED].allocByApp -= block->allocByApp;
+            tags[UNTAGGED].blockCount -= 1;
         }
     }
 }
@@ -1012,6 +1376,7 @@ bool MemoryManager::GetMemorySnapshot(uint64 timestamp, File* file, uint32* snap
                 dstBlock.bktraceHash = curBlock->bktraceHash;
                 dstBlock.pool = curBlock->pool;
                 dstBlock.tags = curBlock->tags;
+                dstBlock.estimatedSize = curBlock->estimatedSize;
 
                 curBlock = curBlock->next;
             }
@@ -5,6 +5,7 @@
 
 #if defined(DAVA_MEMORY_PROFILING_ENABLE)
 
+#include <atomic>
 #include <type_traits>
 
 #include "Functional/Function.h"
@@ -18,6 +19,8 @@
 #include "MemoryManager/MemoryManagerTypes.h"
 #include "MemoryManager/InternalAllocator.h"
 
+struct MemoryManagerTest;
+
 namespace DAVA
 {
 class File;
@@ -29,6 +32,8 @@ class BaseObject;
 */
 class MemoryManager final
 {
+    friend MemoryManagerTest;
+
     static const uint32 BLOCK_MARK = 0xBA0BAB;
     static const uint32 INTERNAL_BLOCK_MARK = 0x55AACC11;
     static const uint32 DEAD_BLOCK_MARK = 0xECECECEC;
@@ -39,11 +44,13 @@ public:
     static const uint32 MAX_ALLOC_POOL_COUNT = 32;
     static const uint32 MAX_TAG_COUNT = 32;
     static const uint32 UNTAGGED = MAX_TAG_COUNT - 1;
+    static const uint32 DEFAULT_SAMPLE_INTERVAL = 512 * 1024;
 
     struct MemoryBlock;
     struct InternalMemoryBlock;
     struct Backtrace;
     struct AllocScopeItem;
+    struct ThreadStat;
 
 public:
     class AllocPoolScope final
@@ -70,6 +77,18 @@ public:
     static void RegisterTagName(uint32 tagMask, const char8* name);
 
     void EnableLightWeightMode();
+    /*
+     Enable sampling mode: allocations don't take global locks, statistics are accumulated per thread and merged in Update(),
+     backtraces are collected only for sampled blocks. Blocks are sampled on average once per `sampleInterval` allocated bytes
+     (Poisson sampling), each sampled block gets unbiased estimate of memory it stands for. Memory snapshot contains only sampled blocks.
+     Should be called before any tracked allocation is made from threads other than the calling one.
+    */
+    void EnableSamplingMode(uint32 sampleInterval = DEFAULT_SAMPLE_INTERVAL);
+    /*
+     Merge per thread statistics and return to tracking of every block. Blocks allocated in sampling mode can be freed after that.
+     Should be called when threads other than the calling one don't allocate memory.
+    */
+    void DisableSamplingMode();
     void SetCallbacks(Function<void()> updateCallback, Function<void(uint32, bool)> tagCallback);
     void Update();
     void Finish();
@@ -121,9 +140,23 @@ private:
     friend void InternalDealloc(void* ptr);
 
 private:
+    DAVA_NOINLINE void TrackBlock(MemoryBlock* block);
+    void UntrackBlock(MemoryBlock* block);
+
     void InsertBlock(MemoryBlock* block);
     void RemoveBlock(MemoryBlock* block);
 
+    ThreadStat* GetThreadStat(bool create);
+    ThreadStat* CreateThreadStat();
+    void MergeThreadStats();
+    uint32 GetThreadStatCount() const;
+
+    static bool SampleAllocation(ThreadStat* threadStat, size_t size, uint32 sampleInterval, uint32& estimatedSize);
+    static uint32 NextSampleDistance(ThreadStat* threadStat, uint32 sampleInterval);
+
+    static void AddAllocStat(AllocPoolStat* pools, TagAllocStat* tags, const MemoryBlock* block);
+    static void SubtractAllocStat(AllocPoolStat* pools, TagAllocStat* tags, const MemoryBlock* block);
+
     void UpdateStatAfterAlloc(MemoryBlock* block, uint32 systemMemoryUsage);
     void UpdateStatAfterDealloc(MemoryBlock* block, uint32 systemMemoryUsage);
 
@@ -172,6 +205,11 @@ private:
     Mutex symbolCollectorMutex;
     size_t bktraceGrowDelta = 0;
     bool lightWeightMode = false; // Flag enabling lightweight mode: no backtrace and symbols, should increase performance
+    bool samplingMode = false; // Flag enabling sampling mode: per thread statistics and backtraces only for sampled blocks
+    uint32 sampleInterval = DEFAULT_SAMPLE_INTERVAL; // Mean number of allocated bytes between sampled blocks
+
+    std::atomic<ThreadStat*> threadStatHead{ nullptr }; // List of per thread statistics, items of exited threads are removed by merging
+    std::atomic<uint32> nextBlockNo{ 0 }; // Block order number used in sampling mode
 
     Function<void()> updateCallback;
     Function<void(uint32, bool)> tagCallback;
@@ -185,6 +223,7 @@ private:
     static MMItemName allocPoolNames[MAX_ALLOC_POOL_COUNT]; // Names of allocation pools
 
     ThreadLocalPtr<AllocScopeItem> tlsAllocScopeStack;
+    ThreadLocalPtr<ThreadStat> tlsThreadStat;
 };
 
 //////////////////////////////////////////////////////////////////////////
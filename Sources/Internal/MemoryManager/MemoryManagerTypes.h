@@ -98,7 +98,7 @@ struct MMBlock
     uint32 pool; // Allocation pool block belongs to
     uint32 tags; // Tags block belongs to
     uint32 type;
-    uint32 padding;
+    uint32 estimatedSize; // Estimate of memory represented by block in sampling mode, 0 if block isn't sampled
 };
 static_assert(sizeof(MMBlock) % 16 == 0, "sizeof(MMBlock) % 16 == 0");
 
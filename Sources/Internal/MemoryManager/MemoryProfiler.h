@@ -8,6 +8,7 @@
 #include "MemoryManager.h"
 
 #define DAVA_MEMORY_PROFILER_ENABLE_LIGHTWEIGHT() DAVA::MemoryManager::Instance()->EnableLightWeightMode()
+#define DAVA_MEMORY_PROFILER_ENABLE_SAMPLING(sampleInterval) DAVA::MemoryManager::Instance()->EnableSamplingMode(sampleInterval)
 #define DAVA_MEMORY_PROFILER_UPDATE() DAVA::MemoryManager::Instance()->Update()
 #define DAVA_MEMORY_PROFILER_FINISH() DAVA::MemoryManager::Instance()->Finish()
 
@@ -35,6 +36,7 @@ public:
 #else // defined(DAVA_MEMORY_PROFILING_ENABLE)
 
 #define DAVA_MEMORY_PROFILER_ENABLE_LIGHTWEIGHT()
+#define DAVA_MEMORY_PROFILER_ENABLE_SAMPLING(sampleInterval)
 #define DAVA_MEMORY_PROFILER_UPDATE()
 #define DAVA_MEMORY_PROFILER_FINISH()
 
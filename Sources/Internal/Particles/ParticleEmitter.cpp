@@ -1,4 +1,5 @@
 #include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleEmitterBinaryFormat.h"
 #include "Particles/ParticleLayer.h"
 #include "Utils/StringFormat.h"
 #include "FileSystem/FileSystem.h"
@@ -253,7 +254,7 @@ ParticleEmitter* ParticleEmitter::LoadEmitter(const FilePath& filename)
     if (FORCE_DEEP_CLONE) //resource and ui editor set this flag not to cache emitters
     {
         res = new ParticleEmitter();
-        res->LoadFromYaml(filename);
+        res->LoadFromFile(filename);
         return res;
     }
 
@@ -266,7 +267,7 @@ ParticleEmitter* ParticleEmitter::LoadEmitter(const FilePath& filename)
     else
     {
         res = new ParticleEmitter();
-        if (res->LoadFromYaml(filename))
+        if (res->LoadFromFile(filename))
         {
             List<ModifiablePropertyLineBase*> modifiables;
             res->GetModifableLines(modifiables);
@@ -281,6 +282,19 @@ ParticleEmitter* ParticleEmitter::LoadEmitter(const FilePath& filename)
     return res;
 }
 
+bool ParticleEmitter::LoadFromFile(const FilePath& filename, bool preserveInheritPosition)
+{
+    // Compiled emitter is used if it is requested directly or if yaml config isn't shipped
+    bool isCompiledPath = ParticleEmitterBinaryFormat::IsCompiledEmitterPath(filename);
+    FilePath compiledPath = isCompiledPath ? filename : ParticleEmitterBinaryFormat::GetCompiledEmitterPath(filename);
+    if (isCompiledPath || (!FileSystem::Instance()->Exists(filename) && FileSystem::Instance()->Exists(compiledPath)))
+    {
+        return ParticleEmitterBinaryFormat::Load(this, compiledPath, filename, preserveInheritPosition);
+    }
+
+    return LoadFromYaml(filename, preserveInheritPosition);
+}
+
 bool ParticleEmitter::LoadFromYaml(const FilePath& filename, bool preserveInheritPosition)
 {
     Cleanup(true);
@@ -52,6 +52,11 @@ public:
     ParticleEmitter();
     ParticleEmitter* Clone();
 
+    /**
+        Loads emitter from yaml config or from its compiled form, see ParticleEmitterBinaryFormat.
+        Compiled emitter is used if `pathName` points to it or if yaml config doesn't exist.
+    */
+    bool LoadFromFile(const FilePath& pathName, bool preserveInheritPosition = false);
     bool LoadFromYaml(const FilePath& pathName, bool preserveInheritPosition = false);
     void SaveToYaml(const FilePath& pathName);
 
@@ -0,0 +1,644 @@
+#include "Particles/ParticleEmitterBinaryFormat.h"
+#include "Particles/ParticleEmitter.h"
+#include "Particles/ParticleEmitterInstance.h"
+#include "Particles/ParticleForce.h"
+#include "Particles/ParticleLayer.h"
+
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+
+namespace DAVA
+{
+namespace ParticleEmitterBinaryFormatDetails
+{
+const uint32 MAGIC = 0x43455044; // "DPEC"
+const uint32 VERSION = 1;
+
+enum ePropertyLineTag : uint8
+{
+    LINE_NULL = 0,
+    LINE_VALUE = 1,
+    LINE_KEYFRAMES = 2,
+    LINE_MODIFIABLE = 3
+};
+
+// Keys are copied as is, so they should be tightly packed
+template <class T>
+void CheckKeyLayout()
+{
+    static_assert(sizeof(typename PropertyLine<T>::PropertyKey) == sizeof(float32) + sizeof(T), "PropertyKey should have no padding");
+}
+
+class Writer
+{
+public:
+    template <class T>
+    void Transfer(T& value)
+    {
+        WriteBytes(&value, sizeof(T));
+    }
+
+    void Transfer(bool& value)
+    {
+        uint8 byte = value ? 1 : 0;
+        WriteBytes(&byte, sizeof(byte));
+    }
+
+    void Transfer(String& value)
+    {
+        uint32 length = static_cast<uint32>(value.size());
+        Transfer(length);
+        WriteBytes(value.data(), length);
+    }
+
+    void Transfer(Vector<bool>& values)
+    {
+        uint32 count = static_cast<uint32>(values.size());
+        Transfer(count);
+        for (uint32 i = 0; i < count; ++i)
+        {
+            bool value = values[i];
+            Transfer(value);
+        }
+    }
+
+    template <class T>
+    void Transfer(RefPtr<PropertyLine<T>>& line)
+    {
+        CheckKeyLayout<T>();
+
+        PropertyLine<T>* ptr = line.Get();
+        ModifiablePropertyLine<T>* modifiable = dynamic_cast<ModifiablePropertyLine<T>*>(ptr);
+        if (modifiable != nullptr)
+        {
+            WriteTag(LINE_MODIFIABLE);
+
+            String valueName = modifiable->GetValueName();
+            RefPtr<PropertyLine<T>> valueLine = modifiable->GetValueLine();
+            RefPtr<PropertyLine<T>> modificationLine = modifiable->GetModificationLine();
+            Transfer(valueName);
+            Transfer(valueLine);
+            Transfer(modificationLine);
+        }
+        else if (dynamic_cast<PropertyLineValue<T>*>(ptr) != nullptr)
+        {
+            WriteTag(LINE_VALUE);
+            WriteKeys(ptr->keys);
+        }
+        else if (dynamic_cast<PropertyLineKeyframes<T>*>(ptr) != nullptr)
+        {
+            WriteTag(LINE_KEYFRAMES);
+            WriteKeys(ptr->keys);
+        }
+        else
+        {
+            DVASSERT(ptr == nullptr, "Unknown property line type");
+            WriteTag(LINE_NULL);
+        }
+    }
+
+    Vector<uint8> data;
+
+private:
+    void WriteBytes(const void* bytes, size_t size)
+    {
+        const uint8* ptr = static_cast<const uint8*>(bytes);
+        data.insert(data.end(), ptr, ptr + size);
+    }
+
+    void WriteTag(ePropertyLineTag tag)
+    {
+        uint8 byte = tag;
+        Transfer(byte);
+    }
+
+    template <class Key>
+    void WriteKeys(const Vector<Key>& keys)
+    {
+        uint32 count = static_cast<uint32>(keys.size());
+        Transfer(count);
+        WriteBytes(keys.data(), count * sizeof(Key));
+    }
+};
+
+class Reader
+{
+public:
+    Reader(const Vector<uint8>& data_)
+        : data(data_)
+    {
+    }
+
+    template <class T>
+    void Transfer(T& value)
+    {
+        ReadBytes(&value, sizeof(T));
+    }
+
+    void Transfer(bool& value)
+    {
+        uint8 byte = 0;
+        ReadBytes(&byte, sizeof(byte));
+        value = (byte != 0);
+    }
+
+    void Transfer(String& value)
+    {
+        uint32 length = 0;
+        Transfer(length);
+        if (CanRead(length))
+        {
+            value.assign(reinterpret_cast<const char8*>(data.data() + offset), length);
+            offset += length;
+        }
+    }
+
+    void Transfer(Vector<bool>& values)
+    {
+        uint32 count = 0;
+        Transfer(count);
+        if (CanRead(count))
+        {
+            values.resize(count);
+            for (uint32 i = 0; i < count; ++i)
+            {
+                values[i] = (data[offset + i] != 0);
+            }
+            offset += count;
+        }
+    }
+
+    template <class T>
+    void Transfer(RefPtr<PropertyLine<T>>& line)
+    {
+        CheckKeyLayout<T>();
+
+        line = nullptr;
+
+        uint8 tag = LINE_NULL;
+        Transfer(tag);
+        switch (tag)
+        {
+        case LINE_NULL:
+            break;
+
+        case LINE_MODIFIABLE:
+        {
+            String valueName;
+            RefPtr<PropertyLine<T>> valueLine;
+            RefPtr<PropertyLine<T>> modificationLine;
+            Transfer(valueName);
+            Transfer(valueLine);
+            Transfer(modificationLine);
+
+            RefPtr<ModifiablePropertyLine<T>> modifiable(new ModifiablePropertyLine<T>(valueName));
+            modifiable->SetValueLine(valueLine);
+            modifiable->SetModificationLine(modificationLine);
+            modifiable->SetModifier(0.0f);
+            line = modifiable;
+            break;
+        }
+
+        case LINE_VALUE:
+        {
+            RefPtr<PropertyLineValue<T>> value(new PropertyLineValue<T>(T()));
+            ReadKeys(value->keys);
+            if (value->keys.size() == 1)
+            {
+                line = value;
+            }
+            else
+            {
+                isValid = false;
+            }
+            break;
+        }
+
+        case LINE_KEYFRAMES:
+        {
+            RefPtr<PropertyLineKeyframes<T>> keyframes(new PropertyLineKeyframes<T>());
+            ReadKeys(keyframes->keys);
+            line = keyframes;
+            break;
+        }
+
+        default:
+            isValid = false;
+            break;
+        }
+    }
+
+    bool IsValid() const
+    {
+        return isValid;
+    }
+
+private:
+    bool CanRead(size_t size)
+    {
+        isValid = isValid && (size <= data.size() - offset);
+        return isValid;
+    }
+
+    void ReadBytes(void* bytes, size_t size)
+    {
+        if (CanRead(size))
+        {
+            Memcpy(bytes, data.data() + offset, size);
+            offset += size;
+        }
+    }
+
+    template <class Key>
+    void ReadKeys(Vector<Key>& keys)
+    {
+        uint32 count = 0;
+        Transfer(count);
+        if (CanRead(size_t(count) * sizeof(Key)))
+        {
+            keys.resize(count);
+            ReadBytes(keys.data(), count * sizeof(Key));
+        }
+    }
+
+    const Vector<uint8>& data;
+    size_t offset = 0;
+    bool isValid = true;
+};
+
+template <class Stream>
+void TransferEmitter(Stream& stream, ParticleEmitter* emitter)
+{
+    stream.Transfer(emitter->emitterType);
+    stream.Transfer(emitter->lifeTime);
+    stream.Transfer(emitter->shortEffect);
+
+    stream.Transfer(emitter->size);
+    stream.Transfer(emitter->emissionVector);
+    stream.Transfer(emitter->emissionVelocityVector);
+    stream.Transfer(emitter->emissionRange);
+    stream.Transfer(emitter->radius);
+    stream.Transfer(emitter->innerRadius);
+    stream.Transfer(emitter->emissionAngle);
+    stream.Transfer(emitter->emissionAngleVariation);
+    stream.Transfer(emitter->colorOverLife);
+}
+
+String MakeRelativePath(const FilePath& path, const FilePath& directory)
+{
+    return path.IsEmpty() ? String() : path.GetRelativePathname(directory);
+}
+}
+
+template <class Stream>
+void ParticleEmitterBinaryFormat::TransferLayer(Stream& stream, ParticleLayer* layer)
+{
+    stream.Transfer(layer->layerName);
+    stream.Transfer(layer->type);
+    stream.Transfer(layer->blending);
+    stream.Transfer(layer->degradeStrategy);
+    stream.Transfer(layer->particleOrientation);
+    stream.Transfer(layer->activeLODS);
+    stream.Transfer(layer->layerPivotPoint);
+    stream.Transfer(layer->layerPivotSizeOffsets);
+
+    stream.Transfer(layer->stripeLifetime);
+    stream.Transfer(layer->stripeVertexSpawnStep);
+    stream.Transfer(layer->stripeStartSize);
+    stream.Transfer(layer->stripeUScrollSpeed);
+    stream.Transfer(layer->stripeVScrollSpeed);
+    stream.Transfer(layer->stripeFadeDistanceFromTop);
+    stream.Transfer(layer->stripeSizeOverLife);
+    stream.Transfer(layer->stripeTextureTileOverLife);
+    stream.Transfer(layer->stripeNoiseUScrollSpeedOverLife);
+    stream.Transfer(layer->stripeNoiseVScrollSpeedOverLife);
+    stream.Transfer(layer->stripeColorOverLife);
+
+    stream.Transfer(layer->life);
+    stream.Transfer(layer->lifeVariation);
+    stream.Transfer(layer->flowSpeed);
+    stream.Transfer(layer->flowSpeedVariation);
+    stream.Transfer(layer->flowOffset);
+    stream.Transfer(layer->flowOffsetVariation);
+    stream.Transfer(layer->noiseScale);
+    stream.Transfer(layer->noiseScaleVariation);
+    stream.Transfer(layer->noiseScaleOverLife);
+    stream.Transfer(layer->noiseUScrollSpeed);
+    stream.Transfer(layer->noiseUScrollSpeedVariation);
+    stream.Transfer(layer->noiseUScrollSpeedOverLife);
+    stream.Transfer(layer->noiseVScrollSpeed);
+    stream.Transfer(layer->noiseVScrollSpeedVariation);
+    stream.Transfer(layer->noiseVScrollSpeedOverLife);
+    stream.Transfer(layer->alphaRemapOverLife);
+    stream.Transfer(layer->number);
+    stream.Transfer(layer->numberVariation);
+    stream.Transfer(layer->size);
+    stream.Transfer(layer->sizeVariation);
+    stream.Transfer(layer->sizeOverLifeXY);
+    stream.Transfer(layer->velocity);
+    stream.Transfer(layer->velocityVariation);
+    stream.Transfer(layer->velocityOverLife);
+    stream.Transfer(layer->spin);
+    stream.Transfer(layer->spinVariation);
+    stream.Transfer(layer->spinOverLife);
+    stream.Transfer(layer->colorRandom);
+    stream.Transfer(layer->alphaOverLife);
+    stream.Transfer(layer->colorOverLife);
+    stream.Transfer(layer->gradientColorForWhite);
+    stream.Transfer(layer->gradientColorForBlack);
+    stream.Transfer(layer->gradientColorForMiddle);
+    stream.Transfer(layer->angle);
+    stream.Transfer(layer->angleVariation);
+    stream.Transfer(layer->animSpeedOverLife);
+    stream.Transfer(layer->gradientMiddlePointLine);
+
+    stream.Transfer(layer->deltaTime);
+    stream.Transfer(layer->deltaVariation);
+    stream.Transfer(layer->loopVariation);
+    stream.Transfer(layer->loopEndTime);
+    stream.Transfer(layer->startTime);
+    stream.Transfer(layer->endTime);
+    stream.Transfer(layer->frameOverLifeFPS);
+    stream.Transfer(layer->gradientMiddlePoint);
+    stream.Transfer(layer->scaleVelocityBase);
+    stream.Transfer(layer->scaleVelocityFactor);
+    stream.Transfer(layer->fresnelToAlphaBias);
+    stream.Transfer(layer->fresnelToAlphaPower);
+    stream.Transfer(layer->alphaRemapLoopCount);
+
+    stream.Transfer(layer->isDisabled);
+    stream.Transfer(layer->enableFog);
+    stream.Transfer(layer->randomSpinDirection);
+    stream.Transfer(layer->isLong);
+    stream.Transfer(layer->isLooped);
+    stream.Transfer(layer->loopSpriteAnimation);
+    stream.Transfer(layer->randomFrameOnStart);
+    stream.Transfer(layer->frameOverLifeEnabled);
+    stream.Transfer(layer->enableFrameBlend);
+    stream.Transfer(layer->useFresnelToAlpha);
+    stream.Transfer(layer->enableAlphaRemap);
+    stream.Transfer(layer->enableNoiseScroll);
+    stream.Transfer(layer->enableNoise);
+    stream.Transfer(layer->enableFlow);
+    stream.Transfer(layer->enableFlowAnimation);
+    stream.Transfer(layer->usePerspectiveMapping);
+    stream.Transfer(layer->useThreePointGradient);
+    stream.Transfer(layer->applyGlobalForces);
+    stream.Transfer(layer->inheritPosition);
+    stream.Transfer(layer->stripeInheritPositionOnlyForBaseVertex);
+    stream.Transfer(layer->isLegacyFormat);
+}
+
+template <class Stream>
+void ParticleEmitterBinaryFormat::TransferForce(Stream& stream, ParticleForce* force)
+{
+    stream.Transfer(force->forceName);
+    stream.Transfer(force->type);
+    stream.Transfer(force->timingType);
+    stream.Transfer(force->shape);
+    stream.Transfer(force->forcePowerLine);
+    stream.Transfer(force->turbulenceLine);
+
+    stream.Transfer(force->position);
+    stream.Transfer(force->rotation);
+    stream.Transfer(force->direction);
+    stream.Transfer(force->forcePower);
+    stream.Transfer(force->boxSize);
+    stream.Transfer(force->halfBoxSize);
+    stream.Transfer(force->squaredRadius);
+    stream.Transfer(force->radius);
+
+    stream.Transfer(force->windFrequency);
+    stream.Transfer(force->windTurbulenceFrequency);
+    stream.Transfer(force->windBias);
+    stream.Transfer(force->windTurbulence);
+    stream.Transfer(force->pointGravityRadius);
+    stream.Transfer(force->planeScale);
+    stream.Transfer(force->reflectionChaos);
+    stream.Transfer(force->rndReflectionForceMin);
+    stream.Transfer(force->rndReflectionForceMax);
+    stream.Transfer(force->velocityThreshold);
+    stream.Transfer(force->startTime);
+    stream.Transfer(force->endTime);
+    stream.Transfer(force->backwardTurbulenceProbability);
+    stream.Transfer(force->reflectionPercent);
+
+    stream.Transfer(force->isActive);
+    stream.Transfer(force->isInfinityRange);
+    stream.Transfer(force->pointGravityUseRandomPointsOnSphere);
+    stream.Transfer(force->isGlobal);
+    stream.Transfer(force->killParticles);
+    stream.Transfer(force->normalAsReflectionVector);
+    stream.Transfer(force->randomizeReflectionForce);
+    stream.Transfer(force->worldAlign);
+}
+
+const char* ParticleEmitterBinaryFormat::COMPILED_EMITTER_EXTENSION = ".pec";
+
+FilePath ParticleEmitterBinaryFormat::GetCompiledEmitterPath(const FilePath& yamlPath)
+{
+    return FilePath::CreateWithNewExtension(yamlPath, COMPILED_EMITTER_EXTENSION);
+}
+
+bool ParticleEmitterBinaryFormat::IsCompiledEmitterPath(const FilePath& path)
+{
+    return path.IsEqualToExtension(COMPILED_EMITTER_EXTENSION);
+}
+
+bool ParticleEmitterBinaryFormat::Compile(const FilePath& yamlPath, const FilePath& compiledPath)
+{
+    if (!FileSystem::Instance()->Exists(yamlPath))
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Compile] File %s doesn't exist", yamlPath.GetStringValue().c_str());
+        return false;
+    }
+
+    ScopedPtr<ParticleEmitter> emitter(new ParticleEmitter());
+    if (!emitter->LoadFromYaml(yamlPath, true))
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Compile] Can't load %s", yamlPath.GetStringValue().c_str());
+        return false;
+    }
+
+    return Save(emitter, compiledPath);
+}
+
+bool ParticleEmitterBinaryFormat::Save(ParticleEmitter* emitter, const FilePath& compiledPath)
+{
+    using namespace ParticleEmitterBinaryFormatDetails;
+
+    FilePath directory = compiledPath.GetDirectory();
+
+    Writer writer;
+    uint32 magic = MAGIC;
+    uint32 version = VERSION;
+    writer.Transfer(magic);
+    writer.Transfer(version);
+
+    String name = emitter->name.c_str() ? String(emitter->name.c_str()) : String();
+    writer.Transfer(name);
+    TransferEmitter(writer, emitter);
+
+    uint32 layersCount = static_cast<uint32>(emitter->layers.size());
+    writer.Transfer(layersCount);
+    for (ParticleLayer* layer : emitter->layers)
+    {
+        TransferLayer(writer, layer);
+
+        String spritePath = MakeRelativePath(layer->spritePath, directory);
+        String flowmapPath = MakeRelativePath(layer->flowmapPath, directory);
+        String noisePath = MakeRelativePath(layer->noisePath, directory);
+        String alphaRemapPath = MakeRelativePath(layer->alphaRemapPath, directory);
+        String innerEmitterPath = MakeRelativePath(layer->innerEmitterPath, directory);
+        bool hasInnerEmitter = (layer->innerEmitter != nullptr);
+        writer.Transfer(spritePath);
+        writer.Transfer(flowmapPath);
+        writer.Transfer(noisePath);
+        writer.Transfer(alphaRemapPath);
+        writer.Transfer(innerEmitterPath);
+        writer.Transfer(hasInnerEmitter);
+
+        const Vector<ParticleForceSimplified*>& simplifiedForces = layer->GetSimplifiedParticleForces();
+        uint32 simplifiedForcesCount = static_cast<uint32>(simplifiedForces.size());
+        writer.Transfer(simplifiedForcesCount);
+        for (ParticleForceSimplified* force : simplifiedForces)
+        {
+            writer.Transfer(force->force);
+            writer.Transfer(force->forceOverLife);
+        }
+
+        const Vector<ParticleForce*>& forces = layer->GetParticleForces();
+        uint32 forcesCount = static_cast<uint32>(forces.size());
+        writer.Transfer(forcesCount);
+        for (ParticleForce* force : forces)
+        {
+            TransferForce(writer, force);
+        }
+    }
+
+    ScopedPtr<File> file(File::Create(compiledPath, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Save] Can't create %s", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    uint32 size = static_cast<uint32>(writer.data.size());
+    return file->Write(writer.data.data(), size) == size;
+}
+
+bool ParticleEmitterBinaryFormat::Load(ParticleEmitter* emitter, const FilePath& compiledPath, const FilePath& configPath, bool preserveInheritPosition)
+{
+    using namespace ParticleEmitterBinaryFormatDetails;
+
+    emitter->Cleanup(true);
+
+    Vector<uint8> data;
+    if (!FileSystem::Instance()->ReadFileContents(compiledPath, data))
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Load] Can't read %s", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    Reader reader(data);
+    uint32 magic = 0;
+    uint32 version = 0;
+    reader.Transfer(magic);
+    reader.Transfer(version);
+    if (!reader.IsValid() || magic != MAGIC || version != VERSION)
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Load] Invalid header in %s", compiledPath.GetStringValue().c_str());
+        return false;
+    }
+
+    FilePath directory = compiledPath.GetDirectory();
+    emitter->configPath = configPath;
+
+    String name;
+    reader.Transfer(name);
+    emitter->name = FastName(name.c_str());
+    TransferEmitter(reader, emitter);
+
+    uint32 layersCount = 0;
+    reader.Transfer(layersCount);
+    for (uint32 l = 0; l < layersCount && reader.IsValid(); ++l)
+    {
+        ScopedPtr<ParticleLayer> layer(new ParticleLayer());
+        TransferLayer(reader, layer.get());
+        if (layer->isLegacyFormat)
+        {
+            layer->inheritPosition &= preserveInheritPosition;
+        }
+
+        String spritePath;
+        String flowmapPath;
+        String noisePath;
+        String alphaRemapPath;
+        String innerEmitterPath;
+        bool hasInnerEmitter = false;
+        reader.Transfer(spritePath);
+        reader.Transfer(flowmapPath);
+        reader.Transfer(noisePath);
+        reader.Transfer(alphaRemapPath);
+        reader.Transfer(innerEmitterPath);
+        reader.Transfer(hasInnerEmitter);
+
+        if (!spritePath.empty())
+            layer->SetSprite(directory + spritePath);
+        if (!flowmapPath.empty())
+            layer->SetFlowmap(directory + flowmapPath);
+        if (!noisePath.empty())
+            layer->SetNoise(directory + noisePath);
+        if (!alphaRemapPath.empty())
+            layer->SetAlphaRemap(directory + alphaRemapPath);
+        if (!innerEmitterPath.empty())
+            layer->innerEmitterPath = directory + innerEmitterPath;
+
+        if (hasInnerEmitter && reader.IsValid())
+        {
+            ScopedPtr<ParticleEmitter> innerEmitter(new ParticleEmitter());
+            if (layer->innerEmitterPath == configPath) // prevent recursion
+            {
+                Logger::Error("Attempt to load inner emitter from super emitter's config will cause recursion");
+            }
+            else if (!layer->innerEmitterPath.IsEmpty())
+            {
+                innerEmitter->LoadFromFile(layer->innerEmitterPath, true);
+            }
+            layer->innerEmitter = new ParticleEmitterInstance(nullptr, innerEmitter.get());
+        }
+
+        uint32 simplifiedForcesCount = 0;
+        reader.Transfer(simplifiedForcesCount);
+        for (uint32 f = 0; f < simplifiedForcesCount && reader.IsValid(); ++f)
+        {
+            ScopedPtr<ParticleForceSimplified> force(new ParticleForceSimplified());
+            reader.Transfer(force->force);
+            reader.Transfer(force->forceOverLife);
+            layer->AddSimplifiedForce(force);
+        }
+
+        uint32 forcesCount = 0;
+        reader.Transfer(forcesCount);
+        for (uint32 f = 0; f < forcesCount && reader.IsValid(); ++f)
+        {
+            ScopedPtr<ParticleForce> force(new ParticleForce(layer));
+            TransferForce(reader, force.get());
+            layer->AddForce(force);
+        }
+
+        emitter->AddLayer(layer);
+    }
+
+    if (!reader.IsValid())
+    {
+        Logger::Error("[ParticleEmitterBinaryFormat::Load] Corrupted data in %s", compiledPath.GetStringValue().c_str());
+        emitter->Cleanup(true);
+        return false;
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+class ParticleEmitter;
+class ParticleForce;
+struct ParticleLayer;
+
+/**
+    Compiled binary form of particle emitter yaml config.
+    Stores emitter state as it is after yaml loading: legacy format conversions, emission vector inversion and sprite
+    pivot recalculation are already applied, sprite and inner emitter paths are stored relative to the compiled file.
+    Property lines are stored as contiguous key arrays and are read with one copy per line, the whole file is read
+    into a single buffer, so loading doesn't touch yaml parser and doesn't allocate per key.
+    Compiled emitters are produced offline by `Compile` and have `.pec` extension, yaml config stays the editing source.
+    ParticleEmitter::LoadFromFile uses compiled emitter if it is requested directly or if yaml config with the same
+    name doesn't exist. Files with another version are rejected by `Load`.
+*/
+class ParticleEmitterBinaryFormat final
+{
+public:
+    static const char* COMPILED_EMITTER_EXTENSION;
+
+    /** Returns path of compiled emitter for yaml config path. */
+    static FilePath GetCompiledEmitterPath(const FilePath& yamlPath);
+    static bool IsCompiledEmitterPath(const FilePath& path);
+
+    /** Loads emitter from yaml config and saves it in compiled form. Returns false if config can't be loaded or file can't be written. */
+    static bool Compile(const FilePath& yamlPath, const FilePath& compiledPath);
+
+    /**
+        Saves emitter in compiled form. Emitter loaded from legacy yaml config should be loaded with
+        `preserveInheritPosition` to keep inherit position flags of its layers.
+    */
+    static bool Save(ParticleEmitter* emitter, const FilePath& compiledPath);
+
+    /**
+        Loads emitter from compiled file, `configPath` is assigned to emitter as its config path.
+        Returns false if file can't be read or has wrong format or version.
+    */
+    static bool Load(ParticleEmitter* emitter, const FilePath& compiledPath, const FilePath& configPath, bool preserveInheritPosition = false);
+
+private:
+    template <class Stream>
+    static void TransferLayer(Stream& stream, ParticleLayer* layer);
+    template <class Stream>
+    static void TransferForce(Stream& stream, ParticleForce* force);
+};
+}
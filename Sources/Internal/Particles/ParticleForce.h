@@ -98,6 +98,8 @@ private:
     float32 radius = 1.0f;
     eShape shape = eShape::BOX;
     ParticleLayer* parentLayer = nullptr;
+
+    friend class ParticleEmitterBinaryFormat;
 };
 
 inline void ParticleForce::SetRadius(float32 radius_)
@@ -318,6 +318,7 @@ ParticleLayer* ParticleLayer::Clone()
     dstLayer->enableFrameBlend = enableFrameBlend;
     dstLayer->inheritPosition = inheritPosition;
     dstLayer->stripeInheritPositionOnlyForBaseVertex = stripeInheritPositionOnlyForBaseVertex;
+    dstLayer->isLegacyFormat = isLegacyFormat;
     dstLayer->usePerspectiveMapping = usePerspectiveMapping;
     dstLayer->useThreePointGradient = useThreePointGradient;
     dstLayer->startTime = startTime;
@@ -1007,7 +1008,7 @@ void ParticleLayer::LoadFromYaml(const FilePath& configPath, const YamlNode* nod
             }
             else
             {
-                emitter->LoadFromYaml(this->innerEmitterPath, true);
+                emitter->LoadFromFile(this->innerEmitterPath, true);
             }
         }
         innerEmitter = new ParticleEmitterInstance(nullptr, emitter.get());
@@ -1018,6 +1019,7 @@ void ParticleLayer::LoadFromYaml(const FilePath& configPath, const YamlNode* nod
         UpdateSizeLine(sizeVariation.Get(), true, !isLong);
         UpdateSizeLine(sizeOverLifeXY.Get(), false, !isLong);
         inheritPosition &= preserveInheritPosition;
+        isLegacyFormat = true;
     }
 }
 
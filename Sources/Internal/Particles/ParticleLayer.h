@@ -263,10 +263,13 @@ private:
 
     bool stripeInheritPositionOnlyForBaseVertex = false; // For stripe particles. Move only base vertex when in stripe.
     bool inheritPosition = false; //for super emitter - if true the whole emitter would be moved, otherwise just emission point
+    bool isLegacyFormat = false; // loaded from config with old effect format, inheritPosition depends on preserveInheritPosition
 
     Vector<ParticleForce*> particleForces;
     Vector<ParticleForceSimplified*> forcesSimplified;
 
+    friend class ParticleEmitterBinaryFormat;
+
 public:
     DAVA_VIRTUAL_REFLECTION(ParticleLayer, BaseObject);
 };
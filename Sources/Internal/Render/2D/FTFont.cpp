@@ -1,4 +1,5 @@
 #include "Render/2D/FTFont.h"
+#include "Concurrency/LockGuard.h"
 #include "Debug/DVAssert.h"
 #include "Engine/Engine.h"
 #include "FileSystem/File.h"
@@ -39,9 +40,11 @@ public:
                                    int32 justifyWidth, int32 spaceAddon,
                                    float32 ascendScale, float32 descendScale,
                                    Vector<float32>* charSizes = NULL,
-                                   bool contentScaleIncluded = false);
+                                   bool contentScaleIncluded = false,
+                                   Vector<FTFont::GlyphPlacement>* glyphPlacements = nullptr);
     uint32 GetFontHeight(float32 size, float32 ascendScale, float32 descendScale);
     bool IsCharAvaliable(char16 ch);
+    bool RasterizeGlyph(float32 physicalSize, uint32 glyphIndex, FTFont::GlyphBitmap& result);
 
     // FaceID methods
     FT_Error OpenFace(FT_Library library, FT_Face* ftface) override;
@@ -176,6 +179,22 @@ String FTFont::GetRawHashString()
     return fontPath.GetFrameworkPath() + "_" + Font::GetRawHashString();
 }
 
+Font::StringMetrics FTFont::GetStringGlyphs(float32 size, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, Vector<GlyphPlacement>& glyphs) const
+{
+    glyphs.clear();
+    return internalFont->DrawString(str, nullptr, 0, 0, 0, 0, 0, 0, size, false, offsetX, offsetY, justifyWidth, spaceAddon, ascendScale, descendScale, nullptr, false, &glyphs);
+}
+
+bool FTFont::RasterizeGlyph(float32 physicalSize, uint32 glyphIndex, GlyphBitmap& bitmap) const
+{
+    return internalFont->RasterizeGlyph(physicalSize, glyphIndex, bitmap);
+}
+
+const void* FTFont::GetGlyphCacheKey() const
+{
+    return internalFont;
+}
+
 bool FTFont::IsTextSupportsSoftwareRendering() const
 {
     return true;
@@ -335,7 +354,8 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
                                                int32 justifyWidth, int32 spaceAddon,
                                                float32 ascendScale, float32 descendScale,
                                                Vector<float32>* charSizes,
-                                               bool contentScaleIncluded)
+                                               bool contentScaleIncluded,
+                                               Vector<FTFont::GlyphPlacement>* glyphPlacements)
 {
     if (!initialized)
     {
@@ -458,6 +478,15 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
 
             layoutWidth += advances[i].x;
 
+            if (glyphPlacements != nullptr && glyph.index > 0)
+            {
+                FTFont::GlyphPlacement placement;
+                placement.glyphIndex = glyph.index;
+                placement.x = int32(pen.x) >> ftToPixelShift;
+                placement.baseline = multilineOffsetY - (int32(pen.y) >> ftToPixelShift);
+                glyphPlacements->push_back(placement);
+            }
+
             int32 width = 0;
             int32 height = 0;
             int32 left = 0;
@@ -583,6 +612,54 @@ Font::StringMetrics FTInternalFont::DrawString(const WideString& str, void* buff
     return metrics;
 }
 
+bool FTInternalFont::RasterizeGlyph(float32 physicalSize, uint32 glyphIndex, FTFont::GlyphBitmap& result)
+{
+    if (!initialized || glyphIndex == 0)
+    {
+        return false;
+    }
+
+    LockGuard<Mutex> guard(drawStringMutex);
+
+    FT_Glyph cachedImage = nullptr;
+    FT_Error error = ftm->LookupGlyph(this, physicalSize, glyphIndex, &cachedImage);
+    if (error != FT_Err_Ok || cachedImage == nullptr)
+    {
+        return false;
+    }
+
+    FT_Glyph image = nullptr;
+    error = FT_Glyph_Copy(cachedImage, &image);
+    if (error == 0)
+    {
+        error = FT_Glyph_To_Bitmap(&image, FT_RENDER_MODE_NORMAL, 0, 1);
+    }
+
+    if (error == 0)
+    {
+        FT_BitmapGlyph bit = FT_BitmapGlyph(image);
+        FT_Bitmap* bitmap = &bit->bitmap;
+
+        result.left = bit->left;
+        result.top = bit->top;
+        result.width = int32(bitmap->width);
+        result.height = int32(bitmap->rows);
+        result.data.resize(result.width * result.height);
+
+        for (int32 h = 0; h < result.height; ++h)
+        {
+            const uint8* row = bitmap->buffer + h * bitmap->pitch;
+            Memcpy(result.data.data() + h * result.width, row, result.width);
+        }
+    }
+
+    if (image)
+    {
+        FT_Done_Glyph(image);
+    }
+    return error == 0;
+}
+
 bool FTInternalFont::IsCharAvaliable(char16 ch)
 {
     if (!initialized)
@@ -22,6 +22,30 @@ class FTInternalFont;
 class FTFont : public Font
 {
 public:
+    /**
+        \brief Position of glyph pen in string laid out by `GetStringGlyphs`.
+        `x` and `baseline` are in physical pixels relative to the top left corner of the string buffer.
+    */
+    struct GlyphPlacement
+    {
+        uint32 glyphIndex = 0;
+        int32 x = 0;
+        int32 baseline = 0;
+    };
+
+    /**
+        \brief Rasterized glyph image in A8 format.
+        `left` and `top` are offsets of the image from the glyph pen in physical pixels (`top` is directed up).
+    */
+    struct GlyphBitmap
+    {
+        int32 left = 0;
+        int32 top = 0;
+        int32 width = 0;
+        int32 height = 0;
+        Vector<uint8> data;
+    };
+
     /**
 		\brief Factory method.
 		\param[in] path - path to freetype-supported file (.ttf, .otf)
@@ -82,6 +106,25 @@ public:
 	*/
     virtual StringMetrics DrawStringToBuffer(float32 size, void* buffer, int32 bufWidth, int32 bufHeight, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, bool contentScaleIncluded = false);
 
+    /**
+		\brief Lay out string without drawing it.
+		\param[out] glyphs - pen positions of visible glyphs in physical pixels
+		\returns string metrics, the same as `DrawStringToBuffer` returns for the same arguments
+	*/
+    StringMetrics GetStringGlyphs(float32 size, int32 offsetX, int32 offsetY, int32 justifyWidth, int32 spaceAddon, const WideString& str, Vector<GlyphPlacement>& glyphs) const;
+
+    /**
+		\brief Rasterize single glyph.
+		\param[in] physicalSize - font size in physical pixels
+		\returns false if glyph can't be rasterized
+	*/
+    bool RasterizeGlyph(float32 physicalSize, uint32 glyphIndex, GlyphBitmap& bitmap) const;
+
+    /**
+		\brief Returns key that is the same for all fonts created from the same file.
+	*/
+    const void* GetGlyphCacheKey() const;
+
     bool IsTextSupportsSoftwareRendering() const override;
 
     //We need to return font path
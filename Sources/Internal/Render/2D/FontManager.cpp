@@ -2,6 +2,7 @@
 #include "FileSystem/KeyedArchive.h"
 #include "Render/2D/FontManager.h"
 #include "Render/2D/FTFont.h"
+#include "Render/2D/GlyphAtlas.h"
 #include "Render/2D/GraphicFont.h"
 #include "Render/2D/Private/FTManager.h"
 #include "Logger/Logger.h"
@@ -130,10 +131,21 @@ FontManager::FontManager()
 
 FontManager::~FontManager()
 {
+    // Glyphs are keyed by internal fonts, so atlas is released before them
+    glyphAtlas.reset();
     FTFont::ClearCache();
     UnregisterFontsPresets();
 }
 
+GlyphAtlas* FontManager::GetGlyphAtlas()
+{
+    if (!glyphAtlas)
+    {
+        glyphAtlas = std::make_unique<GlyphAtlas>();
+    }
+    return glyphAtlas.get();
+}
+
 RefPtr<Font> FontManager::LoadFont(const FilePath& fontPath)
 {
     using namespace FontManagerDetails;
@@ -10,6 +10,7 @@ namespace DAVA
 class Font;
 class FTManager;
 class FilePath;
+class GlyphAtlas;
 
 namespace FontManagerDetails
 {
@@ -30,6 +31,11 @@ public:
         return ftmanager.get();
     }
 
+    /**
+     \brief Get atlas with rasterized glyphs of freetype fonts shared by all text blocks.
+     */
+    GlyphAtlas* GetGlyphAtlas();
+
     RefPtr<Font> LoadFont(const FilePath& fontPath);
 
     /**
@@ -83,5 +89,6 @@ private:
     UnorderedMap<String, FontPreset> fontPresetMap;
     UnorderedMap<String, std::unique_ptr<FontManagerDetails::FontConfigDescriptor>> fontConfigs;
     std::unique_ptr<FTManager> ftmanager;
+    std::unique_ptr<GlyphAtlas> glyphAtlas;
 };
 };
@@ -0,0 +1,285 @@
+#include "Render/2D/GlyphAtlas.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FTFont.h"
+#include "Render/RHI/rhi_Public.h"
+#include "Render/Renderer.h"
+#include "Render/Texture.h"
+
+namespace DAVA
+{
+namespace GlyphAtlasDetails
+{
+const int32 GLYPH_MARGIN = 1;
+}
+
+bool GlyphAtlas::GlyphKey::operator==(const GlyphKey& other) const
+{
+    return font == other.font && size == other.size && glyphIndex == other.glyphIndex;
+}
+
+size_t GlyphAtlas::GlyphKeyHash::operator()(const GlyphKey& key) const
+{
+    size_t seed = std::hash<const void*>()(key.font);
+    seed ^= std::hash<float32>()(key.size) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<uint32>()(key.glyphIndex) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+GlyphAtlas::GlyphAtlas(uint32 size_)
+    : size(size_)
+    , pixels(size_ * size_, 0)
+{
+    ResetDirtyRect();
+    Renderer::GetSignals().needRestoreResources.Connect(this, &GlyphAtlas::Restore);
+    Engine::Instance()->endFrame.Connect(this, &GlyphAtlas::ReleaseRetiredTextures);
+}
+
+GlyphAtlas::~GlyphAtlas()
+{
+    Engine::Instance()->endFrame.Disconnect(this);
+    Renderer::GetSignals().needRestoreResources.Disconnect(this);
+    ReleaseRetiredTextures();
+    SafeRelease(texture);
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::GetGlyph(const FTFont* font, float32 physicalSize, uint32 glyphIndex)
+{
+    GlyphKey key;
+    key.font = font->GetGlyphCacheKey();
+    key.size = physicalSize;
+    key.glyphIndex = glyphIndex;
+
+    const Glyph* glyph = FindGlyph(key);
+    if (glyph != nullptr)
+    {
+        return glyph;
+    }
+
+    FTFont::GlyphBitmap bitmap;
+    if (!font->RasterizeGlyph(physicalSize, glyphIndex, bitmap))
+    {
+        return nullptr;
+    }
+
+    return AddGlyph(key, bitmap);
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::FindGlyph(const GlyphKey& key)
+{
+    ++useCounter;
+
+    auto it = glyphs.find(key);
+    if (it != glyphs.end())
+    {
+        it->second.lastUse = useCounter;
+        return &it->second.glyph;
+    }
+    return nullptr;
+}
+
+const GlyphAtlas::Glyph* GlyphAtlas::AddGlyph(const GlyphKey& key, const FTFont::GlyphBitmap& bitmap)
+{
+    GlyphEntry entry;
+    entry.glyph.left = bitmap.left;
+    entry.glyph.top = bitmap.top;
+    entry.glyph.width = bitmap.width;
+    entry.glyph.height = bitmap.height;
+    entry.lastUse = useCounter;
+
+    if (bitmap.width > 0 && bitmap.height > 0)
+    {
+        int32 x = 0;
+        int32 y = 0;
+        if (!Allocate(bitmap.width, bitmap.height, x, y))
+        {
+            EvictLeastRecentlyUsed();
+            if (!Allocate(bitmap.width, bitmap.height, x, y))
+            {
+                return nullptr;
+            }
+        }
+
+        for (int32 h = 0; h < bitmap.height; ++h)
+        {
+            Memcpy(pixels.data() + (y + h) * size + x, bitmap.data.data() + h * bitmap.width, bitmap.width);
+        }
+        SetRegion(entry, x, y);
+
+        dirtyMinX = Min(dirtyMinX, x);
+        dirtyMinY = Min(dirtyMinY, y);
+        dirtyMaxX = Max(dirtyMaxX, x + bitmap.width);
+        dirtyMaxY = Max(dirtyMaxY, y + bitmap.height);
+    }
+
+    return &glyphs.emplace(key, entry).first->second.glyph;
+}
+
+bool GlyphAtlas::Allocate(int32 width, int32 height, int32& x, int32& y)
+{
+    using namespace GlyphAtlasDetails;
+
+    int32 allocWidth = width + GLYPH_MARGIN;
+    int32 allocHeight = height + GLYPH_MARGIN;
+    int32 atlasSize = int32(size);
+
+    Shelf* bestShelf = nullptr;
+    for (Shelf& shelf : shelves)
+    {
+        if (shelf.height >= allocHeight && shelf.x + allocWidth <= atlasSize)
+        {
+            if (bestShelf == nullptr || shelf.height < bestShelf->height)
+            {
+                bestShelf = &shelf;
+            }
+        }
+    }
+
+    if (bestShelf == nullptr)
+    {
+        if (nextShelfY + allocHeight > atlasSize || allocWidth > atlasSize)
+        {
+            return false;
+        }
+
+        Shelf shelf;
+        shelf.y = nextShelfY;
+        shelf.height = allocHeight;
+        nextShelfY += allocHeight;
+        shelves.push_back(shelf);
+        bestShelf = &shelves.back();
+    }
+
+    x = bestShelf->x;
+    y = bestShelf->y;
+    bestShelf->x += allocWidth;
+    usedArea += allocWidth * allocHeight;
+    return true;
+}
+
+void GlyphAtlas::SetRegion(GlyphEntry& entry, int32 x, int32 y)
+{
+    float32 invSize = 1.f / float32(size);
+    entry.x = x;
+    entry.y = y;
+    entry.glyph.u = float32(x) * invSize;
+    entry.glyph.v = float32(y) * invSize;
+    entry.glyph.u2 = float32(x + entry.glyph.width) * invSize;
+    entry.glyph.v2 = float32(y + entry.glyph.height) * invSize;
+}
+
+void GlyphAtlas::EvictLeastRecentlyUsed()
+{
+    using GlyphsMap = UnorderedMap<GlyphKey, GlyphEntry, GlyphKeyHash>;
+
+    Vector<GlyphsMap::value_type*> entries;
+    entries.reserve(glyphs.size());
+    for (GlyphsMap::value_type& item : glyphs)
+    {
+        entries.push_back(&item);
+    }
+    std::sort(entries.begin(), entries.end(), [](const GlyphsMap::value_type* a, const GlyphsMap::value_type* b) {
+        return a->second.lastUse > b->second.lastUse;
+    });
+
+    Vector<uint8> oldPixels(size * size, 0);
+    pixels.swap(oldPixels);
+    shelves.clear();
+    nextShelfY = 0;
+    usedArea = 0;
+
+    // Keep recently used glyphs until half of atlas is filled, so next glyphs don't cause repacking immediately
+    const int32 keepArea = int32(size * size / 2);
+    GlyphsMap keptGlyphs;
+    for (GlyphsMap::value_type* item : entries)
+    {
+        GlyphEntry& entry = item->second;
+        if (entry.glyph.width > 0 && entry.glyph.height > 0)
+        {
+            int32 x = 0;
+            int32 y = 0;
+            if (usedArea >= keepArea || !Allocate(entry.glyph.width, entry.glyph.height, x, y))
+            {
+                continue;
+            }
+
+            for (int32 h = 0; h < entry.glyph.height; ++h)
+            {
+                Memcpy(pixels.data() + (y + h) * size + x, oldPixels.data() + (entry.y + h) * size + entry.x, entry.glyph.width);
+            }
+            SetRegion(entry, x, y);
+        }
+        keptGlyphs.emplace(item->first, entry);
+    }
+    glyphs.swap(keptGlyphs);
+
+    // Batches pushed before repacking still reference old texture, so repacked glyphs go to new texture
+    ResetTexture();
+}
+
+void GlyphAtlas::Clear()
+{
+    glyphs.clear();
+    shelves.clear();
+    nextShelfY = 0;
+    usedArea = 0;
+    std::fill(pixels.begin(), pixels.end(), uint8(0));
+    ResetTexture();
+}
+
+void GlyphAtlas::ResetTexture()
+{
+    // Texture can be used by batches pushed during current frame, so it is released at the end of frame
+    if (texture != nullptr)
+    {
+        retiredTextures.push_back(texture);
+        texture = nullptr;
+    }
+    ResetDirtyRect();
+    ++generation;
+}
+
+void GlyphAtlas::ResetDirtyRect()
+{
+    dirtyMinX = int32(size);
+    dirtyMinY = int32(size);
+    dirtyMaxX = 0;
+    dirtyMaxY = 0;
+}
+
+void GlyphAtlas::ReleaseRetiredTextures()
+{
+    for (Texture* retiredTexture : retiredTextures)
+    {
+        retiredTexture->Release();
+    }
+    retiredTextures.clear();
+}
+
+void GlyphAtlas::Flush()
+{
+    if (texture == nullptr)
+    {
+        if (glyphs.empty())
+        {
+            return;
+        }
+
+        texture = Texture::CreateFromData(FORMAT_A8, pixels.data(), size, size, false);
+        texture->SetWrapMode(rhi::TEXADDR_CLAMP, rhi::TEXADDR_CLAMP);
+        texture->SetMinMagFilter(rhi::TEXFILTER_LINEAR, rhi::TEXFILTER_LINEAR, rhi::TEXMIPFILTER_NONE);
+    }
+    else if (dirtyMaxX > dirtyMinX && dirtyMaxY > dirtyMinY)
+    {
+        rhi::UpdateTextureRegion(texture->handle, pixels.data(), 0, dirtyMinX, dirtyMinY, dirtyMaxX - dirtyMinX, dirtyMaxY - dirtyMinY);
+    }
+    ResetDirtyRect();
+}
+
+void GlyphAtlas::Restore()
+{
+    if (texture != nullptr && rhi::NeedRestoreTexture(texture->handle))
+    {
+        texture->TexImage(0, size, size, pixels.data(), size * size, Texture::INVALID_CUBEMAP_FACE);
+    }
+}
+}
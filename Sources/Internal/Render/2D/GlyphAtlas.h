@@ -0,0 +1,139 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Render/2D/FTFont.h"
+
+struct GlyphAtlasTest;
+
+namespace DAVA
+{
+class Texture;
+
+/**
+    Shared A8 texture with rasterized glyphs of freetype fonts.
+    Glyphs are keyed by (font file, physical size, glyph index) and packed into shelves with one pixel margin.
+    When atlas is full the least recently used glyphs are evicted and the rest are repacked into new texture,
+    in that case generation is increased and all texture coordinates received before become invalid.
+    Previous texture is kept alive until the end of frame, so batches pushed before repacking are drawn correctly.
+    Pixels are kept in memory; only rectangle with glyphs added since last flush is uploaded, whole texture is
+    uploaded only when it is created or after device lost.
+*/
+class GlyphAtlas final
+{
+public:
+    struct Glyph
+    {
+        int32 left = 0;
+        int32 top = 0;
+        int32 width = 0;
+        int32 height = 0;
+        float32 u = 0.f;
+        float32 v = 0.f;
+        float32 u2 = 0.f;
+        float32 v2 = 0.f;
+    };
+
+    static const uint32 DEFAULT_SIZE = 1024;
+
+    GlyphAtlas(uint32 size = DEFAULT_SIZE);
+    ~GlyphAtlas();
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    /** Returns glyph from atlas, rasterizes it on first request. Returns nullptr if glyph can't be rasterized or doesn't fit atlas. */
+    const Glyph* GetGlyph(const FTFont* font, float32 physicalSize, uint32 glyphIndex);
+
+    /** Uploads added glyphs to texture. Must be called before drawing with atlas texture. */
+    void Flush();
+
+    /** Removes all glyphs. */
+    void Clear();
+
+    Texture* GetTexture() const;
+    uint32 GetGeneration() const;
+    uint32 GetGlyphsCount() const;
+    uint32 GetSize() const;
+
+private:
+    struct GlyphKey
+    {
+        const void* font = nullptr;
+        float32 size = 0.f;
+        uint32 glyphIndex = 0;
+
+        bool operator==(const GlyphKey& other) const;
+    };
+
+    struct GlyphKeyHash
+    {
+        size_t operator()(const GlyphKey& key) const;
+    };
+
+    struct GlyphEntry
+    {
+        Glyph glyph;
+        int32 x = 0;
+        int32 y = 0;
+        uint64 lastUse = 0;
+    };
+
+    struct Shelf
+    {
+        int32 y = 0;
+        int32 height = 0;
+        int32 x = 0;
+    };
+
+    /** Marks glyph as used, returns nullptr if it isn't in atlas. */
+    const Glyph* FindGlyph(const GlyphKey& key);
+    /** Packs rasterized glyph, evicts least recently used glyphs if atlas is full. */
+    const Glyph* AddGlyph(const GlyphKey& key, const FTFont::GlyphBitmap& bitmap);
+    bool Allocate(int32 width, int32 height, int32& x, int32& y);
+    void SetRegion(GlyphEntry& entry, int32 x, int32 y);
+    void EvictLeastRecentlyUsed();
+    void ResetTexture();
+    void ResetDirtyRect();
+    void ReleaseRetiredTextures();
+    void Restore();
+
+    uint32 size = DEFAULT_SIZE;
+    Vector<uint8> pixels;
+    Vector<Shelf> shelves;
+    int32 nextShelfY = 0;
+    int32 usedArea = 0;
+
+    UnorderedMap<GlyphKey, GlyphEntry, GlyphKeyHash> glyphs;
+    uint64 useCounter = 0;
+    uint32 generation = 0;
+
+    Texture* texture = nullptr;
+    Vector<Texture*> retiredTextures; //!< textures replaced during current frame
+    int32 dirtyMinX = 0;
+    int32 dirtyMinY = 0;
+    int32 dirtyMaxX = 0;
+    int32 dirtyMaxY = 0;
+
+    friend GlyphAtlasTest;
+};
+
+inline Texture* GlyphAtlas::GetTexture() const
+{
+    return texture;
+}
+
+inline uint32 GlyphAtlas::GetGeneration() const
+{
+    return generation;
+}
+
+inline uint32 GlyphAtlas::GetGlyphsCount() const
+{
+    return static_cast<uint32>(glyphs.size());
+}
+
+inline uint32 GlyphAtlas::GetSize() const
+{
+    return size;
+}
+}
@@ -0,0 +1,164 @@
+#include "Render/2D/Systems/BatchRecord2D.h"
+#include "Debug/DVAssert.h"
+#include "Math/AABBox2.h"
+#include "Render/Material/NMaterial.h"
+
+namespace DAVA
+{
+namespace BatchRecord2DDetails
+{
+bool IsBoundsOverlapped(const Rect& r1, const Rect& r2)
+{
+    // Touching bounds are treated as overlapped because of antialiased edges
+    return r1.x <= r2.x + r2.dx && r2.x <= r1.x + r1.dx && r1.y <= r2.y + r2.dy && r2.y <= r1.y + r1.dy;
+}
+}
+
+BatchRecord2D::BatchRecord2D(bool retainResources_)
+    : retainResources(retainResources_)
+{
+}
+
+BatchRecord2D::~BatchRecord2D()
+{
+    Clear();
+}
+
+void BatchRecord2D::AddBatch(const Batch& batch)
+{
+    batches.push_back(batch);
+    if (retainResources)
+    {
+        Batch& added = batches.back();
+        SafeRetain(added.material);
+        if (added.textureSetHandle.IsValid())
+        {
+            added.textureSetHandle = rhi::CopyTextureSet(added.textureSetHandle);
+        }
+    }
+}
+
+void BatchRecord2D::Clear()
+{
+    if (retainResources)
+    {
+        for (Batch& batch : batches)
+        {
+            SafeRelease(batch.material);
+            if (batch.textureSetHandle.IsValid())
+            {
+                rhi::ReleaseTextureSet(batch.textureSetHandle);
+            }
+        }
+    }
+
+    batches.clear();
+    vertices.clear();
+    texCoords.clear();
+    colors.clear();
+    indices.clear();
+    replayable = true;
+}
+
+Rect BatchRecord2D::CalculateBatchBounds(const Batch& batch) const
+{
+    AABBox2 box;
+    for (uint32 i = 0; i < batch.vertexCount; ++i)
+    {
+        const float32* v = vertices.data() + (batch.vertexOffset + i) * 2;
+        Vector2 point(v[0], v[1]);
+        if (batch.hasWorldMatrix)
+        {
+            Vector3 transformed = Vector3(v[0], v[1], 0.f) * batch.worldMatrix;
+            point = Vector2(transformed.x, transformed.y);
+        }
+        box.AddPoint(point);
+    }
+
+    Rect bounds(box.min, box.max - box.min);
+    if (batch.clip.dx > 0.f && batch.clip.dy > 0.f)
+    {
+        bounds = bounds.Intersection(batch.clip);
+    }
+    return bounds;
+}
+
+bool BatchRecord2D::IsSameBatchState(const Batch& b1, const Batch& b2)
+{
+    return b1.material == b2.material &&
+    b1.textureSetHandle == b2.textureSetHandle &&
+    b1.samplerStateHandle == b2.samplerStateHandle &&
+    b1.primitiveType == b2.primitiveType &&
+    Max(b1.texCoordCount, 1u) == Max(b2.texCoordCount, 1u) &&
+    b1.clip == b2.clip &&
+    b1.hasWorldMatrix == b2.hasWorldMatrix &&
+    (!b1.hasWorldMatrix || b1.worldMatrix == b2.worldMatrix);
+}
+
+uint32 BatchRecord2D::CalculateReorderedDrawOrder(const Vector<Rect>& batchBounds, uint32 maxReorderDistance, Vector<uint32>& order) const
+{
+    DVASSERT(batchBounds.size() == batches.size());
+
+    // Group bounds include all its batches, so later batches can't jump over it incorrectly
+    struct Group
+    {
+        uint32 firstBatch = 0;
+        uint32 lastBatch = 0;
+        Rect bounds;
+    };
+
+    const uint32 batchesCount = static_cast<uint32>(batches.size());
+    Vector<uint32> nextBatch(batchesCount, uint32(-1));
+    Vector<Group> groups;
+    groups.reserve(batchesCount);
+
+    for (uint32 i = 0; i < batchesCount; ++i)
+    {
+        const Rect& bounds = batchBounds[i];
+        Group* targetGroup = nullptr;
+
+        const uint32 groupsCount = static_cast<uint32>(groups.size());
+        const uint32 searchEnd = groupsCount > maxReorderDistance ? groupsCount - maxReorderDistance : 0;
+        for (uint32 g = groupsCount; g > searchEnd; --g)
+        {
+            Group& group = groups[g - 1];
+            if (IsSameBatchState(batches[group.firstBatch], batches[i]))
+            {
+                targetGroup = &group;
+                break;
+            }
+            if (BatchRecord2DDetails::IsBoundsOverlapped(group.bounds, bounds))
+            {
+                break;
+            }
+        }
+
+        if (targetGroup != nullptr)
+        {
+            nextBatch[targetGroup->lastBatch] = i;
+            targetGroup->lastBatch = i;
+            targetGroup->bounds = targetGroup->bounds.Combine(bounds);
+        }
+        else
+        {
+            Group group;
+            group.firstBatch = i;
+            group.lastBatch = i;
+            group.bounds = bounds;
+            groups.push_back(group);
+        }
+    }
+
+    order.clear();
+    order.reserve(batchesCount);
+    for (const Group& group : groups)
+    {
+        for (uint32 i = group.firstBatch; i != uint32(-1); i = nextBatch[i])
+        {
+            order.push_back(i);
+        }
+    }
+
+    return static_cast<uint32>(groups.size());
+}
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Math/Color.h"
+#include "Math/Matrix4.h"
+#include "Math/Rect.h"
+#include "Render/2D/Systems/BatchDescriptor2D.h"
+#include "Render/RHI/rhi_Public.h"
+
+namespace DAVA
+{
+class NMaterial;
+
+/**
+    Retained copy of batches pushed into RenderSystem2D between `BeginBatchRecording` and `EndBatchRecording`.
+    All geometry is copied into the record, so it can be replayed with `RenderSystem2D::ReplayBatchRecord`
+    after the sources (backgrounds, text blocks, etc.) have been changed or destroyed.
+    If `retainResources` is set, record keeps references to materials and texture sets of recorded batches.
+    Texture set reference keeps only set itself, textures of sprites should outlive the record,
+    so owner should clear the record when sprites are changed or released (reloaded textures are replaced in sets by rhi).
+    Record becomes non-replayable if anything except `PushBatch` was used while recording (e.g. `DrawPacket`).
+*/
+struct BatchRecord2D
+{
+    struct Batch
+    {
+        uint32 vertexOffset = 0;
+        uint32 vertexCount = 0;
+        uint32 indexOffset = 0;
+        uint32 indexCount = 0;
+        uint32 colorOffset = 0;
+        uint32 texCoordCount = 0;
+        Array<uint32, BatchDescriptor2D::MAX_TEXTURE_STREAMS_COUNT> texCoordOffset = {};
+        rhi::HTextureSet textureSetHandle;
+        rhi::HSamplerState samplerStateHandle;
+        rhi::PrimitiveType primitiveType = rhi::PRIMITIVE_TRIANGLELIST;
+        NMaterial* material = nullptr;
+        Matrix4 worldMatrix;
+        Color singleColor = Color::White;
+        Rect clip;
+        bool hasWorldMatrix = false;
+        bool hasColors = false;
+    };
+
+    BatchRecord2D() = default;
+    explicit BatchRecord2D(bool retainResources);
+    BatchRecord2D(const BatchRecord2D&) = delete;
+    BatchRecord2D& operator=(const BatchRecord2D&) = delete;
+    ~BatchRecord2D();
+
+    Vector<Batch> batches;
+    Vector<float32> vertices; //!< packed xy pairs
+    Vector<float32> texCoords; //!< packed uv pairs of all streams
+    Vector<uint32> colors;
+    Vector<uint16> indices;
+    bool replayable = true;
+    const bool retainResources = false;
+
+    void AddBatch(const Batch& batch);
+    void Clear();
+    bool IsEmpty() const;
+
+    /** Returns screen bounds of recorded `batch` transformed by its world matrix and clipped by its clip. */
+    Rect CalculateBatchBounds(const Batch& batch) const;
+
+    /** Returns true if batches can be drawn by one packet. */
+    static bool IsSameBatchState(const Batch& b1, const Batch& b2);
+
+    /**
+        Fills `order` with indices of batches grouped by state for drawing with fewer packets and returns
+        count of groups. Batch joins the latest group with the same state only if it doesn't overlap (by `batchBounds`)
+        any group drawn after that one, so overlapping batches keep their relative order and result looks the same.
+        Only `maxReorderDistance` latest groups are searched.
+    */
+    uint32 CalculateReorderedDrawOrder(const Vector<Rect>& batchBounds, uint32 maxReorderDistance, Vector<uint32>& order) const;
+};
+
+inline bool BatchRecord2D::IsEmpty() const
+{
+    return batches.empty();
+}
+}
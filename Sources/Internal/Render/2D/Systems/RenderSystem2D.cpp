@@ -28,6 +28,41 @@ const bool virtualToPhysicalTransformEnabledDefaultValue = true;
 const uint32 MAX_VERTICES = 1024;
 const uint32 MAX_INDECES = MAX_VERTICES * 2;
 const float32 SEGMENT_LENGTH = 15.0f;
+
+// How many packets back deferred batch can be moved, limits reordering cost for long batch sequences
+const uint32 MAX_REORDER_DISTANCE = 32;
+
+BatchDescriptor2D CreateRecordedBatchDescriptor(const BatchRecord2D& record, const BatchRecord2D::Batch& batch, Matrix4& worldMatrix)
+{
+    BatchDescriptor2D desc;
+    desc.vertexCount = batch.vertexCount;
+    desc.indexCount = batch.indexCount;
+    desc.vertexStride = 2;
+    desc.texCoordStride = 2;
+    desc.texCoordCount = batch.texCoordCount;
+    desc.textureSetHandle = batch.textureSetHandle;
+    desc.samplerStateHandle = batch.samplerStateHandle;
+    desc.primitiveType = batch.primitiveType;
+    desc.material = batch.material;
+    desc.singleColor = batch.singleColor;
+    desc.vertexPointer = record.vertices.data() + batch.vertexOffset * 2;
+    desc.indexPointer = record.indices.data() + batch.indexOffset;
+    for (uint32 texStream = 0; texStream < batch.texCoordCount; ++texStream)
+    {
+        desc.texCoordPointer[texStream] = record.texCoords.data() + batch.texCoordOffset[texStream] * 2;
+    }
+    if (batch.hasColors)
+    {
+        desc.colorPointer = record.colors.data() + batch.colorOffset;
+        desc.colorStride = 1;
+    }
+    if (batch.hasWorldMatrix)
+    {
+        worldMatrix = batch.worldMatrix;
+        desc.worldMatrix = &worldMatrix;
+    }
+    return desc;
+}
 }
 
 const FastName RenderSystem2D::RENDER_PASS_NAME("2d");
@@ -203,6 +238,10 @@ void RenderSystem2D::EndFrame()
         rhi::EndRenderPass(pass2DHandle);
     }
 
+    // Batches deferred without valid render pass are never drawn
+    deferredBatches.Clear();
+    deferredBatchBounds.clear();
+
     prevFrameErrorsFlags = currFrameErrorsFlags;
     currFrameErrorsFlags = 0;
 
@@ -247,6 +286,11 @@ void RenderSystem2D::BeginRenderTargetPass(const RenderTargetPassDescriptor& des
 
     Flush();
 
+    if (activeBatchRecord != nullptr)
+    {
+        activeBatchRecord->replayable = false;
+    }
+
     renderPassTargetDescriptor = desc;
 
     UpdateVirtualToPhysicalMatrix(desc.transformVirtualToPhysical);
@@ -493,6 +537,12 @@ void RenderSystem2D::Flush()
     Called on each EndFrame, particle draw, screen transitions preparing, screen borders draw and changing state
     */
 
+    FlushDeferredBatches();
+    FlushPacket();
+}
+
+void RenderSystem2D::FlushPacket()
+{
     if (vertexIndex == 0 && indexIndex == 0)
     {
         return;
@@ -532,6 +582,12 @@ void RenderSystem2D::Flush()
 
 void RenderSystem2D::DrawPacket(rhi::Packet& packet)
 {
+    if (activeBatchRecord != nullptr)
+    {
+        // External packets can't be copied into record
+        activeBatchRecord->replayable = false;
+    }
+
     if (currentClip.dx == 0.f || currentClip.dy == 0.f)
     {
         // Ignore draw if clip has zero width or height
@@ -577,14 +633,32 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
         return;
     }
 
+    if (activeBatchRecord != nullptr)
+    {
+        RecordBatch(*activeBatchRecord, batchDesc);
+    }
+
 #if defined(__DAVAENGINE_RENDERSTATS__)
     ++Renderer::GetRenderStats().batches2d;
 #endif
+
+    if (batchReorderingEnabled)
+    {
+        RecordBatch(deferredBatches, batchDesc);
+        deferredBatchBounds.push_back(deferredBatches.CalculateBatchBounds(deferredBatches.batches.back()));
+        return;
+    }
+
+    PushBatchImmediate(batchDesc);
+}
+
+void RenderSystem2D::PushBatchImmediate(const BatchDescriptor2D& batchDesc)
+{
     uint32 trimmedTexCoordCount = Max(batchDesc.texCoordCount, 1u); //for zero texCoordCount count we just use 1 empty texcoord stream for batching optimization
     if ((vertexIndex + batchDesc.vertexCount > MAX_VERTICES) || (indexIndex + batchDesc.indexCount > MAX_INDECES) || (trimmedTexCoordCount != currentTexcoordStreamCount))
     {
         // Buffer overflow or format changed. Switch to next VBO.
-        Flush();
+        FlushPacket();
         currentTexcoordStreamCount = trimmedTexCoordCount;
         currentPacket.vertexLayoutUID = GetVertexLayoutId(currentTexcoordStreamCount);
 
@@ -628,7 +702,7 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     // Begin new packet
     if (currentPacket.textureSet != batchDesc.textureSetHandle || currentPacket.primitiveType != batchDesc.primitiveType || lastMaterial != batchDesc.material || lastClip != currentClip || needUpdateWorldMatrix)
     {
-        Flush();
+        FlushPacket();
         if (useCustomWorldMatrix)
         {
             Renderer::GetDynamicBindings().SetDynamicParam(DynamicBindings::PARAM_WORLD, &lastCustomWorldMatrix, DynamicBindings::UPDATE_SEMANTIC_ALWAYS);
@@ -757,6 +831,124 @@ void RenderSystem2D::PushBatch(const BatchDescriptor2D& batchDesc)
     vertexIndex += batchDesc.vertexCount;
 }
 
+void RenderSystem2D::BeginBatchRecording(BatchRecord2D* record)
+{
+    DVASSERT(activeBatchRecord == nullptr, "Nested batch recording is not supported");
+    DVASSERT(record != nullptr);
+    activeBatchRecord = record;
+}
+
+void RenderSystem2D::EndBatchRecording()
+{
+    DVASSERT(activeBatchRecord != nullptr);
+    activeBatchRecord = nullptr;
+}
+
+void RenderSystem2D::RecordBatch(BatchRecord2D& record, const BatchDescriptor2D& batchDesc)
+{
+    BatchRecord2D::Batch batch;
+    batch.vertexCount = batchDesc.vertexCount;
+    batch.indexCount = batchDesc.indexCount;
+    batch.texCoordCount = batchDesc.texCoordCount;
+    batch.textureSetHandle = batchDesc.textureSetHandle;
+    batch.samplerStateHandle = batchDesc.samplerStateHandle;
+    batch.primitiveType = batchDesc.primitiveType;
+    batch.material = batchDesc.material;
+    batch.singleColor = batchDesc.singleColor;
+    batch.clip = currentClip;
+    batch.hasWorldMatrix = (batchDesc.worldMatrix != nullptr);
+    if (batch.hasWorldMatrix)
+    {
+        batch.worldMatrix = *batchDesc.worldMatrix;
+    }
+
+    batch.vertexOffset = static_cast<uint32>(record.vertices.size() / 2);
+    record.vertices.reserve(record.vertices.size() + batchDesc.vertexCount * 2);
+    for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+    {
+        record.vertices.push_back(batchDesc.vertexPointer[i * batchDesc.vertexStride]);
+        record.vertices.push_back(batchDesc.vertexPointer[i * batchDesc.vertexStride + 1]);
+    }
+
+    for (uint32 texStream = 0; texStream < batchDesc.texCoordCount; ++texStream)
+    {
+        const float32* texPtr = batchDesc.texCoordPointer[texStream];
+        batch.texCoordOffset[texStream] = static_cast<uint32>(record.texCoords.size() / 2);
+        if (texPtr == nullptr)
+        {
+            // Same behaviour as in PushBatch: stream without data is filled with zero coordinates
+            record.texCoords.resize(record.texCoords.size() + batchDesc.vertexCount * 2, 0.f);
+            continue;
+        }
+        for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+        {
+            record.texCoords.push_back(texPtr[i * batchDesc.texCoordStride]);
+            record.texCoords.push_back(texPtr[i * batchDesc.texCoordStride + 1]);
+        }
+    }
+
+    batch.hasColors = (batchDesc.colorPointer != nullptr);
+    if (batch.hasColors)
+    {
+        batch.colorOffset = static_cast<uint32>(record.colors.size());
+        for (uint32 i = 0; i < batchDesc.vertexCount; ++i)
+        {
+            record.colors.push_back(batchDesc.colorPointer[i * batchDesc.colorStride]);
+        }
+    }
+
+    batch.indexOffset = static_cast<uint32>(record.indices.size());
+    record.indices.insert(record.indices.end(), batchDesc.indexPointer, batchDesc.indexPointer + batchDesc.indexCount);
+
+    record.AddBatch(batch);
+}
+
+void RenderSystem2D::ReplayBatchRecord(const BatchRecord2D& record)
+{
+    DVASSERT(record.replayable, "Batch record can't be replayed");
+
+    Rect savedClip = currentClip;
+    Matrix4 worldMatrix;
+    for (const BatchRecord2D::Batch& batch : record.batches)
+    {
+        currentClip = batch.clip;
+        PushBatch(CreateRecordedBatchDescriptor(record, batch, worldMatrix));
+    }
+    currentClip = savedClip;
+}
+
+void RenderSystem2D::SetBatchReorderingEnabled(bool enabled)
+{
+    if (batchReorderingEnabled != enabled)
+    {
+        FlushDeferredBatches();
+        batchReorderingEnabled = enabled;
+    }
+}
+
+void RenderSystem2D::FlushDeferredBatches()
+{
+    if (deferredBatches.IsEmpty())
+    {
+        return;
+    }
+
+    deferredBatches.CalculateReorderedDrawOrder(deferredBatchBounds, MAX_REORDER_DISTANCE, deferredDrawOrder);
+
+    const Vector<BatchRecord2D::Batch>& batches = deferredBatches.batches;
+    Rect savedClip = currentClip;
+    Matrix4 worldMatrix;
+    for (uint32 i : deferredDrawOrder)
+    {
+        currentClip = batches[i].clip;
+        PushBatchImmediate(CreateRecordedBatchDescriptor(deferredBatches, batches[i], worldMatrix));
+    }
+    currentClip = savedClip;
+
+    deferredBatches.Clear();
+    deferredBatchBounds.clear();
+}
+
 void RenderSystem2D::Draw(Sprite* sprite, SpriteDrawState* drawState, const Color& color)
 {
     if (!Renderer::GetOptions()->IsOptionEnabled(RenderOptions::SPRITE_DRAW))
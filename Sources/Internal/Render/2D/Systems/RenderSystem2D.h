@@ -5,6 +5,7 @@
 #include "Functional/Function.h"
 #include "Render/2D/Sprite.h"
 #include "Render/2D/Systems/BatchDescriptor2D.h"
+#include "Render/2D/Systems/BatchRecord2D.h"
 #include "Render/RenderBase.h"
 
 namespace DAVA
@@ -181,6 +182,29 @@ public:
      *  it will also modify packet to add current clip
      */
     void DrawPacket(rhi::Packet& packet);
+
+    /**
+     * Start copying all batches pushed via PushBatch into `record` (batches are still drawn as usual).
+     * Nested recordings are not supported.
+     */
+    void BeginBatchRecording(BatchRecord2D* record);
+    void EndBatchRecording();
+    bool IsBatchRecording() const;
+
+    /**
+     * Push all batches from `record` again with the clip they were recorded with.
+     * Current clip is restored after replay.
+     */
+    void ReplayBatchRecord(const BatchRecord2D& record);
+
+    /**
+     * Enable deferred mode in which batches pushed via PushBatch are collected until Flush and reordered
+     * to group batches with the same material, textures, clip and world matrix into one packet.
+     * Batch is moved only over batches whose screen bounds don't intersect its bounds,
+     * so overlapping draws keep submission order. Disabled by default.
+     */
+    void SetBatchReorderingEnabled(bool enabled);
+    bool IsBatchReorderingEnabled() const;
     /*!
      * Highlight controls which has vertices count bigger than verticesCount.
      * Work only with RenderOptions::HIGHLIGHT_BIG_CONTROLS option enabled.
@@ -198,6 +222,7 @@ public:
 
     void PushClip();
     void PopClip();
+    const Rect& GetClip() const;
 
     void ScreenSizeChanged();
 
@@ -317,6 +342,10 @@ private:
     void Setup2DMatrices();
 
     void AddPacket(rhi::Packet& packet);
+    void PushBatchImmediate(const BatchDescriptor2D& batchDesc);
+    void RecordBatch(BatchRecord2D& record, const BatchDescriptor2D& batchDesc);
+    void FlushDeferredBatches();
+    void FlushPacket();
 
     Rect TransformClipRect(const Rect& rect, const Matrix4& transformMatrix);
 
@@ -392,8 +421,30 @@ private:
 
     RenderTargetPassDescriptor mainTargetDescriptor;
     RenderTargetPassDescriptor renderPassTargetDescriptor;
+
+    BatchRecord2D* activeBatchRecord = nullptr;
+
+    BatchRecord2D deferredBatches;
+    Vector<Rect> deferredBatchBounds;
+    Vector<uint32> deferredDrawOrder;
+    bool batchReorderingEnabled = false;
 };
 
+inline bool RenderSystem2D::IsBatchRecording() const
+{
+    return activeBatchRecord != nullptr;
+}
+
+inline bool RenderSystem2D::IsBatchReorderingEnabled() const
+{
+    return batchReorderingEnabled;
+}
+
+inline const Rect& RenderSystem2D::GetClip() const
+{
+    return currentClip;
+}
+
 inline void RenderSystem2D::SetHightlightControlsVerticesLimit(uint32 verticesCount)
 {
     highlightControlsVerticesLimit = verticesCount;
@@ -4,6 +4,7 @@
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
 #include "Render/2D/TextLayout.h"
 #include "Concurrency/LockGuard.h"
 #include "Utils/TextBox.h"
@@ -26,6 +27,7 @@ static const Vector2 INVALID_VECTOR = Vector2(-1.0f, -1.0f);
 }
 
 bool TextBlock::isBiDiSupportEnabled = false;
+bool TextBlock::isGlyphAtlasEnabled = false;
 Set<TextBlock*> TextBlock::registredTextBlocks;
 Mutex TextBlock::textblockListMutex;
 
@@ -65,6 +67,16 @@ void TextBlock::SetBiDiSupportEnabled(bool value)
     }
 }
 
+void TextBlock::SetGlyphAtlasEnabled(bool value)
+{
+    isGlyphAtlasEnabled = value;
+}
+
+bool TextBlock::IsGlyphAtlasEnabled()
+{
+    return isGlyphAtlasEnabled;
+}
+
 TextBlock* TextBlock::Create(const Vector2& size)
 {
     TextBlock* textSprite = new TextBlock();
@@ -87,6 +99,7 @@ TextBlock::TextBlock()
     , needCalculateCacheParams(false)
     , forceBiDiSupport(false)
     , needMeasureLines(false)
+    , glyphAtlasUsed(false)
     , textBox(new TextBox())
     , angle(0.f)
 {
@@ -140,6 +153,7 @@ TextBlock::TextBlock(const TextBlock& src)
     , needCalculateCacheParams(src.needCalculateCacheParams)
     , forceBiDiSupport(src.forceBiDiSupport)
     , needMeasureLines(src.needMeasureLines)
+    , glyphAtlasUsed(false)
     , textBlockRender(nullptr)
     , textBox(new TextBox(*src.textBox))
     , angle(src.angle)
@@ -170,10 +184,19 @@ void TextBlock::SetFontInternal(Font* _font)
     font = SafeRetain(_font);
 
     SafeRelease(textBlockRender);
+    glyphAtlasUsed = false;
     switch (font->GetFontType())
     {
     case Font::TYPE_FT:
-        textBlockRender = new TextBlockSoftwareRender(this);
+        if (isGlyphAtlasEnabled)
+        {
+            textBlockRender = new TextBlockGlyphAtlasRender(this);
+            glyphAtlasUsed = true;
+        }
+        else
+        {
+            textBlockRender = new TextBlockSoftwareRender(this);
+        }
         break;
     case Font::TYPE_GRAPHIC:
     case Font::TYPE_DISTANCE:
@@ -1083,6 +1106,7 @@ void TextBlock::CopyDataFrom(TextBlock* block)
             SafeRelease(textBlockRender);
 
             font = SafeRetain(block->font);
+            glyphAtlasUsed = block->glyphAtlasUsed;
             textBlockRender = block->textBlockRender->Clone();
             textBlockRender->SetTextBlock(this);
         }
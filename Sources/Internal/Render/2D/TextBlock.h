@@ -51,6 +51,13 @@ public:
     */
     static bool IsBiDiSupportEnabled();
 
+    /**
+    * \brief Sets drawing of freetype fonts with quads from shared glyph atlas instead of per text block textures.
+    * Takes effect for fonts set after the call.
+    */
+    static void SetGlyphAtlasEnabled(bool value);
+    static bool IsGlyphAtlasEnabled();
+
     static TextBlock* Create(const Vector2& size);
 
     virtual void SetFont(Font* font);
@@ -92,6 +99,8 @@ public:
 
     Sprite* GetSprite();
     bool IsSpriteReady();
+    /** Returns true if text is drawn with quads from shared glyph atlas, scale and rotation are applied by text block itself in that case. */
+    bool IsGlyphAtlasUsed() const;
     const Vector2& GetSpriteOffset();
 
     const Vector2& GetTextSize();
@@ -196,14 +205,17 @@ private:
     bool needCalculateCacheParams : 1;
     bool forceBiDiSupport : 1;
     bool needMeasureLines : 1;
+    bool glyphAtlasUsed : 1;
 
     static bool isBiDiSupportEnabled; //!< true if BiDi transformation support enabled
+    static bool isGlyphAtlasEnabled; //!< true if freetype fonts are drawn from shared glyph atlas
     static Set<TextBlock*> registredTextBlocks;
     static Mutex textblockListMutex;
 
     friend class TextBlockRender;
     friend class TextBlockSoftwareRender;
     friend class TextBlockGraphicRender;
+    friend class TextBlockGlyphAtlasRender;
 
     TextBlockRender* textBlockRender = nullptr;
     TextBox* textBox = nullptr;
@@ -269,6 +281,11 @@ inline bool TextBlock::IsSpriteReady()
     return (GetSprite() != nullptr);
 }
 
+inline bool TextBlock::IsGlyphAtlasUsed() const
+{
+    return glyphAtlasUsed;
+}
+
 inline bool TextBlock::IsBiDiSupportEnabled()
 {
     return isBiDiSupportEnabled;
@@ -0,0 +1,164 @@
+#include "Render/2D/TextBlockGlyphAtlasRender.h"
+#include "Engine/Engine.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/GlyphAtlas.h"
+#include "Render/2D/TextBlockGraphicRender.h"
+#include "Render/2D/Systems/RenderSystem2D.h"
+#include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "UI/UIControlSystem.h"
+
+namespace DAVA
+{
+TextBlockGlyphAtlasRender::TextBlockGlyphAtlasRender(TextBlock* textBlock)
+    : TextBlockRender(textBlock)
+    , ftFont(static_cast<FTFont*>(textBlock->GetFont()))
+{
+}
+
+TextBlockGlyphAtlasRender::~TextBlockGlyphAtlasRender() = default;
+
+TextBlockRender* TextBlockGlyphAtlasRender::Clone()
+{
+    TextBlockGlyphAtlasRender* result = new TextBlockGlyphAtlasRender(textBlock);
+    result->glyphs = glyphs;
+    result->vertexBuffer = vertexBuffer;
+    result->renderRect = renderRect;
+    result->builtGeneration = builtGeneration;
+    return result;
+}
+
+void TextBlockGlyphAtlasRender::Prepare()
+{
+    glyphs.clear();
+    renderRect = Rect(0, 0, 0, 0);
+    DrawText();
+    BuildVertices();
+}
+
+void TextBlockGlyphAtlasRender::BuildVertices()
+{
+    GlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+    VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+    float32 physicalSize = vcs->ConvertVirtualToPhysicalY(textBlock->renderSize);
+
+    // Atlas can be repacked while glyphs of this text are added, in that case coordinates of added glyphs are requested again
+    const uint32 maxAttempts = 2;
+    for (uint32 attempt = 0; attempt < maxAttempts; ++attempt)
+    {
+        uint32 generation = atlas->GetGeneration();
+        vertexBuffer.clear();
+        vertexBuffer.reserve(glyphs.size() * 4);
+
+        for (const FTFont::GlyphPlacement& placement : glyphs)
+        {
+            const GlyphAtlas::Glyph* glyph = atlas->GetGlyph(ftFont, physicalSize, placement.glyphIndex);
+            if (glyph == nullptr || glyph->width == 0 || glyph->height == 0)
+            {
+                continue;
+            }
+
+            int32 left = placement.x + glyph->left;
+            int32 top = placement.baseline - glyph->top;
+            float32 x1 = vcs->ConvertPhysicalToVirtualX(float32(left));
+            float32 y1 = vcs->ConvertPhysicalToVirtualY(float32(top));
+            float32 x2 = vcs->ConvertPhysicalToVirtualX(float32(left + glyph->width));
+            float32 y2 = vcs->ConvertPhysicalToVirtualY(float32(top + glyph->height));
+
+            GraphicFont::GraphicFontVertex vertex;
+            vertex.position = Vector3(x1, y1, 0.f);
+            vertex.texCoord = Vector2(glyph->u, glyph->v);
+            vertexBuffer.push_back(vertex);
+
+            vertex.position = Vector3(x2, y1, 0.f);
+            vertex.texCoord = Vector2(glyph->u2, glyph->v);
+            vertexBuffer.push_back(vertex);
+
+            vertex.position = Vector3(x2, y2, 0.f);
+            vertex.texCoord = Vector2(glyph->u2, glyph->v2);
+            vertexBuffer.push_back(vertex);
+
+            vertex.position = Vector3(x1, y2, 0.f);
+            vertex.texCoord = Vector2(glyph->u, glyph->v2);
+            vertexBuffer.push_back(vertex);
+        }
+
+        if (generation == atlas->GetGeneration())
+        {
+            break;
+        }
+    }
+
+    builtGeneration = atlas->GetGeneration();
+}
+
+void TextBlockGlyphAtlasRender::Draw(const Color& textColor, const Vector2* offset)
+{
+    if (glyphs.empty())
+        return;
+
+    GlyphAtlas* atlas = GetEngineContext()->fontManager->GetGlyphAtlas();
+    if (builtGeneration != atlas->GetGeneration())
+    {
+        BuildVertices();
+    }
+    atlas->Flush();
+
+    Texture* texture = atlas->GetTexture();
+    if (vertexBuffer.empty() || texture == nullptr)
+        return;
+
+    Matrix4 offsetMatrix = CalculateDrawMatrix(renderRect, offset);
+
+    // Shared index buffer has fixed capacity, so very long text is clamped to it
+    uint32 maxVertexCount = TextBlockGraphicRender::GetSharedIndexBufferCapacity() / 6 * 4;
+
+    BatchDescriptor2D batch;
+    batch.material = RenderSystem2D::DEFAULT_2D_TEXTURE_ALPHA8_MATERIAL;
+    batch.singleColor = textColor;
+    batch.vertexStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+    batch.texCoordStride = TextBlockGraphicRender::TextVerticesDefaultStride;
+    batch.vertexPointer = vertexBuffer[0].position.data;
+    batch.texCoordPointer[0] = vertexBuffer[0].texCoord.data;
+    batch.textureSetHandle = texture->singleTextureSet;
+    batch.samplerStateHandle = texture->samplerStateHandle;
+    batch.vertexCount = Min(static_cast<uint32>(vertexBuffer.size()), maxVertexCount);
+    batch.indexPointer = TextBlockGraphicRender::GetSharedIndexBuffer();
+    batch.indexCount = batch.vertexCount * 6 / 4;
+    batch.worldMatrix = &offsetMatrix;
+    RenderSystem2D::Instance()->PushBatch(batch);
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w)
+{
+    return InternalDrawText(drawText, 0, 0, 0, 0);
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::DrawTextML(const WideString& drawText,
+                                                          int32 x, int32 y, int32 w,
+                                                          int32 xOffset, uint32 yOffset,
+                                                          int32 lineSize)
+{
+    if (textBlock->cacheUseJustify)
+    {
+        VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+        return InternalDrawText(drawText, xOffset, yOffset,
+                                int32(std::ceil(vcs->ConvertVirtualToPhysicalX(float32(w)))),
+                                int32(std::ceil(vcs->ConvertVirtualToPhysicalY(float32(lineSize)))));
+    }
+    return InternalDrawText(drawText, xOffset, yOffset, 0, 0);
+}
+
+Font::StringMetrics TextBlockGlyphAtlasRender::InternalDrawText(const WideString& drawText, int32 x, int32 y, int32 w, int32 lineSize)
+{
+    if (drawText.empty())
+        return Font::StringMetrics();
+
+    Font::StringMetrics metrics = ftFont->GetStringGlyphs(textBlock->renderSize, x, y, w, lineSize, drawText, lineGlyphs);
+    if (metrics.drawRect.dx <= 0 && metrics.drawRect.dy <= 0)
+        return metrics;
+
+    glyphs.insert(glyphs.end(), lineGlyphs.begin(), lineGlyphs.end());
+    renderRect = renderRect.Combine(Rect(float32(metrics.drawRect.x), float32(metrics.drawRect.y), float32(metrics.drawRect.dx), float32(metrics.drawRect.dy)));
+    return metrics;
+}
+}
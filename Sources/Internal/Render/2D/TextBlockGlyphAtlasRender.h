@@ -0,0 +1,46 @@
+#pragma once
+
+#include "Render/2D/TextBlockRender.h"
+#include "Render/2D/FTFont.h"
+#include "Render/2D/GraphicFont.h"
+
+namespace DAVA
+{
+/**
+    Draws freetype font text with quads that reference glyphs in shared GlyphAtlas.
+    Text block keeps only glyph positions and vertices, so no texture is created per text block
+    and all text with the same atlas texture is batched by RenderSystem2D.
+*/
+class TextBlockGlyphAtlasRender : public TextBlockRender
+{
+public:
+    TextBlockGlyphAtlasRender(TextBlock*);
+    ~TextBlockGlyphAtlasRender();
+
+    TextBlockRender* Clone() override;
+
+    void Prepare() override;
+    void Draw(const Color& textColor, const Vector2* offset) override;
+
+protected:
+    Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) override;
+    Font::StringMetrics DrawTextML(const WideString& drawText,
+                                   int32 x, int32 y, int32 w,
+                                   int32 xOffset, uint32 yOffset,
+                                   int32 lineSize) override;
+
+private:
+    Font::StringMetrics InternalDrawText(const WideString& drawText, int32 x, int32 y, int32 w, int32 lineSize);
+    void BuildVertices();
+
+private:
+    static const uint32 INVALID_GENERATION = 0xFFFFFFFF;
+
+    FTFont* ftFont = nullptr;
+    Vector<FTFont::GlyphPlacement> glyphs;
+    Vector<FTFont::GlyphPlacement> lineGlyphs;
+    Vector<GraphicFont::GraphicFontVertex> vertexBuffer;
+    Rect renderRect;
+    uint32 builtGeneration = INVALID_GENERATION;
+};
+}
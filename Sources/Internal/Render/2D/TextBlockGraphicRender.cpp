@@ -94,50 +94,7 @@ void TextBlockGraphicRender::Draw(const Color& textColor, const Vector2* offset)
     if (charDrawed == 0)
         return;
 
-    int32 xOffset = 0; // (int32)(textBlock->position.x);
-    int32 yOffset = 0; // (int32)(textBlock->position.y);
-
-    if (offset)
-    {
-        xOffset += int32(offset->x);
-        yOffset += int32(offset->y);
-    }
-
-    int32 align = textBlock->GetVisualAlign();
-    if (align & ALIGN_RIGHT)
-    {
-        xOffset += int32(textBlock->rectSize.dx - renderRect.dx);
-    }
-    else if ((align & ALIGN_HCENTER) || (align & ALIGN_HJUSTIFY))
-    {
-        xOffset += int32((textBlock->rectSize.dx - renderRect.dx) * 0.5f);
-    }
-
-    if (align & ALIGN_BOTTOM)
-    {
-        yOffset += int32(textBlock->rectSize.dy - renderRect.dy);
-    }
-    else if ((align & ALIGN_VCENTER) || (align & ALIGN_HJUSTIFY))
-    {
-        yOffset += int32((textBlock->rectSize.dy - renderRect.dy) * 0.5f);
-    }
-
-    //NOTE: correct affine transformations
-    Matrix4 offsetMatrix;
-    offsetMatrix.BuildTranslation(Vector3(float32(xOffset) - textBlock->pivot.x, float32(yOffset) - textBlock->pivot.y, 0.f));
-
-    Matrix4 rotateMatrix;
-    rotateMatrix.BuildRotation(Vector3(0.f, 0.f, 1.f), -textBlock->angle);
-
-    Matrix4 scaleMatrix;
-    //recalculate x scale - for non-uniform scale
-    const float difX = 1.0f - (textBlock->scale.dy - textBlock->scale.dx);
-    scaleMatrix.BuildScale(Vector3(difX, 1.f, 1.0f));
-
-    Matrix4 worldMatrix;
-    worldMatrix.BuildTranslation(Vector3(textBlock->position.x, textBlock->position.y, 0.f));
-
-    offsetMatrix = (scaleMatrix * offsetMatrix * rotateMatrix) * worldMatrix;
+    Matrix4 offsetMatrix = CalculateDrawMatrix(renderRect, offset);
 
     if (graphicFont->GetFontType() == Font::TYPE_DISTANCE)
     {
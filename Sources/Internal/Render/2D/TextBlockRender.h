@@ -32,6 +32,8 @@ public:
 
 protected:
     void DrawText();
+    /** Returns world matrix for text with bounds `renderRect` aligned in text block rect. */
+    Matrix4 CalculateDrawMatrix(const Rect& renderRect, const Vector2* offset) const;
     virtual Font::StringMetrics DrawTextSL(const WideString& drawText, int32 x, int32 y, int32 w) = 0;
     virtual Font::StringMetrics DrawTextML(const WideString& drawText,
                                            int32 x, int32 y, int32 w,
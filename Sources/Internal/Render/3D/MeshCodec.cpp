@@ -0,0 +1,380 @@
+#include "Render/3D/MeshCodec.h"
+#include "Compression/LZ4Compressor.h"
+#include "Math/MathHelpers.h"
+#include "Math/Vector.h"
+#include "Render/RenderBase.h"
+
+namespace DAVA
+{
+namespace MeshCodec
+{
+namespace MeshCodecDetails
+{
+const uint32 LAST_FORMAT_BIT = EVF_CUBETEXCOORD3;
+const float32 QUANTIZED_MAX = 65535.f;
+const float32 SNORM16_MAX = 32767.f;
+
+template <class T>
+void Write(Vector<uint8>& out, const T& value)
+{
+    const uint8* bytes = reinterpret_cast<const uint8*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+class Reader
+{
+public:
+    Reader(const Vector<uint8>& data_)
+        : data(data_)
+    {
+    }
+
+    template <class T>
+    bool Read(T& value)
+    {
+        if (position + sizeof(T) > data.size())
+            return false;
+
+        Memcpy(&value, data.data() + position, sizeof(T));
+        position += sizeof(T);
+        return true;
+    }
+
+    const uint8* Take(size_t size)
+    {
+        if (position + size > data.size())
+            return nullptr;
+
+        const uint8* result = data.data() + position;
+        position += size;
+        return result;
+    }
+
+private:
+    const Vector<uint8>& data;
+    size_t position = 0;
+};
+
+/*
+ * Values are delta coded with zigzag mapping, so small differences of both signs have zero high byte,
+ * then low and high bytes are written in separate planes for better compression.
+ */
+void WriteDeltaPlanes(const Vector<uint16>& values, Vector<uint8>& out)
+{
+    size_t count = values.size();
+    size_t base = out.size();
+    out.resize(base + 2 * count);
+
+    uint16 previous = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        int16 delta = static_cast<int16>(values[i] - previous);
+        uint16 zigzag = static_cast<uint16>((delta << 1) ^ (delta >> 15));
+        out[base + i] = static_cast<uint8>(zigzag & 0xFF);
+        out[base + count + i] = static_cast<uint8>(zigzag >> 8);
+        previous = values[i];
+    }
+}
+
+bool ReadDeltaPlanes(Reader& reader, uint32 count, Vector<uint16>& values)
+{
+    const uint8* planes = reader.Take(2 * count);
+    if (planes == nullptr)
+        return false;
+
+    values.resize(count);
+    uint16 previous = 0;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        uint16 zigzag = static_cast<uint16>(planes[i] | (planes[count + i] << 8));
+        int16 delta = static_cast<int16>((zigzag >> 1) ^ (~(zigzag & 1) + 1));
+        previous = static_cast<uint16>(previous + delta);
+        values[i] = previous;
+    }
+    return true;
+}
+
+void EncodeRanges(const uint8* vertices, uint32 vertexCount, uint32 stride, uint32 offset, uint32 components, Vector<uint8>& out)
+{
+    Vector<uint16> quantized(vertexCount);
+    for (uint32 c = 0; c < components; ++c)
+    {
+        const uint8* base = vertices + offset + c * sizeof(float32);
+
+        float32 minValue = std::numeric_limits<float32>::max();
+        float32 maxValue = -std::numeric_limits<float32>::max();
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            float32 value = *reinterpret_cast<const float32*>(base + v * stride);
+            minValue = Min(minValue, value);
+            maxValue = Max(maxValue, value);
+        }
+        Write(out, minValue);
+        Write(out, maxValue);
+
+        float32 scale = (maxValue > minValue) ? QUANTIZED_MAX / (maxValue - minValue) : 0.f;
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            float32 value = *reinterpret_cast<const float32*>(base + v * stride);
+            quantized[v] = static_cast<uint16>(Clamp(std::round((value - minValue) * scale), 0.f, QUANTIZED_MAX));
+        }
+        WriteDeltaPlanes(quantized, out);
+    }
+}
+
+bool DecodeRanges(Reader& reader, uint32 vertexCount, uint32 stride, uint32 offset, uint32 components, uint8* vertices)
+{
+    Vector<uint16> quantized;
+    for (uint32 c = 0; c < components; ++c)
+    {
+        float32 minValue = 0.f;
+        float32 maxValue = 0.f;
+        if (!reader.Read(minValue) || !reader.Read(maxValue) || !ReadDeltaPlanes(reader, vertexCount, quantized))
+            return false;
+
+        float32 scale = (maxValue - minValue) / QUANTIZED_MAX;
+        uint8* base = vertices + offset + c * sizeof(float32);
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            *reinterpret_cast<float32*>(base + v * stride) = minValue + float32(quantized[v]) * scale;
+        }
+    }
+    return true;
+}
+
+float32 SignNotZero(float32 value)
+{
+    return (value >= 0.f) ? 1.f : -1.f;
+}
+
+void EncodeDirections(const uint8* vertices, uint32 vertexCount, uint32 stride, uint32 offset, Vector<uint8>& out)
+{
+    Vector<uint16> octX(vertexCount);
+    Vector<uint16> octY(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        Vector3 n = *reinterpret_cast<const Vector3*>(vertices + offset + v * stride);
+        float32 sum = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        float32 x = (sum > 0.f) ? n.x / sum : 0.f;
+        float32 y = (sum > 0.f) ? n.y / sum : 0.f;
+        if (n.z < 0.f)
+        {
+            float32 foldedX = (1.f - std::abs(y)) * SignNotZero(x);
+            float32 foldedY = (1.f - std::abs(x)) * SignNotZero(y);
+            x = foldedX;
+            y = foldedY;
+        }
+        octX[v] = static_cast<uint16>(static_cast<int16>(std::round(Clamp(x, -1.f, 1.f) * SNORM16_MAX)));
+        octY[v] = static_cast<uint16>(static_cast<int16>(std::round(Clamp(y, -1.f, 1.f) * SNORM16_MAX)));
+    }
+    WriteDeltaPlanes(octX, out);
+    WriteDeltaPlanes(octY, out);
+}
+
+bool DecodeDirections(Reader& reader, uint32 vertexCount, uint32 stride, uint32 offset, uint8* vertices)
+{
+    Vector<uint16> octX;
+    Vector<uint16> octY;
+    if (!ReadDeltaPlanes(reader, vertexCount, octX) || !ReadDeltaPlanes(reader, vertexCount, octY))
+        return false;
+
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        Vector3 n;
+        n.x = Max(float32(static_cast<int16>(octX[v])) / SNORM16_MAX, -1.f);
+        n.y = Max(float32(static_cast<int16>(octY[v])) / SNORM16_MAX, -1.f);
+        n.z = 1.f - std::abs(n.x) - std::abs(n.y);
+        if (n.z < 0.f)
+        {
+            float32 unfoldedX = (1.f - std::abs(n.y)) * SignNotZero(n.x);
+            float32 unfoldedY = (1.f - std::abs(n.x)) * SignNotZero(n.y);
+            n.x = unfoldedX;
+            n.y = unfoldedY;
+        }
+        n.Normalize();
+        *reinterpret_cast<Vector3*>(vertices + offset + v * stride) = n;
+    }
+    return true;
+}
+
+void EncodeRaw(const uint8* vertices, uint32 vertexCount, uint32 stride, uint32 offset, uint32 size, Vector<uint8>& out)
+{
+    // byte planes: bytes of the same significance are stored together
+    for (uint32 b = 0; b < size; ++b)
+    {
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            out.push_back(vertices[offset + v * stride + b]);
+        }
+    }
+}
+
+bool DecodeRaw(Reader& reader, uint32 vertexCount, uint32 stride, uint32 offset, uint32 size, uint8* vertices)
+{
+    const uint8* planes = reader.Take(size * vertexCount);
+    if (planes == nullptr)
+        return false;
+
+    for (uint32 b = 0; b < size; ++b)
+    {
+        for (uint32 v = 0; v < vertexCount; ++v)
+        {
+            vertices[offset + v * stride + b] = planes[b * vertexCount + v];
+        }
+    }
+    return true;
+}
+
+bool IsDirection(uint32 attribute)
+{
+    return (attribute == EVF_NORMAL) || (attribute == EVF_TANGENT) || (attribute == EVF_BINORMAL);
+}
+
+bool IsTexCoord(uint32 attribute)
+{
+    return (attribute == EVF_TEXCOORD0) || (attribute == EVF_TEXCOORD1) || (attribute == EVF_TEXCOORD2) || (attribute == EVF_TEXCOORD3);
+}
+
+/** Encoded data is size of uncompressed data followed by LZ4HC compressed data. */
+bool Compress(const Vector<uint8>& raw, Vector<uint8>& encoded)
+{
+    Vector<uint8> compressed;
+    if (!LZ4HCCompressor().Compress(raw, compressed))
+        return false;
+
+    encoded.clear();
+    Write(encoded, static_cast<uint32>(raw.size()));
+    encoded.insert(encoded.end(), compressed.begin(), compressed.end());
+    return true;
+}
+
+bool Decompress(const uint8* encoded, uint32 encodedSize, Vector<uint8>& raw)
+{
+    uint32 rawSize = 0;
+    if (encodedSize <= sizeof(rawSize))
+        return false;
+
+    Memcpy(&rawSize, encoded, sizeof(rawSize));
+    Vector<uint8> compressed(encoded + sizeof(rawSize), encoded + encodedSize);
+    raw.resize(rawSize);
+    return LZ4Compressor().Decompress(compressed, raw);
+}
+}
+
+bool EncodeVertices(const uint8* vertices, uint32 vertexCount, int32 vertexFormat, Vector<uint8>& encoded)
+{
+    using namespace MeshCodecDetails;
+
+    if (vertexCount == 0)
+        return false;
+
+    uint32 stride = uint32(GetVertexSize(vertexFormat));
+
+    Vector<uint8> raw;
+    raw.reserve(vertexCount * stride);
+
+    uint32 offset = 0;
+    for (uint32 attribute = EVF_LOWER_BIT; attribute <= LAST_FORMAT_BIT; attribute <<= 1)
+    {
+        if ((vertexFormat & attribute) == 0)
+            continue;
+
+        uint32 size = uint32(GetVertexSize(attribute));
+        if (attribute == EVF_VERTEX)
+        {
+            EncodeRanges(vertices, vertexCount, stride, offset, 3, raw);
+        }
+        else if (IsDirection(attribute))
+        {
+            EncodeDirections(vertices, vertexCount, stride, offset, raw);
+        }
+        else if (IsTexCoord(attribute))
+        {
+            EncodeRanges(vertices, vertexCount, stride, offset, 2, raw);
+        }
+        else
+        {
+            EncodeRaw(vertices, vertexCount, stride, offset, size, raw);
+        }
+        offset += size;
+    }
+
+    return Compress(raw, encoded);
+}
+
+bool DecodeVertices(const uint8* encoded, uint32 encodedSize, uint32 vertexCount, int32 vertexFormat, Vector<uint8>& vertices)
+{
+    using namespace MeshCodecDetails;
+
+    Vector<uint8> raw;
+    if (!Decompress(encoded, encodedSize, raw))
+        return false;
+
+    uint32 stride = uint32(GetVertexSize(vertexFormat));
+    vertices.resize(vertexCount * stride);
+
+    Reader reader(raw);
+    uint32 offset = 0;
+    for (uint32 attribute = EVF_LOWER_BIT; attribute <= LAST_FORMAT_BIT; attribute <<= 1)
+    {
+        if ((vertexFormat & attribute) == 0)
+            continue;
+
+        bool decoded = false;
+        uint32 size = uint32(GetVertexSize(attribute));
+        if (attribute == EVF_VERTEX)
+        {
+            decoded = DecodeRanges(reader, vertexCount, stride, offset, 3, vertices.data());
+        }
+        else if (IsDirection(attribute))
+        {
+            decoded = DecodeDirections(reader, vertexCount, stride, offset, vertices.data());
+        }
+        else if (IsTexCoord(attribute))
+        {
+            decoded = DecodeRanges(reader, vertexCount, stride, offset, 2, vertices.data());
+        }
+        else
+        {
+            decoded = DecodeRaw(reader, vertexCount, stride, offset, size, vertices.data());
+        }
+
+        if (!decoded)
+            return false;
+
+        offset += size;
+    }
+
+    return true;
+}
+
+bool EncodeIndices(const uint16* indices, uint32 indexCount, Vector<uint8>& encoded)
+{
+    using namespace MeshCodecDetails;
+
+    if (indexCount == 0)
+        return false;
+
+    Vector<uint8> raw;
+    WriteDeltaPlanes(Vector<uint16>(indices, indices + indexCount), raw);
+    return Compress(raw, encoded);
+}
+
+bool DecodeIndices(const uint8* encoded, uint32 encodedSize, uint32 indexCount, uint16* indices)
+{
+    using namespace MeshCodecDetails;
+
+    Vector<uint8> raw;
+    if (!Decompress(encoded, encodedSize, raw))
+        return false;
+
+    Reader reader(raw);
+    Vector<uint16> values;
+    if (!ReadDeltaPlanes(reader, indexCount, values))
+        return false;
+
+    Memcpy(indices, values.data(), indexCount * sizeof(uint16));
+    return true;
+}
+}
+}
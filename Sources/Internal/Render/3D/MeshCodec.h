@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+
+namespace DAVA
+{
+/**
+    Compact storage format for polygon group data.
+
+    Vertex attributes are split to separate streams and quantized:
+    - positions to 16 bits per component relative to bounding box;
+    - normals, tangents and binormals to two 16 bit components with octahedral mapping;
+    - texture coordinates to 16 bits per component relative to their range.
+    Other attributes are stored as is. Quantized values are delta coded between consecutive vertices,
+    indices are delta coded too, then both are compressed with LZ4HC.
+    Encoding is lossy for quantized attributes, so it should be used only when the precision is enough.
+    Decoding restores interleaved float vertex data with the same vertex format.
+
+    The codec only reduces size of scene files, vertex buffers are still uploaded to GPU as floats.
+    Quantized vertex streams on GPU would need:
+    - vertex attribute formats other than float in DX9 and DX11 backends and half floats in GLES2 backend;
+    - signed normalized formats in Metal backend;
+    - position dequantization and octahedral decoding in vertex shaders.
+    None of them exists now, so they are out of scope of this format.
+*/
+namespace MeshCodec
+{
+bool EncodeVertices(const uint8* vertices, uint32 vertexCount, int32 vertexFormat, Vector<uint8>& encoded);
+bool DecodeVertices(const uint8* encoded, uint32 encodedSize, uint32 vertexCount, int32 vertexFormat, Vector<uint8>& vertices);
+
+bool EncodeIndices(const uint16* indices, uint32 indexCount, Vector<uint8>& encoded);
+bool DecodeIndices(const uint8* encoded, uint32 encodedSize, uint32 indexCount, uint16* indices);
+}
+}
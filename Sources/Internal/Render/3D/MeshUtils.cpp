@@ -1118,6 +1118,499 @@ Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction)
     return indexBufferData;
 }
 
+namespace MeshUtilsDetails
+{
+const uint32 FORSYTH_MAX_CACHE_SIZE = 32;
+const uint32 FORSYTH_DEAD_END_SEARCH_WINDOW = 256;
+
+// Triangle order of alpha blended geometry and of geometry sorted at runtime is visible, so it's kept as is
+bool IsTriangleOrderDependent(RenderObject* ro, RenderBatch* batch)
+{
+    if (ro->GetType() == RenderObject::TYPE_SPEED_TREE)
+    {
+        return true;
+    }
+
+    NMaterial* material = batch->GetMaterial();
+    return (material != nullptr) && material->IsAlphablend();
+}
+
+void CollectOptimizableGeometry(Entity* entity, Set<PolygonGroup*>& polygonGroups, Set<PolygonGroup*>& orderDependentPolygonGroups)
+{
+    RenderObject* ro = GetRenderObject(entity);
+    if (ro != nullptr)
+    {
+        for (uint32 i = 0, count = ro->GetRenderBatchCount(); i < count; ++i)
+        {
+            RenderBatch* batch = ro->GetRenderBatch(i);
+            PolygonGroup* pg = batch->GetPolygonGroup();
+            if (pg != nullptr)
+            {
+                if (IsTriangleOrderDependent(ro, batch))
+                {
+                    orderDependentPolygonGroups.insert(pg);
+                }
+                else
+                {
+                    polygonGroups.insert(pg);
+                }
+            }
+        }
+    }
+
+    for (int32 i = 0, count = entity->GetChildrenCount(); i < count; ++i)
+    {
+        CollectOptimizableGeometry(entity->GetChild(i), polygonGroups, orderDependentPolygonGroups);
+    }
+}
+
+float32 ForsythVertexScore(int32 cachePosition, uint32 activeTriangles, uint32 cacheSize)
+{
+    if (activeTriangles == 0)
+        return -1.f;
+
+    float32 score = 0.f;
+    if (cachePosition >= 0)
+    {
+        // vertices of last triangle get fixed score, so triangles sharing edge with it are not preferred too much
+        if (cachePosition < 3)
+        {
+            score = 0.75f;
+        }
+        else
+        {
+            float32 scaler = 1.f / float32(cacheSize - 3);
+            score = std::pow(1.f - float32(cachePosition - 3) * scaler, 1.5f);
+        }
+    }
+
+    // bonus for vertices with few triangles left, so lone triangles are not left behind
+    score += 2.f * std::pow(float32(activeTriangles), -0.5f);
+    return score;
+}
+
+uint32 SimulateVertexCache(const Vector<uint16>& indices, uint32 vertexCount, uint32 cacheSize, Vector<uint32>* trianglesMisses = nullptr)
+{
+    Vector<uint32> cacheTimestamps(vertexCount, 0);
+    uint32 timestamp = cacheSize + 1;
+    uint32 misses = 0;
+
+    for (size_t i = 0; i < indices.size(); i += 3)
+    {
+        uint32 triangleMisses = 0;
+        for (size_t k = i; k < i + 3; ++k)
+        {
+            uint16 v = indices[k];
+            if (timestamp - cacheTimestamps[v] > cacheSize)
+            {
+                cacheTimestamps[v] = timestamp++;
+                ++triangleMisses;
+            }
+        }
+
+        misses += triangleMisses;
+        if (trianglesMisses != nullptr)
+        {
+            trianglesMisses->push_back(triangleMisses);
+        }
+    }
+
+    return misses;
+}
+
+VertexCacheStatistics CalculateVertexCacheStatistics(const Vector<uint16>& indices, uint32 vertexCount, uint32 cacheSize)
+{
+    VertexCacheStatistics result;
+    if (indices.size() >= 3 && vertexCount > 0)
+    {
+        float32 misses = float32(SimulateVertexCache(indices, vertexCount, cacheSize));
+        result.acmr = misses / float32(indices.size() / 3);
+        result.atvr = misses / float32(vertexCount);
+    }
+    return result;
+}
+
+Vector<uint16> OptimizeVertexCacheOrder(const Vector<uint16>& indices, uint32 vertexCount, uint32 cacheSize)
+{
+    cacheSize = Clamp(cacheSize, 4u, FORSYTH_MAX_CACHE_SIZE);
+    uint32 triangleCount = uint32(indices.size() / 3);
+
+    // triangles adjacent to each vertex, emitted triangles are removed from the lists
+    Vector<uint32> activeTriangles(vertexCount, 0);
+    for (uint16 v : indices)
+    {
+        ++activeTriangles[v];
+    }
+
+    Vector<uint32> adjacencyOffsets(vertexCount + 1, 0);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + activeTriangles[v];
+    }
+
+    Vector<uint32> adjacency(indices.size());
+    Vector<uint32> adjacencyFill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            uint16 v = indices[3 * t + k];
+            adjacency[adjacencyFill[v]++] = t;
+        }
+    }
+
+    Vector<int32> cachePosition(vertexCount, -1);
+    Vector<float32> vertexScore(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        vertexScore[v] = ForsythVertexScore(-1, activeTriangles[v], cacheSize);
+    }
+
+    Vector<float32> triangleScore(triangleCount);
+    Vector<uint8> triangleEmitted(triangleCount, 0);
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        triangleScore[t] = vertexScore[indices[3 * t]] + vertexScore[indices[3 * t + 1]] + vertexScore[indices[3 * t + 2]];
+    }
+
+    Vector<uint16> result;
+    result.reserve(indices.size());
+
+    Vector<uint16> cache;
+    Vector<uint16> newCache;
+    cache.reserve(cacheSize + 3);
+    newCache.reserve(cacheSize + 3);
+
+    // first not emitted triangle in source order, it only moves forward, so dead end search is O(T) in total
+    uint32 deadEndCursor = 0;
+
+    int32 bestTriangle = -1;
+    for (uint32 emittedCount = 0; emittedCount < triangleCount; ++emittedCount)
+    {
+        if (bestTriangle < 0)
+        {
+            // no candidates in cache, happens on start and for disconnected parts of mesh.
+            // Full search of best score would be O(T^2) for meshes of many small parts, so only limited window is searched
+            while (triangleEmitted[deadEndCursor] != 0)
+            {
+                ++deadEndCursor;
+            }
+
+            float32 bestScore = -1.f;
+            for (uint32 t = deadEndCursor, e = Min(deadEndCursor + FORSYTH_DEAD_END_SEARCH_WINDOW, triangleCount); t < e; ++t)
+            {
+                if (triangleEmitted[t] == 0 && triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    bestTriangle = int32(t);
+                }
+            }
+        }
+
+        const uint16* triangle = indices.data() + 3 * bestTriangle;
+        triangleEmitted[bestTriangle] = 1;
+        result.insert(result.end(), triangle, triangle + 3);
+
+        newCache.clear();
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            uint16 v = triangle[k];
+            newCache.push_back(v);
+
+            uint32* begin = adjacency.data() + adjacencyOffsets[v];
+            uint32* end = begin + activeTriangles[v];
+            *std::find(begin, end, uint32(bestTriangle)) = *(end - 1);
+            --activeTriangles[v];
+        }
+        for (uint16 v : cache)
+        {
+            if (v != triangle[0] && v != triangle[1] && v != triangle[2])
+            {
+                newCache.push_back(v);
+            }
+        }
+
+        for (uint32 i = 0; i < uint32(newCache.size()); ++i)
+        {
+            uint16 v = newCache[i];
+            cachePosition[v] = (i < cacheSize) ? int32(i) : -1;
+            vertexScore[v] = ForsythVertexScore(cachePosition[v], activeTriangles[v], cacheSize);
+        }
+        if (newCache.size() > cacheSize)
+        {
+            newCache.resize(cacheSize);
+        }
+        cache.swap(newCache);
+
+        // only triangles adjacent to cached vertices could change score, best of them is emitted next
+        bestTriangle = -1;
+        float32 bestScore = -1.f;
+        for (uint16 v : cache)
+        {
+            for (uint32 i = adjacencyOffsets[v], e = adjacencyOffsets[v] + activeTriangles[v]; i < e; ++i)
+            {
+                uint32 t = adjacency[i];
+                const uint16* tv = indices.data() + 3 * t;
+                triangleScore[t] = vertexScore[tv[0]] + vertexScore[tv[1]] + vertexScore[tv[2]];
+                if (triangleScore[t] > bestScore)
+                {
+                    bestScore = triangleScore[t];
+                    bestTriangle = int32(t);
+                }
+            }
+        }
+    }
+
+    return result;
+}
+
+Vector<uint16> OptimizeOverdrawOrder(const Vector<uint16>& indices, const Vector<Vector3>& positions, uint32 cacheSize, float32 threshold)
+{
+    uint32 triangleCount = uint32(indices.size() / 3);
+    uint32 vertexCount = uint32(positions.size());
+
+    // cluster starts at triangle with all vertices missing the cache, so reordering clusters keeps cache efficiency
+    Vector<uint32> trianglesMisses;
+    trianglesMisses.reserve(triangleCount);
+    uint32 misses = SimulateVertexCache(indices, vertexCount, cacheSize, &trianglesMisses);
+
+    Vector<uint32> clusterStarts;
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        if (t == 0 || trianglesMisses[t] == 3)
+        {
+            clusterStarts.push_back(t);
+        }
+    }
+    if (clusterStarts.size() < 2)
+        return indices;
+    clusterStarts.push_back(triangleCount);
+
+    struct Cluster
+    {
+        uint32 start = 0;
+        uint32 end = 0;
+        Vector3 centroid;
+        Vector3 normal;
+        float32 area = 0.f;
+        float32 sortKey = 0.f;
+    };
+
+    Vector<Cluster> clusters(clusterStarts.size() - 1);
+    Vector3 meshCentroid;
+    float32 meshArea = 0.f;
+    for (size_t c = 0; c < clusters.size(); ++c)
+    {
+        Cluster& cluster = clusters[c];
+        cluster.start = clusterStarts[c];
+        cluster.end = clusterStarts[c + 1];
+
+        for (uint32 t = cluster.start; t < cluster.end; ++t)
+        {
+            const Vector3& p0 = positions[indices[3 * t]];
+            const Vector3& p1 = positions[indices[3 * t + 1]];
+            const Vector3& p2 = positions[indices[3 * t + 2]];
+
+            Vector3 normal = (p1 - p0).CrossProduct(p2 - p0);
+            float32 area = normal.Length();
+            cluster.centroid += (p0 + p1 + p2) * (area / 3.f);
+            cluster.normal += normal;
+            cluster.area += area;
+        }
+
+        meshCentroid += cluster.centroid;
+        meshArea += cluster.area;
+        if (cluster.area > 0.f)
+        {
+            cluster.centroid /= cluster.area;
+        }
+        cluster.normal.Normalize();
+    }
+    if (meshArea > 0.f)
+    {
+        meshCentroid /= meshArea;
+    }
+
+    // clusters on the outer side of mesh and facing out occlude the rest, so they are drawn first
+    for (Cluster& cluster : clusters)
+    {
+        cluster.sortKey = cluster.normal.DotProduct(cluster.centroid - meshCentroid);
+    }
+    std::stable_sort(clusters.begin(), clusters.end(), [](const Cluster& l, const Cluster& r) {
+        return l.sortKey > r.sortKey;
+    });
+
+    Vector<uint16> result;
+    result.reserve(indices.size());
+    for (const Cluster& cluster : clusters)
+    {
+        result.insert(result.end(), indices.begin() + 3 * cluster.start, indices.begin() + 3 * cluster.end);
+    }
+
+    uint32 newMisses = SimulateVertexCache(result, vertexCount, cacheSize);
+    return (float32(newMisses) <= float32(misses) * threshold) ? result : indices;
+}
+
+uint32 HashVertex(const uint8* data, uint32 size)
+{
+    uint32 hash = 2166136261u;
+    for (uint32 i = 0; i < size; ++i)
+    {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/** Writes vertices in order of first use, identical and unused vertices are dropped. Indices are remapped in place. */
+uint32 OptimizeVertexFetchOrder(Vector<uint16>& indices, const uint8* vertexData, uint32 vertexCount, uint32 vertexStride, Vector<uint8>& newVertexData)
+{
+    const uint32 UNMAPPED = 0xFFFFFFFF;
+    Vector<uint32> remap(vertexCount, UNMAPPED);
+    UnorderedMultiMap<uint32, uint32> newVerticesByHash;
+    newVertexData.clear();
+    newVertexData.reserve(vertexCount * vertexStride);
+
+    uint32 newVertexCount = 0;
+    for (uint16& index : indices)
+    {
+        if (remap[index] == UNMAPPED)
+        {
+            const uint8* vertex = vertexData + index * vertexStride;
+            uint32 hash = HashVertex(vertex, vertexStride);
+
+            auto range = newVerticesByHash.equal_range(hash);
+            for (auto it = range.first; it != range.second; ++it)
+            {
+                if (Memcmp(newVertexData.data() + it->second * vertexStride, vertex, vertexStride) == 0)
+                {
+                    remap[index] = it->second;
+                    break;
+                }
+            }
+
+            if (remap[index] == UNMAPPED)
+            {
+                remap[index] = newVertexCount;
+                newVerticesByHash.emplace(hash, newVertexCount);
+                newVertexData.insert(newVertexData.end(), vertex, vertex + vertexStride);
+                ++newVertexCount;
+            }
+        }
+        index = uint16(remap[index]);
+    }
+
+    return newVertexCount;
+}
+}
+
+VertexCacheStatistics CalculateVertexCacheStatistics(PolygonGroup* pg, uint32 cacheSize)
+{
+    DVASSERT(pg);
+
+    Vector<uint16> indices(pg->indexArray, pg->indexArray + pg->GetIndexCount());
+    return MeshUtilsDetails::CalculateVertexCacheStatistics(indices, uint32(pg->GetVertexCount()), cacheSize);
+}
+
+GeometryOptimizationResult OptimizeGeometry(PolygonGroup* pg, uint32 cacheSize, float32 overdrawThreshold)
+{
+    using namespace MeshUtilsDetails;
+
+    DVASSERT(pg);
+
+    GeometryOptimizationResult result;
+    result.vertexCountBefore = uint32(pg->GetVertexCount());
+    result.vertexCountAfter = result.vertexCountBefore;
+
+    // index buffers with several triangle orders (sorted geometry of speed trees) are not processed
+    bool canOptimize = (pg->GetPrimitiveType() == rhi::PRIMITIVE_TRIANGLELIST) && (pg->indexFormat == EIF_16) &&
+    (pg->meshData != nullptr) && (pg->indexArray != nullptr) && (pg->GetIndexCount() >= 3) && (pg->GetFormat() & EVF_VERTEX) &&
+    (pg->GetIndexCount() == pg->GetPrimitiveCount() * 3);
+    if (!canOptimize)
+        return result;
+
+    uint32 vertexCount = uint32(pg->GetVertexCount());
+    uint32 vertexStride = uint32(pg->vertexStride);
+    uint32 indexCount = uint32(pg->GetPrimitiveCount() * 3);
+
+    Vector<uint16> indices(pg->indexArray, pg->indexArray + indexCount);
+    result.before = MeshUtilsDetails::CalculateVertexCacheStatistics(indices, vertexCount, cacheSize);
+
+    Vector<Vector3> positions(vertexCount);
+    for (uint32 v = 0; v < vertexCount; ++v)
+    {
+        pg->GetCoord(int32(v), positions[v]);
+    }
+
+    indices = OptimizeVertexCacheOrder(indices, vertexCount, cacheSize);
+    indices = OptimizeOverdrawOrder(indices, positions, cacheSize, overdrawThreshold);
+
+    Vector<uint8> vertexData;
+    uint32 newVertexCount = OptimizeVertexFetchOrder(indices, pg->meshData, vertexCount, vertexStride, vertexData);
+
+    bool buffersBuilt = pg->vertexBuffer.IsValid() || pg->indexBuffer.IsValid();
+    int32 format = pg->GetFormat();
+    int32 primitiveCount = pg->GetPrimitiveCount();
+
+    pg->ReleaseData();
+    pg->AllocateData(format, int32(newVertexCount), int32(indexCount), primitiveCount);
+    Memcpy(pg->meshData, vertexData.data(), vertexData.size());
+    Memcpy(pg->indexArray, indices.data(), indices.size() * sizeof(uint16));
+    pg->RecalcAABBox();
+
+    if (buffersBuilt)
+    {
+        pg->BuildBuffers();
+    }
+
+    result.after = MeshUtilsDetails::CalculateVertexCacheStatistics(indices, newVertexCount, cacheSize);
+    result.vertexCountAfter = newVertexCount;
+    result.optimized = true;
+    return result;
+}
+
+GeometryOptimizationResult OptimizeGeometryRecursive(Entity* entity, uint32 cacheSize)
+{
+    DVASSERT(entity);
+
+    Set<PolygonGroup*> polygonGroups;
+    Set<PolygonGroup*> orderDependentPolygonGroups;
+    MeshUtilsDetails::CollectOptimizableGeometry(entity, polygonGroups, orderDependentPolygonGroups);
+    for (PolygonGroup* pg : orderDependentPolygonGroups)
+    {
+        polygonGroups.erase(pg);
+    }
+
+    // statistics of groups are weighted by their triangle and vertex counts
+    GeometryOptimizationResult result;
+    float32 triangleCount = 0.f;
+    for (PolygonGroup* pg : polygonGroups)
+    {
+        GeometryOptimizationResult groupResult = OptimizeGeometry(pg, cacheSize);
+        if (groupResult.optimized)
+        {
+            float32 groupTriangleCount = float32(pg->GetPrimitiveCount());
+            triangleCount += groupTriangleCount;
+            result.before.acmr += groupResult.before.acmr * groupTriangleCount;
+            result.after.acmr += groupResult.after.acmr * groupTriangleCount;
+            result.before.atvr += groupResult.before.atvr * float32(groupResult.vertexCountBefore);
+            result.after.atvr += groupResult.after.atvr * float32(groupResult.vertexCountAfter);
+            result.vertexCountBefore += groupResult.vertexCountBefore;
+            result.vertexCountAfter += groupResult.vertexCountAfter;
+            result.optimized = true;
+        }
+    }
+
+    if (result.optimized)
+    {
+        result.before.acmr /= triangleCount;
+        result.after.acmr /= triangleCount;
+        result.before.atvr /= float32(result.vertexCountBefore);
+        result.after.atvr /= float32(result.vertexCountAfter);
+    }
+
+    return result;
+}
+
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity)
 {
     if (!forEntity)
@@ -31,6 +31,47 @@ PolygonGroup* CreateShadowPolygonGroup(PolygonGroup* source);
 
 Vector<uint16> BuildSortedIndexBufferData(PolygonGroup* pg, Vector3 direction);
 
+static const uint32 DEFAULT_VERTEX_CACHE_SIZE = 16;
+
+/**
+    Post-transform vertex cache efficiency of triangle list, calculated with FIFO cache simulation.
+    ACMR - average count of transformed vertices per triangle (0.5 is the best, 3.0 is the worst).
+    ATVR - average count of transforms per vertex (1.0 is the best).
+*/
+struct VertexCacheStatistics
+{
+    float32 acmr = 0.f;
+    float32 atvr = 0.f;
+};
+
+struct GeometryOptimizationResult
+{
+    VertexCacheStatistics before;
+    VertexCacheStatistics after;
+    uint32 vertexCountBefore = 0;
+    uint32 vertexCountAfter = 0;
+    bool optimized = false;
+};
+
+VertexCacheStatistics CalculateVertexCacheStatistics(PolygonGroup* pg, uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
+/**
+    Optimizes triangle list of polygon group for GPU vertex processing without changing rendered image:
+    - reorders triangles for post-transform vertex cache (Forsyth algorithm);
+    - reorders clusters of triangles to draw outer surfaces first and reduce overdraw,
+      if it doesn't make ACMR worse more than by `overdrawThreshold` times;
+    - merges identical vertices, removes unused ones and reorders the rest in order of first use for vertex fetch locality.
+    Only triangle lists with 16-bit indices and single triangle order are processed. Vertex and index buffers are rebuilt if they were created.
+*/
+GeometryOptimizationResult OptimizeGeometry(PolygonGroup* pg, uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE, float32 overdrawThreshold = 1.05f);
+
+/**
+    Optimizes geometry of polygon groups rendered by meshes in entity hierarchy, see `OptimizeGeometry`. Returns summary statistics.
+    Polygon groups used with alpha blended materials or by speed trees (sorted at runtime) are skipped,
+    since their triangle order is visible.
+*/
+GeometryOptimizationResult OptimizeGeometryRecursive(Entity* entity, uint32 cacheSize = DEFAULT_VERTEX_CACHE_SIZE);
+
 uint32 ReleaseGeometryDataRecursive(Entity* forEntity);
 };
 };
@@ -5,6 +5,7 @@
 #include "Render/Highlevel/GeometryOctTree.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Logger/Logger.h"
+#include "Render/3D/MeshCodec.h"
 
 namespace DAVA
 {
@@ -346,10 +347,26 @@ void PolygonGroup::Save(KeyedArchive* keyedArchive, SerializationContext* serial
     keyedArchive->SetInt32("rhi_primitiveType", primitiveType);
     keyedArchive->SetInt32("primitiveCount", primitiveCount);
 
-    keyedArchive->SetInt32("packing", PACKING_NONE);
-    keyedArchive->SetByteArray("vertices", meshData, vertexCount * vertexStride);
-    keyedArchive->SetInt32("indexFormat", indexFormat);
-    keyedArchive->SetByteArray("indices", reinterpret_cast<uint8*>(indexArray), indexCount * INDEX_FORMAT_SIZE[indexFormat]);
+    Vector<uint8> encodedVertices;
+    Vector<uint8> encodedIndices;
+    bool quantize = (serializationContext != nullptr) && serializationContext->IsGeometryQuantizationEnabled() && (indexFormat == EIF_16) &&
+    MeshCodec::EncodeVertices(meshData, vertexCount, vertexFormat, encodedVertices) &&
+    MeshCodec::EncodeIndices(reinterpret_cast<uint16*>(indexArray), indexCount, encodedIndices);
+
+    if (quantize)
+    {
+        keyedArchive->SetInt32("packing", PACKING_QUANTIZED);
+        keyedArchive->SetByteArray("vertices", encodedVertices.data(), static_cast<int32>(encodedVertices.size()));
+        keyedArchive->SetInt32("indexFormat", indexFormat);
+        keyedArchive->SetByteArray("indices", encodedIndices.data(), static_cast<int32>(encodedIndices.size()));
+    }
+    else
+    {
+        keyedArchive->SetInt32("packing", PACKING_NONE);
+        keyedArchive->SetByteArray("vertices", meshData, vertexCount * vertexStride);
+        keyedArchive->SetInt32("indexFormat", indexFormat);
+        keyedArchive->SetByteArray("indices", reinterpret_cast<uint8*>(indexArray), indexCount * INDEX_FORMAT_SIZE[indexFormat]);
+    }
     keyedArchive->SetInt32("cubeTextureCoordCount", cubeTextureCoordCount);
 }
 
@@ -367,6 +384,8 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
     cubeTextureCoordCount = keyedArchive->GetInt32("cubeTextureCoordCount");
 
     int32 formatPacking = keyedArchive->GetInt32("packing");
+    const uint8* archiveData = nullptr;
+    Vector<uint8> decodedVertices;
     if (formatPacking == PACKING_NONE)
     {
         int size = keyedArchive->GetByteArraySize("vertices");
@@ -376,8 +395,24 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
             return;
         }
 
-        const uint8* archiveData = keyedArchive->GetByteArray("vertices");
+        archiveData = keyedArchive->GetByteArray("vertices");
+    }
+    else if (formatPacking == PACKING_QUANTIZED)
+    {
+        const uint8* encodedData = keyedArchive->GetByteArray("vertices");
+        uint32 encodedSize = static_cast<uint32>(keyedArchive->GetByteArraySize("vertices"));
+        if (!MeshCodec::DecodeVertices(encodedData, encodedSize, vertexCount, vertexFormat, decodedVertices))
+        {
+            Logger::Error("PolygonGroup::Load - Something is going wrong, can't decode vertex array");
+            return;
+        }
+
+        archiveData = decodedVertices.data();
+    }
 
+    if (archiveData != nullptr)
+    {
+        int32 size = vertexCount * vertexStride;
         int32 resFormat = cutUnusedStreams ? requiredFlags : (vertexFormat | requiredFlags);
 
         if ((vertexFormat & EVF_PIVOT_DEPRECATED) && (requiredFlags & EVF_PIVOT4))
@@ -423,7 +458,19 @@ void PolygonGroup::LoadPolygonData(KeyedArchive* keyedArchive, SerializationCont
     }
 
     indexFormat = keyedArchive->GetInt32("indexFormat");
-    if (indexFormat == EIF_16)
+    if (indexFormat == EIF_16 && formatPacking == PACKING_QUANTIZED)
+    {
+        SafeDeleteArray(indexArray);
+        indexArray = new int16[indexCount];
+        const uint8* encodedData = keyedArchive->GetByteArray("indices");
+        uint32 encodedSize = static_cast<uint32>(keyedArchive->GetByteArraySize("indices"));
+        if (!MeshCodec::DecodeIndices(encodedData, encodedSize, indexCount, reinterpret_cast<uint16*>(indexArray)))
+        {
+            Logger::Error("PolygonGroup::Load - Something is going wrong, can't decode index array");
+            return;
+        }
+    }
+    else if (indexFormat == EIF_16)
     {
         int size = keyedArchive->GetByteArraySize("indices");
         if (size != indexCount * INDEX_FORMAT_SIZE[indexFormat])
@@ -31,6 +31,7 @@ public:
     {
         PACKING_NONE = 0,
         PACKING_DEFAULT,
+        PACKING_QUANTIZED, // vertices and indices are encoded with MeshCodec, decoded to float layout on load
     };
 
     enum : uint32
@@ -5,6 +5,8 @@
 #include "Render/Highlevel/RenderPassNames.h"
 #include "Reflection/Reflection.h"
 #include "FileSystem/FileSystem.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
@@ -19,6 +21,7 @@ struct GeoDecalManager::DecalBuildInfo
     Matrix4 projectionSpaceTransform;
     int32 lodIndex = -1;
     int32 switchIndex = -1;
+    const SkinnedMesh::JointTargetsData* jointTargetsData = nullptr;
     bool useCustomNormal = false;
     bool useCustomSpecular = false;
     bool useSkinning = false;
@@ -60,6 +63,57 @@ struct GeoDecalManager::DecalVertex
     }
 };
 
+struct GeoDecalManager::DecalBuildJob
+{
+    struct Batch
+    {
+        DecalBuildInfo info;
+        SkinnedMesh::JointTargetsData jointTargetsData;
+        Vector<uint8> geometry;
+    };
+
+    RenderObject* renderObject = nullptr;
+    DecalConfig config;
+    List<Batch> batches;
+    std::atomic<bool> completed{ false };
+    bool deleted = false;
+    bool renderObjectRemoved = false;
+
+    DecalBuildJob(RenderObject* ro, const DecalConfig& config_)
+        : renderObject(SafeRetain(ro))
+        , config(config_)
+    {
+    }
+
+    ~DecalBuildJob()
+    {
+        for (Batch& b : batches)
+        {
+            SafeRelease(b.info.sourceBatch);
+            SafeRelease(b.info.polygonGroup);
+            SafeRelease(b.info.material);
+        }
+        SafeRelease(renderObject);
+    }
+
+    void AddBatch(const DecalBuildInfo& info)
+    {
+        batches.emplace_back();
+        Batch& b = batches.back();
+        b.info = info;
+        SafeRetain(b.info.sourceBatch);
+        SafeRetain(b.info.polygonGroup);
+        SafeRetain(b.info.material);
+
+        // skinning is evaluated in worker thread, so joints are copied in their current state
+        if (info.jointTargetsData != nullptr)
+        {
+            b.jointTargetsData = *info.jointTargetsData;
+            b.info.jointTargetsData = &b.jointTargetsData;
+        }
+    }
+};
+
 GeoDecalManager::BuiltDecal::BuiltDecal(BuiltDecal&& r)
     : sourceObject(r.sourceObject)
     , batchProvider(r.batchProvider)
@@ -114,8 +168,17 @@ private:
 
 const GeoDecalManager::Decal GeoDecalManager::InvalidDecal = nullptr;
 
+GeoDecalManager::GeoDecalManager() = default;
+
 GeoDecalManager::~GeoDecalManager()
 {
+    if (!buildingDecals.empty())
+    {
+        // worker jobs reference build jobs owned by manager
+        GetEngineContext()->jobManager->WaitWorkerJobs();
+        buildingDecals.clear();
+    }
+
     for (auto& d : builtDecals)
     {
         UnregisterDecal(d.first);
@@ -123,14 +186,17 @@ GeoDecalManager::~GeoDecalManager()
     builtDecals.clear();
 }
 
-GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro)
+GeoDecalManager::Decal GeoDecalManager::CreateDecalHandle()
 {
     ++decalCounter;
 
     uintptr_t thisId = reinterpret_cast<uintptr_t>(this);
-    Decal decal = reinterpret_cast<Decal>(decalCounter ^ thisId);
+    return reinterpret_cast<Decal>(decalCounter ^ thisId);
     // todo : use something better for decal id
+}
 
+void GeoDecalManager::InitBuildInfo(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro, DecalBuildInfo& info)
+{
     AABBox3 decalBox = config.GetBoundingBox();
 
     AABBox3 worldSpaceBox;
@@ -178,7 +244,6 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
     Matrix4 proj;
     proj.BuildOrtho(boxMin.x, boxMax.x, boxMin.y, boxMax.y, -boxMax.z, -boxMin.z, false);
 
-    DecalBuildInfo info;
     info.renderObject = ro;
     info.projectionAxis = dir;
     info.projectionSpaceTransform = view * proj;
@@ -187,6 +252,46 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
     info.useSkinning = ro->GetType() == RenderObject::TYPE_SKINNED_MESH;
 
     worldSpaceBox.GetTransformedBox(ro->GetInverseWorldTransform(), info.boundingBox);
+}
+
+bool GeoDecalManager::InitBatchBuildInfo(RenderObject* ro, uint32 batchIndex, DecalBuildInfo& info)
+{
+    int32 lodIndex = -1;
+    int32 switchIndex = -1;
+    info.sourceBatch = ro->GetRenderBatch(batchIndex, lodIndex, switchIndex);
+    info.polygonGroup = info.sourceBatch->GetPolygonGroup();
+    info.material = info.sourceBatch->GetMaterial();
+    info.lodIndex = lodIndex;
+    info.switchIndex = switchIndex;
+    info.jointTargetsData = nullptr;
+
+    if (info.polygonGroup == nullptr)
+        return false;
+
+    const FastName& effectiveFxName = info.material->GetEffectiveFXName();
+
+    if ((effectiveFxName == NMaterialName::SILHOUETTE) || (effectiveFxName == NMaterialName::SHADOW_VOLUME))
+        return false;
+
+    if (info.useSkinning)
+    {
+        info.jointTargetsData = &static_cast<SkinnedMesh*>(ro)->GetJointTargetsData(info.sourceBatch);
+    }
+    else
+    {
+        // oct tree is created on first request, so it should not happen in worker thread
+        info.polygonGroup->GetGeometryOctTree();
+    }
+
+    return true;
+}
+
+GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro)
+{
+    Decal decal = CreateDecalHandle();
+
+    DecalBuildInfo info;
+    InitBuildInfo(config, decalWorldTransform, ro, info);
 
     BuiltDecal& builtDecal = builtDecals[decal];
     {
@@ -194,16 +299,14 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
         builtDecal.sourceObject = SafeRetain(ro);
         builtDecal.batchProvider = decalBatchProvider;
 
+        Vector<uint8> buffer;
         for (uint32 i = 0, e = ro->GetRenderBatchCount(); i < e; ++i)
         {
-            int32 lodIndex = -1;
-            int32 switchIndex = -1;
-            info.sourceBatch = ro->GetRenderBatch(i, lodIndex, switchIndex);
-            info.polygonGroup = info.sourceBatch->GetPolygonGroup();
-            info.material = info.sourceBatch->GetMaterial();
-            info.lodIndex = lodIndex;
-            info.switchIndex = switchIndex;
-            BuildDecal(info, config, decalBatchProvider);
+            buffer.clear();
+            if (InitBatchBuildInfo(ro, i, info) && BuildDecalGeometry(info, config, buffer))
+            {
+                CreateDecalBatches(info, config, buffer, decalBatchProvider);
+            }
         }
     }
     RegisterDecal(decal);
@@ -211,8 +314,90 @@ GeoDecalManager::Decal GeoDecalManager::BuildDecal(const DecalConfig& config, co
     return decal;
 }
 
+GeoDecalManager::Decal GeoDecalManager::BuildDecalAsync(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* ro)
+{
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    if (jobManager == nullptr)
+        return BuildDecal(config, decalWorldTransform, ro);
+
+    Decal decal = CreateDecalHandle();
+
+    DecalBuildInfo info;
+    InitBuildInfo(config, decalWorldTransform, ro, info);
+
+    DecalBuildJob* job = new DecalBuildJob(ro, config);
+    for (uint32 i = 0, e = ro->GetRenderBatchCount(); i < e; ++i)
+    {
+        if (InitBatchBuildInfo(ro, i, info))
+        {
+            job->AddBatch(info);
+        }
+    }
+    buildingDecals[decal].reset(job);
+
+    jobManager->CreateWorkerJob([this, job]() {
+        for (DecalBuildJob::Batch& b : job->batches)
+        {
+            BuildDecalGeometry(b.info, job->config, b.geometry);
+        }
+        job->completed.store(true, std::memory_order_release);
+    });
+
+    return decal;
+}
+
+void GeoDecalManager::ApplyBuiltDecals()
+{
+    for (auto i = buildingDecals.begin(); i != buildingDecals.end();)
+    {
+        DecalBuildJob* job = i->second.get();
+        if (!job->completed.load(std::memory_order_acquire))
+        {
+            ++i;
+            continue;
+        }
+
+        if (!job->deleted)
+        {
+            BuiltDecal& builtDecal = builtDecals[i->first];
+            GeoDecalRenderBatchProvider* decalBatchProvider = new GeoDecalRenderBatchProvider();
+            builtDecal.sourceObject = SafeRetain(job->renderObject);
+            builtDecal.batchProvider = decalBatchProvider;
+
+            for (const DecalBuildJob::Batch& b : job->batches)
+            {
+                if (!b.geometry.empty())
+                {
+                    CreateDecalBatches(b.info, job->config, b.geometry, decalBatchProvider);
+                }
+            }
+
+            if (!job->renderObjectRemoved)
+            {
+                RegisterDecal(i->first);
+            }
+        }
+
+        i = buildingDecals.erase(i);
+    }
+}
+
+bool GeoDecalManager::IsDecalBuilding(Decal decal) const
+{
+    auto i = buildingDecals.find(decal);
+    return (i != buildingDecals.end()) && !i->second->deleted;
+}
+
 void GeoDecalManager::DeleteDecal(Decal decal)
 {
+    auto building = buildingDecals.find(decal);
+    if (building != buildingDecals.end())
+    {
+        // job is removed in ApplyBuiltDecals, since worker thread may still use it
+        building->second->deleted = true;
+        return;
+    }
+
     UnregisterDecal(decal);
     builtDecals.erase(decal);
 }
@@ -242,19 +427,119 @@ void GeoDecalManager::RemoveRenderObject(RenderObject* ro)
             UnregisterDecal(b.first);
         }
     }
+
+    for (const auto& b : buildingDecals)
+    {
+        if (b.second->renderObject == ro)
+        {
+            b.second->renderObjectRemoved = true;
+        }
+    }
 }
 
 #define MAX_CLIPPED_POLYGON_CAPACITY 9
 #define PLANE_THICKNESS_EPSILON 0.00001f
 
-void GeoDecalManager::AddVerticesToGeometry(const DecalBuildInfo& info, const DecalConfig& config, DecalVertex* points, DecalVertex* points_tmp, Vector<uint8>& buffer)
+namespace GeoDecalManagerDetails
+{
+enum TriangleClass : uint8
+{
+    TRIANGLE_OUTSIDE = 0,
+    TRIANGLE_INTERSECTS = 1,
+    TRIANGLE_INSIDE = 2
+};
+
+/*
+ * Classifies triangles against clip space box [-1, 1].
+ * Vertex coordinates are stored in separate streams, three consecutive vertices per triangle.
+ * Loop body has no branches, so compiler vectorizes it.
+ */
+void ClassifyTriangles(const float32* x, const float32* y, const float32* z, uint32 triangleCount, uint8* result)
+{
+    const float32 inner = 1.0f - PLANE_THICKNESS_EPSILON;
+    const float32 outer = 1.0f + PLANE_THICKNESS_EPSILON;
+
+    for (uint32 t = 0; t < triangleCount; ++t)
+    {
+        uint32 commonOutcode = 0x3f;
+        uint32 allInside = 1;
+        for (uint32 v = 3 * t; v < 3 * t + 3; ++v)
+        {
+            uint32 outcode = static_cast<uint32>(x[v] < -outer) | (static_cast<uint32>(x[v] > outer) << 1) |
+            (static_cast<uint32>(y[v] < -outer) << 2) | (static_cast<uint32>(y[v] > outer) << 3) |
+            (static_cast<uint32>(z[v] < -outer) << 4) | (static_cast<uint32>(z[v] > outer) << 5);
+            commonOutcode &= outcode;
+            allInside &= static_cast<uint32>(std::abs(x[v]) < inner) & static_cast<uint32>(std::abs(y[v]) < inner) & static_cast<uint32>(std::abs(z[v]) < inner);
+        }
+        // all vertices outside of the same plane - triangle is outside, otherwise it is clipped unless completely inside
+        result[t] = static_cast<uint8>(static_cast<uint32>(commonOutcode == 0) * (TRIANGLE_INTERSECTS + allInside));
+    }
+}
+}
+
+/*
+ * Offsets of attributes inside of interleaved vertex of polygon group, -1 for absent attributes.
+ */
+struct GeoDecalManager::VertexStreamLayout
+{
+    const uint8* vertexData = nullptr;
+    uint32 vertexStride = 0;
+    int32 coordOffset = -1;
+    int32 texCoordOffset[3] = { -1, -1, -1 };
+    int32 normalOffset = -1;
+    int32 tangentOffset = -1;
+    int32 binormalOffset = -1;
+    int32 hardJointIndexOffset = -1;
+
+    VertexStreamLayout(PolygonGroup* pg)
+        : vertexData(pg->meshData)
+        , vertexStride(static_cast<uint32>(pg->vertexStride))
+    {
+        int32 format = pg->GetFormat();
+        coordOffset = GetOffset(pg, pg->vertexArray, format & EVF_VERTEX);
+        texCoordOffset[0] = GetOffset(pg, pg->textureCoordArray[0], format & EVF_TEXCOORD0);
+        texCoordOffset[1] = GetOffset(pg, pg->textureCoordArray[1], format & EVF_TEXCOORD1);
+        texCoordOffset[2] = GetOffset(pg, pg->textureCoordArray[2], format & EVF_TEXCOORD2);
+        normalOffset = GetOffset(pg, pg->normalArray, format & EVF_NORMAL);
+        tangentOffset = GetOffset(pg, pg->tangentArray, format & EVF_TANGENT);
+        binormalOffset = GetOffset(pg, pg->binormalArray, format & EVF_BINORMAL);
+        hardJointIndexOffset = GetOffset(pg, pg->hardJointIndexArray, format & EVF_HARD_JOINTINDEX);
+    }
+
+    static int32 GetOffset(PolygonGroup* pg, const void* stream, int32 present)
+    {
+        return ((present != 0) && (stream != nullptr)) ? static_cast<int32>(reinterpret_cast<const uint8*>(stream) - pg->meshData) : -1;
+    }
+
+    template <class T>
+    void Read(const uint8* vertex, int32 offset, T& value) const
+    {
+        if (offset >= 0)
+            memcpy(&value, vertex + offset, sizeof(T));
+    }
+};
+
+void GeoDecalManager::ReadVertex(const VertexStreamLayout& layout, uint32 index, DecalVertex& vertex)
+{
+    const uint8* v = layout.vertexData + index * layout.vertexStride;
+    layout.Read(v, layout.coordOffset, vertex.originalPoint);
+    layout.Read(v, layout.texCoordOffset[0], vertex.texCoord0);
+    layout.Read(v, layout.texCoordOffset[1], vertex.texCoord1);
+    layout.Read(v, layout.texCoordOffset[2], vertex.texCoord2);
+    layout.Read(v, layout.normalOffset, vertex.normal);
+    layout.Read(v, layout.tangentOffset, vertex.tangent);
+    layout.Read(v, layout.binormalOffset, vertex.binormal);
+
+    float32 jointIndex = 0.0f;
+    layout.Read(v, layout.hardJointIndexOffset, jointIndex);
+    vertex.jointIndex = static_cast<int32>(jointIndex);
+}
+
+void GeoDecalManager::AddVerticesToGeometry(const DecalConfig& config, DecalVertex* points, DecalVertex* points_tmp, bool clipToBox, Vector<uint8>& buffer)
 {
     const AABBox3 clipSpaceBox = AABBox3(Vector3(0.0f, 0.0f, 0.0f), 2.0f);
 
     uint32_t numPoints = 3;
-    points[0].actualPoint = points[0].actualPoint * info.projectionSpaceTransform;
-    points[1].actualPoint = points[1].actualPoint * info.projectionSpaceTransform;
-    points[2].actualPoint = points[2].actualPoint * info.projectionSpaceTransform;
 
     float minU = 1.0f;
     float maxU = 0.0f;
@@ -293,7 +578,10 @@ void GeoDecalManager::AddVerticesToGeometry(const DecalBuildInfo& info, const De
         }
     }
 
-    ClipToBoundingBox(points, points_tmp, &numPoints, clipSpaceBox);
+    if (clipToBox)
+    {
+        ClipToBoundingBox(points, points_tmp, &numPoints, clipSpaceBox);
+    }
 
     if (numPoints >= 3)
     {
@@ -316,142 +604,116 @@ void GeoDecalManager::AddVerticesToGeometry(const DecalBuildInfo& info, const De
 
 void GeoDecalManager::GetStaticMeshGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer)
 {
-    uint8 decalVertexData[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)] = {};
-    DecalVertex* points = reinterpret_cast<DecalVertex*>(decalVertexData);
-
-    uint8 decalVertexData_tmp[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)] = {};
-    DecalVertex* points_tmp = reinterpret_cast<DecalVertex*>(decalVertexData_tmp);
-
     Vector<uint16> triangles;
     triangles.reserve(512);
     info.polygonGroup->GetGeometryOctTree()->GetTrianglesInBox(info.boundingBox, triangles);
 
-    int32 geometryFormat = info.polygonGroup->GetFormat();
+    VertexStreamLayout layout(info.polygonGroup);
 
-    for (uint16 triangleIndex : triangles)
+    Vector<uint16> vertexIndices(3 * triangles.size());
+    Vector<Vector3> actualPoints(3 * triangles.size());
+    for (size_t i = 0, e = triangles.size(); i < e; ++i)
     {
-        uint16 idx[3];
-        info.polygonGroup->GetTriangleIndices(3 * triangleIndex, idx);
-        info.polygonGroup->GetCoord(idx[0], points[0].originalPoint);
-        info.polygonGroup->GetCoord(idx[1], points[1].originalPoint);
-        info.polygonGroup->GetCoord(idx[2], points[2].originalPoint);
-        points[0].actualPoint = points[0].originalPoint;
-        points[1].actualPoint = points[1].originalPoint;
-        points[2].actualPoint = points[2].originalPoint;
-
-        if (geometryFormat & EVF_TEXCOORD0)
-        {
-            info.polygonGroup->GetTexcoord(0, idx[0], points[0].texCoord0);
-            info.polygonGroup->GetTexcoord(0, idx[1], points[1].texCoord0);
-            info.polygonGroup->GetTexcoord(0, idx[2], points[2].texCoord0);
-        }
-        if (geometryFormat & EVF_TEXCOORD1)
-        {
-            info.polygonGroup->GetTexcoord(1, idx[0], points[0].texCoord1);
-            info.polygonGroup->GetTexcoord(1, idx[1], points[1].texCoord1);
-            info.polygonGroup->GetTexcoord(1, idx[2], points[2].texCoord1);
-        }
-        if (geometryFormat & EVF_TEXCOORD2)
-        {
-            info.polygonGroup->GetTexcoord(2, idx[0], points[0].texCoord2);
-            info.polygonGroup->GetTexcoord(2, idx[1], points[1].texCoord2);
-            info.polygonGroup->GetTexcoord(2, idx[2], points[2].texCoord2);
-        }
-        if (geometryFormat & EVF_NORMAL)
-        {
-            info.polygonGroup->GetNormal(idx[0], points[0].normal);
-            info.polygonGroup->GetNormal(idx[1], points[1].normal);
-            info.polygonGroup->GetNormal(idx[2], points[2].normal);
-        }
-        if (geometryFormat & EVF_TANGENT)
-        {
-            info.polygonGroup->GetTangent(idx[0], points[0].tangent);
-            info.polygonGroup->GetTangent(idx[1], points[1].tangent);
-            info.polygonGroup->GetTangent(idx[2], points[2].tangent);
-        }
-        if (geometryFormat & EVF_BINORMAL)
+        info.polygonGroup->GetTriangleIndices(3 * triangles[i], vertexIndices.data() + 3 * i);
+        for (size_t j = 3 * i; j < 3 * i + 3; ++j)
         {
-            info.polygonGroup->GetBinormal(idx[0], points[0].binormal);
-            info.polygonGroup->GetBinormal(idx[1], points[1].binormal);
-            info.polygonGroup->GetBinormal(idx[2], points[2].binormal);
-        }
-        Vector3 nrm = (points[1].actualPoint - points[0].actualPoint).CrossProduct(points[2].actualPoint - points[0].actualPoint);
-        if ((config.mapping != Mapping::PLANAR) || (nrm.DotProduct(info.projectionAxis) < -std::numeric_limits<float>::epsilon()))
-        {
-            AddVerticesToGeometry(info, config, points, points_tmp, buffer);
+            layout.Read(layout.vertexData + vertexIndices[j] * layout.vertexStride, layout.coordOffset, actualPoints[j]);
         }
     }
+
+    AddTrianglesToGeometry(info, config, layout, vertexIndices, actualPoints, buffer);
 }
 
 void GeoDecalManager::GetSkinnedMeshGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer)
 {
-    SkinnedMesh* mesh = static_cast<SkinnedMesh*>(info.renderObject);
-    const SkinnedMesh::JointTargetsData& jointTargetsData = mesh->GetJointTargetsData(info.sourceBatch);
+    const SkinnedMesh::JointTargetsData& jointTargetsData = *info.jointTargetsData;
 
-    const AABBox3 clipSpaceBox = AABBox3(Vector3(0.0f, 0.0f, 0.0f), 2.0f);
+    VertexStreamLayout layout(info.polygonGroup);
+
+    uint32 indexCount = 3 * static_cast<uint32>(info.polygonGroup->GetIndexCount() / 3);
+    Vector<uint16> vertexIndices(indexCount);
+    Vector<Vector3> actualPoints(indexCount);
+    for (uint32 i = 0; i < indexCount; i += 3)
+    {
+        info.polygonGroup->GetTriangleIndices(i, vertexIndices.data() + i);
+    }
 
-    uint8 decalVertexData[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)];
+    for (uint32 i = 0; i < indexCount; ++i)
+    {
+        const uint8* vertex = layout.vertexData + vertexIndices[i] * layout.vertexStride;
+
+        Vector3 originalPoint;
+        float32 jointIndexValue = 0.0f;
+        layout.Read(vertex, layout.coordOffset, originalPoint);
+        layout.Read(vertex, layout.hardJointIndexOffset, jointIndexValue);
+        int32 jointIndex = static_cast<int32>(jointIndexValue);
+
+        Vector4 weightedVertexPosition = jointTargetsData.positions[jointIndex];
+        Vector4 weightedVertexQuaternion = jointTargetsData.quaternions[jointIndex];
+        Vector3 tmpVec = 2.0f * weightedVertexQuaternion.GetVector3().CrossProduct(originalPoint);
+        actualPoints[i] = weightedVertexPosition.GetVector3() + weightedVertexPosition.w *
+        (originalPoint + weightedVertexQuaternion.w * tmpVec + weightedVertexQuaternion.GetVector3().CrossProduct(tmpVec));
+    }
+
+    AddTrianglesToGeometry(info, config, layout, vertexIndices, actualPoints, buffer);
+}
+
+void GeoDecalManager::AddTrianglesToGeometry(const DecalBuildInfo& info, const DecalConfig& config, const VertexStreamLayout& layout,
+                                             const Vector<uint16>& vertexIndices, const Vector<Vector3>& actualPoints, Vector<uint8>& buffer)
+{
+    using namespace GeoDecalManagerDetails;
+
+    uint32 vertexCount = static_cast<uint32>(actualPoints.size());
+    uint32 triangleCount = vertexCount / 3;
+    if (triangleCount == 0)
+        return;
+
+    Vector<float32> clipSpaceStreams(3 * vertexCount);
+    float32* x = clipSpaceStreams.data();
+    float32* y = x + vertexCount;
+    float32* z = y + vertexCount;
+    for (uint32 i = 0; i < vertexCount; ++i)
+    {
+        Vector3 p = actualPoints[i] * info.projectionSpaceTransform;
+        x[i] = p.x;
+        y[i] = p.y;
+        z[i] = p.z;
+    }
+
+    Vector<uint8> triangleClasses(triangleCount);
+    ClassifyTriangles(x, y, z, triangleCount, triangleClasses.data());
+
+    uint8 decalVertexData[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)] = {};
     DecalVertex* points = reinterpret_cast<DecalVertex*>(decalVertexData);
-    uint8 decalVertexData_tmp[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)];
-    DecalVertex* points_tmp = reinterpret_cast<DecalVertex*>(decalVertexData_tmp);
 
-    int32 geometryFormat = info.polygonGroup->GetFormat();
+    uint8 decalVertexData_tmp[MAX_CLIPPED_POLYGON_CAPACITY * sizeof(DecalVertex)] = {};
+    DecalVertex* points_tmp = reinterpret_cast<DecalVertex*>(decalVertexData_tmp);
 
-    uint32 triangleCount = static_cast<uint32>(info.polygonGroup->GetIndexCount() / 3);
-    for (uint32 triangleIndex = 0; triangleIndex < triangleCount; ++triangleIndex)
+    for (uint32 t = 0; t < triangleCount; ++t)
     {
-        uint16 idx[3];
-        info.polygonGroup->GetTriangleIndices(3 * triangleIndex, idx);
-        for (int32 j = 0; j < 3; ++j)
-        {
-            info.polygonGroup->GetCoord(idx[j], points[j].originalPoint);
-
-            if (geometryFormat & EVF_TEXCOORD0)
-                info.polygonGroup->GetTexcoord(0, idx[j], points[j].texCoord0);
-            if (geometryFormat & EVF_TEXCOORD1)
-                info.polygonGroup->GetTexcoord(1, idx[j], points[j].texCoord1);
-            if (geometryFormat & EVF_TEXCOORD2)
-                info.polygonGroup->GetTexcoord(2, idx[j], points[j].texCoord2);
-            if (geometryFormat & EVF_NORMAL)
-                info.polygonGroup->GetNormal(idx[j], points[j].normal);
-            if (geometryFormat & EVF_TANGENT)
-                info.polygonGroup->GetTangent(idx[j], points[j].tangent);
-            if (geometryFormat & EVF_BINORMAL)
-                info.polygonGroup->GetBinormal(idx[j], points[j].binormal);
-
-            info.polygonGroup->GetHardJointIndex(idx[j], points[j].jointIndex);
-
-            Vector4 weightedVertexPosition = jointTargetsData.positions[points[j].jointIndex];
-            Vector4 weightedVertexQuaternion = jointTargetsData.quaternions[points[j].jointIndex];
-            Vector3 tmpVec = 2.0f * weightedVertexQuaternion.GetVector3().CrossProduct(points[j].originalPoint);
-            points[j].actualPoint = weightedVertexPosition.GetVector3() + weightedVertexPosition.w *
-            (points[j].originalPoint + weightedVertexQuaternion.w * tmpVec + weightedVertexQuaternion.GetVector3().CrossProduct(tmpVec));
-        }
+        if (triangleClasses[t] == TRIANGLE_OUTSIDE)
+            continue;
+
+        const Vector3* p = actualPoints.data() + 3 * t;
+        Vector3 nrm = (p[1] - p[0]).CrossProduct(p[2] - p[0]);
+        if ((config.mapping == Mapping::PLANAR) && (nrm.DotProduct(info.projectionAxis) >= -std::numeric_limits<float>::epsilon()))
+            continue;
 
-        if (Intersection::BoxTriangle(info.boundingBox, points[2].actualPoint, points[1].actualPoint, points[0].actualPoint))
+        for (uint32 j = 0; j < 3; ++j)
         {
-            Vector3 nrm = (points[1].actualPoint - points[0].actualPoint).CrossProduct(points[2].actualPoint - points[0].actualPoint);
-            if ((config.mapping != Mapping::PLANAR) || (nrm.DotProduct(info.projectionAxis) < -std::numeric_limits<float>::epsilon()))
-            {
-                AddVerticesToGeometry(info, config, points, points_tmp, buffer);
-            }
+            uint32 v = 3 * t + j;
+            ReadVertex(layout, vertexIndices[v], points[j]);
+            points[j].actualPoint = Vector3(x[v], y[v], z[v]);
         }
+
+        AddVerticesToGeometry(config, points, points_tmp, triangleClasses[t] == TRIANGLE_INTERSECTS, buffer);
     }
 }
 
-bool GeoDecalManager::BuildDecal(const DecalBuildInfo& info, const DecalConfig& config, RenderBatchProvider* batchProvider)
+bool GeoDecalManager::BuildDecalGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer)
 {
-    if (info.polygonGroup == nullptr)
-        return false;
-
-    const FastName& effectiveFxName = info.material->GetEffectiveFXName();
-
-    if ((effectiveFxName == NMaterialName::SILHOUETTE) || (effectiveFxName == NMaterialName::SHADOW_VOLUME))
-        return false;
-
     int32 geometryFormat = info.polygonGroup->GetFormat();
 
-    Vector<uint8_t> buffer;
     buffer.reserve(3 * sizeof(DecalVertex) * info.polygonGroup->GetIndexCount());
     if (info.useSkinning)
     {
@@ -470,11 +732,15 @@ bool GeoDecalManager::BuildDecal(const DecalBuildInfo& info, const DecalConfig&
         GetStaticMeshGeometry(info, config, buffer);
     }
 
-    if (buffer.empty())
-        return false;
+    return !buffer.empty();
+}
+
+void GeoDecalManager::CreateDecalBatches(const DecalBuildInfo& info, const DecalConfig& config, const Vector<uint8>& buffer, RenderBatchProvider* batchProvider)
+{
+    int32 geometryFormat = info.polygonGroup->GetFormat();
 
     uint32 decalVertexCount = static_cast<uint32>(buffer.size() / sizeof(DecalVertex));
-    const DecalVertex* decalVertexPtr = reinterpret_cast<DecalVertex*>(buffer.data());
+    const DecalVertex* decalVertexPtr = reinterpret_cast<const DecalVertex*>(buffer.data());
 
     ScopedPtr<PolygonGroup> newPolygonGroup(new PolygonGroup());
     newPolygonGroup->AllocateData(geometryFormat | EVF_TEXCOORD3, decalVertexCount, decalVertexCount);
@@ -593,8 +859,6 @@ bool GeoDecalManager::BuildDecal(const DecalBuildInfo& info, const DecalConfig&
             mesh->SetJointTargets(debugBatch, mesh->GetJointTargets(info.sourceBatch));
         }
     }
-
-    return true;
 }
 
 int32_t GeoDecalManager::Classify(int32_t sign, Vector3::eAxis axis, const Vector3& c_v, const DecalVertex& p_v)
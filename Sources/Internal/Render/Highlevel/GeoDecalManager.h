@@ -4,6 +4,7 @@
 #include "FileSystem/FilePath.h"
 #include "Math/AABBox3.h"
 #include <atomic>
+#include <memory>
 
 namespace DAVA
 {
@@ -56,12 +57,27 @@ public:
     static const Decal InvalidDecal;
 
 public:
-    GeoDecalManager() = default;
+    GeoDecalManager();
     ~GeoDecalManager();
 
     Decal BuildDecal(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object);
     void DeleteDecal(Decal decal);
 
+    /*
+     * Same as BuildDecal, but decal geometry is built in worker thread.
+     * Returned decal is valid immediately and could be deleted at any moment,
+     * it becomes visible on first ApplyBuiltDecals call after its geometry is built.
+     * Geometry of render object should not be modified while decal is building.
+     */
+    Decal BuildDecalAsync(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object);
+
+    /*
+     * Creates render batches for decals built in worker threads. Should be called from main thread.
+     */
+    void ApplyBuiltDecals();
+
+    bool IsDecalBuilding(Decal decal) const;
+
     /*
      * Removes all decals associated with provided RenderObject
      */
@@ -70,6 +86,8 @@ public:
 private:
     struct DecalVertex;
     struct DecalBuildInfo;
+    struct DecalBuildJob;
+    struct VertexStreamLayout;
 
     struct BuiltDecal
     {
@@ -88,7 +106,12 @@ private:
     void RegisterDecal(Decal decal);
     void UnregisterDecal(Decal decal);
 
-    bool BuildDecal(const DecalBuildInfo& info, const DecalConfig& config, RenderBatchProvider* provider);
+    Decal CreateDecalHandle();
+    void InitBuildInfo(const DecalConfig& config, const Matrix4& decalWorldTransform, RenderObject* object, DecalBuildInfo& info);
+    bool InitBatchBuildInfo(RenderObject* object, uint32 batchIndex, DecalBuildInfo& info);
+
+    bool BuildDecalGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer);
+    void CreateDecalBatches(const DecalBuildInfo& info, const DecalConfig& config, const Vector<uint8>& buffer, RenderBatchProvider* provider);
     void ClipToPlane(DecalVertex* p_vs, DecalVertex* p_vs_out, uint32* nb_p_vs, int32 sign, Vector3::eAxis axis, const Vector3& c_v);
     void ClipToBoundingBox(DecalVertex* p_vs, DecalVertex* p_out, uint32* nb_p_vs, const AABBox3& clipper);
     int32 Classify(int32 sign, Vector3::eAxis axis, const Vector3& c_v, const DecalVertex& p_v);
@@ -96,10 +119,14 @@ private:
 
     void GetStaticMeshGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer);
     void GetSkinnedMeshGeometry(const DecalBuildInfo& info, const DecalConfig& config, Vector<uint8>& buffer);
-    void AddVerticesToGeometry(const DecalBuildInfo& info, const DecalConfig& config, DecalVertex* points, DecalVertex* points_tmp, Vector<uint8>& buffer);
+    void AddTrianglesToGeometry(const DecalBuildInfo& info, const DecalConfig& config, const VertexStreamLayout& layout,
+                                const Vector<uint16>& vertexIndices, const Vector<Vector3>& actualPoints, Vector<uint8>& buffer);
+    void AddVerticesToGeometry(const DecalConfig& config, DecalVertex* points, DecalVertex* points_tmp, bool clipToBox, Vector<uint8>& buffer);
+    void ReadVertex(const VertexStreamLayout& layout, uint32 index, DecalVertex& vertex);
 
 private:
     Map<Decal, BuiltDecal> builtDecals;
+    Map<Decal, std::unique_ptr<DecalBuildJob>> buildingDecals;
     std::atomic<uintptr_t> decalCounter{ 0 };
 };
 
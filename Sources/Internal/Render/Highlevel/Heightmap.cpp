@@ -7,9 +7,113 @@
 #include "FileSystem/FileSystem.h"
 #include "Utils/Utils.h"
 #include "Logger/Logger.h"
+#include "Compression/ZipCompressor.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
+namespace HeightmapDetails
+{
+// Median edge detector from LOCO-I, works well for smooth terrain with ridges
+inline int32 PredictHeight(int32 left, int32 top, int32 topLeft)
+{
+    if (topLeft >= Max(left, top))
+        return Min(left, top);
+    if (topLeft <= Min(left, top))
+        return Max(left, top);
+    return left + top - topLeft;
+}
+
+// Prediction uses only heights of the same tile, so tiles are decoded independently
+inline int32 PredictHeight(const uint16* tileData, int32 pitch, int32 x, int32 y)
+{
+    if (y == 0)
+        return (x == 0) ? 0 : tileData[x - 1];
+    if (x == 0)
+        return tileData[(y - 1) * pitch];
+
+    const uint16* row = tileData + y * pitch;
+    return PredictHeight(row[x - 1], row[x - pitch], row[x - pitch - 1]);
+}
+
+// Residuals are zigzag-coded, so small negative and positive values both have zero high byte
+inline uint16 EncodeResidual(int32 height, int32 predicted)
+{
+    int32 residual = int16(uint16(height - predicted));
+    return uint16((uint32(residual) << 1) ^ uint32(residual >> 15));
+}
+
+inline uint16 DecodeHeight(uint16 encoded, int32 predicted)
+{
+    int32 residual = int32(encoded >> 1) ^ -int32(encoded & 1);
+    return uint16(predicted + residual);
+}
+
+// Size of tile with this flag in sizes table means that tile planes are stored without deflate
+const uint32 RAW_TILE_FLAG = 1u << 31;
+
+// Returns false if planes can't be deflated, in this case `compressed` contains raw planes
+bool CompressTile(const uint16* tileData, int32 pitch, int32 tileSize, Vector<uint8>& compressed)
+{
+    //high and low bytes of residuals are stored in separate planes, high bytes are mostly zero and compress well
+    uint32 count = uint32(tileSize * tileSize);
+    Vector<uint8> planes(count * 2);
+    for (int32 y = 0, i = 0; y < tileSize; ++y)
+    {
+        for (int32 x = 0; x < tileSize; ++x, ++i)
+        {
+            uint16 encoded = EncodeResidual(tileData[y * pitch + x], PredictHeight(tileData, pitch, x, y));
+            planes[i] = uint8(encoded >> 8);
+            planes[count + i] = uint8(encoded & 0xFF);
+        }
+    }
+
+    if (ZipCompressor().Compress(planes, compressed))
+        return true;
+
+    compressed = std::move(planes);
+    return false;
+}
+
+bool DecompressTile(const Vector<uint8>& compressed, bool isRaw, uint16* tileData, int32 pitch, int32 tileSize)
+{
+    uint32 count = uint32(tileSize * tileSize);
+    Vector<uint8> planes(count * 2);
+    if (isRaw)
+    {
+        if (compressed.size() != planes.size())
+            return false;
+        planes = compressed;
+    }
+    else if (!ZipCompressor().Decompress(compressed, planes) || planes.size() != count * 2)
+    {
+        return false;
+    }
+
+    for (int32 y = 0, i = 0; y < tileSize; ++y)
+    {
+        for (int32 x = 0; x < tileSize; ++x, ++i)
+        {
+            uint16 encoded = uint16((planes[i] << 8) | planes[count + i]);
+            tileData[y * pitch + x] = DecodeHeight(encoded, PredictHeight(tileData, pitch, x, y));
+        }
+    }
+
+    return true;
+}
+
+struct DecompressState
+{
+    Atomic<uint32> nextTile;
+    Atomic<uint32> doneTiles;
+    Atomic<bool> failed{ false };
+};
+}
+
 DAVA_VIRTUAL_REFLECTION_IMPL(Heightmap)
 {
     ReflectionRegistrator<Heightmap>::Begin()
@@ -126,26 +230,52 @@ void Heightmap::Save(const FilePath& filePathname)
         return;
     }
 
-    file->Write(&size, sizeof(size));
-    file->Write(&tileSize, sizeof(tileSize));
+    using namespace HeightmapDetails;
 
-    if (size && tileSize)
+    //file format: signature, version, size, tile size, compressed size of each tile (RAW_TILE_FLAG for not deflated tile), tiles data, tangent basis data
+    int32 encodeTileSize = (tileSize > 0 && (size % tileSize) == 0) ? Min(tileSize, size) : size;
+    int32 blockCount = size / encodeTileSize;
+
+    Vector<Vector<uint8>> compressedTiles(blockCount * blockCount);
+    Vector<uint32> compressedSizes(blockCount * blockCount);
+    for (int32 iRow = 0; iRow < blockCount; ++iRow)
     {
-        int32 blockCount = size / tileSize;
-        for (int32 iRow = 0; iRow < blockCount; ++iRow)
+        for (int32 iCol = 0; iCol < blockCount; ++iCol)
         {
-            for (int32 iCol = 0; iCol < blockCount; ++iCol)
+            int32 tileIndex = iRow * blockCount + iCol;
+            const uint16* tileData = data + iRow * size * encodeTileSize + iCol * encodeTileSize;
+            if (CompressTile(tileData, size, encodeTileSize, compressedTiles[tileIndex]))
             {
-                int32 tileY = iRow * size * tileSize;
-                int32 tileX = iCol * tileSize;
-                for (int32 iTileRow = 0; iTileRow < tileSize; ++iTileRow, tileY += size)
-                {
-                    file->Write(data + tileY + tileX, tileSize * sizeof(data[0]));
-                }
+                compressedSizes[tileIndex] = uint32(compressedTiles[tileIndex].size());
+            }
+            else
+            {
+                Logger::Warning("Heightmap::Save failed to compress tile %d, tile is saved uncompressed: %s", tileIndex, filePathname.GetAbsolutePathname().c_str());
+                compressedSizes[tileIndex] = uint32(compressedTiles[tileIndex].size()) | RAW_TILE_FLAG;
             }
         }
     }
 
+    uint32 signature = FILE_SIGNATURE;
+    uint32 version = FILE_VERSION;
+    file->Write(&signature);
+    file->Write(&version);
+    file->Write(&size);
+    file->Write(&encodeTileSize);
+    file->Write(compressedSizes.data(), uint32(compressedSizes.size() * sizeof(uint32)));
+    for (const Vector<uint8>& tile : compressedTiles)
+    {
+        file->Write(tile.data(), uint32(tile.size()));
+    }
+
+    uint32 tangentBasisDataSize = uint32(tangentBasisData.size());
+    file->Write(&tangentBasisDataSize);
+    if (tangentBasisDataSize != 0)
+    {
+        file->Write(&tangentBasisBBoxSize);
+        file->Write(tangentBasisData.data(), tangentBasisDataSize);
+    }
+
     SafeRelease(file);
 }
 
@@ -164,11 +294,26 @@ bool Heightmap::Load(const FilePath& filePathname)
         return false;
     }
 
-    int32 mapSize = 0, mapTileSize = 0;
+    uint32 signature = 0;
+    file->Read(&signature);
+    if (signature == FILE_SIGNATURE)
+    {
+        bool loaded = LoadCompressed(file);
+        SafeRelease(file);
+
+        if (!loaded)
+        {
+            Logger::Error("Heightmap::Load failed to read file: %s", filePathname.GetAbsolutePathname().c_str());
+        }
+        return loaded;
+    }
 
-    file->Read(&mapSize, sizeof(mapSize));
+    //uncompressed tiles, first value is map size
+    int32 mapSize = int32(signature), mapTileSize = 0;
     file->Read(&mapTileSize, sizeof(mapTileSize));
 
+    ReleaseTangentBasisData();
+
     if (mapSize && mapTileSize)
     {
         if (!IsPowerOf2(mapSize))
@@ -231,6 +376,141 @@ void Heightmap::LoadNotPow2(File* file, int32 readMapSize, int32 readTileSize)
     SafeDeleteArray(tileRowData);
 }
 
+bool Heightmap::LoadCompressed(File* file)
+{
+    using namespace HeightmapDetails;
+
+    uint32 version = 0;
+    int32 mapSize = 0, mapTileSize = 0;
+    file->Read(&version);
+    file->Read(&mapSize);
+    file->Read(&mapTileSize);
+
+    if (version != FILE_VERSION || mapSize <= 0 || mapSize > 65536 || !IsPowerOf2(mapSize) || mapTileSize <= 0 || mapTileSize > mapSize || !IsPowerOf2(mapTileSize))
+    {
+        return false;
+    }
+
+    uint32 blockCount = uint32(mapSize / mapTileSize);
+    uint32 tilesCount = blockCount * blockCount;
+
+    Vector<uint32> compressedSizes(tilesCount);
+    uint32 sizesDataSize = tilesCount * sizeof(uint32);
+    if (file->Read(compressedSizes.data(), sizesDataSize) != sizesDataSize)
+    {
+        return false;
+    }
+
+    uint64 compressedDataSize = 0;
+    for (uint32 compressedSize : compressedSizes)
+    {
+        compressedDataSize += compressedSize & ~RAW_TILE_FLAG;
+    }
+    if (compressedDataSize > file->GetSize() - file->GetPos())
+    {
+        return false;
+    }
+
+    Vector<Vector<uint8>> compressedTiles(tilesCount);
+    for (uint32 i = 0; i < tilesCount; ++i)
+    {
+        uint32 compressedSize = compressedSizes[i] & ~RAW_TILE_FLAG;
+        compressedTiles[i].resize(compressedSize);
+        if (file->Read(compressedTiles[i].data(), compressedSize) != compressedSize)
+        {
+            return false;
+        }
+    }
+
+    ReallocateData(mapSize);
+    SetTileSize(mapTileSize);
+
+    std::shared_ptr<DecompressState> state = std::make_shared<DecompressState>();
+    uint16* heightData = data;
+    auto decompressTiles = [state, tilesCount, blockCount, mapSize, mapTileSize, heightData, &compressedTiles, &compressedSizes]()
+    {
+        for (uint32 tile = state->nextTile++; tile < tilesCount; tile = state->nextTile++)
+        {
+            uint32 iRow = tile / blockCount;
+            uint32 iCol = tile % blockCount;
+            uint16* tileData = heightData + iRow * mapSize * mapTileSize + iCol * mapTileSize;
+            bool isRaw = (compressedSizes[tile] & RAW_TILE_FLAG) != 0;
+            if (!DecompressTile(compressedTiles[tile], isRaw, tileData, mapSize, mapTileSize))
+            {
+                state->failed = true;
+            }
+            state->doneTiles++;
+        }
+    };
+
+    JobManager* jobManager = (GetEngineContext() != nullptr) ? GetEngineContext()->jobManager : nullptr;
+    uint32 jobCount = (jobManager != nullptr) ? Min(jobManager->GetWorkersCount(), tilesCount - 1) : 0;
+    for (uint32 i = 0; i < jobCount; ++i)
+    {
+        jobManager->CreateWorkerJob(decompressTiles);
+    }
+
+    decompressTiles();
+
+    while (state->doneTiles.Get() < tilesCount)
+    {
+        Thread::Yield();
+    }
+
+    ReleaseTangentBasisData();
+
+    uint32 tangentBasisDataSize = 0;
+    if (file->Read(&tangentBasisDataSize) == sizeof(uint32) && tangentBasisDataSize != 0 && tangentBasisDataSize <= file->GetSize() - file->GetPos())
+    {
+        tangentBasisData.resize(tangentBasisDataSize);
+        if (file->Read(&tangentBasisBBoxSize) != sizeof(Vector3) || file->Read(tangentBasisData.data(), tangentBasisDataSize) != tangentBasisDataSize)
+        {
+            ReleaseTangentBasisData();
+        }
+    }
+
+    return !state->failed.Get();
+}
+
+void Heightmap::SetTangentBasisData(const Vector3& bboxSize, const Vector<uint32>& basisData)
+{
+    DVASSERT(basisData.size() == size_t(size * size));
+
+    const uint8* bytes = reinterpret_cast<const uint8*>(basisData.data());
+    Vector<uint8> rawData(bytes, bytes + basisData.size() * sizeof(uint32));
+
+    tangentBasisBBoxSize = bboxSize;
+    if (!ZipCompressor().Compress(rawData, tangentBasisData))
+    {
+        ReleaseTangentBasisData();
+    }
+}
+
+bool Heightmap::GetTangentBasisData(const Vector3& bboxSize, Vector<uint32>& basisData) const
+{
+    if (tangentBasisData.empty() || bboxSize != tangentBasisBBoxSize)
+    {
+        return false;
+    }
+
+    uint32 rawDataSize = uint32(size * size * sizeof(uint32));
+    Vector<uint8> rawData(rawDataSize);
+    if (!ZipCompressor().Decompress(tangentBasisData, rawData) || rawData.size() != rawDataSize)
+    {
+        return false;
+    }
+
+    basisData.resize(size * size);
+    Memcpy(basisData.data(), rawData.data(), rawDataSize);
+    return true;
+}
+
+void Heightmap::ReleaseTangentBasisData()
+{
+    tangentBasisData.clear();
+    tangentBasisData.shrink_to_fit();
+}
+
 Heightmap* Heightmap::Clone(DAVA::Heightmap* clonedHeightmap)
 {
     Heightmap* createdHeightmap = (clonedHeightmap == nullptr) ? new Heightmap() : clonedHeightmap;
@@ -240,6 +520,9 @@ Heightmap* Heightmap::Clone(DAVA::Heightmap* clonedHeightmap)
 
         memcpy(createdHeightmap->data, data, size * size * sizeof(uint16));
         createdHeightmap->SetTileSize(tileSize); // TODO: is it true?
+
+        createdHeightmap->tangentBasisData = tangentBasisData;
+        createdHeightmap->tangentBasisBBoxSize = tangentBasisBBoxSize;
     }
 
     return createdHeightmap;
@@ -15,12 +15,20 @@ protected:
 public:
     static const int32 MAX_VALUE = 65535;
     static const int32 IMAGE_CORRECTION = MAX_VALUE / 255;
+    static const uint32 FILE_SIGNATURE = DAVA_MAKEFOURCC('D', 'V', 'H', 'M');
+    static const uint32 FILE_VERSION = 1;
 
     Heightmap(int32 size = 0);
 
     bool BuildFromImage(const Image* image);
     void SaveToImage(const FilePath& filename);
 
+    /**
+        Heightmap is saved by tiles, each tile is compressed independently: heights are replaced by residuals
+        of prediction from neighbour heights and then deflated. Tile which fails to deflate is saved with raw residuals.
+        Tiles are decompressed in worker jobs on load.
+        Files with uncompressed tiles are loaded too.
+    */
     virtual void Save(const FilePath& filePathname);
     virtual bool Load(const FilePath& filePathname);
 
@@ -37,17 +45,29 @@ public:
 
     Heightmap* Clone(Heightmap* clonedHeightmap);
 
+    /**
+        Tangent basis texture data (RGBA8888 for each height) precomputed for heightmap scaled to `bboxSize`.
+        Data is saved with heightmap and kept compressed in memory until released.
+    */
+    void SetTangentBasisData(const Vector3& bboxSize, const Vector<uint32>& basisData);
+    bool GetTangentBasisData(const Vector3& bboxSize, Vector<uint32>& basisData) const;
+    void ReleaseTangentBasisData();
+
     static const String& FileExtension();
 
 protected:
     void ReallocateData(int32 newSize);
 
     DAVA_DEPRECATED(void LoadNotPow2(File* file, int32 readMapSize, int32 readTileSize));
+    bool LoadCompressed(File* file);
 
     uint16* data = nullptr;
     int32 size = 0;
     int32 tileSize = 16;
 
+    Vector<uint8> tangentBasisData; //compressed
+    Vector3 tangentBasisBBoxSize;
+
     static String FILE_EXTENSION;
 
     DAVA_VIRTUAL_REFLECTION(Heightmap, BaseObject);
@@ -344,6 +344,9 @@ void Landscape::AllocateGeometryData()
     subdivision->BuildSubdivision(heightmap, bbox, PATCH_SIZE_QUADS, minSubdivLevel, (renderMode == RENDERMODE_INSTANCING_MORPHING));
 
     (renderMode == RENDERMODE_NO_INSTANCING) ? AllocateGeometryDataNoInstancing() : AllocateGeometryDataInstancing();
+
+    //precomputed basis is valid only until heightmap is modified, later updates calculate it
+    heightmap->ReleaseTangentBasisData();
 }
 
 void Landscape::RebuildLandscape()
@@ -543,33 +546,45 @@ Vector<Image*> Landscape::CreateTangentBasisTextureData()
 
     Vector<Image*> dataOut;
     {
-        uint32* normalTangntData = new uint32[hmSize * hmSize]; //RGBA8888
-        uint8* normalTangntDataPtr = reinterpret_cast<uint8*>(normalTangntData);
-
-        Vector3 normal, tangent;
-        for (uint32 y = 0; y < hmSize; ++y)
+        //basis precomputed on save is used if landscape size wasn't changed since
+        Vector<uint32> normalTangentData; //RGBA8888
+        if (!heightmap->GetTangentBasisData(bbox.GetSize(), normalTangentData))
         {
-            for (uint32 x = 0; x < hmSize; ++x)
-            {
-                GetTangentBasis(x, y, normal, tangent);
-
-                normal = normal * 0.5f + 0.5f;
-                tangent = tangent * 0.5 + 0.5f;
-
-                *normalTangntDataPtr++ = uint8(normal.x * 255.f);
-                *normalTangntDataPtr++ = uint8(normal.y * 255.f);
-                *normalTangntDataPtr++ = uint8(tangent.y * 255.f);
-                *normalTangntDataPtr++ = uint8(tangent.z * 255.f);
-            }
+            CalculateTangentBasisData(normalTangentData);
         }
 
-        Image* basisImage = Image::CreateFromData(hmSize, hmSize, FORMAT_RGBA8888, reinterpret_cast<uint8*>(normalTangntData));
+        Image* basisImage = Image::CreateFromData(hmSize, hmSize, FORMAT_RGBA8888, reinterpret_cast<const uint8*>(normalTangentData.data()));
         dataOut.push_back(basisImage);
     }
 
     return dataOut;
 }
 
+void Landscape::CalculateTangentBasisData(Vector<uint32>& basisData) const
+{
+    const uint32 hmSize = GetHeightmapSize();
+
+    basisData.resize(hmSize * hmSize);
+    uint8* normalTangntDataPtr = reinterpret_cast<uint8*>(basisData.data());
+
+    Vector3 normal, tangent;
+    for (uint32 y = 0; y < hmSize; ++y)
+    {
+        for (uint32 x = 0; x < hmSize; ++x)
+        {
+            GetTangentBasis(x, y, normal, tangent);
+
+            normal = normal * 0.5f + 0.5f;
+            tangent = tangent * 0.5 + 0.5f;
+
+            *normalTangntDataPtr++ = uint8(normal.x * 255.f);
+            *normalTangntDataPtr++ = uint8(normal.y * 255.f);
+            *normalTangntDataPtr++ = uint8(tangent.y * 255.f);
+            *normalTangntDataPtr++ = uint8(tangent.z * 255.f);
+        }
+    }
+}
+
 void Landscape::GetTangentBasis(uint32 x, uint32 y, Vector3& normalOut, Vector3& tangentOut) const
 {
     DVASSERT(heightmap);
@@ -673,6 +688,65 @@ bool Landscape::PlacePoint(const Vector3& worldPoint, Vector3& result, Vector3*
     return true;
 };
 
+void Landscape::GetOccluderGeometry(uint32 gridSize, Vector<Vector3>& positions, Vector<uint32>& indices) const
+{
+    positions.clear();
+    indices.clear();
+    if (gridSize == 0 || heightmap == nullptr || heightmap->Size() == 0)
+    {
+        return;
+    }
+
+    // heights are sampled twice denser than grid
+    const uint32 samplesSize = gridSize * 2 + 1;
+    Vector2 sampleStep((bbox.max.x - bbox.min.x) / float32(samplesSize - 1), (bbox.max.y - bbox.min.y) / float32(samplesSize - 1));
+
+    Vector<float32> samples(samplesSize * samplesSize);
+    for (uint32 y = 0; y < samplesSize; ++y)
+    {
+        for (uint32 x = 0; x < samplesSize; ++x)
+        {
+            Vector3 point(bbox.min.x + sampleStep.x * float32(x), bbox.min.y + sampleStep.y * float32(y), bbox.max.z);
+            float32 height = bbox.min.z;
+            GetHeightAtPoint(point, height);
+            samples[y * samplesSize + x] = height;
+        }
+    }
+
+    positions.reserve((gridSize + 1) * (gridSize + 1));
+    for (uint32 y = 0; y <= gridSize; ++y)
+    {
+        for (uint32 x = 0; x <= gridSize; ++x)
+        {
+            uint32 sampleX = x * 2;
+            uint32 sampleY = y * 2;
+            float32 height = samples[sampleY * samplesSize + sampleX];
+            for (uint32 sy = (sampleY > 0 ? sampleY - 1 : 0); sy <= Min(sampleY + 1, samplesSize - 1); ++sy)
+            {
+                for (uint32 sx = (sampleX > 0 ? sampleX - 1 : 0); sx <= Min(sampleX + 1, samplesSize - 1); ++sx)
+                {
+                    height = Min(height, samples[sy * samplesSize + sx]);
+                }
+            }
+
+            positions.emplace_back(bbox.min.x + sampleStep.x * float32(sampleX), bbox.min.y + sampleStep.y * float32(sampleY), height);
+        }
+    }
+
+    indices.reserve(gridSize * gridSize * 6);
+    for (uint32 y = 0; y < gridSize; ++y)
+    {
+        for (uint32 x = 0; x < gridSize; ++x)
+        {
+            uint32 i00 = y * (gridSize + 1) + x;
+            uint32 i10 = i00 + 1;
+            uint32 i01 = i00 + gridSize + 1;
+            uint32 i11 = i01 + 1;
+            indices.insert(indices.end(), { i00, i10, i11, i00, i11, i01 });
+        }
+    }
+}
+
 void Landscape::AddPatchToRender(uint32 level, uint32 x, uint32 y)
 {
     DVASSERT(level < subdivision->GetLevelCount());
@@ -1432,7 +1506,20 @@ void Landscape::Save(KeyedArchive* archive, SerializationContext* serializationC
 
     if (heightmap != nullptr)
     {
+        //basis is stored only for quality that uses it, otherwise file is saved without basis
+        if (isRequireTangentBasis)
+        {
+            Vector<uint32> tangentBasisData;
+            CalculateTangentBasisData(tangentBasisData);
+            heightmap->SetTangentBasisData(bbox.GetSize(), tangentBasisData);
+        }
+        else
+        {
+            heightmap->ReleaseTangentBasisData();
+        }
+
         heightmap->Save(heightmapPath);
+        heightmap->ReleaseTangentBasisData();
     }
     archive->SetString("hmap", heightmapPath.GetRelativePathname(serializationContext->GetScenePath()));
     archive->SetByteArrayAsType("bbox", bbox);
@@ -1579,6 +1666,11 @@ void Landscape::SetForceMaxSubdiv(bool force)
     subdivision->SetForceMaxSubdivision(force);
 }
 
+void Landscape::SetAsyncSubdivision(bool async)
+{
+    subdivision->SetAsyncSubdivision(async);
+}
+
 void Landscape::SetUpdatable(bool isUpdatable)
 {
     if (updatable != isUpdatable)
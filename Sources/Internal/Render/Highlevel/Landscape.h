@@ -99,6 +99,12 @@ public:
     bool PlacePoint(const Vector3& point, Vector3& result, Vector3* normal = 0) const;
     bool GetHeightAtPoint(const Vector3& point, float&) const;
 
+    /**
+        Builds world space triangle grid of `gridSize` x `gridSize` cells for software occlusion.
+        Each grid vertex takes the lowest height around it, so grid doesn't occlude more than real terrain.
+    */
+    void GetOccluderGeometry(uint32 gridSize, Vector<Vector3>& positions, Vector<uint32>& indices) const;
+
     Heightmap* GetHeightmap();
     virtual void SetHeightmap(Heightmap* height);
 
@@ -121,6 +127,7 @@ public:
     bool IsUpdatable() const;
 
     void SetForceMaxSubdiv(bool force);
+    void SetAsyncSubdivision(bool async);
 
     void SetUseInstancing(bool useInstancing);
     bool IsUseInstancing() const;
@@ -279,6 +286,7 @@ protected:
 
     Texture* CreateTangentTexture();
     Vector<Image*> CreateTangentBasisTextureData();
+    void CalculateTangentBasisData(Vector<uint32>& basisData) const;
 
     void DrawLandscapeInstancing();
     void DrawPatchInstancing(uint32 level, uint32 xx, uint32 yy, const Vector4& neighborLevel, float32 patchMorph = 0.f, const Vector4& neighborMorph = Vector4());
@@ -5,9 +5,74 @@
 #include "Render/RHI/rhi_Public.h"
 #include "Reflection/ReflectionRegistrator.h"
 #include "Reflection/ReflectedMeta.h"
+#include "Concurrency/ManualResetEvent.h"
+#include "Engine/Engine.h"
+#include "Engine/EngineContext.h"
+#include "Job/JobManager.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LANDSCAPE_SUBDIVISION_SSE2 1
+#include <emmintrin.h>
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define LANDSCAPE_SUBDIVISION_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace DAVA
 {
+namespace LandscapeSubdivisionDetails
+{
+// Calculates `outErrors[i] = errors[i] / (Distance(cameraPos, position[i]) * tanFovY)`, `count` should be multiple of four
+void CalculateScreenErrors(const Vector3& cameraPos, float32 tanFovY, const float32* posX, const float32* posY, const float32* posZ, const float32* errors,
+                           uint32 count, float32* outErrors)
+{
+    DVASSERT((count & 3) == 0);
+
+#if defined(LANDSCAPE_SUBDIVISION_SSE2)
+    const __m128 cameraX = _mm_set1_ps(cameraPos.x);
+    const __m128 cameraY = _mm_set1_ps(cameraPos.y);
+    const __m128 cameraZ = _mm_set1_ps(cameraPos.z);
+    const __m128 tan = _mm_set1_ps(tanFovY);
+    for (uint32 i = 0; i < count; i += 4)
+    {
+        __m128 dx = _mm_sub_ps(cameraX, _mm_loadu_ps(posX + i));
+        __m128 dy = _mm_sub_ps(cameraY, _mm_loadu_ps(posY + i));
+        __m128 dz = _mm_sub_ps(cameraZ, _mm_loadu_ps(posZ + i));
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz)));
+        _mm_storeu_ps(outErrors + i, _mm_div_ps(_mm_loadu_ps(errors + i), _mm_mul_ps(distance, tan)));
+    }
+
+#elif defined(LANDSCAPE_SUBDIVISION_NEON)
+    const float32x4_t cameraX = vdupq_n_f32(cameraPos.x);
+    const float32x4_t cameraY = vdupq_n_f32(cameraPos.y);
+    const float32x4_t cameraZ = vdupq_n_f32(cameraPos.z);
+    for (uint32 i = 0; i < count; i += 4)
+    {
+        float32x4_t dx = vsubq_f32(cameraX, vld1q_f32(posX + i));
+        float32x4_t dy = vsubq_f32(cameraY, vld1q_f32(posY + i));
+        float32x4_t dz = vsubq_f32(cameraZ, vld1q_f32(posZ + i));
+        float32x4_t distance = vsqrtq_f32(vaddq_f32(vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy)), vmulq_f32(dz, dz)));
+        vst1q_f32(outErrors + i, vdivq_f32(vld1q_f32(errors + i), vmulq_n_f32(distance, tanFovY)));
+    }
+
+#else
+    for (uint32 i = 0; i < count; ++i)
+    {
+        float32 dx = cameraPos.x - posX[i];
+        float32 dy = cameraPos.y - posY[i];
+        float32 dz = cameraPos.z - posZ[i];
+        outErrors[i] = errors[i] / (std::sqrt(dx * dx + dy * dy + dz * dz) * tanFovY);
+    }
+#endif
+}
+}
+
+struct LandscapeSubdivision::AsyncSubdivisionState
+{
+    SubdivisionContext context;
+    ManualResetEvent done{ false };
+};
+
 DAVA_VIRTUAL_REFLECTION_IMPL(LandscapeSubdivision::SubdivisionMetrics)
 {
     ReflectionRegistrator<SubdivisionMetrics>::Begin()
@@ -45,16 +110,52 @@ bool LandscapeSubdivision::SubdivisionMetrics::operator==(const SubdivisionMetri
     zoomMaxAbsoluteHeightError == other.zoomMaxAbsoluteHeightError;
 }
 
+void LandscapeSubdivision::PatchErrorBatch::Clear()
+{
+    candidateIndex.clear();
+    errorPosX.clear();
+    errorPosY.clear();
+    errorPosZ.clear();
+    absError.clear();
+    centerX.clear();
+    centerY.clear();
+    centerZ.clear();
+    radius.clear();
+    heightError.clear();
+    radiusError.clear();
+}
+
+void LandscapeSubdivision::PatchErrorBatch::Pad()
+{
+    size_t size = candidateIndex.size();
+    if (size == 0)
+        return;
+
+    //padding is filled with last patch, so padded errors are valid values and never used
+    size_t paddedSize = (size + 3) & ~size_t(3);
+    for (Vector<float32>* values : { &errorPosX, &errorPosY, &errorPosZ, &absError, &centerX, &centerY, &centerZ, &radius })
+    {
+        values->resize(paddedSize, values->back());
+    }
+
+    heightError.resize(paddedSize);
+    radiusError.resize(paddedSize);
+}
+
 LandscapeSubdivision::LandscapeSubdivision()
 {
     frustum = new Frustum();
+    asyncFrustum = new Frustum();
 }
 
 LandscapeSubdivision::~LandscapeSubdivision()
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
+    ApplyAsyncSubdivision();
+
     SafeRelease(frustum);
+    SafeRelease(asyncFrustum);
     SafeRelease(heightmap);
 }
 
@@ -62,20 +163,48 @@ void LandscapeSubdivision::ReleaseInternalData()
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
+    ApplyAsyncSubdivision();
+
     subdivLevelInfoArray.clear();
     patchQuadArray.clear();
     subdivPatchArray.clear();
+    asyncPatchArray.clear();
+    subdivisionValid = false;
 
     SafeRelease(heightmap);
 }
 
+void LandscapeSubdivision::SetAsyncSubdivision(bool async)
+{
+    if (!async)
+    {
+        ApplyAsyncSubdivision();
+    }
+
+    asyncSubdivision = async;
+}
+
+void LandscapeSubdivision::ApplyAsyncSubdivision()
+{
+    if (!asyncState)
+        return;
+
+    asyncState->done.Wait();
+
+    subdivPatchArray.swap(asyncPatchArray);
+    updateID = asyncState->context.updateID;
+    terminatedPatchesCount = asyncState->context.terminatedPatchesCount;
+
+    asyncState.reset();
+}
+
 void LandscapeSubdivision::PrepareSubdivision(Camera* camera, const Matrix4* worldTransform)
 {
-    ++updateID;
+    ApplyAsyncSubdivision();
 
     cameraPos = camera->GetPosition();
 
-    frustum->Build((*worldTransform) * camera->GetViewProjMatrix(), rhi::DeviceCaps().isZeroBaseClipRange);
+    Matrix4 viewProjMatrix = (*worldTransform) * camera->GetViewProjMatrix();
 
     float32 fovLerp = Clamp((camera->GetFOV() - metrics.zoomFov) / (metrics.normalFov - metrics.zoomFov), 0.f, 1.f);
     maxHeightError = metrics.zoomMaxHeightError + (metrics.normalMaxHeightError - metrics.zoomMaxHeightError) * fovLerp;
@@ -83,14 +212,73 @@ void LandscapeSubdivision::PrepareSubdivision(Camera* camera, const Matrix4* wor
     maxAbsoluteHeightError = metrics.zoomMaxAbsoluteHeightError + (metrics.normalMaxAbsoluteHeightError - metrics.zoomMaxAbsoluteHeightError) * fovLerp;
 
     tanFovY = tanf(camera->GetFOV() * PI / 360.f) / camera->GetAspect();
-    //used for calculate metrics projection on screen. Projection calculate as '1.0 / (distance * tan(fov / 2))'. See errors calculation in SubdividePatch()
+    //used for calculate metrics projection on screen. Projection calculate as '1.0 / (distance * tan(fov / 2))'. See errors calculation in Subdivide()
+
+    SubdivisionContext context;
+    context.cameraPos = cameraPos;
+    context.tanFovY = tanFovY;
+    context.maxHeightError = maxHeightError;
+    context.maxPatchRadiusError = maxPatchRadiusError;
+    context.maxAbsoluteHeightError = maxAbsoluteHeightError;
+    context.forceMaxSubdiv = forceMaxSubdiv;
+
+    //subdivision depends only on this input and patches info, so for still camera previous result is reused
+    bool inputChanged = !subdivisionValid ||
+    Memcmp(viewProjMatrix.data, lastViewProjMatrix.data, sizeof(Matrix4)) != 0 ||
+    context.cameraPos != lastContext.cameraPos ||
+    context.tanFovY != lastContext.tanFovY ||
+    context.maxHeightError != lastContext.maxHeightError ||
+    context.maxPatchRadiusError != lastContext.maxPatchRadiusError ||
+    context.maxAbsoluteHeightError != lastContext.maxAbsoluteHeightError ||
+    context.forceMaxSubdiv != lastContext.forceMaxSubdiv;
+
+    if (!inputChanged)
+        return;
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    bool runAsync = asyncSubdivision && subdivisionValid && (jobManager != nullptr);
+
+    lastViewProjMatrix = viewProjMatrix;
+    lastContext = context;
+    subdivisionValid = true;
+
+    context.updateID = ++lastStartedUpdateID;
+
+    if (runAsync)
+    {
+        asyncFrustum->Build(viewProjMatrix, rhi::DeviceCaps().isZeroBaseClipRange);
+        context.frustum = asyncFrustum;
+        context.patchArray = &asyncPatchArray;
+
+        //result is applied by next PrepareSubdivision(), until then job uses only data that isn't modified without ApplyAsyncSubdivision()
+        asyncState = std::make_shared<AsyncSubdivisionState>();
+        asyncState->context = context;
+
+        std::shared_ptr<AsyncSubdivisionState> state = asyncState;
+        jobManager->CreateWorkerJob([this, state]()
+                                    {
+                                        Subdivide(state->context);
+                                        state->done.Signal();
+                                    });
+    }
+    else
+    {
+        frustum->Build(viewProjMatrix, rhi::DeviceCaps().isZeroBaseClipRange);
+        context.frustum = frustum;
+        context.patchArray = &subdivPatchArray;
 
-    terminatedPatchesCount = 0;
-    SubdividePatch(0, 0, 0, 0x3f, maxHeightError, maxPatchRadiusError);
+        Subdivide(context);
+
+        updateID = context.updateID;
+        terminatedPatchesCount = context.terminatedPatchesCount;
+    }
 }
 
 void LandscapeSubdivision::UpdatePatchInfo(const Rect2i& heighmapRect)
 {
+    ApplyAsyncSubdivision();
+    subdivisionValid = false;
+
     UpdatePatchInfo(0, 0, 0, nullptr, heighmapRect);
 }
 
@@ -207,85 +395,125 @@ void LandscapeSubdivision::UpdatePatchInfo(uint32 level, uint32 x, uint32 y, Pat
     }
 }
 
-void LandscapeSubdivision::SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0)
+void LandscapeSubdivision::Subdivide(SubdivisionContext& context)
 {
-    SubdivisionLevelInfo& levelInfo = subdivLevelInfoArray[level];
-    uint32 offset = levelInfo.offset + (y << level) + x;
-    PatchQuadInfo* patch = &patchQuadArray[offset];
-    SubdivisionPatchInfo* subdivPatchInfo = &subdivPatchArray[offset];
-    subdivPatchInfo->lastUpdateID = updateID;
+    using namespace LandscapeSubdivisionDetails;
 
-    // Calculate patch bounding box
-    Frustum::eFrustumResult frustumRes = Frustum::EFR_INSIDE;
+    Vector<SubdivisionPatchInfo>& patchArray = *context.patchArray;
+    context.terminatedPatchesCount = 0;
 
-    if (clippingFlags)
-        frustumRes = frustum->Classify(patch->bbox, clippingFlags, subdivPatchInfo->startClipPlane);
+    //patches are processed level by level: frustum test, batched errors calculation and decision for all patches of level
+    levelPatches.clear();
+    levelPatches.push_back({ 0, 0, context.maxHeightError, context.maxPatchRadiusError, 0x3f });
 
-    if (frustumRes == Frustum::EFR_OUTSIDE)
+    for (uint32 level = 0; level < subdivLevelCount && !levelPatches.empty(); ++level)
     {
-        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::CLIPPED;
-        return;
-    }
+        const SubdivisionLevelInfo& levelInfo = subdivLevelInfoArray[level];
 
-    ////////////////////////////////////////////////////////////////////////////////////
-
-    //Metrics errors we calculate as projection on screen
-    //
-    //                     /              |
-    //                  /                 ^ - error in world-space
-    //               /                    |
-    //            /                       |
-    //         /|                         |
-    //      /   ^ - error in screen-space |
-    //   /      |                         |
-    //  0---------------------------------D-------- frustum axis
-    //          ^                         ^
-    //      near plane            error position plane
-    // plane size 1.0 a-priory   plane size let it be 'H'
-    //
-    // H = D * tg(fov/2), were D - is distance to error position
-    // To find error size on near plane we need just error size divide by 'H'
-    // So, screen space error = error / (D * tg(fov/2))
-    // tg(fov/2) calculating one per-frame, see 'tanFovY' in PrepareSubdivision()
-
-    float32 distance = Distance(cameraPos, patch->positionOfMaxError);
-    float32 heightError = Abs(patch->maxError) / (distance * tanFovY);
-
-    Vector3 patchOrigin = patch->bbox.GetCenter();
-    float32 patchDistance = Distance(cameraPos, patchOrigin);
-    float32 radiusError = patch->radius / (patchDistance * tanFovY);
-
-    if ((level < subdivLevelCount - 1) && ((maxPatchRadiusError <= radiusError) || (maxHeightError <= heightError) || (maxAbsoluteHeightError < Abs(patch->maxError)) || (minSubdivLevel > level) || forceMaxSubdiv))
-    {
-        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::SUBDIVIDED;
+        errorBatch.Clear();
 
-        uint32 x2 = x << 1;
-        uint32 y2 = y << 1;
+        uint32 levelPatchesCount = uint32(levelPatches.size());
+        for (uint32 i = 0; i < levelPatchesCount; ++i)
+        {
+            PatchCandidate& candidate = levelPatches[i];
+            uint32 offset = levelInfo.offset + (candidate.y << level) + candidate.x;
+            const PatchQuadInfo& patch = patchQuadArray[offset];
+            SubdivisionPatchInfo& subdivPatchInfo = patchArray[offset];
+            subdivPatchInfo.lastUpdateID = context.updateID;
+
+            //Classify removes planes patch is completely inside of from 'clippingFlags', so children are tested only with remaining planes
+            if (candidate.clippingFlags && context.frustum->Classify(patch.bbox, candidate.clippingFlags, subdivPatchInfo.startClipPlane) == Frustum::EFR_OUTSIDE)
+            {
+                subdivPatchInfo.subdivisionState = SubdivisionPatchInfo::CLIPPED;
+                continue;
+            }
 
-        SubdividePatch(level + 1, x2 + 0, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 0, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 0, y2 + 1, clippingFlags, heightError, radiusError);
-        SubdividePatch(level + 1, x2 + 1, y2 + 1, clippingFlags, heightError, radiusError);
-    }
-    else
-    {
-        if (calculateMorph)
+            Vector3 patchOrigin = patch.bbox.GetCenter();
+
+            errorBatch.candidateIndex.push_back(i);
+            errorBatch.errorPosX.push_back(patch.positionOfMaxError.x);
+            errorBatch.errorPosY.push_back(patch.positionOfMaxError.y);
+            errorBatch.errorPosZ.push_back(patch.positionOfMaxError.z);
+            errorBatch.absError.push_back(Abs(patch.maxError));
+            errorBatch.centerX.push_back(patchOrigin.x);
+            errorBatch.centerY.push_back(patchOrigin.y);
+            errorBatch.centerZ.push_back(patchOrigin.z);
+            errorBatch.radius.push_back(patch.radius);
+        }
+
+        //Metrics errors we calculate as projection on screen
+        //
+        //                     /              |
+        //                  /                 ^ - error in world-space
+        //               /                    |
+        //            /                       |
+        //         /|                         |
+        //      /   ^ - error in screen-space |
+        //   /      |                         |
+        //  0---------------------------------D-------- frustum axis
+        //          ^                         ^
+        //      near plane            error position plane
+        // plane size 1.0 a-priory   plane size let it be 'H'
+        //
+        // H = D * tg(fov/2), were D - is distance to error position
+        // To find error size on near plane we need just error size divide by 'H'
+        // So, screen space error = error / (D * tg(fov/2))
+        // tg(fov/2) calculating one per-frame, see 'tanFovY' in PrepareSubdivision()
+
+        uint32 batchSize = uint32(errorBatch.candidateIndex.size());
+        errorBatch.Pad();
+
+        uint32 paddedSize = uint32(errorBatch.heightError.size());
+        CalculateScreenErrors(context.cameraPos, context.tanFovY, errorBatch.errorPosX.data(), errorBatch.errorPosY.data(), errorBatch.errorPosZ.data(),
+                              errorBatch.absError.data(), paddedSize, errorBatch.heightError.data());
+        CalculateScreenErrors(context.cameraPos, context.tanFovY, errorBatch.centerX.data(), errorBatch.centerY.data(), errorBatch.centerZ.data(),
+                              errorBatch.radius.data(), paddedSize, errorBatch.radiusError.data());
+
+        nextLevelPatches.clear();
+        for (uint32 b = 0; b < batchSize; ++b)
         {
-            float32 radiusError0Rel = Max(radiusError0, maxPatchRadiusError) / maxPatchRadiusError;
-            float32 radiusErrorRel = Min(radiusError, maxPatchRadiusError) / maxPatchRadiusError;
+            const PatchCandidate& candidate = levelPatches[errorBatch.candidateIndex[b]];
+            uint32 offset = levelInfo.offset + (candidate.y << level) + candidate.x;
+            SubdivisionPatchInfo& subdivPatchInfo = patchArray[offset];
 
-            float32 heightError0Rel = Max(heightError0, maxHeightError) / maxHeightError;
-            float32 heightErrorRel = Min(heightError, maxHeightError) / maxHeightError;
+            float32 heightError = errorBatch.heightError[b];
+            float32 radiusError = errorBatch.radiusError[b];
 
-            float32 error0Delta = Max(radiusError0Rel, heightError0Rel) - 1.f;
-            float32 errorDelta = 1.f - Max(radiusErrorRel, heightErrorRel);
+            if ((level < subdivLevelCount - 1) && ((context.maxPatchRadiusError <= radiusError) || (context.maxHeightError <= heightError) || (context.maxAbsoluteHeightError < errorBatch.absError[b]) || (minSubdivLevel > level) || context.forceMaxSubdiv))
+            {
+                subdivPatchInfo.subdivisionState = SubdivisionPatchInfo::SUBDIVIDED;
 
-            subdivPatchInfo->subdivMorph = 1.f - errorDelta / (error0Delta + errorDelta);
-        }
+                uint32 x2 = candidate.x << 1;
+                uint32 y2 = candidate.y << 1;
 
-        subdivPatchInfo->subdivisionState = SubdivisionPatchInfo::TERMINATED;
+                nextLevelPatches.push_back({ x2 + 0, y2 + 0, heightError, radiusError, candidate.clippingFlags });
+                nextLevelPatches.push_back({ x2 + 1, y2 + 0, heightError, radiusError, candidate.clippingFlags });
+                nextLevelPatches.push_back({ x2 + 0, y2 + 1, heightError, radiusError, candidate.clippingFlags });
+                nextLevelPatches.push_back({ x2 + 1, y2 + 1, heightError, radiusError, candidate.clippingFlags });
+            }
+            else
+            {
+                if (calculateMorph)
+                {
+                    float32 radiusError0Rel = Max(candidate.radiusError0, context.maxPatchRadiusError) / context.maxPatchRadiusError;
+                    float32 radiusErrorRel = Min(radiusError, context.maxPatchRadiusError) / context.maxPatchRadiusError;
+
+                    float32 heightError0Rel = Max(candidate.heightError0, context.maxHeightError) / context.maxHeightError;
+                    float32 heightErrorRel = Min(heightError, context.maxHeightError) / context.maxHeightError;
+
+                    float32 error0Delta = Max(radiusError0Rel, heightError0Rel) - 1.f;
+                    float32 errorDelta = 1.f - Max(radiusErrorRel, heightErrorRel);
+
+                    subdivPatchInfo.subdivMorph = 1.f - errorDelta / (error0Delta + errorDelta);
+                }
+
+                subdivPatchInfo.subdivisionState = SubdivisionPatchInfo::TERMINATED;
+
+                context.terminatedPatchesCount++;
+            }
+        }
 
-        terminatedPatchesCount++;
+        levelPatches.swap(nextLevelPatches);
     }
 }
 
@@ -350,6 +578,7 @@ void LandscapeSubdivision::BuildSubdivision(Heightmap* _heightmap, const AABBox3
     }
 
     subdivPatchArray.resize(subdivPatchCount);
+    asyncPatchArray.resize(subdivPatchCount);
     patchQuadArray.resize(subdivPatchCount);
 
     UpdatePatchInfo(0, 0, 0, nullptr, Rect2i(0, 0, -1, -1));
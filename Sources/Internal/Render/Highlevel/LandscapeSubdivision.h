@@ -6,6 +6,8 @@
 #include "Base/IntrospectionBase.h"
 #include "MemoryManager/MemoryProfiler.h"
 
+struct LandscapeSubdivisionTest;
+
 namespace DAVA
 {
 class Frustum;
@@ -60,6 +62,12 @@ public:
     };
 
     void BuildSubdivision(Heightmap* heightmap, const AABBox3& bbox, uint32 patchSizeQuads, uint32 minSubdivideLevel, bool calculateMorph);
+
+    /**
+        Updates subdivision for camera. Subdivision is skipped if camera, transform and metrics are the same as on previous call.
+        In async mode subdivision for camera is computed in worker job and becomes available on next call,
+        so rendered subdivision is one call behind the camera. Async mode is meant for single camera per landscape.
+    */
     void PrepareSubdivision(Camera* camera, const Matrix4* worldTransform);
     void ReleaseInternalData();
 
@@ -75,6 +83,9 @@ public:
     void UpdatePatchInfo(const Rect2i& heighmapRect);
     void SetForceMaxSubdivision(bool forceSubdivide);
 
+    void SetAsyncSubdivision(bool async);
+    bool IsAsyncSubdivision() const;
+
 private:
     struct PatchQuadInfo
     {
@@ -84,8 +95,53 @@ private:
         float32 radius;
     };
 
+    struct SubdivisionContext
+    {
+        Vector<SubdivisionPatchInfo>* patchArray = nullptr;
+        Frustum* frustum = nullptr;
+        Vector3 cameraPos;
+        float32 tanFovY = 0.f;
+        float32 maxHeightError = 0.f;
+        float32 maxPatchRadiusError = 0.f;
+        float32 maxAbsoluteHeightError = 0.f;
+        uint32 updateID = 0;
+        uint32 terminatedPatchesCount = 0;
+        bool forceMaxSubdiv = false;
+    };
+
+    struct PatchCandidate
+    {
+        uint32 x;
+        uint32 y;
+        float32 heightError0;
+        float32 radiusError0;
+        uint8 clippingFlags;
+    };
+
+    //patches of one level not clipped by frustum, in SoA layout for batched errors calculation
+    struct PatchErrorBatch
+    {
+        Vector<uint32> candidateIndex;
+        Vector<float32> errorPosX;
+        Vector<float32> errorPosY;
+        Vector<float32> errorPosZ;
+        Vector<float32> absError;
+        Vector<float32> centerX;
+        Vector<float32> centerY;
+        Vector<float32> centerZ;
+        Vector<float32> radius;
+        Vector<float32> heightError;
+        Vector<float32> radiusError;
+
+        void Clear();
+        void Pad();
+    };
+
+    struct AsyncSubdivisionState;
+
     void UpdatePatchInfo(uint32 level, uint32 x, uint32 y, PatchQuadInfo* parentPatch, const Rect2i& updateRect);
-    void SubdividePatch(uint32 level, uint32 x, uint32 y, uint8 clippingFlags, float32 heightError0, float32 radiusError0);
+    void Subdivide(SubdivisionContext& context);
+    void ApplyAsyncSubdivision();
 
     const PatchQuadInfo& GetPatchQuadInfo(uint32 level, uint32 x, uint32 y) const;
 
@@ -99,6 +155,7 @@ private:
     uint32 subdivPatchCount = 0;
     uint32 patchSizeQuads = 8;
     uint32 updateID = 0;
+    uint32 lastStartedUpdateID = 0;
 
     SubdivisionMetrics metrics;
 
@@ -117,7 +174,22 @@ private:
     bool calculateMorph = true;
     bool forceMaxSubdiv = false;
 
+    //subdivision input of last PrepareSubdivision, used to skip subdivision for unchanged camera
+    Matrix4 lastViewProjMatrix;
+    SubdivisionContext lastContext;
+    bool subdivisionValid = false;
+
+    Vector<PatchCandidate> levelPatches;
+    Vector<PatchCandidate> nextLevelPatches;
+    PatchErrorBatch errorBatch;
+
+    Vector<SubdivisionPatchInfo> asyncPatchArray;
+    Frustum* asyncFrustum = nullptr;
+    std::shared_ptr<AsyncSubdivisionState> asyncState;
+    bool asyncSubdivision = false;
+
     friend class LandscapeSystem;
+    friend LandscapeSubdivisionTest;
 
     DAVA_VIRTUAL_REFLECTION(LandscapeSubdivision, InspBase);
 };
@@ -147,6 +219,11 @@ inline void LandscapeSubdivision::SetForceMaxSubdivision(bool forceSubdivide)
     forceMaxSubdiv = forceSubdivide;
 }
 
+inline bool LandscapeSubdivision::IsAsyncSubdivision() const
+{
+    return asyncSubdivision;
+}
+
 inline uint32 LandscapeSubdivision::GetLevelCount() const
 {
     return subdivLevelCount;
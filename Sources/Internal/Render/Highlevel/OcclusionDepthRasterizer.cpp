@@ -0,0 +1,423 @@
+#include "Render/Highlevel/OcclusionDepthRasterizer.h"
+#include "Debug/DVAssert.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OCCLUSION_RASTERIZER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define OCCLUSION_RASTERIZER_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace DAVA
+{
+namespace OcclusionDepthRasterizerDetails
+{
+// Tested pixel passes if its depth is not less than stored depth scaled by this value.
+// Keeps geometry visible through its own depth and through coplanar occluders despite interpolation error.
+const float32 DEPTH_TEST_SCALE = 1.0f - 1.0e-4f;
+
+struct TriangleSetup
+{
+    float32 edgeA[3];
+    float32 edgeB[3];
+    float32 edgeC[3];
+    float32 depthA;
+    float32 depthB;
+    float32 depthC;
+};
+
+// Processes four pixels of row starting at `x`, returns number of pixels passed depth test
+template <bool WRITE_DEPTH>
+inline uint32 ProcessPixels4(float32* row, uint32 x, const float32 rowEdge[3], float32 rowDepth, const TriangleSetup& setup)
+{
+#if defined(OCCLUSION_RASTERIZER_SSE2)
+    static const uint32 bitCount[16] = { 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4 };
+
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 px = _mm_add_ps(_mm_set1_ps(float32(x)), _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f));
+
+    __m128 e0 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.edgeA[0]), px), _mm_set1_ps(rowEdge[0]));
+    __m128 e1 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.edgeA[1]), px), _mm_set1_ps(rowEdge[1]));
+    __m128 e2 = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.edgeA[2]), px), _mm_set1_ps(rowEdge[2]));
+    __m128 inside = _mm_and_ps(_mm_and_ps(_mm_cmpge_ps(e0, zero), _mm_cmpge_ps(e1, zero)), _mm_cmpge_ps(e2, zero));
+
+    __m128 depth = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(setup.depthA), px), _mm_set1_ps(rowDepth));
+    __m128 stored = _mm_loadu_ps(row + x);
+    __m128 passed = _mm_and_ps(inside, _mm_cmpge_ps(depth, _mm_mul_ps(stored, _mm_set1_ps(DEPTH_TEST_SCALE))));
+
+    if (WRITE_DEPTH)
+    {
+        __m128 written = _mm_or_ps(_mm_and_ps(inside, _mm_max_ps(depth, stored)), _mm_andnot_ps(inside, stored));
+        _mm_storeu_ps(row + x, written);
+    }
+
+    return bitCount[_mm_movemask_ps(passed)];
+
+#elif defined(OCCLUSION_RASTERIZER_NEON)
+    static const float32 offsets[4] = { 0.5f, 1.5f, 2.5f, 3.5f };
+
+    const float32x4_t zero = vdupq_n_f32(0.0f);
+    const float32x4_t px = vaddq_f32(vdupq_n_f32(float32(x)), vld1q_f32(offsets));
+
+    float32x4_t e0 = vmlaq_n_f32(vdupq_n_f32(rowEdge[0]), px, setup.edgeA[0]);
+    float32x4_t e1 = vmlaq_n_f32(vdupq_n_f32(rowEdge[1]), px, setup.edgeA[1]);
+    float32x4_t e2 = vmlaq_n_f32(vdupq_n_f32(rowEdge[2]), px, setup.edgeA[2]);
+    uint32x4_t inside = vandq_u32(vandq_u32(vcgeq_f32(e0, zero), vcgeq_f32(e1, zero)), vcgeq_f32(e2, zero));
+
+    float32x4_t depth = vmlaq_n_f32(vdupq_n_f32(rowDepth), px, setup.depthA);
+    float32x4_t stored = vld1q_f32(row + x);
+    uint32x4_t passed = vandq_u32(inside, vcgeq_f32(depth, vmulq_n_f32(stored, DEPTH_TEST_SCALE)));
+
+    if (WRITE_DEPTH)
+    {
+        vst1q_f32(row + x, vbslq_f32(inside, vmaxq_f32(depth, stored), stored));
+    }
+
+    uint32x4_t ones = vshrq_n_u32(passed, 31);
+    uint32x2_t sum = vadd_u32(vget_low_u32(ones), vget_high_u32(ones));
+    return vget_lane_u32(vpadd_u32(sum, sum), 0);
+
+#else
+    uint32 count = 0;
+    for (uint32 i = 0; i < 4; ++i)
+    {
+        float32 px = float32(x + i) + 0.5f;
+        if (setup.edgeA[0] * px + rowEdge[0] >= 0.0f && setup.edgeA[1] * px + rowEdge[1] >= 0.0f && setup.edgeA[2] * px + rowEdge[2] >= 0.0f)
+        {
+            float32 depth = setup.depthA * px + rowDepth;
+            float32& stored = row[x + i];
+            if (depth >= stored * DEPTH_TEST_SCALE)
+            {
+                ++count;
+            }
+            if (WRITE_DEPTH)
+            {
+                stored = Max(stored, depth);
+            }
+        }
+    }
+    return count;
+#endif
+}
+}
+
+void OcclusionDepthRasterizer::Resize(uint32 width_, uint32 height_)
+{
+    tilesX = (width_ + TILE_SIZE - 1) / TILE_SIZE;
+    tilesY = (height_ + TILE_SIZE - 1) / TILE_SIZE;
+    width = tilesX * TILE_SIZE;
+    height = tilesY * TILE_SIZE;
+
+    depthBuffer.resize(width * height);
+    tilesDepth.resize(tilesX * tilesY);
+    dirtyTiles.resize(tilesX * tilesY);
+    Clear();
+}
+
+void OcclusionDepthRasterizer::Clear()
+{
+    std::fill(depthBuffer.begin(), depthBuffer.end(), 0.0f);
+    std::fill(tilesDepth.begin(), tilesDepth.end(), 0.0f);
+    std::fill(dirtyTiles.begin(), dirtyTiles.end(), uint8(0));
+    hasDirtyTiles = false;
+}
+
+void OcclusionDepthRasterizer::SetViewProjection(const Matrix4& viewProjection_, float32 nearPlane_)
+{
+    DVASSERT(nearPlane_ > 0.0f);
+
+    viewProjection = viewProjection_;
+    nearPlane = nearPlane_;
+}
+
+void OcclusionDepthRasterizer::RenderTriangles(const Vector3* positions, const uint32* indices, uint32 indexCount)
+{
+    ProcessTriangles<true>(positions, indices, indexCount);
+    UpdateTilesDepth();
+}
+
+uint32 OcclusionDepthRasterizer::CountVisiblePixels(const Vector3* positions, const uint32* indices, uint32 indexCount)
+{
+    return ProcessTriangles<false>(positions, indices, indexCount);
+}
+
+bool OcclusionDepthRasterizer::IsBoxVisible(const AABBox3& box) const
+{
+    using namespace OcclusionDepthRasterizerDetails;
+
+    float32 minX = std::numeric_limits<float32>::max();
+    float32 maxX = -std::numeric_limits<float32>::max();
+    float32 minY = std::numeric_limits<float32>::max();
+    float32 maxY = -std::numeric_limits<float32>::max();
+    float32 closestDepth = 0.0f;
+    for (uint32 k = 0; k < 8; ++k)
+    {
+        Vector3 corner((k & 1) ? box.max.x : box.min.x, (k & 2) ? box.max.y : box.min.y, (k & 4) ? box.max.z : box.min.z);
+        Vector4 clip = Vector4(corner, 1.0f) * viewProjection;
+        if (clip.w < nearPlane)
+        {
+            return true;
+        }
+
+        ScreenVertex v = ToScreen(clip);
+        minX = Min(minX, v.x);
+        maxX = Max(maxX, v.x);
+        minY = Min(minY, v.y);
+        maxY = Max(maxY, v.y);
+        closestDepth = Max(closestDepth, v.depth);
+    }
+
+    minX = Max(minX, 0.0f);
+    maxX = Min(maxX, float32(width));
+    minY = Max(minY, 0.0f);
+    maxY = Min(maxY, float32(height));
+    if (!(minX < maxX && minY < maxY))
+    {
+        // outside of the screen, it is frustum culling business
+        return true;
+    }
+
+    // all partially covered pixels are tested
+    uint32 beginX = uint32(minX);
+    uint32 endX = Min(uint32(std::ceil(maxX)), width);
+    uint32 beginY = uint32(minY);
+    uint32 endY = Min(uint32(std::ceil(maxY)), height);
+
+    for (uint32 tileY = beginY / TILE_SIZE; tileY <= (endY - 1) / TILE_SIZE; ++tileY)
+    {
+        for (uint32 tileX = beginX / TILE_SIZE; tileX <= (endX - 1) / TILE_SIZE; ++tileX)
+        {
+            if (closestDepth < tilesDepth[tileY * tilesX + tileX] * DEPTH_TEST_SCALE)
+            {
+                continue;
+            }
+
+            uint32 rowBegin = Max(tileY * TILE_SIZE, beginY);
+            uint32 rowEnd = Min(tileY * TILE_SIZE + TILE_SIZE, endY);
+            uint32 columnBegin = Max(tileX * TILE_SIZE, beginX);
+            uint32 columnEnd = Min(tileX * TILE_SIZE + TILE_SIZE, endX);
+            for (uint32 y = rowBegin; y < rowEnd; ++y)
+            {
+                const float32* row = depthBuffer.data() + y * width;
+                for (uint32 x = columnBegin; x < columnEnd; ++x)
+                {
+                    if (closestDepth >= row[x] * DEPTH_TEST_SCALE)
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+void OcclusionDepthRasterizer::Merge(const OcclusionDepthRasterizer& other)
+{
+    DVASSERT(width == other.width && height == other.height);
+
+    float32* depth = depthBuffer.data();
+    const float32* otherDepth = other.depthBuffer.data();
+    for (uint32 i = 0, count = uint32(depthBuffer.size()); i < count; ++i)
+    {
+        depth[i] = Max(depth[i], otherDepth[i]);
+    }
+
+    std::fill(dirtyTiles.begin(), dirtyTiles.end(), uint8(1));
+    hasDirtyTiles = true;
+    UpdateTilesDepth();
+}
+
+template <bool WRITE_DEPTH>
+uint32 OcclusionDepthRasterizer::ProcessTriangles(const Vector3* positions, const uint32* indices, uint32 indexCount)
+{
+    uint32 count = 0;
+    for (uint32 i = 0; i + 2 < indexCount; i += 3)
+    {
+        Vector4 clip[3];
+        uint32 insideCount = 0;
+        for (uint32 k = 0; k < 3; ++k)
+        {
+            clip[k] = Vector4(positions[indices[i + k]], 1.0f) * viewProjection;
+            insideCount += (clip[k].w >= nearPlane) ? 1 : 0;
+        }
+
+        if (insideCount == 3)
+        {
+            count += RasterizeTriangle<WRITE_DEPTH>(ToScreen(clip[0]), ToScreen(clip[1]), ToScreen(clip[2]));
+        }
+        else if (insideCount > 0)
+        {
+            // clip by near plane, one triangle gives polygon with three or four vertices
+            Vector4 polygon[4];
+            uint32 polygonSize = 0;
+            for (uint32 k = 0; k < 3; ++k)
+            {
+                const Vector4& a = clip[k];
+                const Vector4& b = clip[(k + 1) % 3];
+                bool isAInside = (a.w >= nearPlane);
+                bool isBInside = (b.w >= nearPlane);
+                if (isAInside)
+                {
+                    polygon[polygonSize++] = a;
+                }
+                if (isAInside != isBInside)
+                {
+                    polygon[polygonSize++].Lerp(a, b, (nearPlane - a.w) / (b.w - a.w));
+                }
+            }
+
+            ScreenVertex v0 = ToScreen(polygon[0]);
+            for (uint32 k = 2; k < polygonSize; ++k)
+            {
+                count += RasterizeTriangle<WRITE_DEPTH>(v0, ToScreen(polygon[k - 1]), ToScreen(polygon[k]));
+            }
+        }
+    }
+    return count;
+}
+
+template <bool WRITE_DEPTH>
+uint32 OcclusionDepthRasterizer::RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1_, const ScreenVertex& v2_)
+{
+    using namespace OcclusionDepthRasterizerDetails;
+
+    float32 area = (v1_.x - v0.x) * (v2_.y - v0.y) - (v2_.x - v0.x) * (v1_.y - v0.y);
+    if (!(area != 0.0f))
+    {
+        return 0;
+    }
+
+    // both windings are rasterized, vertices are reordered to make area positive
+    const ScreenVertex& v1 = (area > 0.0f) ? v1_ : v2_;
+    const ScreenVertex& v2 = (area > 0.0f) ? v2_ : v1_;
+    area = std::abs(area);
+
+    float32 minX = Max(Min(v0.x, Min(v1.x, v2.x)), 0.0f);
+    float32 maxX = Min(Max(v0.x, Max(v1.x, v2.x)), float32(width));
+    float32 minY = Max(Min(v0.y, Min(v1.y, v2.y)), 0.0f);
+    float32 maxY = Min(Max(v0.y, Max(v1.y, v2.y)), float32(height));
+    if (!(minX < maxX && minY < maxY))
+    {
+        return 0;
+    }
+
+    uint32 beginX = uint32(minX);
+    uint32 endX = Min(uint32(std::ceil(maxX)), width);
+    uint32 beginY = uint32(minY);
+    uint32 endY = Min(uint32(std::ceil(maxY)), height);
+
+    // edge functions are positive inside triangle, edge k is opposite to vertex k
+    const ScreenVertex* vertices[3] = { &v0, &v1, &v2 };
+    TriangleSetup setup;
+    for (uint32 k = 0; k < 3; ++k)
+    {
+        const ScreenVertex& a = *vertices[(k + 1) % 3];
+        const ScreenVertex& b = *vertices[(k + 2) % 3];
+        setup.edgeA[k] = a.y - b.y;
+        setup.edgeB[k] = b.x - a.x;
+        setup.edgeC[k] = -(setup.edgeA[k] * a.x + setup.edgeB[k] * a.y);
+    }
+
+    float32 invArea = 1.0f / area;
+    setup.depthA = (v0.depth * setup.edgeA[0] + v1.depth * setup.edgeA[1] + v2.depth * setup.edgeA[2]) * invArea;
+    setup.depthB = (v0.depth * setup.edgeB[0] + v1.depth * setup.edgeB[1] + v2.depth * setup.edgeB[2]) * invArea;
+    setup.depthC = (v0.depth * setup.edgeC[0] + v1.depth * setup.edgeC[1] + v2.depth * setup.edgeC[2]) * invArea;
+    float32 maxDepth = Max(v0.depth, Max(v1.depth, v2.depth));
+
+    uint32 count = 0;
+    for (uint32 tileY = beginY / TILE_SIZE; tileY <= (endY - 1) / TILE_SIZE; ++tileY)
+    {
+        for (uint32 tileX = beginX / TILE_SIZE; tileX <= (endX - 1) / TILE_SIZE; ++tileX)
+        {
+            // closest depth of triangle inside tile is not greater than closest depth of its plane at tile corners
+            float32 x0 = float32(tileX * TILE_SIZE);
+            float32 y0 = float32(tileY * TILE_SIZE);
+            float32 x1 = x0 + float32(TILE_SIZE);
+            float32 y1 = y0 + float32(TILE_SIZE);
+            float32 planeDepth = Max(Max(setup.depthA * x0 + setup.depthB * y0, setup.depthA * x1 + setup.depthB * y0),
+                                     Max(setup.depthA * x0 + setup.depthB * y1, setup.depthA * x1 + setup.depthB * y1));
+            float32 closestDepth = Min(planeDepth + setup.depthC, maxDepth);
+
+            uint32 tileIndex = tileY * tilesX + tileX;
+            if (closestDepth < tilesDepth[tileIndex] * DEPTH_TEST_SCALE)
+            {
+                continue;
+            }
+
+            uint32 rowBegin = Max(tileY * TILE_SIZE, beginY);
+            uint32 rowEnd = Min(tileY * TILE_SIZE + TILE_SIZE, endY);
+            for (uint32 y = rowBegin; y < rowEnd; ++y)
+            {
+                float32 py = float32(y) + 0.5f;
+                float32 rowEdge[3] = {
+                    setup.edgeB[0] * py + setup.edgeC[0],
+                    setup.edgeB[1] * py + setup.edgeC[1],
+                    setup.edgeB[2] * py + setup.edgeC[2]
+                };
+                float32 rowDepth = setup.depthB * py + setup.depthC;
+
+                float32* row = depthBuffer.data() + y * width;
+                for (uint32 x = tileX * TILE_SIZE; x < tileX * TILE_SIZE + TILE_SIZE; x += 4)
+                {
+                    count += ProcessPixels4<WRITE_DEPTH>(row, x, rowEdge, rowDepth, setup);
+                }
+            }
+
+            if (WRITE_DEPTH)
+            {
+                dirtyTiles[tileIndex] = 1;
+                hasDirtyTiles = true;
+            }
+        }
+    }
+
+    return count;
+}
+
+OcclusionDepthRasterizer::ScreenVertex OcclusionDepthRasterizer::ToScreen(const Vector4& clipPosition) const
+{
+    float32 invW = 1.0f / clipPosition.w;
+
+    ScreenVertex result;
+    result.x = (clipPosition.x * invW * 0.5f + 0.5f) * float32(width);
+    result.y = (0.5f - clipPosition.y * invW * 0.5f) * float32(height);
+    result.depth = invW;
+    return result;
+}
+
+void OcclusionDepthRasterizer::UpdateTilesDepth()
+{
+    if (!hasDirtyTiles)
+    {
+        return;
+    }
+
+    for (uint32 tileIndex = 0; tileIndex < uint32(dirtyTiles.size()); ++tileIndex)
+    {
+        if (dirtyTiles[tileIndex] == 0)
+        {
+            continue;
+        }
+
+        uint32 tileX = tileIndex % tilesX;
+        uint32 tileY = tileIndex / tilesX;
+        const float32* row = depthBuffer.data() + tileY * TILE_SIZE * width + tileX * TILE_SIZE;
+
+        float32 farthestDepth = row[0];
+        for (uint32 y = 0; y < TILE_SIZE; ++y, row += width)
+        {
+            for (uint32 x = 0; x < TILE_SIZE; ++x)
+            {
+                farthestDepth = Min(farthestDepth, row[x]);
+            }
+        }
+
+        tilesDepth[tileIndex] = farthestDepth;
+        dirtyTiles[tileIndex] = 0;
+    }
+    hasDirtyTiles = false;
+}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+#include "Math/AABBox3.h"
+
+namespace DAVA
+{
+/**
+    Software depth rasterizer for occlusion tests.
+    Depth is stored as 1/w, so it is interpolated linearly in screen space, larger values are closer to the viewer
+    and cleared buffer has zero depth. Each TILE_SIZE x TILE_SIZE tile keeps the farthest depth of its pixels
+    (hierarchical Z), tiles where triangle is entirely behind that depth are skipped without touching pixels.
+    Pixels are processed by four with SSE2 or NEON where available.
+    Not thread safe, each thread should use its own rasterizer.
+*/
+class OcclusionDepthRasterizer final
+{
+public:
+    static const uint32 TILE_SIZE = 8;
+
+    /** Sets buffer size, size is rounded up to multiple of TILE_SIZE. Buffer is cleared. */
+    void Resize(uint32 width, uint32 height);
+    void Clear();
+
+    uint32 GetWidth() const;
+    uint32 GetHeight() const;
+
+    /** Sets world to clip space transform for following calls. Triangles are clipped by `w >= nearPlane`. */
+    void SetViewProjection(const Matrix4& viewProjection, float32 nearPlane);
+
+    /** Writes depth of indexed triangle list given in world space. */
+    void RenderTriangles(const Vector3* positions, const uint32* indices, uint32 indexCount);
+
+    /**
+        Returns number of pixels covered by indexed triangle list which are not behind current depth.
+        Depth isn't changed. Pixels covered by several triangles are counted several times.
+    */
+    uint32 CountVisiblePixels(const Vector3* positions, const uint32* indices, uint32 indexCount);
+
+    /**
+        Returns false if screen rectangle of world space `box` is entirely behind current depth.
+        Boxes crossing near plane are visible.
+    */
+    bool IsBoxVisible(const AABBox3& box) const;
+
+    /** Keeps closest depth of this and `other` rasterizer of the same size in each pixel. */
+    void Merge(const OcclusionDepthRasterizer& other);
+
+private:
+    struct ScreenVertex
+    {
+        float32 x;
+        float32 y;
+        float32 depth;
+    };
+
+    template <bool WRITE_DEPTH>
+    uint32 ProcessTriangles(const Vector3* positions, const uint32* indices, uint32 indexCount);
+    template <bool WRITE_DEPTH>
+    uint32 RasterizeTriangle(const ScreenVertex& v0, const ScreenVertex& v1, const ScreenVertex& v2);
+
+    ScreenVertex ToScreen(const Vector4& clipPosition) const;
+    void UpdateTilesDepth();
+
+    Matrix4 viewProjection;
+    float32 nearPlane = 1.0f;
+
+    uint32 width = 0;
+    uint32 height = 0;
+    uint32 tilesX = 0;
+    uint32 tilesY = 0;
+
+    Vector<float32> depthBuffer;
+    Vector<float32> tilesDepth;
+    Vector<uint8> dirtyTiles;
+    bool hasDirtyTiles = false;
+};
+
+inline uint32 OcclusionDepthRasterizer::GetWidth() const
+{
+    return width;
+}
+
+inline uint32 OcclusionDepthRasterizer::GetHeight() const
+{
+    return height;
+}
+}
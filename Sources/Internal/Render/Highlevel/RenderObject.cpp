@@ -267,7 +267,7 @@ RenderObject* RenderObject::Clone(RenderObject* newObject)
         newObject = new RenderObject();
     }
 
-    newObject->flags = flags;
+    newObject->flags = flags & ~SOFTWARE_OCCLUDER;
     newObject->RemoveFlag(MARKED_FOR_UPDATE);
     newObject->debugFlags = debugFlags;
     newObject->staticOcclusionIndex = staticOcclusionIndex;
@@ -81,6 +81,8 @@ public:
         VISIBLE_REFRACTION = 1 << 11,
         VISIBLE_QUALITY = 1 << 12,
 
+        SOFTWARE_OCCLUDER = 1 << 13, // set by SoftwareOcclusionCuller for its occluders, not serialized
+
         TRANSFORM_UPDATED = 1 << 15,
     };
 
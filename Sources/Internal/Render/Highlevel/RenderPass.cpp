@@ -4,6 +4,7 @@
 #include "Render/Highlevel/Camera.h"
 #include "Render/Highlevel/RenderPassNames.h"
 #include "Render/Highlevel/ShadowVolumeRenderLayer.h"
+#include "Render/Highlevel/SoftwareOcclusionCuller.h"
 #include "Render/ShaderCache.h"
 
 #include "Debug/ProfilerCPU.h"
@@ -121,10 +122,14 @@ void RenderPass::PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSys
         currVisibilityCriteria &= ~RenderObject::VISIBLE_STATIC_OCCLUSION;
 
     visibilityArray.clear();
+    occludedArray.clear();
     renderSystem->GetRenderHierarchy()->Clip(camera, visibilityArray, currVisibilityCriteria);
+    if (softwareOcclusionCullingEnabled)
+        renderSystem->GetOcclusionCuller()->Cull(camera, visibilityArray, occludedArray);
 
     ClearLayersArrays();
     PrepareLayersArrays(visibilityArray, camera);
+    PrepareShadowVolumeArrays(occludedArray, camera);
 }
 
 void RenderPass::PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera)
@@ -256,6 +261,32 @@ void RenderPass::EndRenderPass()
     rhi::EndRenderPass(renderPass);
 }
 
+void RenderPass::PrepareShadowVolumeArrays(const Vector<RenderObject*>& objectsArray, Camera* camera)
+{
+    // shadow volumes of occluded objects can cast shadows onto visible surfaces
+    for (RenderObject* renderObject : objectsArray)
+    {
+        bool isPrepared = false;
+        uint32 batchCount = renderObject->GetActiveRenderBatchCount();
+        for (uint32 batchIndex = 0; batchIndex < batchCount; ++batchIndex)
+        {
+            RenderBatch* batch = renderObject->GetActiveRenderBatch(batchIndex);
+
+            NMaterial* material = batch->GetMaterial();
+            DVASSERT(material);
+            if (material->PreBuildMaterial(passName) && material->GetRenderLayerID() == RenderLayer::RENDER_LAYER_SHADOW_VOLUME_ID)
+            {
+                if (!isPrepared && (renderObject->GetFlags() & RenderObject::CUSTOM_PREPARE_TO_RENDER))
+                {
+                    renderObject->PrepareToRender(camera);
+                    isPrepared = true;
+                }
+                layersBatchArrays[RenderLayer::RENDER_LAYER_SHADOW_VOLUME_ID].AddRenderBatch(batch);
+            }
+        }
+    }
+}
+
 void RenderPass::ClearLayersArrays()
 {
     for (uint32 id = 0; id < static_cast<uint32>(RenderLayer::RENDER_LAYER_ID_COUNT); ++id)
@@ -269,6 +300,8 @@ MainForwardRenderPass::MainForwardRenderPass(const FastName& name)
     , reflectionPass(nullptr)
     , refractionPass(nullptr)
 {
+    softwareOcclusionCullingEnabled = true;
+
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_OPAQUE_ID, RenderLayer::LAYER_SORTING_FLAGS_OPAQUE));
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_AFTER_OPAQUE_ID, RenderLayer::LAYER_SORTING_FLAGS_AFTER_OPAQUE));
     AddRenderLayer(new RenderLayer(RenderLayer::RENDER_LAYER_VEGETATION_ID, RenderLayer::LAYER_SORTING_FLAGS_VEGETATION));
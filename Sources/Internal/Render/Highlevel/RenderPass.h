@@ -39,6 +39,7 @@ protected:
     /*convinience*/
     void PrepareVisibilityArrays(Camera* camera, RenderSystem* renderSystem);
     void PrepareLayersArrays(const Vector<RenderObject*> objectsArray, Camera* camera);
+    void PrepareShadowVolumeArrays(const Vector<RenderObject*>& objectsArray, Camera* camera);
     void ClearLayersArrays();
 
     void SetupCameraParams(Camera* mainCamera, Camera* drawCamera, Vector4* externalClipPlane = NULL);
@@ -53,6 +54,8 @@ protected:
     Vector<RenderLayer*> renderLayers;
     std::array<RenderBatchArray, RenderLayer::RENDER_LAYER_ID_COUNT> layersBatchArrays;
     Vector<RenderObject*> visibilityArray;
+    Vector<RenderObject*> occludedArray;
+    bool softwareOcclusionCullingEnabled = false;
 
     rhi::HPacketList packetList;
     rhi::HRenderPass renderPass;
@@ -11,6 +11,7 @@
 #include "Render/Highlevel/Camera.h"
 #include "Render/Highlevel/Light.h"
 #include "Render/Highlevel/VisibilityQuadTree.h"
+#include "Render/Highlevel/SoftwareOcclusionCuller.h"
 #include "Render/ShaderCache.h"
 
 #include "Utils/Utils.h"
@@ -24,6 +25,7 @@ RenderSystem::RenderSystem()
     markedObjects.reserve(100);
     debugDrawer = new RenderHelper();
     geoDecalManager = new GeoDecalManager();
+    occlusionCuller = new SoftwareOcclusionCuller();
 }
 
 RenderSystem::~RenderSystem()
@@ -38,6 +40,7 @@ RenderSystem::~RenderSystem()
 
     SafeDelete(debugDrawer);
     SafeDelete(geoDecalManager);
+    SafeDelete(occlusionCuller);
 }
 
 void RenderSystem::RenderPermanent(RenderObject* renderObject)
@@ -95,6 +98,7 @@ void RenderSystem::RemoveRenderObject(RenderObject* renderObject)
     }
 
     geoDecalManager->RemoveRenderObject(renderObject);
+    occlusionCuller->RemoveOccluder(renderObject);
     renderHierarchy->RemoveRenderObject(renderObject);
 
     renderObject->SetRenderSystem(nullptr);
@@ -307,6 +311,8 @@ void RenderSystem::Update(float32 timeElapsed)
     }
     markedObjects.clear();
 
+    geoDecalManager->ApplyBuiltDecals();
+
     renderHierarchy->Update();
 
     if (movedLights.size() > 0 || forceUpdateLights)
@@ -19,6 +19,7 @@ class Light;
 class ParticleEmitterSystem;
 class RenderHierarchy;
 class NMaterial;
+class SoftwareOcclusionCuller;
 
 class RenderSystem
 {
@@ -111,6 +112,11 @@ public:
         return geoDecalManager;
     }
 
+    inline SoftwareOcclusionCuller* GetOcclusionCuller() const
+    {
+        return occlusionCuller;
+    }
+
 public:
     DAVA_DEPRECATED(rhi::RenderPassConfig& GetMainPassConfig());
 
@@ -137,6 +143,7 @@ private:
     NMaterial* globalMaterial = nullptr;
     RenderHelper* debugDrawer = nullptr;
     GeoDecalManager* geoDecalManager = nullptr;
+    SoftwareOcclusionCuller* occlusionCuller = nullptr;
 
     bool hierarchyInitialized = false;
     bool forceUpdateLights = false;
@@ -0,0 +1,256 @@
+#include "Render/Highlevel/SoftwareOcclusionCuller.h"
+#include "Render/Highlevel/Camera.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/Landscape.h"
+#include "Render/Highlevel/OcclusionDepthRasterizer.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+#include "Logger/Logger.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+
+namespace DAVA
+{
+namespace SoftwareOcclusionCullerDetails
+{
+struct RasterizersState
+{
+    Atomic<uint32> nextRasterizer;
+    Atomic<uint32> doneRasterizers;
+};
+
+bool IsOpaqueMaterial(NMaterial* material)
+{
+    if (material == nullptr)
+    {
+        return false;
+    }
+
+    bool isAlphaTest = material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_ALPHATEST) != 0;
+    bool isAlphaBlend = material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_BLENDING) != BLENDING_NONE;
+    return !isAlphaTest && !isAlphaBlend;
+}
+
+void AppendGeometry(PolygonGroup* polygonGroup, Vector<Vector3>& positions, Vector<uint32>& indices)
+{
+    if (polygonGroup == nullptr || polygonGroup->vertexArray == nullptr || polygonGroup->GetPrimitiveType() != rhi::PRIMITIVE_TRIANGLELIST)
+    {
+        return;
+    }
+
+    uint32 baseVertex = static_cast<uint32>(positions.size());
+    for (int32 v = 0, vertexCount = polygonGroup->GetVertexCount(); v < vertexCount; ++v)
+    {
+        Vector3 position;
+        polygonGroup->GetCoord(v, position);
+        positions.push_back(position);
+    }
+
+    for (int32 k = 0, indexCount = polygonGroup->GetIndexCount(); k < indexCount; ++k)
+    {
+        int32 index = 0;
+        polygonGroup->GetIndex(k, index);
+        indices.push_back(baseVertex + static_cast<uint32>(index));
+    }
+}
+}
+
+SoftwareOcclusionCuller::SoftwareOcclusionCuller() = default;
+
+SoftwareOcclusionCuller::~SoftwareOcclusionCuller()
+{
+    RemoveAllOccluders();
+}
+
+void SoftwareOcclusionCuller::SetResolution(uint32 width_, uint32 height_)
+{
+    DVASSERT(width_ > 0 && height_ > 0);
+    width = width_;
+    height = height_;
+    rasterizers.clear();
+}
+
+void SoftwareOcclusionCuller::AddOccluder(RenderObject* renderObject, PolygonGroup* geometry)
+{
+    using namespace SoftwareOcclusionCullerDetails;
+
+    DVASSERT(renderObject != nullptr);
+    RemoveOccluder(renderObject);
+
+    Occluder occluder;
+    if (geometry != nullptr)
+    {
+        AppendGeometry(geometry, occluder.positions, occluder.indices);
+    }
+    else if (renderObject->GetType() == RenderObject::TYPE_LANDSCAPE)
+    {
+        static_cast<Landscape*>(renderObject)->GetOccluderGeometry(LANDSCAPE_GRID_SIZE, occluder.positions, occluder.indices);
+        occluder.isWorldSpace = true;
+    }
+    else
+    {
+        for (uint32 i = 0, count = renderObject->GetRenderBatchCount(); i < count; ++i)
+        {
+            int32 lodIndex = -1;
+            int32 switchIndex = -1;
+            RenderBatch* batch = renderObject->GetRenderBatch(i, lodIndex, switchIndex);
+            if (lodIndex <= 0 && switchIndex <= 0 && IsOpaqueMaterial(batch->GetMaterial()))
+            {
+                AppendGeometry(batch->GetPolygonGroup(), occluder.positions, occluder.indices);
+            }
+        }
+    }
+
+    if (occluder.indices.empty())
+    {
+        Logger::Warning("[SoftwareOcclusionCuller::AddOccluder] Render object has no opaque triangles");
+        return;
+    }
+
+    occluder.renderObject = SafeRetain(renderObject);
+    occluder.renderObject->AddFlag(RenderObject::SOFTWARE_OCCLUDER);
+    occluders.push_back(std::move(occluder));
+}
+
+void SoftwareOcclusionCuller::RemoveOccluder(RenderObject* renderObject)
+{
+    auto it = std::find_if(occluders.begin(), occluders.end(), [renderObject](const Occluder& occluder) {
+        return occluder.renderObject == renderObject;
+    });
+    if (it != occluders.end())
+    {
+        it->renderObject->RemoveFlag(RenderObject::SOFTWARE_OCCLUDER);
+        SafeRelease(it->renderObject);
+        occluders.erase(it);
+    }
+}
+
+void SoftwareOcclusionCuller::RemoveAllOccluders()
+{
+    for (Occluder& occluder : occluders)
+    {
+        occluder.renderObject->RemoveFlag(RenderObject::SOFTWARE_OCCLUDER);
+        SafeRelease(occluder.renderObject);
+    }
+    occluders.clear();
+}
+
+void SoftwareOcclusionCuller::Cull(Camera* camera, Vector<RenderObject*>& objects, Vector<RenderObject*>& occludedObjects)
+{
+    culledObjectsCount = 0;
+    if (!enabled || occluders.empty())
+    {
+        return;
+    }
+
+    Frustum* frustum = camera->GetFrustum();
+    const Vector3& cameraPosition = camera->GetPosition();
+
+    visibleOccluders.clear();
+    for (const Occluder& occluder : occluders)
+    {
+        const AABBox3& bbox = occluder.renderObject->GetWorldBoundingBox();
+        if (frustum->IsInside(bbox))
+        {
+            visibleOccluders.emplace_back((bbox.GetCenter() - cameraPosition).SquareLength(), &occluder);
+        }
+    }
+
+    if (visibleOccluders.empty())
+    {
+        return;
+    }
+
+    // front to back order lets hierarchical depth reject most of hidden triangles
+    std::sort(visibleOccluders.begin(), visibleOccluders.end(), [](const std::pair<float32, const Occluder*>& l, const std::pair<float32, const Occluder*>& r) {
+        return l.first < r.first;
+    });
+
+    const Matrix4& viewProjection = camera->GetViewProjMatrix();
+    RenderOccluders(viewProjection, camera->GetZNear());
+
+    const OcclusionDepthRasterizer& rasterizer = *rasterizers.front();
+    size_t visibleCount = 0;
+    for (RenderObject* renderObject : objects)
+    {
+        bool isAlwaysVisible = (renderObject->GetFlags() & RenderObject::SOFTWARE_OCCLUDER) || renderObject->GetType() == RenderObject::TYPE_LANDSCAPE || renderObject->GetClippingVisible();
+        if (isAlwaysVisible || rasterizer.IsBoxVisible(renderObject->GetWorldBoundingBox()))
+        {
+            objects[visibleCount++] = renderObject;
+        }
+        else
+        {
+            occludedObjects.push_back(renderObject);
+        }
+    }
+    culledObjectsCount = static_cast<uint32>(objects.size() - visibleCount);
+    objects.resize(visibleCount);
+}
+
+void SoftwareOcclusionCuller::RenderOccluders(const Matrix4& viewProjection, float32 nearPlane)
+{
+    using namespace SoftwareOcclusionCullerDetails;
+
+    JobManager* jobManager = (GetEngineContext() != nullptr) ? GetEngineContext()->jobManager : nullptr;
+    uint32 occludersCount = static_cast<uint32>(visibleOccluders.size());
+    uint32 jobCount = (jobManager != nullptr) ? Min(jobManager->GetWorkersCount(), occludersCount - 1) : 0;
+    uint32 rasterizersCount = jobCount + 1;
+
+    while (rasterizers.size() < rasterizersCount)
+    {
+        rasterizers.emplace_back(new OcclusionDepthRasterizer());
+        rasterizers.back()->Resize(width, height);
+    }
+
+    // occluders are distributed across rasterizers with stride, so each of them keeps front to back order
+    // `this` is referenced only while there are not taken rasterizers, i.e. while calling thread waits for them
+    std::shared_ptr<RasterizersState> state = std::make_shared<RasterizersState>();
+    auto renderOccluders = [this, state, rasterizersCount, occludersCount, viewProjection, nearPlane]()
+    {
+        for (uint32 index = state->nextRasterizer++; index < rasterizersCount; index = state->nextRasterizer++)
+        {
+            OcclusionDepthRasterizer* rasterizer = rasterizers[index].get();
+            rasterizer->Clear();
+            for (uint32 k = index; k < occludersCount; k += rasterizersCount)
+            {
+                const Occluder* occluder = visibleOccluders[k].second;
+                Matrix4* worldTransform = occluder->renderObject->GetWorldMatrixPtr();
+                if (occluder->isWorldSpace || worldTransform == nullptr)
+                {
+                    rasterizer->SetViewProjection(viewProjection, nearPlane);
+                }
+                else
+                {
+                    rasterizer->SetViewProjection((*worldTransform) * viewProjection, nearPlane);
+                }
+                rasterizer->RenderTriangles(occluder->positions.data(), occluder->indices.data(), static_cast<uint32>(occluder->indices.size()));
+            }
+            state->doneRasterizers++;
+        }
+    };
+
+    for (uint32 i = 0; i < jobCount; ++i)
+    {
+        jobManager->CreateWorkerJob(renderOccluders);
+    }
+
+    renderOccluders();
+
+    while (state->doneRasterizers.Get() < rasterizersCount)
+    {
+        Thread::Yield();
+    }
+
+    OcclusionDepthRasterizer* result = rasterizers.front().get();
+    for (uint32 i = 1; i < rasterizersCount; ++i)
+    {
+        result->Merge(*rasterizers[i]);
+    }
+    result->SetViewProjection(viewProjection, nearPlane);
+}
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+class Camera;
+class OcclusionDepthRasterizer;
+class PolygonGroup;
+class RenderObject;
+
+/**
+    Runtime occlusion culling on CPU for objects which can't use static occlusion, e.g. dynamic ones.
+    Designated occluders (simplified meshes or landscape) are rasterized into low resolution depth buffer by
+    OcclusionDepthRasterizer on worker jobs and calling thread, then world bounding boxes of visible objects are tested
+    against that buffer. Objects with entirely hidden boxes are removed before their batches reach render layers,
+    except batches of shadow volumes, which can cast shadows onto visible surfaces. Culling is done only for main
+    forward pass camera, so reflection, refraction and static occlusion passes are not affected.
+    Culling does nothing while there are no occluders.
+*/
+class SoftwareOcclusionCuller final
+{
+public:
+    static const uint32 DEFAULT_WIDTH = 256;
+    static const uint32 DEFAULT_HEIGHT = 128;
+    static const uint32 LANDSCAPE_GRID_SIZE = 64;
+
+    SoftwareOcclusionCuller();
+    ~SoftwareOcclusionCuller();
+
+    void SetEnabled(bool enabled);
+    bool IsEnabled() const;
+
+    /** Sets size of depth buffer. Aspect ratio should be close to the one of main camera. */
+    void SetResolution(uint32 width, uint32 height);
+
+    /**
+        Adds `renderObject` as occluder and marks it with RenderObject::SOFTWARE_OCCLUDER flag.
+        If `geometry` is nullptr, opaque batches of LOD 0 are used.
+        Geometry is copied, so simplified `geometry` can be released after the call.
+        Landscape uses Landscape::GetOccluderGeometry.
+    */
+    void AddOccluder(RenderObject* renderObject, PolygonGroup* geometry = nullptr);
+    void RemoveOccluder(RenderObject* renderObject);
+    void RemoveAllOccluders();
+    uint32 GetOccludersCount() const;
+
+    /**
+        Moves objects hidden by occluders from `objects` to `occludedObjects` keeping their order.
+        Occluders, landscape and always visible objects are kept.
+    */
+    void Cull(Camera* camera, Vector<RenderObject*>& objects, Vector<RenderObject*>& occludedObjects);
+
+    /** Number of objects removed by last Cull call. */
+    uint32 GetCulledObjectsCount() const;
+
+private:
+    struct Occluder
+    {
+        RenderObject* renderObject = nullptr;
+        Vector<Vector3> positions;
+        Vector<uint32> indices;
+        bool isWorldSpace = false;
+    };
+
+    void RenderOccluders(const Matrix4& viewProjection, float32 nearPlane);
+
+    Vector<Occluder> occluders;
+    Vector<std::pair<float32, const Occluder*>> visibleOccluders;
+    Vector<std::unique_ptr<OcclusionDepthRasterizer>> rasterizers;
+
+    uint32 width = DEFAULT_WIDTH;
+    uint32 height = DEFAULT_HEIGHT;
+    uint32 culledObjectsCount = 0;
+    bool enabled = true;
+};
+
+inline void SoftwareOcclusionCuller::SetEnabled(bool enabled_)
+{
+    enabled = enabled_;
+}
+
+inline bool SoftwareOcclusionCuller::IsEnabled() const
+{
+    return enabled;
+}
+
+inline uint32 SoftwareOcclusionCuller::GetOccludersCount() const
+{
+    return static_cast<uint32>(occluders.size());
+}
+
+inline uint32 SoftwareOcclusionCuller::GetCulledObjectsCount() const
+{
+    return culledObjectsCount;
+}
+}
@@ -15,12 +15,17 @@
 
 namespace DAVA
 {
+const float32 StaticOcclusion::CAMERA_FOV = 95.0f;
+const float32 StaticOcclusion::CAMERA_ZNEAR = 1.0f;
+const float32 StaticOcclusion::CAMERA_ZFAR = 2500.0f;
+const uint32 StaticOcclusion::RENDER_TARGET_SIZE;
+
 StaticOcclusion::StaticOcclusion()
 {
     for (uint32 k = 0; k < 6; ++k)
     {
         cameras[k] = new Camera();
-        cameras[k]->SetupPerspective(95.0f, 1.0f, 1.0f, 2500.0f); //aspect of one is anyway required to avoid side occlusion errors
+        cameras[k]->SetupPerspective(CAMERA_FOV, 1.0f, CAMERA_ZNEAR, CAMERA_ZFAR); //aspect of one is anyway required to avoid side occlusion errors
     }
 }
 
@@ -39,8 +44,6 @@ void StaticOcclusion::StartBuildOcclusion(StaticOcclusionData* _currentData, Ren
     staticOcclusionRenderPass = new StaticOcclusionRenderPass(PASS_FORWARD);
 
     currentData = _currentData;
-    occlusionAreaRect = currentData->bbox;
-    cellHeightOffset = currentData->cellHeightOffset;
     xBlockCount = currentData->sizeX;
     yBlockCount = currentData->sizeY;
     zBlockCount = currentData->sizeZ;
@@ -61,25 +64,6 @@ void StaticOcclusion::StartBuildOcclusion(StaticOcclusionData* _currentData, Ren
     occlusionPixelThresholdForSpeedtree = _occlusionPixelThresholdForSpeedtree;
 }
 
-AABBox3 StaticOcclusion::GetCellBox(uint32 x, uint32 y, uint32 z)
-{
-    Vector3 size = occlusionAreaRect.GetSize();
-
-    size.x /= xBlockCount;
-    size.y /= yBlockCount;
-    size.z /= zBlockCount;
-
-    Vector3 min(occlusionAreaRect.min.x + x * size.x,
-                occlusionAreaRect.min.y + y * size.y,
-                occlusionAreaRect.min.z + z * size.z);
-    if (cellHeightOffset)
-    {
-        min.z += cellHeightOffset[x + y * xBlockCount];
-    }
-    AABBox3 blockBBox(min, Vector3(min.x + size.x, min.y + size.y, min.z + size.z));
-    return blockBBox;
-}
-
 void StaticOcclusion::AdvanceToNextBlock()
 {
     currentFrameX++;
@@ -143,6 +127,17 @@ const String& StaticOcclusion::GetInfoMessage() const
 }
 
 void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
+{
+    uint32 blockIndex = currentFrameX + currentFrameY * xBlockCount + currentFrameZ * xBlockCount * yBlockCount;
+    AABBox3 cellBox = currentData->GetCellBox(currentFrameX, currentFrameY, currentFrameZ);
+
+    DVASSERT(occlusionFrameResults.size() == 0); // previous results are processed - at least for now
+
+    BuildRenderPassConfigs(cellBox, blockIndex, landscape, renderPassConfigs);
+    stats.totalRenderPasses = renderPassConfigs.size();
+}
+
+void StaticOcclusion::BuildRenderPassConfigs(const AABBox3& cellBox, uint32 blockIndex, Landscape* landscape, Vector<RenderPassCameraConfig>& configs)
 {
     const uint32 stepCount = 10;
 
@@ -168,13 +163,9 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
       { 5, 5, 5 },
     };
 
-    uint32 blockIndex = currentFrameX + currentFrameY * xBlockCount + currentFrameZ * xBlockCount * yBlockCount;
-    AABBox3 cellBox = GetCellBox(currentFrameX, currentFrameY, currentFrameZ);
     Vector3 stepSize = cellBox.GetSize();
     stepSize /= float32(stepCount);
 
-    DVASSERT(occlusionFrameResults.size() == 0); // previous results are processed - at least for now
-
     for (uint32 side = 0; side < 6; ++side)
     {
         Vector3 startPosition, directionX, directionY;
@@ -248,13 +239,11 @@ void StaticOcclusion::BuildRenderPassConfigsForCurrentBlock()
                         config.up = Vector3(0.0f, 0.0f, 1.0f);
                         config.left = Vector3(1.0f, 0.0f, 0.0f);
                     }
-                    renderPassConfigs.push_back(config);
+                    configs.push_back(config);
                 }
             }
         }
     }
-
-    stats.totalRenderPasses = renderPassConfigs.size();
 }
 
 bool StaticOcclusion::PerformRender(const RenderPassCameraConfig& rpc)
@@ -494,6 +483,25 @@ const uint32* StaticOcclusionData::GetData() const
     return dataHolder.data();
 }
 
+AABBox3 StaticOcclusionData::GetCellBox(uint32 x, uint32 y, uint32 z) const
+{
+    Vector3 size = bbox.GetSize();
+
+    size.x /= sizeX;
+    size.y /= sizeY;
+    size.z /= sizeZ;
+
+    Vector3 min(bbox.min.x + x * size.x,
+                bbox.min.y + y * size.y,
+                bbox.min.z + z * size.z);
+    if (cellHeightOffset)
+    {
+        min.z += cellHeightOffset[x + y * sizeX];
+    }
+    AABBox3 blockBBox(min, Vector3(min.x + size.x, min.y + size.y, min.z + size.z));
+    return blockBBox;
+}
+
 void StaticOcclusionData::SetData(const uint32* _data, uint32 dataSize)
 {
     auto elements = dataSize / sizeof(uint32);
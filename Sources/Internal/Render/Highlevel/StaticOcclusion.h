@@ -37,6 +37,8 @@ public:
     void SetData(const uint32* _data, uint32 dataSize);
     const uint32* GetData() const;
 
+    AABBox3 GetCellBox(uint32 x, uint32 y, uint32 z) const;
+
 public:
     AABBox3 bbox;
     uint32 sizeX = 0;
@@ -61,6 +63,24 @@ struct StaticOcclusionFrameResult
 class StaticOcclusion
 {
 public:
+    struct RenderPassCameraConfig
+    {
+        Vector3 position;
+        Vector3 left;
+        Vector3 up;
+        Vector3 direction;
+        uint32 side = 0;
+        uint32 blockIndex = 0;
+    };
+
+    static const float32 CAMERA_FOV;
+    static const float32 CAMERA_ZNEAR;
+    static const float32 CAMERA_ZFAR;
+    static const uint32 RENDER_TARGET_SIZE = 1024;
+
+    /** Appends camera configs used to render occlusion block with `cellBox`. Positions under landscape are skipped. */
+    static void BuildRenderPassConfigs(const AABBox3& cellBox, uint32 blockIndex, Landscape* landscape, Vector<RenderPassCameraConfig>& configs);
+
     StaticOcclusion();
     ~StaticOcclusion();
 
@@ -74,21 +94,9 @@ public:
     const String& GetInfoMessage() const;
 
 private:
-    AABBox3 GetCellBox(uint32 x, uint32 y, uint32 z);
-
     void MarkQueriesAsCompletedForObjectInBlock(uint16 objectIndex, uint32 blockIndex);
     bool ProcessRecorderQueries();
 
-    struct RenderPassCameraConfig
-    {
-        Vector3 position;
-        Vector3 left;
-        Vector3 up;
-        Vector3 direction;
-        uint32 side = 0;
-        uint32 blockIndex = 0;
-    };
-
     struct Statistics
     {
         uint64 blockProcessingTime = 0;
@@ -108,11 +116,9 @@ private:
     StaticOcclusionData* currentData = nullptr;
     RenderSystem* renderSystem = nullptr;
     Landscape* landscape = nullptr;
-    float32* cellHeightOffset = nullptr;
     Vector<StaticOcclusionFrameResult> occlusionFrameResults;
     Vector<RenderPassCameraConfig> renderPassConfigs;
     String lastInfoMessage;
-    AABBox3 occlusionAreaRect;
     uint32 xBlockCount = 0;
     uint32 yBlockCount = 0;
     uint32 zBlockCount = 0;
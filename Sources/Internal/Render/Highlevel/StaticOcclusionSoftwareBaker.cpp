@@ -0,0 +1,299 @@
+#include "Render/Highlevel/StaticOcclusionSoftwareBaker.h"
+#include "Render/Highlevel/Frustum.h"
+#include "Render/Highlevel/Landscape.h"
+#include "Render/Highlevel/OcclusionDepthRasterizer.h"
+#include "Render/Highlevel/RenderBatch.h"
+#include "Render/Highlevel/RenderObject.h"
+#include "Render/Highlevel/StaticOcclusion.h"
+#include "Render/3D/PolygonGroup.h"
+#include "Render/Material/NMaterial.h"
+#include "Render/Material/NMaterialNames.h"
+#include "Base/ScopedPtr.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
+#include "Time/SystemTimer.h"
+#include "Utils/StringFormat.h"
+
+namespace DAVA
+{
+namespace StaticOcclusionSoftwareBakerDetails
+{
+struct BlocksState
+{
+    Atomic<uint32> nextBlock;
+    Atomic<uint32> doneBlocks;
+};
+
+bool IsOccluderMaterial(NMaterial* material)
+{
+    if (material == nullptr)
+    {
+        return false;
+    }
+
+    bool isAlphaTest = material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_ALPHATEST) != 0;
+    bool isAlphaBlend = material->GetEffectiveFlagValue(NMaterialFlagName::FLAG_BLENDING) != BLENDING_NONE;
+    return !isAlphaTest && !isAlphaBlend;
+}
+}
+
+StaticOcclusionSoftwareBaker::StaticOcclusionSoftwareBaker() = default;
+StaticOcclusionSoftwareBaker::~StaticOcclusionSoftwareBaker() = default;
+
+void StaticOcclusionSoftwareBaker::SetResolution(uint32 resolution_)
+{
+    DVASSERT(resolution_ > 0);
+    resolution = resolution_;
+}
+
+void StaticOcclusionSoftwareBaker::StartBake(StaticOcclusionData* data_, const Vector<RenderObject*>& renderObjects, Landscape* landscape_,
+                                             uint32 occlusionPixelThreshold_, uint32 occlusionPixelThresholdForSpeedtree_)
+{
+    data = data_;
+    landscape = landscape_;
+    occlusionPixelThreshold = occlusionPixelThreshold_;
+    occlusionPixelThresholdForSpeedtree = occlusionPixelThresholdForSpeedtree_;
+
+    processedBlocks = 0;
+    blockCount = data->sizeX * data->sizeY * data->sizeZ;
+    buildStartTime = SystemTimer::GetNs();
+
+    meshes.clear();
+    meshes.reserve(renderObjects.size());
+    for (RenderObject* renderObject : renderObjects)
+    {
+        AddRenderObject(renderObject);
+    }
+    AddLandscape();
+
+    UpdateInfoString();
+}
+
+bool StaticOcclusionSoftwareBaker::ProcessBlocks(uint32 maxBlocks)
+{
+    using namespace StaticOcclusionSoftwareBakerDetails;
+
+    uint32 firstBlock = processedBlocks;
+    uint32 endBlock = firstBlock + Min(maxBlocks, blockCount - firstBlock);
+    if (firstBlock < endBlock)
+    {
+        // `this` is referenced only while there are not taken blocks, i.e. while calling thread waits for them
+        std::shared_ptr<BlocksState> state = std::make_shared<BlocksState>();
+        state->nextBlock = firstBlock;
+        auto processBlocks = [this, state, endBlock]()
+        {
+            uint32 block = state->nextBlock++;
+            if (block >= endBlock)
+            {
+                return;
+            }
+
+            OcclusionDepthRasterizer rasterizer;
+            rasterizer.Resize(resolution, resolution);
+            ScopedPtr<Frustum> frustum(new Frustum());
+            for (; block < endBlock; block = state->nextBlock++)
+            {
+                ProcessBlock(block, rasterizer, frustum);
+                state->doneBlocks++;
+            }
+        };
+
+        JobManager* jobManager = (GetEngineContext() != nullptr) ? GetEngineContext()->jobManager : nullptr;
+        uint32 jobCount = (jobManager != nullptr) ? Min(jobManager->GetWorkersCount(), endBlock - firstBlock - 1) : 0;
+        for (uint32 i = 0; i < jobCount; ++i)
+        {
+            jobManager->CreateWorkerJob(processBlocks);
+        }
+
+        processBlocks();
+
+        while (state->doneBlocks.Get() < endBlock - firstBlock)
+        {
+            Thread::Yield();
+        }
+
+        processedBlocks = endBlock;
+    }
+
+    UpdateInfoString();
+    return processedBlocks == blockCount;
+}
+
+void StaticOcclusionSoftwareBaker::Finish()
+{
+    ProcessBlocks(blockCount - processedBlocks);
+}
+
+void StaticOcclusionSoftwareBaker::AddRenderObject(RenderObject* renderObject)
+{
+    using namespace StaticOcclusionSoftwareBakerDetails;
+
+    Matrix4* worldTransform = renderObject->GetWorldMatrixPtr();
+
+    meshes.emplace_back();
+    Mesh& mesh = meshes.back();
+    mesh.occlusionIndex = renderObject->GetStaticOcclusionIndex();
+    mesh.pixelThreshold = (renderObject->GetType() == RenderObject::TYPE_SPEED_TREE) ? occlusionPixelThresholdForSpeedtree : occlusionPixelThreshold;
+
+    for (uint32 i = 0, count = renderObject->GetRenderBatchCount(); i < count; ++i)
+    {
+        int32 lodIndex = -1;
+        int32 switchIndex = -1;
+        RenderBatch* batch = renderObject->GetRenderBatch(i, lodIndex, switchIndex);
+        if (switchIndex > 0)
+        {
+            // switch objects are rendered without depth write by StaticOcclusionRenderPass
+            mesh.isOccluder = false;
+        }
+        if (lodIndex > 0 || switchIndex > 0)
+        {
+            continue;
+        }
+
+        PolygonGroup* polygonGroup = batch->GetPolygonGroup();
+        if (polygonGroup == nullptr || polygonGroup->vertexArray == nullptr || polygonGroup->GetPrimitiveType() != rhi::PRIMITIVE_TRIANGLELIST)
+        {
+            continue;
+        }
+
+        if (!IsOccluderMaterial(batch->GetMaterial()))
+        {
+            mesh.isOccluder = false;
+        }
+
+        uint32 baseVertex = static_cast<uint32>(mesh.positions.size());
+        for (int32 v = 0, vertexCount = polygonGroup->GetVertexCount(); v < vertexCount; ++v)
+        {
+            Vector3 position;
+            polygonGroup->GetCoord(v, position);
+            if (worldTransform != nullptr)
+            {
+                position = position * (*worldTransform);
+            }
+            mesh.positions.push_back(position);
+            mesh.bbox.AddPoint(position);
+        }
+
+        for (int32 k = 0, indexCount = polygonGroup->GetIndexCount(); k < indexCount; ++k)
+        {
+            int32 index = 0;
+            polygonGroup->GetIndex(k, index);
+            mesh.indices.push_back(baseVertex + static_cast<uint32>(index));
+        }
+    }
+
+    if (mesh.indices.empty())
+    {
+        meshes.pop_back();
+    }
+}
+
+void StaticOcclusionSoftwareBaker::AddLandscape()
+{
+    landscapeMesh = Mesh();
+    landscapeMesh.occlusionIndex = INVALID_STATIC_OCCLUSION_INDEX;
+    if (landscape == nullptr)
+    {
+        return;
+    }
+
+    landscape->GetOccluderGeometry(LANDSCAPE_GRID_SIZE, landscapeMesh.positions, landscapeMesh.indices);
+    for (const Vector3& position : landscapeMesh.positions)
+    {
+        landscapeMesh.bbox.AddPoint(position);
+    }
+}
+
+void StaticOcclusionSoftwareBaker::ProcessBlock(uint32 blockIndex, OcclusionDepthRasterizer& rasterizer, Frustum* frustum)
+{
+    uint32 x = blockIndex % data->sizeX;
+    uint32 y = (blockIndex / data->sizeX) % data->sizeY;
+    uint32 z = blockIndex / (data->sizeX * data->sizeY);
+
+    Vector<StaticOcclusion::RenderPassCameraConfig> configs;
+    StaticOcclusion::BuildRenderPassConfigs(data->GetCellBox(x, y, z), blockIndex, landscape, configs);
+
+    float32 halfSize = StaticOcclusion::CAMERA_ZNEAR * std::tan(DegToRad(StaticOcclusion::CAMERA_FOV) * 0.5f);
+    Matrix4 projection;
+    projection.BuildPerspective(-halfSize, halfSize, -halfSize, halfSize, StaticOcclusion::CAMERA_ZNEAR, StaticOcclusion::CAMERA_ZFAR, false);
+
+    float32 pixelScale = float32(StaticOcclusion::RENDER_TARGET_SIZE) / float32(rasterizer.GetWidth());
+    pixelScale *= pixelScale;
+
+    Vector<std::pair<float32, const Mesh*>> occluders;
+    Vector<const Mesh*> candidates;
+    for (const StaticOcclusion::RenderPassCameraConfig& config : configs)
+    {
+        Matrix4 view;
+        view.BuildLookAtMatrix(config.position, config.position + config.direction, config.up);
+        Matrix4 viewProjection = view * projection;
+        frustum->Build(viewProjection, false);
+
+        occluders.clear();
+        candidates.clear();
+        for (const Mesh& mesh : meshes)
+        {
+            if (!frustum->IsInside(mesh.bbox))
+            {
+                continue;
+            }
+
+            if (mesh.isOccluder)
+            {
+                occluders.emplace_back((mesh.bbox.GetCenter() - config.position).SquareLength(), &mesh);
+            }
+            if (mesh.occlusionIndex != INVALID_STATIC_OCCLUSION_INDEX && !data->IsObjectVisibleFromBlock(blockIndex, mesh.occlusionIndex))
+            {
+                candidates.push_back(&mesh);
+            }
+        }
+
+        if (candidates.empty())
+        {
+            continue;
+        }
+
+        rasterizer.Clear();
+        rasterizer.SetViewProjection(viewProjection, StaticOcclusion::CAMERA_ZNEAR);
+
+        if (!landscapeMesh.indices.empty())
+        {
+            rasterizer.RenderTriangles(landscapeMesh.positions.data(), landscapeMesh.indices.data(), static_cast<uint32>(landscapeMesh.indices.size()));
+        }
+
+        // front to back order lets hierarchical depth reject most of hidden triangles
+        std::sort(occluders.begin(), occluders.end(), [](const std::pair<float32, const Mesh*>& l, const std::pair<float32, const Mesh*>& r) {
+            return l.first < r.first;
+        });
+        for (const auto& occluder : occluders)
+        {
+            const Mesh* mesh = occluder.second;
+            rasterizer.RenderTriangles(mesh->positions.data(), mesh->indices.data(), static_cast<uint32>(mesh->indices.size()));
+        }
+
+        for (const Mesh* mesh : candidates)
+        {
+            uint32 visiblePixels = rasterizer.CountVisiblePixels(mesh->positions.data(), mesh->indices.data(), static_cast<uint32>(mesh->indices.size()));
+            if (float32(visiblePixels) * pixelScale > float32(mesh->pixelThreshold))
+            {
+                data->EnableVisibilityForObject(blockIndex, mesh->occlusionIndex);
+            }
+        }
+    }
+}
+
+void StaticOcclusionSoftwareBaker::UpdateInfoString()
+{
+    float64 timeSpent = static_cast<float64>(SystemTimer::GetNs() - buildStartTime) / 1e+9;
+    if (processedBlocks >= blockCount)
+    {
+        lastInfoMessage = Format("Completed. Total time spent: %.1f s", timeSpent);
+    }
+    else
+    {
+        lastInfoMessage = Format("Processing block: %u from %u\n\nTotal time spent: %.1f s", processedBlocks + 1, blockCount, timeSpent);
+    }
+}
+}
@@ -0,0 +1,100 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/BaseMath.h"
+
+namespace DAVA
+{
+class Frustum;
+class Landscape;
+class OcclusionDepthRasterizer;
+class RenderObject;
+class StaticOcclusionData;
+
+/**
+    Builds static occlusion data on CPU without renderer, so it can be used with Null rhi backend.
+    For each block the same camera positions as in StaticOcclusion are rasterized by OcclusionDepthRasterizer:
+    landscape and opaque geometry are written to depth, then visible pixels of objects which are still invisible from
+    the block are counted. Count scaled to StaticOcclusion::RENDER_TARGET_SIZE is compared with occlusion pixel threshold.
+    Geometry of LOD 0 and first switch is used. Objects with alpha tested or blended materials and switch objects
+    are tested but don't occlude, like in StaticOcclusionRenderPass. Landscape occludes by Landscape::GetOccluderGeometry.
+    Blocks are processed in parallel by worker jobs and calling thread, each block writes only its own visibility bits.
+*/
+class StaticOcclusionSoftwareBaker final
+{
+public:
+    static const uint32 DEFAULT_RESOLUTION = 256;
+    static const uint32 LANDSCAPE_GRID_SIZE = 256;
+
+    StaticOcclusionSoftwareBaker();
+    ~StaticOcclusionSoftwareBaker();
+
+    /** Sets size of depth buffer. Bigger size is more precise for small objects and slower. */
+    void SetResolution(uint32 resolution);
+    uint32 GetResolution() const;
+
+    /** Collects world space geometry of `renderObjects` and `landscape` and prepares to fill `data`. */
+    void StartBake(StaticOcclusionData* data, const Vector<RenderObject*>& renderObjects, Landscape* landscape,
+                   uint32 occlusionPixelThreshold, uint32 occlusionPixelThresholdForSpeedtree);
+
+    /** Processes up to `maxBlocks` next blocks. Returns true if all blocks are processed. */
+    bool ProcessBlocks(uint32 maxBlocks);
+
+    /** Processes all remaining blocks. */
+    void Finish();
+
+    uint32 GetCurrentStepsCount() const;
+    uint32 GetTotalStepsCount() const;
+    const String& GetInfoMessage() const;
+
+private:
+    struct Mesh
+    {
+        Vector<Vector3> positions;
+        Vector<uint32> indices;
+        AABBox3 bbox;
+        uint32 pixelThreshold = 0;
+        uint16 occlusionIndex = 0;
+        bool isOccluder = true;
+    };
+
+    void AddRenderObject(RenderObject* renderObject);
+    void AddLandscape();
+    void ProcessBlock(uint32 blockIndex, OcclusionDepthRasterizer& rasterizer, Frustum* frustum);
+    void UpdateInfoString();
+
+    StaticOcclusionData* data = nullptr;
+    Landscape* landscape = nullptr;
+    Vector<Mesh> meshes;
+    Mesh landscapeMesh;
+
+    uint32 resolution = DEFAULT_RESOLUTION;
+    uint32 occlusionPixelThreshold = 0;
+    uint32 occlusionPixelThresholdForSpeedtree = 0;
+
+    uint32 processedBlocks = 0;
+    uint32 blockCount = 0;
+    uint64 buildStartTime = 0;
+    String lastInfoMessage;
+};
+
+inline uint32 StaticOcclusionSoftwareBaker::GetResolution() const
+{
+    return resolution;
+}
+
+inline uint32 StaticOcclusionSoftwareBaker::GetCurrentStepsCount() const
+{
+    return processedBlocks;
+}
+
+inline uint32 StaticOcclusionSoftwareBaker::GetTotalStepsCount() const
+{
+    return blockCount;
+}
+
+inline const String& StaticOcclusionSoftwareBaker::GetInfoMessage() const
+{
+    return lastInfoMessage;
+}
+}
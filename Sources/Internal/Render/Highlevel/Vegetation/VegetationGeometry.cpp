@@ -11,9 +11,91 @@
 #include "Render/Texture.h"
 #include "Engine/Engine.h"
 #include "Engine/EngineContext.h"
+#include "FileSystem/File.h"
+#include "Base/ScopedPtr.h"
+#include "FileSystem/FileList.h"
+#include "FileSystem/FileSystem.h"
+#include "Job/JobManager.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+#include "Logger/Logger.h"
+#include "Utils/CRC32.h"
+#include "Utils/StringFormat.h"
 
 namespace DAVA
 {
+namespace VegetationGeometryDetails
+{
+const uint32 CACHE_FILE_SIGNATURE = DAVA_MAKEFOURCC('V', 'G', 'C', 'H');
+const uint32 CACHE_FILE_VERSION = 2;
+const uint64 CACHE_FOLDER_SIZE_LIMIT = 128 * 1024 * 1024;
+
+/*
+    Cache file layout:
+    CacheFileHeader
+    for each resolution: uint32 cellCount, VegetationBufferItem[cellCount]
+    VegetationVertex[vertexCount]
+    VegetationIndex[indexCount]
+*/
+struct CacheFileHeader
+{
+    uint32 signature = CACHE_FILE_SIGNATURE;
+    uint32 version = CACHE_FILE_VERSION;
+    uint32 key = 0;
+    uint32 resolutionCount = 0;
+    uint32 vertexCount = 0;
+    uint32 indexCount = 0;
+    uint32 dataCrc32 = 0; //of vertex and index data
+};
+
+FilePath GetCacheFolder()
+{
+    return FilePath("~doc:/VegetationCache/");
+}
+
+// Least recently written cache files are deleted while cache folder is larger than limit
+void EvictCacheFiles(const FilePath& keptPath)
+{
+    FileSystem* fileSystem = FileSystem::Instance();
+
+    Vector<std::pair<String, FilePath>> cacheFiles;
+    uint64 totalSize = 0;
+    ScopedPtr<FileList> fileList(new FileList(GetCacheFolder()));
+    for (uint32 i = 0; i < fileList->GetCount(); ++i)
+    {
+        const FilePath& path = fileList->GetPathname(i);
+        if (!fileList->IsDirectory(i) && path.IsEqualToExtension(".vegcache"))
+        {
+            totalSize += fileList->GetFileSize(i);
+            if (path != keptPath)
+            {
+                // modification date is formatted as 'YYYY.MM.DD hh:mm:ss', so it is sorted as string
+                cacheFiles.emplace_back(File::GetModificationDate(path), path);
+            }
+        }
+    }
+
+    if (totalSize <= CACHE_FOLDER_SIZE_LIMIT)
+    {
+        return;
+    }
+
+    std::sort(cacheFiles.begin(), cacheFiles.end());
+    for (const std::pair<String, FilePath>& cacheFile : cacheFiles)
+    {
+        uint64 fileSize = 0;
+        if (fileSystem->GetFileSize(cacheFile.second, fileSize) && fileSystem->DeleteFile(cacheFile.second))
+        {
+            totalSize -= Min(fileSize, totalSize);
+            if (totalSize <= CACHE_FOLDER_SIZE_LIMIT)
+            {
+                break;
+            }
+        }
+    }
+}
+}
+
 void VegetationGeometry::CustomGeometryLayerData::BuildBBox()
 {
     bbox.Empty();
@@ -121,55 +203,13 @@ void VegetationGeometry::Build(VegetationRenderData* renderData)
 
     PrepareBoundingBoxes();
 
-    Vector<VegetationVertex>& vertexData = renderData->GetVertices();
-    Vector<VegetationIndex>& indexData = renderData->GetIndices();
-
-    Vector<ClusterPositionData> clusterPositions;
-    Vector<VertexRangeData> layerClusterRanges;
-    GenerateClusterPositionData(maxClusters, clusterPositions, layerClusterRanges);
-
-    Vector<Vector<BufferData>> resolutionDataArray;
-    for (uint32 resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
-    {
-        resolutionDataArray.emplace_back();
-        Vector<BufferData>& cellDataArray = resolutionDataArray.back();
-
-        Vector<ClusterResolutionData> clusterResolution;
-        Vector<BufferCellData> cellOffsets;
-        GenerateClusterResolutionData(resolutionIndex, maxClusters, clusterPositions, layerClusterRanges, clusterResolution);
-
-        std::stable_sort(clusterResolution.begin(), clusterResolution.end(), ClusterByMatrixCompareFunction);
-
-        GenerateVertexData(customGeometryData, clusterResolution, vertexData, cellOffsets);
-
-        size_t cellCount = cellOffsets.size();
-        for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
-        {
-            cellDataArray.emplace_back();
-            BufferData& bufferOffsets = cellDataArray.back();
-            GenerateIndexData(customGeometryData, clusterResolution, cellOffsets[cellIndex], vertexData, indexData, bufferOffsets);
-        }
-    }
-
-    Vector<Vector<VegetationBufferItem>>& indexBuffers = renderData->GetIndexBuffers();
-    for (size_t resolutionIndex = 0; resolutionIndex < resolutionCount; ++resolutionIndex)
+    uint32 cacheKey = CalculateCacheKey();
+    FilePath cachePath = GetCachePath(cacheKey);
+    isLoadedFromCache = LoadCache(cachePath, cacheKey, renderData);
+    if (!isLoadedFromCache)
     {
-        Vector<BufferData>& indexBuffersOffsets = resolutionDataArray[resolutionIndex];
-
-        indexBuffers.emplace_back();
-        Vector<VegetationBufferItem>& currentResolutionIndexBuffers = indexBuffers.back();
-
-        size_t cellCount = indexBuffersOffsets.size();
-        for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
-        {
-            currentResolutionIndexBuffers.emplace_back();
-            VegetationBufferItem& indexBufferItem = currentResolutionIndexBuffers.back();
-
-            BufferData& indexBufferOffset = indexBuffersOffsets[cellIndex];
-
-            indexBufferItem.indexCount = indexBufferOffset.size;
-            indexBufferItem.startIndex = indexBufferOffset.indexOffset;
-        }
+        GenerateRenderData(renderData);
+        SaveCache(cachePath, cacheKey, renderData);
     }
 
     NMaterial* material = customGeometryData[0].material;
@@ -209,6 +249,292 @@ void VegetationGeometry::Build(VegetationRenderData* renderData)
     }
 }
 
+void VegetationGeometry::GenerateRenderData(VegetationRenderData* renderData)
+{
+    Vector<ClusterPositionData> clusterPositions;
+    Vector<VertexRangeData> layerClusterRanges;
+    GenerateClusterPositionData(maxClusters, clusterPositions, layerClusterRanges);
+
+    //resolutions don't depend on each other, so they are generated in worker jobs and concatenated after
+    Vector<ResolutionBufferData> resolutionDataArray(resolutionCount);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 jobCount = (jobManager != nullptr && resolutionCount > 1) ? Min(jobManager->GetWorkersCount(), resolutionCount - 1) : 0;
+
+    struct GenerateState
+    {
+        Atomic<uint32> nextResolution;
+        Atomic<uint32> doneResolutions;
+    };
+    std::shared_ptr<GenerateState> state = std::make_shared<GenerateState>();
+
+    uint32 count = resolutionCount;
+    auto generateResolutions = [this, state, count, &clusterPositions, &layerClusterRanges, &resolutionDataArray]()
+    {
+        for (uint32 resolutionIndex = state->nextResolution++; resolutionIndex < count; resolutionIndex = state->nextResolution++)
+        {
+            GenerateResolutionBufferData(resolutionIndex, clusterPositions, layerClusterRanges, resolutionDataArray[resolutionIndex]);
+            state->doneResolutions++;
+        }
+    };
+
+    for (uint32 i = 0; i < jobCount; ++i)
+    {
+        jobManager->CreateWorkerJob(generateResolutions);
+    }
+
+    generateResolutions();
+
+    while (state->doneResolutions.Get() < count)
+    {
+        Thread::Yield();
+    }
+
+    Vector<VegetationVertex>& vertexData = renderData->GetVertices();
+    Vector<VegetationIndex>& indexData = renderData->GetIndices();
+    Vector<Vector<VegetationBufferItem>>& indexBuffers = renderData->GetIndexBuffers();
+
+    size_t totalVertexCount = 0;
+    size_t totalIndexCount = 0;
+    for (const ResolutionBufferData& resolutionData : resolutionDataArray)
+    {
+        totalVertexCount += resolutionData.vertexData.size();
+        totalIndexCount += resolutionData.indexData.size();
+    }
+    vertexData.reserve(vertexData.size() + totalVertexCount);
+    indexData.reserve(indexData.size() + totalIndexCount);
+
+    for (const ResolutionBufferData& resolutionData : resolutionDataArray)
+    {
+        uint32 vertexOffset = static_cast<uint32>(vertexData.size());
+        uint32 indexOffset = static_cast<uint32>(indexData.size());
+
+        vertexData.insert(vertexData.end(), resolutionData.vertexData.begin(), resolutionData.vertexData.end());
+        for (VegetationIndex index : resolutionData.indexData)
+        {
+            indexData.push_back(index + vertexOffset);
+        }
+
+        indexBuffers.emplace_back();
+        Vector<VegetationBufferItem>& currentResolutionIndexBuffers = indexBuffers.back();
+
+        size_t cellCount = resolutionData.cellData.size();
+        for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+        {
+            currentResolutionIndexBuffers.emplace_back();
+            VegetationBufferItem& indexBufferItem = currentResolutionIndexBuffers.back();
+
+            const BufferData& indexBufferOffset = resolutionData.cellData[cellIndex];
+
+            indexBufferItem.indexCount = indexBufferOffset.size;
+            indexBufferItem.startIndex = indexBufferOffset.indexOffset + indexOffset;
+        }
+    }
+}
+
+void VegetationGeometry::GenerateResolutionBufferData(uint32 resolutionId, const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerRanges,
+                                                      ResolutionBufferData& resolutionBufferData)
+{
+    Vector<ClusterResolutionData> clusterResolution;
+    Vector<BufferCellData> cellOffsets;
+    GenerateClusterResolutionData(resolutionId, maxClusters, clusterPositions, layerRanges, clusterResolution);
+
+    std::stable_sort(clusterResolution.begin(), clusterResolution.end(), ClusterByMatrixCompareFunction);
+
+    GenerateVertexData(customGeometryData, clusterResolution, resolutionBufferData.vertexData, cellOffsets);
+
+    size_t cellCount = cellOffsets.size();
+    resolutionBufferData.cellData.resize(cellCount);
+    for (size_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+    {
+        GenerateIndexData(customGeometryData, clusterResolution, cellOffsets[cellIndex], resolutionBufferData.vertexData, resolutionBufferData.indexData, resolutionBufferData.cellData[cellIndex]);
+    }
+}
+
+bool VegetationGeometry::IsLoadedFromCache() const
+{
+    return isLoadedFromCache;
+}
+
+uint32 VegetationGeometry::CalculateCacheKey() const
+{
+    CRC32 crc;
+    crc.AddData(&VegetationGeometryDetails::CACHE_FILE_VERSION, sizeof(uint32));
+    crc.AddData(&maxDensityLevels, sizeof(maxDensityLevels));
+    crc.AddData(unitSize.data, sizeof(unitSize.data));
+    crc.AddData(worldSize.data, sizeof(worldSize.data));
+
+    for (const VegetationLayerParams& layerParams : maxClusters)
+    {
+        crc.AddData(&layerParams.maxClusterCount, sizeof(layerParams.maxClusterCount));
+        crc.AddData(&layerParams.instanceRotationVariation, sizeof(layerParams.instanceRotationVariation));
+        crc.AddData(&layerParams.instanceScaleVariation, sizeof(layerParams.instanceScaleVariation));
+    }
+
+    crc.AddData(resolutionCellSquare.data(), resolutionCellSquare.size() * sizeof(uint32));
+    crc.AddData(resolutionScale.data(), resolutionScale.size() * sizeof(float32));
+    crc.AddData(resolutionTilesPerRow.data(), resolutionTilesPerRow.size() * sizeof(uint32));
+    crc.AddData(resolutionClusterStride.data(), resolutionClusterStride.size() * sizeof(uint32));
+
+    //layout of entities and their lods is hashed too, so moving geometry between them changes the key
+    uint32 entityCount = static_cast<uint32>(customGeometryData.size());
+    crc.AddData(&entityCount, sizeof(entityCount));
+    for (const CustomGeometryEntityData& entityData : customGeometryData)
+    {
+        uint32 lodCount = static_cast<uint32>(entityData.lods.size());
+        crc.AddData(&lodCount, sizeof(lodCount));
+        for (const CustomGeometryLayerData& lodData : entityData.lods)
+        {
+            uint32 vertexCount = static_cast<uint32>(lodData.sourcePositions.size());
+            uint32 textureCoordCount = static_cast<uint32>(lodData.sourceTextureCoords.size());
+            uint32 normalCount = static_cast<uint32>(lodData.sourceNormals.size());
+            uint32 indexCount = static_cast<uint32>(lodData.sourceIndices.size());
+            crc.AddData(&vertexCount, sizeof(vertexCount));
+            crc.AddData(&textureCoordCount, sizeof(textureCoordCount));
+            crc.AddData(&normalCount, sizeof(normalCount));
+            crc.AddData(&indexCount, sizeof(indexCount));
+
+            crc.AddData(lodData.sourcePositions.data(), lodData.sourcePositions.size() * sizeof(Vector3));
+            crc.AddData(lodData.sourceTextureCoords.data(), lodData.sourceTextureCoords.size() * sizeof(Vector2));
+            crc.AddData(lodData.sourceNormals.data(), lodData.sourceNormals.size() * sizeof(Vector3));
+            crc.AddData(lodData.sourceIndices.data(), lodData.sourceIndices.size() * sizeof(VegetationIndex));
+        }
+    }
+
+    return crc.Done();
+}
+
+FilePath VegetationGeometry::GetCachePath(uint32 cacheKey) const
+{
+    return VegetationGeometryDetails::GetCacheFolder() + Format("%08x.vegcache", cacheKey);
+}
+
+bool VegetationGeometry::LoadCache(const FilePath& cachePath, uint32 cacheKey, VegetationRenderData* renderData) const
+{
+    using namespace VegetationGeometryDetails;
+
+    ScopedPtr<File> file(File::Create(cachePath, File::OPEN | File::READ));
+    if (!file)
+    {
+        return false;
+    }
+
+    CacheFileHeader header;
+    if (file->Read(&header) != sizeof(CacheFileHeader) ||
+        header.signature != CACHE_FILE_SIGNATURE || header.version != CACHE_FILE_VERSION || header.key != cacheKey ||
+        header.resolutionCount != resolutionCount)
+    {
+        return false;
+    }
+
+    uint64 dataSize = uint64(header.vertexCount) * sizeof(VegetationVertex) + uint64(header.indexCount) * sizeof(VegetationIndex);
+    if (dataSize > file->GetSize())
+    {
+        return false;
+    }
+
+    Vector<Vector<VegetationBufferItem>> indexBuffers(resolutionCount);
+    for (Vector<VegetationBufferItem>& resolutionIndexBuffers : indexBuffers)
+    {
+        uint32 cellCount = 0;
+        if (file->Read(&cellCount) != sizeof(uint32) || cellCount > header.indexCount)
+        {
+            return false;
+        }
+
+        resolutionIndexBuffers.resize(cellCount);
+        uint32 itemsSize = cellCount * static_cast<uint32>(sizeof(VegetationBufferItem));
+        if (cellCount > 0 && file->Read(resolutionIndexBuffers.data(), itemsSize) != itemsSize)
+        {
+            return false;
+        }
+
+        for (const VegetationBufferItem& item : resolutionIndexBuffers)
+        {
+            if (item.startIndex > header.indexCount || item.indexCount > header.indexCount - item.startIndex)
+            {
+                return false;
+            }
+        }
+    }
+
+    Vector<VegetationVertex> vertexData(header.vertexCount);
+    Vector<VegetationIndex> indexData(header.indexCount);
+    uint32 vertexDataSize = header.vertexCount * static_cast<uint32>(sizeof(VegetationVertex));
+    uint32 indexDataSize = header.indexCount * static_cast<uint32>(sizeof(VegetationIndex));
+    bool dataRead = (file->Read(vertexData.data(), vertexDataSize) == vertexDataSize) && (file->Read(indexData.data(), indexDataSize) == indexDataSize);
+
+    CRC32 crc;
+    crc.AddData(vertexData.data(), vertexDataSize);
+    crc.AddData(indexData.data(), indexDataSize);
+    if (!dataRead || crc.Done() != header.dataCrc32)
+    {
+        Logger::Warning("[VegetationGeometry::LoadCache] Cache file %s is corrupted", cachePath.GetStringValue().c_str());
+        return false;
+    }
+
+    renderData->GetVertices() = std::move(vertexData);
+    renderData->GetIndices() = std::move(indexData);
+    renderData->GetIndexBuffers() = std::move(indexBuffers);
+
+    return true;
+}
+
+void VegetationGeometry::SaveCache(const FilePath& cachePath, uint32 cacheKey, VegetationRenderData* renderData) const
+{
+    using namespace VegetationGeometryDetails;
+
+    FileSystem::Instance()->CreateDirectory(cachePath.GetDirectory(), true);
+
+    ScopedPtr<File> file(File::Create(cachePath, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Warning("[VegetationGeometry::SaveCache] Can't create cache file %s", cachePath.GetStringValue().c_str());
+        return;
+    }
+
+    const Vector<VegetationVertex>& vertexData = renderData->GetVertices();
+    const Vector<VegetationIndex>& indexData = renderData->GetIndices();
+    const Vector<Vector<VegetationBufferItem>>& indexBuffers = renderData->GetIndexBuffers();
+
+    CacheFileHeader header;
+    header.key = cacheKey;
+    header.resolutionCount = static_cast<uint32>(indexBuffers.size());
+    header.vertexCount = static_cast<uint32>(vertexData.size());
+    header.indexCount = static_cast<uint32>(indexData.size());
+
+    uint32 vertexDataSize = header.vertexCount * static_cast<uint32>(sizeof(VegetationVertex));
+    uint32 indexDataSize = header.indexCount * static_cast<uint32>(sizeof(VegetationIndex));
+
+    CRC32 crc;
+    crc.AddData(vertexData.data(), vertexDataSize);
+    crc.AddData(indexData.data(), indexDataSize);
+    header.dataCrc32 = crc.Done();
+
+    bool success = (file->Write(&header) == sizeof(CacheFileHeader));
+    for (const Vector<VegetationBufferItem>& resolutionIndexBuffers : indexBuffers)
+    {
+        uint32 cellCount = static_cast<uint32>(resolutionIndexBuffers.size());
+        uint32 itemsSize = cellCount * static_cast<uint32>(sizeof(VegetationBufferItem));
+        success = success && (file->Write(&cellCount) == sizeof(uint32));
+        success = success && (cellCount == 0 || file->Write(resolutionIndexBuffers.data(), itemsSize) == itemsSize);
+    }
+
+    success = success && (file->Write(vertexData.data(), vertexDataSize) == vertexDataSize);
+    success = success && (file->Write(indexData.data(), indexDataSize) == indexDataSize);
+
+    if (!success)
+    {
+        file.reset();
+        FileSystem::Instance()->DeleteFile(cachePath);
+        Logger::Warning("[VegetationGeometry::SaveCache] Can't write cache file %s", cachePath.GetStringValue().c_str());
+        return;
+    }
+
+    file.reset();
+    EvictCacheFiles(cachePath);
+}
+
 void VegetationGeometry::OnVegetationPropertiesChanged(NMaterial* mat, KeyedArchive* props)
 {
     if (mat)
@@ -43,7 +43,15 @@ public:
                        const VegetationGeometryDataPtr& geometryData);
     virtual ~VegetationGeometry();
 
+    /**
+        Generates vertex and index buffers for all resolutions. Resolutions are generated in worker jobs.
+        Generated buffers are cached in '~doc:/VegetationCache/' by hash of layer parameters, resolution setup,
+        source geometry and its layout, so next build with the same input only reads the cache file.
+        Least recently written cache files are deleted when cache folder exceeds 128 MB.
+    */
     void Build(VegetationRenderData* renderData);
+    /** Returns true if buffers of last Build were read from cache. */
+    bool IsLoadedFromCache() const;
     void OnVegetationPropertiesChanged(NMaterial* material, KeyedArchive* props);
 
     void SetupCameraPositions(const AABBox3& bbox, Vector<Vector3>& positions);
@@ -113,6 +121,14 @@ private:
         uint32 clusterCount;
     };
 
+    //buffers of single resolution, indices and offsets are relative to resolution start
+    struct ResolutionBufferData
+    {
+        Vector<VegetationVertex> vertexData;
+        Vector<VegetationIndex> indexData;
+        Vector<BufferData> cellData;
+    };
+
 private:
     void GenerateClusterPositionData(const Vector<VegetationLayerParams>& layerClusterCount, Vector<ClusterPositionData>& clusters, Vector<VertexRangeData>& layerRanges);
 
@@ -125,10 +141,19 @@ private:
     void GenerateIndexData(const Vector<CustomGeometryEntityData>& sourceGeomData, const Vector<ClusterResolutionData>& clusterResolution, const BufferCellData& rangeData,
                            Vector<VegetationVertex>& vertexData, Vector<VegetationIndex>& indexData, BufferData& bufferOffsets);
 
+    void GenerateResolutionBufferData(uint32 resolutionId, const Vector<ClusterPositionData>& clusterPositions, const Vector<VertexRangeData>& layerRanges,
+                                      ResolutionBufferData& resolutionBufferData);
+    void GenerateRenderData(VegetationRenderData* renderData);
+
+    uint32 CalculateCacheKey() const;
+    FilePath GetCachePath(uint32 cacheKey) const;
+    bool LoadCache(const FilePath& cachePath, uint32 cacheKey, VegetationRenderData* renderData) const;
+    void SaveCache(const FilePath& cachePath, uint32 cacheKey, VegetationRenderData* renderData) const;
+
     static bool ClusterByMatrixCompareFunction(const ClusterResolutionData& a, const ClusterResolutionData& b);
 
-    void Rotate(float32 angle, const Vector<Vector3>& sourcePositions, const Vector<Vector3>& sourceNormals, Vector<Vector3>& rotatedPositions, Vector<Vector3>& rotatedNormals);
-    void Scale(const Vector3& clusterPivot, float32 scale, const Vector<Vector3>& sourcePositions, const Vector<Vector3>& sourceNormals, Vector<Vector3>& scaledPositions, Vector<Vector3>& scaledNormals);
+    static void Rotate(float32 angle, const Vector<Vector3>& sourcePositions, const Vector<Vector3>& sourceNormals, Vector<Vector3>& rotatedPositions, Vector<Vector3>& rotatedNormals);
+    static void Scale(const Vector3& clusterPivot, float32 scale, const Vector<Vector3>& sourcePositions, const Vector<Vector3>& sourceNormals, Vector<Vector3>& scaledPositions, Vector<Vector3>& scaledNormals);
 
     uint32 PrepareResolutionId(uint32 currentResolutionId, uint32 cellX, uint32 cellY) const;
     void InitCustomGeometry(const VegetationGeometryDataPtr& geometryData);
@@ -148,6 +173,7 @@ private:
     uint32 resolutionCount;
 
     Vector<CustomGeometryEntityData> customGeometryData;
+    bool isLoadedFromCache = false;
 };
 };
 
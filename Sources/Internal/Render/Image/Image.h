@@ -101,7 +101,7 @@ public:
     void SaveToSystemPhotos(SaveToSystemPhotoCallbackReceiver* callback = 0);
 #endif
 
-    Vector<Image*> CreateMipMapsImages(bool isNormalMap = false);
+    Vector<Image*> CreateMipMapsImages(bool isNormalMap = false, bool gammaCorrect = false);
 
     bool Normalize();
 
@@ -245,6 +245,19 @@ struct ConvertRGBA8888toRGBA4444
     }
 };
 
+struct ConvertRGBA8888toRGB565
+{
+    inline void operator()(const uint32* input, uint16* output)
+    {
+        //r-channel in least significant bits
+        uint32 pixel = *input;
+        uint32 r = (pixel & 0xFF) >> 3;
+        uint32 g = ((pixel >> 8) & 0xFF) >> 2;
+        uint32 b = ((pixel >> 16) & 0xFF) >> 3;
+        *output = static_cast<uint16>(r | (g << 5) | (b << 11));
+    }
+};
+
 struct ConvertRGBA5551toRGBA8888
 {
     inline void operator()(const uint16* input, uint32* output)
@@ -940,10 +953,15 @@ bool CanConvertDirect(PixelFormat inFormat, PixelFormat outFormat);
 void SwapRedBlueChannels(const Image* srcImage, const Image* dstImage = nullptr);
 void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32 height, uint32 pitch, void* dstData = nullptr);
 
-Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap = false);
+/**
+    Downscales image twice with box filter. Large images are processed by several worker jobs.
+    If `gammaCorrect` is true, color channels of RGBA8888 and RGB888 images are treated as sRGB values
+    and are averaged in linear space, alpha channel is always averaged as is.
+*/
+Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap = false, bool gammaCorrect = false);
 bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
                              const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
-                             void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize);
+                             void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize, bool gammaCorrect = false);
 
 void ResizeRGBA8Billinear(const uint32* inPixels, uint32 w, uint32 h, uint32* outPixels, uint32 w2, uint32 h2);
 
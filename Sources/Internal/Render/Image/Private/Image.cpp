@@ -161,7 +161,7 @@ bool Image::Normalize()
     return normalized;
 }
 
-Vector<Image*> Image::CreateMipMapsImages(bool isNormalMap /* = false */)
+Vector<Image*> Image::CreateMipMapsImages(bool isNormalMap /* = false */, bool gammaCorrect /* = false */)
 {
     DAVA_MEMORY_PROFILER_CLASS_ALLOC_SCOPE();
 
@@ -197,7 +197,7 @@ Vector<Image*> Image::CreateMipMapsImages(bool isNormalMap /* = false */)
 
         bool downScaled = ImageConvert::DownscaleTwiceBillinear(format, format,
                                                                 curImage->data, curImage->width, curImage->height, ImageUtils::GetPitchInBytes(curImage->width, format),
-                                                                halfImage->GetData(), halfWidth, halfHeight, ImageUtils::GetPitchInBytes(halfWidth, format), isNormalMap);
+                                                                halfImage->GetData(), halfWidth, halfHeight, ImageUtils::GetPitchInBytes(halfWidth, format), isNormalMap, gammaCorrect);
         if (!downScaled)
         {
             hasErrors = true;
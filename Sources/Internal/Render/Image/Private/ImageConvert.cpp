@@ -4,6 +4,17 @@
 #include "Engine/Engine.h"
 #include "Functional/Function.h"
 #include "Math/HalfFloat.h"
+#include "Job/JobManager.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMAGE_CONVERT_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+#define IMAGE_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace DAVA
 {
@@ -18,6 +29,416 @@ float32 ChannelIntToFloat(uint32 ch)
     return (static_cast<float32>(ch) / std::numeric_limits<uint8>::max());
 }
 
+namespace ImageConvertDetails
+{
+// Approximate amount of output bytes processed by one worker job
+const uint32 ROW_BLOCK_SIZE = 256 * 1024;
+
+struct RowBlocksState
+{
+    Atomic<uint32> nextBlock;
+    Atomic<uint32> doneBlocks;
+};
+
+/*
+    Calls `fn(beginRow, endRow)` for blocks of rows. For big images blocks are processed in worker jobs.
+    Calling thread takes blocks too and waits only for blocks that are already in progress,
+    so it is safe to call this function from worker jobs.
+*/
+template <typename FN>
+void ForEachRowBlock(uint32 rowCount, uint32 rowSize, const FN& fn)
+{
+    uint32 blockRows = Max(ROW_BLOCK_SIZE / Max(rowSize, 1u), 1u);
+    uint32 blockCount = (rowCount + blockRows - 1) / blockRows;
+
+    JobManager* jobManager = (GetEngineContext() != nullptr) ? GetEngineContext()->jobManager : nullptr;
+    uint32 jobCount = (jobManager != nullptr) ? Min(jobManager->GetWorkersCount(), blockCount - 1) : 0;
+    if (blockCount < 2 || jobCount == 0)
+    {
+        fn(0, rowCount);
+        return;
+    }
+
+    // `fn` is referenced only while there are not taken blocks, i.e. while calling thread waits for them
+    std::shared_ptr<RowBlocksState> state = std::make_shared<RowBlocksState>();
+    auto processBlocks = [state, blockRows, blockCount, rowCount, &fn]()
+    {
+        for (uint32 block = state->nextBlock++; block < blockCount; block = state->nextBlock++)
+        {
+            uint32 beginRow = block * blockRows;
+            fn(beginRow, Min(beginRow + blockRows, rowCount));
+            state->doneBlocks++;
+        }
+    };
+
+    for (uint32 i = 0; i < jobCount; ++i)
+    {
+        jobManager->CreateWorkerJob(processBlocks);
+    }
+
+    processBlocks();
+
+    while (state->doneBlocks.Get() < blockCount)
+    {
+        Thread::Yield();
+    }
+}
+
+template <class TYPE_IN, class TYPE_OUT, typename CONVERT_FUNC>
+void ConvertRows(const void* inData, uint32 width, uint32 height, uint32 inPitch, void* outData, uint32 outPitch)
+{
+    ForEachRowBlock(height, width * sizeof(TYPE_OUT), [&](uint32 beginRow, uint32 endRow)
+                    {
+                        ConvertDirect<TYPE_IN, TYPE_OUT, CONVERT_FUNC> convert;
+                        convert(static_cast<const uint8*>(inData) + beginRow * inPitch, width, endRow - beginRow, inPitch,
+                                static_cast<uint8*>(outData) + beginRow * outPitch, width, endRow - beginRow, outPitch);
+                    });
+}
+
+using RowKernel = void (*)(const uint8* input, uint8* output, uint32 width);
+
+template <class TYPE_OUT>
+void ConvertRows(RowKernel kernel, const void* inData, uint32 width, uint32 height, uint32 inPitch, void* outData, uint32 outPitch)
+{
+    ForEachRowBlock(height, width * sizeof(TYPE_OUT), [&](uint32 beginRow, uint32 endRow)
+                    {
+                        const uint8* readPtr = static_cast<const uint8*>(inData) + beginRow * inPitch;
+                        uint8* writePtr = static_cast<uint8*>(outData) + beginRow * outPitch;
+                        for (uint32 y = beginRow; y < endRow; ++y)
+                        {
+                            kernel(readPtr, writePtr, width);
+                            readPtr += inPitch;
+                            writePtr += outPitch;
+                        }
+                    });
+}
+
+template <class TYPE_IN, class TYPE_OUT, class CHANNEL_TYPE, typename UNPACK_FUNC, typename PACK_FUNC>
+void DownscaleRows(const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
+                   void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    ForEachRowBlock(outHeight, outWidth * sizeof(TYPE_OUT), [&](uint32 beginRow, uint32 endRow)
+                    {
+                        ConvertDownscaleTwiceBillinear<TYPE_IN, TYPE_OUT, CHANNEL_TYPE, UNPACK_FUNC, PACK_FUNC> convert;
+                        convert(static_cast<const uint8*>(inData) + beginRow * 2 * inPitch, inWidth, inHeight, inPitch,
+                                static_cast<uint8*>(outData) + beginRow * outPitch, outWidth, endRow - beginRow, outPitch);
+                    });
+}
+
+// Row kernels below give exactly the same results as scalar convert functions from ImageConvert.h
+
+inline uint32 SwapRedBlue(uint32 pixel)
+{
+    return (pixel & 0xFF00FF00) | ((pixel >> 16) & 0xFF) | ((pixel & 0xFF) << 16);
+}
+
+void SwapRedBlueRow(const uint8* input, uint8* output, uint32 width)
+{
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    const __m128i maskAG = _mm_set1_epi32(0xFF00FF00);
+    const __m128i maskLow = _mm_set1_epi32(0x000000FF);
+    const __m128i maskHigh = _mm_set1_epi32(0x00FF0000);
+    for (; x + 4 <= width; x += 4)
+    {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4));
+        __m128i ag = _mm_and_si128(v, maskAG);
+        __m128i low = _mm_and_si128(_mm_srli_epi32(v, 16), maskLow);
+        __m128i high = _mm_and_si128(_mm_slli_epi32(v, 16), maskHigh);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 4), _mm_or_si128(ag, _mm_or_si128(low, high)));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 16 <= width; x += 16)
+    {
+        uint8x16x4_t v = vld4q_u8(input + x * 4);
+        uint8x16_t tmp = v.val[0];
+        v.val[0] = v.val[2];
+        v.val[2] = tmp;
+        vst4q_u8(output + x * 4, v);
+    }
+#endif
+    for (; x < width; ++x)
+    {
+        uint32 pixel;
+        Memcpy(&pixel, input + x * 4, sizeof(uint32));
+        pixel = SwapRedBlue(pixel);
+        Memcpy(output + x * 4, &pixel, sizeof(uint32));
+    }
+}
+
+void RGB888toRGBA8888Row(const uint8* input, uint8* output, uint32 width)
+{
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_NEON)
+    for (; x + 8 <= width; x += 8)
+    {
+        uint8x8x3_t rgb = vld3_u8(input + x * 3);
+        uint8x8x4_t rgba = { { rgb.val[0], rgb.val[1], rgb.val[2], vdup_n_u8(0xFF) } };
+        vst4_u8(output + x * 4, rgba);
+    }
+#else
+    // four pixels are three 32-bit words on input and four words on output
+    for (; x + 4 <= width; x += 4)
+    {
+        uint32 w[3];
+        Memcpy(w, input + x * 3, sizeof(w));
+        uint32 pixels[4] =
+        {
+          0xFF000000 | (w[0] & 0xFFFFFF),
+          0xFF000000 | (w[0] >> 24) | ((w[1] & 0xFFFF) << 8),
+          0xFF000000 | (w[1] >> 16) | ((w[2] & 0xFF) << 16),
+          0xFF000000 | (w[2] >> 8)
+        };
+        Memcpy(output + x * 4, pixels, sizeof(pixels));
+    }
+#endif
+    ConvertDirect<RGB888, uint32, ConvertRGB888toRGBA8888> convert;
+    convert(input + x * 3, width - x, 1, 0, output + x * 4, width - x, 1, 0);
+}
+
+#if defined(IMAGE_CONVERT_SSE2)
+// packs 32-bit lanes with values in [0, 0xFFFF] to 16-bit lanes
+inline __m128i PackLow16(__m128i v0, __m128i v1)
+{
+    v0 = _mm_srai_epi32(_mm_slli_epi32(v0, 16), 16);
+    v1 = _mm_srai_epi32(_mm_slli_epi32(v1, 16), 16);
+    return _mm_packs_epi32(v0, v1);
+}
+
+inline __m128i RGBA8888toRGBA4444(__m128i v)
+{
+    __m128i r = _mm_slli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF0)), 8);
+    __m128i g = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF000)), 4);
+    __m128i b = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF00000)), 16);
+    __m128i a = _mm_srli_epi32(v, 28);
+    return _mm_or_si128(_mm_or_si128(r, g), _mm_or_si128(b, a));
+}
+
+inline __m128i RGBA8888toRGB565(__m128i v)
+{
+    __m128i r = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF8)), 3);
+    __m128i g = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xFC00)), 5);
+    __m128i b = _mm_srli_epi32(_mm_and_si128(v, _mm_set1_epi32(0xF80000)), 8);
+    return _mm_or_si128(r, _mm_or_si128(g, b));
+}
+#endif
+
+void RGBA8888toRGBA4444Row(const uint8* input, uint8* output, uint32 width)
+{
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4 + 16));
+        __m128i packed = PackLow16(RGBA8888toRGBA4444(v0), RGBA8888toRGBA4444(v1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 2), packed);
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 8 <= width; x += 8)
+    {
+        uint8x8x4_t v = vld4_u8(input + x * 4);
+        uint16x8_t r = vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[0], 4)), 12);
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[1], 4)), 8);
+        uint16x8_t b = vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[2], 4)), 4);
+        uint16x8_t a = vmovl_u8(vshr_n_u8(v.val[3], 4));
+        vst1q_u16(reinterpret_cast<uint16*>(output + x * 2), vorrq_u16(vorrq_u16(r, g), vorrq_u16(b, a)));
+    }
+#endif
+    ConvertDirect<uint32, uint16, ConvertRGBA8888toRGBA4444> convert;
+    convert(input + x * 4, width - x, 1, 0, output + x * 2, width - x, 1, 0);
+}
+
+void RGBA8888toRGB565Row(const uint8* input, uint8* output, uint32 width)
+{
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    for (; x + 8 <= width; x += 8)
+    {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(input + x * 4 + 16));
+        __m128i packed = PackLow16(RGBA8888toRGB565(v0), RGBA8888toRGB565(v1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + x * 2), packed);
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 8 <= width; x += 8)
+    {
+        uint8x8x4_t v = vld4_u8(input + x * 4);
+        uint16x8_t r = vmovl_u8(vshr_n_u8(v.val[0], 3));
+        uint16x8_t g = vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[1], 2)), 5);
+        uint16x8_t b = vshlq_n_u16(vmovl_u8(vshr_n_u8(v.val[2], 3)), 11);
+        vst1q_u16(reinterpret_cast<uint16*>(output + x * 2), vorrq_u16(r, vorrq_u16(g, b)));
+    }
+#endif
+    ConvertDirect<uint32, uint16, ConvertRGBA8888toRGB565> convert;
+    convert(input + x * 4, width - x, 1, 0, output + x * 2, width - x, 1, 0);
+}
+
+void HalfToFloatRow(const uint16* input, float32* output, uint32 count)
+{
+    uint32 i = 0;
+#if defined(IMAGE_CONVERT_NEON) && defined(__aarch64__)
+    for (; i + 4 <= count; i += 4)
+    {
+        float16x4_t h = vreinterpret_f16_u16(vld1_u16(input + i));
+        vst1q_f32(output + i, vcvt_f32_f16(h));
+    }
+#endif
+    for (; i < count; ++i)
+    {
+        output[i] = Float16Compressor::Decompress(input[i]);
+    }
+}
+
+void FloatToHalfRow(const float32* input, uint16* output, uint32 count)
+{
+    // hardware conversion rounds to nearest, so Float16Compressor is used to keep results identical on all platforms
+    for (uint32 i = 0; i < count; ++i)
+    {
+        output[i] = Float16Compressor::Compress(input[i]);
+    }
+}
+
+// Averages 2x2 blocks of RGBA8888 pixels, `outWidth` output pixels are written
+void DownscaleRGBA8888Row(const uint8* row0, const uint8* row1, uint8* output, uint32 outWidth)
+{
+    uint32 x = 0;
+#if defined(IMAGE_CONVERT_SSE2)
+    const __m128i zero = _mm_setzero_si128();
+    for (; x + 2 <= outWidth; x += 2)
+    {
+        __m128i v0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+        __m128i v1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+        __m128i lo = _mm_add_epi16(_mm_unpacklo_epi8(v0, zero), _mm_unpacklo_epi8(v1, zero));
+        __m128i hi = _mm_add_epi16(_mm_unpackhi_epi8(v0, zero), _mm_unpackhi_epi8(v1, zero));
+        lo = _mm_add_epi16(lo, _mm_srli_si128(lo, 8));
+        hi = _mm_add_epi16(hi, _mm_srli_si128(hi, 8));
+        __m128i sum = _mm_srli_epi16(_mm_unpacklo_epi64(lo, hi), 2);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(output + x * 4), _mm_packus_epi16(sum, sum));
+    }
+#elif defined(IMAGE_CONVERT_NEON)
+    for (; x + 2 <= outWidth; x += 2)
+    {
+        uint8x16_t v0 = vld1q_u8(row0 + x * 8);
+        uint8x16_t v1 = vld1q_u8(row1 + x * 8);
+        uint16x8_t lo = vaddl_u8(vget_low_u8(v0), vget_low_u8(v1));
+        uint16x8_t hi = vaddl_u8(vget_high_u8(v0), vget_high_u8(v1));
+        uint16x4_t sumLo = vadd_u16(vget_low_u16(lo), vget_high_u16(lo));
+        uint16x4_t sumHi = vadd_u16(vget_low_u16(hi), vget_high_u16(hi));
+        vst1_u8(output + x * 4, vshrn_n_u16(vcombine_u16(sumLo, sumHi), 2));
+    }
+#endif
+    for (; x < outWidth; ++x)
+    {
+        const uint8* p0 = row0 + x * 8;
+        const uint8* p1 = row1 + x * 8;
+        for (uint32 c = 0; c < 4; ++c)
+        {
+            output[x * 4 + c] = static_cast<uint8>((p0[c] + p0[c + 4] + p1[c] + p1[c + 4]) / 4);
+        }
+    }
+}
+
+void DownscaleRGBA8888(const void* inData, uint32 inPitch, void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch)
+{
+    ForEachRowBlock(outHeight, outWidth * sizeof(uint32), [&](uint32 beginRow, uint32 endRow)
+                    {
+                        for (uint32 y = beginRow; y < endRow; ++y)
+                        {
+                            const uint8* row0 = static_cast<const uint8*>(inData) + y * 2 * inPitch;
+                            DownscaleRGBA8888Row(row0, row0 + inPitch, static_cast<uint8*>(outData) + y * outPitch, outWidth);
+                        }
+                    });
+}
+
+struct SRGBTables
+{
+    static const uint32 LINEAR_BITS = 12;
+
+    SRGBTables()
+    {
+        for (uint32 i = 0; i < 256; ++i)
+        {
+            float32 c = i / 255.f;
+            float32 l = (c <= 0.04045f) ? (c / 12.92f) : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            toLinear[i] = static_cast<uint16>(l * 65535.f + 0.5f);
+        }
+
+        const uint32 size = 1 << LINEAR_BITS;
+        for (uint32 i = 0; i < size; ++i)
+        {
+            float32 l = float32(i) / float32(size - 1);
+            float32 c = (l <= 0.0031308f) ? (l * 12.92f) : (1.055f * std::pow(l, 1.f / 2.4f) - 0.055f);
+            toSRGB[i] = static_cast<uint8>(Clamp(c, 0.f, 1.f) * 255.f + 0.5f);
+        }
+    }
+
+    uint8 LinearToSRGB(uint32 linear) const
+    {
+        return toSRGB[linear >> (16 - LINEAR_BITS)];
+    }
+
+    uint16 toLinear[256];
+    uint8 toSRGB[1 << LINEAR_BITS];
+};
+
+const SRGBTables& GetSRGBTables()
+{
+    static SRGBTables tables;
+    return tables;
+}
+
+struct UnpackSRGBA8888
+{
+    inline void operator()(const uint32* input, uint32& r, uint32& g, uint32& b, uint32& a)
+    {
+        UnpackRGBA8888 unpack;
+        unpack(input, r, g, b, a);
+        r = tables.toLinear[r];
+        g = tables.toLinear[g];
+        b = tables.toLinear[b];
+    }
+
+    const SRGBTables& tables = GetSRGBTables();
+};
+
+struct PackSRGBA8888
+{
+    inline void operator()(uint32 r, uint32 g, uint32 b, uint32 a, uint32* output)
+    {
+        PackRGBA8888 pack;
+        pack(tables.LinearToSRGB(r), tables.LinearToSRGB(g), tables.LinearToSRGB(b), a, output);
+    }
+
+    const SRGBTables& tables = GetSRGBTables();
+};
+
+struct UnpackSRGB888
+{
+    inline void operator()(const RGB888* input, uint32& r, uint32& g, uint32& b, uint32& a)
+    {
+        r = tables.toLinear[input->r];
+        g = tables.toLinear[input->g];
+        b = tables.toLinear[input->b];
+        a = 0xFF;
+    }
+
+    const SRGBTables& tables = GetSRGBTables();
+};
+
+struct PackSRGB888
+{
+    inline void operator()(uint32 r, uint32 g, uint32 b, uint32 a, RGB888* output)
+    {
+        output->r = tables.LinearToSRGB(r);
+        output->g = tables.LinearToSRGB(g);
+        output->b = tables.LinearToSRGB(b);
+    }
+
+    const SRGBTables& tables = GetSRGBTables();
+};
+} // namespace ImageConvertDetails
+
 namespace ImageConvert
 {
 bool Normalize(PixelFormat format, const void* inData, uint32 width, uint32 height, uint32 pitch, void* outData)
@@ -115,98 +536,97 @@ bool ConvertImageDirect(PixelFormat inFormat, PixelFormat outFormat,
 {
     if (inFormat == FORMAT_RGBA5551 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGBA5551toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint16, uint32, ConvertRGBA5551toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA4444 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGBA4444toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint16, uint32, ConvertRGBA4444toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGB888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGB888, uint32, ConvertRGB888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint32>(&ImageConvertDetails::RGB888toRGBA8888Row, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGB565 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertRGB565toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint16, uint32, ConvertRGB565toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_A8 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint8, uint32, ConvertA8toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint8, uint32, ConvertA8toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_A16 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<uint16, uint32, ConvertA16toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint16, uint32, ConvertA16toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<BGR888, RGB888, ConvertBGR888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<BGR888, RGB888, ConvertBGR888toRGB888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGR888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGR888, uint32, ConvertBGR888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<BGR888, uint32, ConvertBGR888toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_BGRA8888 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint32>(&ImageConvertDetails::SwapRedBlueRow, inData, inWidth, inHeight, inPitch, outData, outPitch);
+        return true;
+    }
+    else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_BGRA8888)
+    {
+        ImageConvertDetails::ConvertRows<uint32>(&ImageConvertDetails::SwapRedBlueRow, inData, inWidth, inHeight, inPitch, outData, outPitch);
+        return true;
+    }
+    else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA4444)
+    {
+        ImageConvertDetails::ConvertRows<uint16>(&ImageConvertDetails::RGBA8888toRGBA4444Row, inData, inWidth, inHeight, inPitch, outData, outPitch);
+        return true;
+    }
+    else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGB565)
+    {
+        ImageConvertDetails::ConvertRows<uint16>(&ImageConvertDetails::RGBA8888toRGB565Row, inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGB888)
     {
-        ConvertDirect<uint32, RGB888, ConvertRGBA8888toRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint32, RGB888, ConvertRGBA8888toRGB888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA16161616 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA16161616, uint32, ConvertRGBA16161616toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<RGBA16161616, uint32, ConvertRGBA16161616toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA32323232 && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA32323232, uint32, ConvertRGBA32323232toRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<RGBA32323232, uint32, ConvertRGBA32323232toRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA16F && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA16F, uint32, ConvertRGBA16FtoRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<RGBA16F, uint32, ConvertRGBA16FtoRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA32F && outFormat == FORMAT_RGBA8888)
     {
-        ConvertDirect<RGBA32F, uint32, ConvertRGBA32FtoRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<RGBA32F, uint32, ConvertRGBA32FtoRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA16F)
     {
-        ConvertDirect<uint32, RGBA16F, ConvertRGBA8888toRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint32, RGBA16F, ConvertRGBA8888toRGBA16F>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else if (inFormat == FORMAT_RGBA8888 && outFormat == FORMAT_RGBA32F)
     {
-        ConvertDirect<uint32, RGBA32F, ConvertRGBA8888toRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        ImageConvertDetails::ConvertRows<uint32, RGBA32F, ConvertRGBA8888toRGBA32F>(inData, inWidth, inHeight, inPitch, outData, outPitch);
         return true;
     }
     else
@@ -278,8 +698,7 @@ void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32
     }
     case FORMAT_RGBA8888:
     {
-        ConvertDirect<BGRA8888, RGBA8888, ConvertBGRA8888toRGBA8888> swap;
-        swap(srcData, width, height, pitch, dstData);
+        ImageConvertDetails::ConvertRows<uint32>(&ImageConvertDetails::SwapRedBlueRow, srcData, width, height, pitch, dstData, pitch);
         return;
     }
     case FORMAT_RGBA4444:
@@ -322,65 +741,71 @@ void SwapRedBlueChannels(PixelFormat format, void* srcData, uint32 width, uint32
 
 bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
                              const void* inData, uint32 inWidth, uint32 inHeight, uint32 inPitch,
-                             void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize)
+                             void* outData, uint32 outWidth, uint32 outHeight, uint32 outPitch, bool normalize, bool gammaCorrect)
 {
+    using namespace ImageConvertDetails;
+
     if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA8888))
     {
         if (normalize)
         {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            DownscaleRows<uint32, uint32, uint32, UnpackRGBA8888, PackNormalizedRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
+        else if (gammaCorrect)
+        {
+            DownscaleRows<uint32, uint32, uint32, UnpackSRGBA8888, PackSRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
+        else if ((inWidth > outWidth) && (inHeight > outHeight))
+        {
+            DownscaleRGBA8888(inData, inPitch, outData, outWidth, outHeight, outPitch);
         }
         else
         {
-            ConvertDownscaleTwiceBillinear<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888> convert;
-            convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+            DownscaleRows<uint32, uint32, uint32, UnpackRGBA8888, PackRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
         }
     }
     else if ((inFormat == FORMAT_RGBA8888) && (outFormat == FORMAT_RGBA4444))
     {
-        ConvertDownscaleTwiceBillinear<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<uint32, uint16, uint32, UnpackRGBA8888, PackRGBA4444>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA4444) && (outFormat == FORMAT_RGBA8888))
     {
-        ConvertDownscaleTwiceBillinear<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<uint16, uint32, uint32, UnpackRGBA4444, PackRGBA8888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_A8) && (outFormat == FORMAT_A8))
     {
-        ConvertDownscaleTwiceBillinear<uint8, uint8, uint32, UnpackA8, PackA8> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<uint8, uint8, uint32, UnpackA8, PackA8>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGB888) && (outFormat == FORMAT_RGB888))
     {
-        ConvertDownscaleTwiceBillinear<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        if (gammaCorrect)
+        {
+            DownscaleRows<RGB888, RGB888, uint32, UnpackSRGB888, PackSRGB888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
+        else
+        {
+            DownscaleRows<RGB888, RGB888, uint32, UnpackRGB888, PackRGB888>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        }
     }
     else if ((inFormat == FORMAT_RGBA5551) && (outFormat == FORMAT_RGBA5551))
     {
-        ConvertDownscaleTwiceBillinear<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<uint16, uint16, uint32, UnpackRGBA5551, PackRGBA5551>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16161616) && (outFormat == FORMAT_RGBA16161616))
     {
-        ConvertDownscaleTwiceBillinear<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<RGBA16161616, RGBA16161616, uint32, UnpackRGBA16161616, PackRGBA16161616>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32323232) && (outFormat == FORMAT_RGBA32323232))
     {
-        ConvertDownscaleTwiceBillinear<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<RGBA32323232, RGBA32323232, uint64, UnpackRGBA32323232, PackRGBA32323232>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA16F) && (outFormat == FORMAT_RGBA16F))
     {
-        ConvertDownscaleTwiceBillinear<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<RGBA16F, RGBA16F, float32, UnpackRGBA16F, PackRGBA16F>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else if ((inFormat == FORMAT_RGBA32F) && (outFormat == FORMAT_RGBA32F))
     {
-        ConvertDownscaleTwiceBillinear<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F> convert;
-        convert(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
+        DownscaleRows<RGBA32F, RGBA32F, float32, UnpackRGBA32F, PackRGBA32F>(inData, inWidth, inHeight, inPitch, outData, outWidth, outHeight, outPitch);
     }
     else
     {
@@ -391,7 +816,7 @@ bool DownscaleTwiceBillinear(PixelFormat inFormat, PixelFormat outFormat,
     return true;
 }
 
-Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap /*= false*/)
+Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap /*= false*/, bool gammaCorrect /*= false*/)
 {
     DVASSERT(source != nullptr);
 
@@ -405,7 +830,7 @@ Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap /*= false*/
     if (destination != nullptr)
     {
         uint32 pitchMultiplier = PixelFormatDescriptor::GetPixelFormatSizeInBits(pixelFormat);
-        bool downscaled = DownscaleTwiceBillinear(pixelFormat, pixelFormat, source->GetData(), sWidth, sHeigth, sWidth * pitchMultiplier / 8, destination->GetData(), dWidth, dHeigth, dWidth * pitchMultiplier / 8, isNormalMap);
+        bool downscaled = DownscaleTwiceBillinear(pixelFormat, pixelFormat, source->GetData(), sWidth, sHeigth, sWidth * pitchMultiplier / 8, destination->GetData(), dWidth, dHeigth, dWidth * pitchMultiplier / 8, isNormalMap, gammaCorrect);
         if (downscaled == false)
         {
             SafeRelease(destination);
@@ -417,44 +842,47 @@ Image* DownscaleTwiceBillinear(const Image* source, bool isNormalMap /*= false*/
 
 void ResizeRGBA8Billinear(const uint32* inPixels, uint32 w, uint32 h, uint32* outPixels, uint32 w2, uint32 h2)
 {
-    int32 a, b, c, d, x, y, index;
     float32 x_ratio = (static_cast<float32>(w - 1)) / w2;
     float32 y_ratio = (static_cast<float32>(h - 1)) / h2;
-    float32 x_diff, y_diff, blue, red, green, alpha;
-    uint32 offset = 0;
-    for (uint32 i = 0; i < h2; i++)
-    {
-        for (uint32 j = 0; j < w2; j++)
-        {
-            x = static_cast<int32>(x_ratio * j);
-            y = static_cast<int32>(y_ratio * i);
-            x_diff = (x_ratio * j) - x;
-            y_diff = (y_ratio * i) - y;
-            index = (y * w + x);
-            a = inPixels[index];
-            b = inPixels[index + 1];
-            c = inPixels[index + w];
-            d = inPixels[index + w + 1];
-
-            blue = (a & 0xff) * (1 - x_diff) * (1 - y_diff) + (b & 0xff) * (x_diff) * (1 - y_diff) +
-            (c & 0xff) * (y_diff) * (1 - x_diff) + (d & 0xff) * (x_diff * y_diff);
-
-            green = ((a >> 8) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 8) & 0xff) * (x_diff) * (1 - y_diff) +
-            ((c >> 8) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 8) & 0xff) * (x_diff * y_diff);
-
-            red = ((a >> 16) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 16) & 0xff) * (x_diff) * (1 - y_diff) +
-            ((c >> 16) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 16) & 0xff) * (x_diff * y_diff);
-
-            alpha = ((a >> 24) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 24) & 0xff) * (x_diff) * (1 - y_diff) +
-            ((c >> 24) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 24) & 0xff) * (x_diff * y_diff);
-
-            outPixels[offset++] =
-            (((static_cast<uint32>(alpha)) << 24) & 0xff000000) |
-            (((static_cast<uint32>(red)) << 16) & 0xff0000) |
-            (((static_cast<uint32>(green)) << 8) & 0xff00) |
-            (static_cast<uint32>(blue));
-        }
-    }
+    ImageConvertDetails::ForEachRowBlock(h2, w2 * sizeof(uint32), [&](uint32 beginRow, uint32 endRow)
+                                         {
+                                             int32 a, b, c, d, x, y, index;
+                                             float32 x_diff, y_diff, blue, red, green, alpha;
+                                             uint32 offset = beginRow * w2;
+                                             for (uint32 i = beginRow; i < endRow; i++)
+                                             {
+                                                 for (uint32 j = 0; j < w2; j++)
+                                                 {
+                                                     x = static_cast<int32>(x_ratio * j);
+                                                     y = static_cast<int32>(y_ratio * i);
+                                                     x_diff = (x_ratio * j) - x;
+                                                     y_diff = (y_ratio * i) - y;
+                                                     index = (y * w + x);
+                                                     a = inPixels[index];
+                                                     b = inPixels[index + 1];
+                                                     c = inPixels[index + w];
+                                                     d = inPixels[index + w + 1];
+
+                                                     blue = (a & 0xff) * (1 - x_diff) * (1 - y_diff) + (b & 0xff) * (x_diff) * (1 - y_diff) +
+                                                     (c & 0xff) * (y_diff) * (1 - x_diff) + (d & 0xff) * (x_diff * y_diff);
+
+                                                     green = ((a >> 8) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 8) & 0xff) * (x_diff) * (1 - y_diff) +
+                                                     ((c >> 8) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 8) & 0xff) * (x_diff * y_diff);
+
+                                                     red = ((a >> 16) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 16) & 0xff) * (x_diff) * (1 - y_diff) +
+                                                     ((c >> 16) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 16) & 0xff) * (x_diff * y_diff);
+
+                                                     alpha = ((a >> 24) & 0xff) * (1 - x_diff) * (1 - y_diff) + ((b >> 24) & 0xff) * (x_diff) * (1 - y_diff) +
+                                                     ((c >> 24) & 0xff) * (y_diff) * (1 - x_diff) + ((d >> 24) & 0xff) * (x_diff * y_diff);
+
+                                                     outPixels[offset++] =
+                                                     (((static_cast<uint32>(alpha)) << 24) & 0xff000000) |
+                                                     (((static_cast<uint32>(red)) << 16) & 0xff0000) |
+                                                     (((static_cast<uint32>(green)) << 8) & 0xff00) |
+                                                     (static_cast<uint32>(blue));
+                                                 }
+                                             }
+                                         });
 }
 
 inline float32 ReadFloatDirect(uint8* ptr)
@@ -524,17 +952,31 @@ bool ConvertFloatFormats(uint32 width, uint32 height, PixelFormat inFormat, Pixe
 
     uint8* inPtr = reinterpret_cast<uint8*>(inData);
     uint8* outPtr = reinterpret_cast<uint8*>(outData);
-    for (uint32 y = 0; y < height; ++y)
-    {
-        uint8* inRowPtr = inPtr + y * inPitch;
-        uint8* outRowPtr = outPtr + y * outPitch;
-        for (uint32 x = 0; x < width; ++x)
-        {
-            ConvertFloatPixel(inChannels, inSize, outChannels, outSize, inRowPtr, outRowPtr);
-            inRowPtr += inSize * inChannels;
-            outRowPtr += outSize * outChannels;
-        }
-    }
+    ImageConvertDetails::ForEachRowBlock(height, outPitch, [&](uint32 beginRow, uint32 endRow)
+                                         {
+                                             for (uint32 y = beginRow; y < endRow; ++y)
+                                             {
+                                                 uint8* inRowPtr = inPtr + y * inPitch;
+                                                 uint8* outRowPtr = outPtr + y * outPitch;
+                                                 if (inChannels == outChannels && inSize == 2 && outSize == 4)
+                                                 {
+                                                     ImageConvertDetails::HalfToFloatRow(reinterpret_cast<uint16*>(inRowPtr), reinterpret_cast<float32*>(outRowPtr), width * inChannels);
+                                                 }
+                                                 else if (inChannels == outChannels && inSize == 4 && outSize == 2)
+                                                 {
+                                                     ImageConvertDetails::FloatToHalfRow(reinterpret_cast<float32*>(inRowPtr), reinterpret_cast<uint16*>(outRowPtr), width * inChannels);
+                                                 }
+                                                 else
+                                                 {
+                                                     for (uint32 x = 0; x < width; ++x)
+                                                     {
+                                                         ConvertFloatPixel(inChannels, inSize, outChannels, outSize, inRowPtr, outRowPtr);
+                                                         inRowPtr += inSize * inChannels;
+                                                         outRowPtr += outSize * outChannels;
+                                                     }
+                                                 }
+                                             }
+                                         });
 
     return true;
 }
@@ -795,6 +795,30 @@ void NMaterial::PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFl
     FXCache::GetFXDescriptor(extraFxName.IsValid() ? extraFxName : GetEffectiveFXName(), flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
 }
 
+bool NMaterial::IsAlphablend()
+{
+    const FastName& fxName = GetEffectiveFXName();
+    if (!fxName.IsValid())
+    {
+        return false;
+    }
+
+    UnorderedMap<FastName, int32> flags(16);
+    CollectMaterialFlags(flags);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_USED);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER);
+    flags.erase(NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER);
+    const FXDescriptor& fxDescr = FXCache::GetFXDescriptor(fxName, flags, QualitySettingsSystem::Instance()->GetCurMaterialQuality(GetQualityGroup()));
+    for (const RenderPassDescriptor& passDescr : fxDescr.renderPassDescriptors)
+    {
+        if (passDescr.hasBlend)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
 void NMaterial::PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags)
 {
     uint32 flagsCount = static_cast<uint32>(flags.size());
@@ -188,6 +188,9 @@ public:
     void PreCacheFXWithFlags(const UnorderedMap<FastName, int32>& extraFlags, const FastName& extraFxName = FastName());
     void PreCacheFXVariations(const Vector<FastName>& fxNames, const Vector<FastName>& flags);
 
+    // returns true if any render pass of effective FX blends with framebuffer, i.e. draw order of geometry is visible
+    bool IsAlphablend();
+
     static const float32 DEFAULT_LIGHTMAP_SIZE;
 
     enum eUserFlag
@@ -2,229 +2,229 @@
 
 namespace DAVA
 {
-const FastName NMaterialName::DECAL_ALPHABLEND = FastName("~res:/Materials/Decal.Alphablend.material");
-const FastName NMaterialName::DECAL_ALPHABLEND_CULLFACE = FastName("~res:/Materials/Decal.Alphablend.Cullface.material");
-const FastName NMaterialName::PIXELLIT_SPECULARMAP_ALPHATEST = FastName("~res:/Materials/PixelLit.SpecularMap.Alphatest.material");
-const FastName NMaterialName::TEXTURED_ALPHABLEND = FastName("~res:/Materials/Textured.Alphablend.material");
-const FastName NMaterialName::TEXTURED_ALPHABLEND_CULLFACE = FastName("~res:/Materials/Textured.Alphablend.Cullface.material");
-const FastName NMaterialName::DECAL_ALPHATEST = FastName("~res:/Materials/Decal.Alphatest.material");
-const FastName NMaterialName::PIXELLIT_SPECULARMAP_OPAQUE = FastName("~res:/Materials/PixelLit.SpecularMap.Opaque.material");
-const FastName NMaterialName::TEXTURED_ALPHATEST = FastName("~res:/Materials/Textured.Alphatest.material");
-const FastName NMaterialName::TEXTURED_VERTEXCOLOR_ALPHATEST = FastName("~res:/Materials/Textured.VertexColor.Alphatest.material");
-const FastName NMaterialName::TEXTURED_VERTEXCOLOR_ALPHABLEND = FastName("~res:/Materials/Textured.VertexColor.Alphablend.material");
-const FastName NMaterialName::DECAL_OPAQUE = FastName("~res:/Materials/Decal.Opaque.material");
-const FastName NMaterialName::TEXTURED_OPAQUE = FastName("~res:/Materials/Textured.Opaque.material");
-const FastName NMaterialName::TEXTURED_OPAQUE_NOCULL = FastName("~res:/Materials/Textured.Opaque.NoCull.material");
-const FastName NMaterialName::TEXTURED_VERTEXCOLOR_OPAQUE = FastName("~res:/Materials/Textured.VertexColor.Opaque.material");
-const FastName NMaterialName::DETAIL_ALPHABLEND = FastName("~res:/Materials/Detail.Alphablend.material");
-const FastName NMaterialName::SHADOWRECT = FastName("~res:/Materials/ShadowRect.material");
-const FastName NMaterialName::TILE_MASK = FastName("~res:/Materials/TileMaskAllQualities.material");
-const FastName NMaterialName::TILE_MASK_DEBUG = FastName("~res:/Materials/TileMask.Debug.material");
-const FastName NMaterialName::DETAIL_ALPHATEST = FastName("~res:/Materials/Detail.Alphatest.material");
-const FastName NMaterialName::SHADOW_VOLUME = FastName("~res:/Materials/ShadowVolume.material");
-const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND = FastName("~res:/Materials/VertexColor.Alphablend.material");
-const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND_NODEPTHTEST = FastName("~res:/Materials/VertexColor.Alphablend.NoDepthtest.material");
-const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND_TEXTURED = FastName("~res:/Materials/VertexColor.Alphablend.Textured.material");
-const FastName NMaterialName::DETAIL_OPAQUE = FastName("~res:/Materials/Detail.Opaque.material");
-const FastName NMaterialName::SILHOUETTE = FastName("~res:/Materials/Silhouette.material");
-const FastName NMaterialName::VERTEXCOLOR_FRAMEBLEND_ALPHABLEND = FastName("~res:/Materials/VertexColor.FrameBlend.Alphablend.material");
-const FastName NMaterialName::SKYOBJECT = FastName("~res:/Materials/Skyobject.material");
-const FastName NMaterialName::VERTEXCOLOR_FRAMEBLEND_OPAQUE = FastName("~res:/Materials/VertexColor.FrameBlend.Opaque.material");
-const FastName NMaterialName::PIXELLIT_ALPHATEST = FastName("~res:/Materials/PixelLit.Alphatest.material");
-const FastName NMaterialName::SPEEDTREE_ALPHATEST = FastName("~res:/Materials/SpeedTreeLeaf.Alphatest.material");
-const FastName NMaterialName::SPEEDTREE_ALPHABLEND = FastName("~res:/Materials/SpeedTreeLeaf.Alphablend.material");
-const FastName NMaterialName::SPEEDTREE_ALPHABLEND_ALPHATEST = FastName("~res:/Materials/SpeedTreeLeaf.Alphablend.Alphatest.material");
-const FastName NMaterialName::SPEEDTREE_OPAQUE = FastName("~res:/Materials/SpeedTreeLeaf.Opaque.material");
-const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHATEST = FastName("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphatest.material");
-const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHABLEND = FastName("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphablend.material");
-const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHABLEND_ALPHATEST = FastName("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphablend.Alphatest.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_OPAQUE = FastName("~res:/Materials/SphericalLitAllQualities.Textured.Opaque.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_ALPHATEST = FastName("~res:/Materials/SphericalLitAllQualities.Textured.Alphatest.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_ALPHABLEND = FastName("~res:/Materials/SphericalLitAllQualities.Textured.Alphablend.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_OPAQUE = FastName("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Opaque.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_ALPHATEST = FastName("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Alphatest.material");
-const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_ALPHABLEND = FastName("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Alphablend.material");
-const FastName NMaterialName::VERTEXCOLOR_OPAQUE = FastName("~res:/Materials/VertexColor.Opaque.material");
-const FastName NMaterialName::VERTEXCOLOR_OPAQUE_NODEPTHTEST = FastName("~res:/Materials/VertexColor.Opaque.NoDepthtest.material");
-const FastName NMaterialName::PIXELLIT_OPAQUE = FastName("~res:/Materials/PixelLit.Opaque.material");
-const FastName NMaterialName::TEXTURE_LIGHTMAP_ALPHABLEND = FastName("~res:/Materials/TextureLightmap.Alphablend.material");
-const FastName NMaterialName::VERTEXLIT_ALPHATEST = FastName("~res:/Materials/VertexLit.Alphatest.material");
-const FastName NMaterialName::PIXELLIT_SPECULAR_ALPHATEST = FastName("~res:/Materials/PixelLit.Specular.Alphatest.material");
-const FastName NMaterialName::TEXTURE_LIGHTMAP_ALPHATEST = FastName("~res:/Materials/TextureLightmap.Alphatest.material");
-const FastName NMaterialName::VERTEXLIT_OPAQUE = FastName("~res:/Materials/VertexLit.Opaque.material");
-const FastName NMaterialName::PIXELLIT_SPECULAR_OPAQUE = FastName("~res:/Materials/PixelLit.Specular.Opaque.material");
-const FastName NMaterialName::TEXTURE_LIGHTMAP_OPAQUE = FastName("~res:/Materials/TextureLightmap.Opaque.material");
-const FastName NMaterialName::GRASS = FastName("~res:/Materials/Grass.material");
-
-const FastName NMaterialName::PARTICLES = FastName("~res:/Materials/Particles/Particles.material");
-
-const FastName NMaterialName::DEBUG_DRAW_OPAQUE = FastName("~res:/Materials/DebugDraw/Debug.Opaque.material");
-const FastName NMaterialName::DEBUG_DRAW_ALPHABLEND = FastName("~res:/Materials/DebugDraw/Debug.Alphablend.material");
-const FastName NMaterialName::DEBUG_DRAW_WIREFRAME = FastName("~res:/Materials/DebugDraw/Wireframe.material");
-const FastName NMaterialName::DEBUG_DRAW_PARTICLES = FastName("~res:/Materials/DebugDraw/Debug.Particles.material");
-const FastName NMaterialName::DEBUG_DRAW_PARTICLES_NO_DEPTH = FastName("~res:/Materials/DebugDraw/Debug.Particles.NoDepth.material");
-
-const FastName NMaterialName::WATER_ALL_QUALITIES = FastName("~res:/Materials/WaterAllQualities.material");
-
-const FastName NMaterialName::WATER_PER_PIXEL_REAL_REFLECTIONS = FastName("~res:/Materials/WaterPerPixelRealReflections.material");
-const FastName NMaterialName::WATER_PER_PIXEL_CUBEMAP_ALPHABLEND = FastName("~res:/Materials/WaterPerPixelCubemapAlphablend.material");
-const FastName NMaterialName::WATER_PER_VERTEX_CUBEMAP_DECAL = FastName("~res:/Materials/WaterPerVertexCubemapDecal.material");
-
-const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_PIXEL_OPAQUE = FastName("~res:/Materials/NormalizedBlinnPhongPerPixel.Opaque.material");
-const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_PIXEL_FAST_OPAQUE = FastName("~res:/Materials/NormalizedBlinnPhongPerPixelFast.Opaque.material");
-const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_VERTEX_OPAQUE = FastName("~res:/Materials/NormalizedBlinnPhongPerVertex.Opaque.material");
-
-const FastName NMaterialTextureName::TEXTURE_ALBEDO("albedo");
-const FastName NMaterialTextureName::TEXTURE_NORMAL("normalmap");
-const FastName NMaterialTextureName::TEXTURE_SPECULAR("specularmap");
-const FastName NMaterialTextureName::TEXTURE_DETAIL("detail");
-const FastName NMaterialTextureName::TEXTURE_LIGHTMAP("lightmap");
-const FastName NMaterialTextureName::TEXTURE_DECAL("decal");
-const FastName NMaterialTextureName::TEXTURE_CUBEMAP("cubemap");
-const FastName NMaterialTextureName::TEXTURE_HEIGHTMAP("heightmap");
-const FastName NMaterialTextureName::TEXTURE_TANGENTSPACE("tangentSpace");
-const FastName NMaterialTextureName::TEXTURE_DECALMASK("decalmask");
-const FastName NMaterialTextureName::TEXTURE_DECALTEXTURE("decaltexture");
-const FastName NMaterialTextureName::TEXTURE_FLOW("flowmap");
-const FastName NMaterialTextureName::TEXTURE_NOISE("noiseTex");
-const FastName NMaterialTextureName::TEXTURE_ALPHA_REMAP("alphaRemapTex");
-
-const FastName NMaterialTextureName::TEXTURE_DYNAMIC_REFLECTION("dynamicReflection");
-const FastName NMaterialTextureName::TEXTURE_DYNAMIC_REFRACTION("dynamicRefraction");
-
-const FastName NMaterialTextureName::TEXTURE_PARTICLES_HEATMAP("heatMap");
-const FastName NMaterialTextureName::TEXTURE_PARTICLES_RT("particlesRT");
+const FastName NMaterialName::DECAL_ALPHABLEND = DV_FASTNAME("~res:/Materials/Decal.Alphablend.material");
+const FastName NMaterialName::DECAL_ALPHABLEND_CULLFACE = DV_FASTNAME("~res:/Materials/Decal.Alphablend.Cullface.material");
+const FastName NMaterialName::PIXELLIT_SPECULARMAP_ALPHATEST = DV_FASTNAME("~res:/Materials/PixelLit.SpecularMap.Alphatest.material");
+const FastName NMaterialName::TEXTURED_ALPHABLEND = DV_FASTNAME("~res:/Materials/Textured.Alphablend.material");
+const FastName NMaterialName::TEXTURED_ALPHABLEND_CULLFACE = DV_FASTNAME("~res:/Materials/Textured.Alphablend.Cullface.material");
+const FastName NMaterialName::DECAL_ALPHATEST = DV_FASTNAME("~res:/Materials/Decal.Alphatest.material");
+const FastName NMaterialName::PIXELLIT_SPECULARMAP_OPAQUE = DV_FASTNAME("~res:/Materials/PixelLit.SpecularMap.Opaque.material");
+const FastName NMaterialName::TEXTURED_ALPHATEST = DV_FASTNAME("~res:/Materials/Textured.Alphatest.material");
+const FastName NMaterialName::TEXTURED_VERTEXCOLOR_ALPHATEST = DV_FASTNAME("~res:/Materials/Textured.VertexColor.Alphatest.material");
+const FastName NMaterialName::TEXTURED_VERTEXCOLOR_ALPHABLEND = DV_FASTNAME("~res:/Materials/Textured.VertexColor.Alphablend.material");
+const FastName NMaterialName::DECAL_OPAQUE = DV_FASTNAME("~res:/Materials/Decal.Opaque.material");
+const FastName NMaterialName::TEXTURED_OPAQUE = DV_FASTNAME("~res:/Materials/Textured.Opaque.material");
+const FastName NMaterialName::TEXTURED_OPAQUE_NOCULL = DV_FASTNAME("~res:/Materials/Textured.Opaque.NoCull.material");
+const FastName NMaterialName::TEXTURED_VERTEXCOLOR_OPAQUE = DV_FASTNAME("~res:/Materials/Textured.VertexColor.Opaque.material");
+const FastName NMaterialName::DETAIL_ALPHABLEND = DV_FASTNAME("~res:/Materials/Detail.Alphablend.material");
+const FastName NMaterialName::SHADOWRECT = DV_FASTNAME("~res:/Materials/ShadowRect.material");
+const FastName NMaterialName::TILE_MASK = DV_FASTNAME("~res:/Materials/TileMaskAllQualities.material");
+const FastName NMaterialName::TILE_MASK_DEBUG = DV_FASTNAME("~res:/Materials/TileMask.Debug.material");
+const FastName NMaterialName::DETAIL_ALPHATEST = DV_FASTNAME("~res:/Materials/Detail.Alphatest.material");
+const FastName NMaterialName::SHADOW_VOLUME = DV_FASTNAME("~res:/Materials/ShadowVolume.material");
+const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND = DV_FASTNAME("~res:/Materials/VertexColor.Alphablend.material");
+const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND_NODEPTHTEST = DV_FASTNAME("~res:/Materials/VertexColor.Alphablend.NoDepthtest.material");
+const FastName NMaterialName::VERTEXCOLOR_ALPHABLEND_TEXTURED = DV_FASTNAME("~res:/Materials/VertexColor.Alphablend.Textured.material");
+const FastName NMaterialName::DETAIL_OPAQUE = DV_FASTNAME("~res:/Materials/Detail.Opaque.material");
+const FastName NMaterialName::SILHOUETTE = DV_FASTNAME("~res:/Materials/Silhouette.material");
+const FastName NMaterialName::VERTEXCOLOR_FRAMEBLEND_ALPHABLEND = DV_FASTNAME("~res:/Materials/VertexColor.FrameBlend.Alphablend.material");
+const FastName NMaterialName::SKYOBJECT = DV_FASTNAME("~res:/Materials/Skyobject.material");
+const FastName NMaterialName::VERTEXCOLOR_FRAMEBLEND_OPAQUE = DV_FASTNAME("~res:/Materials/VertexColor.FrameBlend.Opaque.material");
+const FastName NMaterialName::PIXELLIT_ALPHATEST = DV_FASTNAME("~res:/Materials/PixelLit.Alphatest.material");
+const FastName NMaterialName::SPEEDTREE_ALPHATEST = DV_FASTNAME("~res:/Materials/SpeedTreeLeaf.Alphatest.material");
+const FastName NMaterialName::SPEEDTREE_ALPHABLEND = DV_FASTNAME("~res:/Materials/SpeedTreeLeaf.Alphablend.material");
+const FastName NMaterialName::SPEEDTREE_ALPHABLEND_ALPHATEST = DV_FASTNAME("~res:/Materials/SpeedTreeLeaf.Alphablend.Alphatest.material");
+const FastName NMaterialName::SPEEDTREE_OPAQUE = DV_FASTNAME("~res:/Materials/SpeedTreeLeaf.Opaque.material");
+const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHATEST = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphatest.material");
+const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHABLEND = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphablend.material");
+const FastName NMaterialName::SPHERICLIT_SPEEDTREE_ALPHABLEND_ALPHATEST = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.SpeedTreeLeaf.Alphablend.Alphatest.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_OPAQUE = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.Opaque.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_ALPHATEST = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.Alphatest.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_ALPHABLEND = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.Alphablend.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_OPAQUE = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Opaque.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_ALPHATEST = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Alphatest.material");
+const FastName NMaterialName::SPHERICLIT_TEXTURED_VERTEXCOLOR_ALPHABLEND = DV_FASTNAME("~res:/Materials/SphericalLitAllQualities.Textured.VertexColor.Alphablend.material");
+const FastName NMaterialName::VERTEXCOLOR_OPAQUE = DV_FASTNAME("~res:/Materials/VertexColor.Opaque.material");
+const FastName NMaterialName::VERTEXCOLOR_OPAQUE_NODEPTHTEST = DV_FASTNAME("~res:/Materials/VertexColor.Opaque.NoDepthtest.material");
+const FastName NMaterialName::PIXELLIT_OPAQUE = DV_FASTNAME("~res:/Materials/PixelLit.Opaque.material");
+const FastName NMaterialName::TEXTURE_LIGHTMAP_ALPHABLEND = DV_FASTNAME("~res:/Materials/TextureLightmap.Alphablend.material");
+const FastName NMaterialName::VERTEXLIT_ALPHATEST = DV_FASTNAME("~res:/Materials/VertexLit.Alphatest.material");
+const FastName NMaterialName::PIXELLIT_SPECULAR_ALPHATEST = DV_FASTNAME("~res:/Materials/PixelLit.Specular.Alphatest.material");
+const FastName NMaterialName::TEXTURE_LIGHTMAP_ALPHATEST = DV_FASTNAME("~res:/Materials/TextureLightmap.Alphatest.material");
+const FastName NMaterialName::VERTEXLIT_OPAQUE = DV_FASTNAME("~res:/Materials/VertexLit.Opaque.material");
+const FastName NMaterialName::PIXELLIT_SPECULAR_OPAQUE = DV_FASTNAME("~res:/Materials/PixelLit.Specular.Opaque.material");
+const FastName NMaterialName::TEXTURE_LIGHTMAP_OPAQUE = DV_FASTNAME("~res:/Materials/TextureLightmap.Opaque.material");
+const FastName NMaterialName::GRASS = DV_FASTNAME("~res:/Materials/Grass.material");
+
+const FastName NMaterialName::PARTICLES = DV_FASTNAME("~res:/Materials/Particles/Particles.material");
+
+const FastName NMaterialName::DEBUG_DRAW_OPAQUE = DV_FASTNAME("~res:/Materials/DebugDraw/Debug.Opaque.material");
+const FastName NMaterialName::DEBUG_DRAW_ALPHABLEND = DV_FASTNAME("~res:/Materials/DebugDraw/Debug.Alphablend.material");
+const FastName NMaterialName::DEBUG_DRAW_WIREFRAME = DV_FASTNAME("~res:/Materials/DebugDraw/Wireframe.material");
+const FastName NMaterialName::DEBUG_DRAW_PARTICLES = DV_FASTNAME("~res:/Materials/DebugDraw/Debug.Particles.material");
+const FastName NMaterialName::DEBUG_DRAW_PARTICLES_NO_DEPTH = DV_FASTNAME("~res:/Materials/DebugDraw/Debug.Particles.NoDepth.material");
+
+const FastName NMaterialName::WATER_ALL_QUALITIES = DV_FASTNAME("~res:/Materials/WaterAllQualities.material");
+
+const FastName NMaterialName::WATER_PER_PIXEL_REAL_REFLECTIONS = DV_FASTNAME("~res:/Materials/WaterPerPixelRealReflections.material");
+const FastName NMaterialName::WATER_PER_PIXEL_CUBEMAP_ALPHABLEND = DV_FASTNAME("~res:/Materials/WaterPerPixelCubemapAlphablend.material");
+const FastName NMaterialName::WATER_PER_VERTEX_CUBEMAP_DECAL = DV_FASTNAME("~res:/Materials/WaterPerVertexCubemapDecal.material");
+
+const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_PIXEL_OPAQUE = DV_FASTNAME("~res:/Materials/NormalizedBlinnPhongPerPixel.Opaque.material");
+const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_PIXEL_FAST_OPAQUE = DV_FASTNAME("~res:/Materials/NormalizedBlinnPhongPerPixelFast.Opaque.material");
+const FastName NMaterialName::NORMALIZED_BLINN_PHONG_PER_VERTEX_OPAQUE = DV_FASTNAME("~res:/Materials/NormalizedBlinnPhongPerVertex.Opaque.material");
+
+const FastName NMaterialTextureName::TEXTURE_ALBEDO = DV_FASTNAME("albedo");
+const FastName NMaterialTextureName::TEXTURE_NORMAL = DV_FASTNAME("normalmap");
+const FastName NMaterialTextureName::TEXTURE_SPECULAR = DV_FASTNAME("specularmap");
+const FastName NMaterialTextureName::TEXTURE_DETAIL = DV_FASTNAME("detail");
+const FastName NMaterialTextureName::TEXTURE_LIGHTMAP = DV_FASTNAME("lightmap");
+const FastName NMaterialTextureName::TEXTURE_DECAL = DV_FASTNAME("decal");
+const FastName NMaterialTextureName::TEXTURE_CUBEMAP = DV_FASTNAME("cubemap");
+const FastName NMaterialTextureName::TEXTURE_HEIGHTMAP = DV_FASTNAME("heightmap");
+const FastName NMaterialTextureName::TEXTURE_TANGENTSPACE = DV_FASTNAME("tangentSpace");
+const FastName NMaterialTextureName::TEXTURE_DECALMASK = DV_FASTNAME("decalmask");
+const FastName NMaterialTextureName::TEXTURE_DECALTEXTURE = DV_FASTNAME("decaltexture");
+const FastName NMaterialTextureName::TEXTURE_FLOW = DV_FASTNAME("flowmap");
+const FastName NMaterialTextureName::TEXTURE_NOISE = DV_FASTNAME("noiseTex");
+const FastName NMaterialTextureName::TEXTURE_ALPHA_REMAP = DV_FASTNAME("alphaRemapTex");
+
+const FastName NMaterialTextureName::TEXTURE_DYNAMIC_REFLECTION = DV_FASTNAME("dynamicReflection");
+const FastName NMaterialTextureName::TEXTURE_DYNAMIC_REFRACTION = DV_FASTNAME("dynamicRefraction");
+
+const FastName NMaterialTextureName::TEXTURE_PARTICLES_HEATMAP = DV_FASTNAME("heatMap");
+const FastName NMaterialTextureName::TEXTURE_PARTICLES_RT = DV_FASTNAME("particlesRT");
 
 // params
 
-const FastName NMaterialParamName::PARAM_LIGHT_POSITION0("lightPosition0");
-const FastName NMaterialParamName::PARAM_PROP_AMBIENT_COLOR("ambientColor");
-const FastName NMaterialParamName::PARAM_PROP_DIFFUSE_COLOR("diffuseColor");
-const FastName NMaterialParamName::PARAM_PROP_SPECULAR_COLOR("specularColor");
-const FastName NMaterialParamName::PARAM_LIGHT_AMBIENT_COLOR("materialLightAmbientColor");
-const FastName NMaterialParamName::PARAM_LIGHT_DIFFUSE_COLOR("materialLightDiffuseColor");
-const FastName NMaterialParamName::PARAM_LIGHT_SPECULAR_COLOR("materialLightSpecularColor");
-const FastName NMaterialParamName::PARAM_LIGHT_INTENSITY0("lightIntensity0");
-const FastName NMaterialParamName::PARAM_MATERIAL_SPECULAR_SHININESS("materialSpecularShininess");
-const FastName NMaterialParamName::PARAM_FOG_LIMIT("fogLimit");
-const FastName NMaterialParamName::PARAM_FOG_COLOR("fogColor");
-const FastName NMaterialParamName::PARAM_FOG_DENSITY("fogDensity");
-const FastName NMaterialParamName::PARAM_FOG_START("fogStart");
-const FastName NMaterialParamName::PARAM_FOG_END("fogEnd");
-const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_DENSITY("fogHalfspaceDensity");
-const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_HEIGHT("fogHalfspaceHeight");
-const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_FALLOFF("fogHalfspaceFalloff");
-const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_LIMIT("fogHalfspaceLimit");
-const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_COLOR_SUN("fogAtmosphereColorSun");
-const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_COLOR_SKY("fogAtmosphereColorSky");
-const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_SCATTERING("fogAtmosphereScattering");
-const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_DISTANCE("fogAtmosphereDistance");
-const FastName NMaterialParamName::PARAM_FLAT_COLOR("flatColor");
-const FastName NMaterialParamName::PARAM_TEXTURE0_SHIFT("texture0Shift");
-const FastName NMaterialParamName::PARAM_UV_OFFSET("uvOffset");
-const FastName NMaterialParamName::PARAM_UV_SCALE("uvScale");
-const FastName NMaterialParamName::PARAM_LIGHTMAP_SIZE("lightmapSize");
-const FastName NMaterialParamName::PARAM_DECAL_TILE_SCALE("decalTileCoordScale");
-const FastName NMaterialParamName::PARAM_DECAL_TILE_COLOR("decalTileColor");
-const FastName NMaterialParamName::PARAM_DETAIL_TILE_SCALE("detailTileCoordScale");
-const FastName NMaterialParamName::PARAM_RCP_SCREEN_SIZE("rcpScreenSize");
-const FastName NMaterialParamName::PARAM_SCREEN_OFFSET("screenOffset");
-const FastName NMaterialParamName::PARAM_ALPHATEST_THRESHOLD("alphatestThreshold");
-const FastName NMaterialParamName::PARAM_LANDSCAPE_TEXTURE_TILING("textureTiling");
-const FastName NMaterialParamName::WATER_CLEAR_COLOR("waterColor");
-const FastName NMaterialParamName::DEPRECATED_SHADOW_COLOR_PARAM("shadowColor");
-const FastName NMaterialParamName::DEPRECATED_LANDSCAPE_TEXTURE_0_TILING("texture0Tiling");
-const FastName NMaterialParamName::PARAM_TREE_LEAF_COLOR_MUL("treeLeafColorMul");
-const FastName NMaterialParamName::FORCED_SHADOW_DIRECTION_PARAM("forcedShadowDirection");
-const FastName NMaterialParamName::PARAM_SPECULAR_SCALE("inSpecularity");
+const FastName NMaterialParamName::PARAM_LIGHT_POSITION0 = DV_FASTNAME("lightPosition0");
+const FastName NMaterialParamName::PARAM_PROP_AMBIENT_COLOR = DV_FASTNAME("ambientColor");
+const FastName NMaterialParamName::PARAM_PROP_DIFFUSE_COLOR = DV_FASTNAME("diffuseColor");
+const FastName NMaterialParamName::PARAM_PROP_SPECULAR_COLOR = DV_FASTNAME("specularColor");
+const FastName NMaterialParamName::PARAM_LIGHT_AMBIENT_COLOR = DV_FASTNAME("materialLightAmbientColor");
+const FastName NMaterialParamName::PARAM_LIGHT_DIFFUSE_COLOR = DV_FASTNAME("materialLightDiffuseColor");
+const FastName NMaterialParamName::PARAM_LIGHT_SPECULAR_COLOR = DV_FASTNAME("materialLightSpecularColor");
+const FastName NMaterialParamName::PARAM_LIGHT_INTENSITY0 = DV_FASTNAME("lightIntensity0");
+const FastName NMaterialParamName::PARAM_MATERIAL_SPECULAR_SHININESS = DV_FASTNAME("materialSpecularShininess");
+const FastName NMaterialParamName::PARAM_FOG_LIMIT = DV_FASTNAME("fogLimit");
+const FastName NMaterialParamName::PARAM_FOG_COLOR = DV_FASTNAME("fogColor");
+const FastName NMaterialParamName::PARAM_FOG_DENSITY = DV_FASTNAME("fogDensity");
+const FastName NMaterialParamName::PARAM_FOG_START = DV_FASTNAME("fogStart");
+const FastName NMaterialParamName::PARAM_FOG_END = DV_FASTNAME("fogEnd");
+const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_DENSITY = DV_FASTNAME("fogHalfspaceDensity");
+const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_HEIGHT = DV_FASTNAME("fogHalfspaceHeight");
+const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_FALLOFF = DV_FASTNAME("fogHalfspaceFalloff");
+const FastName NMaterialParamName::PARAM_FOG_HALFSPACE_LIMIT = DV_FASTNAME("fogHalfspaceLimit");
+const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_COLOR_SUN = DV_FASTNAME("fogAtmosphereColorSun");
+const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_COLOR_SKY = DV_FASTNAME("fogAtmosphereColorSky");
+const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_SCATTERING = DV_FASTNAME("fogAtmosphereScattering");
+const FastName NMaterialParamName::PARAM_FOG_ATMOSPHERE_DISTANCE = DV_FASTNAME("fogAtmosphereDistance");
+const FastName NMaterialParamName::PARAM_FLAT_COLOR = DV_FASTNAME("flatColor");
+const FastName NMaterialParamName::PARAM_TEXTURE0_SHIFT = DV_FASTNAME("texture0Shift");
+const FastName NMaterialParamName::PARAM_UV_OFFSET = DV_FASTNAME("uvOffset");
+const FastName NMaterialParamName::PARAM_UV_SCALE = DV_FASTNAME("uvScale");
+const FastName NMaterialParamName::PARAM_LIGHTMAP_SIZE = DV_FASTNAME("lightmapSize");
+const FastName NMaterialParamName::PARAM_DECAL_TILE_SCALE = DV_FASTNAME("decalTileCoordScale");
+const FastName NMaterialParamName::PARAM_DECAL_TILE_COLOR = DV_FASTNAME("decalTileColor");
+const FastName NMaterialParamName::PARAM_DETAIL_TILE_SCALE = DV_FASTNAME("detailTileCoordScale");
+const FastName NMaterialParamName::PARAM_RCP_SCREEN_SIZE = DV_FASTNAME("rcpScreenSize");
+const FastName NMaterialParamName::PARAM_SCREEN_OFFSET = DV_FASTNAME("screenOffset");
+const FastName NMaterialParamName::PARAM_ALPHATEST_THRESHOLD = DV_FASTNAME("alphatestThreshold");
+const FastName NMaterialParamName::PARAM_LANDSCAPE_TEXTURE_TILING = DV_FASTNAME("textureTiling");
+const FastName NMaterialParamName::WATER_CLEAR_COLOR = DV_FASTNAME("waterColor");
+const FastName NMaterialParamName::DEPRECATED_SHADOW_COLOR_PARAM = DV_FASTNAME("shadowColor");
+const FastName NMaterialParamName::DEPRECATED_LANDSCAPE_TEXTURE_0_TILING = DV_FASTNAME("texture0Tiling");
+const FastName NMaterialParamName::PARAM_TREE_LEAF_COLOR_MUL = DV_FASTNAME("treeLeafColorMul");
+const FastName NMaterialParamName::FORCED_SHADOW_DIRECTION_PARAM = DV_FASTNAME("forcedShadowDirection");
+const FastName NMaterialParamName::PARAM_SPECULAR_SCALE = DV_FASTNAME("inSpecularity");
 
 // Particles params.
-const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_WHITE("gradientColorForWhite");
-const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_BLACK("gradientColorForBlack");
-const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_MIDDLE("gradientColorForMiddle");
-const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_MIDDLE_POINT("gradientMiddlePoint");
+const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_WHITE = DV_FASTNAME("gradientColorForWhite");
+const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_BLACK = DV_FASTNAME("gradientColorForBlack");
+const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_COLOR_FOR_MIDDLE = DV_FASTNAME("gradientColorForMiddle");
+const FastName NMaterialParamName::PARAM_PARTICLES_GRADIENT_MIDDLE_POINT = DV_FASTNAME("gradientMiddlePoint");
 
 //flags
-const FastName NMaterialFlagName::FLAG_BLENDING = FastName("BLENDING");
-
-const FastName NMaterialFlagName::FLAG_VERTEXFOG = FastName("VERTEX_FOG");
-const FastName NMaterialFlagName::FLAG_FOG_LINEAR = FastName("FOG_LINEAR");
-const FastName NMaterialFlagName::FLAG_FOG_HALFSPACE = FastName("FOG_HALFSPACE");
-const FastName NMaterialFlagName::FLAG_FOG_HALFSPACE_LINEAR = FastName("FOG_HALFSPACE_LINEAR");
-const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE = FastName("FOG_ATMOSPHERE");
-const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE_NO_ATTENUATION = FastName("FOG_ATMOSPHERE_NO_ATTENUATION");
-const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE_NO_SCATTERING = FastName("FOG_ATMOSPHERE_NO_SCATTERING");
-const FastName NMaterialFlagName::FLAG_TEXTURESHIFT = FastName("TEXTURE0_SHIFT_ENABLED");
-const FastName NMaterialFlagName::FLAG_TEXTURE0_ANIMATION_SHIFT = FastName("TEXTURE0_ANIMATION_SHIFT");
-const FastName NMaterialFlagName::FLAG_WAVE_ANIMATION = FastName("WAVE_ANIMATION");
-const FastName NMaterialFlagName::FLAG_FAST_NORMALIZATION = FastName("FAST_NORMALIZATION");
-const FastName NMaterialFlagName::FLAG_TILED_DECAL_MASK = FastName("TILED_DECAL_MASK");
-const FastName NMaterialFlagName::FLAG_TILED_DECAL_ROTATION = FastName("TILE_DECAL_ROTATION");
-const FastName NMaterialFlagName::FLAG_FLATCOLOR = FastName("FLATCOLOR");
-const FastName NMaterialFlagName::FLAG_FLATALBEDO = FastName("FLATALBEDO");
-
-const FastName NMaterialFlagName::FLAG_DISTANCEATTENUATION = FastName("DISTANCE_ATTENUATION");
-const FastName NMaterialFlagName::FLAG_SPECULAR = FastName("SPECULAR");
-const FastName NMaterialFlagName::FLAG_SEPARATE_NORMALMAPS = FastName("SEPARATE_NORMALMAPS");
-
-const FastName NMaterialFlagName::FLAG_SPEED_TREE_OBJECT = FastName("SPEED_TREE_OBJECT");
-const FastName NMaterialFlagName::FLAG_SPHERICAL_LIT = FastName("SPHERICAL_LIT");
-
-const FastName NMaterialFlagName::FLAG_TANGENT_SPACE_WATER_REFLECTIONS = FastName("TANGENT_SPACE_WATER_REFLECTIONS");
-
-const FastName NMaterialFlagName::FLAG_DEBUG_UNITY_Z_NORMAL = FastName("DEBUG_UNITY_Z_NORMAL");
-const FastName NMaterialFlagName::FLAG_DEBUG_Z_NORMAL_SCALE = FastName("DEBUG_Z_NORMAL_SCALE");
-const FastName NMaterialFlagName::FLAG_DEBUG_NORMAL_ROTATION = FastName("DEBUG_NORMAL_ROTATION");
-
-const FastName NMaterialFlagName::FLAG_HARD_SKINNING = FastName("HARD_SKINNING");
-const FastName NMaterialFlagName::FLAG_SOFT_SKINNING = FastName("SOFT_SKINNING");
-
-const FastName NMaterialFlagName::FLAG_FLOWMAP_SKY = FastName("FLOWMAP_SKY");
-const FastName NMaterialFlagName::FLAG_PARTICLES_FLOWMAP = FastName("PARTICLES_FLOWMAP");
-const FastName NMaterialFlagName::FLAG_PARTICLES_FLOWMAP_ANIMATION = FastName("PARTICLES_FLOWMAP_ANIMATION");
-const FastName NMaterialFlagName::FLAG_PARTICLES_PERSPECTIVE_MAPPING = FastName("PARTICLES_PERSPECTIVE_MAPPING");
-const FastName NMaterialFlagName::FLAG_PARTICLES_THREE_POINT_GRADIENT = FastName("PARTICLES_THREE_POINT_GRADIENT");
-const FastName NMaterialFlagName::FLAG_PARTICLES_NOISE = FastName("PARTICLES_NOISE");
-const FastName NMaterialFlagName::FLAG_PARTICLES_FRESNEL_TO_ALPHA = FastName("PARTICLES_FRESNEL_TO_ALPHA");
-const FastName NMaterialFlagName::FLAG_PARTICLES_ALPHA_REMAP = FastName("PARTICLES_ALPHA_REMAP");
-
-const FastName NMaterialFlagName::FLAG_LIGHTMAPONLY = FastName("MATERIAL_VIEW_LIGHTMAP_ONLY");
-const FastName NMaterialFlagName::FLAG_TEXTUREONLY = FastName("MATERIAL_VIEW_TEXTURE_ONLY");
-const FastName NMaterialFlagName::FLAG_SETUPLIGHTMAP = FastName("SETUP_LIGHTMAP");
-const FastName NMaterialFlagName::FLAG_VIEWALBEDO = FastName("VIEW_ALBEDO");
-const FastName NMaterialFlagName::FLAG_VIEWAMBIENT = FastName("VIEW_AMBIENT");
-const FastName NMaterialFlagName::FLAG_VIEWDIFFUSE = FastName("VIEW_DIFFUSE");
-const FastName NMaterialFlagName::FLAG_VIEWSPECULAR = FastName("VIEW_SPECULAR");
-
-const FastName NMaterialFlagName::FLAG_FRAME_BLEND = FastName("FRAME_BLEND");
-const FastName NMaterialFlagName::FLAG_FORCE_2D_MODE = FastName("FORCE_2D_MODE");
-
-const FastName NMaterialFlagName::FLAG_ALPHATEST = FastName("ALPHATESTVALUE");
-const FastName NMaterialFlagName::FLAG_ALPHATESTVALUE = FastName("ALPHATESTVALUE");
-const FastName NMaterialFlagName::FLAG_ALPHASTEPVALUE = FastName("ALPHASTEPVALUE");
-
-const FastName NMaterialFlagName::FLAG_LANDSCAPE_USE_INSTANCING("LANDSCAPE_USE_INSTANCING");
-const FastName NMaterialFlagName::FLAG_LANDSCAPE_LOD_MORPHING("LANDSCAPE_LOD_MORPHING");
-const FastName NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR("LANDSCAPE_MORPHING_COLOR");
-
-const FastName NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE("HEIGHTMAP_FLOAT_TEXTURE");
-
-const FastName NMaterialFlagName::FLAG_ILLUMINATION_USED = FastName("ILLUMINATION_USED");
-const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER = FastName("ILLUMINATION_SHADOW_CASTER");
-const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER = FastName("ILLUMINATION_SHADOW_RECEIVER");
-
-const FastName NMaterialFlagName::FLAG_TEST_OCCLUSION = FastName("TEST_OCCLUSION");
-
-const FastName NMaterialFlagName::FLAG_FORCED_SHADOW_DIRECTION = FastName("FORCED_SHADOW_DIRECTION");
-
-const FastName NMaterialFlagName::FLAG_PARTICLES_DEBUG_SHOW_HEATMAP = FastName("HEATMAP");
-const FastName NMaterialFlagName::FLAG_GEO_DECAL = FastName("GEO_DECAL");
-const FastName NMaterialFlagName::FLAG_GEO_DECAL_SPECULAR = FastName("GEO_DECAL_SPECULAR");
+const FastName NMaterialFlagName::FLAG_BLENDING = DV_FASTNAME("BLENDING");
+
+const FastName NMaterialFlagName::FLAG_VERTEXFOG = DV_FASTNAME("VERTEX_FOG");
+const FastName NMaterialFlagName::FLAG_FOG_LINEAR = DV_FASTNAME("FOG_LINEAR");
+const FastName NMaterialFlagName::FLAG_FOG_HALFSPACE = DV_FASTNAME("FOG_HALFSPACE");
+const FastName NMaterialFlagName::FLAG_FOG_HALFSPACE_LINEAR = DV_FASTNAME("FOG_HALFSPACE_LINEAR");
+const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE = DV_FASTNAME("FOG_ATMOSPHERE");
+const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE_NO_ATTENUATION = DV_FASTNAME("FOG_ATMOSPHERE_NO_ATTENUATION");
+const FastName NMaterialFlagName::FLAG_FOG_ATMOSPHERE_NO_SCATTERING = DV_FASTNAME("FOG_ATMOSPHERE_NO_SCATTERING");
+const FastName NMaterialFlagName::FLAG_TEXTURESHIFT = DV_FASTNAME("TEXTURE0_SHIFT_ENABLED");
+const FastName NMaterialFlagName::FLAG_TEXTURE0_ANIMATION_SHIFT = DV_FASTNAME("TEXTURE0_ANIMATION_SHIFT");
+const FastName NMaterialFlagName::FLAG_WAVE_ANIMATION = DV_FASTNAME("WAVE_ANIMATION");
+const FastName NMaterialFlagName::FLAG_FAST_NORMALIZATION = DV_FASTNAME("FAST_NORMALIZATION");
+const FastName NMaterialFlagName::FLAG_TILED_DECAL_MASK = DV_FASTNAME("TILED_DECAL_MASK");
+const FastName NMaterialFlagName::FLAG_TILED_DECAL_ROTATION = DV_FASTNAME("TILE_DECAL_ROTATION");
+const FastName NMaterialFlagName::FLAG_FLATCOLOR = DV_FASTNAME("FLATCOLOR");
+const FastName NMaterialFlagName::FLAG_FLATALBEDO = DV_FASTNAME("FLATALBEDO");
+
+const FastName NMaterialFlagName::FLAG_DISTANCEATTENUATION = DV_FASTNAME("DISTANCE_ATTENUATION");
+const FastName NMaterialFlagName::FLAG_SPECULAR = DV_FASTNAME("SPECULAR");
+const FastName NMaterialFlagName::FLAG_SEPARATE_NORMALMAPS = DV_FASTNAME("SEPARATE_NORMALMAPS");
+
+const FastName NMaterialFlagName::FLAG_SPEED_TREE_OBJECT = DV_FASTNAME("SPEED_TREE_OBJECT");
+const FastName NMaterialFlagName::FLAG_SPHERICAL_LIT = DV_FASTNAME("SPHERICAL_LIT");
+
+const FastName NMaterialFlagName::FLAG_TANGENT_SPACE_WATER_REFLECTIONS = DV_FASTNAME("TANGENT_SPACE_WATER_REFLECTIONS");
+
+const FastName NMaterialFlagName::FLAG_DEBUG_UNITY_Z_NORMAL = DV_FASTNAME("DEBUG_UNITY_Z_NORMAL");
+const FastName NMaterialFlagName::FLAG_DEBUG_Z_NORMAL_SCALE = DV_FASTNAME("DEBUG_Z_NORMAL_SCALE");
+const FastName NMaterialFlagName::FLAG_DEBUG_NORMAL_ROTATION = DV_FASTNAME("DEBUG_NORMAL_ROTATION");
+
+const FastName NMaterialFlagName::FLAG_HARD_SKINNING = DV_FASTNAME("HARD_SKINNING");
+const FastName NMaterialFlagName::FLAG_SOFT_SKINNING = DV_FASTNAME("SOFT_SKINNING");
+
+const FastName NMaterialFlagName::FLAG_FLOWMAP_SKY = DV_FASTNAME("FLOWMAP_SKY");
+const FastName NMaterialFlagName::FLAG_PARTICLES_FLOWMAP = DV_FASTNAME("PARTICLES_FLOWMAP");
+const FastName NMaterialFlagName::FLAG_PARTICLES_FLOWMAP_ANIMATION = DV_FASTNAME("PARTICLES_FLOWMAP_ANIMATION");
+const FastName NMaterialFlagName::FLAG_PARTICLES_PERSPECTIVE_MAPPING = DV_FASTNAME("PARTICLES_PERSPECTIVE_MAPPING");
+const FastName NMaterialFlagName::FLAG_PARTICLES_THREE_POINT_GRADIENT = DV_FASTNAME("PARTICLES_THREE_POINT_GRADIENT");
+const FastName NMaterialFlagName::FLAG_PARTICLES_NOISE = DV_FASTNAME("PARTICLES_NOISE");
+const FastName NMaterialFlagName::FLAG_PARTICLES_FRESNEL_TO_ALPHA = DV_FASTNAME("PARTICLES_FRESNEL_TO_ALPHA");
+const FastName NMaterialFlagName::FLAG_PARTICLES_ALPHA_REMAP = DV_FASTNAME("PARTICLES_ALPHA_REMAP");
+
+const FastName NMaterialFlagName::FLAG_LIGHTMAPONLY = DV_FASTNAME("MATERIAL_VIEW_LIGHTMAP_ONLY");
+const FastName NMaterialFlagName::FLAG_TEXTUREONLY = DV_FASTNAME("MATERIAL_VIEW_TEXTURE_ONLY");
+const FastName NMaterialFlagName::FLAG_SETUPLIGHTMAP = DV_FASTNAME("SETUP_LIGHTMAP");
+const FastName NMaterialFlagName::FLAG_VIEWALBEDO = DV_FASTNAME("VIEW_ALBEDO");
+const FastName NMaterialFlagName::FLAG_VIEWAMBIENT = DV_FASTNAME("VIEW_AMBIENT");
+const FastName NMaterialFlagName::FLAG_VIEWDIFFUSE = DV_FASTNAME("VIEW_DIFFUSE");
+const FastName NMaterialFlagName::FLAG_VIEWSPECULAR = DV_FASTNAME("VIEW_SPECULAR");
+
+const FastName NMaterialFlagName::FLAG_FRAME_BLEND = DV_FASTNAME("FRAME_BLEND");
+const FastName NMaterialFlagName::FLAG_FORCE_2D_MODE = DV_FASTNAME("FORCE_2D_MODE");
+
+const FastName NMaterialFlagName::FLAG_ALPHATEST = DV_FASTNAME("ALPHATESTVALUE");
+const FastName NMaterialFlagName::FLAG_ALPHATESTVALUE = DV_FASTNAME("ALPHATESTVALUE");
+const FastName NMaterialFlagName::FLAG_ALPHASTEPVALUE = DV_FASTNAME("ALPHASTEPVALUE");
+
+const FastName NMaterialFlagName::FLAG_LANDSCAPE_USE_INSTANCING = DV_FASTNAME("LANDSCAPE_USE_INSTANCING");
+const FastName NMaterialFlagName::FLAG_LANDSCAPE_LOD_MORPHING = DV_FASTNAME("LANDSCAPE_LOD_MORPHING");
+const FastName NMaterialFlagName::FLAG_LANDSCAPE_MORPHING_COLOR = DV_FASTNAME("LANDSCAPE_MORPHING_COLOR");
+
+const FastName NMaterialFlagName::FLAG_HEIGHTMAP_FLOAT_TEXTURE = DV_FASTNAME("HEIGHTMAP_FLOAT_TEXTURE");
+
+const FastName NMaterialFlagName::FLAG_ILLUMINATION_USED = DV_FASTNAME("ILLUMINATION_USED");
+const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_CASTER = DV_FASTNAME("ILLUMINATION_SHADOW_CASTER");
+const FastName NMaterialFlagName::FLAG_ILLUMINATION_SHADOW_RECEIVER = DV_FASTNAME("ILLUMINATION_SHADOW_RECEIVER");
+
+const FastName NMaterialFlagName::FLAG_TEST_OCCLUSION = DV_FASTNAME("TEST_OCCLUSION");
+
+const FastName NMaterialFlagName::FLAG_FORCED_SHADOW_DIRECTION = DV_FASTNAME("FORCED_SHADOW_DIRECTION");
+
+const FastName NMaterialFlagName::FLAG_PARTICLES_DEBUG_SHOW_HEATMAP = DV_FASTNAME("HEATMAP");
+const FastName NMaterialFlagName::FLAG_GEO_DECAL = DV_FASTNAME("GEO_DECAL");
+const FastName NMaterialFlagName::FLAG_GEO_DECAL_SPECULAR = DV_FASTNAME("GEO_DECAL_SPECULAR");
 
 //quality
-const FastName NMaterialQualityName::QUALITY_FLAG_NAME = FastName("Quality");
-const FastName NMaterialQualityName::QUALITY_GROUP_FLAG_NAME = FastName("QualityGroup");
-const FastName NMaterialQualityName::DEFAULT_QUALITY_NAME = FastName("Normal");
+const FastName NMaterialQualityName::QUALITY_FLAG_NAME = DV_FASTNAME("Quality");
+const FastName NMaterialQualityName::QUALITY_GROUP_FLAG_NAME = DV_FASTNAME("QualityGroup");
+const FastName NMaterialQualityName::DEFAULT_QUALITY_NAME = DV_FASTNAME("Normal");
 
 Vector<FastName> RUNTIME_ONLY_FLAGS =
 {
@@ -279,5 +279,5 @@ const DAVA::String NMaterialSerializationKey::MaterialName = "materialName";
 const DAVA::String NMaterialSerializationKey::ConfigName = "configName";
 const DAVA::String NMaterialSerializationKey::ConfigCount = "configCount";
 const DAVA::String NMaterialSerializationKey::ConfigArchive = "configArchive_%d";
-const FastName NMaterialSerializationKey::DefaultConfigName = FastName("Default");
+const FastName NMaterialSerializationKey::DefaultConfigName = DV_FASTNAME("Default");
 };
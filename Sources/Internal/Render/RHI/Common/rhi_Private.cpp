@@ -453,6 +453,14 @@ void Update(Handle tex, const void* data, uint32 level, TextureFace face)
     return (*_Impl.impl_Texture_Update)(tex, data, level, face);
 }
 
+void UpdateRegion(Handle tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    if (_Impl.impl_Texture_UpdateRegion != nullptr)
+        (*_Impl.impl_Texture_UpdateRegion)(tex, levelData, level, x, y, width, height);
+    else
+        (*_Impl.impl_Texture_Update)(tex, levelData, level, TEXTURE_FACE_NONE);
+}
+
 bool NeedRestore(Handle tex)
 {
     return (*_Impl.impl_Texture_NeedRestore)(tex);
@@ -83,6 +83,7 @@ void* Map(Handle tex, unsigned level = 0, TextureFace face = TEXTURE_FACE_NONE);
 void Unmap(Handle tex);
 
 void Update(Handle tex, const void* data, uint32 level, TextureFace face = TEXTURE_FACE_NONE);
+void UpdateRegion(Handle tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height);
 
 bool NeedRestore(Handle tex);
 };
@@ -69,6 +69,25 @@ uint32 TextureStride(TextureFormat format, Size2i size, uint32 level)
 
 //------------------------------------------------------------------------------
 
+uint32 TextureRegionPixelSize(TextureFormat format)
+{
+    switch (format)
+    {
+    case TEXTURE_FORMAT_R8G8B8A8:
+    case TEXTURE_FORMAT_R32F:
+        return sizeof(uint32);
+    case TEXTURE_FORMAT_R5G6B5:
+    case TEXTURE_FORMAT_R16:
+        return sizeof(uint16);
+    case TEXTURE_FORMAT_R8:
+        return sizeof(uint8);
+    default:
+        return 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+
 Size2i TextureExtents(Size2i size, uint32 level)
 {
     return Size2i(std::max(1, size.dx >> level), std::max(1, size.dy >> level));
@@ -37,4 +37,5 @@ namespace rhi
 Size2i TextureExtents(Size2i size, uint32 level);
 uint32 TextureStride(TextureFormat format, Size2i size, uint32 level);
 uint32 TextureSize(TextureFormat format, uint32 width, uint32 height, uint32 level = 0);
+uint32 TextureRegionPixelSize(TextureFormat format); // 0 if format can't be updated by region without conversion
 }
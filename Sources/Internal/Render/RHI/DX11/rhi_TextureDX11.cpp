@@ -430,6 +430,26 @@ void dx11_Texture_Update(Handle tex, const void* data, uint32 level, TextureFace
     dx11_Texture_Unmap(tex);
 }
 
+void dx11_Texture_UpdateRegion(Handle tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureDX11_t* self = TextureDX11Pool::Get(tex);
+    uint32 pixelSize = TextureRegionPixelSize(self->descriptor.format);
+    if (self->descriptor.type == TEXTURE_TYPE_CUBE || pixelSize == 0)
+    {
+        dx11_Texture_Update(tex, levelData, level, TEXTURE_FACE_NONE);
+        return;
+    }
+
+    DVASSERT(!self->isMapped);
+
+    uint32 stride = TextureStride(self->descriptor.format, Size2i(self->descriptor.width, self->descriptor.height), level);
+    const uint8* origin = static_cast<const uint8*>(levelData) + y * stride + x * pixelSize;
+    D3D11_BOX box = { x, y, 0, x + width, y + height, 1 };
+
+    DX11Command cmd(DX11Command::UPDATE_SUBRESOURCE, self->tex2d, level, &box, origin, stride, 0);
+    ExecDX11(&cmd, 1);
+}
+
 bool dx11_Texture_NeedRestore(Handle tex)
 {
     return false;
@@ -449,6 +469,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &dx11_Texture_Map;
     dispatch->impl_Texture_Unmap = &dx11_Texture_Unmap;
     dispatch->impl_Texture_Update = &dx11_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &dx11_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &dx11_Texture_NeedRestore;
 }
 
@@ -1571,6 +1571,13 @@ static void _GLES2_ExecImmediateCommand(CommonImpl::ImmediateCommand* command)
         }
         break;
 
+        case GLCommand::TEX_SUBIMAGE2D:
+        {
+            GL_CALL(glTexSubImage2D(GLenum(arg[0]), GLint(arg[1]), GLint(arg[2]), GLint(arg[3]), GLsizei(arg[4]), GLsizei(arg[5]), GLenum(arg[6]), GLenum(arg[7]), reinterpret_cast<const GLvoid*>(arg[8])));
+            cmd->status = err;
+        }
+        break;
+
         case GLCommand::GENERATE_MIPMAP:
         {
             GL_CALL(glGenerateMipmap(GLenum(arg[0])));
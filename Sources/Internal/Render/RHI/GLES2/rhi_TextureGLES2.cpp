@@ -660,6 +660,44 @@ void gles2_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void gles2_Texture_UpdateRegion(Handle tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
+    Size2i sz = TextureExtents(Size2i(self->width, self->height), level);
+
+    DVASSERT(!self->isRenderBuffer);
+    DVASSERT(!self->isMapped);
+    DVASSERT(x + width <= uint32(sz.dx) && y + height <= uint32(sz.dy));
+
+    if (self->isCubeMap || TextureRegionPixelSize(self->format) == 0)
+    {
+        gles2_Texture_Update(tex, levelData, level, TEXTURE_FACE_NONE);
+        return;
+    }
+
+    GLint int_fmt;
+    GLint fmt;
+    GLenum type;
+    bool compressed;
+    GetGLTextureFormat(self->format, &int_fmt, &fmt, &type, &compressed);
+
+    // GLES2 has no unpack row length, so whole rows of region are uploaded to keep source data contiguous
+    uint32 stride = TextureStride(self->format, Size2i(self->width, self->height), level);
+    const uint8* rows = static_cast<const uint8*>(levelData) + y * stride;
+
+    GLCommand cmd[] =
+    {
+      { GLCommand::SET_ACTIVE_TEXTURE, { GL_TEXTURE0 + 0 } },
+      { GLCommand::BIND_TEXTURE, { GL_TEXTURE_2D, uint64(&(self->uid)) } },
+      { GLCommand::TEX_SUBIMAGE2D, { GL_TEXTURE_2D, uint64(level), 0, uint64(y), uint64(sz.dx), uint64(height), uint64(fmt), type, reinterpret_cast<uint64>(rows) } },
+      { GLCommand::RESTORE_TEXTURE0, {} }
+    };
+
+    ExecGL(cmd, countof(cmd));
+}
+
+//------------------------------------------------------------------------------
+
 bool gles2_Texture_NeedRestore(Handle tex)
 {
     TextureGLES2_t* self = TextureGLES2Pool::Get(tex);
@@ -821,6 +859,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &gles2_Texture_Map;
     dispatch->impl_Texture_Unmap = &gles2_Texture_Unmap;
     dispatch->impl_Texture_Update = &gles2_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &gles2_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &gles2_Texture_NeedRestore;
 }
 
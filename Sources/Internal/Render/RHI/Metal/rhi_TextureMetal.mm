@@ -623,6 +623,28 @@ void metal_Texture_Update(Handle tex, const void* data, uint32 level, TextureFac
 
 //------------------------------------------------------------------------------
 
+void metal_Texture_UpdateRegion(Handle tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height)
+{
+    TextureMetal_t* self = TextureMetalPool::Get(tex);
+    uint32 pixelSize = TextureRegionPixelSize(self->format);
+    if (self->is_cubemap || pixelSize == 0)
+    {
+        metal_Texture_Update(tex, levelData, level, TEXTURE_FACE_NONE);
+        return;
+    }
+
+    uint32 stride = TextureStride(self->format, Size2i(self->width, self->height), level);
+    const uint8* origin = static_cast<const uint8*>(levelData) + y * stride + x * pixelSize;
+    MTLRegion rgn = MTLRegionMake2D(x, y, width, height);
+    [self->uid replaceRegion:rgn mipmapLevel:level withBytes:origin bytesPerRow:stride];
+
+    #if RHI_METAL__USE_PURGABLE_STATE
+    [self->uid setPurgeableState:MTLPurgeableStateNonVolatile];
+    #endif
+}
+
+//------------------------------------------------------------------------------
+
 static bool
 metal_Texture_NeedRestore(Handle tex)
 {
@@ -647,6 +669,7 @@ void SetupDispatch(Dispatch* dispatch)
     dispatch->impl_Texture_Map = &metal_Texture_Map;
     dispatch->impl_Texture_Unmap = &metal_Texture_Unmap;
     dispatch->impl_Texture_Update = &metal_Texture_Update;
+    dispatch->impl_Texture_UpdateRegion = &metal_Texture_UpdateRegion;
     dispatch->impl_Texture_NeedRestore = &metal_Texture_NeedRestore;
 }
 
@@ -252,6 +252,10 @@ void UnmapTexture(HTexture tex);
 
 void UpdateTexture(HTexture tex, const void* data, uint32 level, TextureFace face = TEXTURE_FACE_NONE);
 
+// uploads only region of 2D texture level, `levelData` contains whole level and region is read from it;
+// backends without partial update and formats which need conversion upload whole level
+void UpdateTextureRegion(HTexture tex, const void* levelData, uint32 level, uint32 x, uint32 y, uint32 width, uint32 height);
+
 bool NeedRestoreTexture(HTexture tex);
 
 struct TextureSetDescriptor
@@ -1,10 +1,15 @@
 #include "Scene3D/Scene.h"
 
+#include "Concurrency/Atomic.h"
 #include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
 #include "Entity/ComponentUtils.h"
 #include "FileSystem/FileSystem.h"
+#include "Job/JobManager.h"
+#include "Logger/Logger.h"
+#include "Render/3D/MeshUtils.h"
 #include "Render/3D/StaticMesh.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/Light.h"
@@ -26,6 +31,7 @@
 #include "Scene3D/Components/StaticOcclusionComponent.h"
 #include "Scene3D/Components/AnimationComponent.h"
 #include "Scene3D/Components/MotionComponent.h"
+#include "Scene3D/Components/ParticleEffectComponent.h"
 #include "Scene3D/Components/SlotComponent.h"
 #include "Scene3D/Components/SwitchComponent.h"
 #include "Scene3D/Components/SoundComponent.h"
@@ -79,6 +85,15 @@
 
 namespace DAVA
 {
+namespace SceneDetails
+{
+struct ProcessStageState
+{
+    Atomic<uint32> nextSystem;
+    Atomic<uint32> doneSystems;
+};
+}
+
 //TODO: remove this crap with shadow color
 EntityCache::~EntityCache()
 {
@@ -308,7 +323,11 @@ void Scene::CreateSystems()
     if (SCENE_SYSTEM_LOD_FLAG & systemsMask)
     {
         lodSystem = new LodSystem(this);
-        AddSystem(lodSystem, ComponentUtils::MakeMask<LodComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
+        SceneSystemDataAccess dataAccess;
+        dataAccess.ReadComponents(ComponentUtils::MakeMask<TransformComponent>())
+        .WriteComponents(ComponentUtils::MakeMask<LodComponent>() | ComponentUtils::MakeMask<RenderComponent>() | ComponentUtils::MakeMask<ParticleEffectComponent>())
+        .ReadSingleton<TransformSingleComponent>();
+        AddSystem(lodSystem, ComponentUtils::MakeMask<LodComponent>(), dataAccess, SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
     if (SCENE_SYSTEM_SWITCH_FLAG & systemsMask)
@@ -327,7 +346,11 @@ void Scene::CreateSystems()
     if (SCENE_SYSTEM_SOUND_UPDATE_FLAG & systemsMask)
     {
         soundSystem = new SoundUpdateSystem(this);
-        AddSystem(soundSystem, ComponentUtils::MakeMask<TransformComponent>() | ComponentUtils::MakeMask<SoundComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
+        SceneSystemDataAccess dataAccess;
+        dataAccess.ReadComponents(ComponentUtils::MakeMask<TransformComponent>())
+        .WriteComponents(ComponentUtils::MakeMask<SoundComponent>())
+        .ReadSingleton<TransformSingleComponent>();
+        AddSystem(soundSystem, ComponentUtils::MakeMask<TransformComponent>() | ComponentUtils::MakeMask<SoundComponent>(), dataAccess, SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
     if (SCENE_SYSTEM_RENDER_UPDATE_FLAG & systemsMask)
@@ -375,19 +398,24 @@ void Scene::CreateSystems()
     if (SCENE_SYSTEM_SPEEDTREE_UPDATE_FLAG & systemsMask)
     {
         speedTreeUpdateSystem = new SpeedTreeUpdateSystem(this);
-        AddSystem(speedTreeUpdateSystem, ComponentUtils::MakeMask<SpeedTreeComponent>() | ComponentUtils::MakeMask<RenderComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
+        // wind and wave state is read from WindSystem and WaveSystem
+        SceneSystemDataAccess dataAccess;
+        dataAccess.ReadComponents(ComponentUtils::MakeMask<TransformComponent>() | ComponentUtils::MakeMask<WindComponent>() | ComponentUtils::MakeMask<WaveComponent>())
+        .WriteComponents(ComponentUtils::MakeMask<SpeedTreeComponent>() | ComponentUtils::MakeMask<RenderComponent>())
+        .ReadSingleton<TransformSingleComponent>();
+        AddSystem(speedTreeUpdateSystem, ComponentUtils::MakeMask<SpeedTreeComponent>() | ComponentUtils::MakeMask<RenderComponent>(), dataAccess, SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
     if (SCENE_SYSTEM_WIND_UPDATE_FLAG & systemsMask)
     {
         windSystem = new WindSystem(this);
-        AddSystem(windSystem, ComponentUtils::MakeMask<WindComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
+        AddSystem(windSystem, ComponentUtils::MakeMask<WindComponent>(), SceneSystemDataAccess().WriteComponents(ComponentUtils::MakeMask<WindComponent>()), SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
     if (SCENE_SYSTEM_WAVE_UPDATE_FLAG & systemsMask)
     {
         waveSystem = new WaveSystem(this);
-        AddSystem(waveSystem, ComponentUtils::MakeMask<WaveComponent>(), SCENE_SYSTEM_REQUIRE_PROCESS);
+        AddSystem(waveSystem, ComponentUtils::MakeMask<WaveComponent>(), SceneSystemDataAccess().WriteComponents(ComponentUtils::MakeMask<WaveComponent>()), SCENE_SYSTEM_REQUIRE_PROCESS);
     }
 
     if (SCENE_SYSTEM_GEO_DECAL_FLAG & systemsMask)
@@ -469,6 +497,7 @@ Scene::~Scene()
     systemsToProcess.clear();
     systemsToInput.clear();
     systemsToFixedProcess.clear();
+    processStages.clear();
 
     RemoveAllChildren();
     SafeRelease(sceneGlobalMaterial);
@@ -592,10 +621,18 @@ void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMa
         DVASSERT(wasInserted);
     }
 
+    processStagesDirty = true;
+
     sceneSystem->SetScene(this);
     RegisterEntitiesInSystemRecursively(sceneSystem, this);
 }
 
+void Scene::AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMask, const SceneSystemDataAccess& dataAccess, uint32 processFlags /*= 0*/, SceneSystem* insertBeforeSceneForProcess /*= nullptr*/)
+{
+    sceneSystem->SetDataAccess(dataAccess);
+    AddSystem(sceneSystem, componentMask, processFlags, insertBeforeSceneForProcess);
+}
+
 void Scene::RemoveSystem(SceneSystem* sceneSystem)
 {
     sceneSystem->PrepareForRemove();
@@ -603,6 +640,7 @@ void Scene::RemoveSystem(SceneSystem* sceneSystem)
     RemoveSystem(systemsToProcess, sceneSystem);
     RemoveSystem(systemsToInput, sceneSystem);
     RemoveSystem(systemsToFixedProcess, sceneSystem);
+    processStagesDirty = true;
 
     bool removed = RemoveSystem(systems, sceneSystem);
     if (removed)
@@ -690,25 +728,24 @@ void Scene::Update(float32 timeElapsed)
         fixedUpdate.lastTime -= fixedUpdate.constantTime;
     }
 
-    for (SceneSystem* system : systemsToProcess)
+    if (processStagesDirty)
     {
-        if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
+        BuildProcessStages();
+    }
+
+    for (const Vector<SceneSystem*>& stage : processStages)
+    {
+        if (parallelProcessEnabled && stage.size() > 1)
         {
-            updatableSystem->UpdatePreTransform(timeElapsed);
-            transformSystem->Process(timeElapsed);
-            updatableSystem->UpdatePostTransform(timeElapsed);
+            ProcessSystemsConcurrently(stage, timeElapsed);
         }
-        else if (system == lodSystem)
+        else
         {
-            if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
+            for (SceneSystem* system : stage)
             {
-                lodSystem->Process(timeElapsed);
+                ProcessSystem(system, timeElapsed);
             }
         }
-        else
-        {
-            system->Process(timeElapsed);
-        }
     }
 
     if (transformSingleComponent)
@@ -726,6 +763,127 @@ void Scene::Update(float32 timeElapsed)
     sceneGlobalTime += timeElapsed;
 }
 
+void Scene::ProcessSystem(SceneSystem* system, float32 timeElapsed)
+{
+    if ((systemsMask & SCENE_SYSTEM_UPDATEBLE_FLAG) && system == transformSystem)
+    {
+        updatableSystem->UpdatePreTransform(timeElapsed);
+        transformSystem->Process(timeElapsed);
+        updatableSystem->UpdatePostTransform(timeElapsed);
+    }
+    else if (system == lodSystem)
+    {
+        if (Renderer::GetOptions()->IsOptionEnabled(RenderOptions::UPDATE_LODS))
+        {
+            lodSystem->Process(timeElapsed);
+        }
+    }
+    else
+    {
+        system->Process(timeElapsed);
+    }
+}
+
+void Scene::ProcessSystemsConcurrently(const Vector<SceneSystem*>& stage, float32 timeElapsed)
+{
+    uint32 systemsCount = static_cast<uint32>(stage.size());
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 jobCount = (jobManager != nullptr) ? Min(jobManager->GetWorkersCount(), systemsCount - 1) : 0;
+    if (jobCount == 0)
+    {
+        for (SceneSystem* system : stage)
+        {
+            ProcessSystem(system, timeElapsed);
+        }
+        return;
+    }
+
+    // Main thread takes systems too and waits only for systems that are already processed by workers,
+    // so jobs that start after all systems are taken do nothing.
+    std::shared_ptr<SceneDetails::ProcessStageState> state = std::make_shared<SceneDetails::ProcessStageState>();
+    auto processSystems = [this, state, &stage, systemsCount, timeElapsed]()
+    {
+        for (uint32 i = state->nextSystem++; i < systemsCount; i = state->nextSystem++)
+        {
+            ProcessSystem(stage[i], timeElapsed);
+            state->doneSystems++;
+        }
+    };
+
+    for (uint32 i = 0; i < jobCount; ++i)
+    {
+        jobManager->CreateWorkerJob(processSystems);
+    }
+
+    processSystems();
+
+    while (state->doneSystems.Get() < systemsCount)
+    {
+        Thread::Yield();
+    }
+}
+
+void Scene::BuildProcessStages()
+{
+    processStages.clear();
+
+    // Stages are built for consecutive systems with declared data access.
+    // System is placed to the next stage after the last stage of preceding system it conflicts with.
+    Vector<SceneSystem*> declaredSystems;
+    Vector<uint32> declaredStages;
+    auto flushDeclaredSystems = [&]()
+    {
+        size_t firstStage = processStages.size();
+        for (size_t i = 0; i < declaredSystems.size(); ++i)
+        {
+            uint32 stage = 0;
+            for (size_t j = 0; j < i; ++j)
+            {
+                if (declaredSystems[j]->GetDataAccess().ConflictsWith(declaredSystems[i]->GetDataAccess()))
+                {
+                    stage = Max(stage, declaredStages[j] + 1);
+                }
+            }
+            declaredStages.push_back(stage);
+
+            if (firstStage + stage >= processStages.size())
+            {
+                processStages.resize(firstStage + stage + 1);
+            }
+            processStages[firstStage + stage].push_back(declaredSystems[i]);
+        }
+
+        declaredSystems.clear();
+        declaredStages.clear();
+    };
+
+    for (SceneSystem* system : systemsToProcess)
+    {
+        if (system->GetDataAccess().IsDeclared())
+        {
+            declaredSystems.push_back(system);
+        }
+        else
+        {
+            flushDeclaredSystems();
+            processStages.push_back({ system });
+        }
+    }
+    flushDeclaredSystems();
+
+    processStagesDirty = false;
+}
+
+void Scene::SetParallelProcessEnabled(bool enabled)
+{
+    parallelProcessEnabled = enabled;
+}
+
+bool Scene::IsParallelProcessEnabled() const
+{
+    return parallelProcessEnabled;
+}
+
 void Scene::Draw()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::SCENE_DRAW)
@@ -873,6 +1031,14 @@ void Scene::OptimizeBeforeExport()
         }
     }
 
+    MeshUtils::GeometryOptimizationResult geometryResult = MeshUtils::OptimizeGeometryRecursive(this);
+    if (geometryResult.optimized)
+    {
+        Logger::Info("Geometry optimized: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, vertices %u -> %u",
+                     geometryResult.before.acmr, geometryResult.after.acmr, geometryResult.before.atvr, geometryResult.after.atvr,
+                     geometryResult.vertexCountBefore, geometryResult.vertexCountAfter);
+    }
+
     Entity::OptimizeBeforeExport();
 }
 
@@ -148,6 +148,12 @@ public:
     void UnregisterComponent(Entity* entity, Component* component);
 
     virtual void AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMask, uint32 processFlags = 0, SceneSystem* insertBeforeSceneForProcess = nullptr, SceneSystem* insertBeforeSceneForInput = nullptr, SceneSystem* insertBeforeSceneForFixedProcess = nullptr);
+    /**
+        \brief Adds system that declares data it reads and writes in `Process`.
+        Systems with declared data access that don't conflict with each other are processed concurrently in worker jobs,
+        conflicting systems are processed in order they were added. Systems without declaration are processed serially.
+     */
+    void AddSystem(SceneSystem* sceneSystem, const ComponentMask& componentMask, const SceneSystemDataAccess& dataAccess, uint32 processFlags = 0, SceneSystem* insertBeforeSceneForProcess = nullptr);
     virtual void RemoveSystem(SceneSystem* sceneSystem);
     template <class T>
     T* GetSystem();
@@ -206,6 +212,13 @@ public:
 
     virtual void Update(float32 timeElapsed);
     virtual void Draw();
+
+    /**
+        Enables concurrent processing of systems with declared data access. Disabled by default
+        until results of concurrent processing of engine systems are verified against serial processing.
+    */
+    void SetParallelProcessEnabled(bool enabled);
+    bool IsParallelProcessEnabled() const;
     void SceneDidLoaded() override;
 
     Camera* GetCamera(int32 n);
@@ -263,6 +276,15 @@ protected:
 
     bool RemoveSystem(Vector<SceneSystem*>& storage, SceneSystem* system);
 
+    void ProcessSystem(SceneSystem* system, float32 timeElapsed);
+    void ProcessSystemsConcurrently(const Vector<SceneSystem*>& stage, float32 timeElapsed);
+    void BuildProcessStages();
+
+    // Systems from `systemsToProcess` grouped to stages, systems of one stage are independent from each other
+    Vector<Vector<SceneSystem*>> processStages;
+    bool processStagesDirty = true;
+    bool parallelProcessEnabled = false;
+
     uint32 systemsMask;
     uint32 maxEntityIDCounter;
 
@@ -50,6 +50,16 @@ public:
         return debugLogEnabled;
     }
 
+    inline void SetGeometryQuantizationEnabled(bool state)
+    {
+        geometryQuantizationEnabled = state;
+    }
+
+    inline bool IsGeometryQuantizationEnabled() const
+    {
+        return geometryQuantizationEnabled;
+    }
+
     inline void SetScene(Scene* target)
     {
         scene = target;
@@ -162,6 +172,7 @@ private:
     uint32 version = 0;
 
     bool debugLogEnabled = false;
+    bool geometryQuantizationEnabled = false;
 };
 
 template <template <typename, typename> class Container, class T, class A>
@@ -65,6 +65,16 @@ void SceneFileV2::EnableSaveForGame(bool _isSaveForGame)
     isSaveForGame = _isSaveForGame;
 }
 
+void SceneFileV2::EnableGeometryOptimization(bool _isGeometryOptimizationEnabled)
+{
+    isGeometryOptimizationEnabled = _isGeometryOptimizationEnabled;
+}
+
+void SceneFileV2::EnableGeometryQuantization(bool isGeometryQuantizationEnabled)
+{
+    serializationContext.SetGeometryQuantizationEnabled(isGeometryQuantizationEnabled);
+}
+
 void SceneFileV2::EnableDebugLog(bool _isDebugLogEnabled)
 {
     isDebugLogEnabled = _isDebugLogEnabled;
@@ -1238,6 +1248,17 @@ void SceneFileV2::RebuildTangentSpace(Entity* entity)
         RebuildTangentSpace(entity->GetChild(i));
 }
 
+void SceneFileV2::OptimizeGeometry(Entity* rootNode)
+{
+    MeshUtils::GeometryOptimizationResult result = MeshUtils::OptimizeGeometryRecursive(rootNode);
+    if (result.optimized && isDebugLogEnabled)
+    {
+        Logger::FrameworkDebug("+ optimize geometry: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, vertices %u -> %u",
+                               result.before.acmr, result.after.acmr, result.before.atvr, result.after.atvr,
+                               result.vertexCountBefore, result.vertexCountAfter);
+    }
+}
+
 void SceneFileV2::ConvertShadowVolumes(Entity* entity, NMaterial* shadowMaterialParent)
 {
     RenderObject* ro = GetRenderObject(entity);
@@ -1338,6 +1359,11 @@ void SceneFileV2::OptimizeScene(Entity* rootNode)
         convert.ValidateSpeedTreeComponentCount(rootNode);
     }
 
+    if (isGeometryOptimizationEnabled)
+    {
+        OptimizeGeometry(rootNode);
+    }
+
     QualitySettingsSystem::Instance()->UpdateEntityAfterLoad(rootNode);
 }
 
@@ -130,6 +130,9 @@ public:
     void EnableDebugLog(bool _isDebugLogEnabled);
     bool DebugLogEnabled();
     void EnableSaveForGame(bool _isSaveForGame);
+    void EnableGeometryOptimization(bool _isGeometryOptimizationEnabled);
+    // Polygon groups are saved with lossy MeshCodec encoding. It affects file size only, geometry is decoded to floats on load.
+    void EnableGeometryQuantization(bool isGeometryQuantizationEnabled);
 
     //Material * GetMaterial(int32 index);
     //StaticMesh * GetStaticMesh(int32 index);
@@ -145,6 +148,7 @@ public:
     void ConvertShadowVolumes(Entity* rootNode, NMaterial* shadowMaterialParent);
     void RemoveDeprecatedMaterialFlags(Entity* rootNode);
     void ConvertAlphatestValueMaterials(Entity* rootNode);
+    void OptimizeGeometry(Entity* rootNode);
     int32 removedNodeCount = 0;
 
     void UpdatePolygonGroupRequestedFormatRecursively(Entity* entity);
@@ -194,6 +198,7 @@ private:
 
     bool isDebugLogEnabled;
     bool isSaveForGame;
+    bool isGeometryOptimizationEnabled = false;
     eError lastError;
 
     SerializationContext serializationContext;
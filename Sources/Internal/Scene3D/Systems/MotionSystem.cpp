@@ -1,5 +1,7 @@
 #include "MotionSystem.h"
 
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
 #include "Scene3D/Entity.h"
@@ -11,9 +13,20 @@
 #include "Scene3D/Systems/GlobalEventSystem.h"
 #include "Scene3D/SkeletonAnimation/MotionLayer.h"
 #include "Scene3D/SkeletonAnimation/SimpleMotion.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 
 namespace DAVA
 {
+namespace MotionSystemDetails
+{
+struct UpdateState
+{
+    Atomic<uint32> nextComponent;
+    Atomic<uint32> doneComponents;
+};
+}
+
 MotionSystem::MotionSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -118,13 +131,67 @@ void MotionSystem::Process(float32 timeElapsed)
 
     motionSingleComponent->Clear();
 
-    for (MotionComponent* component : activeComponents)
+    UpdateActiveComponents(timeElapsed);
+}
+
+void MotionSystem::UpdateActiveComponents(float32 dTime)
+{
+    using namespace MotionSystemDetails;
+
+    uint32 componentsCount = static_cast<uint32>(activeComponents.size());
+    activeComponentsEvents.resize(componentsCount);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 jobCount = (jobManager != nullptr && componentsCount > 1 && GetScene()->IsParallelProcessEnabled()) ? Min(jobManager->GetWorkersCount(), componentsCount - 1) : 0;
+    if (jobCount == 0)
+    {
+        for (uint32 i = 0; i < componentsCount; ++i)
+        {
+            UpdateMotionLayers(activeComponents[i], dTime, &activeComponentsEvents[i]);
+        }
+    }
+    else
+    {
+        // each component touches only its own skeleton and events, main thread takes components too
+        std::shared_ptr<UpdateState> state = std::make_shared<UpdateState>();
+        auto updateComponents = [this, state, componentsCount, dTime]()
+        {
+            for (uint32 i = state->nextComponent++; i < componentsCount; i = state->nextComponent++)
+            {
+                UpdateMotionLayers(activeComponents[i], dTime, &activeComponentsEvents[i]);
+                state->doneComponents++;
+            }
+        };
+
+        for (uint32 i = 0; i < jobCount; ++i)
+        {
+            jobManager->CreateWorkerJob(updateComponents);
+        }
+
+        updateComponents();
+
+        while (state->doneComponents.Get() < componentsCount)
+        {
+            Thread::Yield();
+        }
+    }
+
+    for (uint32 i = 0; i < componentsCount; ++i)
     {
-        UpdateMotionLayers(component, timeElapsed);
+        MotionEvents& events = activeComponentsEvents[i];
+
+        motionSingleComponent->animationEnd.insert(events.animationEnd.begin(), events.animationEnd.end());
+        motionSingleComponent->animationMarkerReached.insert(events.animationMarkerReached.begin(), events.animationMarkerReached.end());
+        if (events.simpleMotionFinished)
+            motionSingleComponent->simpleMotionFinished.emplace_back(activeComponents[i]);
+
+        events.animationEnd.clear();
+        events.animationMarkerReached.clear();
+        events.simpleMotionFinished = false;
     }
 }
 
-void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime)
+void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime, MotionEvents* events)
 {
     DVASSERT(motionComponent);
 
@@ -142,10 +209,10 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
             motionLayer->Update(dTime);
 
             for (const auto& motionEnd : motionLayer->GetEndedMotions())
-                motionSingleComponent->animationEnd.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionEnd));
+                events->animationEnd.emplace_back(motionComponent, motionLayer->GetName(), motionEnd);
 
             for (const auto& motionMarker : motionLayer->GetReachedMarkers())
-                motionSingleComponent->animationMarkerReached.insert(MotionSingleComponent::AnimationInfo(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second));
+                events->animationMarkerReached.emplace_back(motionComponent, motionLayer->GetName(), motionMarker.first, motionMarker.second);
 
             const SkeletonPose& pose = motionLayer->GetCurrentSkeletonPose();
             MotionLayer::eMotionBlend blendMode = motionLayer->GetBlendMode();
@@ -171,7 +238,7 @@ void MotionSystem::UpdateMotionLayers(MotionComponent* motionComponent, float32
         {
             simpleMotion->Update(dTime);
             if (!simpleMotion->IsPlaying())
-                motionSingleComponent->simpleMotionFinished.emplace_back(motionComponent);
+                events->simpleMotionFinished = true;
 
             simpleMotion->EvaluatePose(&resultPose);
         }
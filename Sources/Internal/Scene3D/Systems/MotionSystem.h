@@ -4,6 +4,7 @@
 #include "Base/FastName.h"
 #include "Entity/SceneSystem.h"
 #include "Scene3D/Components/SkeletonComponent.h"
+#include "Scene3D/Components/SingleComponents/MotionSingleComponent.h"
 
 namespace DAVA
 {
@@ -30,9 +31,19 @@ protected:
     void SetScene(Scene* scene) override;
 
 private:
-    void UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime);
+    //events of one component are collected separately, so components can be updated concurrently
+    struct MotionEvents
+    {
+        Vector<MotionSingleComponent::AnimationInfo> animationEnd;
+        Vector<MotionSingleComponent::AnimationInfo> animationMarkerReached;
+        bool simpleMotionFinished = false;
+    };
+
+    void UpdateMotionLayers(MotionComponent* motionComponent, float32 dTime, MotionEvents* events);
+    void UpdateActiveComponents(float32 dTime);
 
     Vector<MotionComponent*> activeComponents;
+    Vector<MotionEvents> activeComponentsEvents;
     MotionSingleComponent* motionSingleComponent = nullptr;
 };
 
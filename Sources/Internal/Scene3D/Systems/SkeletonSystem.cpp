@@ -1,8 +1,12 @@
 #include "SkeletonSystem.h"
 
 #include "Animation/AnimationTrack.h"
+#include "Concurrency/Atomic.h"
+#include "Concurrency/Thread.h"
 #include "Debug/ProfilerCPU.h"
 #include "Debug/ProfilerMarkerNames.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Render/Highlevel/SkinnedMesh.h"
 #include "Scene3D/Entity.h"
 #include "Scene3D/Components/ComponentHelpers.h"
@@ -16,6 +20,15 @@
 
 namespace DAVA
 {
+namespace SkeletonSystemDetails
+{
+struct UpdateState
+{
+    Atomic<uint32> nextEntity;
+    Atomic<uint32> doneEntities;
+};
+}
+
 SkeletonSystem::SkeletonSystem(Scene* scene)
     : SceneSystem(scene)
 {
@@ -72,26 +85,53 @@ void SkeletonSystem::Process(float32 timeElapsed)
     UpdateTestSkeletons();
 #endif
 
-    for (int32 i = 0, sz = static_cast<int32>(entities.size()); i < sz; ++i)
-    {
-        SkeletonComponent* component = GetSkeletonComponent(entities[i]);
+    using namespace SkeletonSystemDetails;
 
-        if (component != nullptr)
+    uint32 entitiesCount = static_cast<uint32>(entities.size());
+    updatedSkinnedMeshes.resize(entitiesCount);
+
+    JobManager* jobManager = GetEngineContext()->jobManager;
+    uint32 jobCount = (jobManager != nullptr && entitiesCount > 1 && GetScene()->IsParallelProcessEnabled()) ? Min(jobManager->GetWorkersCount(), entitiesCount - 1) : 0;
+    if (jobCount == 0)
+    {
+        for (uint32 i = 0; i < entitiesCount; ++i)
+        {
+            updatedSkinnedMeshes[i] = UpdateSkeleton(entities[i]);
+        }
+    }
+    else
+    {
+        // skeletons are independent, main thread takes them too
+        std::shared_ptr<UpdateState> state = std::make_shared<UpdateState>();
+        auto updateSkeletons = [this, state, entitiesCount]()
         {
-            if (component->configUpdated)
+            for (uint32 i = state->nextEntity++; i < entitiesCount; i = state->nextEntity++)
             {
-                RebuildSkeleton(GetSkeletonComponent(entities[i]));
+                updatedSkinnedMeshes[i] = UpdateSkeleton(entities[i]);
+                state->doneEntities++;
             }
+        };
 
-            if (component->startJoint != SkeletonComponent::INVALID_JOINT_INDEX)
-            {
-                UpdateJointTransforms(component);
-                RenderObject* ro = GetRenderObject(entities[i]);
-                if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
-                {
-                    UpdateSkinnedMesh(component, static_cast<SkinnedMesh*>(ro));
-                }
-            }
+        for (uint32 i = 0; i < jobCount; ++i)
+        {
+            jobManager->CreateWorkerJob(updateSkeletons);
+        }
+
+        updateSkeletons();
+
+        while (state->doneEntities.Get() < entitiesCount)
+        {
+            Thread::Yield();
+        }
+    }
+
+    // render system isn't thread safe, so meshes are marked after all skeletons are updated
+    RenderSystem* renderSystem = GetScene()->GetRenderSystem();
+    for (SkinnedMesh* skinnedMesh : updatedSkinnedMeshes)
+    {
+        if (skinnedMesh != nullptr)
+        {
+            renderSystem->MarkForUpdate(skinnedMesh);
         }
     }
 
@@ -137,6 +177,33 @@ void SkeletonSystem::DrawSkeletons(RenderHelper* drawer)
     }
 }
 
+SkinnedMesh* SkeletonSystem::UpdateSkeleton(Entity* entity)
+{
+    SkeletonComponent* component = GetSkeletonComponent(entity);
+    if (component == nullptr)
+        return nullptr;
+
+    if (component->configUpdated)
+    {
+        RebuildSkeleton(component);
+    }
+
+    if (component->startJoint == SkeletonComponent::INVALID_JOINT_INDEX)
+        return nullptr;
+
+    UpdateJointTransforms(component);
+
+    RenderObject* ro = GetRenderObject(entity);
+    if (ro != nullptr && (RenderObject::TYPE_SKINNED_MESH == ro->GetType()))
+    {
+        SkinnedMesh* skinnedMesh = static_cast<SkinnedMesh*>(ro);
+        PrepareSkinnedMesh(component, skinnedMesh);
+        return skinnedMesh;
+    }
+
+    return nullptr;
+}
+
 void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 {
     DVASSERT(!skeleton->configUpdated);
@@ -183,6 +250,12 @@ void SkeletonSystem::UpdateJointTransforms(SkeletonComponent* skeleton)
 }
 
 void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
+{
+    PrepareSkinnedMesh(skeleton, skinnedMeshObject);
+    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
+}
+
+void SkeletonSystem::PrepareSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject)
 {
     DVASSERT(!skeleton->configUpdated);
 
@@ -199,8 +272,6 @@ void SkeletonSystem::UpdateSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh*
 
     skinnedMeshObject->UpdateJointTransforms(skeleton->finalTransforms);
     skinnedMeshObject->SetBoundingBox(resBox); //TODO: *Skinning* decide on bbox calculation
-
-    GetScene()->GetRenderSystem()->MarkForUpdate(skinnedMeshObject);
 }
 
 void SkeletonSystem::RebuildSkeleton(SkeletonComponent* skeleton)
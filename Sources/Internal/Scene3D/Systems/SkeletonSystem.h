@@ -28,13 +28,16 @@ public:
     void DrawSkeletons(RenderHelper* drawer);
 
 private:
+    SkinnedMesh* UpdateSkeleton(Entity* entity);
     void UpdateJointTransforms(SkeletonComponent* skeleton);
+    void PrepareSkinnedMesh(SkeletonComponent* skeleton, SkinnedMesh* skinnedMeshObject);
 
     void RebuildSkeleton(SkeletonComponent* skeleton);
 
     void UpdateTestSkeletons(float32 timeElapsed);
 
     Vector<Entity*> entities;
+    Vector<SkinnedMesh*> updatedSkinnedMeshes;
 };
 
 } //ns
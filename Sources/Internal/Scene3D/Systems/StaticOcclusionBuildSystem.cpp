@@ -14,6 +14,9 @@
 #include "Render/3D/PolygonGroup.h"
 #include "Render/Highlevel/Landscape.h"
 #include "Render/Highlevel/StaticOcclusion.h"
+#include "Render/Highlevel/StaticOcclusionSoftwareBaker.h"
+#include "Engine/Engine.h"
+#include "Job/JobManager.h"
 #include "Scene3D/Components/ComponentHelpers.h"
 #include "Scene3D/Lod/LodComponent.h"
 #include "Scene3D/Lod/LodSystem.h"
@@ -35,6 +38,7 @@ StaticOcclusionBuildSystem::~StaticOcclusionBuildSystem()
 {
     GetScene()->GetEventSystem()->UnregisterSystemForEvent(this, EventSystem::STATIC_OCCLUSION_COMPONENT_CHANGED);
     SafeDelete(staticOcclusion);
+    SafeDelete(softwareBaker);
 }
 
 void StaticOcclusionBuildSystem::AddEntity(Entity* entity)
@@ -66,6 +70,7 @@ void StaticOcclusionBuildSystem::PrepareRenderObjects()
 {
     GetScene()->staticOcclusionSystem->ClearOcclusionObjects();
     landscape = nullptr;
+    occlusionRenderObjects.clear();
 
     // Prepare render objects
     Vector<Entity*> sceneEntities;
@@ -81,6 +86,7 @@ void StaticOcclusionBuildSystem::PrepareRenderObjects()
         {
             renderObject->AddFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
             renderObject->SetStaticOcclusionIndex(index++);
+            occlusionRenderObjects.push_back(renderObject);
         }
         else if (RenderObject::TYPE_LANDSCAPE == renderObjectType)
         {
@@ -107,11 +113,18 @@ void StaticOcclusionBuildSystem::Cancel()
 {
     activeIndex = -1;
     SafeDelete(staticOcclusion);
+    SafeDelete(softwareBaker);
 
     GetScene()->staticOcclusionSystem->InvalidateOcclusion();
     SceneForceLod(LodComponent::INVALID_LOD_LAYER);
 }
 
+void StaticOcclusionBuildSystem::SetSoftwareBakingEnabled(bool enabled)
+{
+    DVASSERT(!IsInBuild());
+    softwareBakingEnabled = enabled;
+}
+
 void StaticOcclusionBuildSystem::CollectEntitiesForOcclusionRecursively(Vector<Entity*>& dest, Entity* entity)
 {
     if (GetAnimationComponent(entity)) //skip animated hierarchies
@@ -188,6 +201,15 @@ void StaticOcclusionBuildSystem::StartBuildOcclusion()
     data.Init(occlusionComponent->GetSubdivisionsX(), occlusionComponent->GetSubdivisionsY(),
               occlusionComponent->GetSubdivisionsZ(), objectsCount, worldBox, occlusionComponent->GetCellHeightOffsets());
 
+    if (softwareBakingEnabled)
+    {
+        if (nullptr == softwareBaker)
+            softwareBaker = new StaticOcclusionSoftwareBaker();
+
+        softwareBaker->StartBake(&data, occlusionRenderObjects, landscape, occlusionComponent->GetOcclusionPixelThreshold(), occlusionComponent->GetOcclusionPixelThresholdForSpeedtree());
+        return;
+    }
+
     if (nullptr == staticOcclusion)
         staticOcclusion = new StaticOcclusion();
 
@@ -231,7 +253,13 @@ uint32 StaticOcclusionBuildSystem::GetBuildStatus() const
 {
     uint32 ret = 0;
 
-    if (staticOcclusion)
+    if (softwareBakingEnabled && softwareBaker)
+    {
+        uint32 currentStepsCount = softwareBaker->GetCurrentStepsCount();
+        uint32 totalStepsCount = softwareBaker->GetTotalStepsCount();
+        ret = (currentStepsCount * 100) / Max(totalStepsCount, 1u);
+    }
+    else if (staticOcclusion)
     {
         uint32 currentStepsCount = staticOcclusion->GetCurrentStepsCount();
         uint32 totalStepsCount = staticOcclusion->GetTotalStepsCount();
@@ -243,6 +271,11 @@ uint32 StaticOcclusionBuildSystem::GetBuildStatus() const
 const String& StaticOcclusionBuildSystem::GetBuildStatusInfo() const
 {
     static const String defaultMessage = "Static occlusion system not started";
+    if (softwareBakingEnabled)
+    {
+        return (softwareBaker == nullptr) ? defaultMessage : softwareBaker->GetInfoMessage();
+    }
+
     if (staticOcclusion == nullptr)
     {
         return defaultMessage;
@@ -286,7 +319,19 @@ void StaticOcclusionBuildSystem::Process(float32 timeElapsed)
     if (activeIndex == static_cast<uint32>(-1))
         return;
 
-    bool finished = staticOcclusion->ProcessBlock();
+    bool finished = false;
+    if (softwareBakingEnabled)
+    {
+        // one block per worker and calling thread per frame keeps editor responsive
+        JobManager* jobManager = GetEngineContext()->jobManager;
+        uint32 blocksPerProcess = ((jobManager != nullptr) ? jobManager->GetWorkersCount() : 0) + 1;
+        finished = softwareBaker->ProcessBlocks(blocksPerProcess);
+    }
+    else
+    {
+        finished = staticOcclusion->ProcessBlock();
+    }
+
     if (finished)
     {
         FinishBuildOcclusion();
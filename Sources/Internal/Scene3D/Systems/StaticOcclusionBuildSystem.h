@@ -12,6 +12,7 @@ class Landscape;
 class RenderObject;
 class StaticOcclusion;
 class StaticOcclusionComponent;
+class StaticOcclusionSoftwareBaker;
 class StaticOcclusionData;
 class StaticOcclusionDataComponent;
 class StaticOcclusionDebugDrawComponent;
@@ -35,6 +36,13 @@ public:
     void Build();
     void Cancel();
 
+    /**
+        Selects CPU baker instead of GPU occlusion queries, see StaticOcclusionSoftwareBaker.
+        CPU baker doesn't need renderer and processes several blocks per Process call in parallel.
+    */
+    void SetSoftwareBakingEnabled(bool enabled);
+    bool IsSoftwareBakingEnabled() const;
+
     bool IsInBuild() const;
     uint32 GetBuildStatus() const;
     const String& GetBuildStatusInfo() const;
@@ -51,7 +59,10 @@ private:
     Camera* camera = nullptr;
     Landscape* landscape = nullptr;
     Vector<Entity*> occlusionEntities;
+    Vector<RenderObject*> occlusionRenderObjects;
     StaticOcclusion* staticOcclusion = nullptr;
+    StaticOcclusionSoftwareBaker* softwareBaker = nullptr;
+    bool softwareBakingEnabled = false;
     StaticOcclusionDataComponent* componentInProgress = nullptr;
     uint32 activeIndex = -1;
     uint32 objectsCount = 0;
@@ -62,6 +73,11 @@ inline void StaticOcclusionBuildSystem::SetCamera(Camera* _camera)
     camera = _camera;
 }
 
+inline bool StaticOcclusionBuildSystem::IsSoftwareBakingEnabled() const
+{
+    return softwareBakingEnabled;
+}
+
 } // ns
 
 #endif /* __DAVAENGINE_SCENE3D_STATIC_OCCLUSION_SYSTEM_H__ */
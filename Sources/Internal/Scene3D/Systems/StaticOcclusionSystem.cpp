@@ -23,17 +23,74 @@
 
 namespace DAVA
 {
+namespace StaticOcclusionSystemDetails
+{
+const uint32 CACHE_LINE_WORDS = 64 / sizeof(uint32);
+
+inline uint32 CountBits(uint32 x)
+{
+#ifdef __GNUC__
+    return uint32(__builtin_popcount(x));
+#else
+    x -= ((x >> 1) & 0x55555555);
+    x = (((x >> 2) & 0x33333333) + (x & 0x33333333));
+    x = (((x >> 4) + x) & 0x0f0f0f0f);
+    x += (x >> 8);
+    x += (x >> 16);
+    return x & 0x0000003f;
+#endif
+}
+
+inline void PrefetchMemory(const void* ptr)
+{
+#ifdef __GNUC__
+    __builtin_prefetch(ptr);
+#endif
+}
+
+//camera usually moves to adjacent cell, so warm up visibility data of horizontal neighbours
+void PrefetchNeighbourBlocks(uint32 blockIndex, StaticOcclusionData* data)
+{
+    uint32 x = blockIndex % data->sizeX;
+    uint32 y = (blockIndex / data->sizeX) % data->sizeY;
+    uint32 blockWords = data->objectCount / 32;
+
+    uint32 neighbours[4];
+    uint32 neighboursCount = 0;
+    if (x > 0)
+        neighbours[neighboursCount++] = blockIndex - 1;
+    if (x + 1 < data->sizeX)
+        neighbours[neighboursCount++] = blockIndex + 1;
+    if (y > 0)
+        neighbours[neighboursCount++] = blockIndex - data->sizeX;
+    if (y + 1 < data->sizeY)
+        neighbours[neighboursCount++] = blockIndex + data->sizeX;
+
+    for (uint32 n = 0; n < neighboursCount; ++n)
+    {
+        const uint32* bitdata = data->GetBlockVisibilityData(neighbours[n]);
+        for (uint32 w = 0; w < blockWords; w += CACHE_LINE_WORDS)
+            PrefetchMemory(bitdata + w);
+    }
+}
+}
+
 //
 // Static Occlusion System
 //
 
 void StaticOcclusionSystem::UndoOcclusionVisibility()
 {
-    for (auto ro : indexedRenderObjects)
+    //only objects hidden by current cell need flag update
+    for (uint32 w = 0, wordCount = static_cast<uint32>(appliedVisibility.size()); w < wordCount; ++w)
     {
-        if (ro != nullptr)
+        uint32 changed = ~appliedVisibility[w] & presentObjects[w];
+        appliedVisibility[w] = ~0u;
+        while (changed != 0)
         {
-            ro->SetFlags(ro->GetFlags() | RenderObject::VISIBLE_STATIC_OCCLUSION);
+            uint32 lowestBit = changed & (0u - changed);
+            changed ^= lowestBit;
+            indexedRenderObjects[w * 32 + FastLog2(lowestBit)]->AddFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
         }
     }
 
@@ -46,29 +103,34 @@ void StaticOcclusionSystem::UndoOcclusionVisibility()
 
 void StaticOcclusionSystem::ProcessStaticOcclusionForOneDataSet(uint32 blockIndex, StaticOcclusionData* data)
 {
+    using namespace StaticOcclusionSystemDetails;
+
     occludedObjectsCount = 0;
     visibleObjestsCount = 0;
 
-    uint32* bitdata = data->GetBlockVisibilityData(blockIndex);
-    uint32 size = static_cast<uint32>(indexedRenderObjects.size());
-    for (uint32 k = 0; k < size; ++k)
+    //flags are touched only for objects which visibility differs from previously applied cell
+    const uint32* bitdata = data->GetBlockVisibilityData(blockIndex);
+    uint32 wordCount = Min(static_cast<uint32>(appliedVisibility.size()), data->objectCount / 32);
+    for (uint32 w = 0; w < wordCount; ++w)
     {
-        uint32 index = k / 32; // number of bits in uint32
-        uint32 shift = k & 31; // bitmask for uint32
+        uint32 visibility = bitdata[w];
+        uint32 present = presentObjects[w];
+        uint32 changed = (appliedVisibility[w] ^ visibility) & present;
+        appliedVisibility[w] = visibility;
 
-        RenderObject* ro = indexedRenderObjects[k];
-        if (nullptr == ro)
-            continue;
+        visibleObjestsCount += CountBits(visibility & present);
+        occludedObjectsCount += CountBits(~visibility & present);
 
-        if (bitdata[index] & (1 << shift))
+        while (changed != 0)
         {
-            ro->SetFlags(ro->GetFlags() | RenderObject::VISIBLE_STATIC_OCCLUSION);
-            ++visibleObjestsCount;
-        }
-        else
-        {
-            ro->SetFlags(ro->GetFlags() & ~RenderObject::VISIBLE_STATIC_OCCLUSION);
-            ++occludedObjectsCount;
+            uint32 lowestBit = changed & (0u - changed);
+            changed ^= lowestBit;
+
+            RenderObject* ro = indexedRenderObjects[w * 32 + FastLog2(lowestBit)];
+            if (visibility & lowestBit)
+                ro->AddFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
+            else
+                ro->RemoveFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
         }
     }
 
@@ -172,6 +234,7 @@ void StaticOcclusionSystem::Process(float32 timeElapsed)
     if (needUpdatePVS)
     {
         ProcessStaticOcclusionForOneDataSet(activeBlockIndex, activePVSSet);
+        StaticOcclusionSystemDetails::PrefetchNeighbourBlocks(activeBlockIndex, activePVSSet);
     }
 
 #if defined(__DAVAENGINE_RENDERSTATS__)
@@ -239,10 +302,22 @@ void StaticOcclusionSystem::AddRenderObjectToOcclusion(RenderObject* renderObjec
      */
     if (renderObject->GetStaticOcclusionIndex() != INVALID_STATIC_OCCLUSION_INDEX)
     {
-        indexedRenderObjects.resize(Max(static_cast<uint32>(indexedRenderObjects.size()), static_cast<uint32>(renderObject->GetStaticOcclusionIndex() + 1)));
-        DVASSERT(indexedRenderObjects[renderObject->GetStaticOcclusionIndex()] == nullptr,
+        uint32 index = static_cast<uint32>(renderObject->GetStaticOcclusionIndex());
+        indexedRenderObjects.resize(Max(static_cast<uint32>(indexedRenderObjects.size()), index + 1));
+        DVASSERT(indexedRenderObjects[index] == nullptr,
                  "Static Occlusion merge conflict. Skip this message and invalidate Static Occlusion");
-        indexedRenderObjects[renderObject->GetStaticOcclusionIndex()] = renderObject;
+        indexedRenderObjects[index] = renderObject;
+
+        uint32 wordCount = (static_cast<uint32>(indexedRenderObjects.size()) + 31) / 32;
+        appliedVisibility.resize(wordCount, ~0u);
+        presentObjects.resize(wordCount, 0);
+
+        uint32 mask = 1u << (index & 31);
+        presentObjects[index / 32] |= mask;
+        if (appliedVisibility[index / 32] & mask)
+            renderObject->AddFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
+        else
+            renderObject->RemoveFlag(RenderObject::VISIBLE_STATIC_OCCLUSION);
     }
 }
 
@@ -253,8 +328,10 @@ void StaticOcclusionSystem::RemoveRenderObjectFromOcclusion(RenderObject* render
      */
     if (renderObject->GetStaticOcclusionIndex() != INVALID_STATIC_OCCLUSION_INDEX)
     {
-        DVASSERT(renderObject->GetStaticOcclusionIndex() < indexedRenderObjects.size());
-        indexedRenderObjects[renderObject->GetStaticOcclusionIndex()] = 0;
+        uint32 index = static_cast<uint32>(renderObject->GetStaticOcclusionIndex());
+        DVASSERT(index < indexedRenderObjects.size());
+        indexedRenderObjects[index] = 0;
+        presentObjects[index / 32] &= ~(1u << (index & 31));
     }
 }
 
@@ -292,6 +369,8 @@ void StaticOcclusionSystem::ClearOcclusionObjects()
         }
     }
     indexedRenderObjects.clear();
+    appliedVisibility.clear();
+    presentObjects.clear();
 }
 void StaticOcclusionSystem::CollectOcclusionObjectsRecursively(Entity* entity)
 {
@@ -309,6 +388,8 @@ void StaticOcclusionSystem::InvalidateOcclusion()
 {
     InvalidateOcclusionIndicesRecursively(GetScene());
     indexedRenderObjects.clear();
+    appliedVisibility.clear();
+    presentObjects.clear();
 }
 
 void StaticOcclusionSystem::InvalidateOcclusionIndicesRecursively(Entity* entity)
@@ -4,6 +4,8 @@
 #include <Entity/SceneSystem.h>
 #include <Base/Message.h>
 
+struct StaticOcclusionSystemTest;
+
 namespace DAVA
 {
 class Camera;
@@ -53,10 +55,14 @@ private:
     uint32 activeBlockIndex = 0;
     Vector<StaticOcclusionDataComponent*> staticOcclusionComponents;
     Vector<RenderObject*> indexedRenderObjects;
+    Vector<uint32> appliedVisibility; // bit per indexed object, mirrors VISIBLE_STATIC_OCCLUSION flags set by system
+    Vector<uint32> presentObjects; // bit per non-null entry of indexedRenderObjects
     bool isInPvs = false;
 
     uint32 occludedObjectsCount = 0;
     uint32 visibleObjestsCount = 0;
+
+    friend StaticOcclusionSystemTest;
 };
 
 class StaticOcclusionDebugDrawSystem : public SceneSystem
@@ -49,6 +49,14 @@ RefPtr<UIComponent> UIComponent::SafeCreateByType(const Type* componentType)
     return RefPtr<UIComponent>(CreateByType(componentType));
 }
 
+void UIComponent::SetControlRenderDirty()
+{
+    if (control != nullptr)
+    {
+        control->SetRenderDirty();
+    }
+}
+
 RefPtr<UIComponent> UIComponent::SafeClone() const
 {
     return RefPtr<UIComponent>(Clone());
@@ -34,6 +34,9 @@ public:
 protected:
     virtual ~UIComponent();
 
+    /** Mark owner control render dirty. Should be called by components which affect control drawing. */
+    void SetControlRenderDirty();
+
 private:
     UIControl* control;
 };
@@ -8,10 +8,12 @@
 #include "UI/DataBinding/Private/UIDataBindingDependenciesManager.h"
 #include "UI/DataBinding/Private/UIDataModel.h"
 
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaExpression.h"
 #include "UI/Formula/Private/FormulaParser.h"
 #include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
 
 #include "UI/Styles/UIStyleSheetPropertyDataBase.h"
 
@@ -44,6 +46,7 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
     {
         component->SetDirty(false);
         expression = nullptr;
+        program = nullptr;
         hasToResetError = true;
         expChanged = true;
 
@@ -83,24 +86,29 @@ void UIDataBinding::ProcessReadFromModel(UIDataBindingDependenciesManager* depen
         try
         {
             expression = parser.ParseExpression();
+            program = FormulaCompiler().Compile(expression);
         }
         catch (const FormulaException& error)
         {
             expression = nullptr;
+            program = nullptr;
             hasToResetError = false;
             NotifyError(error.GetFormattedMessage(), component->GetControlFieldName());
         }
     }
 
-    if (expression.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || expChanged || dependenciesManager->IsDirty(dependencyId)))
+    if (program.get() && component->GetUpdateMode() != UIDataBindingComponent::MODE_WRITE && (parent->IsDirty() || expChanged || dependenciesManager->IsDirty(dependencyId)))
     {
         FormulaContext* context = parent->GetFormulaContext().get();
         hasToResetError = true;
         try
         {
-            FormulaExecutor executor(context);
-            Any val = executor.Calculate(expression.get());
-            const Vector<void*>& dependencies = executor.GetDependencies();
+            if (!vm)
+            {
+                vm = std::make_unique<FormulaVirtualMachine>();
+            }
+            Any val = vm->Execute(*program, context);
+            const Vector<void*>& dependencies = vm->GetDependencies();
 
             if (!dependencies.empty())
             {
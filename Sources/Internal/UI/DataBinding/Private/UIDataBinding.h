@@ -7,6 +7,8 @@ namespace DAVA
 {
 class UIDataBindingComponent;
 class FormulaExpression;
+struct FormulaProgram;
+class FormulaVirtualMachine;
 class UIDataBindingIssueDelegate;
 class UIDataBindingDependenciesManager;
 
@@ -24,6 +26,8 @@ public:
 private:
     UIDataBindingComponent* component = nullptr;
     std::shared_ptr<FormulaExpression> expression;
+    std::shared_ptr<FormulaProgram> program;
+    std::unique_ptr<FormulaVirtualMachine> vm;
 
     Reflection controlReflection;
 };
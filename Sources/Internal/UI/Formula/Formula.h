@@ -8,6 +8,8 @@ namespace DAVA
 {
 class FormulaExpression;
 class FormulaContext;
+struct FormulaProgram;
+class FormulaVirtualMachine;
 
 /**
  \ingroup formula
@@ -63,6 +65,8 @@ public:
 
 private:
     std::shared_ptr<FormulaExpression> exp;
+    std::shared_ptr<FormulaProgram> program;
+    std::unique_ptr<FormulaVirtualMachine> vm;
 
     String parsingError;
     String calculationError;
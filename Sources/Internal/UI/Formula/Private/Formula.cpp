@@ -1,8 +1,10 @@
 #include "UI/Formula/Formula.h"
 
+#include "UI/Formula/FormulaContext.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
 #include "UI/Formula/Private/FormulaParser.h"
-#include "UI/Formula/Private/FormulaExecutor.h"
 #include "UI/Formula/Private/FormulaFormatter.h"
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
 
 namespace DAVA
 {
@@ -22,6 +24,7 @@ bool Formula::Parse(const String& str)
     {
         FormulaParser parser(str);
         exp = parser.ParseExpression();
+        program = FormulaCompiler().Compile(exp);
         return true;
     }
     catch (const FormulaException& error)
@@ -34,6 +37,7 @@ bool Formula::Parse(const String& str)
 void Formula::Reset()
 {
     exp.reset();
+    program.reset();
     parsingError = "";
     calculationError = "";
 }
@@ -47,12 +51,15 @@ Any Formula::Calculate(FormulaContext* context)
 {
     calculationError = "";
 
-    if (exp)
+    if (program)
     {
         try
         {
-            FormulaExecutor executor(context);
-            return executor.Calculate(exp.get());
+            if (!vm)
+            {
+                vm = std::make_unique<FormulaVirtualMachine>();
+            }
+            return vm->Execute(*program, context);
         }
         catch (const FormulaException& error)
         {
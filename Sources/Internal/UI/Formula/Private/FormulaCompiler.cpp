@@ -0,0 +1,385 @@
+#include "UI/Formula/Private/FormulaCompiler.h"
+
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+
+namespace DAVA
+{
+FormulaCompiler::FormulaCompiler()
+{
+}
+
+FormulaCompiler::~FormulaCompiler()
+{
+}
+
+std::shared_ptr<FormulaProgram> FormulaCompiler::Compile(const std::shared_ptr<FormulaExpression>& exp)
+{
+    program = std::make_shared<FormulaProgram>();
+    program->expression = exp;
+    nextRegister = 0;
+
+    uint16 resultRegister = AllocRegister();
+    CompileTo(exp.get(), resultRegister);
+    program->resultRegister = resultRegister;
+
+    std::shared_ptr<FormulaProgram> result = program;
+    program.reset();
+    return result;
+}
+
+void FormulaCompiler::Visit(FormulaValueExpression* exp)
+{
+    EmitLoadValue(exp->GetValue(), exp);
+}
+
+void FormulaCompiler::Visit(FormulaNegExpression* exp)
+{
+    Any value;
+    if (TryGetConstant(exp, value))
+    {
+        EmitLoadValue(value, exp);
+        return;
+    }
+
+    uint16 dst = targetRegister;
+    CompileTo(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction instruction;
+    instruction.opCode = FormulaProgram::OP_NEG;
+    instruction.dst = dst;
+    instruction.a = dst;
+    instruction.source = exp;
+    program->code.push_back(instruction);
+}
+
+void FormulaCompiler::Visit(FormulaNotExpression* exp)
+{
+    Any value;
+    if (TryGetConstant(exp, value))
+    {
+        EmitLoadValue(value, exp);
+        return;
+    }
+
+    uint16 dst = targetRegister;
+    CompileTo(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction instruction;
+    instruction.opCode = FormulaProgram::OP_NOT;
+    instruction.dst = dst;
+    instruction.a = dst;
+    instruction.source = exp;
+    program->code.push_back(instruction);
+}
+
+void FormulaCompiler::Visit(FormulaWhenExpression* exp)
+{
+    uint16 dst = targetRegister;
+    Vector<size_t> jumpsToEnd;
+
+    for (const auto& branch : exp->GetBranches())
+    {
+        Any condition;
+        if (TryGetConstant(branch.first.get(), condition) && condition.CanGet<bool>())
+        {
+            if (condition.Get<bool>())
+            {
+                // Branch is always selected, so next branches and else branch are unreachable
+                CompileTo(branch.second.get(), dst);
+                FormulaProgram::Instruction move;
+                move.opCode = FormulaProgram::OP_MOVE;
+                move.dst = dst;
+                move.a = dst;
+                move.source = branch.second.get();
+                program->code.push_back(move);
+
+                for (size_t jump : jumpsToEnd)
+                {
+                    program->code[jump].index = static_cast<int32>(program->code.size());
+                }
+                return;
+            }
+            continue;
+        }
+
+        CompileTo(branch.first.get(), dst);
+        size_t jumpToNext = program->code.size();
+        FormulaProgram::Instruction jumpIfFalse;
+        jumpIfFalse.opCode = FormulaProgram::OP_JUMP_IF_FALSE;
+        jumpIfFalse.a = dst;
+        jumpIfFalse.source = branch.first.get();
+        program->code.push_back(jumpIfFalse);
+
+        CompileTo(branch.second.get(), dst);
+        FormulaProgram::Instruction move;
+        move.opCode = FormulaProgram::OP_MOVE;
+        move.dst = dst;
+        move.a = dst;
+        move.source = branch.second.get();
+        program->code.push_back(move);
+
+        jumpsToEnd.push_back(program->code.size());
+        FormulaProgram::Instruction jump;
+        jump.opCode = FormulaProgram::OP_JUMP;
+        jump.source = exp;
+        program->code.push_back(jump);
+
+        program->code[jumpToNext].index = static_cast<int32>(program->code.size());
+    }
+
+    CompileTo(exp->GetElseBranch(), dst);
+    FormulaProgram::Instruction move;
+    move.opCode = FormulaProgram::OP_MOVE;
+    move.dst = dst;
+    move.a = dst;
+    move.source = exp->GetElseBranch();
+    program->code.push_back(move);
+
+    for (size_t jump : jumpsToEnd)
+    {
+        program->code[jump].index = static_cast<int32>(program->code.size());
+    }
+}
+
+void FormulaCompiler::Visit(FormulaBinaryOperatorExpression* exp)
+{
+    Any value;
+    if (TryGetConstant(exp, value))
+    {
+        EmitLoadValue(value, exp);
+        return;
+    }
+
+    uint16 dst = targetRegister;
+    uint32 savedNextRegister = nextRegister;
+    uint16 rhsRegister = AllocRegister();
+
+    CompileTo(exp->GetLhs(), dst);
+    CompileTo(exp->GetRhs(), rhsRegister);
+
+    FormulaProgram::Instruction instruction;
+    instruction.opCode = FormulaProgram::OP_BINARY;
+    instruction.binaryOperator = exp->GetOperator();
+    instruction.dst = dst;
+    instruction.a = dst;
+    instruction.b = rhsRegister;
+    instruction.source = exp;
+    program->code.push_back(instruction);
+
+    nextRegister = savedNextRegister;
+}
+
+void FormulaCompiler::Visit(FormulaFunctionExpression* exp)
+{
+    uint16 dst = targetRegister;
+    uint32 savedNextRegister = nextRegister;
+
+    const Vector<std::shared_ptr<FormulaExpression>>& params = exp->GetParms();
+    uint16 firstParamRegister = static_cast<uint16>(nextRegister);
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        AllocRegister();
+    }
+
+    for (size_t i = 0; i < params.size(); i++)
+    {
+        CompileTo(params[i].get(), static_cast<uint16>(firstParamRegister + i));
+    }
+
+    FormulaProgram::Instruction instruction;
+    instruction.opCode = FormulaProgram::OP_CALL;
+    instruction.dst = dst;
+    instruction.a = firstParamRegister;
+    instruction.b = static_cast<uint16>(params.size());
+    instruction.index = AddName(exp->GetName());
+    instruction.source = exp;
+    program->code.push_back(instruction);
+
+    nextRegister = savedNextRegister;
+}
+
+void FormulaCompiler::Visit(FormulaFieldAccessExpression* exp)
+{
+    uint16 dst = targetRegister;
+
+    FormulaProgram::Instruction instruction;
+    instruction.dst = dst;
+    instruction.index = AddName(exp->GetFieldName());
+    instruction.source = exp;
+
+    if (exp->GetExp())
+    {
+        CompileTo(exp->GetExp(), dst);
+        instruction.opCode = FormulaProgram::OP_GET_FIELD;
+        instruction.a = dst;
+        instruction.operandSource = exp->GetExp();
+    }
+    else
+    {
+        instruction.opCode = FormulaProgram::OP_LOAD_FIELD;
+    }
+
+    program->code.push_back(instruction);
+}
+
+void FormulaCompiler::Visit(FormulaIndexExpression* exp)
+{
+    uint16 dst = targetRegister;
+    uint32 savedNextRegister = nextRegister;
+    uint16 indexRegister = AllocRegister();
+
+    // Index is calculated before data access like in FormulaExecutor to keep order of dependencies
+    CompileTo(exp->GetIndexExp(), indexRegister);
+    CompileTo(exp->GetExp(), dst);
+
+    FormulaProgram::Instruction instruction;
+    instruction.opCode = FormulaProgram::OP_GET_INDEX;
+    instruction.dst = dst;
+    instruction.a = dst;
+    instruction.b = indexRegister;
+    instruction.source = exp;
+    instruction.operandSource = exp->GetExp();
+    program->code.push_back(instruction);
+
+    nextRegister = savedNextRegister;
+}
+
+void FormulaCompiler::CompileTo(FormulaExpression* exp, uint16 dst)
+{
+    uint16 savedTargetRegister = targetRegister;
+    targetRegister = dst;
+    exp->Accept(this);
+    targetRegister = savedTargetRegister;
+}
+
+void FormulaCompiler::EmitLoadValue(const Any& value, FormulaExpression* source)
+{
+    FormulaProgram::Instruction instruction;
+    instruction.dst = targetRegister;
+    instruction.source = source;
+
+    if (value.CanGet<int32>())
+    {
+        instruction.opCode = FormulaProgram::OP_LOAD_INT;
+        instruction.intValue = value.Get<int32>();
+    }
+    else if (value.CanGet<float32>())
+    {
+        instruction.opCode = FormulaProgram::OP_LOAD_FLOAT;
+        instruction.floatValue = value.Get<float32>();
+    }
+    else if (value.CanGet<bool>())
+    {
+        instruction.opCode = FormulaProgram::OP_LOAD_BOOL;
+        instruction.intValue = value.Get<bool>() ? 1 : 0;
+    }
+    else
+    {
+        instruction.opCode = FormulaProgram::OP_LOAD_CONST;
+        instruction.index = static_cast<int32>(program->constants.size());
+        program->constants.push_back(value);
+    }
+
+    program->code.push_back(instruction);
+}
+
+uint16 FormulaCompiler::AllocRegister()
+{
+    DVASSERT(nextRegister < std::numeric_limits<uint16>::max());
+    uint16 result = static_cast<uint16>(nextRegister);
+    nextRegister++;
+    program->registersCount = std::max(program->registersCount, nextRegister);
+    return result;
+}
+
+int32 FormulaCompiler::AddName(const String& name)
+{
+    auto it = std::find(program->names.begin(), program->names.end(), name);
+    if (it != program->names.end())
+    {
+        return static_cast<int32>(std::distance(program->names.begin(), it));
+    }
+
+    program->names.push_back(name);
+    return static_cast<int32>(program->names.size() - 1);
+}
+
+bool FormulaCompiler::TryGetConstant(FormulaExpression* exp, Any& value) const
+{
+    // Expressions which fail on calculation are not folded to report errors in runtime
+    try
+    {
+        if (exp->IsValue())
+        {
+            value = static_cast<FormulaValueExpression*>(exp)->GetValue();
+            return IsFoldableValue(value);
+        }
+
+        FormulaNegExpression* negExp = dynamic_cast<FormulaNegExpression*>(exp);
+        if (negExp != nullptr)
+        {
+            Any arg;
+            if (TryGetConstant(negExp->GetExp(), arg))
+            {
+                value = FormulaExecutor::CalculateNeg(arg, exp);
+                return IsFoldableValue(value);
+            }
+            return false;
+        }
+
+        FormulaNotExpression* notExp = dynamic_cast<FormulaNotExpression*>(exp);
+        if (notExp != nullptr)
+        {
+            Any arg;
+            if (TryGetConstant(notExp->GetExp(), arg))
+            {
+                value = FormulaExecutor::CalculateNot(arg, exp);
+                return IsFoldableValue(value);
+            }
+            return false;
+        }
+
+        FormulaBinaryOperatorExpression* binaryExp = dynamic_cast<FormulaBinaryOperatorExpression*>(exp);
+        if (binaryExp != nullptr)
+        {
+            Any lhs;
+            Any rhs;
+            if (TryGetConstant(binaryExp->GetLhs(), lhs) && TryGetConstant(binaryExp->GetRhs(), rhs))
+            {
+                FormulaBinaryOperatorExpression::Operator op = binaryExp->GetOperator();
+                if ((op == FormulaBinaryOperatorExpression::OP_DIV || op == FormulaBinaryOperatorExpression::OP_MOD) && IsIntegerZero(rhs))
+                {
+                    return false;
+                }
+
+                value = FormulaExecutor::CalculateBinaryOperator(op, lhs, rhs, exp);
+                return IsFoldableValue(value);
+            }
+            return false;
+        }
+    }
+    catch (const FormulaException&)
+    {
+        return false;
+    }
+
+    return false;
+}
+
+bool FormulaCompiler::IsIntegerZero(const Any& value) const
+{
+    int32 intVal = 0;
+    return (FormulaExecutor::CastToInt32(value, &intVal) && intVal == 0) ||
+    (value.CanGet<uint32>() && value.Get<uint32>() == 0) ||
+    (value.CanGet<int64>() && value.Get<int64>() == 0) ||
+    (value.CanGet<uint64>() && value.Get<uint64>() == 0);
+}
+
+bool FormulaCompiler::IsFoldableValue(const Any& value) const
+{
+    return !value.IsEmpty() &&
+    (value.CanGet<int32>() || value.CanGet<uint32>() || value.CanGet<int64>() || value.CanGet<uint64>() ||
+     value.CanGet<float32>() || value.CanGet<float64>() || value.CanGet<bool>() || value.CanGet<String>());
+}
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/Any.h"
+#include "UI/Formula/Private/FormulaExpression.h"
+
+namespace DAVA
+{
+/**
+ \ingroup formula
+
+ Compiled form of formula expression. Instructions work with registers,
+ numeric and boolean constants are stored directly in instructions.
+ Program holds the source expression to report errors with its location.
+ */
+struct FormulaProgram
+{
+    enum OpCode : uint8
+    {
+        OP_LOAD_INT, // dst = intValue
+        OP_LOAD_FLOAT, // dst = floatValue
+        OP_LOAD_BOOL, // dst = intValue != 0
+        OP_LOAD_CONST, // dst = constants[index]
+        OP_LOAD_FIELD, // dst = context->FindReflection(names[index])
+        OP_GET_FIELD, // dst = a.names[index]
+        OP_GET_INDEX, // dst = a[b]
+        OP_NEG, // dst = -a
+        OP_NOT, // dst = not a
+        OP_BINARY, // dst = a binaryOperator b
+        OP_CALL, // dst = names[index](a, ..., a + b - 1)
+        OP_MOVE, // dst = value of a
+        OP_JUMP, // goto index
+        OP_JUMP_IF_FALSE // if (!a) goto index
+    };
+
+    struct Instruction
+    {
+        OpCode opCode = OP_MOVE;
+        FormulaBinaryOperatorExpression::Operator binaryOperator = FormulaBinaryOperatorExpression::OP_PLUS;
+        uint16 dst = 0;
+        uint16 a = 0;
+        uint16 b = 0;
+        int32 intValue = 0;
+        float32 floatValue = 0.0f;
+        int32 index = 0;
+        FormulaExpression* source = nullptr; //!< expression for error reporting
+        FormulaExpression* operandSource = nullptr; //!< expression of operand `a` for reference errors
+    };
+
+    Vector<Instruction> code;
+    Vector<Any> constants;
+    Vector<String> names;
+    uint32 registersCount = 0;
+    uint16 resultRegister = 0;
+    std::shared_ptr<FormulaExpression> expression;
+};
+
+/**
+ \ingroup formula
+
+ Compiler translates expression tree to FormulaProgram. Operations on constants
+ are folded on compilation step.
+ */
+class FormulaCompiler : private FormulaExpressionVisitor
+{
+public:
+    FormulaCompiler();
+    ~FormulaCompiler() override;
+
+    std::shared_ptr<FormulaProgram> Compile(const std::shared_ptr<FormulaExpression>& exp);
+
+private:
+    void Visit(FormulaValueExpression* exp) override;
+    void Visit(FormulaNegExpression* exp) override;
+    void Visit(FormulaNotExpression* exp) override;
+    void Visit(FormulaWhenExpression* exp) override;
+    void Visit(FormulaBinaryOperatorExpression* exp) override;
+    void Visit(FormulaFunctionExpression* exp) override;
+    void Visit(FormulaFieldAccessExpression* exp) override;
+    void Visit(FormulaIndexExpression* exp) override;
+
+    void CompileTo(FormulaExpression* exp, uint16 dst);
+    void EmitLoadValue(const Any& value, FormulaExpression* source);
+    uint16 AllocRegister();
+    int32 AddName(const String& name);
+
+    bool TryGetConstant(FormulaExpression* exp, Any& value) const;
+    bool IsFoldableValue(const Any& value) const;
+    bool IsIntegerZero(const Any& value) const;
+
+    std::shared_ptr<FormulaProgram> program;
+    uint16 targetRegister = 0;
+    uint32 nextRegister = 0;
+};
+}
@@ -55,110 +55,244 @@ void FormulaExecutor::Visit(FormulaValueExpression* exp)
 
 void FormulaExecutor::Visit(FormulaNegExpression* exp)
 {
-    const Any& val = CalculateImpl(exp->GetExp());
+    calculationResult = CalculateNeg(CalculateImpl(exp->GetExp()), exp);
+}
 
-    if (val.CanGet<float32>())
+void FormulaExecutor::Visit(FormulaNotExpression* exp)
+{
+    calculationResult = CalculateNot(CalculateImpl(exp->GetExp()), exp);
+}
+
+void FormulaExecutor::Visit(FormulaWhenExpression* exp)
+{
+    for (const auto& branch : exp->GetBranches())
     {
-        calculationResult = Any(-val.Get<float32>());
+        Any val = CalculateImpl(branch.first.get());
+        if (val.CanGet<bool>())
+        {
+            if (val.Get<bool>())
+            {
+                calculationResult = CalculateImpl(branch.second.get());
+                return;
+            }
+        }
+        else
+        {
+            DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to when selector expression", FormulaFormatter::AnyTypeToString(val).c_str()), branch.first.get());
+        }
     }
-    else if (val.CanGet<float64>())
+    calculationResult = CalculateImpl(exp->GetElseBranch());
+}
+
+void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
+{
+    Any l = CalculateImpl(exp->GetLhs());
+    Any r = CalculateImpl(exp->GetRhs());
+    calculationResult = CalculateBinaryOperator(exp->GetOperator(), l, r, exp);
+}
+
+void FormulaExecutor::Visit(FormulaFunctionExpression* exp)
+{
+    const Vector<std::shared_ptr<FormulaExpression>>& params = exp->GetParms();
+
+    Vector<Any> values;
+    values.reserve(params.size());
+
+    for (const std::shared_ptr<FormulaExpression>& paramExp : params)
     {
-        calculationResult = Any(-val.Get<float64>());
+        values.push_back(CalculateImpl(paramExp.get()));
     }
-    else if (val.CanGet<int64>())
+
+    calculationResult = InvokeFunction(context, exp, values);
+}
+
+void FormulaExecutor::Visit(FormulaFieldAccessExpression* exp)
+{
+    Reflection res;
+    if (exp->GetExp())
     {
-        calculationResult = Any(-val.Get<int64>());
+        Reflection data = GetDataReference(exp->GetExp());
+        if (data.IsValid())
+        {
+            dataReference = data.GetField(exp->GetFieldName());
+        }
+        else
+        {
+            dataReference = Reflection();
+        }
     }
     else
     {
-        int32 res = 0;
-        if (CastToInt32(val, &res))
+        dataReference = context->FindReflection(exp->GetFieldName());
+    }
+
+    if (dataReference.IsValid())
+    {
+        dependencies.push_back(dataReference.GetValueObject().GetVoidPtr());
+    }
+    else
+    {
+        DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", exp->GetFieldName().c_str()), exp);
+    }
+}
+
+void FormulaExecutor::Visit(FormulaIndexExpression* exp)
+{
+    Any indexVal = Calculate(exp->GetIndexExp());
+    Reflection data = GetDataReference(exp->GetExp());
+    if (data.IsValid())
+    {
+        dataReference = data.GetField(indexVal);
+
+        if (dataReference.IsValid())
         {
-            calculationResult = Any(-res);
+            dependencies.push_back(dataReference.GetValueObject().GetVoidPtr());
         }
         else
         {
-            DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to unary '-' expression", FormulaFormatter::AnyTypeToString(val).c_str()), exp);
+            DAVA_THROW(FormulaException, Format("Can't get data '%s' by index '%s' with type '%s'",
+                                                FormulaFormatter().Format(exp).c_str(),
+                                                FormulaFormatter::AnyToString(indexVal).c_str(),
+                                                FormulaFormatter::AnyTypeToString(indexVal).c_str()),
+                       exp);
         }
     }
+    else
+    {
+        DAVA_THROW(FormulaException, Format("It's not data access expression '%s'", FormulaFormatter().Format(exp).c_str()), exp);
+    }
 }
 
-void FormulaExecutor::Visit(FormulaNotExpression* exp)
+const Any& FormulaExecutor::CalculateImpl(FormulaExpression* exp)
 {
-    Any val = CalculateImpl(exp->GetExp());
-    if (val.CanGet<bool>())
+    dataReference = Reflection();
+    calculationResult.Clear();
+
+    exp->Accept(this);
+
+    if (calculationResult.IsEmpty())
+    {
+        if (dataReference.IsValid())
+        {
+            calculationResult = dataReference.GetValue();
+        }
+        else
+        {
+            DAVA_THROW(FormulaException,
+                       Format("Can't calculate expression '%s'",
+                              FormulaFormatter().Format(exp).c_str()),
+                       exp);
+        }
+    }
+
+    if (calculationResult.CanCast<std::shared_ptr<FormulaExpression>>())
     {
-        calculationResult = Any(!val.Get<bool>());
+        std::shared_ptr<FormulaExpression> internalExpr = calculationResult.Cast<std::shared_ptr<FormulaExpression>>();
+        FormulaExecutor executor(context->GetParent() ? context->GetParent() : context);
+        calculationResult = executor.Calculate(internalExpr.get());
+    }
+
+    dataReference = Reflection();
+
+    return calculationResult;
+}
+
+const Reflection& FormulaExecutor::GetDataReferenceImpl(FormulaExpression* exp)
+{
+    dataReference = Reflection();
+    calculationResult.Clear();
+
+    exp->Accept(this);
+
+    if (dataReference.IsValid())
+    {
+        calculationResult.Clear();
+        return dataReference;
     }
     else
     {
-        DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to unary 'not' expression", FormulaFormatter::AnyTypeToString(val).c_str()), exp);
+        DAVA_THROW(FormulaException,
+                   Format("Can't get data reference '%s'",
+                          FormulaFormatter().Format(exp).c_str()),
+                   exp);
     }
 }
 
-void FormulaExecutor::Visit(FormulaWhenExpression* exp)
+Any FormulaExecutor::CalculateNeg(const Any& val, FormulaExpression* exp)
 {
-    for (const auto& branch : exp->GetBranches())
+    if (val.CanGet<float32>())
     {
-        Any val = CalculateImpl(branch.first.get());
-        if (val.CanGet<bool>())
+        return Any(-val.Get<float32>());
+    }
+    else if (val.CanGet<float64>())
+    {
+        return Any(-val.Get<float64>());
+    }
+    else if (val.CanGet<int64>())
+    {
+        return Any(-val.Get<int64>());
+    }
+    else
+    {
+        int32 res = 0;
+        if (CastToInt32(val, &res))
         {
-            if (val.Get<bool>())
-            {
-                calculationResult = CalculateImpl(branch.second.get());
-                return;
-            }
+            return Any(-res);
         }
         else
         {
-            DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to when selector expression", FormulaFormatter::AnyTypeToString(val).c_str()), branch.first.get());
+            DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to unary '-' expression", FormulaFormatter::AnyTypeToString(val).c_str()), exp);
         }
     }
-    calculationResult = CalculateImpl(exp->GetElseBranch());
 }
 
-void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
+Any FormulaExecutor::CalculateNot(const Any& val, FormulaExpression* exp)
 {
-    Any l = CalculateImpl(exp->GetLhs());
-    Any r = CalculateImpl(exp->GetRhs());
+    if (val.CanGet<bool>())
+    {
+        return Any(!val.Get<bool>());
+    }
+    else
+    {
+        DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to unary 'not' expression", FormulaFormatter::AnyTypeToString(val).c_str()), exp);
+    }
+}
 
+Any FormulaExecutor::CalculateBinaryOperator(FormulaBinaryOperatorExpression::Operator op, const Any& l, const Any& r, FormulaExpression* exp)
+{
     if (l.CanGet<uint64>() && r.CanGet<uint64>())
     {
-        calculationResult = CalculateIntAnyValues<uint64>(exp->GetOperator(), l, r);
+        return CalculateIntAnyValues<uint64>(op, l, r);
     }
     else if (l.CanGet<int64>() && r.CanGet<int64>())
     {
-        calculationResult = CalculateIntAnyValues<int64>(exp->GetOperator(), l, r);
+        return CalculateIntAnyValues<int64>(op, l, r);
     }
     else if (l.CanGet<uint32>() && r.CanGet<uint32>())
     {
-        calculationResult = CalculateIntAnyValues<uint32>(exp->GetOperator(), l, r);
+        return CalculateIntAnyValues<uint32>(op, l, r);
     }
     else if (l.CanGet<bool>() && r.CanGet<bool>())
     {
         bool lVal = l.Get<bool>();
         bool rVal = r.Get<bool>();
-        switch (exp->GetOperator())
+        switch (op)
         {
         case FormulaBinaryOperatorExpression::OP_AND:
-            calculationResult = Any(lVal && rVal);
-            break;
+            return Any(lVal && rVal);
 
         case FormulaBinaryOperatorExpression::OP_OR:
-            calculationResult = Any(lVal || rVal);
-            break;
+            return Any(lVal || rVal);
 
         case FormulaBinaryOperatorExpression::OP_EQ:
-            calculationResult = Any(lVal == rVal);
-            break;
+            return Any(lVal == rVal);
 
         case FormulaBinaryOperatorExpression::OP_NOT_EQ:
-            calculationResult = Any(lVal != rVal);
-            break;
+            return Any(lVal != rVal);
 
         default:
             DAVA_THROW(FormulaException, Format("Operator '%s' cannot be applied to '%s', '%s'",
-                                                FormulaFormatter::BinaryOpToString(exp->GetOperator()).c_str(),
+                                                FormulaFormatter::BinaryOpToString(op).c_str(),
                                                 FormulaFormatter::AnyTypeToString(l).c_str(),
                                                 FormulaFormatter::AnyTypeToString(r).c_str()),
                        exp);
@@ -168,23 +302,20 @@ void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
     {
         String lVal = l.Get<String>();
         String rVal = r.Get<String>();
-        switch (exp->GetOperator())
+        switch (op)
         {
         case FormulaBinaryOperatorExpression::OP_PLUS:
-            calculationResult = Any(lVal + rVal);
-            break;
+            return Any(lVal + rVal);
 
         case FormulaBinaryOperatorExpression::OP_EQ:
-            calculationResult = Any(lVal == rVal);
-            break;
+            return Any(lVal == rVal);
 
         case FormulaBinaryOperatorExpression::OP_NOT_EQ:
-            calculationResult = Any(lVal != rVal);
-            break;
+            return Any(lVal != rVal);
 
         default:
             DAVA_THROW(FormulaException, Format("Operator '%s' cannot be applied to '%s', '%s'",
-                                                FormulaFormatter::BinaryOpToString(exp->GetOperator()).c_str(),
+                                                FormulaFormatter::BinaryOpToString(op).c_str(),
                                                 FormulaFormatter::AnyTypeToString(l).c_str(),
                                                 FormulaFormatter::AnyTypeToString(r).c_str()),
                        exp);
@@ -200,24 +331,24 @@ void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
 
         if (isLeftInt && isRightInt)
         {
-            calculationResult = CalculateIntValues<int32>(exp->GetOperator(), leftIntVal, rightIntVal);
+            return CalculateIntValues<int32>(op, leftIntVal, rightIntVal);
         }
         else if ((l.CanGet<float32>() || isLeftInt) && (r.CanGet<float32>() || isRightInt))
         {
             float32 lVal = l.CanGet<float32>() ? l.Get<float32>() : static_cast<float32>(leftIntVal);
             float32 rVal = r.CanGet<float32>() ? r.Get<float32>() : static_cast<float32>(rightIntVal);
-            calculationResult = CalculateNumberValues<float32>(exp->GetOperator(), lVal, rVal);
+            return CalculateNumberValues<float32>(op, lVal, rVal);
         }
         else if ((l.CanGet<float64>() && r.CanCast<float64>()) || (l.CanCast<float64>() && r.CanGet<float64>()))
         {
             float64 lVal = l.Cast<float64>();
             float64 rVal = r.Cast<float64>();
-            calculationResult = CalculateNumberValues<float64>(exp->GetOperator(), lVal, rVal);
+            return CalculateNumberValues<float64>(op, lVal, rVal);
         }
         else
         {
             DAVA_THROW(FormulaException, Format("Operator '%s' cannot be applied to '%s', '%s'",
-                                                FormulaFormatter::BinaryOpToString(exp->GetOperator()).c_str(),
+                                                FormulaFormatter::BinaryOpToString(op).c_str(),
                                                 FormulaFormatter::AnyTypeToString(l).c_str(),
                                                 FormulaFormatter::AnyTypeToString(r).c_str()),
                        exp);
@@ -225,20 +356,13 @@ void FormulaExecutor::Visit(FormulaBinaryOperatorExpression* exp)
     }
 }
 
-void FormulaExecutor::Visit(FormulaFunctionExpression* exp)
+Any FormulaExecutor::InvokeFunction(FormulaContext* context, FormulaFunctionExpression* exp, Vector<Any>& values)
 {
-    const Vector<std::shared_ptr<FormulaExpression>>& params = exp->GetParms();
     Vector<const Type*> types;
-    types.reserve(params.size());
-
-    Vector<Any> values;
-    values.reserve(params.size());
-
-    for (const std::shared_ptr<FormulaExpression>& paramExp : params)
+    types.reserve(values.size());
+    for (const Any& v : values)
     {
-        Any res = CalculateImpl(paramExp.get());
-        types.push_back(res.GetType());
-        values.push_back(res);
+        types.push_back(v.GetType());
     }
 
     AnyFn fn = context->FindFunction(exp->GetName(), types);
@@ -260,7 +384,7 @@ void FormulaExecutor::Visit(FormulaFunctionExpression* exp)
     for (Any& v : values)
     {
         int32 intVal = 0;
-        if (fn.GetInvokeParams().argsType[index] == Type::Instance<float32>() && FormulaExecutor::CastToInt32(v, &intVal))
+        if (fn.GetInvokeParams().argsType[index] == Type::Instance<float32>() && CastToInt32(v, &intVal))
         {
             v = Any(static_cast<float32>(intVal));
         }
@@ -268,35 +392,28 @@ void FormulaExecutor::Visit(FormulaFunctionExpression* exp)
         index++;
     }
 
-    switch (params.size())
+    switch (values.size())
     {
     case 0:
-        calculationResult = fn.Invoke();
-        break;
+        return fn.Invoke();
 
     case 1:
-        calculationResult = fn.Invoke(values[0]);
-        break;
+        return fn.Invoke(values[0]);
 
     case 2:
-        calculationResult = fn.Invoke(values[0], values[1]);
-        break;
+        return fn.Invoke(values[0], values[1]);
 
     case 3:
-        calculationResult = fn.Invoke(values[0], values[1], values[2]);
-        break;
+        return fn.Invoke(values[0], values[1], values[2]);
 
     case 4:
-        calculationResult = fn.Invoke(values[0], values[1], values[2], values[3]);
-        break;
+        return fn.Invoke(values[0], values[1], values[2], values[3]);
 
     case 5:
-        calculationResult = fn.Invoke(values[0], values[1], values[2], values[3], values[4]);
-        break;
+        return fn.Invoke(values[0], values[1], values[2], values[3], values[4]);
 
     case 6:
-        calculationResult = fn.Invoke(values[0], values[1], values[2], values[3], values[4], values[5]);
-        break;
+        return fn.Invoke(values[0], values[1], values[2], values[3], values[4], values[5]);
 
     default:
     {
@@ -318,120 +435,8 @@ void FormulaExecutor::Visit(FormulaFunctionExpression* exp)
     }
 }
 
-void FormulaExecutor::Visit(FormulaFieldAccessExpression* exp)
-{
-    Reflection res;
-    if (exp->GetExp())
-    {
-        Reflection data = GetDataReference(exp->GetExp());
-        if (data.IsValid())
-        {
-            dataReference = data.GetField(exp->GetFieldName());
-        }
-        else
-        {
-            dataReference = Reflection();
-        }
-    }
-    else
-    {
-        dataReference = context->FindReflection(exp->GetFieldName());
-    }
-
-    if (dataReference.IsValid())
-    {
-        dependencies.push_back(dataReference.GetValueObject().GetVoidPtr());
-    }
-    else
-    {
-        DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", exp->GetFieldName().c_str()), exp);
-    }
-}
-
-void FormulaExecutor::Visit(FormulaIndexExpression* exp)
-{
-    Any indexVal = Calculate(exp->GetIndexExp());
-    Reflection data = GetDataReference(exp->GetExp());
-    if (data.IsValid())
-    {
-        dataReference = data.GetField(indexVal);
-
-        if (dataReference.IsValid())
-        {
-            dependencies.push_back(dataReference.GetValueObject().GetVoidPtr());
-        }
-        else
-        {
-            DAVA_THROW(FormulaException, Format("Can't get data '%s' by index '%s' with type '%s'",
-                                                FormulaFormatter().Format(exp).c_str(),
-                                                FormulaFormatter::AnyToString(indexVal).c_str(),
-                                                FormulaFormatter::AnyTypeToString(indexVal).c_str()),
-                       exp);
-        }
-    }
-    else
-    {
-        DAVA_THROW(FormulaException, Format("It's not data access expression '%s'", FormulaFormatter().Format(exp).c_str()), exp);
-    }
-}
-
-const Any& FormulaExecutor::CalculateImpl(FormulaExpression* exp)
-{
-    dataReference = Reflection();
-    calculationResult.Clear();
-
-    exp->Accept(this);
-
-    if (calculationResult.IsEmpty())
-    {
-        if (dataReference.IsValid())
-        {
-            calculationResult = dataReference.GetValue();
-        }
-        else
-        {
-            DAVA_THROW(FormulaException,
-                       Format("Can't calculate expression '%s'",
-                              FormulaFormatter().Format(exp).c_str()),
-                       exp);
-        }
-    }
-
-    if (calculationResult.CanCast<std::shared_ptr<FormulaExpression>>())
-    {
-        std::shared_ptr<FormulaExpression> internalExpr = calculationResult.Cast<std::shared_ptr<FormulaExpression>>();
-        FormulaExecutor executor(context->GetParent() ? context->GetParent() : context);
-        calculationResult = executor.Calculate(internalExpr.get());
-    }
-
-    dataReference = Reflection();
-
-    return calculationResult;
-}
-
-const Reflection& FormulaExecutor::GetDataReferenceImpl(FormulaExpression* exp)
-{
-    dataReference = Reflection();
-    calculationResult.Clear();
-
-    exp->Accept(this);
-
-    if (dataReference.IsValid())
-    {
-        calculationResult.Clear();
-        return dataReference;
-    }
-    else
-    {
-        DAVA_THROW(FormulaException,
-                   Format("Can't get data reference '%s'",
-                          FormulaFormatter().Format(exp).c_str()),
-                   exp);
-    }
-}
-
 template <typename T>
-Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any anyLVal, Any anyRVal) const
+Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& anyLVal, const Any& anyRVal)
 {
     T lVal = anyLVal.Cast<T>();
     T rVal = anyRVal.Cast<T>();
@@ -439,7 +444,7 @@ Any FormulaExecutor::CalculateNumberAnyValues(FormulaBinaryOperatorExpression::O
 }
 
 template <typename T>
-Any FormulaExecutor::CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any anyLVal, Any anyRVal) const
+Any FormulaExecutor::CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& anyLVal, const Any& anyRVal)
 {
     T lVal = anyLVal.Cast<T>();
     T rVal = anyRVal.Cast<T>();
@@ -447,7 +452,7 @@ Any FormulaExecutor::CalculateIntAnyValues(FormulaBinaryOperatorExpression::Oper
 }
 
 template <typename T>
-Any FormulaExecutor::CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const
+Any FormulaExecutor::CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal)
 {
     if (op == FormulaBinaryOperatorExpression::OP_MOD)
     {
@@ -460,7 +465,7 @@ Any FormulaExecutor::CalculateIntValues(FormulaBinaryOperatorExpression::Operato
 }
 
 template <typename T>
-Any FormulaExecutor::CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const
+Any FormulaExecutor::CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal)
 {
     switch (op)
     {
@@ -491,7 +496,7 @@ Any FormulaExecutor::CalculateNumberValues(FormulaBinaryOperatorExpression::Oper
     }
 }
 
-bool FormulaExecutor::CastToInt32(const Any& val, int32* res) const
+bool FormulaExecutor::CastToInt32(const Any& val, int32* res)
 {
     if (val.CanGet<int32>())
     {
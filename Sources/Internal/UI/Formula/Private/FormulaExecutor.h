@@ -45,6 +45,18 @@ public:
      */
     const Vector<void*>& GetDependencies() const;
 
+    /**
+     \ingroup formula
+
+     Operations on calculated values. They are shared with FormulaVirtualMachine
+     to keep conversion rules and error messages identical. `exp` is used for error reporting.
+     */
+    static Any CalculateNeg(const Any& val, FormulaExpression* exp);
+    static Any CalculateNot(const Any& val, FormulaExpression* exp);
+    static Any CalculateBinaryOperator(FormulaBinaryOperatorExpression::Operator op, const Any& l, const Any& r, FormulaExpression* exp);
+    static Any InvokeFunction(FormulaContext* context, FormulaFunctionExpression* exp, Vector<Any>& values);
+    static bool CastToInt32(const Any& val, int32* res);
+
 private:
     void Visit(FormulaValueExpression* exp) override;
     void Visit(FormulaNegExpression* exp) override;
@@ -59,18 +71,16 @@ private:
     const Reflection& GetDataReferenceImpl(FormulaExpression* exp);
 
     template <typename T>
-    Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    static Any CalculateNumberAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal);
 
     template <typename T>
-    Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, Any lVal, Any rVal) const;
+    static Any CalculateIntAnyValues(FormulaBinaryOperatorExpression::Operator op, const Any& lVal, const Any& rVal);
 
     template <typename T>
-    Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const;
+    static Any CalculateIntValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal);
 
     template <typename T>
-    Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal) const;
-
-    bool CastToInt32(const Any& val, int32* res) const;
+    static Any CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal);
 
     FormulaContext* context = nullptr;
     Any calculationResult;
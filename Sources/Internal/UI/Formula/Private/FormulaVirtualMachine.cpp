@@ -0,0 +1,462 @@
+#include "UI/Formula/Private/FormulaVirtualMachine.h"
+
+#include "UI/Formula/FormulaContext.h"
+#include "UI/Formula/Private/FormulaData.h"
+#include "UI/Formula/Private/FormulaException.h"
+#include "UI/Formula/Private/FormulaExecutor.h"
+#include "UI/Formula/Private/FormulaFormatter.h"
+#include "Utils/StringFormat.h"
+
+namespace DAVA
+{
+FormulaVirtualMachine::FormulaVirtualMachine()
+{
+}
+
+FormulaVirtualMachine::~FormulaVirtualMachine()
+{
+}
+
+Any FormulaVirtualMachine::Execute(const FormulaProgram& program, FormulaContext* context_)
+{
+    // Previous execution could be interrupted by exception and leave registers filled
+    ReleaseRegisters();
+    context = context_;
+    dependencies.clear();
+
+    if (registers.size() < program.registersCount)
+    {
+        registers.resize(program.registersCount);
+    }
+
+    const int32 codeSize = static_cast<int32>(program.code.size());
+    int32 pc = 0;
+    while (pc < codeSize)
+    {
+        const FormulaProgram::Instruction& instruction = program.code[pc];
+        pc++;
+
+        switch (instruction.opCode)
+        {
+        case FormulaProgram::OP_LOAD_INT:
+            SetValue(registers[instruction.dst], instruction.intValue);
+            break;
+
+        case FormulaProgram::OP_LOAD_FLOAT:
+            SetValue(registers[instruction.dst], instruction.floatValue);
+            break;
+
+        case FormulaProgram::OP_LOAD_BOOL:
+            SetValue(registers[instruction.dst], instruction.intValue != 0);
+            break;
+
+        case FormulaProgram::OP_LOAD_CONST:
+        {
+            Register& dst = registers[instruction.dst];
+            const Any& value = program.constants[instruction.index];
+            if (value.CanGet<std::shared_ptr<FormulaDataMap>>())
+            {
+                dst.kind = Register::KIND_REFERENCE;
+                dst.anyValue = value;
+                dst.reference = Reflection::Create(ReflectedObject(value.Get<std::shared_ptr<FormulaDataMap>>().get()));
+            }
+            else if (value.CanGet<std::shared_ptr<FormulaDataVector>>())
+            {
+                dst.kind = Register::KIND_REFERENCE;
+                dst.anyValue = value;
+                dst.reference = Reflection::Create(ReflectedObject(value.Get<std::shared_ptr<FormulaDataVector>>().get()));
+            }
+            else
+            {
+                SetAny(dst, Any(value));
+            }
+            break;
+        }
+
+        case FormulaProgram::OP_LOAD_FIELD:
+        {
+            const String& name = program.names[instruction.index];
+            Reflection ref = context->FindReflection(name);
+            if (!ref.IsValid())
+            {
+                DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", name.c_str()), instruction.source);
+            }
+            SetReference(registers[instruction.dst], ref);
+            break;
+        }
+
+        case FormulaProgram::OP_GET_FIELD:
+            ExecuteGetField(program, instruction);
+            break;
+
+        case FormulaProgram::OP_GET_INDEX:
+            ExecuteGetIndex(instruction);
+            break;
+
+        case FormulaProgram::OP_NEG:
+            ExecuteNeg(instruction);
+            break;
+
+        case FormulaProgram::OP_NOT:
+            ExecuteNot(instruction);
+            break;
+
+        case FormulaProgram::OP_BINARY:
+            ExecuteBinary(instruction);
+            break;
+
+        case FormulaProgram::OP_CALL:
+            ExecuteCall(instruction);
+            break;
+
+        case FormulaProgram::OP_MOVE:
+        {
+            Register& src = registers[instruction.a];
+            Resolve(src, instruction.source);
+            if (instruction.dst != instruction.a)
+            {
+                registers[instruction.dst] = src;
+            }
+            break;
+        }
+
+        case FormulaProgram::OP_JUMP:
+            pc = instruction.index;
+            break;
+
+        case FormulaProgram::OP_JUMP_IF_FALSE:
+        {
+            Register& condition = registers[instruction.a];
+            Resolve(condition, instruction.source);
+            if (condition.kind != Register::KIND_BOOL)
+            {
+                DAVA_THROW(FormulaException, Format("Invalid argument type '%s' to when selector expression", FormulaFormatter::AnyTypeToString(ToAny(condition, instruction.source)).c_str()), instruction.source);
+            }
+            if (!condition.boolValue)
+            {
+                pc = instruction.index;
+            }
+            break;
+        }
+
+        default:
+            DVASSERT(false, "Unknown formula instruction");
+            break;
+        }
+    }
+
+    Any result = ToAny(registers[program.resultRegister], program.expression.get());
+    ReleaseRegisters();
+    return result;
+}
+
+void FormulaVirtualMachine::ReleaseRegisters()
+{
+    // Registers shouldn't keep data of context alive between executions
+    for (Register& reg : registers)
+    {
+        if (reg.kind == Register::KIND_ANY || reg.kind == Register::KIND_REFERENCE)
+        {
+            reg.anyValue.Clear();
+            reg.reference = Reflection();
+        }
+        reg.kind = Register::KIND_EMPTY;
+    }
+    callArguments.clear();
+    context = nullptr;
+}
+
+const Vector<void*>& FormulaVirtualMachine::GetDependencies() const
+{
+    return dependencies;
+}
+
+void FormulaVirtualMachine::SetValue(Register& reg, int32 value)
+{
+    reg.kind = Register::KIND_INT;
+    reg.intValue = value;
+}
+
+void FormulaVirtualMachine::SetValue(Register& reg, float32 value)
+{
+    reg.kind = Register::KIND_FLOAT;
+    reg.floatValue = value;
+}
+
+void FormulaVirtualMachine::SetValue(Register& reg, bool value)
+{
+    reg.kind = Register::KIND_BOOL;
+    reg.boolValue = value;
+}
+
+void FormulaVirtualMachine::SetAny(Register& reg, Any&& value)
+{
+    if (value.CanCast<std::shared_ptr<FormulaExpression>>())
+    {
+        std::shared_ptr<FormulaExpression> internalExpr = value.Cast<std::shared_ptr<FormulaExpression>>();
+        FormulaExecutor executor(context->GetParent() ? context->GetParent() : context);
+        value = executor.Calculate(internalExpr.get());
+    }
+
+    if (value.CanGet<int32>())
+    {
+        SetValue(reg, value.Get<int32>());
+    }
+    else if (value.CanGet<float32>())
+    {
+        SetValue(reg, value.Get<float32>());
+    }
+    else if (value.CanGet<bool>())
+    {
+        SetValue(reg, value.Get<bool>());
+    }
+    else
+    {
+        reg.kind = Register::KIND_ANY;
+        reg.anyValue = std::move(value);
+    }
+}
+
+void FormulaVirtualMachine::SetReference(Register& reg, const Reflection& ref)
+{
+    DVASSERT(ref.IsValid());
+    reg.kind = Register::KIND_REFERENCE;
+    reg.anyValue.Clear();
+    reg.reference = ref;
+    dependencies.push_back(ref.GetValueObject().GetVoidPtr());
+}
+
+void FormulaVirtualMachine::Resolve(Register& reg, FormulaExpression* source)
+{
+    if (reg.kind == Register::KIND_REFERENCE)
+    {
+        Any value = reg.anyValue.IsEmpty() ? reg.reference.GetValue() : reg.anyValue;
+        reg.reference = Reflection();
+        SetAny(reg, std::move(value));
+    }
+    else if (reg.kind == Register::KIND_EMPTY)
+    {
+        DAVA_THROW(FormulaException, Format("Can't calculate expression '%s'", FormulaFormatter().Format(source).c_str()), source);
+    }
+}
+
+Any FormulaVirtualMachine::ToAny(Register& reg, FormulaExpression* source)
+{
+    Resolve(reg, source);
+
+    switch (reg.kind)
+    {
+    case Register::KIND_INT:
+        return Any(reg.intValue);
+    case Register::KIND_FLOAT:
+        return Any(reg.floatValue);
+    case Register::KIND_BOOL:
+        return Any(reg.boolValue);
+    default:
+        return reg.anyValue;
+    }
+}
+
+void FormulaVirtualMachine::ExecuteNeg(const FormulaProgram::Instruction& instruction)
+{
+    Register& src = registers[instruction.a];
+    Resolve(src, instruction.source);
+
+    Register& dst = registers[instruction.dst];
+    if (src.kind == Register::KIND_INT)
+    {
+        SetValue(dst, -src.intValue);
+    }
+    else if (src.kind == Register::KIND_FLOAT)
+    {
+        SetValue(dst, -src.floatValue);
+    }
+    else
+    {
+        SetAny(dst, FormulaExecutor::CalculateNeg(ToAny(src, instruction.source), instruction.source));
+    }
+}
+
+void FormulaVirtualMachine::ExecuteNot(const FormulaProgram::Instruction& instruction)
+{
+    Register& src = registers[instruction.a];
+    Resolve(src, instruction.source);
+
+    Register& dst = registers[instruction.dst];
+    if (src.kind == Register::KIND_BOOL)
+    {
+        SetValue(dst, !src.boolValue);
+    }
+    else
+    {
+        SetAny(dst, FormulaExecutor::CalculateNot(ToAny(src, instruction.source), instruction.source));
+    }
+}
+
+void FormulaVirtualMachine::ExecuteBinary(const FormulaProgram::Instruction& instruction)
+{
+    Register& lhs = registers[instruction.a];
+    Register& rhs = registers[instruction.b];
+    Resolve(lhs, instruction.source);
+    Resolve(rhs, instruction.source);
+
+    Register& dst = registers[instruction.dst];
+    FormulaBinaryOperatorExpression::Operator op = instruction.binaryOperator;
+    bool isLogicalOp = op == FormulaBinaryOperatorExpression::OP_AND || op == FormulaBinaryOperatorExpression::OP_OR;
+
+    // Fast paths follow conversion rules of FormulaExecutor::CalculateBinaryOperator
+    if (lhs.kind == Register::KIND_INT && rhs.kind == Register::KIND_INT && !isLogicalOp)
+    {
+        int32 lVal = lhs.intValue;
+        int32 rVal = rhs.intValue;
+        if (op == FormulaBinaryOperatorExpression::OP_MOD)
+        {
+            SetValue(dst, lVal % rVal);
+        }
+        else
+        {
+            CalculateNumberValues<int32>(op, lVal, rVal, dst);
+        }
+        return;
+    }
+
+    bool isLhsNumber = lhs.kind == Register::KIND_INT || lhs.kind == Register::KIND_FLOAT;
+    bool isRhsNumber = rhs.kind == Register::KIND_INT || rhs.kind == Register::KIND_FLOAT;
+    if (isLhsNumber && isRhsNumber && !isLogicalOp && op != FormulaBinaryOperatorExpression::OP_MOD)
+    {
+        float32 lVal = lhs.kind == Register::KIND_FLOAT ? lhs.floatValue : static_cast<float32>(lhs.intValue);
+        float32 rVal = rhs.kind == Register::KIND_FLOAT ? rhs.floatValue : static_cast<float32>(rhs.intValue);
+        CalculateNumberValues<float32>(op, lVal, rVal, dst);
+        return;
+    }
+
+    if (lhs.kind == Register::KIND_BOOL && rhs.kind == Register::KIND_BOOL)
+    {
+        bool lVal = lhs.boolValue;
+        bool rVal = rhs.boolValue;
+        switch (op)
+        {
+        case FormulaBinaryOperatorExpression::OP_AND:
+            SetValue(dst, lVal && rVal);
+            return;
+        case FormulaBinaryOperatorExpression::OP_OR:
+            SetValue(dst, lVal || rVal);
+            return;
+        case FormulaBinaryOperatorExpression::OP_EQ:
+            SetValue(dst, lVal == rVal);
+            return;
+        case FormulaBinaryOperatorExpression::OP_NOT_EQ:
+            SetValue(dst, lVal != rVal);
+            return;
+        default:
+            break;
+        }
+    }
+
+    Any l = ToAny(lhs, instruction.source);
+    Any r = ToAny(rhs, instruction.source);
+    Any res = FormulaExecutor::CalculateBinaryOperator(op, l, r, instruction.source);
+    if (res.IsEmpty())
+    {
+        DAVA_THROW(FormulaException, Format("Can't calculate expression '%s'", FormulaFormatter().Format(instruction.source).c_str()), instruction.source);
+    }
+    SetAny(dst, std::move(res));
+}
+
+void FormulaVirtualMachine::ExecuteCall(const FormulaProgram::Instruction& instruction)
+{
+    callArguments.resize(instruction.b);
+    for (uint16 i = 0; i < instruction.b; i++)
+    {
+        callArguments[i] = ToAny(registers[instruction.a + i], instruction.source);
+    }
+
+    FormulaFunctionExpression* exp = static_cast<FormulaFunctionExpression*>(instruction.source);
+    Any res = FormulaExecutor::InvokeFunction(context, exp, callArguments);
+    if (res.IsEmpty())
+    {
+        DAVA_THROW(FormulaException, Format("Can't calculate expression '%s'", FormulaFormatter().Format(exp).c_str()), exp);
+    }
+    SetAny(registers[instruction.dst], std::move(res));
+}
+
+void FormulaVirtualMachine::ExecuteGetField(const FormulaProgram& program, const FormulaProgram::Instruction& instruction)
+{
+    Register& base = registers[instruction.a];
+    if (base.kind != Register::KIND_REFERENCE)
+    {
+        DAVA_THROW(FormulaException, Format("Can't get data reference '%s'", FormulaFormatter().Format(instruction.operandSource).c_str()), instruction.operandSource);
+    }
+
+    const String& name = program.names[instruction.index];
+    Reflection ref = base.reference.GetField(name);
+    if (!ref.IsValid())
+    {
+        DAVA_THROW(FormulaException, Format("Can't resolve symbol '%s'", name.c_str()), instruction.source);
+    }
+    SetReference(registers[instruction.dst], ref);
+}
+
+void FormulaVirtualMachine::ExecuteGetIndex(const FormulaProgram::Instruction& instruction)
+{
+    Any indexVal = ToAny(registers[instruction.b], instruction.source);
+
+    Register& base = registers[instruction.a];
+    if (base.kind != Register::KIND_REFERENCE)
+    {
+        DAVA_THROW(FormulaException, Format("Can't get data reference '%s'", FormulaFormatter().Format(instruction.operandSource).c_str()), instruction.operandSource);
+    }
+
+    Reflection ref = base.reference.GetField(indexVal);
+    if (!ref.IsValid())
+    {
+        DAVA_THROW(FormulaException, Format("Can't get data '%s' by index '%s' with type '%s'",
+                                            FormulaFormatter().Format(instruction.source).c_str(),
+                                            FormulaFormatter::AnyToString(indexVal).c_str(),
+                                            FormulaFormatter::AnyTypeToString(indexVal).c_str()),
+                   instruction.source);
+    }
+    SetReference(registers[instruction.dst], ref);
+}
+
+template <typename T>
+void FormulaVirtualMachine::CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal, Register& dst)
+{
+    switch (op)
+    {
+    case FormulaBinaryOperatorExpression::OP_PLUS:
+        SetValue(dst, static_cast<T>(lVal + rVal));
+        break;
+    case FormulaBinaryOperatorExpression::OP_MINUS:
+        SetValue(dst, static_cast<T>(lVal - rVal));
+        break;
+    case FormulaBinaryOperatorExpression::OP_MUL:
+        SetValue(dst, static_cast<T>(lVal * rVal));
+        break;
+    case FormulaBinaryOperatorExpression::OP_DIV:
+        SetValue(dst, static_cast<T>(lVal / rVal));
+        break;
+    case FormulaBinaryOperatorExpression::OP_EQ:
+        SetValue(dst, lVal == rVal);
+        break;
+    case FormulaBinaryOperatorExpression::OP_NOT_EQ:
+        SetValue(dst, lVal != rVal);
+        break;
+    case FormulaBinaryOperatorExpression::OP_LE:
+        SetValue(dst, lVal <= rVal);
+        break;
+    case FormulaBinaryOperatorExpression::OP_LT:
+        SetValue(dst, lVal < rVal);
+        break;
+    case FormulaBinaryOperatorExpression::OP_GE:
+        SetValue(dst, lVal >= rVal);
+        break;
+    case FormulaBinaryOperatorExpression::OP_GT:
+        SetValue(dst, lVal > rVal);
+        break;
+    default:
+        DVASSERT(false, "Invalid operands to binary expression");
+        break;
+    }
+}
+}
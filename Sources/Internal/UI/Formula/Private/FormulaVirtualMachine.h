@@ -0,0 +1,85 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "Base/Any.h"
+#include "Reflection/Reflection.h"
+#include "UI/Formula/Private/FormulaCompiler.h"
+
+namespace DAVA
+{
+class FormulaContext;
+
+/**
+ \ingroup formula
+
+ Executes FormulaProgram. Results are identical to FormulaExecutor, but int32, float32
+ and bool values are kept in registers without Any, so arithmetic and comparison
+ don't allocate. Machine is supposed to be kept by formula owner and reused for
+ every execution, so registers are allocated only once.
+ */
+class FormulaVirtualMachine final
+{
+public:
+    FormulaVirtualMachine();
+    ~FormulaVirtualMachine();
+
+    /**
+     Executes program with data from context and returns result.
+     */
+    Any Execute(const FormulaProgram& program, FormulaContext* context);
+
+    /**
+     Pointers to data which were accessed on last execution. See FormulaExecutor::GetDependencies.
+     */
+    const Vector<void*>& GetDependencies() const;
+
+private:
+    struct Register
+    {
+        enum Kind : uint8
+        {
+            KIND_EMPTY,
+            KIND_INT,
+            KIND_FLOAT,
+            KIND_BOOL,
+            KIND_ANY,
+            KIND_REFERENCE
+        };
+
+        Kind kind = KIND_EMPTY;
+        union
+        {
+            int32 intValue = 0;
+            float32 floatValue;
+            bool boolValue;
+        };
+        Any anyValue;
+        Reflection reference;
+    };
+
+    void SetValue(Register& reg, int32 value);
+    void SetValue(Register& reg, float32 value);
+    void SetValue(Register& reg, bool value);
+    void SetAny(Register& reg, Any&& value);
+    void SetReference(Register& reg, const Reflection& ref);
+
+    void ReleaseRegisters();
+    void Resolve(Register& reg, FormulaExpression* source);
+    Any ToAny(Register& reg, FormulaExpression* source);
+
+    void ExecuteNeg(const FormulaProgram::Instruction& instruction);
+    void ExecuteNot(const FormulaProgram::Instruction& instruction);
+    void ExecuteBinary(const FormulaProgram::Instruction& instruction);
+    void ExecuteCall(const FormulaProgram::Instruction& instruction);
+    void ExecuteGetField(const FormulaProgram& program, const FormulaProgram::Instruction& instruction);
+    void ExecuteGetIndex(const FormulaProgram::Instruction& instruction);
+
+    template <typename T>
+    void CalculateNumberValues(FormulaBinaryOperatorExpression::Operator op, T lVal, T rVal, Register& dst);
+
+    FormulaContext* context = nullptr;
+    Vector<Register> registers;
+    Vector<Any> callArguments;
+    Vector<void*> dependencies;
+};
+}
@@ -23,6 +23,24 @@ void Layouter::ApplyLayout(UIControl* control)
     ApplySizesAndPositions();
 
     layoutData.clear();
+
+    if (!skippedSubtrees.empty())
+    {
+        Vector<UIControl*> resizedControls;
+        for (const SkippedSubtree& subtree : skippedSubtrees)
+        {
+            if (subtree.control->GetSize() != subtree.size)
+            {
+                resizedControls.push_back(subtree.control);
+            }
+        }
+        skippedSubtrees.clear();
+
+        for (UIControl* resizedControl : resizedControls)
+        {
+            ApplyLayout(resizedControl);
+        }
+    }
 }
 
 void Layouter::ApplyLayoutNonRecursive(UIControl* control)
@@ -40,6 +58,7 @@ void Layouter::ApplyLayoutNonRecursive(UIControl* control)
 void Layouter::CollectControls(UIControl* control, bool recursive)
 {
     layoutData.clear();
+    skippedSubtrees.clear();
     layoutData.emplace_back(ControlLayoutData(control));
     CollectControlChildren(control, -1, 0, recursive);
 }
@@ -70,13 +89,49 @@ void Layouter::CollectControlChildren(UIControl* control, int32 parentIndex, int
         {
             if (child->GetComponentCount<UILayoutIsolationComponent>() == 0)
             {
-                CollectControlChildren(child.Get(), index, childIndex, recursive);
+                if (incrementalLayoutEnabled && CanSkipSubtree(child.Get()))
+                {
+                    int32 nextIndex = static_cast<int32>(layoutData.size());
+                    layoutData[childIndex].SetParentIndex(index);
+                    layoutData[childIndex].SetFirstChildIndex(nextIndex);
+                    layoutData[childIndex].SetLastChildIndex(nextIndex - 1);
+                    skippedSubtrees.push_back({ child.Get(), child->GetSize() });
+                }
+                else
+                {
+                    CollectControlChildren(child.Get(), index, childIndex, recursive);
+                }
                 childIndex++;
             }
         }
     }
 }
 
+bool Layouter::CanSkipSubtree(const UIControl* control) const
+{
+    if (control->GetChildren().empty() || control->IsLayoutDirty() || control->IsLayoutPositionDirty() ||
+        control->IsLayoutOrderDirty() || control->IsLayoutChildrenDirty())
+    {
+        return false;
+    }
+
+    UISizePolicyComponent* sizePolicy = control->GetComponent<UISizePolicyComponent>();
+    if (sizePolicy != nullptr)
+    {
+        for (int32 axis = Vector2::AXIS_X; axis < Vector2::AXIS_COUNT; axis++)
+        {
+            UISizePolicyComponent::eSizePolicy policy = sizePolicy->GetPolicyByAxis(axis);
+            if (policy != UISizePolicyComponent::IGNORE_SIZE && policy != UISizePolicyComponent::FIXED_SIZE &&
+                policy != UISizePolicyComponent::PERCENT_OF_PARENT)
+            {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
 void Layouter::ProcessAxis(Vector2::eAxis axis, bool processSizes)
 {
     if (processSizes)
@@ -186,6 +241,11 @@ void Layouter::SetRtl(bool rtl)
     isRtl = rtl;
 }
 
+void Layouter::SetIncrementalLayoutEnabled(bool enabled)
+{
+    incrementalLayoutEnabled = enabled;
+}
+
 bool Layouter::IsLeftNotch() const
 {
     return isLeftNotch;
@@ -38,6 +38,13 @@ public:
     void SetVisibilityRect(const Rect& r);
     const Rect& GetVisibilityRect() const;
 
+    /**
+        In incremental mode clean subtrees, whose size doesn't depend on their children, are not collected.
+        Current size of subtree root is used as its measure result, and subtree is relayouted only if this size was changed.
+    */
+    void SetIncrementalLayoutEnabled(bool enabled);
+    bool IsIncrementalLayoutEnabled() const;
+
     const Vector<ControlLayoutData>& GetLayoutData() const;
     Vector<ControlLayoutData>& GetLayoutData();
 
@@ -45,7 +52,17 @@ public:
     Function<void(UIControl*, Vector2::eAxis, const LayoutFormula*)> onFormulaProcessed;
 
 private:
+    struct SkippedSubtree
+    {
+        UIControl* control = nullptr;
+        Vector2 size;
+    };
+
+    bool CanSkipSubtree(const UIControl* control) const;
+
     Vector<ControlLayoutData> layoutData;
+    Vector<SkippedSubtree> skippedSubtrees;
+    bool incrementalLayoutEnabled = false;
     bool isRtl = false;
     Rect visibilityRect;
     LayoutMargins safeAreaInsets;
@@ -72,4 +89,9 @@ inline const Rect& Layouter::GetVisibilityRect() const
 {
     return visibilityRect;
 }
+
+inline bool Layouter::IsIncrementalLayoutEnabled() const
+{
+    return incrementalLayoutEnabled;
+}
 }
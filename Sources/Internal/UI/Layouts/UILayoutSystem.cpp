@@ -28,6 +28,8 @@ namespace DAVA
 UILayoutSystem::UILayoutSystem()
     : sharedLayouter(std::make_unique<Layouter>())
 {
+    sharedLayouter->SetIncrementalLayoutEnabled(true);
+
     sharedLayouter->onFormulaProcessed = [this](UIControl* control, Vector2::eAxis axis, const LayoutFormula* formula) {
         formulaProcessed.Emit(control, axis, formula);
     };
@@ -90,6 +92,8 @@ void UILayoutSystem::Process(float32 elapsedTime)
     if (!needUpdate)
         return;
 
+    sharedLayouter->SetIncrementalLayoutEnabled(!fullLayoutRequired);
+
     if (currentScreen.Valid())
     {
         ProcessControlHierarhy(currentScreen.Get());
@@ -99,6 +103,12 @@ void UILayoutSystem::Process(float32 elapsedTime)
     {
         ProcessControlHierarhy(popupContainer.Get());
     }
+
+    if (fullLayoutRequired)
+    {
+        fullLayoutRequired = false;
+        sharedLayouter->SetIncrementalLayoutEnabled(true);
+    }
 }
 
 void UILayoutSystem::UnregisterControl(UIControl* control)
@@ -161,6 +171,10 @@ bool UILayoutSystem::IsRtl() const
 
 void UILayoutSystem::SetRtl(bool rtl)
 {
+    if (sharedLayouter->IsRtl() != rtl)
+    {
+        RequestFullLayout();
+    }
     sharedLayouter->SetRtl(rtl);
 }
 
@@ -181,6 +195,8 @@ void UILayoutSystem::SetPhysicalSafeAreaInsets(float32 left, float32 top, float3
                                       isLeftNotch,
                                       isRightNotch);
 
+    RequestFullLayout();
+
     if (currentScreen.Valid())
     {
         currentScreen->SetLayoutDirty();
@@ -333,6 +349,12 @@ void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
 {
     ProcessControl(control);
 
+    // Subtrees without dirty controls are skipped
+    if (!control->IsLayoutChildrenDirty() && !fullLayoutRequired)
+    {
+        return;
+    }
+
     // TODO: For now game has many places where changes in layouts can
     // change hierarchy of controls. In future client want fix this places,
     // after that this code should be replaced by simple for-each.
@@ -350,10 +372,28 @@ void UILayoutSystem::ProcessControlHierarhy(UIControl* control)
         }
         ++it;
     }
+
+    // Flag is reset only after whole subtree is processed. Children dirtied by layout of their siblings keep it for the next update.
+    bool childrenDirty = false;
+    for (const auto& child : children)
+    {
+        childrenDirty = childrenDirty || child->IsLayoutDirty() || child->IsLayoutPositionDirty() || child->IsLayoutOrderDirty() || child->IsLayoutChildrenDirty();
+    }
+    if (!childrenDirty)
+    {
+        control->ResetLayoutChildrenDirty();
+    }
+}
+
+void UILayoutSystem::RequestFullLayout()
+{
+    fullLayoutRequired = true;
+    SetDirty();
 }
 
 void UILayoutSystem::UpdateVisibilityRect(const Rect& visibilityRect)
 {
+    RequestFullLayout();
     sharedLayouter->SetVisibilityRect(visibilityRect);
     if (currentScreen.Valid())
     {
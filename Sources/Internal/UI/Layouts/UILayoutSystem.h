@@ -70,10 +70,12 @@ private:
     void ProcessControl(UIControl* control);
 
     void UpdateVisibilityRect(const Rect& visibilityRect);
+    void RequestFullLayout();
 
     bool autoupdatesEnabled = true;
     bool dirty = false;
     bool needUpdate = false;
+    bool fullLayoutRequired = false; //!< layout context was changed, so all formulas and clean subtrees should be relayouted
     std::unique_ptr<class Layouter> sharedLayouter;
     RefPtr<UIScreen> currentScreen;
     RefPtr<UIControl> popupContainer;
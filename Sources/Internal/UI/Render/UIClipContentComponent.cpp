@@ -33,6 +33,7 @@ UIClipContentComponent* UIClipContentComponent::Clone() const
 void UIClipContentComponent::SetEnabled(bool _enabled)
 {
     enabled = _enabled;
+    SetControlRenderDirty();
 }
 
 bool UIClipContentComponent::IsEnabled() const
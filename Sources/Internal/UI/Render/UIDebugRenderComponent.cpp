@@ -43,6 +43,7 @@ UIDebugRenderComponent::UIDebugRenderComponent(const UIDebugRenderComponent& src
 void UIDebugRenderComponent::SetEnabled(bool _enabled)
 {
     enabled = _enabled;
+    SetControlRenderDirty();
 }
 
 bool UIDebugRenderComponent::IsEnabled() const
@@ -53,6 +54,7 @@ bool UIDebugRenderComponent::IsEnabled() const
 void UIDebugRenderComponent::SetDrawColor(const Color& color)
 {
     drawColor = color;
+    SetControlRenderDirty();
 }
 
 const Color& UIDebugRenderComponent::GetDrawColor() const
@@ -63,6 +65,7 @@ const Color& UIDebugRenderComponent::GetDrawColor() const
 void UIDebugRenderComponent::SetPivotPointDrawMode(ePivotPointDrawMode mode)
 {
     pivotPointDrawMode = mode;
+    SetControlRenderDirty();
 }
 
 UIDebugRenderComponent::ePivotPointDrawMode UIDebugRenderComponent::GetPivotPointDrawMode() const
@@ -3,6 +3,8 @@
 #include "Debug/ProfilerMarkerNames.h"
 #include "Render/2D/Systems/RenderSystem2D.h"
 #include "Render/2D/Systems/VirtualCoordinatesSystem.h"
+#include "Render/2D/FontManager.h"
+#include "Render/2D/GlyphAtlas.h"
 #include "Render/2D/TextBlock.h"
 #include "Render/2D/TextBlockSoftwareRender.h"
 #include "Render/Renderer.h"
@@ -16,6 +18,7 @@
 #include "UI/UIScreen.h"
 #include "UI/UIScreenTransition.h"
 #include "UI/UIScreenshoter.h"
+#include "UI/UIStaticText.h"
 #include "Utils/StringUtils.h"
 
 namespace DAVA
@@ -44,6 +47,11 @@ UIRenderSystem::UIRenderSystem(RenderSystem2D* renderSystem2D_)
 
 UIRenderSystem::~UIRenderSystem() = default;
 
+void UIRenderSystem::UnregisterControl(UIControl* control)
+{
+    RemoveRetainedDrawList(control);
+}
+
 void UIRenderSystem::OnControlVisible(UIControl* control)
 {
     if (control->GetComponentCount<UISceneComponent>() != 0)
@@ -54,6 +62,8 @@ void UIRenderSystem::OnControlVisible(UIControl* control)
 
 void UIRenderSystem::OnControlInvisible(UIControl* control)
 {
+    RemoveRetainedDrawList(control);
+
     if (control->GetComponentCount<UISceneComponent>() != 0)
     {
         ui3DViews.erase(control);
@@ -87,16 +97,56 @@ void UIRenderSystem::Render()
 {
     DAVA_PROFILER_CPU_SCOPE(ProfilerCPUMarkerName::UI_RENDER_SYSTEM);
 
-    if (currentScreen.Valid())
+    const bool wasBatchReorderingEnabled = renderSystem2D->IsBatchReorderingEnabled();
+    renderSystem2D->SetBatchReorderingEnabled(batchReorderingEnabled);
+
+    if (retainedModeEnabled)
     {
-        RenderControlHierarhy(currentScreen.Get(), baseGeometricData, nullptr);
-    }
+        // Recorded geometry depends on screen size (sprites culling and per pixel alignment)
+        const VirtualCoordinatesSystem* vcs = GetEngineContext()->uiControlSystem->vcs;
+        if (retainedVirtualScreenSize != vcs->GetVirtualScreenSize() || retainedPhysicalScreenSize != vcs->GetPhysicalScreenSize())
+        {
+            InvalidateRetainedDrawLists();
+            retainedVirtualScreenSize = vcs->GetVirtualScreenSize();
+            retainedPhysicalScreenSize = vcs->GetPhysicalScreenSize();
+        }
 
-    if (popupContainer.Valid())
+        // Recorded text references glyph atlas texture and coordinates, which are replaced on atlas repacking
+        if (TextBlock::IsGlyphAtlasEnabled())
+        {
+            uint32 glyphAtlasGeneration = GetEngineContext()->fontManager->GetGlyphAtlas()->GetGeneration();
+            if (retainedGlyphAtlasGeneration != glyphAtlasGeneration)
+            {
+                InvalidateRetainedDrawLists();
+                retainedGlyphAtlasGeneration = glyphAtlasGeneration;
+            }
+        }
+
+        if (currentScreen.Valid())
+        {
+            RenderRetainedControlHierarhy(currentScreen.Get(), baseGeometricData, nullptr);
+        }
+
+        if (popupContainer.Valid())
+        {
+            RenderRetainedControlHierarhy(popupContainer.Get(), baseGeometricData, nullptr);
+        }
+    }
+    else
     {
-        RenderControlHierarhy(popupContainer.Get(), baseGeometricData, nullptr);
+        if (currentScreen.Valid())
+        {
+            RenderControlHierarhy(currentScreen.Get(), baseGeometricData, nullptr);
+        }
+
+        if (popupContainer.Valid())
+        {
+            RenderControlHierarhy(popupContainer.Get(), baseGeometricData, nullptr);
+        }
     }
 
+    renderSystem2D->SetBatchReorderingEnabled(wasBatchReorderingEnabled);
+
     screenshoter->OnFrame();
 }
 
@@ -149,6 +199,62 @@ void UIRenderSystem::SetPopupContainer(const RefPtr<UIControl>& _popupContainer)
     popupContainer = _popupContainer;
 }
 
+void UIRenderSystem::SetRetainedModeEnabled(bool enabled)
+{
+    if (retainedModeEnabled != enabled)
+    {
+        retainedModeEnabled = enabled;
+        InvalidateRetainedDrawLists();
+    }
+}
+
+bool UIRenderSystem::IsRetainedModeEnabled() const
+{
+    return retainedModeEnabled;
+}
+
+void UIRenderSystem::SetBatchReorderingEnabled(bool enabled)
+{
+    batchReorderingEnabled = enabled;
+}
+
+bool UIRenderSystem::IsBatchReorderingEnabled() const
+{
+    return batchReorderingEnabled;
+}
+
+void UIRenderSystem::InvalidateRetainedDrawLists()
+{
+    retainedDrawLists.clear();
+}
+
+void UIRenderSystem::RemoveRetainedDrawList(UIControl* control)
+{
+    auto it = retainedDrawLists.find(control);
+    if (it != retainedDrawLists.end())
+    {
+        // Parents keep pointer to removed draw list, so they should be rebuilt
+        for (RetainedDrawList* parentList = it->second->parent; parentList != nullptr; parentList = parentList->parent)
+        {
+            parentList->subtreeValid = false;
+            parentList->children.clear();
+        }
+        for (RetainedDrawList* childList : it->second->children)
+        {
+            childList->parent = nullptr;
+        }
+        retainedDrawLists.erase(it);
+    }
+}
+
+bool UIRenderSystem::IsRetainedModeSupported(const UIControl* control) const
+{
+    // Controls with overridden Draw/DrawAfterChilds may be animated or use DrawPacket,
+    // so only types with known draw code are retained
+    const std::type_info& type = typeid(*control);
+    return type == typeid(UIControl) || type == typeid(UIStaticText) || type == typeid(UIScreen);
+}
+
 void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground)
 {
     if (!control->GetVisibilityFlag() || control->IsHiddenForDebug())
@@ -171,22 +277,150 @@ void UIRenderSystem::RenderControlHierarhy(UIControl* control, const UIGeometric
         renderSystem2D->IntersectClipRect(unrotatedRect); //anyway it doesn't work with rotation
     }
 
-    control->Draw(drawData);
-    const UITextComponent* txt = control->GetComponent<UITextComponent>();
-    if (txt)
+    RenderControlContent(control, drawData, parentColor);
+
+    const UIControlBackground* bg = control->GetComponent<UIControlBackground>();
+    const UIControlBackground* parentBgForChild = bg ? bg : parentBackground;
+    control->isIteratorCorrupted = false;
+    for (const auto& child : control->GetChildren())
     {
-        RenderText(control, txt, drawData, parentColor);
+        RenderControlHierarhy(child.Get(), drawData, parentBgForChild);
+        DVASSERT(!control->isIteratorCorrupted);
+    }
+
+    RenderControlAfterChildren(control, drawData, clipContents);
+}
+
+UIRenderSystem::RetainedDrawList* UIRenderSystem::RenderRetainedControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground)
+{
+    if (!control->GetVisibilityFlag() || control->IsHiddenForDebug())
+        return nullptr;
+
+    UIGeometricData drawData = control->GetLocalGeometricData();
+    drawData.AddGeometricData(geometricData);
+
+    const Color& parentColor = parentBackground ? parentBackground->GetDrawColor() : Color::White;
+
+    std::unique_ptr<RetainedDrawList>& drawListPtr = retainedDrawLists[control];
+    if (!drawListPtr)
+    {
+        drawListPtr.reset(new RetainedDrawList());
+    }
+    RetainedDrawList* drawList = drawListPtr.get();
+
+    const bool supported = IsRetainedModeSupported(control);
+    const UIGeometricData& cachedData = drawList->geometricData;
+    bool upToDate = supported && drawList->valid && !control->IsRenderDirty();
+    upToDate = upToDate && cachedData.position == drawData.position && cachedData.size == drawData.size;
+    upToDate = upToDate && cachedData.pivotPoint == drawData.pivotPoint && cachedData.scale == drawData.scale && cachedData.angle == drawData.angle;
+    upToDate = upToDate && drawList->parentColor == parentColor && drawList->clip == renderSystem2D->GetClip();
+
+    control->ResetRenderDirty();
+
+    if (upToDate && drawList->subtreeValid)
+    {
+        ReplayRetainedDrawList(drawList);
+        return drawList;
+    }
+
+    if (!upToDate)
+    {
+        drawList->geometricData = drawData;
+        drawList->parentColor = parentColor;
+        drawList->clip = renderSystem2D->GetClip();
+        drawList->beforeChildren.Clear();
+        drawList->afterChildren.Clear();
+        control->SetParentColor(parentColor);
+    }
+
+    UIClipContentComponent* clipContent = control->GetComponent<UIClipContentComponent>();
+    bool clipContents = (clipContent != nullptr && clipContent->IsEnabled());
+    if (clipContents)
+    {
+        renderSystem2D->PushClip();
+        renderSystem2D->IntersectClipRect(drawData.GetUnrotatedRect());
+    }
+
+    if (upToDate)
+    {
+        renderSystem2D->ReplayBatchRecord(drawList->beforeChildren);
+    }
+    else if (supported)
+    {
+        renderSystem2D->BeginBatchRecording(&drawList->beforeChildren);
+        RenderControlContent(control, drawData, parentColor);
+        renderSystem2D->EndBatchRecording();
+    }
+    else
+    {
+        RenderControlContent(control, drawData, parentColor);
     }
 
     const UIControlBackground* bg = control->GetComponent<UIControlBackground>();
     const UIControlBackground* parentBgForChild = bg ? bg : parentBackground;
+    bool childrenValid = true;
+    drawList->children.clear();
     control->isIteratorCorrupted = false;
     for (const auto& child : control->GetChildren())
     {
-        RenderControlHierarhy(child.Get(), drawData, parentBgForChild);
+        RetainedDrawList* childList = RenderRetainedControlHierarhy(child.Get(), drawData, parentBgForChild);
+        if (childList != nullptr)
+        {
+            childList->parent = drawList;
+            childrenValid = childrenValid && childList->subtreeValid;
+            drawList->children.push_back(childList);
+        }
         DVASSERT(!control->isIteratorCorrupted);
     }
 
+    if (upToDate)
+    {
+        if (clipContents)
+        {
+            renderSystem2D->PopClip();
+        }
+        renderSystem2D->ReplayBatchRecord(drawList->afterChildren);
+    }
+    else if (supported)
+    {
+        renderSystem2D->BeginBatchRecording(&drawList->afterChildren);
+        RenderControlAfterChildren(control, drawData, clipContents);
+        renderSystem2D->EndBatchRecording();
+
+        drawList->valid = drawList->beforeChildren.replayable && drawList->afterChildren.replayable;
+    }
+    else
+    {
+        RenderControlAfterChildren(control, drawData, clipContents);
+        drawList->valid = false;
+    }
+
+    drawList->subtreeValid = drawList->valid && childrenValid;
+    return drawList;
+}
+
+void UIRenderSystem::ReplayRetainedDrawList(const RetainedDrawList* drawList)
+{
+    renderSystem2D->ReplayBatchRecord(drawList->beforeChildren);
+    for (const RetainedDrawList* childList : drawList->children)
+    {
+        ReplayRetainedDrawList(childList);
+    }
+    renderSystem2D->ReplayBatchRecord(drawList->afterChildren);
+}
+
+void UIRenderSystem::RenderControlContent(UIControl* control, const UIGeometricData& drawData, const Color& parentColor)
+{
+    control->Draw(drawData);
+    const UITextComponent* txt = control->GetComponent<UITextComponent>();
+    if (txt)
+    {
+        RenderText(control, txt, drawData, parentColor);
+    }
+}
+
+void UIRenderSystem::RenderControlAfterChildren(UIControl* control, const UIGeometricData& drawData, bool clipContents)
+{
     control->DrawAfterChilds(drawData);
 
     if (clipContents)
@@ -277,9 +511,9 @@ void UIRenderSystem::RenderText(const UIControl* control, const UITextComponent*
     }
 
     Rect textBlockRect(geometricData.position, geometricData.size);
-    if (textBlock->GetFont() && textBlock->GetFont()->GetFontType() == Font::TYPE_DISTANCE)
+    if (textBlock->GetFont() && (textBlock->GetFont()->GetFontType() == Font::TYPE_DISTANCE || textBlock->IsGlyphAtlasUsed()))
     {
-        // Correct rect and setup position and scale for distance fonts
+        // Correct rect and setup position and scale for distance fonts and glyph atlas text
         textBlockRect.dx *= geometricData.scale.dx;
         textBlockRect.dy *= geometricData.scale.dy;
         textBlock->SetScale(geometricData.scale);
@@ -2,6 +2,9 @@
 
 #include "Base/BaseTypes.h"
 #include "Base/RefPtr.h"
+#include "Math/Color.h"
+#include "Math/Math2D.h"
+#include "Render/2D/Systems/BatchRecord2D.h"
 #include "UI/UISystem.h"
 #include "UI/UIGeometricData.h"
 
@@ -36,7 +39,27 @@ public:
     void SetCurrentScreen(const RefPtr<UIScreen>& screen);
     void SetPopupContainer(const RefPtr<UIControl>& popupContainer);
 
+    /**
+    Enable retained rendering of current screen and popups.
+    In retained mode batches of each control are recorded once and replayed every frame
+    until control is marked with `UIControl::SetRenderDirty` (layout, style, text or background changes do it automatically).
+    Only controls of known types (UIControl, UIStaticText, UIScreen) are retained, other controls are drawn every frame.
+    */
+    void SetRetainedModeEnabled(bool enabled);
+    bool IsRetainedModeEnabled() const;
+
+    /** Drop all retained draw lists, e.g. after textures reloading or localization change. */
+    void InvalidateRetainedDrawLists();
+
+    /**
+    Enable reordering of non-overlapping batches of UI by RenderSystem2D (see `RenderSystem2D::SetBatchReorderingEnabled`)
+    while current screen and popups are rendered. Disabled by default.
+    */
+    void SetBatchReorderingEnabled(bool enabled);
+    bool IsBatchReorderingEnabled() const;
+
 protected:
+    void UnregisterControl(UIControl* control) override;
     void OnControlVisible(UIControl* control) override;
     void OnControlInvisible(UIControl* control) override;
 
@@ -49,7 +72,26 @@ protected:
 private:
     void ForceRenderControl(UIControl* control);
 
+    struct RetainedDrawList
+    {
+        BatchRecord2D beforeChildren{ true };
+        BatchRecord2D afterChildren{ true };
+        Vector<RetainedDrawList*> children; //!< draw lists of children visible on the last render
+        RetainedDrawList* parent = nullptr;
+        UIGeometricData geometricData;
+        Color parentColor;
+        Rect clip;
+        bool valid = false; //!< own batches can be replayed
+        bool subtreeValid = false; //!< batches of whole subtree can be replayed without hierarchy traversal
+    };
+
     void RenderControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground);
+    RetainedDrawList* RenderRetainedControlHierarhy(UIControl* control, const UIGeometricData& geometricData, const UIControlBackground* parentBackground);
+    void ReplayRetainedDrawList(const RetainedDrawList* drawList);
+    void RemoveRetainedDrawList(UIControl* control);
+    bool IsRetainedModeSupported(const UIControl* control) const;
+    void RenderControlContent(UIControl* control, const UIGeometricData& drawData, const Color& parentColor);
+    void RenderControlAfterChildren(UIControl* control, const UIGeometricData& drawData, bool clipContents);
 
     void DebugRender(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
     void RenderDebugRect(const UIDebugRenderComponent* component, const UIGeometricData& geometricData);
@@ -67,5 +109,12 @@ private:
 
     Set<UIControl*> ui3DViews;
     bool needClearMainPass = true;
+
+    UnorderedMap<const UIControl*, std::unique_ptr<RetainedDrawList>> retainedDrawLists;
+    Size2i retainedVirtualScreenSize;
+    Size2i retainedPhysicalScreenSize;
+    uint32 retainedGlyphAtlasGeneration = 0;
+    bool retainedModeEnabled = false;
+    bool batchReorderingEnabled = false;
 };
 }
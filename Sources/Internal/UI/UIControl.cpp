@@ -90,6 +90,8 @@ UIControl::UIControl(const Rect& rect)
     , layoutDirty(true)
     , layoutPositionDirty(true)
     , layoutOrderDirty(true)
+    , layoutChildrenDirty(false)
+    , renderDirty(true)
     , inputEnabled(true)
 {
     StartControlTracking(this);
@@ -144,6 +146,9 @@ void UIControl::SetParent(UIControl* newParent)
         PropagateParentWithContext(newParent->packageContext ? newParent : newParent->parentWithContext);
 
         parent->RegisterInputProcessors(inputProcessorsCount);
+
+        // Dirty flags of attached subtree were set while it wasn't reachable from new parent
+        parent->SetLayoutChildrenDirty();
     }
     else
     {
@@ -433,6 +438,7 @@ void UIControl::SetPivot(const Vector2& newPivot)
 void UIControl::SetAngle(float32 angleInRad)
 {
     angle = angleInRad;
+    SetRenderDirty();
 }
 
 void UIControl::SetAngleInDegrees(float32 angleInDeg)
@@ -480,6 +486,7 @@ void UIControl::SetScaledRect(const Rect& rect, bool rectInAbsoluteCoordinates /
         scale.y = rect.dy / (size.y * gd.scale.y);
         SetAbsolutePosition(Vector2(rect.x + GetPivotPoint().x * scale.x, rect.y + GetPivotPoint().y * scale.y));
     }
+    SetRenderDirty();
 }
 
 float32 UIControl::GetAngleInDegrees() const
@@ -656,6 +663,7 @@ void UIControl::RemoveControl(UIControl* control_)
             children.erase(it);
             isIteratorCorrupted = true;
             SetLayoutDirty();
+            SetLayoutChildrenDirty();
             return;
         }
     }
@@ -890,6 +898,7 @@ void UIControl::CopyDataFrom(UIControl* srcControl)
     layoutDirty = srcControl->layoutDirty;
     layoutPositionDirty = srcControl->layoutPositionDirty;
     layoutOrderDirty = srcControl->layoutOrderDirty;
+    layoutChildrenDirty = srcControl->layoutChildrenDirty;
     packageContext = srcControl->packageContext;
 
     eventDispatcher = nullptr;
@@ -1816,6 +1825,7 @@ bool UIControl::IsHiddenForDebug() const
 void UIControl::SetHiddenForDebug(bool hidden)
 {
     hiddenForDebug = hidden;
+    SetRenderDirty();
 }
 
 void UIControl::SystemOnFocusLost()
@@ -2298,6 +2308,7 @@ bool UIControl::IsStyleSheetDirty() const
 void UIControl::SetStyleSheetDirty()
 {
     styleSheetDirty = true;
+    SetRenderDirty();
     if (scene)
     {
         scene->GetStyleSheetSystem()->SetDirty();
@@ -2316,6 +2327,8 @@ void UIControl::ResetStyleSheetDirty()
 void UIControl::SetLayoutDirty()
 {
     layoutDirty = true;
+    SetParentsLayoutChildrenDirty();
+    SetRenderDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2336,6 +2349,8 @@ void UIControl::ResetLayoutDirty()
 void UIControl::SetLayoutPositionDirty()
 {
     layoutPositionDirty = true;
+    SetParentsLayoutChildrenDirty();
+    SetRenderDirty();
     if (scene)
     {
         scene->GetLayoutSystem()->SetDirty();
@@ -2354,6 +2369,8 @@ void UIControl::ResetLayoutPositionDirty()
 void UIControl::SetLayoutOrderDirty()
 {
     layoutOrderDirty = true;
+    SetParentsLayoutChildrenDirty();
+    SetRenderDirty();
 }
 
 void UIControl::ResetLayoutOrderDirty()
@@ -2361,6 +2378,43 @@ void UIControl::ResetLayoutOrderDirty()
     layoutOrderDirty = false;
 }
 
+void UIControl::ResetLayoutChildrenDirty()
+{
+    layoutChildrenDirty = false;
+}
+
+void UIControl::SetLayoutChildrenDirty()
+{
+    // Layout system skips subtrees without dirty controls, so all parents up to the root should be marked
+    for (UIControl* c = this; c != nullptr; c = c->parent)
+    {
+        c->layoutChildrenDirty = true;
+    }
+}
+
+void UIControl::SetParentsLayoutChildrenDirty()
+{
+    if (parent != nullptr)
+    {
+        parent->SetLayoutChildrenDirty();
+    }
+}
+
+void UIControl::SetRenderDirty()
+{
+    // Parents are always marked too: each of them replays retained draw list of the whole subtree.
+    // Propagation can't stop on already dirty parent, because dirty flag of invisible control is never reset.
+    for (UIControl* c = this; c != nullptr; c = c->parent)
+    {
+        c->renderDirty = true;
+    }
+}
+
+void UIControl::ResetRenderDirty()
+{
+    renderDirty = false;
+}
+
 void UIControl::SetPackageContext(const RefPtr<UIControlPackageContext>& newPackageContext)
 {
     if (packageContext != newPackageContext)
@@ -906,6 +906,8 @@ protected:
     bool layoutDirty : 1;
     bool layoutPositionDirty : 1;
     bool layoutOrderDirty : 1;
+    bool layoutChildrenDirty : 1;
+    bool renderDirty : 1;
 
     int32 inputProcessorsCount = 1;
 
@@ -919,6 +921,7 @@ protected:
 
     void SetScene(UIControlSystem* scene);
     void SetParent(UIControl* newParent);
+    void SetParentsLayoutChildrenDirty();
 
     virtual ~UIControl();
 
@@ -1082,6 +1085,16 @@ public:
     void SetLayoutOrderDirty();
     void ResetLayoutOrderDirty();
 
+    /** Returns true if any of layout dirty flags is set for some control in the subtree of this control (except itself). */
+    bool IsLayoutChildrenDirty() const;
+    void SetLayoutChildrenDirty();
+    void ResetLayoutChildrenDirty();
+
+    /** Render dirty flag invalidates retained draw lists of this control and all its parents. */
+    bool IsRenderDirty() const;
+    void SetRenderDirty();
+    void ResetRenderDirty();
+
     RefPtr<UIControlPackageContext> GetPackageContext() const;
     const RefPtr<UIControlPackageContext>& GetLocalPackageContext() const;
     void SetPackageContext(const RefPtr<UIControlPackageContext>& packageContext);
@@ -1128,6 +1141,7 @@ inline const Vector2& UIControl::GetScale() const
 inline void UIControl::SetScale(const Vector2& newScale)
 {
     scale = newScale;
+    SetRenderDirty();
 }
 
 inline const Vector2& UIControl::GetSize() const
@@ -1238,4 +1252,14 @@ inline bool UIControl::IsLayoutOrderDirty() const
 {
     return layoutOrderDirty;
 }
+
+inline bool UIControl::IsLayoutChildrenDirty() const
+{
+    return layoutChildrenDirty;
+}
+
+inline bool UIControl::IsRenderDirty() const
+{
+    return renderDirty;
+}
 };
@@ -151,6 +151,7 @@ void UIControlBackground::SetSprite(const FilePath& path)
 void UIControlBackground::SetFrame(int32 drawFrame)
 {
     frame = drawFrame;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetFrame(const FastName& frameName)
@@ -166,6 +167,7 @@ void UIControlBackground::SetFrame(const FastName& frameName)
 void UIControlBackground::SetAlign(int32 drawAlign)
 {
     align = drawAlign;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
@@ -186,17 +188,20 @@ void UIControlBackground::SetDrawType(UIControlBackground::eDrawType drawType)
 void UIControlBackground::SetModification(int32 modification)
 {
     spriteModification = modification;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetColorInheritType(UIControlBackground::eColorInheritType inheritType)
 {
     DVASSERT(inheritType >= 0 && inheritType < COLOR_INHERIT_TYPES_COUNT);
     colorInheritType = inheritType;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetPerPixelAccuracyType(ePerPixelAccuracyType accuracyType)
 {
     perPixelAccuracyType = accuracyType;
+    SetControlRenderDirty();
 }
 
 UIControlBackground::ePerPixelAccuracyType UIControlBackground::GetPerPixelAccuracyType() const
@@ -211,7 +216,11 @@ const Color& UIControlBackground::GetDrawColor() const
 
 void UIControlBackground::SetDrawColor(const Color& c)
 {
-    drawColor = c;
+    if (drawColor != c)
+    {
+        drawColor = c;
+        SetControlRenderDirty();
+    }
 }
 
 void UIControlBackground::SetParentColor(const Color& parentColor)
@@ -559,11 +568,13 @@ void UIControlBackground::ReleaseDrawData()
 void UIControlBackground::SetLeftRightStretchCap(float32 _leftStretchCap)
 {
     leftStretchCap = _leftStretchCap;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetTopBottomStretchCap(float32 _topStretchCap)
 {
     topStretchCap = _topStretchCap;
+    SetControlRenderDirty();
 }
 
 float32 UIControlBackground::GetLeftRightStretchCap() const
@@ -579,6 +590,7 @@ float32 UIControlBackground::GetTopBottomStretchCap() const
 void UIControlBackground::SetMaterial(NMaterial* _material)
 {
     material = _material;
+    SetControlRenderDirty();
 }
 
 inline NMaterial* UIControlBackground::GetMaterial() const
@@ -589,21 +601,25 @@ inline NMaterial* UIControlBackground::GetMaterial() const
 void UIControlBackground::SetRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors = batches;
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::AppendRenderBatches(const Vector<BatchDescriptor2D>& batches)
 {
     batchDescriptors.insert(batchDescriptors.end(), batches.begin(), batches.end());
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::AddRenderBatch(const BatchDescriptor2D& batch)
 {
     batchDescriptors.push_back(batch);
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::ClearBatches()
 {
     batchDescriptors.clear();
+    SetControlRenderDirty();
 }
 
 const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
@@ -614,6 +630,7 @@ const Vector<BatchDescriptor2D>& UIControlBackground::GetRenderBatches() const
 void UIControlBackground::SetColor(const Color& _color)
 {
     color = _color;
+    SetControlRenderDirty();
 }
 
 const Color& UIControlBackground::GetColor() const
@@ -644,11 +661,13 @@ void UIControlBackground::SetMaskSpriteFromPath(const FilePath& path)
         mask.Set(Sprite::Create(path));
     else
         mask.Set(nullptr);
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetMaskSprite(Sprite* sprite)
 {
     mask = sprite;
+    SetControlRenderDirty();
 }
 
 FilePath UIControlBackground::GetDetailSpritePath() const
@@ -664,11 +683,13 @@ void UIControlBackground::SetDetailSpriteFromPath(const FilePath& path)
         detail.Set(Sprite::Create(path));
     else
         detail.Set(nullptr);
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetDetailSprite(Sprite* sprite)
 {
     detail = sprite;
+    SetControlRenderDirty();
 }
 
 FilePath UIControlBackground::GetGradientSpritePath() const
@@ -684,11 +705,13 @@ void UIControlBackground::SetGradientSpriteFromPath(const FilePath& path)
         gradient.Set(Sprite::Create(path));
     else
         gradient.Set(nullptr);
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetGradientSprite(Sprite* sprite)
 {
     gradient = sprite;
+    SetControlRenderDirty();
 }
 
 FilePath UIControlBackground::GetContourSpritePath() const
@@ -704,11 +727,13 @@ void UIControlBackground::SetContourSpriteFromPath(const FilePath& path)
         contour.Set(Sprite::Create(path));
     else
         contour.Set(nullptr);
+    SetControlRenderDirty();
 }
 
 void UIControlBackground::SetContourSprite(Sprite* sprite)
 {
     contour = sprite;
+    SetControlRenderDirty();
 }
 
 eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
@@ -719,5 +744,6 @@ eGradientBlendMode UIControlBackground::GetGradientBlendMode() const
 void UIControlBackground::SetGradientBlendMode(eGradientBlendMode mode)
 {
     gradientMode = mode;
+    SetControlRenderDirty();
 }
 };
@@ -0,0 +1,1059 @@
+#include "UI/UIPackageBinaryFormat.h"
+
+#include "Base/ScopedPtr.h"
+#include "FileSystem/File.h"
+#include "FileSystem/FileSystem.h"
+#include "Logger/Logger.h"
+#include "Reflection/ReflectedTypeDB.h"
+#include "UI/DefaultUIPackageBuilder.h"
+#include "UI/Styles/UIStyleSheetPropertyDataBase.h"
+#include "UI/UIPackageLoader.h"
+#include "Utils/UTF8Utils.h"
+
+namespace DAVA
+{
+namespace UIPackageBinaryFormatDetails
+{
+const uint32 MAGIC = 0x42495544; // "DUIB"
+const uint32 VERSION = 2;
+const uint32 INVALID_STRING = 0xFFFFFFFF;
+
+enum eOpCode : uint8
+{
+    OP_BEGIN_PACKAGE = 0,
+    OP_END_PACKAGE,
+    OP_IMPORTED_PACKAGE,
+    OP_STYLE_SHEET,
+    OP_BEGIN_CONTROL_WITH_CLASS,
+    OP_BEGIN_CONTROL_WITH_CUSTOM_CLASS,
+    OP_BEGIN_CONTROL_WITH_PROTOTYPE,
+    OP_BEGIN_CONTROL_WITH_PATH,
+    OP_END_CONTROL,
+    OP_BEGIN_CONTROL_PROPERTIES,
+    OP_END_CONTROL_PROPERTIES,
+    OP_BEGIN_COMPONENT_PROPERTIES,
+    OP_END_COMPONENT_PROPERTIES,
+    OP_PROPERTY,
+    OP_DATA_BINDING
+};
+
+enum eValueTag : uint8
+{
+    VALUE_EMPTY = 0,
+    VALUE_BOOL,
+    VALUE_INT32,
+    VALUE_UINT32,
+    VALUE_INT64,
+    VALUE_UINT64,
+    VALUE_FLOAT32,
+    VALUE_FAST_NAME,
+    VALUE_STRING,
+    VALUE_WIDE_STRING,
+    VALUE_VECTOR2,
+    VALUE_VECTOR3,
+    VALUE_VECTOR4,
+    VALUE_COLOR,
+    VALUE_RECT,
+    VALUE_FILE_PATH,
+    VALUE_ENUM
+};
+
+const Type* GetFieldType(const ReflectedStructure::Field* field)
+{
+    return field->valueWrapper->GetType(ReflectedObject())->Decay();
+}
+
+const ReflectedStructure::Field* FindField(const ReflectedType* type, const FastName& name)
+{
+    if (type != nullptr && type->GetStructure() != nullptr)
+    {
+        for (const std::unique_ptr<ReflectedStructure::Field>& field : type->GetStructure()->fields)
+        {
+            if (field->name == name)
+            {
+                return field.get();
+            }
+        }
+    }
+    return nullptr;
+}
+
+class Writer
+{
+public:
+    void WriteUInt8(uint8 value)
+    {
+        ops.push_back(value);
+    }
+
+    void WriteUInt32(uint32 value)
+    {
+        WriteBytes(&value, sizeof(value));
+    }
+
+    void WriteInt32(int32 value)
+    {
+        WriteBytes(&value, sizeof(value));
+    }
+
+    void WriteFloat32(float32 value)
+    {
+        WriteBytes(&value, sizeof(value));
+    }
+
+    void WriteFloats(const float32* values, uint32 count)
+    {
+        WriteBytes(values, count * sizeof(float32));
+    }
+
+    void WriteBytes(const void* bytes, uint32 size)
+    {
+        const uint8* ptr = static_cast<const uint8*>(bytes);
+        ops.insert(ops.end(), ptr, ptr + size);
+    }
+
+    void WriteString(const String& str)
+    {
+        WriteUInt32(InternString(str));
+    }
+
+    void WriteFastName(const FastName& name)
+    {
+        WriteUInt32(name.IsValid() ? InternString(name.c_str()) : INVALID_STRING);
+    }
+
+    bool WriteValue(const Any& value)
+    {
+        if (value.IsEmpty())
+        {
+            WriteUInt8(VALUE_EMPTY);
+            return true;
+        }
+
+        const Type* type = value.GetType()->Decay();
+        if (type == Type::Instance<bool>())
+        {
+            WriteUInt8(VALUE_BOOL);
+            WriteUInt8(value.Get<bool>() ? 1 : 0);
+        }
+        else if (type == Type::Instance<int32>())
+        {
+            WriteUInt8(VALUE_INT32);
+            WriteInt32(value.Get<int32>());
+        }
+        else if (type == Type::Instance<uint32>())
+        {
+            WriteUInt8(VALUE_UINT32);
+            WriteUInt32(value.Get<uint32>());
+        }
+        else if (type == Type::Instance<int64>())
+        {
+            int64 v = value.Get<int64>();
+            WriteUInt8(VALUE_INT64);
+            WriteBytes(&v, sizeof(v));
+        }
+        else if (type == Type::Instance<uint64>())
+        {
+            uint64 v = value.Get<uint64>();
+            WriteUInt8(VALUE_UINT64);
+            WriteBytes(&v, sizeof(v));
+        }
+        else if (type == Type::Instance<float32>())
+        {
+            WriteUInt8(VALUE_FLOAT32);
+            WriteFloat32(value.Get<float32>());
+        }
+        else if (type == Type::Instance<FastName>())
+        {
+            WriteUInt8(VALUE_FAST_NAME);
+            WriteFastName(value.Get<FastName>());
+        }
+        else if (type == Type::Instance<String>())
+        {
+            WriteUInt8(VALUE_STRING);
+            WriteString(value.Get<String>());
+        }
+        else if (type == Type::Instance<WideString>())
+        {
+            WriteUInt8(VALUE_WIDE_STRING);
+            WriteString(UTF8Utils::EncodeToUTF8(value.Get<WideString>()));
+        }
+        else if (type == Type::Instance<Vector2>())
+        {
+            WriteUInt8(VALUE_VECTOR2);
+            WriteFloats(value.Get<Vector2>().data, Vector2::AXIS_COUNT);
+        }
+        else if (type == Type::Instance<Vector3>())
+        {
+            WriteUInt8(VALUE_VECTOR3);
+            WriteFloats(value.Get<Vector3>().data, Vector3::AXIS_COUNT);
+        }
+        else if (type == Type::Instance<Vector4>())
+        {
+            WriteUInt8(VALUE_VECTOR4);
+            WriteFloats(value.Get<Vector4>().data, Vector4::AXIS_COUNT);
+        }
+        else if (type == Type::Instance<Color>())
+        {
+            WriteUInt8(VALUE_COLOR);
+            WriteFloats(value.Get<Color>().color, Color::CHANNEL_COUNT);
+        }
+        else if (type == Type::Instance<Rect>())
+        {
+            const Rect& rect = value.Get<Rect>();
+            WriteUInt8(VALUE_RECT);
+            WriteFloat32(rect.x);
+            WriteFloat32(rect.y);
+            WriteFloat32(rect.dx);
+            WriteFloat32(rect.dy);
+        }
+        else if (type == Type::Instance<FilePath>())
+        {
+            WriteUInt8(VALUE_FILE_PATH);
+            WriteString(value.Get<FilePath>().GetFrameworkPath());
+        }
+        else if (type->IsEnum() && type->GetSize() == sizeof(int32))
+        {
+            // Enums and flags are restored with type of the field they are assigned to
+            WriteUInt8(VALUE_ENUM);
+            WriteInt32(value.ReinterpretCast(Type::Instance<int32>()).Get<int32>());
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    Vector<uint8> Finish()
+    {
+        Vector<uint8> data;
+        data.reserve(ops.size() + 1024);
+
+        auto append = [&data](const void* bytes, size_t size) {
+            const uint8* ptr = static_cast<const uint8*>(bytes);
+            data.insert(data.end(), ptr, ptr + size);
+        };
+
+        append(&MAGIC, sizeof(MAGIC));
+        append(&VERSION, sizeof(VERSION));
+
+        uint32 count = static_cast<uint32>(strings.size());
+        append(&count, sizeof(count));
+        for (const String& str : strings)
+        {
+            uint32 length = static_cast<uint32>(str.size());
+            append(&length, sizeof(length));
+            append(str.data(), length);
+        }
+
+        data.insert(data.end(), ops.begin(), ops.end());
+        return data;
+    }
+
+private:
+    uint32 InternString(const String& str)
+    {
+        auto it = stringIndices.find(str);
+        if (it != stringIndices.end())
+        {
+            return it->second;
+        }
+
+        uint32 index = static_cast<uint32>(strings.size());
+        strings.push_back(str);
+        stringIndices[str] = index;
+        return index;
+    }
+
+    Vector<uint8> ops;
+    Vector<String> strings;
+    UnorderedMap<String, uint32> stringIndices;
+};
+
+/**
+    Records calls of UIPackageLoader and forwards them to the real builder,
+    so reflected types and prototypes are resolved exactly as on yaml loading.
+*/
+class RecordingBuilder : public AbstractUIPackageBuilder
+{
+public:
+    RecordingBuilder(Writer& writer_)
+        : writer(writer_)
+    {
+    }
+
+    bool IsValid() const
+    {
+        return isValid;
+    }
+
+    void BeginPackage(const FilePath& packagePath, int32 version) override
+    {
+        writer.WriteUInt8(OP_BEGIN_PACKAGE);
+        writer.WriteInt32(version);
+        target.BeginPackage(packagePath, version);
+    }
+
+    void EndPackage() override
+    {
+        writer.WriteUInt8(OP_END_PACKAGE);
+        target.EndPackage();
+    }
+
+    bool ProcessImportedPackage(const String& packagePath, AbstractUIPackageLoader* loader) override
+    {
+        writer.WriteUInt8(OP_IMPORTED_PACKAGE);
+        writer.WriteString(packagePath);
+        return target.ProcessImportedPackage(packagePath, loader);
+    }
+
+    void ProcessStyleSheet(const Vector<UIStyleSheetSelectorChain>& selectorChains, const Vector<UIStyleSheetProperty>& properties) override
+    {
+        const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+        writer.WriteUInt8(OP_STYLE_SHEET);
+        writer.WriteUInt32(static_cast<uint32>(selectorChains.size()));
+        for (const UIStyleSheetSelectorChain& chain : selectorChains)
+        {
+            writer.WriteString(chain.ToString());
+        }
+
+        writer.WriteUInt32(static_cast<uint32>(properties.size()));
+        for (const UIStyleSheetProperty& property : properties)
+        {
+            const UIStyleSheetPropertyDescriptor& descr = propertyDB->GetStyleSheetPropertyByIndex(property.propertyIndex);
+            writer.WriteString(descr.GetFullName());
+            if (!writer.WriteValue(property.value))
+            {
+                Fail("Unsupported value type of style sheet property %s", descr.GetFullName().c_str());
+            }
+            writer.WriteUInt8(property.transition ? 1 : 0);
+            writer.WriteFloat32(property.transitionTime);
+            writer.WriteInt32(static_cast<int32>(property.transitionFunction));
+        }
+
+        target.ProcessStyleSheet(selectorChains, properties);
+    }
+
+    const ReflectedType* BeginControlWithClass(const FastName& controlName, const String& className) override
+    {
+        writer.WriteUInt8(OP_BEGIN_CONTROL_WITH_CLASS);
+        writer.WriteFastName(controlName);
+        writer.WriteString(className);
+        return target.BeginControlWithClass(controlName, className);
+    }
+
+    const ReflectedType* BeginControlWithCustomClass(const FastName& controlName, const String& customClassName, const String& className) override
+    {
+        writer.WriteUInt8(OP_BEGIN_CONTROL_WITH_CUSTOM_CLASS);
+        writer.WriteFastName(controlName);
+        writer.WriteString(customClassName);
+        writer.WriteString(className);
+        return target.BeginControlWithCustomClass(controlName, customClassName, className);
+    }
+
+    const ReflectedType* BeginControlWithPrototype(const FastName& controlName, const String& packageName, const FastName& prototypeName, const String* customClassName, AbstractUIPackageLoader* loader) override
+    {
+        if (packageName.empty())
+        {
+            // Prototype from the same package is recorded before the control which uses it,
+            // so on replay builder finds it already created
+            loader->LoadControlByName(prototypeName, this);
+        }
+
+        writer.WriteUInt8(OP_BEGIN_CONTROL_WITH_PROTOTYPE);
+        writer.WriteFastName(controlName);
+        writer.WriteString(packageName);
+        writer.WriteFastName(prototypeName);
+        writer.WriteUInt8(customClassName != nullptr ? 1 : 0);
+        if (customClassName != nullptr)
+        {
+            writer.WriteString(*customClassName);
+        }
+        return target.BeginControlWithPrototype(controlName, packageName, prototypeName, customClassName, loader);
+    }
+
+    const ReflectedType* BeginControlWithPath(const String& pathName) override
+    {
+        writer.WriteUInt8(OP_BEGIN_CONTROL_WITH_PATH);
+        writer.WriteString(pathName);
+        return target.BeginControlWithPath(pathName);
+    }
+
+    const ReflectedType* BeginUnknownControl(const FastName& controlName, const YamlNode* node) override
+    {
+        Fail("Control %s has no class, prototype or path", controlName.c_str());
+        return target.BeginUnknownControl(controlName, node);
+    }
+
+    void EndControl(eControlPlace controlPlace) override
+    {
+        writer.WriteUInt8(OP_END_CONTROL);
+        writer.WriteUInt8(static_cast<uint8>(controlPlace));
+        target.EndControl(controlPlace);
+    }
+
+    void BeginControlPropertiesSection(const String& name) override
+    {
+        if (ReflectedTypeDB::GetByPermanentName(name) == nullptr)
+        {
+            Fail("Control type %s has no permanent name", name.c_str());
+        }
+        writer.WriteUInt8(OP_BEGIN_CONTROL_PROPERTIES);
+        writer.WriteString(name);
+        target.BeginControlPropertiesSection(name);
+    }
+
+    void EndControlPropertiesSection() override
+    {
+        writer.WriteUInt8(OP_END_CONTROL_PROPERTIES);
+        target.EndControlPropertiesSection();
+    }
+
+    const ReflectedType* BeginComponentPropertiesSection(const Type* componentType, uint32 componentIndex) override
+    {
+        const ReflectedType* reflectedType = ReflectedTypeDB::GetByType(componentType);
+        String typeName = reflectedType != nullptr ? reflectedType->GetPermanentName() : String();
+        if (typeName.empty())
+        {
+            Fail("Component type %s has no permanent name", componentType->GetName());
+        }
+        writer.WriteUInt8(OP_BEGIN_COMPONENT_PROPERTIES);
+        writer.WriteString(typeName);
+        writer.WriteUInt32(componentIndex);
+        return target.BeginComponentPropertiesSection(componentType, componentIndex);
+    }
+
+    void EndComponentPropertiesSection() override
+    {
+        writer.WriteUInt8(OP_END_COMPONENT_PROPERTIES);
+        target.EndComponentPropertiesSection();
+    }
+
+    void ProcessProperty(const ReflectedStructure::Field& field, const Any& value) override
+    {
+        writer.WriteUInt8(OP_PROPERTY);
+        writer.WriteFastName(field.name);
+        if (!writer.WriteValue(value))
+        {
+            Fail("Unsupported value type of property %s", field.name.c_str());
+        }
+        target.ProcessProperty(field, value);
+    }
+
+    void ProcessDataBinding(const String& fieldName, const String& expression, int32 bindingMode) override
+    {
+        writer.WriteUInt8(OP_DATA_BINDING);
+        writer.WriteString(fieldName);
+        writer.WriteString(expression);
+        writer.WriteInt32(bindingMode);
+        target.ProcessDataBinding(fieldName, expression, bindingMode);
+    }
+
+private:
+    template <typename... Args>
+    void Fail(const char* format, Args... args)
+    {
+        Logger::Error(format, args...);
+        isValid = false;
+    }
+
+    Writer& writer;
+    DefaultUIPackageBuilder target;
+    bool isValid = true;
+};
+
+class Reader
+{
+public:
+    Reader(const Vector<uint8>& data_)
+        : data(data_)
+    {
+    }
+
+    bool IsEnd() const
+    {
+        return offset == data.size();
+    }
+
+    bool ReadUInt8(uint8& value)
+    {
+        return ReadBytes(&value, sizeof(value));
+    }
+
+    bool ReadUInt32(uint32& value)
+    {
+        return ReadBytes(&value, sizeof(value));
+    }
+
+    bool ReadInt32(int32& value)
+    {
+        return ReadBytes(&value, sizeof(value));
+    }
+
+    bool ReadFloat32(float32& value)
+    {
+        return ReadBytes(&value, sizeof(value));
+    }
+
+    bool ReadBytes(void* bytes, size_t size)
+    {
+        if (offset + size > data.size())
+        {
+            return false;
+        }
+        Memcpy(bytes, data.data() + offset, size);
+        offset += size;
+        return true;
+    }
+
+    bool ReadStringTable()
+    {
+        uint32 count = 0;
+        if (!ReadUInt32(count))
+        {
+            return false;
+        }
+
+        strings.reserve(count);
+        names.resize(count);
+        for (uint32 i = 0; i < count; i++)
+        {
+            uint32 length = 0;
+            if (!ReadUInt32(length) || offset + length > data.size())
+            {
+                return false;
+            }
+            strings.emplace_back(reinterpret_cast<const char*>(data.data() + offset), length);
+            offset += length;
+        }
+        return true;
+    }
+
+    bool ReadString(const String*& str)
+    {
+        uint32 index = 0;
+        if (!ReadUInt32(index) || index >= strings.size())
+        {
+            return false;
+        }
+        str = &strings[index];
+        return true;
+    }
+
+    bool ReadFastName(FastName& name)
+    {
+        uint32 index = 0;
+        if (!ReadUInt32(index))
+        {
+            return false;
+        }
+
+        if (index == INVALID_STRING)
+        {
+            name = FastName();
+            return true;
+        }
+
+        if (index >= strings.size())
+        {
+            return false;
+        }
+
+        // Names are interned once per string, controls with same names don't look up FastName table again
+        if (!names[index].IsValid())
+        {
+            names[index] = FastName(strings[index]);
+        }
+        name = names[index];
+        return true;
+    }
+
+    /** Reads value, `fieldType` is used to restore enums. */
+    bool ReadValue(const Type* fieldType, Any& value)
+    {
+        uint8 tag = 0;
+        if (!ReadUInt8(tag))
+        {
+            return false;
+        }
+
+        switch (tag)
+        {
+        case VALUE_EMPTY:
+            value = Any();
+            return true;
+
+        case VALUE_BOOL:
+        {
+            uint8 v = 0;
+            return Assign(ReadUInt8(v), v != 0, value);
+        }
+
+        case VALUE_INT32:
+        {
+            int32 v = 0;
+            return Assign(ReadInt32(v), v, value);
+        }
+
+        case VALUE_UINT32:
+        {
+            uint32 v = 0;
+            return Assign(ReadUInt32(v), v, value);
+        }
+
+        case VALUE_INT64:
+        {
+            int64 v = 0;
+            return Assign(ReadBytes(&v, sizeof(v)), v, value);
+        }
+
+        case VALUE_UINT64:
+        {
+            uint64 v = 0;
+            return Assign(ReadBytes(&v, sizeof(v)), v, value);
+        }
+
+        case VALUE_FLOAT32:
+        {
+            float32 v = 0.0f;
+            return Assign(ReadFloat32(v), v, value);
+        }
+
+        case VALUE_FAST_NAME:
+        {
+            FastName v;
+            return Assign(ReadFastName(v), v, value);
+        }
+
+        case VALUE_STRING:
+        case VALUE_WIDE_STRING:
+        case VALUE_FILE_PATH:
+        {
+            const String* str = nullptr;
+            if (!ReadString(str))
+            {
+                return false;
+            }
+
+            if (tag == VALUE_STRING)
+            {
+                value = *str;
+            }
+            else if (tag == VALUE_WIDE_STRING)
+            {
+                value = UTF8Utils::EncodeToWideString(*str);
+            }
+            else
+            {
+                value = FilePath(*str);
+            }
+            return true;
+        }
+
+        case VALUE_VECTOR2:
+        {
+            Vector2 v;
+            return Assign(ReadBytes(v.data, sizeof(v.data)), v, value);
+        }
+
+        case VALUE_VECTOR3:
+        {
+            Vector3 v;
+            return Assign(ReadBytes(v.data, sizeof(v.data)), v, value);
+        }
+
+        case VALUE_VECTOR4:
+        {
+            Vector4 v;
+            return Assign(ReadBytes(v.data, sizeof(v.data)), v, value);
+        }
+
+        case VALUE_COLOR:
+        {
+            Color v;
+            return Assign(ReadBytes(v.color, sizeof(v.color)), v, value);
+        }
+
+        case VALUE_RECT:
+        {
+            Rect v;
+            bool isRead = ReadFloat32(v.x) && ReadFloat32(v.y) && ReadFloat32(v.dx) && ReadFloat32(v.dy);
+            return Assign(isRead, v, value);
+        }
+
+        case VALUE_ENUM:
+        {
+            int32 v = 0;
+            if (!ReadInt32(v))
+            {
+                return false;
+            }
+            value = fieldType != nullptr ? Any(v).ReinterpretCast(fieldType) : Any(v);
+            return true;
+        }
+
+        default:
+            return false;
+        }
+    }
+
+private:
+    template <typename T>
+    static bool Assign(bool isRead, const T& v, Any& value)
+    {
+        if (isRead)
+        {
+            value = v;
+        }
+        return isRead;
+    }
+
+    const Vector<uint8>& data;
+    size_t offset = 0;
+    Vector<String> strings;
+    Vector<FastName> names;
+};
+
+bool ReplayStyleSheet(Reader& reader, AbstractUIPackageBuilder* builder)
+{
+    const UIStyleSheetPropertyDataBase* propertyDB = UIStyleSheetPropertyDataBase::Instance();
+
+    uint32 chainsCount = 0;
+    if (!reader.ReadUInt32(chainsCount))
+    {
+        return false;
+    }
+
+    Vector<UIStyleSheetSelectorChain> selectorChains;
+    selectorChains.reserve(chainsCount);
+    for (uint32 i = 0; i < chainsCount; i++)
+    {
+        const String* selector = nullptr;
+        if (!reader.ReadString(selector))
+        {
+            return false;
+        }
+        selectorChains.push_back(UIStyleSheetSelectorChain(*selector));
+    }
+
+    uint32 propertiesCount = 0;
+    if (!reader.ReadUInt32(propertiesCount))
+    {
+        return false;
+    }
+
+    Vector<UIStyleSheetProperty> properties;
+    properties.reserve(propertiesCount);
+    for (uint32 i = 0; i < propertiesCount; i++)
+    {
+        FastName name;
+        if (!reader.ReadFastName(name))
+        {
+            return false;
+        }
+
+        bool isKnown = propertyDB->IsValidStyleSheetProperty(name);
+        uint32 index = isKnown ? propertyDB->GetStyleSheetPropertyIndex(name) : 0;
+        const ReflectedStructure::Field* field = isKnown ? propertyDB->GetStyleSheetPropertyByIndex(index).field : nullptr;
+
+        Any value;
+        uint8 transition = 0;
+        float32 transitionTime = 0.0f;
+        int32 transitionFunction = Interpolation::LINEAR;
+        if (!reader.ReadValue(field != nullptr ? GetFieldType(field) : nullptr, value) ||
+            !reader.ReadUInt8(transition) ||
+            !reader.ReadFloat32(transitionTime) ||
+            !reader.ReadInt32(transitionFunction))
+        {
+            return false;
+        }
+
+        if (field != nullptr)
+        {
+            properties.push_back(UIStyleSheetProperty(index, value, transition != 0, static_cast<Interpolation::FuncType>(transitionFunction), transitionTime));
+        }
+        else
+        {
+            Logger::Error("[UIPackageBinaryFormat::Load] Unknown style sheet property %s", name.c_str());
+        }
+    }
+
+    builder->ProcessStyleSheet(selectorChains, properties);
+    return true;
+}
+
+bool Replay(Reader& reader, const FilePath& packagePath, AbstractUIPackageBuilder* builder, AbstractUIPackageLoader* loader)
+{
+    const ReflectedType* propertiesType = nullptr;
+
+    while (!reader.IsEnd())
+    {
+        uint8 op = 0;
+        if (!reader.ReadUInt8(op))
+        {
+            return false;
+        }
+
+        switch (op)
+        {
+        case OP_BEGIN_PACKAGE:
+        {
+            int32 version = 0;
+            if (!reader.ReadInt32(version))
+            {
+                return false;
+            }
+            builder->BeginPackage(packagePath, version);
+            break;
+        }
+
+        case OP_END_PACKAGE:
+            builder->EndPackage();
+            break;
+
+        case OP_IMPORTED_PACKAGE:
+        {
+            const String* path = nullptr;
+            if (!reader.ReadString(path))
+            {
+                return false;
+            }
+            builder->ProcessImportedPackage(*path, loader);
+            break;
+        }
+
+        case OP_STYLE_SHEET:
+            if (!ReplayStyleSheet(reader, builder))
+            {
+                return false;
+            }
+            break;
+
+        case OP_BEGIN_CONTROL_WITH_CLASS:
+        {
+            FastName controlName;
+            const String* className = nullptr;
+            if (!reader.ReadFastName(controlName) || !reader.ReadString(className))
+            {
+                return false;
+            }
+            builder->BeginControlWithClass(controlName, *className);
+            break;
+        }
+
+        case OP_BEGIN_CONTROL_WITH_CUSTOM_CLASS:
+        {
+            FastName controlName;
+            const String* customClassName = nullptr;
+            const String* className = nullptr;
+            if (!reader.ReadFastName(controlName) || !reader.ReadString(customClassName) || !reader.ReadString(className))
+            {
+                return false;
+            }
+            builder->BeginControlWithCustomClass(controlName, *customClassName, *className);
+            break;
+        }
+
+        case OP_BEGIN_CONTROL_WITH_PROTOTYPE:
+        {
+            FastName controlName;
+            const String* packageName = nullptr;
+            FastName prototypeName;
+            uint8 hasCustomClass = 0;
+            const String* customClassName = nullptr;
+            if (!reader.ReadFastName(controlName) || !reader.ReadString(packageName) || !reader.ReadFastName(prototypeName) || !reader.ReadUInt8(hasCustomClass))
+            {
+                return false;
+            }
+            if (hasCustomClass != 0 && !reader.ReadString(customClassName))
+            {
+                return false;
+            }
+            builder->BeginControlWithPrototype(controlName, *packageName, prototypeName, customClassName, loader);
+            break;
+        }
+
+        case OP_BEGIN_CONTROL_WITH_PATH:
+        {
+            const String* path = nullptr;
+            if (!reader.ReadString(path))
+            {
+                return false;
+            }
+            builder->BeginControlWithPath(*path);
+            break;
+        }
+
+        case OP_END_CONTROL:
+        {
+            uint8 controlPlace = 0;
+            if (!reader.ReadUInt8(controlPlace) || controlPlace > AbstractUIPackageBuilder::TO_PREVIOUS_CONTROL)
+            {
+                return false;
+            }
+            builder->EndControl(static_cast<AbstractUIPackageBuilder::eControlPlace>(controlPlace));
+            break;
+        }
+
+        case OP_BEGIN_CONTROL_PROPERTIES:
+        {
+            const String* typeName = nullptr;
+            if (!reader.ReadString(typeName))
+            {
+                return false;
+            }
+            propertiesType = ReflectedTypeDB::GetByPermanentName(*typeName);
+            builder->BeginControlPropertiesSection(*typeName);
+            break;
+        }
+
+        case OP_END_CONTROL_PROPERTIES:
+            propertiesType = nullptr;
+            builder->EndControlPropertiesSection();
+            break;
+
+        case OP_BEGIN_COMPONENT_PROPERTIES:
+        {
+            const String* typeName = nullptr;
+            uint32 componentIndex = 0;
+            if (!reader.ReadString(typeName) || !reader.ReadUInt32(componentIndex))
+            {
+                return false;
+            }
+
+            const ReflectedType* componentType = ReflectedTypeDB::GetByPermanentName(*typeName);
+            if (componentType == nullptr)
+            {
+                Logger::Error("[UIPackageBinaryFormat::Load] Unknown component %s", typeName->c_str());
+                return false;
+            }
+            propertiesType = builder->BeginComponentPropertiesSection(componentType->GetType(), componentIndex);
+            break;
+        }
+
+        case OP_END_COMPONENT_PROPERTIES:
+            propertiesType = nullptr;
+            builder->EndComponentPropertiesSection();
+            break;
+
+        case OP_PROPERTY:
+        {
+            FastName fieldName;
+            if (!reader.ReadFastName(fieldName))
+            {
+                return false;
+            }
+
+            const ReflectedStructure::Field* field = FindField(propertiesType, fieldName);
+            Any value;
+            if (!reader.ReadValue(field != nullptr ? GetFieldType(field) : nullptr, value))
+            {
+                return false;
+            }
+
+            if (field != nullptr)
+            {
+                builder->ProcessProperty(*field, value);
+            }
+            else
+            {
+                Logger::Error("[UIPackageBinaryFormat::Load] Unknown property %s", fieldName.c_str());
+            }
+            break;
+        }
+
+        case OP_DATA_BINDING:
+        {
+            const String* fieldName = nullptr;
+            const String* expression = nullptr;
+            int32 bindingMode = 0;
+            if (!reader.ReadString(fieldName) || !reader.ReadString(expression) || !reader.ReadInt32(bindingMode))
+            {
+                return false;
+            }
+            builder->ProcessDataBinding(*fieldName, *expression, bindingMode);
+            break;
+        }
+
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+}
+
+const char* UIPackageBinaryFormat::BINARY_PACKAGE_EXTENSION = ".uib";
+
+FilePath UIPackageBinaryFormat::GetBinaryPackagePath(const FilePath& yamlPath)
+{
+    return FilePath::CreateWithNewExtension(yamlPath, BINARY_PACKAGE_EXTENSION);
+}
+
+bool UIPackageBinaryFormat::IsBinaryPackagePath(const FilePath& path)
+{
+    return path.IsEqualToExtension(BINARY_PACKAGE_EXTENSION);
+}
+
+bool UIPackageBinaryFormat::Compile(const FilePath& yamlPath, const FilePath& binaryPath)
+{
+    using namespace UIPackageBinaryFormatDetails;
+
+    if (!FileSystem::Instance()->Exists(yamlPath))
+    {
+        Logger::Error("[UIPackageBinaryFormat::Compile] File %s doesn't exist", yamlPath.GetStringValue().c_str());
+        return false;
+    }
+
+    Writer writer;
+    RecordingBuilder recorder(writer);
+    UIPackageLoader loader;
+    if (!loader.LoadPackage(yamlPath, &recorder) || !recorder.IsValid())
+    {
+        Logger::Error("[UIPackageBinaryFormat::Compile] Can't compile %s", yamlPath.GetStringValue().c_str());
+        return false;
+    }
+
+    ScopedPtr<File> file(File::Create(binaryPath, File::CREATE | File::WRITE));
+    if (!file)
+    {
+        Logger::Error("[UIPackageBinaryFormat::Compile] Can't create %s", binaryPath.GetStringValue().c_str());
+        return false;
+    }
+
+    Vector<uint8> data = writer.Finish();
+    uint32 size = static_cast<uint32>(data.size());
+    return file->Write(data.data(), size) == size;
+}
+
+bool UIPackageBinaryFormat::Load(const FilePath& binaryPath, const FilePath& packagePath, AbstractUIPackageBuilder* builder, AbstractUIPackageLoader* loader)
+{
+    using namespace UIPackageBinaryFormatDetails;
+
+    Vector<uint8> data;
+    if (!FileSystem::Instance()->ReadFileContents(binaryPath, data))
+    {
+        return false;
+    }
+
+    Reader reader(data);
+    uint32 magic = 0;
+    uint32 version = 0;
+    if (!reader.ReadUInt32(magic) || magic != MAGIC || !reader.ReadUInt32(version) || version != VERSION)
+    {
+        Logger::Error("[UIPackageBinaryFormat::Load] Invalid header in %s", binaryPath.GetStringValue().c_str());
+        return false;
+    }
+
+    if (!reader.ReadStringTable() || !Replay(reader, packagePath, builder, loader))
+    {
+        Logger::Error("[UIPackageBinaryFormat::Load] Corrupted data in %s", binaryPath.GetStringValue().c_str());
+        DVASSERT(false);
+        return false;
+    }
+
+    return true;
+}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include "Base/BaseTypes.h"
+#include "FileSystem/FilePath.h"
+
+namespace DAVA
+{
+class AbstractUIPackageBuilder;
+class AbstractUIPackageLoader;
+
+/**
+    Precompiled binary form of UI package.
+    Package yaml is loaded offline by UIPackageLoader and every call it makes to the package builder is recorded:
+    controls and components are stored with already resolved classes, reflected fields and typed property values,
+    prototypes from the same package are stored in the order they have to be created, style sheets are stored
+    with already parsed properties. All names and strings are interned into one string table.
+    Loading replays recorded calls into the builder directly from file data, so no yaml tokenizing, YamlNode tree
+    and string to value conversions are needed at runtime.
+    Binary packages are produced offline by `Compile` and have `.uib` extension. UIPackageLoader uses binary package
+    if it is requested directly or if yaml package with the same name doesn't exist.
+    Custom data of package is editor only information and is not stored.
+*/
+class UIPackageBinaryFormat final
+{
+public:
+    static const char* BINARY_PACKAGE_EXTENSION;
+
+    /** Returns path of binary package for yaml package path. */
+    static FilePath GetBinaryPackagePath(const FilePath& yamlPath);
+    static bool IsBinaryPackagePath(const FilePath& path);
+
+    /**
+        Loads yaml package and saves recorded builder calls in binary form. Imported packages are loaded to resolve
+        prototypes but are not embedded, they are loaded by their own paths at runtime. Returns false if package
+        can't be loaded, contains data which can't be stored or file can't be written.
+    */
+    static bool Compile(const FilePath& yamlPath, const FilePath& binaryPath);
+
+    /**
+        Replays binary package from `binaryPath` into `builder` as package with `packagePath`. `loader` is passed to
+        builder to load imported packages. Returns false if file can't be read or has wrong format.
+    */
+    static bool Load(const FilePath& binaryPath, const FilePath& packagePath, AbstractUIPackageBuilder* builder, AbstractUIPackageLoader* loader);
+};
+}
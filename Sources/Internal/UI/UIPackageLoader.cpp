@@ -15,6 +15,7 @@
 #include "UI/Text/UITextComponent.h"
 #include "UI/UIControlHelpers.h"
 #include "UI/UIPackage.h"
+#include "UI/UIPackageBinaryFormat.h"
 #include "UI/Components/UIComponent.h"
 #include "UI/DataBinding/UIDataBindingComponent.h"
 #include "UI/Layouts/UIAnchorComponent.h"
@@ -85,6 +86,13 @@ bool UIPackageLoader::LoadPackage(const FilePath& packagePath, AbstractUIPackage
         loadingQueue.clear();
     }
 
+    // Precompiled binary package is used if it is requested directly or if yaml isn't shipped
+    FilePath binaryPath = UIPackageBinaryFormat::IsBinaryPackagePath(packagePath) ? packagePath : UIPackageBinaryFormat::GetBinaryPackagePath(packagePath);
+    if (binaryPath == packagePath || (!FileSystem::Instance()->Exists(packagePath) && FileSystem::Instance()->Exists(binaryPath)))
+    {
+        return UIPackageBinaryFormat::Load(binaryPath, packagePath, builder, this);
+    }
+
     if (!FileSystem::Instance()->Exists(packagePath))
         return false;
 